@@ -134,11 +134,23 @@ DependenciesRelease = {
 ProjLinks = { }
 for k, v in pairs(Dependencies) do ProjLinks[k] = v end
 
-ProjDebugLinks = { }
-for k, v in pairs(DependenciesDebug) do ProjDebugLinks[k] = v end
+-- Bullet doesn't ship debug builds of BulletCollision, BulletDynamics or BulletSoftBody, and it's debug and release
+-- libraries can't be mixed, so Debug builds link the release Bullet libraries along with FMOD's logging libraries. 
+-- Bullet's release libraries are built against the static release runtime, so projects using this list have to 
+-- use that runtime in Debug as well
+ProjDebugLinks = {
+	"dependencies/bullet3/lib/Bullet3Common.lib",
+	"dependencies/bullet3/lib/BulletCollision.lib",
+	"dependencies/bullet3/lib/BulletDynamics.lib",
+	"dependencies/bullet3/lib/BulletInverseDynamics.lib",
+	"dependencies/bullet3/lib/BulletSoftBody.lib",
+	"dependencies/bullet3/lib/LinearMath.lib",
+	"dependencies/fmod/lib/fmodstudioL_vc.lib",
+	"dependencies/fmod/lib/fmodL_vc.lib",
+}
 
 ProjReleaseLinks = { }
-for k, v in pairs(DependenciesRelease) do ProjDebugLinks[k] = v end
+for k, v in pairs(DependenciesRelease) do ProjReleaseLinks[k] = v end
 
 -- This function handles creating the default project for a module, if no premake folder is given
 -- @param folderName The path to the module, as collected from os.matchdirs
@@ -390,6 +402,11 @@ function AddProjects(groupName, folders)
 				runtime "Release"
 				optimize "on"
 
+				-- The memory tracker's allocator hooks are for debugging, so shipped builds go without them
+				defines {
+					"ENABLE_MEMORY_TRACKING=0"
+				}
+
 				links(ProjLinksRelease)
 	end
 
@@ -402,4 +419,167 @@ for k, proj in pairs(sampleGroups) do
 	local name = path.getbasename(proj);
     local samples = os.matchdirs(proj .. "/*")
     AddProjects("Samples - " .. name, samples)
-end
\ No newline at end of file
+end
+
+-- This function creates a benchmark executable for a project, which compiles the project's sources (minus it's entry
+-- point) alongside the benchmark's own sources, so that engine code can be measured without running the game
+-- @param benchDir The folder containing the benchmark, with it's sources in a src folder
+-- @param target   The folder of the project being benchmarked
+function AddBenchmarkProject(benchDir, target)
+
+	local name = path.getbasename(benchDir)
+	local relpath = path.getrelative(rootDir, benchDir)
+	local targetRel = path.getrelative(rootDir, target)
+
+	premake.info(" Adding benchmark: " .. name .. " (for " .. targetRel .. ")")
+
+	project(name)
+		location(relpath)
+		kind "ConsoleApp"
+		language "C++"
+		cppdialect "C++17"
+		staticruntime "on"
+
+		targetdir ("%{wks.location}\\bin\\" .. outputdir .. "\\%{prj.name}")
+		objdir ("%{wks.location}\\obj\\" .. outputdir .. "\\%{prj.name}")
+
+		-- Benchmarks load the game's assets, so we run them from the target project's resource folder
+		debugdir (path.join(target, "res"))
+		debugargs { "--baseline", "bench_baseline.json" }
+
+		files {
+			"%{prj.location}\\src\\**.h",
+			"%{prj.location}\\src\\**.cpp",
+			path.join(target, "src/**.h"),
+			path.join(target, "src/**.hpp"),
+			path.join(target, "src/**.cpp"),
+			path.join(target, "src/**.c")
+		}
+		-- The benchmark provides it's own main
+		removefiles { path.join(target, "src/entry_point.cpp") }
+
+		defines {
+			"_CRT_SECURE_NO_WARNINGS",
+			-- Replacing the global allocator would add it's bookkeeping to every benchmark that allocates
+			"ENABLE_MEMORY_TRACKING=0"
+		}
+
+		-- The target's sources come first so it's includes resolve the same way they do in the game
+		ProjIncludes[1] = path.join(targetRel, "src")
+		includedirs(ProjIncludes)
+		includedirs { path.join(relpath, "src") }
+
+		links(ProjLinks)
+
+		filter "system:windows"
+			systemversion "latest"
+			buildoptions { "/bigobj" }
+
+			defines {
+				"GLFW_INCLUDE_NONE",
+				"WINDOWS"
+			}
+
+		filter "system:linux"
+			links { "pthread", "dl" }
+
+		filter "configurations:Debug"
+			-- Release runtime to match the Bullet libraries we link in Debug (see ProjDebugLinks)
+			runtime "Release"
+			symbols "on"
+
+			links(ProjDebugLinks)
+
+		filter "configurations:Release"
+			runtime "Release"
+			optimize "on"
+
+			links(ProjReleaseLinks)
+
+		filter {}
+end
+
+-- Microbenchmarks for the engine, these aren't part of the projects folder so they don't get picked up as games
+group("Benchmarks")
+AddBenchmarkProject(path.join(rootDir, "benchmarks/BeatEngineBench"), path.join(rootDir, "projects/BeatEngine"))
+
+-- This function creates a command line tool for a project, which compiles the project's sources (minus it's entry
+-- point) alongside the tool's own sources, so that tools can share the engine's loaders and formats
+-- @param toolDir The folder containing the tool, with it's sources in a src folder
+-- @param target  The folder of the project the tool works on
+function AddToolProject(toolDir, target)
+
+	local name = path.getbasename(toolDir)
+	local relpath = path.getrelative(rootDir, toolDir)
+	local targetRel = path.getrelative(rootDir, target)
+
+	premake.info(" Adding tool: " .. name .. " (for " .. targetRel .. ")")
+
+	project(name)
+		location(relpath)
+		kind "ConsoleApp"
+		language "C++"
+		cppdialect "C++17"
+		staticruntime "on"
+
+		targetdir ("%{wks.location}\\bin\\" .. outputdir .. "\\%{prj.name}")
+		objdir ("%{wks.location}\\obj\\" .. outputdir .. "\\%{prj.name}")
+
+		-- Tools work on the game's assets, so we run them from the target project's resource folder
+		debugdir (path.join(target, "res"))
+		debugargs { "." }
+
+		files {
+			"%{prj.location}\\src\\**.h",
+			"%{prj.location}\\src\\**.cpp",
+			path.join(target, "src/**.h"),
+			path.join(target, "src/**.hpp"),
+			path.join(target, "src/**.cpp"),
+			path.join(target, "src/**.c")
+		}
+		-- The tool provides it's own main
+		removefiles { path.join(target, "src/entry_point.cpp") }
+
+		defines {
+			"_CRT_SECURE_NO_WARNINGS",
+			"ENABLE_MEMORY_TRACKING=0"
+		}
+
+		-- The target's sources come first so it's includes resolve the same way they do in the game
+		ProjIncludes[1] = path.join(targetRel, "src")
+		includedirs(ProjIncludes)
+		includedirs { path.join(relpath, "src") }
+
+		links(ProjLinks)
+
+		filter "system:windows"
+			systemversion "latest"
+			buildoptions { "/bigobj" }
+
+			defines {
+				"GLFW_INCLUDE_NONE",
+				"WINDOWS"
+			}
+
+		filter "system:linux"
+			links { "pthread", "dl" }
+
+		filter "configurations:Debug"
+			-- Release runtime to match the Bullet libraries we link in Debug (see ProjDebugLinks)
+			runtime "Release"
+			symbols "on"
+
+			links(ProjDebugLinks)
+
+		filter "configurations:Release"
+			runtime "Release"
+			optimize "on"
+
+			links(ProjReleaseLinks)
+
+		filter {}
+end
+
+-- Offline tools for preparing the game's assets
+group("Tools")
+AddToolProject(path.join(rootDir, "tools/AssetCooker"), path.join(rootDir, "projects/BeatEngine"))
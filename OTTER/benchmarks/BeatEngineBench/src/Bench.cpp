@@ -0,0 +1,264 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#include "Logging.h"
+#include "Utils/FileHelpers.h"
+#include "Utils/FrameArena.h"
+
+namespace Bench {
+	struct Registration {
+		const char*   Name;
+		BenchmarkFunc Func;
+	};
+
+	struct Result {
+		std::string Name;
+		uint64_t    Iterations;
+		double      MedianNs;
+		double      MinNs;
+		uint64_t    ItemsPerIteration;
+	};
+
+	// Function local so that registrars in other translation units can't run before it exists
+	static std::vector<Registration>& GetRegistry() {
+		static std::vector<Registration> registry;
+		return registry;
+	}
+
+	State::State(uint64_t iterations) :
+		_iterations(iterations),
+		_remaining(iterations),
+		_elapsedNs(0),
+		_itemsPerIteration(1),
+		_isStarted(false),
+		_isPaused(false),
+		_start(Clock::time_point())
+	{ }
+
+	bool State::KeepRunning() {
+		if (!_isStarted) {
+			_isStarted = true;
+			_start = Clock::now();
+		}
+		// Every iteration is a frame as far as the engine is concerned, so frame memory is released the same
+		// way the main loop does it instead of piling up for the whole run
+		else {
+			FrameArena::EndFrame();
+		}
+		if (_remaining > 0) {
+			_remaining--;
+			return true;
+		}
+		if (!_isPaused) {
+			_elapsedNs += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _start).count();
+			_isPaused = true;
+		}
+		return false;
+	}
+
+	void State::PauseTiming() {
+		if (!_isPaused) {
+			_elapsedNs += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _start).count();
+			_isPaused = true;
+		}
+	}
+
+	void State::ResumeTiming() {
+		if (_isPaused) {
+			_isPaused = false;
+			_start = Clock::now();
+		}
+	}
+
+	uint64_t State::GetIterations() const {
+		return _iterations;
+	}
+
+	uint64_t State::GetElapsedNs() const {
+		return _elapsedNs;
+	}
+
+	void State::SetItemsPerIteration(uint64_t value) {
+		_itemsPerIteration = std::max<uint64_t>(1, value);
+	}
+
+	uint64_t State::GetItemsPerIteration() const {
+		return _itemsPerIteration;
+	}
+
+	Registrar::Registrar(const char* name, BenchmarkFunc func) {
+		GetRegistry().push_back({ name, func });
+	}
+
+	RunOptions RunOptions::Parse(int argCount, char** arguments) {
+		RunOptions result;
+		for (int ix = 1; ix < argCount; ix++) {
+			const char* arg = arguments[ix];
+			// Grabs the value following a flag, or nullptr if we're at the end of the arguments
+			const char* value = (ix + 1 < argCount) ? arguments[ix + 1] : nullptr;
+
+			if (strcmp(arg, "--save-baseline") == 0) {
+				result.SaveBaseline = true;
+			}
+			else if (value == nullptr) {
+				LOG_WARN("Missing value for command line argument \"{}\"", arg);
+			}
+			else if (strcmp(arg, "--filter") == 0) {
+				result.Filter = value;
+				ix++;
+			}
+			else if (strcmp(arg, "--out") == 0) {
+				result.OutputPath = value;
+				ix++;
+			}
+			else if (strcmp(arg, "--baseline") == 0) {
+				result.BaselinePath = value;
+				ix++;
+			}
+			else if (strcmp(arg, "--threshold") == 0) {
+				result.Threshold = std::max(0.0, atof(value));
+				ix++;
+			}
+			else if (strcmp(arg, "--min-time") == 0) {
+				result.MinTimeMs = std::max(0.1, atof(value));
+				ix++;
+			}
+			else if (strcmp(arg, "--repetitions") == 0) {
+				result.Repetitions = std::max(1, atoi(value));
+				ix++;
+			}
+			else {
+				LOG_WARN("Unknown command line argument \"{}\"", arg);
+			}
+		}
+
+		if (result.SaveBaseline && result.BaselinePath.empty()) {
+			result.BaselinePath = "bench_baseline.json";
+		}
+		return result;
+	}
+
+	static Result Run(const Registration& bench, const RunOptions& options) {
+		const uint64_t minTimeNs = static_cast<uint64_t>(options.MinTimeMs * 1000000.0);
+
+		// Grow the iteration count until a single run takes long enough to be measured reliably
+		uint64_t iterations = 1;
+		uint64_t itemsPerIteration = 1;
+		while (true) {
+			State state(iterations);
+			bench.Func(state);
+			itemsPerIteration = state.GetItemsPerIteration();
+
+			uint64_t elapsed = state.GetElapsedNs();
+			if (elapsed >= minTimeNs || iterations >= (1ull << 32)) {
+				break;
+			}
+			// Aim a bit past the target based on how long this run took, but never grow more than 10x at once
+			uint64_t estimate = elapsed > 0 ? static_cast<uint64_t>(iterations * 1.4 * minTimeNs / elapsed) : iterations * 10;
+			iterations = std::clamp(estimate, iterations * 2, iterations * 10);
+		}
+
+		std::vector<double> samples;
+		samples.reserve(options.Repetitions);
+		for (int ix = 0; ix < options.Repetitions; ix++) {
+			State state(iterations);
+			bench.Func(state);
+			samples.push_back(static_cast<double>(state.GetElapsedNs()) / iterations);
+		}
+		std::sort(samples.begin(), samples.end());
+
+		Result result;
+		result.Name = bench.Name;
+		result.Iterations = iterations;
+		result.MedianNs = samples[samples.size() / 2];
+		result.MinNs = samples.front();
+		result.ItemsPerIteration = itemsPerIteration;
+		return result;
+	}
+
+	int RunAll(const RunOptions& options) {
+		// Sort by name so that the output is stable no matter what order the files were linked in
+		std::vector<Registration> registry = GetRegistry();
+		std::sort(registry.begin(), registry.end(), [](const Registration& a, const Registration& b) {
+			return strcmp(a.Name, b.Name) < 0;
+		});
+
+		nlohmann::json baseline;
+		bool compare = !options.SaveBaseline && !options.BaselinePath.empty();
+		if (compare) {
+			if (std::filesystem::exists(options.BaselinePath)) {
+				baseline = nlohmann::json::parse(FileHelpers::ReadFile(options.BaselinePath))["benchmarks"];
+			} else {
+				LOG_WARN("Baseline \"{}\" was not found, run with --save-baseline to create it", options.BaselinePath);
+				compare = false;
+			}
+		}
+
+		printf("%-44s %14s %14s %14s %12s\n", "Benchmark", "Iterations", "Median ns/op", "Min ns/op", "vs baseline");
+
+		nlohmann::json results = nlohmann::json::object();
+		int regressions = 0;
+		for (const auto& bench : registry) {
+			if (!options.Filter.empty() && strstr(bench.Name, options.Filter.c_str()) == nullptr) {
+				continue;
+			}
+
+			Result result = Run(bench, options);
+
+			nlohmann::json item;
+			item["iterations"] = result.Iterations;
+			item["median_ns"] = result.MedianNs;
+			item["min_ns"] = result.MinNs;
+			item["items_per_iteration"] = result.ItemsPerIteration;
+			item["median_ns_per_item"] = result.MedianNs / result.ItemsPerIteration;
+			results[result.Name] = item;
+
+			char delta[32] = "";
+			if (compare && baseline.contains(result.Name)) {
+				double reference = baseline[result.Name].value("median_ns", 0.0);
+				if (reference > 0.0) {
+					double percent = (result.MedianNs - reference) / reference * 100.0;
+					bool regressed = percent > options.Threshold;
+					regressions += regressed ? 1 : 0;
+					snprintf(delta, sizeof(delta), "%+.1f%%%s", percent, regressed ? " !!" : "");
+				}
+			}
+			else if (compare) {
+				snprintf(delta, sizeof(delta), "new");
+			}
+
+			printf("%-44s %14llu %14.1f %14.1f %12s\n", result.Name.c_str(), (unsigned long long)result.Iterations, result.MedianNs, result.MinNs, delta);
+			fflush(stdout);
+		}
+
+		nlohmann::json blob;
+		blob["benchmarks"] = results;
+		blob["repetitions"] = options.Repetitions;
+		blob["min_time_ms"] = options.MinTimeMs;
+		#ifdef NDEBUG
+		blob["config"] = "Release";
+		#else
+		blob["config"] = "Debug";
+		#endif
+
+		std::string contents = blob.dump(1, '\t');
+		if (options.SaveBaseline) {
+			FileHelpers::WriteContentsToFile(options.BaselinePath, contents);
+			LOG_INFO("Saved baseline to \"{}\"", options.BaselinePath);
+		}
+		if (!options.OutputPath.empty()) {
+			FileHelpers::WriteContentsToFile(options.OutputPath, contents);
+			LOG_INFO("Wrote results to \"{}\"", options.OutputPath);
+		}
+
+		if (regressions > 0) {
+			LOG_ERROR("{} benchmark(s) were more than {}% slower than the baseline", regressions, options.Threshold);
+			return 1;
+		}
+		return 0;
+	}
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <json.hpp>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Bench {
+	/// <summary>
+	/// Passed to every benchmark, controls how many iterations the benchmark runs and times them.
+	/// Anything done before the first call to KeepRunning is setup and is not timed:
+	///
+	/// BENCHMARK(MyBenchmark) {
+	///     auto thing = BuildThing();
+	///     while (state.KeepRunning()) {
+	///         Bench::DoNotOptimize(thing->DoWork());
+	///     }
+	/// }
+	/// </summary>
+	class State {
+	public:
+		State(uint64_t iterations);
+
+		/// <summary>
+		/// Returns true while there are iterations left to run, starting the timer on the first call. Each
+		/// call after the first ends the frame arena's frame, so frame memory doesn't outlive an iteration
+		/// </summary>
+		bool KeepRunning();
+
+		/// <summary>
+		/// Stops the timer, used to exclude per-iteration setup or cleanup from the results
+		/// </summary>
+		void PauseTiming();
+		/// <summary>
+		/// Restarts the timer after a call to PauseTiming
+		/// </summary>
+		void ResumeTiming();
+
+		/// <summary>
+		/// Gets the number of iterations this run was asked to do
+		/// </summary>
+		uint64_t GetIterations() const;
+		/// <summary>
+		/// Gets the number of nanoseconds spent in timed code
+		/// </summary>
+		uint64_t GetElapsedNs() const;
+
+		/// <summary>
+		/// Sets how many items each iteration processes (ex: objects visited), so results can be reported per item as well
+		/// </summary>
+		void SetItemsPerIteration(uint64_t value);
+		uint64_t GetItemsPerIteration() const;
+
+	protected:
+		typedef std::chrono::high_resolution_clock Clock;
+
+		uint64_t          _iterations;
+		uint64_t          _remaining;
+		uint64_t          _elapsedNs;
+		uint64_t          _itemsPerIteration;
+		bool              _isStarted;
+		bool              _isPaused;
+		Clock::time_point _start;
+	};
+
+	typedef void(*BenchmarkFunc)(State&);
+
+	/// <summary>
+	/// Registers a benchmark with the runner, used by the BENCHMARK macro
+	/// </summary>
+	struct Registrar {
+		Registrar(const char* name, BenchmarkFunc func);
+	};
+
+	/// <summary>
+	/// Options for the benchmark runner, parsed from the command line
+	///
+	/// Usage: BeatEngineBench [--filter text] [--out results.json] [--baseline baseline.json] [--save-baseline] [--threshold percent] [--min-time ms] [--repetitions N]
+	/// </summary>
+	struct RunOptions {
+		// Only benchmarks with names containing this text will be run
+		std::string Filter;
+		// Where to write the results of this run, leave empty to skip writing them
+		std::string OutputPath   = "bench_results.json";
+		// The results to compare against, leave empty to skip the comparison
+		std::string BaselinePath;
+		// If true, the results of this run are written to the baseline path instead of compared with it
+		bool        SaveBaseline = false;
+		// How much slower than the baseline a benchmark can be before we call it a regression, in percent
+		double      Threshold    = 10.0;
+		// The minimum amount of time a single repetition should take, so short benchmarks aren't dominated by timer noise
+		double      MinTimeMs    = 10.0;
+		// How many times each benchmark is repeated, we report the median and fastest repetition
+		int         Repetitions  = 5;
+
+		static RunOptions Parse(int argCount, char** arguments);
+	};
+
+	/// <summary>
+	/// Runs all registered benchmarks that match the options, and compares them to a baseline if one was given
+	/// </summary>
+	/// <returns>The process exit code, non-zero if any benchmark regressed past the threshold</returns>
+	int RunAll(const RunOptions& options);
+
+	/// <summary>
+	/// Prevents the compiler from optimizing away a value that is only computed for the benchmark
+	/// </summary>
+	template <typename T>
+	inline void DoNotOptimize(const T& value) {
+		#ifdef _MSC_VER
+		// MSVC has no inline asm on x64, so we force the address to escape through a volatile store instead
+		static const void* volatile sink;
+		sink = &value;
+		_ReadWriteBarrier();
+		#else
+		asm volatile("" : : "r,m"(value) : "memory");
+		#endif
+	}
+
+	/// <summary>
+	/// Tells the compiler that all memory may have been read or written, so stores in the loop aren't removed
+	/// </summary>
+	inline void ClobberMemory() {
+		#ifdef _MSC_VER
+		_ReadWriteBarrier();
+		#else
+		asm volatile("" : : : "memory");
+		#endif
+	}
+}
+
+/// <summary>
+/// Declares and registers a benchmark, the body receives a Bench::State named state
+/// </summary>
+#define BENCHMARK(name) \
+	static void name(Bench::State& state); \
+	static Bench::Registrar __registrar_##name(#name, name); \
+	static void name(Bench::State& state)
@@ -0,0 +1,108 @@
+#include "Bench.h"
+#include "Fixtures.h"
+
+#include "Gameplay/Components/Camera.h"
+#include "Gameplay/Components/RenderComponent.h"
+#include "Gameplay/Components/RotatingBehaviour.h"
+
+using namespace Gameplay;
+
+// Iterating every renderer is what the render layer does every frame
+BENCHMARK(ComponentManager_Each_RenderComponent) {
+	const Scene::Sptr& scene = Fixtures::GetFlatScene();
+	state.SetItemsPerIteration(Fixtures::FlatSceneSize);
+
+	while (state.KeepRunning()) {
+		int count = 0;
+		scene->Components().Each<RenderComponent>([&](const RenderComponent::Sptr& renderer) {
+			count++;
+		});
+		Bench::DoNotOptimize(count);
+	}
+}
+
+// Half the objects have this component, so this measures the cost of the type filter as well
+BENCHMARK(ComponentManager_Each_RotatingBehaviour) {
+	const Scene::Sptr& scene = Fixtures::GetFlatScene();
+	state.SetItemsPerIteration(Fixtures::FlatSceneSize / 2);
+
+	while (state.KeepRunning()) {
+		int count = 0;
+		scene->Components().Each<RotatingBehaviour>([&](const RotatingBehaviour::Sptr& behaviour) {
+			count++;
+		});
+		Bench::DoNotOptimize(count);
+	}
+}
+
+// RenderComponent is the first component added to every object, so this is the best case
+BENCHMARK(GameObject_Get_First) {
+	GameObject::Sptr object = Fixtures::GetFlatScene()->FindObjectByName("Object 0");
+
+	while (state.KeepRunning()) {
+		Bench::DoNotOptimize(object->Get<RenderComponent>());
+	}
+}
+
+// Camera isn't on the object, so every component gets checked
+BENCHMARK(GameObject_Get_Missing) {
+	GameObject::Sptr object = Fixtures::GetFlatScene()->FindObjectByName("Object 0");
+
+	while (state.KeepRunning()) {
+		Bench::DoNotOptimize(object->Get<Camera>());
+	}
+}
+
+BENCHMARK(GameObject_Has_Present) {
+	GameObject::Sptr object = Fixtures::GetFlatScene()->FindObjectByName("Object 0");
+
+	while (state.KeepRunning()) {
+		Bench::DoNotOptimize(object->Has<RotatingBehaviour>());
+	}
+}
+
+BENCHMARK(GameObject_Has_Missing) {
+	GameObject::Sptr object = Fixtures::GetFlatScene()->FindObjectByName("Object 0");
+
+	while (state.KeepRunning()) {
+		Bench::DoNotOptimize(object->Has<Camera>());
+	}
+}
+
+// Once transforms are cached, getting the deepest transform should be cheap
+BENCHMARK(GameObject_GetTransform_DeepCached) {
+	const GameObject::Sptr& leaf = Fixtures::GetDeepChain().back();
+	leaf->GetTransform();
+
+	while (state.KeepRunning()) {
+		Bench::DoNotOptimize(leaf->GetTransform());
+	}
+}
+
+// Moves the root of the hierarchy, then reads back every transform in the chain
+BENCHMARK(GameObject_GetTransform_DeepDirtyRoot) {
+	const std::vector<GameObject::Sptr>& chain = Fixtures::GetDeepChain();
+	const GameObject::Sptr& root = chain.front();
+	state.SetItemsPerIteration(chain.size());
+
+	float offset = 0.0f;
+	while (state.KeepRunning()) {
+		offset += 0.001f;
+		root->SetPostion(glm::vec3(offset, 0.0f, 0.0f));
+		for (const auto& object : chain) {
+			Bench::DoNotOptimize(object->GetTransform());
+		}
+	}
+}
+
+// Moving the leaf should only recompute the leaf
+BENCHMARK(GameObject_GetTransform_DeepDirtyLeaf) {
+	const GameObject::Sptr& leaf = Fixtures::GetDeepChain().back();
+
+	float offset = 0.0f;
+	while (state.KeepRunning()) {
+		offset += 0.001f;
+		leaf->SetPostion(glm::vec3(offset, 0.0f, 0.0f));
+		Bench::DoNotOptimize(leaf->GetTransform());
+	}
+}
@@ -0,0 +1,145 @@
+#include "Fixtures.h"
+
+#include "MockGL.h"
+
+#include "Gameplay/MeshResource.h"
+#include "Gameplay/Components/Camera.h"
+#include "Gameplay/Components/RenderComponent.h"
+#include "Gameplay/Components/RotatingBehaviour.h"
+#include "Graphics/Font.h"
+#include "Utils/ResourceManager/ResourceManager.h"
+
+using namespace Gameplay;
+
+namespace Fixtures {
+	static ShaderProgram::Sptr __shader;
+	static Texture2D::Sptr __texture;
+	static Material::Sptr __material;
+	static Scene::Sptr __flatScene;
+	static Scene::Sptr __deepScene;
+	static std::vector<GameObject::Sptr> __deepChain;
+
+	void Init() {
+		ResourceManager::Init();
+		ResourceManager::RegisterType<Texture2D>();
+		ResourceManager::RegisterType<ShaderProgram>();
+		ResourceManager::RegisterType<Material>();
+		ResourceManager::RegisterType<MeshResource>();
+		ResourceManager::RegisterType<Font>();
+
+		ComponentManager::RegisterType<Camera>();
+		ComponentManager::RegisterType<RenderComponent>();
+		ComponentManager::RegisterType<RotatingBehaviour>();
+		ComponentManager::RegisterType<RotatingBehaviourCD>();
+	}
+
+	void Cleanup() {
+		__deepChain.clear();
+		__deepScene = nullptr;
+		__flatScene = nullptr;
+		__material = nullptr;
+		__texture = nullptr;
+		__shader = nullptr;
+		ResourceManager::Cleanup();
+	}
+
+	const ShaderProgram::Sptr& GetShader() {
+		if (__shader == nullptr) {
+			// Roughly what the deferred shaders expose once the uniform blocks have been filtered out
+			MockGL::SetProgramUniforms({
+				{ "u_Material.AlbedoMap",     GL_SAMPLER_2D },
+				{ "u_Material.NormalMap",     GL_SAMPLER_2D },
+				{ "u_Material.SpecularMap",   GL_SAMPLER_2D },
+				{ "u_Material.EmissiveMap",   GL_SAMPLER_2D },
+				{ "u_Material.DiscardThreshold", GL_FLOAT },
+				{ "u_Material.Shininess",     GL_FLOAT },
+				{ "u_Material.Tint",          GL_FLOAT_VEC4 },
+				{ "u_Material.UvScroll",      GL_FLOAT_VEC2 },
+				{ "u_Material.UseNormalMap",  GL_BOOL },
+				{ "u_Material.Offsets[0]",    GL_FLOAT_VEC3, 4 },
+			});
+
+			__shader = ResourceManager::CreateAsset<ShaderProgram>();
+			__shader->LoadShaderPart("#version 450\nvoid main() { }", ShaderPartType::Vertex);
+			__shader->LoadShaderPart("#version 450\nvoid main() { }", ShaderPartType::Fragment);
+			__shader->Link();
+
+			MockGL::ClearProgramUniforms();
+		}
+		return __shader;
+	}
+
+	const Texture2D::Sptr& GetTexture() {
+		if (__texture == nullptr) {
+			Texture2DDescription desc;
+			desc.Width = 4;
+			desc.Height = 4;
+			desc.Format = InternalFormat::RGBA8;
+			__texture = ResourceManager::CreateAsset<Texture2D>(desc);
+		}
+		return __texture;
+	}
+
+	const Material::Sptr& GetMaterial() {
+		if (__material == nullptr) {
+			__material = ResourceManager::CreateAsset<Material>(GetShader());
+			__material->Name = "Benchmark Material";
+			__material->Set("u_Material.AlbedoMap", GetTexture());
+			__material->Set("u_Material.NormalMap", GetTexture());
+			__material->Set("u_Material.SpecularMap", GetTexture());
+			__material->Set("u_Material.EmissiveMap", GetTexture());
+			__material->Set("u_Material.DiscardThreshold", 0.1f);
+			__material->Set("u_Material.Shininess", 0.5f);
+			__material->Set("u_Material.Tint", glm::vec4(1.0f));
+			__material->Set("u_Material.UvScroll", glm::vec2(0.0f));
+			__material->Set("u_Material.UseNormalMap", true);
+		}
+		return __material;
+	}
+
+	const Scene::Sptr& GetFlatScene() {
+		if (__flatScene == nullptr) {
+			__flatScene = std::make_shared<Scene>();
+			__flatScene->DefaultMaterial = GetMaterial();
+
+			for (int ix = 0; ix < FlatSceneSize; ix++) {
+				GameObject::Sptr object = __flatScene->CreateGameObject("Object " + std::to_string(ix));
+				object->SetPostion(glm::vec3(ix * 2.0f, 0.0f, 0.0f));
+
+				RenderComponent::Sptr renderer = object->Add<RenderComponent>();
+				renderer->SetMaterial(GetMaterial());
+
+				if (ix % 2 == 0) {
+					object->Add<RotatingBehaviour>();
+				} else {
+					object->Add<RotatingBehaviourCD>();
+				}
+			}
+		}
+		return __flatScene;
+	}
+
+	const Scene::Sptr& GetDeepScene() {
+		if (__deepScene == nullptr) {
+			__deepScene = std::make_shared<Scene>();
+
+			GameObject::Sptr parent = nullptr;
+			for (int ix = 0; ix < DeepSceneDepth; ix++) {
+				GameObject::Sptr object = __deepScene->CreateGameObject("Node " + std::to_string(ix));
+				object->SetPostion(glm::vec3(1.0f, 0.0f, 0.0f));
+				object->SetRotation(glm::vec3(0.0f, 0.0f, 5.0f));
+				if (parent != nullptr) {
+					parent->AddChild(object);
+				}
+				__deepChain.push_back(object);
+				parent = object;
+			}
+		}
+		return __deepScene;
+	}
+
+	const std::vector<GameObject::Sptr>& GetDeepChain() {
+		GetDeepScene();
+		return __deepChain;
+	}
+}
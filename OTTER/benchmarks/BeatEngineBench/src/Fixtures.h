@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+
+#include "Gameplay/Scene.h"
+#include "Gameplay/Material.h"
+#include "Graphics/ShaderProgram.h"
+#include "Graphics/Textures/Texture2D.h"
+
+/// <summary>
+/// Shared setup for the benchmarks. Everything here is built once on first use and then reused,
+/// so that benchmarks that are run many times during calibration don't rebuild their inputs.
+///
+/// Only components that don't depend on the Application are used, since there is no window or
+/// application running in the benchmark executable.
+/// </summary>
+namespace Fixtures {
+	/// <summary>
+	/// Registers the resource and component types the benchmarks use, must be called before any other fixture
+	/// </summary>
+	void Init();
+	/// <summary>
+	/// Releases all the fixtures that have been created
+	/// </summary>
+	void Cleanup();
+
+	/// <summary>
+	/// Gets a shader whose introspected uniforms look like the engine's deferred material shaders
+	/// </summary>
+	const ShaderProgram::Sptr& GetShader();
+	/// <summary>
+	/// Gets a 4x4 RGBA texture
+	/// </summary>
+	const Texture2D::Sptr& GetTexture();
+	/// <summary>
+	/// Gets a material using GetShader, with all of it's uniforms set
+	/// </summary>
+	const Gameplay::Material::Sptr& GetMaterial();
+
+	/// <summary>
+	/// Gets a scene with a flat list of objects, about the size of a loaded level. Every object has a
+	/// RenderComponent, and alternating objects have a RotatingBehaviour or RotatingBehaviourCD
+	/// </summary>
+	const Gameplay::Scene::Sptr& GetFlatScene();
+	/// <summary>
+	/// The number of objects in the flat scene, not including the scene's camera
+	/// </summary>
+	constexpr int FlatSceneSize = 2000;
+
+	/// <summary>
+	/// Gets a scene containing a single chain of nested objects
+	/// </summary>
+	const Gameplay::Scene::Sptr& GetDeepScene();
+	/// <summary>
+	/// Gets the objects in the deep scene from the root down to the deepest child
+	/// </summary>
+	const std::vector<Gameplay::GameObject::Sptr>& GetDeepChain();
+	/// <summary>
+	/// The number of objects in the deep scene's chain
+	/// </summary>
+	constexpr int DeepSceneDepth = 64;
+}
@@ -0,0 +1,242 @@
+#include "MockGL.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+
+#include "Logging.h"
+
+// The next ID to give out for any created object, we share one counter between all object types
+static GLuint __nextId = 1;
+// The uniforms that new programs will be created with
+static std::vector<MockGL::Uniform> __pendingUniforms;
+// The uniforms that each program reports during introspection, by program ID
+static std::unordered_map<GLuint, std::vector<MockGL::Uniform>> __programUniforms;
+// Memory handed out when the engine maps a buffer, writes into it just go nowhere
+static std::vector<uint8_t> __mappedScratch;
+
+// Stands in for every function we don't mock. On x64 there is a single calling convention where the
+// caller cleans up the stack, so it's safe to call this through any GL function pointer type
+static void* APIENTRY MockNoOp() {
+	return nullptr;
+}
+
+static const GLubyte* APIENTRY MockGetString(GLenum name) {
+	switch (name) {
+		case GL_VERSION:                  return reinterpret_cast<const GLubyte*>("4.6.0 Mock");
+		case GL_VENDOR:                   return reinterpret_cast<const GLubyte*>("BeatEngine");
+		case GL_RENDERER:                 return reinterpret_cast<const GLubyte*>("Mock GL");
+		case GL_SHADING_LANGUAGE_VERSION: return reinterpret_cast<const GLubyte*>("4.60");
+		default:                          return reinterpret_cast<const GLubyte*>("");
+	}
+}
+
+static const GLubyte* APIENTRY MockGetStringi(GLenum name, GLuint index) {
+	// glad needs at least one extension or it will refuse to load
+	return reinterpret_cast<const GLubyte*>("GL_ARB_direct_state_access");
+}
+
+static void APIENTRY MockGetIntegerv(GLenum pname, GLint* data) {
+	switch (pname) {
+		case GL_NUM_EXTENSIONS:                   *data = 1; break;
+		case GL_MAX_TEXTURE_SIZE:                 *data = 16384; break;
+		case GL_MAX_3D_TEXTURE_SIZE:              *data = 2048; break;
+		case GL_MAX_TEXTURE_IMAGE_UNITS:          *data = 32; break;
+		case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS: *data = 192; break;
+		case GL_MAX_UNIFORM_BUFFER_BINDINGS:      *data = 84; break;
+		case GL_MAX_COLOR_ATTACHMENTS:            *data = 8; break;
+		case GL_MAX_SAMPLES:                      *data = 8; break;
+		case GL_MAX_TRANSFORM_FEEDBACK_INTERLEAVED_COMPONENTS: *data = 128; break;
+		case GL_VIEWPORT:
+			data[0] = 0; data[1] = 0; data[2] = 1920; data[3] = 1080;
+			break;
+		default: *data = 0; break;
+	}
+}
+
+static void APIENTRY MockGetFloatv(GLenum pname, GLfloat* data) {
+	*data = pname == GL_MAX_TEXTURE_MAX_ANISOTROPY ? 16.0f : 0.0f;
+}
+
+static GLuint APIENTRY MockCreateShader(GLenum type) {
+	return __nextId++;
+}
+
+static GLuint APIENTRY MockCreateProgram() {
+	GLuint id = __nextId++;
+	__programUniforms[id] = __pendingUniforms;
+	return id;
+}
+
+static void APIENTRY MockDeleteProgram(GLuint program) {
+	__programUniforms.erase(program);
+}
+
+static void APIENTRY MockGenObjects(GLsizei n, GLuint* ids) {
+	for (GLsizei ix = 0; ix < n; ix++) {
+		ids[ix] = __nextId++;
+	}
+}
+
+static void APIENTRY MockCreateTextures(GLenum target, GLsizei n, GLuint* ids) {
+	MockGenObjects(n, ids);
+}
+
+static void APIENTRY MockGetShaderiv(GLuint shader, GLenum pname, GLint* params) {
+	*params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+static void APIENTRY MockGetProgramiv(GLuint program, GLenum pname, GLint* params) {
+	*params = pname == GL_LINK_STATUS ? GL_TRUE : 0;
+}
+
+static void APIENTRY MockGetProgramInterfaceiv(GLuint program, GLenum programInterface, GLenum pname, GLint* params) {
+	*params = 0;
+	if (programInterface == GL_UNIFORM && pname == GL_ACTIVE_RESOURCES) {
+		auto it = __programUniforms.find(program);
+		*params = it != __programUniforms.end() ? static_cast<GLint>(it->second.size()) : 0;
+	}
+}
+
+static void APIENTRY MockGetProgramResourceiv(GLuint program, GLenum programInterface, GLuint index, GLsizei propCount, const GLenum* props, GLsizei bufSize, GLsizei* length, GLint* params) {
+	const MockGL::Uniform* uniform = nullptr;
+	auto it = __programUniforms.find(program);
+	if (programInterface == GL_UNIFORM && it != __programUniforms.end() && index < it->second.size()) {
+		uniform = &it->second[index];
+	}
+
+	GLsizei count = std::min(propCount, bufSize);
+	for (GLsizei ix = 0; ix < count; ix++) {
+		params[ix] = 0;
+		if (uniform == nullptr) continue;
+		switch (props[ix]) {
+			case GL_NAME_LENGTH: params[ix] = static_cast<GLint>(uniform->Name.size() + 1); break;
+			case GL_TYPE:        params[ix] = static_cast<GLint>(uniform->Type); break;
+			case GL_ARRAY_SIZE:  params[ix] = uniform->ArraySize; break;
+			// Locations just need to be unique and not -1, so the index will do
+			case GL_LOCATION:    params[ix] = static_cast<GLint>(index); break;
+			default: break;
+		}
+	}
+	if (length != nullptr) {
+		*length = count;
+	}
+}
+
+static void APIENTRY MockGetProgramResourceName(GLuint program, GLenum programInterface, GLuint index, GLsizei bufSize, GLsizei* length, GLchar* name) {
+	std::string_view source;
+	auto it = __programUniforms.find(program);
+	if (programInterface == GL_UNIFORM && it != __programUniforms.end() && index < it->second.size()) {
+		source = it->second[index].Name;
+	}
+
+	GLsizei count = bufSize > 0 ? std::min(static_cast<GLsizei>(source.size()), bufSize - 1) : 0;
+	if (bufSize > 0) {
+		memcpy(name, source.data(), count);
+		name[count] = '\0';
+	}
+	if (length != nullptr) {
+		*length = count;
+	}
+}
+
+static void APIENTRY MockGetUniformiv(GLuint program, GLint location, GLint* params) {
+	*params = 0;
+}
+
+static GLenum APIENTRY MockCheckFramebufferStatus(GLenum target) {
+	return GL_FRAMEBUFFER_COMPLETE;
+}
+
+static GLenum APIENTRY MockCheckNamedFramebufferStatus(GLuint framebuffer, GLenum target) {
+	return GL_FRAMEBUFFER_COMPLETE;
+}
+
+static void* APIENTRY MockMapNamedBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+	if (__mappedScratch.size() < static_cast<size_t>(length)) {
+		__mappedScratch.resize(length);
+	}
+	return __mappedScratch.data();
+}
+
+static void* APIENTRY MockMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+	return MockMapNamedBufferRange(0, offset, length, access);
+}
+
+static GLboolean APIENTRY MockReturnTrue() {
+	return GL_TRUE;
+}
+
+static void APIENTRY MockGetTextureImage(GLuint texture, GLint level, GLenum format, GLenum type, GLsizei bufSize, void* pixels) {
+	memset(pixels, 0, bufSize);
+}
+
+static void APIENTRY MockGetQueryObjectiv(GLuint id, GLenum pname, GLint* params) {
+	*params = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+}
+
+static void APIENTRY MockGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params) {
+	*params = 0;
+}
+
+static void* MockLoad(const char* name) {
+	static const std::unordered_map<std::string_view, void*> functions = {
+		{ "glGetString",                   reinterpret_cast<void*>(&MockGetString) },
+		{ "glGetStringi",                  reinterpret_cast<void*>(&MockGetStringi) },
+		{ "glGetIntegerv",                 reinterpret_cast<void*>(&MockGetIntegerv) },
+		{ "glGetFloatv",                   reinterpret_cast<void*>(&MockGetFloatv) },
+		{ "glCreateShader",                reinterpret_cast<void*>(&MockCreateShader) },
+		{ "glCreateProgram",               reinterpret_cast<void*>(&MockCreateProgram) },
+		{ "glDeleteProgram",               reinterpret_cast<void*>(&MockDeleteProgram) },
+		{ "glGenBuffers",                  reinterpret_cast<void*>(&MockGenObjects) },
+		{ "glGenTextures",                 reinterpret_cast<void*>(&MockGenObjects) },
+		{ "glGenVertexArrays",             reinterpret_cast<void*>(&MockGenObjects) },
+		{ "glGenFramebuffers",             reinterpret_cast<void*>(&MockGenObjects) },
+		{ "glGenRenderbuffers",            reinterpret_cast<void*>(&MockGenObjects) },
+		{ "glGenQueries",                  reinterpret_cast<void*>(&MockGenObjects) },
+		{ "glCreateBuffers",               reinterpret_cast<void*>(&MockGenObjects) },
+		{ "glCreateVertexArrays",          reinterpret_cast<void*>(&MockGenObjects) },
+		{ "glCreateFramebuffers",          reinterpret_cast<void*>(&MockGenObjects) },
+		{ "glCreateRenderbuffers",         reinterpret_cast<void*>(&MockGenObjects) },
+		{ "glCreateTransformFeedbacks",    reinterpret_cast<void*>(&MockGenObjects) },
+		{ "glCreateQueries",               reinterpret_cast<void*>(&MockCreateTextures) },
+		{ "glCreateTextures",              reinterpret_cast<void*>(&MockCreateTextures) },
+		{ "glGetShaderiv",                 reinterpret_cast<void*>(&MockGetShaderiv) },
+		{ "glGetProgramiv",                reinterpret_cast<void*>(&MockGetProgramiv) },
+		{ "glGetProgramInterfaceiv",       reinterpret_cast<void*>(&MockGetProgramInterfaceiv) },
+		{ "glGetProgramResourceiv",        reinterpret_cast<void*>(&MockGetProgramResourceiv) },
+		{ "glGetProgramResourceName",      reinterpret_cast<void*>(&MockGetProgramResourceName) },
+		{ "glGetUniformiv",                reinterpret_cast<void*>(&MockGetUniformiv) },
+		{ "glCheckFramebufferStatus",      reinterpret_cast<void*>(&MockCheckFramebufferStatus) },
+		{ "glCheckNamedFramebufferStatus", reinterpret_cast<void*>(&MockCheckNamedFramebufferStatus) },
+		{ "glMapBufferRange",              reinterpret_cast<void*>(&MockMapBufferRange) },
+		{ "glMapNamedBufferRange",         reinterpret_cast<void*>(&MockMapNamedBufferRange) },
+		{ "glUnmapBuffer",                 reinterpret_cast<void*>(&MockReturnTrue) },
+		{ "glUnmapNamedBuffer",            reinterpret_cast<void*>(&MockReturnTrue) },
+		{ "glIsTexture",                   reinterpret_cast<void*>(&MockReturnTrue) },
+		{ "glGetTextureImage",             reinterpret_cast<void*>(&MockGetTextureImage) },
+		{ "glGetQueryObjectiv",            reinterpret_cast<void*>(&MockGetQueryObjectiv) },
+		{ "glGetQueryObjectui64v",         reinterpret_cast<void*>(&MockGetQueryObjectui64v) },
+	};
+
+	auto it = functions.find(name);
+	return it != functions.end() ? it->second : reinterpret_cast<void*>(&MockNoOp);
+}
+
+bool MockGL::Install() {
+	if (!gladLoadGLLoader(MockLoad)) {
+		LOG_ERROR("Failed to load the mock GL implementation");
+		return false;
+	}
+	LOG_INFO("Using mock OpenGL {}.{}", GLVersion.major, GLVersion.minor);
+	return true;
+}
+
+void MockGL::SetProgramUniforms(const std::vector<Uniform>& uniforms) {
+	__pendingUniforms = uniforms;
+}
+
+void MockGL::ClearProgramUniforms() {
+	__pendingUniforms.clear();
+}
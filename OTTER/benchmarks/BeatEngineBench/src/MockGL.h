@@ -0,0 +1,43 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+
+/// <summary>
+/// A fake OpenGL implementation that we load through glad in place of a real context, so the engine's
+/// graphics classes can be created and exercised on machines without a GPU (ex: CI runners).
+///
+/// Every GL entry point that has no mock implementation does nothing and returns 0. The calls the engine
+/// depends on the results of (object creation, status checks, limits, shader introspection, buffer mapping)
+/// return plausible values, so resources behave as if they were created successfully.
+/// </summary>
+class MockGL {
+public:
+	MockGL() = delete;
+
+	/// <summary>
+	/// Describes a uniform that programs created by the mock will report during introspection
+	/// </summary>
+	struct Uniform {
+		std::string Name;
+		// The GL type of the uniform (ex: GL_FLOAT_VEC4, GL_SAMPLER_2D)
+		GLenum      Type;
+		int         ArraySize = 1;
+	};
+
+	/// <summary>
+	/// Loads the mock into glad's function pointers, must be called before any GL resources are created
+	/// </summary>
+	/// <returns>True if glad accepted the mock</returns>
+	static bool Install();
+
+	/// <summary>
+	/// Sets the uniforms that the next programs created will report when the engine introspects them,
+	/// this lets materials populate themselves like they would with a real shader
+	/// </summary>
+	static void SetProgramUniforms(const std::vector<Uniform>& uniforms);
+	/// <summary>
+	/// Resets the uniforms for new programs back to none
+	/// </summary>
+	static void ClearProgramUniforms();
+};
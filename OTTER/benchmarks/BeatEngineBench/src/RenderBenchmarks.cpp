@@ -0,0 +1,106 @@
+#include <filesystem>
+
+#include "Bench.h"
+#include "Fixtures.h"
+
+#include "Graphics/Font.h"
+#include "Graphics/GuiBatcher.h"
+
+using namespace Gameplay;
+
+// The number of quads or strings pushed per iteration, about what a busy menu pushes in a frame
+static const int GuiItemsPerFrame = 256;
+
+static const char* BenchFontPath = "fonts/Roboto-Medium.ttf";
+
+// Fonts are baked on first use, since baking isn't what we're measuring
+static const Font::Sptr& GetFont() {
+	static Font::Sptr font;
+	if (font == nullptr && std::filesystem::exists(BenchFontPath)) {
+		font = std::make_shared<Font>(BenchFontPath, 16.0f);
+		font->Bake();
+	}
+	return font;
+}
+
+// Only measures the CPU side, since every GL call lands in the mock
+BENCHMARK(Material_Apply) {
+	const Material::Sptr& material = Fixtures::GetMaterial();
+
+	while (state.KeepRunning()) {
+		material->Apply();
+	}
+}
+
+BENCHMARK(GuiBatcher_PushRect) {
+	const Texture2D::Sptr& texture = Fixtures::GetTexture();
+	GuiBatcher::SetWindowSize({ 1920, 1080 });
+	state.SetItemsPerIteration(GuiItemsPerFrame);
+
+	while (state.KeepRunning()) {
+		for (int ix = 0; ix < GuiItemsPerFrame; ix++) {
+			glm::vec2 min = glm::vec2((ix % 16) * 100.0f, (ix / 16) * 60.0f);
+			GuiBatcher::PushRect(min, min + glm::vec2(90.0f, 50.0f), glm::vec4(1.0f), texture);
+		}
+
+		// Flushing clears the batch so it doesn't grow between iterations, it has it's own benchmark below
+		state.PauseTiming();
+		GuiBatcher::Flush();
+		state.ResumeTiming();
+	}
+}
+
+// Rounded rects are pushed as nine quads, which is what most of the game's panels use
+BENCHMARK(GuiBatcher_PushRect_Rounded) {
+	const Texture2D::Sptr& texture = Fixtures::GetTexture();
+	GuiBatcher::SetWindowSize({ 1920, 1080 });
+	state.SetItemsPerIteration(GuiItemsPerFrame);
+
+	while (state.KeepRunning()) {
+		for (int ix = 0; ix < GuiItemsPerFrame; ix++) {
+			glm::vec2 min = glm::vec2((ix % 16) * 100.0f, (ix / 16) * 60.0f);
+			GuiBatcher::PushRect(min, min + glm::vec2(90.0f, 50.0f), glm::vec4(1.0f), texture, 8);
+		}
+
+		state.PauseTiming();
+		GuiBatcher::Flush();
+		state.ResumeTiming();
+	}
+}
+
+BENCHMARK(GuiBatcher_RenderText) {
+	const Font::Sptr& font = GetFont();
+	if (font == nullptr) {
+		LOG_WARN("\"{}\" not found, run the benchmarks from the BeatEngine res folder", BenchFontPath);
+		return;
+	}
+	GuiBatcher::SetWindowSize({ 1920, 1080 });
+	state.SetItemsPerIteration(GuiItemsPerFrame);
+
+	const std::string text = "Score: 123456";
+	while (state.KeepRunning()) {
+		for (int ix = 0; ix < GuiItemsPerFrame; ix++) {
+			GuiBatcher::RenderText(text, font, glm::vec2(10.0f, ix * 4.0f), glm::vec4(1.0f));
+		}
+
+		state.PauseTiming();
+		GuiBatcher::Flush();
+		state.ResumeTiming();
+	}
+}
+
+BENCHMARK(GuiBatcher_Flush) {
+	const Texture2D::Sptr& texture = Fixtures::GetTexture();
+	GuiBatcher::SetWindowSize({ 1920, 1080 });
+
+	while (state.KeepRunning()) {
+		state.PauseTiming();
+		for (int ix = 0; ix < GuiItemsPerFrame; ix++) {
+			glm::vec2 min = glm::vec2((ix % 16) * 100.0f, (ix / 16) * 60.0f);
+			GuiBatcher::PushRect(min, min + glm::vec2(90.0f, 50.0f), glm::vec4(1.0f), texture);
+		}
+		state.ResumeTiming();
+
+		GuiBatcher::Flush();
+	}
+}
@@ -0,0 +1,83 @@
+#include <filesystem>
+
+#include "Bench.h"
+#include "Fixtures.h"
+
+#include "Utils/OptimizedObjLoader.h"
+#include "Utils/ResourceManager/ResourceManager.h"
+
+using namespace Gameplay;
+
+// A mid sized mesh from the game, so the benchmarks are dominated by parsing rather than file overhead
+static const char* BenchMeshPath = "KBuilding.obj";
+
+// Exposes the OBJ parser on it's own, so we can measure it without the hull baking and file writing
+class ObjParserAccess : public OptimizedObjLoader {
+public:
+	using OptimizedObjLoader::_LoadFromObjFile;
+};
+
+// Returns a path in the temp directory for files the benchmarks write, so we never touch the game's .bin files
+static std::string GetTempPath(const char* filename) {
+	return (std::filesystem::temp_directory_path() / filename).string();
+}
+
+// Looks up a material out of a pool about the size of what the game has loaded
+BENCHMARK(ResourceManager_Get) {
+	static std::vector<Guid> ids;
+	if (ids.empty()) {
+		for (int ix = 0; ix < 500; ix++) {
+			ids.push_back(ResourceManager::CreateAsset<Material>(Fixtures::GetShader())->GetGUID());
+		}
+	}
+
+	size_t index = 0;
+	while (state.KeepRunning()) {
+		Bench::DoNotOptimize(ResourceManager::Get<Material>(ids[index]));
+		index = (index + 1) % ids.size();
+	}
+}
+
+BENCHMARK(ObjLoader_ParseObj) {
+	if (!std::filesystem::exists(BenchMeshPath)) {
+		LOG_WARN("\"{}\" not found, run the benchmarks from the BeatEngine res folder", BenchMeshPath);
+		return;
+	}
+
+	while (state.KeepRunning()) {
+		MeshBuilder<VertexPosNormTexColTangents>* mesh = ObjParserAccess::_LoadFromObjFile(BenchMeshPath);
+		Bench::DoNotOptimize(mesh);
+
+		state.PauseTiming();
+		delete mesh;
+		state.ResumeTiming();
+	}
+}
+
+// The full conversion the game does the first time it sees an OBJ file
+BENCHMARK(ObjLoader_ConvertToBinary) {
+	if (!std::filesystem::exists(BenchMeshPath)) {
+		return;
+	}
+	std::string binPath = GetTempPath("beat_bench_convert.bin");
+
+	while (state.KeepRunning()) {
+		OptimizedObjLoader::ConvertToBinary(BenchMeshPath, binPath);
+	}
+}
+
+// What the game does on every run after the first, reading the binary file and uploading it
+BENCHMARK(ObjLoader_LoadBinary) {
+	if (!std::filesystem::exists(BenchMeshPath)) {
+		return;
+	}
+	static std::string binPath;
+	if (binPath.empty()) {
+		binPath = GetTempPath("beat_bench_load.bin");
+		OptimizedObjLoader::ConvertToBinary(BenchMeshPath, binPath);
+	}
+
+	while (state.KeepRunning()) {
+		Bench::DoNotOptimize(OptimizedObjLoader::LoadFromFile(binPath));
+	}
+}
@@ -0,0 +1,69 @@
+#include "Bench.h"
+#include "Fixtures.h"
+
+using namespace Gameplay;
+
+// Searches for the last object created, so the whole object list is scanned
+BENCHMARK(Scene_FindObjectByName) {
+	const Scene::Sptr& scene = Fixtures::GetFlatScene();
+	const std::string name = "Object " + std::to_string(Fixtures::FlatSceneSize - 1);
+
+	while (state.KeepRunning()) {
+		Bench::DoNotOptimize(scene->FindObjectByName(name));
+	}
+}
+
+BENCHMARK(Scene_FindObjectByName_Missing) {
+	const Scene::Sptr& scene = Fixtures::GetFlatScene();
+	const std::string name = "Not in the scene";
+
+	while (state.KeepRunning()) {
+		Bench::DoNotOptimize(scene->FindObjectByName(name));
+	}
+}
+
+BENCHMARK(Scene_FindObjectByGUID) {
+	const Scene::Sptr& scene = Fixtures::GetFlatScene();
+	const Guid id = scene->FindObjectByName("Object " + std::to_string(Fixtures::FlatSceneSize - 1))->GetGUID();
+
+	while (state.KeepRunning()) {
+		Bench::DoNotOptimize(scene->FindObjectByGUID(id));
+	}
+}
+
+BENCHMARK(Scene_ToJson) {
+	const Scene::Sptr& scene = Fixtures::GetFlatScene();
+	state.SetItemsPerIteration(Fixtures::FlatSceneSize);
+
+	while (state.KeepRunning()) {
+		nlohmann::json blob = scene->ToJson();
+		Bench::DoNotOptimize(blob);
+	}
+}
+
+// Loading also creates the physics world, since that is part of what a scene load costs
+BENCHMARK(Scene_FromJson) {
+	nlohmann::json blob = Fixtures::GetFlatScene()->ToJson();
+	state.SetItemsPerIteration(Fixtures::FlatSceneSize);
+
+	while (state.KeepRunning()) {
+		Scene::Sptr loaded = Scene::FromJson(blob);
+		Bench::DoNotOptimize(loaded);
+
+		// Tearing the scene down isn't what we're measuring
+		state.PauseTiming();
+		loaded = nullptr;
+		state.ResumeTiming();
+	}
+}
+
+// Scenes are saved as text, so this is what loading one from disk costs before FromJson
+BENCHMARK(Scene_ParseJsonText) {
+	std::string text = Fixtures::GetFlatScene()->ToJson().dump(1, '\t');
+	state.SetItemsPerIteration(text.size());
+
+	while (state.KeepRunning()) {
+		nlohmann::json blob = nlohmann::json::parse(text);
+		Bench::DoNotOptimize(blob);
+	}
+}
@@ -0,0 +1,31 @@
+#include "Logging.h"
+#include "Utils/FrameArena.h"
+
+#include "Bench.h"
+#include "Fixtures.h"
+#include "MockGL.h"
+
+// Microbenchmarks for the engine's hot paths. These run against a mock GL layer so they don't need a GPU or a window,
+// results are written to bench_results.json and can be compared against a stored baseline:
+//
+//    BeatEngineBench --save-baseline                       (record a baseline to bench_baseline.json)
+//    BeatEngineBench --baseline bench_baseline.json        (compare against it, exits with 1 if anything regressed)
+//
+// The working directory should be the BeatEngine res folder, since some benchmarks load the game's assets
+int main(int argc, char** args) {
+	Logger::Init();
+	// Benchmarks run the same code as the main loop, which expects the arena to belong to this thread
+	FrameArena::Init();
+
+	Bench::RunOptions options = Bench::RunOptions::Parse(argc, args);
+
+	int result = 1;
+	if (MockGL::Install()) {
+		Fixtures::Init();
+		result = Bench::RunAll(options);
+		Fixtures::Cleanup();
+	}
+
+	Logger::Uninitialize();
+	return result;
+}
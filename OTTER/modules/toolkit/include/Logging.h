@@ -1,8 +1,59 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include "spdlog/spdlog.h"
 #include "spdlog/fmt/ostr.h"
 #include "spdlog/logger.h"
 
+// Log levels for LOG_ACTIVE_LEVEL, these match spdlog's level enum
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_WARN  3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_OFF   6
+
+// Set LOG_ACTIVE_LEVEL in the build config to strip every log call below that level out of the build,
+// their arguments aren't even evaluated. Asserts are never stripped
+#ifndef LOG_ACTIVE_LEVEL
+#ifdef _DEBUG
+#define LOG_ACTIVE_LEVEL LOG_LEVEL_TRACE
+#else
+#define LOG_ACTIVE_LEVEL LOG_LEVEL_INFO
+#endif
+#endif
+
+struct LogEntry;
+
+/*
+	Per call site state for rate limiting and de-duplication, one of these is created by every LOG_* macro.
+	Counters are updated without locking, so under contention the limits are approximate
+*/
+struct LogSite {
+	// The start of the current rate limiting window, in milliseconds
+	std::atomic<int64_t>  WindowStart;
+	// The number of messages that have been let through this window
+	std::atomic<uint32_t> WindowCount;
+	// The number of messages dropped by the rate limit since the last one we printed
+	std::atomic<uint32_t> Suppressed;
+	// The hash of the last message we printed, and when we printed it
+	std::atomic<size_t>   LastHash;
+	std::atomic<int64_t>  LastTime;
+	// The number of times the last message was repeated since we printed it
+	std::atomic<uint32_t> Repeats;
+
+	constexpr LogSite() :
+		WindowStart(0), WindowCount(0), Suppressed(0), LastHash(0), LastTime(0), Repeats(0) {}
+
+	/*
+		Checks the rate limit for this call site, this is done before the message is formatted
+		so that a call site that is being spammed costs as little as possible
+	*/
+	bool Allow();
+};
+
 class Logger {
 public:
 	struct LoggerSettings
@@ -10,8 +61,18 @@ public:
 		bool OutputToFile;
 		bool OutputToConsole;
 		std::string LogFileName;
+		// True to hand messages off to a background thread, false to write them out on the calling thread
+		bool Async;
+		// The number of messages that can be waiting for the background thread, must be a power of 2. When the
+		// queue is full new messages are dropped rather than blocking the caller
+		uint32_t QueueSize;
+		// The most messages a single call site can log per second, zero to disable. Errors are never rate limited
+		uint32_t MaxMessagesPerSecond;
+		// Identical messages from a single call site within this many milliseconds are collapsed, zero to disable
+		uint32_t DuplicateWindowMs;
 		LoggerSettings() :
-			OutputToFile(false), OutputToConsole(true), LogFileName("logs.txt") {}
+			OutputToFile(false), OutputToConsole(true), LogFileName("logs.txt"), Async(true), QueueSize(4096),
+			MaxMessagesPerSecond(20), DuplicateWindowMs(2000) {}
 	};
 	/*
 		Initializes the logging subsystem, and sets up the color logger and debug trace utilities
@@ -24,7 +85,7 @@ public:
 	static void Uninitialize();
 
 	/*
-		Gets the logging instance
+		Gets the logging instance. Writing to it directly skips the queue, rate limiting and de-duplication
 	*/
 	inline static std::shared_ptr<spdlog::logger>& GetLogger() { return myLogger; }
 	/*
@@ -32,16 +93,88 @@ public:
 	*/
 	static std::string DumpStackTrace();
 
+	/*
+		Blocks until every message that has been logged so far has been written out
+	*/
+	static void Flush();
+
+	/*
+		Formats and logs a message from a call site, used by the LOG_* macros
+	*/
+	template <typename... Args>
+	static void Log(LogSite& site, spdlog::level::level_enum level, bool withStackTrace, spdlog::string_view_t format, const Args&... args) {
+		fmt::memory_buffer buffer;
+		fmt::format_to(buffer, format, args...);
+		_Submit(site, level, withStackTrace, spdlog::string_view_t(buffer.data(), buffer.size()));
+	}
+	template <typename T>
+	static void Log(LogSite& site, spdlog::level::level_enum level, bool withStackTrace, const T& message) {
+		if constexpr (std::is_convertible<const T&, spdlog::string_view_t>::value) {
+			_Submit(site, level, withStackTrace, spdlog::string_view_t(message));
+		} else {
+			fmt::memory_buffer buffer;
+			fmt::format_to(buffer, "{}", message);
+			_Submit(site, level, withStackTrace, spdlog::string_view_t(buffer.data(), buffer.size()));
+		}
+	}
+
 private:
 	static std::shared_ptr<spdlog::logger> myLogger;
 	static bool isInitialized;
+	static uint32_t myMaxMessagesPerSecond;
+	static uint32_t myDuplicateWindowMs;
+
+	friend struct LogSite;
+
+	static int64_t _NowMs();
+	static void _Submit(LogSite& site, spdlog::level::level_enum level, bool withStackTrace, spdlog::string_view_t message);
+	// Grabs the raw return addresses on the calling thread, which is cheap compared to resolving them
+	static void _CaptureStackTrace(std::vector<void*>& frames, uint32_t skip);
+	static std::string _SymbolizeStackTrace(const std::vector<void*>& frames);
+	// Writes a message out to the sinks, resolving it's stack trace if it has one
+	static void _Write(const LogEntry& entry);
+	// The body of the background thread, drains the queue until we're uninitialized
+	static void _RunWorker();
 };
 
+// The call site lives in a lambda rather than directly in the macro, since a static isn't allowed in a constexpr function.
+// Errors skip the rate limit so that a spammy site can't hide a different error behind it, repeats are still collapsed
+#define LOG_AT(logLevel, withStackTrace, ...) do { \
+		::LogSite& __logSite = []() -> ::LogSite& { static ::LogSite site; return site; }(); \
+		if ((logLevel) >= ::spdlog::level::err || __logSite.Allow()) { ::Logger::Log(__logSite, logLevel, withStackTrace, __VA_ARGS__); } \
+	} while (false)
+
 // Client log macros
-#define LOG_TRACE(...) ::Logger::GetLogger()->trace(__VA_ARGS__)
-#define LOG_INFO(...)  ::Logger::GetLogger()->info(__VA_ARGS__)
-#define LOG_WARN(...)  ::Logger::GetLogger()->warn(__VA_ARGS__)
-#define LOG_ERROR(...) { ::Logger::GetLogger()->error(__VA_ARGS__); ::Logger::GetLogger()->error("Location: \n{}", ::Logger::DumpStackTrace()); }
+#if LOG_ACTIVE_LEVEL <= LOG_LEVEL_TRACE
+#define LOG_TRACE(...) LOG_AT(::spdlog::level::trace, false, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) ((void)0)
+#endif
+
+#if LOG_ACTIVE_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...)  LOG_AT(::spdlog::level::info, false, __VA_ARGS__)
+#else
+#define LOG_INFO(...)  ((void)0)
+#endif
+
+#if LOG_ACTIVE_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(...)  LOG_AT(::spdlog::level::warn, false, __VA_ARGS__)
+#else
+#define LOG_WARN(...)  ((void)0)
+#endif
+
+// Errors also log the stack trace, which is captured here but resolved on the logging thread
+#if LOG_ACTIVE_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) LOG_AT(::spdlog::level::err, true, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
 
-// Allows us to assert if a value is true, and automagically debug break if it is false
-#define LOG_ASSERT(x, ...) { if (!(x)) { ::Logger::GetLogger()->error(__VA_ARGS__); __debugbreak(); } }
\ No newline at end of file
+// Allows us to assert if a value is true, and automagically debug break if it is false. Asserts are never rate
+// limited, and the log is flushed before we break so that the message is visible
+#define LOG_ASSERT(x, ...) do { if (!(x)) { \
+		::LogSite __logSite; \
+		::Logger::Log(__logSite, ::spdlog::level::err, false, __VA_ARGS__); \
+		::Logger::Flush(); \
+		__debugbreak(); \
+	} } while (false)
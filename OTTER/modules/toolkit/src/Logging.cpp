@@ -1,5 +1,11 @@
 #include "Logging.h"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <string_view>
+#include <thread>
 
 #include "spdlog/common.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
@@ -13,6 +19,152 @@
 
 std::shared_ptr<spdlog::logger> Logger::myLogger;
 bool Logger::isInitialized = false;
+uint32_t Logger::myMaxMessagesPerSecond = 0;
+uint32_t Logger::myDuplicateWindowMs = 0;
+
+// The most frames we'll keep from a stack trace
+static constexpr uint32_t MaxStackFrames = 62;
+
+/*
+	A message waiting to be written out by the logging thread
+*/
+struct LogEntry {
+	spdlog::level::level_enum Level;
+	std::string               Message;
+	// Raw return addresses for errors, resolved to names on the logging thread
+	std::vector<void*>        Frames;
+};
+
+/*
+	A bounded multi-producer queue that never takes a lock, based on Dmitry Vyukov's MPMC queue. Every cell has a
+	sequence number that tells producers and the consumer whose turn it is to use it, so they only ever contend
+	on a single atomic increment
+*/
+class LogQueue {
+public:
+	LogQueue(size_t size) :
+		myCells(new Cell[size]),
+		myMask(size - 1),
+		myEnqueuePos(0),
+		myDequeuePos(0)
+	{
+		for (size_t ix = 0; ix < size; ix++) {
+			myCells[ix].Sequence.store(ix, std::memory_order_relaxed);
+		}
+	}
+
+	bool TryPush(LogEntry&& entry) {
+		Cell* cell;
+		size_t pos = myEnqueuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			cell = &myCells[pos & myMask];
+			size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+			if (diff == 0) {
+				if (myEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			}
+			// The consumer hasn't freed up this cell yet, so the queue is full
+			else if (diff < 0) {
+				return false;
+			}
+			else {
+				pos = myEnqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+		cell->Data = std::move(entry);
+		cell->Sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool TryPop(LogEntry& entry) {
+		Cell* cell;
+		size_t pos = myDequeuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			cell = &myCells[pos & myMask];
+			size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+			if (diff == 0) {
+				if (myDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			}
+			// Nothing has been written to this cell yet, so the queue is empty
+			else if (diff < 0) {
+				return false;
+			}
+			else {
+				pos = myDequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+		entry = std::move(cell->Data);
+		cell->Sequence.store(pos + myMask + 1, std::memory_order_release);
+		return true;
+	}
+
+private:
+	struct Cell {
+		std::atomic<size_t> Sequence;
+		LogEntry            Data;
+	};
+
+	std::unique_ptr<Cell[]> myCells;
+	size_t                  myMask;
+	// Kept on separate cache lines so producers and the consumer don't fight over them
+	alignas(64) std::atomic<size_t> myEnqueuePos;
+	alignas(64) std::atomic<size_t> myDequeuePos;
+};
+
+/*
+	Everything the logging thread needs, kept out of the header so that including Logging.h stays cheap
+*/
+struct AsyncLogState {
+	std::unique_ptr<LogQueue> Queue;
+	std::thread               Worker;
+	std::atomic<bool>         Running{ false };
+	// Lets producers skip the wake up when the worker is already busy
+	std::atomic<bool>         Sleeping{ false };
+	std::mutex                WakeLock;
+	std::condition_variable   WakeSignal;
+	// Used to figure out when everything logged before a flush has been written
+	std::atomic<uint64_t>     Submitted{ 0 };
+	std::atomic<uint64_t>     Written{ 0 };
+	// Messages we've thrown away because the queue was full
+	std::atomic<uint32_t>     Dropped{ 0 };
+	// Cleared at the start of shutdown so that no new messages are taken
+	std::atomic<bool>         Accepting{ false };
+	// The number of threads currently using the logger, shutdown waits for these before tearing it down
+	std::atomic<uint32_t>     InFlight{ 0 };
+
+	// If we're torn down without being uninitialized (ex: exit() was called), we still need to stop the thread
+	~AsyncLogState() {
+		if (Worker.joinable()) {
+			Running = false;
+			WakeSignal.notify_one();
+			Worker.join();
+		}
+	}
+};
+static AsyncLogState AsyncState;
+
+/*
+	Marks the calling thread as using the logger until the end of the scope. The count goes up before we check
+	Accepting, so Uninitialize either sees us and waits, or we see that it's shutting down and back off
+*/
+struct LoggerUseScope {
+	bool Entered;
+	LoggerUseScope() {
+		AsyncState.InFlight.fetch_add(1);
+		Entered = AsyncState.Accepting.load();
+	}
+	~LoggerUseScope() {
+		AsyncState.InFlight.fetch_sub(1);
+	}
+};
+
+// DbgHelp is single threaded, so all symbol lookups need to hold this
+static std::mutex SymbolLock;
 
 void Logger::Init(const LoggerSettings& settings) {
 	if (!isInitialized) {
@@ -33,6 +185,8 @@ void Logger::Init(const LoggerSettings& settings) {
 
 		// Our log level is set to trace (the highest) by default
 		myLogger->set_level(spdlog::level::trace);
+		// Errors are usually followed by a crash, so make sure they make it to disk
+		myLogger->flush_on(spdlog::level::err);
 		// The default color for trace is the same as info, so we get our color output
 		auto console_sink = dynamic_cast<spdlog::sinks::stdout_color_sink_mt*>(myLogger->sinks().back().get());
 		// and make trace cyan instead
@@ -47,6 +201,24 @@ void Logger::Init(const LoggerSettings& settings) {
 		SymSetOptions(SYMOPT_LOAD_LINES);
 		#endif
 
+		myMaxMessagesPerSecond = settings.MaxMessagesPerSecond;
+		myDuplicateWindowMs = settings.DuplicateWindowMs;
+
+		// Start up the logging thread, the queue size needs to be a power of 2 for the index masking to work
+		if (settings.Async) {
+			size_t queueSize = 1;
+			while (queueSize < settings.QueueSize) {
+				queueSize <<= 1;
+			}
+			// Other threads could still be racing a shutdown, so the queue is kept around once it's been created
+			if (AsyncState.Queue == nullptr) {
+				AsyncState.Queue = std::make_unique<LogQueue>(queueSize);
+			}
+			AsyncState.Running = true;
+			AsyncState.Worker = std::thread(&Logger::_RunWorker);
+		}
+
+		AsyncState.Accepting = true;
 		isInitialized = true;
 	}
 }
@@ -54,67 +226,168 @@ void Logger::Init(const LoggerSettings& settings) {
 void Logger::Uninitialize()
 {
 	if (isInitialized) {
+		// Stop taking new messages, and wait for anyone that got in before us to finish with the logger
+		AsyncState.Accepting = false;
+		while (AsyncState.InFlight.load() > 0) {
+			std::this_thread::yield();
+		}
+
+		// Let the logging thread drain anything that's still queued up before we tear down the sinks
+		if (AsyncState.Worker.joinable()) {
+			AsyncState.Running = false;
+			AsyncState.WakeSignal.notify_one();
+			AsyncState.Worker.join();
+		}
+
 		#ifdef WINDOWS 
 		HANDLE process = GetCurrentProcess();
 		SymCleanup(process);
 		#endif
 		myLogger = nullptr;
 		spdlog::shutdown();
+		isInitialized = false;
 	}
 }
 
 std::string Logger::DumpStackTrace()
+{
+	std::vector<void*> frames;
+	// Bypass this frame
+	_CaptureStackTrace(frames, 1);
+	return _SymbolizeStackTrace(frames);
+}
+
+void Logger::Flush()
+{
+	LoggerUseScope scope;
+	if (!scope.Entered) {
+		return;
+	}
+
+	// Wait for the logging thread to catch up to everything that was submitted before now
+	if (AsyncState.Running) {
+		uint64_t target = AsyncState.Submitted.load();
+		while (AsyncState.Written.load() < target && AsyncState.Running) {
+			AsyncState.WakeSignal.notify_one();
+			std::this_thread::yield();
+		}
+	}
+	myLogger->flush();
+}
+
+bool LogSite::Allow()
+{
+	if (Logger::myMaxMessagesPerSecond == 0) {
+		return true;
+	}
+
+	// Start a new window once a second has passed, whoever wins the exchange resets the count
+	int64_t now = Logger::_NowMs();
+	int64_t windowStart = WindowStart.load(std::memory_order_relaxed);
+	if (now - windowStart >= 1000 && WindowStart.compare_exchange_strong(windowStart, now, std::memory_order_relaxed)) {
+		WindowCount.store(0, std::memory_order_relaxed);
+	}
+
+	if (WindowCount.fetch_add(1, std::memory_order_relaxed) < Logger::myMaxMessagesPerSecond) {
+		return true;
+	}
+	Suppressed.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+int64_t Logger::_NowMs()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Logger::_Submit(LogSite& site, spdlog::level::level_enum level, bool withStackTrace, spdlog::string_view_t message)
+{
+	// Logging before init or after shutdown has nowhere to go
+	LoggerUseScope scope;
+	if (!scope.Entered) {
+		return;
+	}
+
+	// Collapse a message that's identical to the last one from this call site
+	int64_t now = _NowMs();
+	size_t hash = std::hash<std::string_view>()(std::string_view(message.data(), message.size()));
+	if (myDuplicateWindowMs > 0 && hash == site.LastHash.load(std::memory_order_relaxed) &&
+		now - site.LastTime.load(std::memory_order_relaxed) < myDuplicateWindowMs) {
+		site.Repeats.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	site.LastHash.store(hash, std::memory_order_relaxed);
+	site.LastTime.store(now, std::memory_order_relaxed);
+
+	LogEntry entry;
+	entry.Level = level;
+	entry.Message.assign(message.data(), message.size());
+
+	// Let the reader know about anything we held back from this call site since the last message
+	uint32_t repeats = site.Repeats.exchange(0, std::memory_order_relaxed);
+	uint32_t suppressed = site.Suppressed.exchange(0, std::memory_order_relaxed);
+	if (repeats > 0) {
+		fmt::format_to(std::back_inserter(entry.Message), " (previous message repeated {} times)", repeats);
+	}
+	if (suppressed > 0) {
+		fmt::format_to(std::back_inserter(entry.Message), " ({} messages rate limited)", suppressed);
+	}
+
+	if (withStackTrace) {
+		// Skip ourselves and Log, so the trace starts at whoever logged the error
+		_CaptureStackTrace(entry.Frames, 2);
+	}
+
+	// Without a logging thread we write straight to the sinks
+	if (!AsyncState.Running) {
+		_Write(entry);
+		return;
+	}
+
+	// We never block the caller, if the logging thread can't keep up the message is dropped and counted
+	AsyncState.Submitted.fetch_add(1);
+	if (!AsyncState.Queue->TryPush(std::move(entry))) {
+		AsyncState.Submitted.fetch_sub(1);
+		AsyncState.Dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	if (AsyncState.Sleeping.load(std::memory_order_relaxed) || level >= spdlog::level::err) {
+		AsyncState.WakeSignal.notify_one();
+	}
+}
+
+void Logger::_CaptureStackTrace(std::vector<void*>& frames, uint32_t skip)
+{
+	frames.clear();
+#ifdef WINDOWS
+	void* buffer[MaxStackFrames];
+	// Skip this frame as well as whatever the caller asked for
+	USHORT count = RtlCaptureStackBackTrace(skip + 1, MaxStackFrames, buffer, NULL);
+	frames.assign(buffer, buffer + count);
+#endif
+}
+
+std::string Logger::_SymbolizeStackTrace(const std::vector<void*>& frames)
 {
 	std::stringstream ss;
 
-	// Windows implementation taken from http://www.rioki.org/2017/01/09/windows_stacktrace.html
+	// Windows implementation adapted from http://www.rioki.org/2017/01/09/windows_stacktrace.html
 #ifdef WINDOWS
-	// We will always assume x64, since that is our only supported project architecture
-	DWORD machine = IMAGE_FILE_MACHINE_AMD64;
+	std::lock_guard<std::mutex> lock(SymbolLock);
 
 	// Get the process handle
 	HANDLE process = GetCurrentProcess();
-	// Get the current thread handle
-	HANDLE thread = GetCurrentThread();
-	// Prep our context info
-	CONTEXT context = {};
-	context.ContextFlags = CONTEXT_FULL;
-	// Capture our device context (registers and everything)
-	RtlCaptureContext(&context);
-
-	// Prepare our stack frame
-	STACKFRAME frame = {};
-	frame.AddrPC.Offset = context.Rip; // This is our instruction pointer in register RIP
-	frame.AddrPC.Mode = AddrModeFlat;
-	frame.AddrFrame.Offset = context.Rbp; // This is the address of our frame, stored in RBP
-	frame.AddrFrame.Mode = AddrModeFlat;
-	frame.AddrStack.Offset = context.Rsp; // This is the address of the stack, stored in RSP
-	frame.AddrStack.Mode = AddrModeFlat;
-
-	// Bypass this frame
-	StackWalk(machine, process, thread, &frame, &context, NULL, SymFunctionTableAccess, SymGetModuleBase, NULL);
 
 	// Iterate over all frames in the stack
-	while (StackWalk(machine, process, thread, &frame, &context, NULL, SymFunctionTableAccess, SymGetModuleBase, NULL))
+	for (void* frame : frames)
 	{
 		// The address of the function
-		DWORD64 functionAddress;
+		DWORD64 functionAddress = reinterpret_cast<DWORD64>(frame);
 		// Stores the output information
-		std::string moduleName, functionName, file;
+		std::string functionName, file;
 		// Stores the line
 		unsigned int line = 0;
 
-		// Extract the function address from the current frame
-		functionAddress = frame.AddrPC.Offset;
-
-		// Get the module that the address is part of
-		DWORD64 moduleBase = SymGetModuleBase(process, frame.AddrPC.Offset);
-		// Get the name of the module, store it in buffer
-		char moduleBuff[MAX_PATH];
-		if (moduleBase && GetModuleFileNameA(reinterpret_cast<HINSTANCE>(moduleBase), moduleBuff, MAX_PATH)) {
-			moduleName = moduleBuff;
-		}
-
 		// Prepare a buffer to hold the symbol and it's name
 		char symbolBuffer[sizeof(IMAGEHLP_SYMBOL) + 255];
 		PIMAGEHLP_SYMBOL symbol = (PIMAGEHLP_SYMBOL)symbolBuffer;
@@ -146,3 +419,44 @@ std::string Logger::DumpStackTrace()
 	return ss.str();
 }
 
+void Logger::_Write(const LogEntry& entry)
+{
+	myLogger->log(entry.Level, spdlog::string_view_t(entry.Message));
+	if (!entry.Frames.empty()) {
+		myLogger->log(entry.Level, "Location: \n{}", _SymbolizeStackTrace(entry.Frames));
+	}
+}
+
+void Logger::_RunWorker()
+{
+	LogEntry entry;
+	for (;;) {
+		// Check if we should stop before we drain the queue, so anything pushed before Running was cleared still
+		// gets written out on our last pass
+		bool stopping = !AsyncState.Running;
+		bool wroteAny = false;
+		while (AsyncState.Queue->TryPop(entry)) {
+			_Write(entry);
+			AsyncState.Written.fetch_add(1);
+			wroteAny = true;
+		}
+
+		uint32_t dropped = AsyncState.Dropped.exchange(0, std::memory_order_relaxed);
+		if (dropped > 0) {
+			myLogger->warn("Dropped {} log messages, the log queue was full", dropped);
+		}
+
+		if (stopping) {
+			break;
+		}
+
+		// Nap until someone logs something, we also wake up on a timer in case we missed a notification
+		if (!wroteAny) {
+			std::unique_lock<std::mutex> lock(AsyncState.WakeLock);
+			AsyncState.Sleeping = true;
+			AsyncState.WakeSignal.wait_for(lock, std::chrono::milliseconds(10));
+			AsyncState.Sleeping = false;
+		}
+	}
+	myLogger->flush();
+}
@@ -0,0 +1,56 @@
+#version 430
+
+// Blurs a 16x16 tile of the image per work group with a separable kernel. The tile and the texels around it that the
+// kernel reaches are loaded into shared memory once, then blurred along x and y without touching the texture again.
+// See BlurPasses
+
+#define TILE_SIZE  16
+// Must match BlurPasses::MaxComputeRadius
+#define MAX_RADIUS 8
+#define REGION     (TILE_SIZE + 2 * MAX_RADIUS)
+
+layout(local_size_x = TILE_SIZE, local_size_y = TILE_SIZE) in;
+
+uniform layout(binding = 0) sampler2D s_Image;
+layout(binding = 0, rgba8) uniform writeonly image2D i_Output;
+
+uniform float u_Row[2 * MAX_RADIUS + 1];
+uniform float u_Column[2 * MAX_RADIUS + 1];
+uniform int   u_Radius;
+
+shared vec4 s_Region[REGION][REGION];
+shared vec4 s_Rows[REGION][TILE_SIZE];
+
+void main() {
+    ivec2 size = textureSize(s_Image, 0);
+    ivec2 origin = ivec2(gl_WorkGroupID.xy) * TILE_SIZE - MAX_RADIUS;
+    ivec2 local = ivec2(gl_LocalInvocationID.xy);
+
+    // Every thread loads up to 4 texels of the region, clamping at the edges of the image
+    for (int y = local.y; y < REGION; y += TILE_SIZE) {
+        for (int x = local.x; x < REGION; x += TILE_SIZE) {
+            s_Region[y][x] = texelFetch(s_Image, clamp(origin + ivec2(x, y), ivec2(0), size - 1), 0);
+        }
+    }
+    barrier();
+
+    // Blur along x for every row in the region, so that the vertical pass has the rows above and below the tile
+    for (int y = local.y; y < REGION; y += TILE_SIZE) {
+        vec4 accumulator = vec4(0);
+        for (int ix = -u_Radius; ix <= u_Radius; ix++) {
+            accumulator += s_Region[y][local.x + MAX_RADIUS + ix] * u_Row[ix + u_Radius];
+        }
+        s_Rows[y][local.x] = accumulator;
+    }
+    barrier();
+
+    vec4 result = vec4(0);
+    for (int iy = -u_Radius; iy <= u_Radius; iy++) {
+        result += s_Rows[local.y + MAX_RADIUS + iy][local.x] * u_Column[iy + u_Radius];
+    }
+
+    ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+    if (all(lessThan(pixel, imageSize(i_Output)))) {
+        imageStore(i_Output, pixel, result);
+    }
+}
@@ -3,10 +3,12 @@
 #include "../fragments/fs_common_inputs.glsl"
 
 // We output a single color to the color buffer
-layout(location = 0) out vec4 albedo_specPower;
-layout(location = 1) out vec4 normal_metallic;
+layout(location = 0) out vec4 albedo;
+layout(location = 1) out vec4 normal_material;
 layout(location = 2) out vec4 emissive;
-layout(location = 3) out vec3 view_pos;
+// Only attached while the G-Buffer is being validated, see RenderLayer::SetGBufferValidationEnabled
+layout(location = 3) out vec4 reference_viewPos;
+layout(location = 4) out vec4 reference_normal;
 
 // Represents a collection of attributes that would define a material
 // For instance, you can think of this like material settings in 
@@ -22,6 +24,7 @@ struct Material {
 uniform Material u_Material;
 
 #include "../fragments/frame_uniforms.glsl"
+#include "../fragments/gbuffer_encoding.glsl"
 
 // https://learnopengl.com/Advanced-Lighting/Advanced-Lighting
 void main() {
@@ -36,8 +39,8 @@ void main() {
 		discard;
 	}
 
-	// Extract albedo from material, and store shininess
-	albedo_specPower = vec4(albedoColor.rgb, 1.0f); //lightingParams.x);
+	// Extract albedo from material
+	albedo = vec4(albedoColor.rgb, 1.0f);
 
 	// Normalize our input normal
     // Read our tangent from the map, and convert from the [0,1] range to [-1,1] range
@@ -47,12 +50,12 @@ void main() {
     // Here we apply the TBN matrix to transform the normal from tangent space to view space
     normal = normalize(inTBN * normal);
 	
-	// Map [-1, 1] to [0, 1]
-	normal = clamp((normal + 1) / 2.0, 0, 1);
-	normal_metallic = vec4(normal, lightingParams.y);
+	// Pack the normal with our metallic and shininess
+	normal_material = EncodeGBufferSurface(normal, lightingParams.y, 1.0f); //lightingParams.x);
 
 	// Extract emissive from the material
 	emissive = texture(u_Material.EmissiveMap, inUV);
 
-	view_pos = inViewPos;
+	reference_viewPos = vec4(inViewPos, 1.0f);
+	reference_normal = vec4(normal, 1.0f);
 }
\ No newline at end of file
@@ -9,6 +9,7 @@ layout(location = 7) in vec4 inTextureWeights;
 ////////////////////////////////////////////////////////////////
 
 #include "../fragments/frame_uniforms.glsl"
+#include "../fragments/gbuffer_encoding.glsl"
 
 ////////////////////////////////////////////////////////////////
 /////////////// Instance Level Uniforms ////////////////////////
@@ -35,10 +36,12 @@ uniform Material u_Material;
 ////////////////////////////////////////////////////////////////
 
 // We output a single color to the color buffer
-layout(location = 0) out vec4 albedo_specPower;
-layout(location = 1) out vec4 normal_metallic;
+layout(location = 0) out vec4 albedo;
+layout(location = 1) out vec4 normal_material;
 layout(location = 2) out vec4 emissive;
-layout(location = 3) out vec3 view_pos;
+// Only attached while the G-Buffer is being validated, see RenderLayer::SetGBufferValidationEnabled
+layout(location = 3) out vec4 reference_viewPos;
+layout(location = 4) out vec4 reference_normal;
 
 // https://learnopengl.com/Advanced-Lighting/Advanced-Lighting
 void main() {
@@ -53,8 +56,8 @@ void main() {
 		discard;
 	}
 
-	// Extract albedo from material, and store shininess
-	albedo_specPower = vec4(albedoColor.rgb, u_Material.Shininess);
+	// Extract albedo from material
+	albedo = vec4(albedoColor.rgb, 1.0f);
 	
 	// Normalize our input normal
 	vec3 normal = normalize(
@@ -66,14 +69,14 @@ void main() {
     // Here we apply the TBN matrix to transform the normal from tangent space to view space
     normal = normalize(inTBN * normal);
 	
-	// Map [-1, 1] to [0, 1]
-	normal = clamp((normal + 1) / 2.0, 0, 1);
-	normal_metallic = vec4(normal, 0.0f);
+	// Pack the normal with our metallic and shininess
+	normal_material = EncodeGBufferSurface(normal, 0.0f, u_Material.Shininess);
 
 	// Extract emissive from the material
 	emissive = 
 		texture(u_Material.EmissiveA, inUV).rgba * inTextureWeights.x +
 		texture(u_Material.EmissiveB, inUV).rgba * inTextureWeights.y;
 		
-	view_pos = inViewPos;
+	reference_viewPos = vec4(inViewPos, 1.0f);
+	reference_normal = vec4(normal, 1.0f);
 }
\ No newline at end of file
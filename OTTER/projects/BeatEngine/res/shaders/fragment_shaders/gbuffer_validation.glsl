@@ -0,0 +1,59 @@
+#version 430
+
+// Compares what the lighting passes read back from the compact G-Buffer against reference values written at full
+// precision by the G-Buffer shaders. Errors are scaled by the tolerances, so anything at full intensity is over
+//     R: Angle between the decoded normal and the reference normal
+//     G: Distance between the re-constructed position and the reference position, relative to it's depth
+//     B: Angle the previous encoding (xyz in 8 bits per channel) would have had, for comparison with R
+// Pixels that one encoding thinks have a surface and the other doesn't are drawn in magenta
+
+layout(location = 0) in vec2 inUV;
+layout(location = 0) out vec4 outColor;
+
+uniform layout(binding = 5) sampler2D s_ReferencePosition;
+uniform layout(binding = 6) sampler2D s_ReferenceNormal;
+
+// The normal error in degrees that maps to full intensity
+uniform float u_NormalTolerance;
+// The relative position error that maps to full intensity
+uniform float u_PositionTolerance;
+
+#include "../fragments/frame_uniforms.glsl"
+#include "../fragments/deferred_post_common.glsl"
+
+float AngleBetween(vec3 a, vec3 b) {
+    return degrees(acos(clamp(dot(a, b), -1.0, 1.0)));
+}
+
+void main() {
+    vec3 normal = GetNormal(inUV);
+    vec4 reference = texture(s_ReferenceNormal, inUV);
+
+    bool hasSurface = length(normal) > 0.1;
+    bool hasReference = reference.w > 0.0;
+    if (hasSurface != hasReference) {
+        outColor = vec4(1.0, 0.0, 1.0, 1.0);
+        return;
+    }
+    if (!hasSurface) {
+        outColor = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+
+    vec3 referenceNormal = normalize(reference.xyz);
+    float normalError = AngleBetween(normal, referenceNormal);
+
+    // Quantize the reference the same way the old normal target did
+    vec3 legacy = round((referenceNormal * 0.5 + 0.5) * 255.0) / 255.0 * 2.0 - 1.0;
+    float legacyError = AngleBetween(normalize(legacy), referenceNormal);
+
+    vec3 referencePos = texture(s_ReferencePosition, inUV).xyz;
+    float positionError = distance(GetViewPosition(inUV), referencePos) / max(abs(referencePos.z), u_ZNear);
+
+    outColor = vec4(
+        normalError / u_NormalTolerance,
+        positionError / u_PositionTolerance,
+        legacyError / u_NormalTolerance,
+        1.0
+    );
+}
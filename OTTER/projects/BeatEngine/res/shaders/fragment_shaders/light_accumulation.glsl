@@ -29,10 +29,10 @@ layout (std140, binding = 2) uniform b_LightBlock {
 	mat3  EnvironmentRotation;
 };
 
-#include "../fragments/deferred_post_common.glsl"
-
 #include "../fragments/frame_uniforms.glsl"
 
+#include "../fragments/deferred_post_common.glsl"
+
 // Calculates the contribution the given point light has 
 // for the current fragment
 // @param viewPos   The fragment's position in view space
@@ -69,10 +69,9 @@ void main() {
 
     normal = normalize(normal);
 
-    vec3 albedo = GetAlbedo(inUV);
     vec3 viewPos = GetViewPosition(inUV);
     
-    float specularPow = texture(s_AlbedoSpec, inUV).a;
+    float specularPow = GetSpecularPower(inUV);
 
     vec3 diffuse = vec3(0);
     vec3 specular = vec3(0);
@@ -0,0 +1,37 @@
+#version 430
+
+// Renders the image in slot 0 into a target half it's size, for building downsample chains. See BlurPasses
+
+layout(location = 0) in vec2 inUV;
+layout(location = 0) out vec4 outColor;
+
+uniform layout(binding = 0) sampler2D s_Image;
+uniform layout(binding = 1) sampler2D s_Depth;
+
+// See DownsampleAlpha, 0 averages alpha, 1 stores the nearest distance from s_Depth, 2 keeps the smallest alpha
+uniform int u_AlphaMode;
+
+#include "../../../fragments/frame_uniforms.glsl"
+#include "../../../fragments/view_distance.glsl"
+
+void main() {
+    // The output texel covers a 2x2 block of the input, so a bilinear tap at it's center averages the block
+    vec4 result = texture(s_Image, inUV);
+
+    if (u_AlphaMode == 1) {
+        // Keep the nearest surface, so foreground objects don't get pushed back by what's behind them
+        vec2 texelSize = 1.0 / textureSize(s_Depth, 0);
+        result.a = 1.0e30;
+        for (int iy = 0; iy < 2; iy++) {
+            for (int ix = 0; ix < 2; ix++) {
+                vec2 uv = inUV + (vec2(ix, iy) - 0.5) * texelSize;
+                result.a = min(result.a, DepthToDist(uv, texelFetch(s_Depth, ivec2(uv / texelSize), 0).r));
+            }
+        }
+    } else if (u_AlphaMode == 2) {
+        vec4 alphas = textureGather(s_Image, inUV, 3);
+        result.a = min(min(alphas.x, alphas.y), min(alphas.z, alphas.w));
+    }
+
+    outColor = result;
+}
@@ -0,0 +1,22 @@
+#version 430
+
+// One half of a separable blur, run once along each axis. See BlurPasses
+
+layout(location = 0) in vec2 inUV;
+layout(location = 0) out vec4 outColor;
+
+uniform layout(binding = 0) sampler2D s_Image;
+
+// Enough for 32 texels either side, see BlurPasses::MaxRadius
+uniform float u_Weights[65];
+uniform int   u_Radius;
+// The distance between taps in UV space, one texel along the axis we're blurring
+uniform vec2  u_Step;
+
+void main() {
+    vec4 accumulator = vec4(0);
+    for (int ix = -u_Radius; ix <= u_Radius; ix++) {
+        accumulator += texture(s_Image, inUV + u_Step * ix) * u_Weights[ix + u_Radius];
+    }
+    outColor = accumulator;
+}
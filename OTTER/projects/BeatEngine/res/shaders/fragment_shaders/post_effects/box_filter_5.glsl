@@ -1,7 +1,7 @@
 #version 430
 
 layout(location = 0) in vec2 inUV;
-layout(location = 0) out vec3 outColor;
+layout(location = 0) out vec4 outColor;
 
 uniform layout(binding = 0) sampler2D s_Image;
 
@@ -17,5 +17,5 @@ void main() {
             accumulator += texture(s_Image, uv).rgb * u_Filter[index];
         }
     }
-    outColor = accumulator;
+    outColor = vec4(accumulator, 1.0);
 }
@@ -1,7 +1,6 @@
 #version 440
 
-// Modified from:
-// http://tuxedolabs.blogspot.com/2018/05/bokeh-depth-of-field-in-single-pass.html
+// The full resolution path for the depth of field effect, see dof_gather.glsl for the downsampled one
 
 layout(location = 0) in vec2 inUV;
 
@@ -13,36 +12,10 @@ layout(binding = 0) uniform sampler2D a_Sampler;
 layout(binding = 1) uniform sampler2D a_Depth;
 
 #include "../../fragments/frame_uniforms.glsl"
+#include "../../fragments/dof_common.glsl"
 
-const float GOLDEN_ANGLE = 2.39996323;
-const float MAX_BLUR_RADIUS = 20; // We impose a hard limit on blurring to avoid killing the GPU
-const float RAD_SCALE = 0.5;
-
-// Converts a screen space coord and a raw depth value into a world-space distance
-// @param screen The screen-space coordinate to convert
-// @param rawValue The raw, non-linear depth value to convert
-// @returns A distance to the camera in world units
-float DepthToDist(vec2 screen, float rawValue) {
-	vec4 screenPos = vec4(screen.x, screen.y, rawValue, 1.0) * 2.0 - 1.0;
-	vec4 viewPosition = u_InvProjection * screenPos;
-
-	return -(viewPosition.z / viewPosition.w);
-}
-
-/*
-* Calculates the Circle of Confusion for a given depth value
-* @param depth The depth of the fragment to caluculate for (in world units)
-* @param focalPlane The distance from the lense to the focal plane (in world units)
-* @param focalLength The focal length parameter (calculated as 1/F = 1/focalPlane + 1/distToSensor)
-* @see http://fileadmin.cs.lth.se/cs/Education/EDAN35/lectures/12DOF.pdf
-*/
-float getBlurSize(float depth, float focalPlane, float focalLength) {
-	float coc = clamp(
-        (focalLength * (focalPlane - depth)) / 
-        (depth * (focalPlane - focalLength)), 
-        -1.0, 1.0);
-	return abs(coc) * u_Aperture;
-}
+// We impose a hard limit on blurring to avoid killing the GPU
+uniform float u_MaxBlurRadius;
 
 /*
 * Calculates our color for the depth of field effect
@@ -64,7 +37,7 @@ vec3 depthOfField(vec2 texCoord, float focusPoint, float focusLength) {
 
     // We'll blur our fragment outward in a circle
     float radius = RAD_SCALE;
-    for (float ang = 0.0; radius < min(u_Aperture, MAX_BLUR_RADIUS); ang += GOLDEN_ANGLE)
+    for (float ang = 0.0; radius < min(u_Aperture, u_MaxBlurRadius); ang += GOLDEN_ANGLE)
     {
         // Determine the UV coord of the fragment we want to blur
         vec2 tc = texCoord + vec2(cos(ang), sin(ang)) * texelSize * radius;
@@ -90,7 +63,7 @@ vec3 depthOfField(vec2 texCoord, float focusPoint, float focusLength) {
 
 void main() {
     // Calculate our focal length
-    float focalLength = 1.0f / (1.0 / u_FocalDepth + 1.0 / u_LensDepth);
+    float focalLength = getFocalLength();
     // Perform our DOF blurring
     vec3 dof = depthOfField(inUV, u_FocalDepth, focalLength);
     // Return the result
@@ -0,0 +1,38 @@
+#version 440
+
+// Brings the downsampled depth of field result back up to full resolution, blending it over the sharp image based on
+// the circle of confusion at each pixel
+
+layout(location = 0) in vec2 inUV;
+
+layout(location = 0) out vec4 outColor;
+
+// The sharp, full resolution image
+layout(binding = 0) uniform sampler2D s_Image;
+// The depth buffer to use (non-linearized)
+layout(binding = 1) uniform sampler2D s_Depth;
+// The output of dof_gather.glsl
+layout(binding = 2) uniform sampler2D s_Blurred;
+// The input to dof_gather.glsl, with the distance to the camera in alpha
+layout(binding = 3) uniform sampler2D s_Distance;
+
+#include "../../fragments/frame_uniforms.glsl"
+#include "../../fragments/dof_common.glsl"
+#include "../../fragments/bilateral_upsample.glsl"
+
+// The size of the blurred image relative to the full resolution image
+uniform float u_Scale;
+
+void main() {
+    vec2 texelSize = 1.0 / textureSize(s_Depth, 0);
+    float depth = DepthToDist(inUV, texelFetch(s_Depth, ivec2(inUV / texelSize), 0).r);
+    float coc = getBlurSize(depth, u_FocalDepth, getFocalLength());
+
+    vec3 sharp = texture(s_Image, inUV).rgb;
+    vec4 blurred = BilateralUpsample(s_Blurred, s_Distance, inUV, depth, 8.0);
+
+    // Pixels whose blur would be smaller than a single low resolution texel keep (some of) their full resolution detail,
+    // unless the blur from something in front of them covers them, like the full resolution shader lets it
+    float blend = max(smoothstep(RAD_SCALE, 1.0 / u_Scale, coc), smoothstep(0.0, 0.25, blurred.a));
+    outColor = vec4(mix(sharp, blurred.rgb, blend), 1.0);
+}
@@ -0,0 +1,61 @@
+#version 440
+
+// The bokeh gather for the depth of field effect, run on a downsampled copy of the image so that the number of samples
+// drops with the square of the downsampling. The input stores the distance to the camera in alpha (see BlurPasses).
+// The output stores how much of each texel is covered by blur from nearer surfaces in alpha, since dof_composite.glsl
+// can't tell that from a pixel's own circle of confusion, and foreground blur spills over pixels that are in focus
+
+layout(location = 0) in vec2 inUV;
+
+layout(location = 0) out vec4 outColor;
+
+// The downsampled color buffer, with the distance to the camera in alpha
+layout(binding = 0) uniform sampler2D s_Image;
+
+#include "../../fragments/frame_uniforms.glsl"
+#include "../../fragments/dof_common.glsl"
+
+// We impose a hard limit on blurring to avoid killing the GPU, in full resolution pixels
+uniform float u_MaxBlurRadius;
+// The size of the image we're gathering from relative to the full resolution image
+uniform float u_Scale;
+
+void main() {
+    float focalLength = getFocalLength();
+
+    // Determines the size of single texel
+    vec2 texelSize = 1.0 / textureSize(s_Image, 0);
+
+    // Blur sizes are in full resolution pixels, so we scale them down to our texels
+    vec4 center = texture(s_Image, inUV);
+    float centerDepth = center.a;
+    float centerCOC = getBlurSize(centerDepth, u_FocalDepth, focalLength) * u_Scale;
+
+    vec3 color = center.rgb;
+    float tot = 1.0;
+    float spill = 0.0;
+
+    // We'll blur our fragment outward in a circle
+    float radius = RAD_SCALE;
+    float maxRadius = min(u_Aperture, u_MaxBlurRadius) * u_Scale;
+    for (float ang = 0.0; radius < maxRadius; ang += GOLDEN_ANGLE)
+    {
+        // Collect the color, depth, circle of confusion for the sample
+        vec4 sampleValue = texture(s_Image, inUV + vec2(cos(ang), sin(ang)) * texelSize * radius);
+        float sampleCOC = getBlurSize(sampleValue.a, u_FocalDepth, focalLength) * u_Scale;
+
+        if (sampleValue.a > centerDepth)
+            sampleCOC = clamp(sampleCOC, 0.0, centerCOC);
+
+        float m = smoothstep(radius - RAD_SCALE, radius + RAD_SCALE, sampleCOC);
+        color += mix(color / tot, sampleValue.rgb, m);
+        if (sampleValue.a < centerDepth)
+            spill += m;
+
+        // Track that we have another sample, and advance our radius outward
+        tot += 1.0;
+        radius += RAD_SCALE / radius;
+    }
+
+    outColor = vec4(color / tot, spill / tot);
+}
@@ -0,0 +1,17 @@
+// Cel shading as a fused stage, see cel_shader.glsl
+
+uniform sampler1D STAGE_ToonTerm;
+uniform float     STAGE_Discard;
+
+vec4 STAGE_Apply(vec2 uv, vec3 viewDir, vec4 color) {
+    // Using a LUT to allow artists to tweak toon shading settings
+    color.r = texture(STAGE_ToonTerm, color.r).r;
+    color.g = texture(STAGE_ToonTerm, color.g).g;
+    color.b = texture(STAGE_ToonTerm, color.b).b;
+    color.a = 1.0;
+
+    if (color.a < STAGE_Discard) {
+        discard;
+    }
+    return color;
+}
@@ -0,0 +1,11 @@
+// Chromatic aberration as a fused stage, see Chromatic_Aberration.glsl. Samples the input at offsets, so it has to
+// be the first stage in it's pass
+
+uniform float STAGE_Strength;
+
+vec4 STAGE_Apply(vec2 uv, vec3 viewDir, vec4 color) {
+    float rValue = texture(s_Image, uv - STAGE_Strength * 0.00019).r;
+    float gValue = texture(s_Image, uv - STAGE_Strength * 0.00006).g;
+    float bValue = texture(s_Image, uv - STAGE_Strength * -0.00026).b;
+    return vec4(rValue, gValue, bValue, 1.0);
+}
@@ -0,0 +1,8 @@
+// Color correction as a fused stage, see color_correction.glsl
+
+uniform sampler3D STAGE_Lut;
+uniform float     STAGE_Strength;
+
+vec4 STAGE_Apply(vec2 uv, vec3 viewDir, vec4 color) {
+    return vec4(mix(color.rgb, texture(STAGE_Lut, color.rgb).rgb, clamp(STAGE_Strength, 0, 1)), color.a);
+}
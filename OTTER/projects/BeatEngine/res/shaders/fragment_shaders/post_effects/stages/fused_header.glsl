@@ -0,0 +1,14 @@
+#version 430
+
+// The start of every fused post processing shader. The layer appends each effect's stage, with STAGE_ replaced by a
+// prefix unique to that stage (ex: s0_), followed by a main function that runs the stages in order
+
+layout(location = 0) in vec2 inUV;
+layout(location = 1) in vec3 inViewDir;
+
+layout(location = 0) out vec4 outColor;
+
+// The output of the previous pass, stages that resample it can only be the first in a fused pass
+uniform layout(binding = 0) sampler2D s_Image;
+
+#include "../../../fragments/frame_uniforms.glsl"
@@ -0,0 +1,20 @@
+// Night vision as a fused stage, see Night_Vision.glsl
+
+// Hashing a random value obfuscated from a sin wave
+float STAGE_Hash(in float n) { return fract(sin(n) * 56583.342); }
+
+vec4 STAGE_Apply(vec2 uv, vec3 viewDir, vec4 color) {
+    // scramble texel
+    vec2 u = uv * 2. - 1.;
+    vec2 n = u * vec2(u_ScreenSize.x / u_ScreenSize.y, 1.0);
+
+    vec3 c = color.rgb;
+
+    // flicker, grain, vignette
+    c += sin(STAGE_Hash(u_Time)) * 0.01;
+    c += STAGE_Hash((STAGE_Hash(n.x) + n.y) * u_Time) * 0.5;
+    c *= smoothstep(length(n * n * n * vec2(0.075, 0.4)), 1.0, 0.4);
+
+    c = dot(c, vec3(0.2126, 0.7152, 0.0722)) * vec3(0.2, 1.5 - STAGE_Hash(u_Time) * 0.1, 0.4);
+    return vec4(c, 1.0);
+}
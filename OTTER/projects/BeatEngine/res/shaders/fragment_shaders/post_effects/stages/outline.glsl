@@ -0,0 +1,59 @@
+// Outlines as a fused stage, see outline.glsl. Only the G-Buffer is sampled around the pixel, the input is only read
+// at the pixel being shaded, so this can go anywhere in a fused pass
+
+#include "../../../fragments/gbuffer_encoding.glsl"
+
+uniform sampler2D STAGE_Depth;
+uniform sampler2D STAGE_Normals;
+
+uniform vec4  STAGE_OutlineColor;
+uniform float STAGE_Scale;
+uniform float STAGE_DepthThreshold;
+uniform float STAGE_NormalThreshold;
+uniform float STAGE_DepthNormThreshold;
+uniform float STAGE_DepthNormThresholdScale;
+uniform vec2  STAGE_PixelSize;
+
+vec4 STAGE_Apply(vec2 uv, vec3 viewDir, vec4 color) {
+    float depth = texture(STAGE_Depth, uv).r;
+    vec3 norm = DecodeGBufferNormal(texture(STAGE_Normals, uv));
+
+    float halfScale = STAGE_Scale * 0.5f;
+
+    // We calculate an x shape around our UV that we'll sample the corners of
+    vec2 u0 = uv + vec2(-STAGE_PixelSize.x, -STAGE_PixelSize.y) * floor(halfScale);
+    vec2 u1 = uv + vec2( STAGE_PixelSize.x,  STAGE_PixelSize.y) * ceil(halfScale);
+    vec2 u2 = uv + vec2( STAGE_PixelSize.x, -STAGE_PixelSize.y) * floor(halfScale);
+    vec2 u3 = uv + vec2(-STAGE_PixelSize.x,  STAGE_PixelSize.y) * ceil(halfScale);
+
+    float d0 = texture(STAGE_Depth, u0).r;
+    float d1 = texture(STAGE_Depth, u1).r;
+    float d2 = texture(STAGE_Depth, u2).r;
+    float d3 = texture(STAGE_Depth, u3).r;
+
+    vec3 n0 = DecodeGBufferNormal(texture(STAGE_Normals, u0));
+    vec3 n1 = DecodeGBufferNormal(texture(STAGE_Normals, u1));
+    vec3 n2 = DecodeGBufferNormal(texture(STAGE_Normals, u2));
+    vec3 n3 = DecodeGBufferNormal(texture(STAGE_Normals, u3));
+
+    // Compute a threshold term based on the dot product between the camera and the normal
+    float nDotV = 1 - dot(norm, -viewDir);
+    float normalThreshold = clamp((nDotV - STAGE_DepthNormThreshold) / (1 - STAGE_DepthNormThreshold), 0, 1);
+    normalThreshold = normalThreshold * STAGE_DepthNormThresholdScale + 1;
+
+    // Robert's cross depth
+    float dDiff0 = d1 - d0;
+    float dDiff1 = d3 - d2;
+    float edgeDepth = sqrt(pow(dDiff0, 2) + pow(dDiff1, 2)) * 64;
+    edgeDepth = edgeDepth > STAGE_DepthThreshold * normalThreshold * depth ? 1 : 0;
+
+    // Robert's cross normals
+    vec3 nDiff0 = n1 - n0;
+    vec3 nDiff1 = n3 - n2;
+    float edgeNorm = sqrt(dot(nDiff0, nDiff0) + dot(nDiff1, nDiff1));
+    edgeNorm = edgeNorm > STAGE_NormalThreshold ? 1 : 0;
+
+    float edgeFactor = max(edgeDepth, edgeNorm);
+    vec3 result = (STAGE_OutlineColor.rgb * STAGE_OutlineColor.a * edgeFactor) + (1 - edgeFactor) * color.rgb;
+    return vec4(result, color.a);
+}
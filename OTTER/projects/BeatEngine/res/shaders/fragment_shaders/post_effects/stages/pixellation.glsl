@@ -0,0 +1,12 @@
+// Pixellation as a fused stage, see Pixellation.glsl. Samples the input at other pixels, so it has to be the first
+// stage in it's pass
+
+uniform float STAGE_PixelNumber;
+
+vec4 STAGE_Apply(vec2 uv, vec3 viewDir, vec4 color) {
+    float dx = 15.0 * (1.0 / STAGE_PixelNumber);
+    float dy = 10.0 * (1.0 / STAGE_PixelNumber);
+    vec2 coord = vec2(dx * floor(uv.x / dx),
+                      dy * floor(uv.y / dy));
+    return texture(s_Image, coord);
+}
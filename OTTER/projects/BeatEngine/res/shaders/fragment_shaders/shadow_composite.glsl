@@ -50,21 +50,8 @@ struct Light {
 	vec4  ColorAttenuation;
 };
 
-#include "../fragments/deferred_post_common.glsl"
 #include "../fragments/frame_uniforms.glsl"
-
-// Showing off another way to extract view pos from depth
-vec4 GetViewPos(vec2 uv) {
-	// Get the depth buffer value at this pixel, map from [0,1] to [-1,1]    
-	float zOverW = GetDepth(uv) * 2 - 1;
-	// We convert the range [0,1] to [-1,1], create a point to inverse project    
-	vec4 currentPos = vec4(uv.xy * 2 - 1, zOverW, 1);
-	// Transform by the view-projection inverse    
-	vec4 D = inverse(u_Projection) * currentPos;
-	// Divide by w for perspective divide    
-	vec4 viewPos = D / D.w;
-	return viewPos;
-}
+#include "../fragments/deferred_post_common.glsl"
 
 // Calculates the contribution the given point light has 
 // for the current fragment
@@ -176,11 +163,8 @@ void main() {
     // Make sure the normal is in fact, a normal
     normal = normalize(normal);
 
-    // Get values from the g-buffer
-    vec3 albedo = GetAlbedo(inUV);
-
-    // Get viewspace from depth re-construction method (just to show how it works!)
-    vec3 viewPos = GetViewPos(inUV).xyz;
+    // Get viewspace position, re-constructed from depth
+    vec3 viewPos = GetViewPosition(inUV);
 
     // Determine the position in light clip space
 	vec4 shadowPos = u_ViewToShadow * vec4(viewPos, 1.0);  
@@ -224,7 +208,7 @@ void main() {
         }
 
         // We'll also grab specular power from the G-Buffer
-        float specularPow = texture(s_AlbedoSpec, inUV).a;
+        float specularPow = GetSpecularPower(inUV);
 
         // Use the structure to calculate a directional light's contribution
         CalcDirectionalLightContribution(viewPos, normal, l, specularPow, diffuse, specular);
@@ -0,0 +1,29 @@
+// Upsamples a lower resolution image, using a matching image that stores the distance to the camera in it's alpha
+// channel. Each of the 4 nearest low resolution texels is weighted by how close it's distance is to the distance at
+// the pixel we're shading, on top of the usual bilinear weight, so that colors don't bleed across depth edges
+// @param lowRes The low resolution image
+// @param lowResDist An image the same size as lowRes, with the distance to the camera in alpha
+// @param uv The UV coordinate to upsample at
+// @param dist The distance to the camera at the full resolution pixel
+// @param sharpness How strongly differences in distance are rejected, relative to the distance
+vec4 BilateralUpsample(sampler2D lowRes, sampler2D lowResDist, vec2 uv, float dist, float sharpness) {
+    ivec2 size = textureSize(lowRes, 0);
+    vec2 pos = uv * size - 0.5;
+    vec2 f = fract(pos);
+    ivec2 base = ivec2(floor(pos));
+
+    vec4 result = vec4(0);
+    float total = 0.0;
+    for (int iy = 0; iy < 2; iy++) {
+        for (int ix = 0; ix < 2; ix++) {
+            ivec2 coord = clamp(base + ivec2(ix, iy), ivec2(0), size - 1);
+            vec4 texel = texelFetch(lowRes, coord, 0);
+            float texelDist = texelFetch(lowResDist, coord, 0).a;
+            float bilinear = (ix == 0 ? 1.0 - f.x : f.x) * (iy == 0 ? 1.0 - f.y : f.y);
+            float weight = bilinear / (0.001 + sharpness * abs(texelDist - dist) / max(dist, 0.001));
+            result += texel * weight;
+            total += weight;
+        }
+    }
+    return result / max(total, 0.00001);
+}
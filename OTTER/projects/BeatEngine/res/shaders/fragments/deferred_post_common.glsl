@@ -1,23 +1,36 @@
+// Needs frame_uniforms.glsl to be included first
 
 uniform layout(binding=0) sampler2D s_Depth;
-uniform layout(binding=1) sampler2D s_AlbedoSpec;
-uniform layout(binding=2) sampler2D s_NormalsMetallic;
+uniform layout(binding=1) sampler2D s_Albedo;
+uniform layout(binding=2) sampler2D s_NormalsMaterial;
 uniform layout(binding=3) sampler2D s_Emissive;
-uniform layout(binding=4) sampler2D s_Position;
 
+#include "gbuffer_encoding.glsl"
 
+// Returns the view space normal, or a zero vector for pixels without one
 vec3 GetNormal(vec2 uv) {
-    return ((texture(s_NormalsMetallic, uv).xyz) * 2) - 1;
+    return DecodeGBufferNormal(texture(s_NormalsMaterial, uv));
 }
 
 vec3 GetAlbedo(vec2 uv) {
-    return texture(s_AlbedoSpec, uv).rgb;
+    return texture(s_Albedo, uv).rgb;
 }
 
-vec3 GetViewPosition(vec2 uv) {
-    return texture(s_Position, uv).rgb;
+float GetMetallic(vec2 uv) {
+    return texture(s_NormalsMaterial, uv).b;
+}
+
+float GetSpecularPower(vec2 uv) {
+    return texture(s_NormalsMaterial, uv).a;
 }
 
 float GetDepth(vec2 uv) {
     return texelFetch(s_Depth, ivec2(uv * textureSize(s_Depth, 0)), 0).r;
-}
\ No newline at end of file
+}
+
+// Rebuilds the view space position from the depth buffer, rather than storing it in the G-Buffer
+vec3 GetViewPosition(vec2 uv) {
+    vec4 clipPos = vec4(uv, GetDepth(uv), 1.0) * 2.0 - 1.0;
+    vec4 viewPos = u_InvProjection * clipPos;
+    return viewPos.xyz / viewPos.w;
+}
@@ -0,0 +1,29 @@
+// Shared by the depth of field shaders, needs frame_uniforms.glsl to be included first
+
+// Modified from:
+// http://tuxedolabs.blogspot.com/2018/05/bokeh-depth-of-field-in-single-pass.html
+
+#include "view_distance.glsl"
+
+const float GOLDEN_ANGLE = 2.39996323;
+const float RAD_SCALE = 0.5;
+
+/*
+* Calculates the Circle of Confusion for a given depth value
+* @param depth The depth of the fragment to caluculate for (in world units)
+* @param focalPlane The distance from the lense to the focal plane (in world units)
+* @param focalLength The focal length parameter (calculated as 1/F = 1/focalPlane + 1/distToSensor)
+* @see http://fileadmin.cs.lth.se/cs/Education/EDAN35/lectures/12DOF.pdf
+*/
+float getBlurSize(float depth, float focalPlane, float focalLength) {
+	float coc = clamp(
+        (focalLength * (focalPlane - depth)) / 
+        (depth * (focalPlane - focalLength)), 
+        -1.0, 1.0);
+	return abs(coc) * u_Aperture;
+}
+
+// Calculates the focal length from the camera's focal and lens depth
+float getFocalLength() {
+    return 1.0f / (1.0 / u_FocalDepth + 1.0 / u_LensDepth);
+}
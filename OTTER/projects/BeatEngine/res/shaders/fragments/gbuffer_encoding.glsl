@@ -0,0 +1,44 @@
+// Packing for the G-Buffer's normal target, shared by the shaders that write the G-Buffer and the ones that read it
+//
+// Color1 stores the view space normal octahedral encoded in RG, metallic in B and specular power in A. A cleared
+// texel (all zeros) decodes to a normal pointing straight away from the camera, which no visible surface can
+// have, so it marks pixels that nothing wrote a normal to (ex: the skybox)
+#ifndef GBUFFER_ENCODING_GLSL
+#define GBUFFER_ENCODING_GLSL
+
+// Folds the lower half of the octahedron over the upper half's diagonals
+vec2 OctWrap(vec2 v) {
+    return (1.0 - abs(v.yx)) * mix(vec2(-1.0), vec2(1.0), greaterThanEqual(v, vec2(0.0)));
+}
+
+// Projects a unit vector onto an octahedron and unfolds it onto the [0,1] square
+// @param normal The normalized vector to encode
+vec2 EncodeNormal(vec3 normal) {
+    normal /= abs(normal.x) + abs(normal.y) + abs(normal.z);
+    vec2 result = normal.z >= 0.0 ? normal.xy : OctWrap(normal.xy);
+    return result * 0.5 + 0.5;
+}
+
+// Inverse of EncodeNormal, returns a normalized vector
+vec3 DecodeNormal(vec2 encoded) {
+    encoded = encoded * 2.0 - 1.0;
+    vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float fold = max(-normal.z, 0.0);
+    normal.xy += mix(vec2(fold), vec2(-fold), greaterThanEqual(normal.xy, vec2(0.0)));
+    return normalize(normal);
+}
+
+// Packs a surface into the value to write to the G-Buffer's Color1
+// @param normal        The view space normal, normalized
+// @param metallic      The surface's metallic factor, between 0 and 1
+// @param specularPower The surface's specular power, between 0 and 1
+vec4 EncodeGBufferSurface(vec3 normal, float metallic, float specularPower) {
+    return vec4(EncodeNormal(normal), metallic, specularPower);
+}
+
+// Unpacks the view space normal from a Color1 texel, or returns a zero vector if the pixel doesn't have one
+vec3 DecodeGBufferNormal(vec4 packed) {
+    return any(greaterThan(packed.rg, vec2(0.0))) ? DecodeNormal(packed.rg) : vec3(0.0);
+}
+
+#endif
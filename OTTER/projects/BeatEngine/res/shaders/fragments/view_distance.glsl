@@ -0,0 +1,12 @@
+// Needs frame_uniforms.glsl to be included first
+
+// Converts a screen space coord and a raw depth value into a world-space distance
+// @param screen The screen-space coordinate to convert
+// @param rawValue The raw, non-linear depth value to convert
+// @returns A distance to the camera in world units
+float DepthToDist(vec2 screen, float rawValue) {
+	vec4 screenPos = vec4(screen.x, screen.y, rawValue, 1.0) * 2.0 - 1.0;
+	vec4 viewPosition = u_InvProjection * screenPos;
+
+	return -(viewPosition.z / viewPosition.w);
+}
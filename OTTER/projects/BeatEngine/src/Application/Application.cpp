@@ -1,17 +1,23 @@
 #include "Application/Application.h"
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GLFW/glfw3.h>
 #include <glad/glad.h>
 
 #include "Logging.h"
 #include "Gameplay/InputEngine.h"
+#include "Gameplay/InputRecorder.h"
 #include "Application/Timing.h"
 #include <filesystem>
 #include "Layers/GLAppLayer.h"
 #include "Utils/FileHelpers.h"
 #include "Utils/ResourceManager/ResourceManager.h"
 #include "Utils/ImGuiHelper.h"
+#include "Utils/Profiler.h"
+#include "Utils/MemoryTracker.h"
+#include "Utils/FrameArena.h"
 
 // Graphics
 #include "Graphics/Buffers/IndexBuffer.h"
@@ -27,6 +33,7 @@
 #include "Graphics/Font.h"
 #include "Graphics/GuiBatcher.h"
 #include "Graphics/Framebuffer.h"
+#include "Graphics/GpuProfiler.h"
 
 // Gameplay
 #include "Gameplay/Material.h"
@@ -72,6 +79,7 @@
 #include "Layers/LogicUpdateLayer.h"
 #include "Layers/ImGuiDebugLayer.h"
 #include "Layers/InstancedRenderingTestLayer.h"
+#include "Layers/PhysicsStressTestLayer.h"
 #include "Layers/ParticleLayer.h"
 #include "Layers/Level1Scene.h"
 #include "Application/Layers/MainMenuScene.h"
@@ -103,6 +111,12 @@ std::string Application::_applicationName = "Beat!";
 #define DEFAULT_WINDOW_WIDTH 1920
 #define DEFAULT_WINDOW_HEIGHT 1080
 
+// Gets the directory we store our settings under, %APPDATA% on Windows or the working directory if it isn't set (ex: Linux)
+static std::filesystem::path GetSettingsRoot() {
+	const char* appdata = getenv("APPDATA");
+	return appdata != nullptr ? std::filesystem::path(appdata) : std::filesystem::current_path();
+}
+
 Application::Application() :
 	_window(nullptr),
 	_windowSize({DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT}),
@@ -111,7 +125,11 @@ Application::Application() :
 	_windowTitle("Beat - Amnesia Interactive"),
 	_currentScene(nullptr),
 	_targetScene(nullptr),
-	_renderOutput(nullptr)
+	_renderOutput(nullptr),
+	_benchmarkSettings(BenchmarkSettings()),
+	_benchmark(nullptr),
+	_sceneGeneration(0),
+	_sceneGenerationStarted(false)
 { }
 
 Application::~Application() = default;
@@ -124,8 +142,13 @@ Application& Application::Get() {
 void Application::Start(int argCount, char** arguments) {
 	LOG_ASSERT(_singleton == nullptr, "Application has already been started!");
 	_singleton = new Application();
-	_singleton->_Run();
 
+	_singleton->_benchmarkSettings = BenchmarkSettings::Parse(argCount, arguments);
+	if (_singleton->_benchmarkSettings.Enabled) {
+		_singleton->_benchmark = std::make_shared<BenchmarkRunner>(_singleton->_benchmarkSettings);
+	}
+
+	_singleton->_Run();
 
 }
 
@@ -147,12 +170,24 @@ void Application::ResizeWindow(const glm::ivec2& newSize)
 	_HandleWindowSizeChanged(newSize);
 }
 
+bool Application::IsHiddenWindow() const {
+	return _benchmarkSettings.Enabled && _benchmarkSettings.HiddenWindow;
+}
+
+bool Application::IsOffscreen() const {
+	return _benchmarkSettings.Enabled && _benchmarkSettings.Offscreen;
+}
+
 void Application::Quit() {
 	_isRunning = false;
 }
 
 bool Application::LoadScene(const std::string& path) {
 	if (std::filesystem::exists(path)) { 
+		// Start the new scene's generation before loading anything, so the memory it loads is credited to it
+		MemoryTracker::BeginSceneGeneration();
+		_sceneGenerationStarted = true;
+
 		if (path == "Level1.json") {		
 		
 		//GetLayer<PostProcessingLayer>()->GetEffect<NightVisionEffect>()->Enabled = true;
@@ -176,7 +211,11 @@ bool Application::LoadScene(const std::string& path) {
 		}
 
 		//SFXS->PlayEvent("event:/MenuMusic");
+		// The editor needs the source manifest so that resources can be saved, cooked manifests can't be written back
 		std::string manifestPath = std::filesystem::path(path).stem().string() + "-manifest.json";
+		if (!_isEditor) {
+			manifestPath = ResourceManager::ResolveManifestPath(manifestPath);
+		}
 		if (std::filesystem::exists(manifestPath)) {
 			LOG_INFO("Loading manifest from \"{}\"", manifestPath);
 			ResourceManager::LoadManifest(manifestPath);
@@ -196,7 +235,7 @@ void Application::LoadScene(const Gameplay::Scene::Sptr& scene) {
 
 void Application::SaveSettings()
 {
-	std::filesystem::path appdata = getenv("APPDATA");
+	std::filesystem::path appdata = GetSettingsRoot();
 	std::filesystem::path settingsPath = appdata / _applicationName / "app-settings.json";
 
 	if (!std::filesystem::exists(appdata / _applicationName)) {
@@ -212,51 +251,51 @@ float toggleKeys = 3.0f;
 float Application::keyboard()
 {
 	// for key 0 regular lighting + custom LUT
-	if (glfwGetKey(_window, GLFW_KEY_SPACE) == GLFW_PRESS) {
+	if (InputEngine::IsKeyDown(GLFW_KEY_SPACE)) {
 		toggleKeys = 10.0f;
 
 	}
 
 	// for key 1 no lighting at all
-	if (glfwGetKey(_window, GLFW_KEY_1) == GLFW_PRESS) {
+	if (InputEngine::IsKeyDown(GLFW_KEY_1)) {
 		toggleKeys = 1.0f;
 
 	}
 	// for key 2 Ambient lighting
-	if (glfwGetKey(_window, GLFW_KEY_2) == GLFW_PRESS) {
+	if (InputEngine::IsKeyDown(GLFW_KEY_2)) {
 		toggleKeys = 2.0f;
 
 	}
 	// for key 3 specular lighting
-	if (glfwGetKey(_window, GLFW_KEY_3) == GLFW_PRESS) {
+	if (InputEngine::IsKeyDown(GLFW_KEY_3)) {
 		toggleKeys = 3.0f;
 
 	}
 
 	// for key 4 Ambient + specular lighting
-	if (glfwGetKey(_window, GLFW_KEY_4) == GLFW_PRESS) {
+	if (InputEngine::IsKeyDown(GLFW_KEY_4)) {
 		toggleKeys = 4.0f;
 
 	}
 
 	// for key 5 Ambient + specular lighting + toon shader
-	if (glfwGetKey(_window, GLFW_KEY_5) == GLFW_PRESS) {
+	if (InputEngine::IsKeyDown(GLFW_KEY_5)) {
 		toggleKeys = 5.0f;
 
 	}
 
 	// for key 8 regular lighting + Warm Lut
-	if (glfwGetKey(_window, GLFW_KEY_8) == GLFW_PRESS) {
+	if (InputEngine::IsKeyDown(GLFW_KEY_8)) {
 		toggleKeys = 8.0f;
 	}
 
 	// for key 9 regular lighting + Cool Lut
-	if (glfwGetKey(_window, GLFW_KEY_9) == GLFW_PRESS) {
+	if (InputEngine::IsKeyDown(GLFW_KEY_9)) {
 		toggleKeys = 9.0f;
 	}
 
 	// for key 0 regular lighting + custom LUT
-	if (glfwGetKey(_window, GLFW_KEY_0) == GLFW_PRESS) {
+	if (InputEngine::IsKeyDown(GLFW_KEY_0)) {
 		toggleKeys = 0.0f;
 
 	}
@@ -266,6 +305,11 @@ float Application::keyboard()
 
 void Application::_Run()
 {	
+	// Bullet's allocator needs to be hooked before the first scene creates a physics world
+	MemoryTracker::Init();
+	// Loading runs on this thread too, so the frame arena needs to be claimed before any layers are loaded
+	FrameArena::Init();
+
 	// Non Dev Mode
 #ifdef _DEBUG
 	_isEditor = true;
@@ -274,6 +318,14 @@ void Application::_Run()
 #ifndef _DEBUG
 	_isEditor = false;
 #endif
+	// Benchmarks always run like a release build, so the scene plays and there's no editor overhead
+	if (_benchmark != nullptr) {
+		_isEditor = false;
+	}
+	// Hidden window and offscreen runs don't have anything to play audio for
+	if (IsHiddenWindow() || IsOffscreen()) {
+		AudioEngine::SetEnabled(false);
+	}
 	// TODO: Register layers
 	_layers.push_back(std::make_shared<GLAppLayer>());
 
@@ -290,6 +342,8 @@ void Application::_Run()
 	_layers.push_back(std::make_shared<PostProcessingLayer>());
 	_layers.push_back(std::make_shared<InterfaceLayer>());
 	_layers.push_back(std::make_shared<MainMenuScene>());
+	// Uncomment to benchmark single vs multithreaded physics on startup
+	//_layers.push_back(std::make_shared<PhysicsStressTestLayer>());
 
 
 	// _DEBUG
@@ -306,6 +360,10 @@ void Application::_Run()
 	// We'll grab these since we'll need them!
 	_windowSize.x = JsonGet(_appSettings, "window_width", DEFAULT_WINDOW_WIDTH);
 	_windowSize.y = JsonGet(_appSettings, "window_height", DEFAULT_WINDOW_HEIGHT);
+	// Offscreen runs always render at the same size, so their images can be compared between machines
+	if (IsOffscreen()) {
+		_windowSize = _benchmarkSettings.Resolution;
+	}
 
 	// By default, we want our viewport to be the whole screen
 	_primaryViewport = { 0, 0, _windowSize.x, _windowSize.y };
@@ -317,6 +375,21 @@ void Application::_Run()
 	// Load all layers
 	_Load();
 
+	// The layers will have picked a starting scene, but benchmarks and recordings start from a specific one,
+	// with a pinned seed so that the same input always plays out the same way
+	if (_benchmarkSettings.IsFixedStep()) {
+		LoadScene(_benchmarkSettings.ScenePath);
+		SpawnLoop::SetSeed(_benchmarkSettings.Seed);
+
+		if (!_benchmarkSettings.RecordPath.empty()) {
+			InputRecorder::Start(_benchmarkSettings.RecordPath, _benchmarkSettings.ScenePath, _benchmarkSettings.TimeStep, _benchmarkSettings.Seed);
+		}
+	}
+	// Benchmarks are driven entirely by their input script, so we don't want stray input from the window
+	if (_benchmark != nullptr) {
+		InputEngine::SetWindowInputEnabled(false);
+	}
+
 	// Grab current time as the previous frame
 	double lastFrame =  glfwGetTime();
 
@@ -326,6 +399,16 @@ void Application::_Run()
 	AudioEngine::GetContextBanks()->PlayEvent("event:/MenuMusic");
 	// Infinite loop as long as the application is running
 	while (_isRunning) {
+		PROFILE_FRAME();
+		PROFILE_ZONE("Frame");
+		// Layers own most of what they allocate for the lifetime of the app, scene objects and their
+		// components tag themselves where they're created
+		MEMORY_TAG(MemoryTag::Application);
+
+		if (_benchmark != nullptr) {
+			_benchmark->BeginFrame();
+		}
+
 		// Handle scene switching
 		
 		if (_targetScene != nullptr) {
@@ -346,6 +429,10 @@ void Application::_Run()
 		// Figure out the current time, and the time since the last frame
 		double thisFrame = glfwGetTime();
 		float dt = static_cast<float>(thisFrame - lastFrame);
+		// Benchmarks and recordings step with a fixed timestep so that every run simulates exactly the same thing
+		if (_benchmarkSettings.IsFixedStep()) {
+			dt = _benchmarkSettings.TimeStep;
+		}
 		float scaledDt = dt * timing._timeScale;
 
 		// Update all timing values
@@ -356,7 +443,14 @@ void Application::_Run()
 		timing._timeSinceSceneLoad += scaledDt;
 		timing._unscaledTimeSinceSceneLoad += dt;
 
-		ImGuiHelper::StartFrame();
+		bool hiddenWindow = IsHiddenWindow();
+		// Offscreen runs render everything, but nothing gets presented to the window
+		bool present = !hiddenWindow && !IsOffscreen();
+		if (present) {
+			ImGuiHelper::StartFrame();
+		}
+		// Hidden window runs still update things that time their GPU work (ex: particle simulation), so they need a frame as well
+		GpuProfiler::BeginFrame();
 
 		keyboard();
 
@@ -364,10 +458,30 @@ void Application::_Run()
 		if (_currentScene != nullptr) {
 			_Update();
 			_LateUpdate();
-			_PreRender();
-			_RenderScene(); 
-			_PostRender();
-			AudioEngine::GetContext()->Update();
+			if (_benchmark != nullptr) {
+				_benchmark->ApplyCamera(_currentScene);
+			}
+			if (!hiddenWindow) {
+				_PreRender();
+				_RenderScene(); 
+				_PostRender();
+
+				if (_benchmark != nullptr) {
+					// The hidden window's back buffer is undefined under pixel ownership rules, so we capture the
+					// image that was presented to it instead, falling back to the render output without post processing
+					PostProcessingLayer::Sptr postProcessing = GetLayer<PostProcessingLayer>();
+					Framebuffer::Sptr source = postProcessing != nullptr && postProcessing->Enabled ? postProcessing->GetPresentedOutput() : nullptr;
+					if (source == nullptr) {
+						source = GetLayer<RenderLayer>()->GetRenderOutput();
+					}
+					glm::ivec2 size;
+					glfwGetFramebufferSize(_window, &size.x, &size.y);
+					_benchmark->CaptureFrame(source, size);
+				}
+			}
+
+			PROFILE_ZONE("Audio");
+			AudioEngine::Update();
 		}
 		
 
@@ -377,10 +491,33 @@ void Application::_Run()
 		lastFrame = thisFrame;
 
 		InputEngine::EndFrame();
-		ImGuiHelper::EndFrame();
+		if (present) {
+			GPU_PASS("ImGui");
+			ImGuiHelper::EndFrame();
+		}
+		GpuProfiler::EndFrame();
+		if (!hiddenWindow) {
+			if (present) {
+				PROFILE_ZONE("SwapBuffers");
+				glfwSwapBuffers(_window);
+			} else {
+				// Without a swap nothing pushes our commands to the GPU, so we flush to keep it busy like a real frame would
+				glFlush();
+			}
+		}
+
+		// Nothing should be holding on to frame memory by now, so we can recycle it for the next frame
+		FrameArena::EndFrame();
+
+		if (_benchmark != nullptr && _benchmark->EndFrame()) {
+			_isRunning = false;
+		}
+	}
 
-		glfwSwapBuffers(_window);
+	if (_benchmark != nullptr) {
+		_benchmark->WriteResults();
 	}
+	InputRecorder::Stop();
 
 	// Unload all our layers
 	_Unload();
@@ -441,11 +578,11 @@ void Application::_RegisterClasses()
 }
 
 void Application::_Load() {
-
-
+	MEMORY_TAG(MemoryTag::Application);
 
 	for (const auto& layer : _layers) {
 		if (layer->Enabled && *(layer->Overrides & AppLayerFunctions::OnAppLoad)) {
+			PROFILE_ZONE(layer->Name.c_str());
 			layer->OnAppLoad(_appSettings);
 		}
 	}
@@ -461,19 +598,23 @@ void Application::_Load() {
 
 
 void Application::_Update() {
+	PROFILE_ZONE("Update");
 	if (CurrentScene()->FindObjectByName("Character/Player") != nullptr) {
 		score = CurrentScene()->FindObjectByName("Character/Player")->Get<CharacterController>()->GetScore();
 	}
 	for (const auto& layer : _layers) {
 		if (layer->Enabled && *(layer->Overrides & AppLayerFunctions::OnUpdate)) {
+			PROFILE_ZONE(layer->Name.c_str());
 			layer->OnUpdate();
 		}
 	}
 }
 
 void Application::_LateUpdate() {
+	PROFILE_ZONE("LateUpdate");
 	for (const auto& layer : _layers) {
 		if (layer->Enabled && *(layer->Overrides & AppLayerFunctions::OnLateUpdate)) {
+			PROFILE_ZONE(layer->Name.c_str());
 			layer->OnLateUpdate();
 		}
 	}
@@ -481,6 +622,7 @@ void Application::_LateUpdate() {
 
 void Application::_PreRender()
 {
+	PROFILE_ZONE("PreRender");
 	glm::ivec2 size ={ 0, 0 };
 	glfwGetWindowSize(_window, &size.x, &size.y);
 	glViewport(0, 0, size.x, size.y);
@@ -491,6 +633,7 @@ void Application::_PreRender()
 
 	for (const auto& layer : _layers) {
 		if (layer->Enabled && *(layer->Overrides & AppLayerFunctions::OnPreRender)) {
+			PROFILE_ZONE(layer->Name.c_str());
 			layer->OnPreRender();
 		}
 	}
@@ -544,20 +687,24 @@ void Application::_PostRender() {
 }
 */
 void Application::_RenderScene() {
+	PROFILE_ZONE("RenderScene");
 
 	Framebuffer::Sptr result = nullptr;
 	for (const auto& layer : _layers) {
 		if (layer->Enabled && *(layer->Overrides & AppLayerFunctions::OnRender)) {
+			PROFILE_ZONE(layer->Name.c_str());
 			layer->OnRender(result);
 		}
 	}
 }
 
 void Application::_PostRender() {
+	PROFILE_ZONE("PostRender");
 	// Note that we use a reverse iterator for post render
 	for (auto it = _layers.begin(); it != _layers.end(); it++) {
 		const auto& layer = *it;
 		if (layer->Enabled && *(layer->Overrides & AppLayerFunctions::OnPostRender)) {
+			PROFILE_ZONE(layer->Name.c_str());
 			layer->OnPostRender();
 		}
 	}
@@ -568,17 +715,23 @@ void Application::_Unload() {
 	for (auto it = _layers.crbegin(); it != _layers.crend(); it++) {
 		const auto& layer = *it;
 		if (layer->Enabled && *(layer->Overrides & AppLayerFunctions::OnAppUnload)) {
+			PROFILE_ZONE(layer->Name.c_str());
 			layer->OnAppUnload();
 		}
 	}
 
 	// Clean up ImGui
 	ImGuiHelper::Cleanup();
+
+	// Release our timing queries while we still have a context
+	GpuProfiler::Cleanup();
 }
 int Application::GetScore() {
 	return score;
 }
 void Application::_HandleSceneChange() {
+	PROFILE_ZONE("SceneChange");
+
 	// If we currently have a current scene, let the layers know it's being unloaded
 	if (_currentScene != nullptr) {
 		
@@ -588,22 +741,41 @@ void Application::_HandleSceneChange() {
 		for (auto it = _layers.crbegin(); it != _layers.crend(); it++) {
 			const auto& layer = *it;
 			if (layer->Enabled && *(layer->Overrides & AppLayerFunctions::OnSceneUnload)) {
+				PROFILE_ZONE(layer->Name.c_str());
 				layer->OnSceneUnload();
 			}
 		}
 	}
 
+	// Scenes loaded from a file start their generation before they load, scenes built in code start it here
+	if (!_sceneGenerationStarted) {
+		MemoryTracker::BeginSceneGeneration();
+	}
+	_sceneGenerationStarted = false;
+
+	// Swapping the scene out should release the last of the old scene, anything from it that's still alive has leaked
+	bool hadScene = _currentScene != nullptr;
+	std::weak_ptr<Gameplay::Scene> previousScene = _currentScene;
+	std::string previousName = hadScene && !_currentScene->GetFilePath().empty() ? _currentScene->GetFilePath() : "Unsaved scene";
 	_currentScene = _targetScene;
+	if (hadScene) {
+		MemoryTracker::CheckSceneUnload(previousName, _sceneGeneration, previousScene.expired());
+	}
+	_sceneGeneration = MemoryTracker::GetGeneration();
 	
 	// Let the layers know that we've loaded in a new scene
 	for (const auto& layer : _layers) {
 		if (layer->Enabled && *(layer->Overrides & AppLayerFunctions::OnSceneLoad)) {
+			PROFILE_ZONE(layer->Name.c_str());
 			layer->OnSceneLoad();
 		}
 	}
 
 	// Wake up all game objects in the scene
-	_currentScene->Awake();
+	{
+		MEMORY_TAG(MemoryTag::Scene);
+		_currentScene->Awake();
+	}
 
 	// If we are not in editor mode, scenes play by default
 	if (!_isEditor) {
@@ -616,6 +788,7 @@ void Application::_HandleSceneChange() {
 void Application::_HandleWindowSizeChanged(const glm::ivec2& newSize) {
 	for (const auto& layer : _layers) {
 		if (layer->Enabled && *(layer->Overrides & AppLayerFunctions::OnWindowResize)) {
+			PROFILE_ZONE(layer->Name.c_str());
 			layer->OnWindowResize(_windowSize, newSize);
 		}
 	}
@@ -628,7 +801,7 @@ void Application::_ConfigureSettings() {
 	_appSettings = _GetDefaultAppSettings();
 
 	// We'll store our settings in the %APPDATA% directory, under our application name
-	std::filesystem::path appdata = getenv("APPDATA");
+	std::filesystem::path appdata = GetSettingsRoot();
 	std::filesystem::path settingsPath = appdata / _applicationName / "app-settings.json";
 
 	// If the settings file exists, we can load it in!
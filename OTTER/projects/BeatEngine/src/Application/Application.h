@@ -6,6 +6,7 @@
 #include "Application/ApplicationLayer.h"
 #include "Gameplay/Scene.h"
 #include "FMOD/AudioEngine.h"
+#include "Application/Benchmark.h"
 struct GLFWwindow;
 
 /**
@@ -61,6 +62,17 @@ public:
 	 */
 	void SetPrimaryViewport(const glm::uvec4& value);
 
+	/**
+	 * Returns true if the application is running without presenting anything to the
+	 * screen (ex: hidden window benchmarks). Rendering and audio are skipped in this mode
+	 */
+	bool IsHiddenWindow() const;
+	/**
+	 * Returns true if the application is rendering every frame without presenting it (ex: offscreen
+	 * render benchmarks). The window is hidden, and audio and ImGui are skipped in this mode
+	 */
+	bool IsOffscreen() const;
+
 	/**
 	 * Quits the application at the end of the current frame
 	 */
@@ -142,6 +154,16 @@ protected:
 
 	Framebuffer::Sptr _renderOutput;
 
+	// The benchmark, record and replay settings from the command line
+	BenchmarkSettings     _benchmarkSettings;
+	// Collects timings when started with --benchmark or --replay, nullptr otherwise
+	BenchmarkRunner::Sptr _benchmark;
+
+	// The memory tracker generation the current scene was loaded in, used to find what it leaves behind
+	uint32_t _sceneGeneration;
+	// True if LoadScene has already started a generation for the target scene
+	bool     _sceneGenerationStarted;
+
 	void _Run();
 	void _RegisterClasses();
 	void _Load();
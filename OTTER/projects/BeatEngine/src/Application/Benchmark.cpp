@@ -0,0 +1,713 @@
+#include "Application/Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+
+#include <glad/glad.h>
+#include <stb_image_write.h>
+
+#include "Logging.h"
+#include "Application/Application.h"
+#include "Gameplay/InputEngine.h"
+#include "Graphics/GpuProfiler.h"
+#include "Utils/FileHelpers.h"
+#include "Utils/FrameArena.h"
+#include "Utils/MemoryTracker.h"
+#include "Utils/JsonGlmHelpers.h"
+
+BenchmarkSettings BenchmarkSettings::Parse(int argCount, char** arguments) {
+	BenchmarkSettings result;
+	// Tracks which settings were given explicitly, so a replay doesn't override them
+	bool hasScene = false, hasFrames = false, hasDt = false, hasSeed = false;
+	bool isReplay = false;
+
+	for (int ix = 1; ix < argCount; ix++) {
+		const char* arg = arguments[ix];
+		// Grabs the value following a flag, or nullptr if we're at the end of the arguments
+		const char* value = (ix + 1 < argCount) ? arguments[ix + 1] : nullptr;
+
+		if (strcmp(arg, "--benchmark") == 0) {
+			result.Enabled = true;
+			// The scene is optional, so we only consume the next argument if it isn't another flag
+			if (value != nullptr && strncmp(value, "--", 2) != 0) {
+				result.ScenePath = value;
+				hasScene = true;
+				ix++;
+			}
+		}
+		else if (strcmp(arg, "--offscreen") == 0) {
+			result.Enabled = true;
+			result.Offscreen = true;
+			// Like --benchmark, the scene is optional
+			if (value != nullptr && strncmp(value, "--", 2) != 0) {
+				result.ScenePath = value;
+				hasScene = true;
+				ix++;
+			}
+		}
+		else if (strcmp(arg, "--hidden-window") == 0) {
+			result.Enabled = true;
+			result.HiddenWindow = true;
+		}
+		else if (value == nullptr) {
+			LOG_WARN("Missing value for command line argument \"{}\"", arg);
+		}
+		else if (strcmp(arg, "--scene") == 0) {
+			result.ScenePath = value;
+			hasScene = true;
+			ix++;
+		}
+		else if (strcmp(arg, "--frames") == 0) {
+			result.Frames = std::max(1, atoi(value));
+			hasFrames = true;
+			ix++;
+		}
+		else if (strcmp(arg, "--warmup") == 0) {
+			result.WarmupFrames = std::max(0, atoi(value));
+			ix++;
+		}
+		else if (strcmp(arg, "--dt") == 0) {
+			result.TimeStep = static_cast<float>(atof(value));
+			hasDt = true;
+			ix++;
+		}
+		else if (strcmp(arg, "--seed") == 0) {
+			result.Seed = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+			hasSeed = true;
+			ix++;
+		}
+		else if (strcmp(arg, "--record") == 0) {
+			result.RecordPath = value;
+			ix++;
+		}
+		else if (strcmp(arg, "--replay") == 0) {
+			result.Enabled = true;
+			result.InputPath = value;
+			isReplay = true;
+			ix++;
+		}
+		else if (strcmp(arg, "--input") == 0) {
+			result.InputPath = value;
+			ix++;
+		}
+		else if (strcmp(arg, "--out") == 0) {
+			result.OutputPath = value;
+			ix++;
+		}
+		else if (strcmp(arg, "--size") == 0) {
+			int width = 0, height = 0;
+			if (sscanf(value, "%dx%d", &width, &height) == 2 && width > 0 && height > 0) {
+				result.Resolution = glm::ivec2(width, height);
+			} else {
+				LOG_WARN("Invalid size \"{}\", expected WIDTHxHEIGHT", value);
+			}
+			ix++;
+		}
+		else if (strcmp(arg, "--gl-api") == 0) {
+			result.GlApi = value;
+			ix++;
+		}
+		else if (strcmp(arg, "--camera") == 0) {
+			result.CameraPath = value;
+			ix++;
+		}
+		else if (strcmp(arg, "--checksum-every") == 0) {
+			result.ChecksumInterval = std::max(0, atoi(value));
+			ix++;
+		}
+		else if (strcmp(arg, "--reference") == 0) {
+			result.ReferencePath = value;
+			ix++;
+		}
+		else if (strcmp(arg, "--dump-frames") == 0) {
+			result.FrameDumpPath = value;
+			ix++;
+		}
+		else if (strcmp(arg, "--reloads") == 0) {
+			result.SceneReloads = std::max(0, atoi(value));
+			ix++;
+		}
+		else {
+			LOG_WARN("Unknown command line argument \"{}\"", arg);
+		}
+	}
+
+	// Recordings know what they need to be replayed exactly, we only read the header here and leave the events to the runner
+	if (isReplay) {
+		if (std::filesystem::exists(result.InputPath)) {
+			nlohmann::json blob = nlohmann::json::parse(FileHelpers::ReadFile(result.InputPath));
+			if (!hasScene)  result.ScenePath = blob.value("scene", result.ScenePath);
+			if (!hasDt)     result.TimeStep  = blob.value("dt", result.TimeStep);
+			if (!hasSeed)   result.Seed      = blob.value("seed", result.Seed);
+			if (!hasFrames) result.Frames    = std::max(1, blob.value("frames", result.Frames) - result.WarmupFrames);
+		} else {
+			LOG_WARN("Replay \"{}\" was not found", result.InputPath);
+		}
+	}
+
+	// Camera paths are made for a specific scene, so they can pick it if we weren't given one
+	if (!result.CameraPath.empty() && !hasScene && !isReplay) {
+		if (std::filesystem::exists(result.CameraPath)) {
+			nlohmann::json blob = nlohmann::json::parse(FileHelpers::ReadFile(result.CameraPath));
+			result.ScenePath = blob.value("scene", result.ScenePath);
+		}
+	}
+
+	if (result.Offscreen && result.HiddenWindow) {
+		LOG_WARN("Offscreen runs need to render, ignoring --hidden-window");
+		result.HiddenWindow = false;
+	}
+	if (result.GlApi != "native" && result.GlApi != "egl" && result.GlApi != "osmesa") {
+		LOG_WARN("Unknown GL API \"{}\", expected native, egl or osmesa", result.GlApi);
+		result.GlApi = "native";
+	}
+
+	if (result.Enabled && !result.RecordPath.empty()) {
+		LOG_WARN("Can't record while benchmarking, ignoring --record");
+		result.RecordPath.clear();
+	}
+
+	// Recordings get a fresh seed unless one was asked for, so each one plays a different level
+	if (!result.RecordPath.empty() && !hasSeed) {
+		result.Seed = std::random_device()();
+	}
+
+	if (result.TimeStep <= 0.0f) {
+		LOG_WARN("Invalid benchmark timestep, falling back to 1/60s");
+		result.TimeStep = 1.0f / 60.0f;
+	}
+
+	return result;
+}
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkSettings& settings) :
+	_settings(settings),
+	_frameIndex(0),
+	_frameStart(0),
+	_inputEvents(std::vector<InputEvent>()),
+	_nextInputEvent(0),
+	_frameTimes(std::vector<double>()),
+	_zoneTimes(std::unordered_map<std::string, std::vector<double>>()),
+	_capture(std::vector<ProfileThreadCapture>()),
+	_frameZoneTotals(std::unordered_map<const char*, double>()),
+	_cameraKeys(std::vector<CameraKey>()),
+	_checksums(std::vector<FrameChecksum>()),
+	_pixels(std::vector<uint8_t>()),
+	_captureBuffer(nullptr),
+	_renderer(""),
+	_captureNs(0),
+	_lastGpuFrame(0),
+	_gpuFrameTimes(std::vector<double>()),
+	_gpuPassTimes(std::unordered_map<std::string, std::vector<double>>()),
+	_framePassTotals(std::unordered_map<const char*, double>()),
+	_renderStats(std::unordered_map<std::string, std::vector<double>>()),
+	_heapAllocations(std::vector<double>()),
+	_arenaBytes(std::vector<double>()),
+	_reloadsDone(0)
+{
+	_frameTimes.reserve(_settings.Frames);
+	_heapAllocations.reserve(_settings.Frames);
+	_arenaBytes.reserve(_settings.Frames);
+
+	if (!_settings.InputPath.empty()) {
+		_LoadInputScript(_settings.InputPath);
+	}
+	if (!_settings.CameraPath.empty()) {
+		_LoadCameraPath(_settings.CameraPath);
+	}
+
+	// We need the profiler running to break the frame down into zones
+	Profiler::SetRecording(true);
+
+	LOG_INFO("Benchmarking \"{}\" for {} frames (+{} warmup) at dt={}s, seed {}{}", _settings.ScenePath, _settings.Frames,
+		_settings.WarmupFrames, _settings.TimeStep, _settings.Seed, _settings.HiddenWindow ? " (hidden window)" : (_settings.Offscreen ? " (offscreen)" : ""));
+}
+
+BenchmarkRunner::~BenchmarkRunner() = default;
+
+const BenchmarkSettings& BenchmarkRunner::GetSettings() const {
+	return _settings;
+}
+
+int BenchmarkRunner::GetFrameIndex() const {
+	return _frameIndex;
+}
+
+void BenchmarkRunner::BeginFrame() {
+	_frameStart = Profiler::Now();
+	_captureNs = 0;
+
+	// Events are sorted by frame, so we only need to apply the ones that have come due
+	while (_nextInputEvent < _inputEvents.size() && _inputEvents[_nextInputEvent].Frame <= _frameIndex) {
+		const InputEvent& e = _inputEvents[_nextInputEvent++];
+		if (e.IsCursor) {
+			InputEngine::InjectCursor(e.Cursor);
+		}
+		if (e.Key >= 0) {
+			InputEngine::InjectKey(e.Key, e.Down);
+		}
+		if (e.MouseButton >= 0) {
+			InputEngine::InjectMouseButton(e.MouseButton, e.Down);
+		}
+	}
+
+	// Reloads are spread evenly through the recorded frames, and never land on the last one so that the
+	// application gets a chance to swap the scene and check the old copy before we finish
+	if (_reloadsDone < _settings.SceneReloads && _IsRecordingFrame()) {
+		int interval = std::max(1, _settings.Frames / (_settings.SceneReloads + 1));
+		int recorded = _frameIndex - _settings.WarmupFrames;
+		if (recorded > 0 && recorded % interval == 0 && recorded < _settings.Frames - 1) {
+			LOG_INFO("Reloading \"{}\" ({} of {})", _settings.ScenePath, _reloadsDone + 1, _settings.SceneReloads);
+			Application::Get().LoadScene(_settings.ScenePath);
+			_reloadsDone++;
+		}
+	}
+}
+
+void BenchmarkRunner::ApplyCamera(const Gameplay::Scene::Sptr& scene) {
+	if (_cameraKeys.empty() || scene == nullptr || scene->MainCamera == nullptr) {
+		return;
+	}
+
+	// Find the first key that's still ahead of us
+	float time = _frameIndex * _settings.TimeStep;
+	size_t next = 0;
+	while (next < _cameraKeys.size() && _cameraKeys[next].Time <= time) {
+		next++;
+	}
+
+	glm::vec3 position, target;
+	if (next == 0) {
+		position = _cameraKeys.front().Position;
+		target   = _cameraKeys.front().Target;
+	} else if (next == _cameraKeys.size()) {
+		position = _cameraKeys.back().Position;
+		target   = _cameraKeys.back().Target;
+	} else {
+		const CameraKey& a = _cameraKeys[next - 1];
+		const CameraKey& b = _cameraKeys[next];
+		float t = (time - a.Time) / (b.Time - a.Time);
+		position = glm::mix(a.Position, b.Position, t);
+		target   = glm::mix(a.Target, b.Target, t);
+	}
+
+	Gameplay::GameObject* camera = scene->MainCamera->GetGameObject();
+	camera->SetPostion(position);
+	camera->LookAt(target);
+}
+
+void BenchmarkRunner::CaptureFrame(const Framebuffer::Sptr& source, const glm::ivec2& size) {
+	if (!_settings.Offscreen || !_IsRecordingFrame() || source == nullptr || size.x <= 0 || size.y <= 0) {
+		return;
+	}
+
+	// We always hash the last frame, so that even short runs have something to compare
+	int recorded = _frameIndex - _settings.WarmupFrames;
+	bool isLast = recorded == _settings.Frames - 1;
+	bool isInterval = _settings.ChecksumInterval > 0 && (recorded + 1) % _settings.ChecksumInterval == 0;
+	if (!isLast && !isInterval) {
+		return;
+	}
+
+	PROFILE_ZONE("Frame Checksum");
+	uint64_t start = Profiler::Now();
+
+	if (_renderer.empty()) {
+		_renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+	}
+
+	if (_captureBuffer == nullptr) {
+		FramebufferDescriptor desc;
+		desc.Width = size.x;
+		desc.Height = size.y;
+		desc.RenderTargets[RenderTargetAttachment::Color0] = RenderTargetDescriptor(RenderTargetType::ColorRgba8);
+		_captureBuffer = std::make_shared<Framebuffer>(desc);
+		_captureBuffer->SetDebugName("Benchmark Capture");
+	} else if (_captureBuffer->GetSize() != size) {
+		_captureBuffer->Resize(size);
+	}
+
+	// Scale the image into our buffer with the same filtering the present pass uses on it's way to the window
+	Framebuffer::Blit(source, _captureBuffer, BufferFlags::Color, MagFilter::Linear);
+
+	// We skip alpha, since none of our passes write meaningful alpha to the final image
+	_pixels.resize(static_cast<size_t>(size.x) * size.y * 3);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, _captureBuffer->GetHandle());
+	glReadBuffer(GL_COLOR_ATTACHMENT0);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, size.x, size.y, GL_RGB, GL_UNSIGNED_BYTE, _pixels.data());
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+
+	// 64 bit FNV-1a, we only need to detect changes, not resist tampering
+	uint64_t hash = 14695981039346656037ull;
+	for (uint8_t byte : _pixels) {
+		hash ^= byte;
+		hash *= 1099511628211ull;
+	}
+	char text[17];
+	snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+	_checksums.push_back({ _frameIndex, text });
+
+	if (!_settings.FrameDumpPath.empty()) {
+		std::filesystem::create_directories(_settings.FrameDumpPath);
+		std::string path = (std::filesystem::path(_settings.FrameDumpPath) / ("frame_" + std::to_string(_frameIndex) + ".png")).string();
+		// GL images start at the bottom left, PNGs at the top left
+		stbi_flip_vertically_on_write(true);
+		stbi_write_png(path.c_str(), size.x, size.y, 3, _pixels.data(), size.x * 3);
+		stbi_flip_vertically_on_write(false);
+	}
+
+	_captureNs += Profiler::Now() - start;
+}
+
+bool BenchmarkRunner::EndFrame() {
+	uint64_t frameEnd = Profiler::Now();
+	bool recording = _IsRecordingFrame();
+	_frameIndex++;
+
+	if (recording) {
+		_frameTimes.push_back((frameEnd - _frameStart - _captureNs) / 1000000.0);
+
+		const FrameArenaStats& arena = FrameArena::GetLastFrameStats();
+		_heapAllocations.push_back(static_cast<double>(arena.HeapAllocations));
+		_arenaBytes.push_back(static_cast<double>(arena.ArenaBytes));
+
+		if (!_settings.HiddenWindow) {
+			_RecordGpuStats();
+		}
+
+		// Total up every zone on the main thread that ran within this frame, keyed by pointer since zone names are stable
+		Profiler::Capture(_capture, _frameStart);
+		_frameZoneTotals.clear();
+		uint32_t mainThreadId = Profiler::GetMainThreadId();
+		for (const auto& thread : _capture) {
+			if (thread.ThreadId != mainThreadId) continue;
+			for (const auto& zone : thread.Zones) {
+				if (zone.StartNs < _frameStart || zone.EndNs > frameEnd) continue;
+				_frameZoneTotals[zone.Name] += (zone.EndNs - zone.StartNs) / 1000000.0;
+			}
+		}
+		for (const auto& [name, ms] : _frameZoneTotals) {
+			_zoneTimes[name].push_back(ms);
+		}
+	}
+
+	return _frameIndex >= _settings.WarmupFrames + _settings.Frames;
+}
+
+nlohmann::json BenchmarkRunner::GetResults() const {
+	nlohmann::json result;
+	result["scene"] = _settings.ScenePath;
+	result["frames"] = _frameTimes.size();
+	result["warmup_frames"] = _settings.WarmupFrames;
+	result["dt"] = _settings.TimeStep;
+	result["hidden_window"] = _settings.HiddenWindow;
+	result["input"] = _settings.InputPath;
+	result["seed"] = _settings.Seed;
+	result["frame_ms"] = _Summarize(_frameTimes);
+
+	// Build a fixed width histogram so that runs can be compared bucket for bucket
+	std::vector<int> buckets(HistogramBuckets, 0);
+	int overflow = 0;
+	for (double ms : _frameTimes) {
+		int bucket = static_cast<int>(ms / HistogramBucketMs);
+		if (bucket < HistogramBuckets) {
+			buckets[bucket]++;
+		} else {
+			overflow++;
+		}
+	}
+	// Trim off the empty buckets at the end to keep the output readable
+	while (!buckets.empty() && buckets.back() == 0) {
+		buckets.pop_back();
+	}
+	result["histogram"] = {
+		{ "bucket_ms", HistogramBucketMs },
+		{ "counts",    buckets },
+		{ "overflow",  overflow }
+	};
+
+	// Zones that don't run every frame will have fewer samples than frames, we report the count so that's obvious
+	nlohmann::json zones = nlohmann::json::object();
+	for (const auto& [name, samples] : _zoneTimes) {
+		nlohmann::json zone = _Summarize(samples);
+		zone["frames"] = samples.size();
+		zones[name] = zone;
+	}
+	result["zones"] = zones;
+
+	// Heap allocations are only counted when the global allocator is being tracked
+	if (MemoryTracker::IsCpuTrackingEnabled()) {
+		result["heap_allocations"] = _Summarize(_heapAllocations);
+	}
+	result["frame_arena"] = {
+		{ "bytes",      _Summarize(_arenaBytes) },
+		{ "high_water", FrameArena::GetHighWaterMark() },
+		{ "capacity",   FrameArena::GetCapacity() }
+	};
+
+	// GPU timings and draw stats only exist when we're rendering
+	if (!_settings.HiddenWindow) {
+		nlohmann::json passes = nlohmann::json::object();
+		for (const auto& [name, samples] : _gpuPassTimes) {
+			nlohmann::json pass = _Summarize(samples);
+			pass["frames"] = samples.size();
+			passes[name] = pass;
+		}
+		result["gpu"] = {
+			{ "frame_ms", _Summarize(_gpuFrameTimes) },
+			{ "passes",   passes }
+		};
+
+		nlohmann::json stats = nlohmann::json::object();
+		for (const auto& [name, samples] : _renderStats) {
+			stats[name] = _Summarize(samples);
+		}
+		result["render_stats"] = stats;
+	}
+
+	if (_settings.SceneReloads > 0) {
+		result["leak_check"] = _GetLeakCheck();
+	}
+
+	if (_settings.Offscreen) {
+		result["resolution"] = { _settings.Resolution.x, _settings.Resolution.y };
+		result["gl_api"] = _settings.GlApi;
+		result["renderer"] = _renderer;
+		result["camera"] = _settings.CameraPath;
+
+		nlohmann::json checksums = nlohmann::json::array();
+		for (const auto& checksum : _checksums) {
+			checksums.push_back({ { "frame", checksum.Frame }, { "hash", checksum.Hash } });
+		}
+		result["checksums"] = checksums;
+
+		if (!_settings.ReferencePath.empty()) {
+			result["reference"] = _CompareChecksums();
+		}
+	}
+
+	return result;
+}
+
+void BenchmarkRunner::WriteResults() const {
+	std::string results = GetResults().dump(1, '\t');
+
+	// Results go straight to stdout rather than through the logger, so they can be piped into other tools
+	std::cout << results << std::endl;
+
+	if (!_settings.OutputPath.empty()) {
+		FileHelpers::WriteContentsToFile(_settings.OutputPath, results);
+		LOG_INFO("Wrote benchmark results to \"{}\"", _settings.OutputPath);
+	}
+}
+
+void BenchmarkRunner::_LoadInputScript(const std::string& path) {
+	if (!std::filesystem::exists(path)) {
+		LOG_WARN("Benchmark input script \"{}\" was not found, running without input", path);
+		return;
+	}
+
+	nlohmann::json blob = nlohmann::json::parse(FileHelpers::ReadFile(path));
+	for (const auto& item : blob["events"]) {
+		InputEvent e;
+		e.Frame       = item.value("frame", 0);
+		e.Key         = item.value("key", -1);
+		e.MouseButton = item.value("mouse", -1);
+		e.Down        = item.value("down", true);
+		e.IsCursor    = item.contains("cursor");
+		e.Cursor      = e.IsCursor ? glm::dvec2(item["cursor"][0].get<double>(), item["cursor"][1].get<double>()) : glm::dvec2(0.0);
+		_inputEvents.push_back(e);
+	}
+
+	// Stable sort so that events on the same frame keep the order they were written in
+	std::stable_sort(_inputEvents.begin(), _inputEvents.end(), [](const InputEvent& a, const InputEvent& b) {
+		return a.Frame < b.Frame;
+	});
+
+	LOG_INFO("Loaded {} input events from \"{}\"", _inputEvents.size(), path);
+}
+
+void BenchmarkRunner::_LoadCameraPath(const std::string& path) {
+	if (!std::filesystem::exists(path)) {
+		LOG_WARN("Camera path \"{}\" was not found, the camera will be left alone", path);
+		return;
+	}
+
+	nlohmann::json blob = nlohmann::json::parse(FileHelpers::ReadFile(path));
+	for (const auto& item : blob["keys"]) {
+		CameraKey key;
+		key.Time     = item.value("time", 0.0f);
+		key.Position = JsonGet(item, "position", glm::vec3(0.0f));
+		key.Target   = JsonGet(item, "target", glm::vec3(0.0f, 1.0f, 0.0f));
+		_cameraKeys.push_back(key);
+	}
+
+	std::stable_sort(_cameraKeys.begin(), _cameraKeys.end(), [](const CameraKey& a, const CameraKey& b) {
+		return a.Time < b.Time;
+	});
+
+	LOG_INFO("Loaded {} camera keys from \"{}\"", _cameraKeys.size(), path);
+}
+
+bool BenchmarkRunner::_IsRecordingFrame() const {
+	return _frameIndex >= _settings.WarmupFrames;
+}
+
+void BenchmarkRunner::_RecordGpuStats() {
+	const RenderStats& stats = GpuProfiler::GetLastFrameStats();
+	_renderStats["draw_calls"].push_back(stats.DrawCalls);
+	_renderStats["triangles"].push_back(static_cast<double>(stats.Triangles));
+	_renderStats["shader_binds"].push_back(stats.ShaderBinds);
+	_renderStats["material_applies"].push_back(stats.MaterialApplies);
+	_renderStats["texture_binds"].push_back(stats.TextureBinds);
+	_renderStats["ubo_bytes"].push_back(static_cast<double>(stats.UboBytes));
+
+	// Pass timings are read back a couple of frames late, and not every frame if the GPU falls behind,
+	// so we only take them when a new frame has been resolved
+	uint64_t resolved = GpuProfiler::GetResolvedFrameIndex();
+	if (resolved == _lastGpuFrame) {
+		return;
+	}
+	_lastGpuFrame = resolved;
+	_gpuFrameTimes.push_back(GpuProfiler::GetFrameGpuTime());
+
+	// Passes can show up more than once per frame (ex: one per shadow caster), so we total them by name
+	_framePassTotals.clear();
+	for (const auto& timing : GpuProfiler::GetPassTimings()) {
+		_framePassTotals[timing.Name] += timing.Milliseconds;
+	}
+	for (const auto& [name, ms] : _framePassTotals) {
+		_gpuPassTimes[name].push_back(ms);
+	}
+}
+
+nlohmann::json BenchmarkRunner::_CompareChecksums() const {
+	nlohmann::json result;
+	result["path"] = _settings.ReferencePath;
+
+	if (!std::filesystem::exists(_settings.ReferencePath)) {
+		LOG_WARN("Reference results \"{}\" were not found, skipping image comparison", _settings.ReferencePath);
+		return result;
+	}
+	nlohmann::json reference = nlohmann::json::parse(FileHelpers::ReadFile(_settings.ReferencePath));
+
+	// Different drivers rasterize differently, so a hash mismatch across renderers doesn't tell us much
+	std::string referenceRenderer = reference.value("renderer", std::string());
+	if (referenceRenderer != _renderer) {
+		LOG_WARN("Reference was rendered with \"{}\" but this run used \"{}\", images may not match", referenceRenderer, _renderer);
+	}
+	if (reference.contains("resolution") && reference["resolution"] != nlohmann::json({ _settings.Resolution.x, _settings.Resolution.y })) {
+		LOG_WARN("Reference was rendered at a different resolution, images will not match");
+	}
+
+	std::unordered_map<int, std::string> hashes;
+	if (reference.contains("checksums")) {
+		for (const auto& item : reference["checksums"]) {
+			hashes[item.value("frame", -1)] = item.value("hash", std::string());
+		}
+	}
+
+	int compared = 0;
+	std::vector<int> mismatched;
+	for (const auto& checksum : _checksums) {
+		auto it = hashes.find(checksum.Frame);
+		if (it == hashes.end()) continue;
+		compared++;
+		if (it->second != checksum.Hash) {
+			mismatched.push_back(checksum.Frame);
+		}
+	}
+
+	if (!mismatched.empty()) {
+		LOG_ERROR("{} of {} frames differ from the reference (first is frame {})", mismatched.size(), compared, mismatched.front());
+	} else if (compared > 0) {
+		LOG_INFO("All {} frames match the reference", compared);
+	} else {
+		LOG_WARN("No frames in common with the reference, check the frame and warmup counts match");
+	}
+
+	result["compared"] = compared;
+	result["mismatched"] = mismatched;
+	result["match"] = compared > 0 && mismatched.empty();
+	return result;
+}
+
+nlohmann::json BenchmarkRunner::_GetLeakCheck() const {
+	nlohmann::json result;
+	result["reloads"] = _reloadsDone;
+	result["cpu_tracked"] = MemoryTracker::IsCpuTrackingEnabled();
+
+	// The scene the layers started with gets swapped out too, we only judge the copies of our own scene
+	nlohmann::json leaks = nlohmann::json::array();
+	for (const SceneLeakReport& report : MemoryTracker::GetLeakReports()) {
+		if (report.Scene != _settings.ScenePath) continue;
+
+		size_t gpuBytes = 0;
+		for (const auto& allocation : report.GpuAllocations) {
+			gpuBytes += allocation.Bytes;
+		}
+		leaks.push_back({
+			{ "generation",      report.Generation },
+			{ "scene_released",  report.SceneReleased },
+			{ "heap_blocks",     report.CpuCount },
+			{ "heap_bytes",      report.CpuBytes },
+			{ "gpu_allocations", report.GpuAllocations.size() },
+			{ "gpu_bytes",       gpuBytes }
+		});
+	}
+
+	if (!leaks.empty()) {
+		LOG_ERROR("{} of {} reloads of \"{}\" left memory behind", leaks.size(), _reloadsDone, _settings.ScenePath);
+	} else if (_reloadsDone > 0) {
+		LOG_INFO("All {} reloads of \"{}\" were freed", _reloadsDone, _settings.ScenePath);
+	} else {
+		LOG_WARN("The scene was never reloaded, check that there are enough frames for {} reloads", _settings.SceneReloads);
+	}
+
+	result["leaks"] = leaks;
+	result["passed"] = _reloadsDone > 0 && leaks.empty();
+	return result;
+}
+
+nlohmann::json BenchmarkRunner::_Summarize(std::vector<double> samples) {
+	nlohmann::json result;
+	if (samples.empty()) {
+		return result;
+	}
+
+	std::sort(samples.begin(), samples.end());
+
+	double total = 0.0;
+	for (double sample : samples) {
+		total += sample;
+	}
+	double mean = total / samples.size();
+
+	double variance = 0.0;
+	for (double sample : samples) {
+		variance += (sample - mean) * (sample - mean);
+	}
+	variance /= samples.size();
+
+	// Nearest rank percentiles, so every reported value is one we actually measured
+	auto percentile = [&](double p) {
+		size_t rank = static_cast<size_t>(std::ceil(p * samples.size()));
+		return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+	};
+
+	result["mean"]   = mean;
+	result["min"]    = samples.front();
+	result["max"]    = samples.back();
+	result["stddev"] = std::sqrt(variance);
+	result["p50"]    = percentile(0.50);
+	result["p95"]    = percentile(0.95);
+	result["p99"]    = percentile(0.99);
+	result["total"]  = total;
+	return result;
+}
@@ -0,0 +1,214 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <json.hpp>
+#include <GLM/glm.hpp>
+
+#include "Utils/Macros.h"
+#include "Utils/Profiler.h"
+#include "Gameplay/Scene.h"
+#include "Graphics/Framebuffer.h"
+
+/// <summary>
+/// Settings for benchmark, record and replay runs, parsed from the command line
+///
+/// Usage: Beat --benchmark [scene.json] [--hidden-window] [--frames N] [--warmup N] [--dt seconds] [--seed N] [--input script.json] [--reloads N] [--out results.json]
+///        Beat --record recording.json [--scene scene.json] [--dt seconds] [--seed N]
+///        Beat --replay recording.json [--hidden-window] [--frames N] [--warmup N] [--out results.json]
+///        Beat --offscreen [scene.json] [--camera path.json] [--size 1280x720] [--gl-api native|egl|osmesa]
+///             [--checksum-every N] [--reference results.json] [--dump-frames folder] [--frames N] [--out results.json]
+///
+/// Reloads swap the scene out for a fresh copy of itself N times during the recorded frames, and report anything the
+/// unloaded copies left behind. Running "Beat --benchmark Level1.json --hidden-window --frames 120 --reloads 2" loads and
+/// unloads the scene twice, and it's results should have a leak check that passed. Frames that reload include the load
+/// in their timings, so leave reloads off for runs that are being compared for performance.
+///
+/// Replays are benchmarks that take their scene, timestep, seed, frame count and input from a recording.
+/// Offscreen runs are benchmarks that render every frame without presenting it, and hash the rendered image
+/// so that changes to the renderer can be checked against a reference run. For machines without a GPU, run them
+/// on Mesa's software renderer (ex: LIBGL_ALWAYS_SOFTWARE=1, or --gl-api osmesa)
+/// </summary>
+struct BenchmarkSettings {
+	// True if the application should run a benchmark instead of the game
+	bool        Enabled      = false;
+	// True if we should skip rendering, presenting and audio. The GL context still comes from a hidden window, so this needs a display
+	bool        HiddenWindow = false;
+	// The scene file to load and run
+	std::string ScenePath    = "Level1.json";
+	// The number of frames to record
+	int         Frames       = 600;
+	// The number of frames to run before recording, so that loading doesn't skew our results
+	int         WarmupFrames = 30;
+	// The fixed delta time to feed into every frame, in seconds
+	float       TimeStep     = 1.0f / 60.0f;
+	// The seed for gameplay randomness, so every run spawns the same level
+	uint32_t    Seed         = 0;
+	// An optional input script or recording to play back during the run
+	std::string InputPath;
+	// Where to write the results, leave empty to only print them
+	std::string OutputPath   = "benchmark.json";
+	// If set, the game runs normally at a fixed timestep and records all input to this path
+	std::string RecordPath;
+	// True if we should render every frame to a hidden window without presenting it
+	bool        Offscreen    = false;
+	// The size of the hidden window for offscreen runs, so images are comparable between machines
+	glm::ivec2  Resolution   = glm::ivec2(1280, 720);
+	// The API to create the GL context with for offscreen runs (native, egl or osmesa)
+	std::string GlApi        = "native";
+	// An optional camera path to fly the scene's main camera along
+	std::string CameraPath;
+	// How often to hash the rendered image in offscreen runs, in recorded frames. The last frame is always hashed
+	int         ChecksumInterval = 60;
+	// The results of a previous offscreen run to compare image hashes with
+	std::string ReferencePath;
+	// If set, every hashed frame is also written to this folder as a PNG
+	std::string FrameDumpPath;
+	// The number of times to reload the scene during the run, checking that each unloaded copy was freed
+	int         SceneReloads = 0;
+
+	/// <summary>
+	/// Returns true if the game should step with a fixed timestep rather than real time
+	/// </summary>
+	bool IsFixedStep() const { return Enabled || !RecordPath.empty(); }
+
+	/// <summary>
+	/// Parses benchmark settings from the application's command line arguments
+	/// </summary>
+	static BenchmarkSettings Parse(int argCount, char** arguments);
+};
+
+/// <summary>
+/// Runs a scene for a fixed number of frames with a fixed timestep, and collects
+/// timing statistics for the frame as a whole and every profiler zone on the main thread.
+/// When rendering, GPU pass timings and draw statistics are collected as well.
+/// Input can be scripted with a JSON file of key and mouse events:
+///
+/// { "events": [ { "frame": 10, "key": 32, "down": true }, { "frame": 14, "mouse": 0, "down": false } ] }
+///
+/// The camera can be scripted with a JSON file of keyframes, the camera moves linearly between them
+/// and holds at the last one. The scene is optional, and is used if one wasn't given on the command line:
+///
+/// { "scene": "Level1.json", "keys": [ { "time": 0.0, "position": [ 0, -15, 2 ], "target": [ 0, 0, 0 ] },
+///                                     { "time": 5.0, "position": [ 40, -15, 2 ], "target": [ 40, 0, 0 ] } ] }
+/// </summary>
+class BenchmarkRunner {
+public:
+	DEFINE_RESOURCE(BenchmarkRunner);
+
+	// The width of each bucket in our frame time histogram, in milliseconds
+	static constexpr double HistogramBucketMs = 0.5;
+	// The number of buckets in the histogram, anything longer lands in the overflow
+	static constexpr int    HistogramBuckets  = 80;
+
+	BenchmarkRunner(const BenchmarkSettings& settings);
+	~BenchmarkRunner();
+
+	/// <summary>
+	/// Gets the settings that the benchmark is running with
+	/// </summary>
+	const BenchmarkSettings& GetSettings() const;
+
+	/// <summary>
+	/// Gets the index of the current frame, including warmup frames
+	/// </summary>
+	int GetFrameIndex() const;
+
+	/// <summary>
+	/// Invoked at the start of every frame, applies any scripted input for the frame and
+	/// requests a scene reload if one is due
+	/// </summary>
+	void BeginFrame();
+	/// <summary>
+	/// Moves the scene's main camera along the camera path, invoked after the scene has updated
+	/// so that the path overrides any camera controllers
+	/// </summary>
+	void ApplyCamera(const Gameplay::Scene::Sptr& scene);
+
+	/// <summary>
+	/// Hashes the rendered image if this frame should be checksummed, invoked once the frame has been
+	/// fully rendered but before it is presented. The source is scaled into our own framebuffer the same
+	/// way it is presented, so that we never have to read from the hidden window itself
+	/// </summary>
+	/// <param name="source">The framebuffer holding the final image of the frame</param>
+	/// <param name="size">The size of the window's framebuffer in pixels</param>
+	void CaptureFrame(const Framebuffer::Sptr& source, const glm::ivec2& size);
+
+	/// <summary>
+	/// Invoked at the end of every frame, records timings for the frame
+	/// </summary>
+	/// <returns>True if the benchmark has recorded all of it's frames</returns>
+	bool EndFrame();
+
+	/// <summary>
+	/// Builds the results of the benchmark as JSON
+	/// </summary>
+	nlohmann::json GetResults() const;
+	/// <summary>
+	/// Prints the results to the console, and writes them to the output file if one was given
+	/// </summary>
+	void WriteResults() const;
+
+protected:
+	struct InputEvent {
+		int        Frame;
+		int        Key;
+		int        MouseButton;
+		bool       Down;
+		bool       IsCursor;
+		glm::dvec2 Cursor;
+	};
+
+	struct CameraKey {
+		float     Time;
+		glm::vec3 Position;
+		glm::vec3 Target;
+	};
+
+	struct FrameChecksum {
+		int         Frame;
+		std::string Hash;
+	};
+
+	BenchmarkSettings       _settings;
+	int                     _frameIndex;
+	uint64_t                _frameStart;
+	std::vector<InputEvent> _inputEvents;
+	size_t                  _nextInputEvent;
+
+	std::vector<double>                                  _frameTimes;
+	std::unordered_map<std::string, std::vector<double>> _zoneTimes;
+	std::vector<ProfileThreadCapture>                    _capture;
+	std::unordered_map<const char*, double>              _frameZoneTotals;
+
+	std::vector<CameraKey>     _cameraKeys;
+	std::vector<FrameChecksum> _checksums;
+	std::vector<uint8_t>       _pixels;
+	// Holds the captured image at the window's size and in a fixed format, so every run reads back the same way
+	Framebuffer::Sptr          _captureBuffer;
+	std::string                _renderer;
+	// Time spent reading back and hashing images this frame, which we leave out of the frame time
+	uint64_t                   _captureNs;
+
+	// GPU timings arrive a few frames late, so we track which frame we last took them from
+	uint64_t                                             _lastGpuFrame;
+	std::vector<double>                                  _gpuFrameTimes;
+	std::unordered_map<std::string, std::vector<double>> _gpuPassTimes;
+	std::unordered_map<const char*, double>              _framePassTotals;
+	std::unordered_map<std::string, std::vector<double>> _renderStats;
+
+	// Transient memory stats from the frame arena, the application ends the arena's frame right before ours
+	std::vector<double>        _heapAllocations;
+	std::vector<double>        _arenaBytes;
+
+	// The number of scene reloads we've requested so far
+	int                        _reloadsDone;
+
+	void _LoadInputScript(const std::string& path);
+	void _LoadCameraPath(const std::string& path);
+	bool _IsRecordingFrame() const;
+	void _RecordGpuStats();
+	nlohmann::json _CompareChecksums() const;
+	nlohmann::json _GetLeakCheck() const;
+	static nlohmann::json _Summarize(std::vector<double> samples);
+};
@@ -185,6 +185,7 @@ void ControlsMenuScene::_CreateScene()
 		Texture2D::Sptr TexBeatGemTutorial = ResourceManager::CreateAsset<Texture2D>("textures/GUI/BeatGems.png");
 		Texture2D::Sptr TexVinylsTutorial = ResourceManager::CreateAsset<Texture2D>("textures/GUI/Vinyls.png");
 		Font::Sptr FontVCR = ResourceManager::CreateAsset<Font>("fonts/VCR.ttf", 16.f);
+		FontVCR->SetAtlasMode(FontAtlasMode::SDF);
 		FontVCR->Bake();
 
 		Material::Sptr UIMat = ResourceManager::CreateAsset<Material>(deferredForward);
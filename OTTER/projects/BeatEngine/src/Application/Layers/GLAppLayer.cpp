@@ -17,6 +17,20 @@ void GLAppLayer::OnAppLoad(const nlohmann::json& config) {
 
 	Application& app = Application::Get();
 
+	// Hidden window runs still need a GL context for loading resources, so we use a window that's never shown. This still needs a display
+	if (app.IsHiddenWindow() || app.IsOffscreen()) {
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	}
+	// Offscreen runs can pick how the context is made, so they can run on Mesa's software renderer without a GPU
+	if (app.IsOffscreen()) {
+		const std::string& api = app._benchmarkSettings.GlApi;
+		if (api == "egl") {
+			glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+		} else if (api == "osmesa") {
+			glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+		}
+	}
+
 	//Create a new GLFW window and make it current
 	app._window = glfwCreateWindow(app._windowSize.x, app._windowSize.y, app._windowTitle.c_str(), nullptr, nullptr);
 	glfwMakeContextCurrent(app._window);
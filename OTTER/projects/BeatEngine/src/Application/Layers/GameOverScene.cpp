@@ -159,6 +159,7 @@ void GameOverScene::_CreateScene()
 		Texture2D::Sptr TexNavigationLeftRight = ResourceManager::CreateAsset<Texture2D>("textures/GUI/NavigationLeftRight.png");
 		Texture2D::Sptr TexNavigationUpDown = ResourceManager::CreateAsset<Texture2D>("textures/GUI/NavigationUpDown.png");
 		Font::Sptr FontVCR = ResourceManager::CreateAsset<Font>("fonts/VCR.ttf", 16.f);
+		FontVCR->SetAtlasMode(FontAtlasMode::SDF);
 		FontVCR->Bake();
 
 		Material::Sptr UIMat = ResourceManager::CreateAsset<Material>(basicShader);
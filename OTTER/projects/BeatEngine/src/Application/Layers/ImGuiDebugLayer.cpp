@@ -15,6 +15,9 @@
 #include "../Windows/DebugWindow.h"
 #include "../Windows/GBufferPreviews.h"
 #include "../Windows/PostProcessingSettingsWindow.h"
+#include "../Windows/ProfilerWindow.h"
+#include "../Windows/RenderStatsWindow.h"
+#include "../Windows/MemoryWindow.h"
 #include "FMOD/AudioEngine.h"
 
 #include "Graphics/DebugDraw.h"
@@ -41,6 +44,9 @@ void ImGuiDebugLayer::OnAppLoad(const nlohmann::json & config)
 	RegisterWindow<DebugWindow>();
 	RegisterWindow<GBufferPreviews>();
 	RegisterWindow<PostProcessingSettingsWindow>();
+	RegisterWindow<ProfilerWindow>();
+	RegisterWindow<RenderStatsWindow>();
+	RegisterWindow<MemoryWindow>();
 }
 
 void ImGuiDebugLayer::OnAppUnload()
@@ -294,7 +300,7 @@ void ImGuiDebugLayer::_RenderGameWindow()
 
 	// Janky ass button text for the play/stop button
 	static char buffer[64];
-	sprintf_s(buffer, "%s###PLAY_STOP", scene->IsPlaying ? "[]" : ">");
+	snprintf(buffer, sizeof(buffer), "%s###PLAY_STOP", scene->IsPlaying ? "[]" : ">");
 
 	// Remove spacing around buttons
 	ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
@@ -1,5 +1,6 @@
 #include "InterfaceLayer.h"
 #include "Graphics/GuiBatcher.h"
+#include "Graphics/GpuProfiler.h"
 #include <GLM/glm.hpp>
 #include <GLM/gtc/matrix_transform.hpp>
 #include "../Application.h"
@@ -15,6 +16,8 @@ InterfaceLayer::~InterfaceLayer()
 { }
 
 void InterfaceLayer::OnRender(const Framebuffer::Sptr& prevLayer) {
+	GPU_PASS("GUI");
+
 	// Gets the application instance
 	Application& app = Application::Get();
 
@@ -326,6 +326,7 @@ void Level1Scene::_CreateScene()
 		 Texture2D::Sptr TexNavigationUpDown = ResourceManager::CreateAsset<Texture2D>("textures/GUI/NavigationUpDown.png");
 		
 		 Font::Sptr FontVCR = ResourceManager::CreateAsset<Font>("fonts/VCR.ttf", 16.f);
+		 FontVCR->SetAtlasMode(FontAtlasMode::SDF);
 		 FontVCR->Bake();
 
 		 // In Order For the Toon Shader to Work you must include this line on each object using the shader
@@ -664,6 +665,8 @@ void Level1Scene::_CreateScene()
 			//RigidBody::Sptr physics = GameManager->Add<RigidBody>(RigidBodyType::Kinematic);
 			GameManager->Add<BeatTimer>();
 			GameManager->Add<SpawnLoop>();
+			// Runs our spawning and scene management, so it can never go to sleep
+			GameManager->AlwaysActive = true;
 			//ScoreComponent
 			//LevelSpawningComponent
 			//Scene Swapper
@@ -1321,6 +1324,16 @@ void Level1Scene::_CreateScene()
 		
 
 
+		// Scroll the player and camera through the level instead of moving every level object
+		scene->SetWorldScrollEnabled(true);
+		scene->SetWorldScrollVelocity(glm::vec3(1.0f, 0.0f, 0.0f));
+		scene->AddScrollFollower(scene->MainCamera->GetGameObject()->SelfRef());
+		scene->AddScrollFollower(character);
+
+		// Objects that are far from the camera and player (ex: collected pickups) stop updating and simulating
+		scene->SetActivationRadius(80.0f);
+		scene->AddActivationAnchor(character);
+
 		GuiBatcher::SetDefaultTexture(ResourceManager::CreateAsset<Texture2D>("textures/ui-sprite.png"));
 		GuiBatcher::SetDefaultBorderRadius(8);
 
@@ -1,16 +1,52 @@
 #include "LogicUpdateLayer.h"
 #include "../Application.h"
 #include "../Timing.h"
+#include "Utils/JsonGlmHelpers.h"
 
 LogicUpdateLayer::LogicUpdateLayer() :
-	ApplicationLayer()
+	ApplicationLayer(),
+	_physicsRate(120.0f),
+	_maxSubSteps(8)
 {
 	Name = "Logic";
-	Overrides = AppLayerFunctions::OnUpdate;
+	Overrides = AppLayerFunctions::OnAppLoad | AppLayerFunctions::OnSceneLoad | AppLayerFunctions::OnUpdate;
 }
 
 LogicUpdateLayer::~LogicUpdateLayer() = default;
 
+void LogicUpdateLayer::SetPhysicsRate(float value) {
+	_physicsRate = value > 0.0f ? value : _physicsRate;
+	_ApplyPhysicsSettings();
+}
+
+float LogicUpdateLayer::GetPhysicsRate() const {
+	return _physicsRate;
+}
+
+void LogicUpdateLayer::SetMaxSubSteps(int value) {
+	_maxSubSteps = value < 1 ? 1 : value;
+	_ApplyPhysicsSettings();
+}
+
+int LogicUpdateLayer::GetMaxSubSteps() const {
+	return _maxSubSteps;
+}
+
+void LogicUpdateLayer::OnAppLoad(const nlohmann::json& config)
+{
+	// Pull our physics settings out of the app config, falling back to our defaults
+	if (config.contains(Name) && config[Name].is_object()) {
+		const nlohmann::json& settings = config[Name];
+		SetPhysicsRate(JsonGet(settings, "physics_rate", _physicsRate));
+		SetMaxSubSteps(JsonGet(settings, "max_physics_substeps", _maxSubSteps));
+	}
+}
+
+void LogicUpdateLayer::OnSceneLoad()
+{
+	_ApplyPhysicsSettings();
+}
+
 void LogicUpdateLayer::OnUpdate()
 {
 	Application& app = Application::Get();
@@ -18,6 +54,23 @@ void LogicUpdateLayer::OnUpdate()
 	// Perform updates for all components
 	app.CurrentScene()->Update(Timing::Current().DeltaTime());
 
-	// Update our worlds physics!
+	// Update our worlds physics! The scene handles splitting the frame into fixed steps
 	app.CurrentScene()->DoPhysics(Timing::Current().DeltaTime());
 }
+
+nlohmann::json LogicUpdateLayer::GetDefaultConfig()
+{
+	nlohmann::json result;
+	result["physics_rate"] = _physicsRate;
+	result["max_physics_substeps"] = _maxSubSteps;
+	return result;
+}
+
+void LogicUpdateLayer::_ApplyPhysicsSettings()
+{
+	Gameplay::Scene::Sptr scene = Application::Get().CurrentScene();
+	if (scene != nullptr) {
+		scene->SetPhysicsTimestep(1.0f / _physicsRate);
+		scene->SetMaxPhysicsSubSteps(_maxSubSteps);
+	}
+}
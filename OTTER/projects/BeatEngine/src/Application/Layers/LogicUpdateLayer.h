@@ -8,10 +8,40 @@ public:
 	LogicUpdateLayer();
 	virtual ~LogicUpdateLayer();
 
+	/**
+	 * Sets the number of fixed physics steps to take per second
+	 * 
+	 * @param value The new physics rate in Hz, should be greater than zero
+	 */
+	void SetPhysicsRate(float value);
+	/**
+	 * Gets the number of fixed physics steps taken per second
+	 */
+	float GetPhysicsRate() const;
+
+	/**
+	 * Sets the maximum number of physics steps that may be taken in a single frame
+	 * 
+	 * @param value The new maximum number of substeps, should be at least 1
+	 */
+	void SetMaxSubSteps(int value);
+	/**
+	 * Gets the maximum number of physics steps that may be taken in a single frame
+	 */
+	int GetMaxSubSteps() const;
+
 	// Inherited from ApplicationLayer
 
+	virtual void OnAppLoad(const nlohmann::json& config) override;
+	virtual void OnSceneLoad() override;
 	virtual void OnUpdate() override;
+	virtual nlohmann::json GetDefaultConfig() override;
 
 protected:
+	// The number of fixed physics steps per second
+	float _physicsRate;
+	// The maximum number of physics steps per frame
+	int   _maxSubSteps;
 
-};
\ No newline at end of file
+	void _ApplyPhysicsSettings();
+};
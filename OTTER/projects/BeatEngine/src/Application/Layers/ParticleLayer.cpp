@@ -2,6 +2,7 @@
 #include "Gameplay/Components/ParticleSystem.h"
 #include "Application/Application.h"
 #include "RenderLayer.h"
+#include "Graphics/GpuProfiler.h"
 
 ParticleLayer::ParticleLayer() :
 	ApplicationLayer()
@@ -22,6 +23,7 @@ void ParticleLayer::OnUpdate()
 	// Only update the particle systems when the game is playing, so we can edit them in
 	// the inspector
 	if (app.CurrentScene()->IsPlaying) {
+		GPU_PASS("Particle Simulation");
 		app.CurrentScene()->Components().Each<ParticleSystem>([](const ParticleSystem::Sptr& system) {
 			if (system->IsEnabled) {
 				system->Update();
@@ -32,6 +34,8 @@ void ParticleLayer::OnUpdate()
 
 void ParticleLayer::OnPostRender()
 {
+	GPU_PASS("Particles");
+
 	Application& app = Application::Get();
 	const glm::uvec4& viewport = app.GetPrimaryViewport();
 
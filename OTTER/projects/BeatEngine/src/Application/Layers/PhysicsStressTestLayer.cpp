@@ -0,0 +1,90 @@
+#include "PhysicsStressTestLayer.h"
+
+#include <chrono>
+
+#include "Application/Application.h"
+#include "Gameplay/Scene.h"
+#include "Gameplay/Physics/RigidBody.h"
+#include "Gameplay/Physics/Colliders/BoxCollider.h"
+#include "Utils/JsonGlmHelpers.h"
+#include "Utils/ThreadPool.h"
+#include "Logging.h"
+
+PhysicsStressTestLayer::PhysicsStressTestLayer() :
+	ApplicationLayer(),
+	_gridSize({ 10, 10, 5 }),
+	_numFrames(600),
+	_numThreads(0)
+{
+	Name = "Physics Stress Test";
+	Overrides = AppLayerFunctions::OnAppLoad;
+}
+
+PhysicsStressTestLayer::~PhysicsStressTestLayer() = default;
+
+void PhysicsStressTestLayer::OnAppLoad(const nlohmann::json& config) {
+	if (config.contains(Name) && config[Name].is_object()) {
+		const nlohmann::json& settings = config[Name];
+		_gridSize   = JsonGet(settings, "grid_size", _gridSize);
+		_numFrames  = JsonGet(settings, "frames", _numFrames);
+		_numThreads = JsonGet(settings, "threads", _numThreads);
+	}
+
+	int threads = _numThreads > 0 ? _numThreads : ThreadPool::HardwareThreads();
+
+	LOG_INFO("Running physics stress test with {} bodies for {} frames", _gridSize.x * _gridSize.y * _gridSize.z, _numFrames);
+	double singleThreaded = _RunBenchmark(1);
+	double multiThreaded  = _RunBenchmark(threads);
+	LOG_INFO("  1 thread:   {:.3f} ms/frame", singleThreaded);
+	LOG_INFO("  {} threads: {:.3f} ms/frame ({:.2f}x)", threads, multiThreaded, singleThreaded / multiThreaded);
+}
+
+nlohmann::json PhysicsStressTestLayer::GetDefaultConfig() {
+	nlohmann::json result;
+	result["grid_size"] = _gridSize;
+	result["frames"]    = _numFrames;
+	result["threads"]   = _numThreads;
+	return result;
+}
+
+double PhysicsStressTestLayer::_RunBenchmark(int threads) {
+	using namespace Gameplay;
+	using namespace Gameplay::Physics;
+
+	Scene::Sptr scene = std::make_shared<Scene>();
+	scene->SetPhysicsThreadCount(threads);
+
+	// A big static floor for everything to land on
+	GameObject::Sptr floor = scene->CreateGameObject("Floor");
+	RigidBody::Sptr floorBody = floor->Add<RigidBody>(RigidBodyType::Static);
+	floorBody->AddCollider(BoxCollider::Create(glm::vec3(100.0f, 100.0f, 1.0f)))->SetPosition({ 0.0f, 0.0f, -1.0f });
+
+	// Stack our bodies slightly offset so they topple into each other
+	const float spacing = 1.1f;
+	for (int ix = 0; ix < _gridSize.x; ix++) {
+		for (int iy = 0; iy < _gridSize.y; iy++) {
+			for (int iz = 0; iz < _gridSize.z; iz++) {
+				GameObject::Sptr box = scene->CreateGameObject("Box");
+				box->HideInHierarchy = true;
+				box->SetPostion({ ix * spacing + iz * 0.1f, iy * spacing, 1.0f + iz * spacing });
+				RigidBody::Sptr body = box->Add<RigidBody>(RigidBodyType::Dynamic);
+				body->AddCollider(BoxCollider::Create(glm::vec3(0.5f)));
+			}
+		}
+	}
+
+	scene->Awake();
+	scene->IsPlaying = true;
+
+	// Step with a fixed frame time so both runs do exactly the same amount of work
+	const float dt = 1.0f / 60.0f;
+	double totalMs = 0.0;
+	for (int frame = 0; frame < _numFrames; frame++) {
+		auto start = std::chrono::high_resolution_clock::now();
+		scene->DoPhysics(dt);
+		auto end = std::chrono::high_resolution_clock::now();
+		totalMs += std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	return totalMs / _numFrames;
+}
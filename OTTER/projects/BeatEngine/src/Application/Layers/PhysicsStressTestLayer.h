@@ -0,0 +1,35 @@
+#pragma once
+#include "Application/ApplicationLayer.h"
+
+/**
+ * Benchmarks the physics world by simulating a stack of several hundred dynamic bodies, once
+ * with the single threaded world and once with the multithreaded world, and logs the results
+ */
+class PhysicsStressTestLayer final : public ApplicationLayer {
+public:
+	MAKE_PTRS(PhysicsStressTestLayer)
+
+	PhysicsStressTestLayer();
+	virtual ~PhysicsStressTestLayer();
+
+	// Inherited from ApplicationLayer
+
+	virtual void OnAppLoad(const nlohmann::json& config) override;
+	virtual nlohmann::json GetDefaultConfig() override;
+
+protected:
+	// The number of bodies along each axis of our stack
+	glm::ivec3 _gridSize;
+	// The number of frames to simulate for each run
+	int        _numFrames;
+	// The number of threads to use for the multithreaded run, 0 to use all hardware threads
+	int        _numThreads;
+
+	/**
+	 * Builds the stress scene and simulates it for the configured number of frames
+	 * 
+	 * @param threads The number of physics threads to use for the scene
+	 * @returns The average time spent in DoPhysics per frame, in milliseconds
+	 */
+	double _RunBenchmark(int threads);
+};
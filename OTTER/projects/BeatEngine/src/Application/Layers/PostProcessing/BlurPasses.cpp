@@ -0,0 +1,158 @@
+#include "BlurPasses.h"
+#include "Utils/ResourceManager/ResourceManager.h"
+
+BlurPasses::BlurPasses() :
+	_separableShader(nullptr),
+	_computeShader(nullptr),
+	_downsampleShader(nullptr),
+	_scratch(nullptr)
+{
+	_separableShader = ResourceManager::CreateAsset<ShaderProgram>(std::unordered_map<ShaderPartType, std::string>{
+		{ ShaderPartType::Vertex, "shaders/vertex_shaders/fullscreen_quad.glsl" },
+		{ ShaderPartType::Fragment, "shaders/fragment_shaders/post_effects/blur/separable.glsl" }
+	});
+	_computeShader = ResourceManager::CreateAsset<ShaderProgram>(std::unordered_map<ShaderPartType, std::string>{
+		{ ShaderPartType::Compute, "shaders/compute_shaders/blur_tile.glsl" }
+	});
+	_downsampleShader = ResourceManager::CreateAsset<ShaderProgram>(std::unordered_map<ShaderPartType, std::string>{
+		{ ShaderPartType::Vertex, "shaders/vertex_shaders/fullscreen_quad.glsl" },
+		{ ShaderPartType::Fragment, "shaders/fragment_shaders/post_effects/blur/downsample.glsl" }
+	});
+}
+
+BlurPasses::~BlurPasses() = default;
+
+BlurMode BlurPasses::Apply(PostProcessingLayer::Effect& effect, const Framebuffer::Sptr& output, const float* kernel, int size, const glm::vec2& pixelSize, BlurMode mode)
+{
+	int radius = size / 2;
+	if (mode == BlurMode::Kernel2D || size % 2 == 0 || radius > MaxRadius) {
+		return BlurMode::Kernel2D;
+	}
+
+	std::vector<float> row, column;
+	if (!Separate(kernel, size, row, column)) {
+		return BlurMode::Kernel2D;
+	}
+
+	// The compute path skips the scratch buffer and the second fullscreen pass, so we prefer it when it can be used
+	if ((mode == BlurMode::Auto || mode == BlurMode::Compute) && ApplyCompute(output, row, column)) {
+		return BlurMode::Compute;
+	}
+
+	ApplySeparable(effect, output, row, column, pixelSize);
+	return BlurMode::Separable;
+}
+
+void BlurPasses::ApplySeparable(PostProcessingLayer::Effect& effect, const Framebuffer::Sptr& output, const std::vector<float>& row, const std::vector<float>& column, const glm::vec2& pixelSize)
+{
+	LOG_ASSERT(row.size() % 2 == 1 && row.size() == column.size(), "Separable kernels need an odd number of weights");
+	LOG_ASSERT((int)row.size() <= MaxRadius * 2 + 1, "Kernel is too large for the separable blur");
+
+	PrepareTarget(_scratch, output->GetSize(), RenderTargetType::ColorRgba16F);
+
+	// Horizontal pass, from slot 0 into the scratch buffer
+	_scratch->Bind();
+	glViewport(0, 0, _scratch->GetWidth(), _scratch->GetHeight());
+	_separableShader->Bind();
+	_separableShader->SetUniform("u_Weights", row.data(), (int)row.size());
+	_separableShader->SetUniform("u_Radius", (int)row.size() / 2);
+	_separableShader->SetUniform("u_Step", glm::vec2(pixelSize.x, 0.0f));
+	effect.DrawFullscreen();
+
+	// Vertical pass, left bound for the layer to draw into the output
+	output->Bind();
+	glViewport(0, 0, output->GetWidth(), output->GetHeight());
+	_scratch->BindAttachment(RenderTargetAttachment::Color0, 0);
+	_separableShader->SetUniform("u_Weights", column.data(), (int)column.size());
+	_separableShader->SetUniform("u_Step", glm::vec2(0.0f, pixelSize.y));
+}
+
+bool BlurPasses::ApplyCompute(const Framebuffer::Sptr& output, const std::vector<float>& row, const std::vector<float>& column)
+{
+	if ((int)row.size() > MaxComputeRadius * 2 + 1 || row.size() != column.size()) {
+		return false;
+	}
+
+	// Image stores need a format that images support, which rules out RGB8
+	Texture2D::Sptr target = output->GetTextureAttachment(RenderTargetAttachment::Color0);
+	if (target == nullptr || target->GetFormat() != InternalFormat::RGBA8) {
+		return false;
+	}
+
+	_computeShader->Bind();
+	_computeShader->SetUniform("u_Row", row.data(), (int)row.size());
+	_computeShader->SetUniform("u_Column", column.data(), (int)column.size());
+	_computeShader->SetUniform("u_Radius", (int)row.size() / 2);
+
+	glBindImageTexture(0, target->GetHandle(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+	glDispatchCompute((target->GetWidth() + 15) / 16, (target->GetHeight() + 15) / 16, 1);
+	glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+
+	// The next pass samples or blits the output, which doesn't wait on image stores on it's own
+	glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT);
+	return true;
+}
+
+void BlurPasses::Downsample(PostProcessingLayer::Effect& effect, const Framebuffer::Sptr& output, DownsampleAlpha alpha, const Framebuffer::Sptr& depthSource)
+{
+	LOG_ASSERT(alpha != DownsampleAlpha::NearestDepth || depthSource != nullptr, "Downsampling with depth needs a depth buffer");
+
+	output->Bind();
+	glViewport(0, 0, output->GetWidth(), output->GetHeight());
+	_downsampleShader->Bind();
+	_downsampleShader->SetUniform("u_AlphaMode", *alpha);
+	if (depthSource != nullptr) {
+		depthSource->BindAttachment(RenderTargetAttachment::Depth, 1);
+	}
+	effect.DrawFullscreen();
+}
+
+bool BlurPasses::Separate(const float* kernel, int size, std::vector<float>& row, std::vector<float>& column, float tolerance)
+{
+	row.assign(size, 0.0f);
+	column.assign(size, 0.0f);
+
+	// Any row and column through the largest weight can be scaled to rebuild the kernel, if it's separable at all
+	int pivotRow = 0, pivotColumn = 0;
+	for (int ix = 0; ix < size * size; ix++) {
+		if (glm::abs(kernel[ix]) > glm::abs(kernel[pivotRow * size + pivotColumn])) {
+			pivotRow = ix / size;
+			pivotColumn = ix % size;
+		}
+	}
+	float pivot = kernel[pivotRow * size + pivotColumn];
+	if (pivot == 0.0f) {
+		// An empty kernel, the row is already all zeros
+		column.assign(size, 1.0f);
+		return true;
+	}
+
+	for (int ix = 0; ix < size; ix++) {
+		row[ix] = kernel[pivotRow * size + ix];
+		column[ix] = kernel[ix * size + pivotColumn] / pivot;
+	}
+
+	float limit = tolerance * glm::max(1.0f, glm::abs(pivot));
+	for (int iy = 0; iy < size; iy++) {
+		for (int ix = 0; ix < size; ix++) {
+			if (glm::abs(kernel[iy * size + ix] - column[iy] * row[ix]) > limit) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void BlurPasses::PrepareTarget(Framebuffer::Sptr& buffer, const glm::ivec2& size, RenderTargetType format)
+{
+	glm::ivec2 clamped = glm::max(size, glm::ivec2(1));
+	if (buffer == nullptr) {
+		FramebufferDescriptor fboDesc = FramebufferDescriptor();
+		fboDesc.Width = clamped.x;
+		fboDesc.Height = clamped.y;
+		fboDesc.RenderTargets[RenderTargetAttachment::Color0] = RenderTargetDescriptor(format);
+		buffer = std::make_shared<Framebuffer>(fboDesc);
+	} else if (buffer->GetSize() != clamped) {
+		buffer->Resize(clamped);
+	}
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <vector>
+#include <EnumToString.h>
+
+#include "Application/Layers/PostProcessingLayer.h"
+#include "Graphics/ShaderProgram.h"
+#include "Graphics/Framebuffer.h"
+
+/**
+ * The ways that BlurPasses can apply a kernel
+ */
+ENUM(BlurMode, int,
+	// Picks the fastest path that the kernel allows
+	Auto      = 0,
+	// A single pass that samples the full 2D kernel, works for any kernel
+	Kernel2D  = 1,
+	// Two 1D passes, for kernels that are the outer product of a row and a column (ex: box and gaussian blurs)
+	Separable = 2,
+	// A single compute dispatch that blurs tiles out of shared memory, for separable kernels up to MaxComputeRadius
+	Compute   = 3
+);
+
+/**
+ * What a downsample pass stores in the alpha channel of it's output
+ */
+ENUM(DownsampleAlpha, int,
+	// Averages the input's alpha like the other channels
+	Average      = 0,
+	// Stores the distance to the camera of the nearest surface, read from a depth buffer
+	NearestDepth = 1,
+	// Keeps the smallest alpha of the input texels (ex: to carry a stored distance down the chain)
+	Min          = 2
+);
+
+/**
+ * Shared blur passes for post processing effects, so that effects don't each need their own
+ * kernels. Each instance keeps the scratch buffer it needs between passes, so effects should
+ * have their own instance.
+ *
+ * All of the passes read the image from texture slot 0, and expect the layer's fullscreen quad
+ * to be bound (which it is while effects are being applied)
+ */
+class BlurPasses {
+public:
+	MAKE_PTRS(BlurPasses);
+	NO_COPY(BlurPasses);
+	NO_MOVE(BlurPasses);
+
+	// The largest radius the separable path supports, limited by the size of the weights array in the shader
+	static const int MaxRadius = 32;
+	// The largest radius the compute path supports, limited by the apron around each tile in shared memory
+	static const int MaxComputeRadius = 8;
+
+	BlurPasses();
+	~BlurPasses();
+
+	/**
+	 * Blurs the image in slot 0 into output with a square kernel, splitting it into a row and a
+	 * column when it's separable
+	 * @param effect The effect that's applying the blur, used to draw
+	 * @param output The framebuffer the effect is rendering into
+	 * @param kernel The weights of the kernel, row by row from the bottom
+	 * @param size The width and height of the kernel, must be odd
+	 * @param pixelSize The size of a texel in the image being blurred, in UV space
+	 * @param mode The path to use, paths that can't apply the kernel fall back to the next best one
+	 * @returns The path that was used. For Separable, the second pass is left bound, and the layer's
+	 *          draw finishes it. For Compute, the output has been written. For Kernel2D nothing was
+	 *          done, and the effect should apply the kernel itself
+	 */
+	BlurMode Apply(PostProcessingLayer::Effect& effect, const Framebuffer::Sptr& output, const float* kernel, int size, const glm::vec2& pixelSize, BlurMode mode = BlurMode::Auto);
+
+	/**
+	 * Runs the horizontal half of a separable blur into a scratch buffer, then binds the output and
+	 * the vertical half so that the next fullscreen draw finishes the blur
+	 */
+	void ApplySeparable(PostProcessingLayer::Effect& effect, const Framebuffer::Sptr& output, const std::vector<float>& row, const std::vector<float>& column, const glm::vec2& pixelSize);
+	/**
+	 * Blurs the image in slot 0 straight into the output's color attachment with a compute shader
+	 * @returns False if the kernel or output can't be used with the compute path
+	 */
+	bool ApplyCompute(const Framebuffer::Sptr& output, const std::vector<float>& row, const std::vector<float>& column);
+
+	/**
+	 * Renders the image in slot 0 into output, which should be half it's size. Chaining these builds
+	 * the half and quarter resolution images for effects that blur at a lower resolution
+	 * @param effect The effect that's downsampling, used to draw
+	 * @param output The framebuffer to render into
+	 * @param alpha What to store in the output's alpha channel
+	 * @param depthSource The framebuffer to read depth from for DownsampleAlpha::NearestDepth
+	 */
+	void Downsample(PostProcessingLayer::Effect& effect, const Framebuffer::Sptr& output, DownsampleAlpha alpha = DownsampleAlpha::Average, const Framebuffer::Sptr& depthSource = nullptr);
+
+	/**
+	 * Splits a square kernel into a row and a column whose outer product is the kernel, if there is one
+	 * @returns True if the kernel is separable within the given tolerance
+	 */
+	static bool Separate(const float* kernel, int size, std::vector<float>& row, std::vector<float>& column, float tolerance = 1.0e-4f);
+
+	/**
+	 * Creates or resizes a single color target framebuffer, for effects that keep intermediate buffers
+	 */
+	static void PrepareTarget(Framebuffer::Sptr& buffer, const glm::ivec2& size, RenderTargetType format);
+
+protected:
+	ShaderProgram::Sptr _separableShader;
+	ShaderProgram::Sptr _computeShader;
+	ShaderProgram::Sptr _downsampleShader;
+
+	// Holds the result of the horizontal pass. Kept at half float, so that kernels with negative
+	// weights (ex: sharpening) aren't clamped between the passes
+	Framebuffer::Sptr   _scratch;
+};
@@ -7,10 +7,13 @@
 #include <GLM/glm.hpp>
 
 BoxFilter3x3::BoxFilter3x3() :
-	PostProcessingLayer::Effect()
+	PostProcessingLayer::Effect(),
+	Mode(BlurMode::Auto),
+	_blur(std::make_shared<BlurPasses>())
 {
 	Name = "Box Filter";
-	_format = RenderTargetType::ColorRgb8;
+	// RGBA so that the compute path can write to it, RGB8 isn't supported by image stores
+	_format = RenderTargetType::ColorRgba8;
 
 	// Zero the memory, then set center pixel to 1.0
 	memset(Filter, 0, sizeof(float) * 9);
@@ -26,9 +29,17 @@ BoxFilter3x3::~BoxFilter3x3() = default;
 
 void BoxFilter3x3::Apply(const Framebuffer::Sptr& gBuffer)
 {
-	_shader->Bind(); 
-	_shader->SetUniform("u_Filter", Filter, 9); 
-	_shader->SetUniform("u_PixelSize", glm::vec2(1.0f) / (glm::vec2)gBuffer->GetSize()); 
+	glm::vec2 pixelSize = glm::vec2(1.0f) / (glm::vec2)gBuffer->GetSize();
+
+	// Let the blur passes take the kernel if it's separable, otherwise we sample the whole thing
+	BlurMode applied = _blur->Apply(*this, _output, Filter, 3, pixelSize, Mode);
+	if (applied == BlurMode::Compute) {
+		_outputWritten = true;
+	} else if (applied == BlurMode::Kernel2D) {
+		_shader->Bind();
+		_shader->SetUniform("u_Filter", Filter, 9);
+		_shader->SetUniform("u_PixelSize", pixelSize);
+	}
 }
 
 void BoxFilter3x3::RenderImGui()
@@ -73,6 +84,8 @@ void BoxFilter3x3::RenderImGui()
 		}
 	}
 
+	ENUM_COMBO("Path", &Mode, BlurMode)
+
 	ImGui::PopID();
 }
 
@@ -84,6 +97,7 @@ BoxFilter3x3::Sptr BoxFilter3x3::FromJson(const nlohmann::json& data)
 	for (int ix = 0; ix < 9; ix++) {
 		result->Filter[ix] = filter[ix];
 	}
+	result->Mode = ParseBlurMode(JsonGet<std::string>(data, "mode", "Auto"), BlurMode::Auto);
 	return result;
 }
 
@@ -95,6 +109,7 @@ nlohmann::json BoxFilter3x3::ToJson() const
 	}
 	return {
 		{ "enabled", Enabled },
-		{ "filter", filter }
+		{ "filter", filter },
+		{ "mode", ~Mode }
 	};
 }
@@ -3,11 +3,14 @@
 #include "Graphics/ShaderProgram.h"
 #include "Graphics/Textures/Texture3D.h"
 #include "Graphics/Framebuffer.h"
+#include "BlurPasses.h"
 
 class BoxFilter3x3 : public PostProcessingLayer::Effect {
 public:
 	MAKE_PTRS(BoxFilter3x3);
 	float Filter[9];
+	// How the filter gets applied, separable filters (ex: a box or gaussian blur) can skip most of the samples
+	BlurMode Mode;
 
 	BoxFilter3x3();
 	virtual ~BoxFilter3x3();
@@ -22,5 +25,6 @@ public:
 
 protected:
 	ShaderProgram::Sptr _shader;
+	BlurPasses::Sptr    _blur;
 };
 
@@ -7,10 +7,13 @@
 #include <GLM/glm.hpp>
 
 BoxFilter5x5::BoxFilter5x5() :
-	PostProcessingLayer::Effect()
+	PostProcessingLayer::Effect(),
+	Mode(BlurMode::Auto),
+	_blur(std::make_shared<BlurPasses>())
 {
 	Name = "Box Filter";
-	_format = RenderTargetType::ColorRgb8;
+	// RGBA so that the compute path can write to it, RGB8 isn't supported by image stores
+	_format = RenderTargetType::ColorRgba8;
 
 	memset(Filter, 0, sizeof(float) * 25);
 	Filter[12] = 1.0f;
@@ -25,9 +28,17 @@ BoxFilter5x5::~BoxFilter5x5() = default;
 
 void BoxFilter5x5::Apply(const Framebuffer::Sptr& gBuffer)
 {
-	_shader->Bind();
-	_shader->SetUniform("u_Filter", Filter, 25);
-	_shader->SetUniform("u_PixelSize", glm::vec2(1.0f) / (glm::vec2)gBuffer->GetSize()); 
+	glm::vec2 pixelSize = glm::vec2(1.0f) / (glm::vec2)gBuffer->GetSize();
+
+	// Let the blur passes take the kernel if it's separable, otherwise we sample the whole thing
+	BlurMode applied = _blur->Apply(*this, _output, Filter, 5, pixelSize, Mode);
+	if (applied == BlurMode::Compute) {
+		_outputWritten = true;
+	} else if (applied == BlurMode::Kernel2D) {
+		_shader->Bind();
+		_shader->SetUniform("u_Filter", Filter, 25);
+		_shader->SetUniform("u_PixelSize", pixelSize);
+	}
 }
 
 void BoxFilter5x5::RenderImGui()
@@ -71,6 +82,8 @@ void BoxFilter5x5::RenderImGui()
 		}
 	}
 
+	ENUM_COMBO("Path", &Mode, BlurMode)
+
 	ImGui::PopID();
 }
 
@@ -82,6 +95,7 @@ BoxFilter5x5::Sptr BoxFilter5x5::FromJson(const nlohmann::json& data)
 	for (int ix = 0; ix < 25; ix++) {
 		result->Filter[ix] = filter[ix];
 	}
+	result->Mode = ParseBlurMode(JsonGet<std::string>(data, "mode", "Auto"), BlurMode::Auto);
 	return result;
 }
 
@@ -93,6 +107,7 @@ nlohmann::json BoxFilter5x5::ToJson() const
 	}
 	return {
 		{ "enabled", Enabled },
-		{ "filter", filter }
+		{ "filter", filter },
+		{ "mode", ~Mode }
 	};
 }
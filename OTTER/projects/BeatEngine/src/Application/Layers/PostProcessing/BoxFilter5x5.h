@@ -3,11 +3,14 @@
 #include "Graphics/ShaderProgram.h"
 #include "Graphics/Textures/Texture3D.h"
 #include "Graphics/Framebuffer.h"
+#include "BlurPasses.h"
 
 class BoxFilter5x5 : public PostProcessingLayer::Effect {
 public:
 	MAKE_PTRS(BoxFilter5x5);
 	float Filter[25];
+	// How the filter gets applied, separable filters (ex: a box or gaussian blur) can skip most of the samples
+	BlurMode Mode;
 
 	BoxFilter5x5();
 	virtual ~BoxFilter5x5();
@@ -22,4 +25,5 @@ public:
 
 protected:
 	ShaderProgram::Sptr _shader;
+	BlurPasses::Sptr    _blur;
 };
\ No newline at end of file
@@ -34,6 +34,22 @@ void CelShaderEffect::Apply(const Framebuffer::Sptr& gBuffer)
 	//gBuffer->BindAttachment(RenderTargetAttachment::Color1, 2); // The normal buffer
 }
 
+EffectFusion CelShaderEffect::GetFusion() const
+{
+	return EffectFusion::PerPixel;
+}
+
+std::string CelShaderEffect::GetStageSource() const
+{
+	return "shaders/fragment_shaders/post_effects/stages/cel_shader.glsl";
+}
+
+void CelShaderEffect::ApplyStage(const Framebuffer::Sptr& gBuffer, PostProcessingLayer::FusedStage& stage)
+{
+	stage.BindTexture("ToonTerm", _ToonTerm);
+	stage.SetUniform("Discard", _Discard);
+}
+
 void CelShaderEffect::RenderImGui()
 {
 	LABEL_LEFT(ImGui::SliderFloat,  "Discard Threshold", &_Discard, 0.f, 1.0f);
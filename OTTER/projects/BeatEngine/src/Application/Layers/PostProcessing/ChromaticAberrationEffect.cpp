@@ -31,6 +31,21 @@ void ChromaticAberrationEffect::Apply(const Framebuffer::Sptr& gBuffer)
 	_shader->SetUniform("u_Strength", _strength);
 }
 
+EffectFusion ChromaticAberrationEffect::GetFusion() const
+{
+	return EffectFusion::Resample;
+}
+
+std::string ChromaticAberrationEffect::GetStageSource() const
+{
+	return "shaders/fragment_shaders/post_effects/stages/chromatic_aberration.glsl";
+}
+
+void ChromaticAberrationEffect::ApplyStage(const Framebuffer::Sptr& gBuffer, PostProcessingLayer::FusedStage& stage)
+{
+	stage.SetUniform("Strength", _strength);
+}
+
 void ChromaticAberrationEffect::RenderImGui()
 {
 	LABEL_LEFT(ImGui::SliderFloat, "Strength", &_strength, -100, 100);
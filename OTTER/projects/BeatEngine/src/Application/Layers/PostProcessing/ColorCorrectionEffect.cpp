@@ -54,6 +54,32 @@ void ColorCorrectionEffect::Apply(const Framebuffer::Sptr& gBuffer)
 
 
 
+EffectFusion ColorCorrectionEffect::GetFusion() const
+{
+	return EffectFusion::PerPixel;
+}
+
+std::string ColorCorrectionEffect::GetStageSource() const
+{
+	return "shaders/fragment_shaders/post_effects/stages/color_correction.glsl";
+}
+
+void ColorCorrectionEffect::ApplyStage(const Framebuffer::Sptr& gBuffer, PostProcessingLayer::FusedStage& stage)
+{
+	// Same LUT selection as Apply, falling back to the first LUT so the sampler always has something bound
+	Texture3D::Sptr lut = Lut;
+	if (checked2 == true && checked1 == false && checked3 == false) {
+		lut = Lut2;
+	}
+	if (checked3 == true && checked1 == false && checked2 == false) {
+		lut = Lut3;
+	}
+	if (lut != nullptr) {
+		stage.BindTexture("Lut", lut);
+	}
+	stage.SetUniform("Strength", _strength);
+}
+
 void ColorCorrectionEffect::RenderImGui()
 {
 	// 1st lut
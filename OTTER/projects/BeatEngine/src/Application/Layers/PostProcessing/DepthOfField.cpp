@@ -7,7 +7,15 @@
 
 DepthOfField::DepthOfField() :
 	PostProcessingLayer::Effect(),
-	_shader(nullptr)
+	_shader(nullptr),
+	_gatherShader(nullptr),
+	_compositeShader(nullptr),
+	_blur(std::make_shared<BlurPasses>()),
+	_downsample(2),
+	_maxBlurRadius(20.0f),
+	_half(nullptr),
+	_quarter(nullptr),
+	_gathered(nullptr)
 {
 	Name = "Depth of Field";
 	_format = RenderTargetType::ColorRgb8;
@@ -16,14 +24,61 @@ DepthOfField::DepthOfField() :
 		{ ShaderPartType::Vertex, "shaders/vertex_shaders/fullscreen_quad.glsl" },
 		{ ShaderPartType::Fragment, "shaders/fragment_shaders/post_effects/depth_of_field.glsl" }
 	});
+	_gatherShader = ResourceManager::CreateAsset<ShaderProgram>(std::unordered_map<ShaderPartType, std::string>{
+		{ ShaderPartType::Vertex, "shaders/vertex_shaders/fullscreen_quad.glsl" },
+		{ ShaderPartType::Fragment, "shaders/fragment_shaders/post_effects/dof_gather.glsl" }
+	});
+	_compositeShader = ResourceManager::CreateAsset<ShaderProgram>(std::unordered_map<ShaderPartType, std::string>{
+		{ ShaderPartType::Vertex, "shaders/vertex_shaders/fullscreen_quad.glsl" },
+		{ ShaderPartType::Fragment, "shaders/fragment_shaders/post_effects/dof_composite.glsl" }
+	});
 }
 
 DepthOfField::~DepthOfField() = default;
 
 void DepthOfField::Apply(const Framebuffer::Sptr& gBuffer)
 {
-	_shader->Bind();
+	if (_downsample <= 0) {
+		_shader->Bind();
+		_shader->SetUniform("u_MaxBlurRadius", _maxBlurRadius);
+		gBuffer->BindAttachment(RenderTargetAttachment::Depth, 1);
+		return;
+	}
+
+	glm::ivec2 size = _output->GetSize();
+	float scale = 1.0f / (float)(1 << _downsample);
+
+	// Build the downsample chain, carrying the distance to the nearest surface in alpha for the gather and upsample
+	BlurPasses::PrepareTarget(_half, size / 2, RenderTargetType::ColorRgba16F);
+	_blur->Downsample(*this, _half, DownsampleAlpha::NearestDepth, gBuffer);
+	Framebuffer::Sptr gatherInput = _half;
+	if (_downsample > 1) {
+		BlurPasses::PrepareTarget(_quarter, size / 4, RenderTargetType::ColorRgba16F);
+		_half->BindAttachment(RenderTargetAttachment::Color0, 0);
+		_blur->Downsample(*this, _quarter, DownsampleAlpha::Min);
+		gatherInput = _quarter;
+	}
+
+	// Gather the bokeh at the lower resolution, which is where the savings come from. The distances stay in the
+	// gather's input, the output's alpha is used for how much blur spills over from nearer surfaces
+	BlurPasses::PrepareTarget(_gathered, gatherInput->GetSize(), RenderTargetType::ColorRgba16F);
+	_gathered->Bind();
+	glViewport(0, 0, _gathered->GetWidth(), _gathered->GetHeight());
+	gatherInput->BindAttachment(RenderTargetAttachment::Color0, 0);
+	_gatherShader->Bind();
+	_gatherShader->SetUniform("u_MaxBlurRadius", _maxBlurRadius);
+	_gatherShader->SetUniform("u_Scale", scale);
+	DrawFullscreen();
+
+	// Leave the composite bound, the layer will draw it into our output
+	_output->Bind();
+	glViewport(0, 0, _output->GetWidth(), _output->GetHeight());
+	_input->BindAttachment(RenderTargetAttachment::Color0, 0);
 	gBuffer->BindAttachment(RenderTargetAttachment::Depth, 1);
+	_gathered->BindAttachment(RenderTargetAttachment::Color0, 2);
+	gatherInput->BindAttachment(RenderTargetAttachment::Color0, 3);
+	_compositeShader->Bind();
+	_compositeShader->SetUniform("u_Scale", scale);
 }
 
 void DepthOfField::RenderImGui()
@@ -35,18 +90,27 @@ void DepthOfField::RenderImGui()
 		ImGui::DragFloat("Lens Dist. ", &cam->LensDepth,  0.01f, 0.001f, 50.0f);
 		ImGui::DragFloat("Aperture   ", &cam->Aperture,   0.1f, 0.1f, 60.0f);
 	}
+	ImGui::DragFloat("Max Radius ", &_maxBlurRadius, 0.5f, 1.0f, 128.0f);
+
+	static const char* resolutions[] = { "Full", "Half", "Quarter" };
+	ImGui::Combo("Resolution ", &_downsample, resolutions, 3);
 }
 
 DepthOfField::Sptr DepthOfField::FromJson(const nlohmann::json& data)
 {
 	DepthOfField::Sptr result = std::make_shared<DepthOfField>();
 	result->Enabled = JsonGet(data, "enabled", true);
+	// Settings saved before the downsampled path existed were tuned at full resolution, so they stay there
+	result->_downsample = JsonGet(data, "downsample", 0);
+	result->_maxBlurRadius = JsonGet(data, "max_blur_radius", result->_maxBlurRadius);
 	return result;
 }
 
 nlohmann::json DepthOfField::ToJson() const
 {
 	return {
-		{ "enabled", Enabled }
+		{ "enabled", Enabled },
+		{ "downsample", _downsample },
+		{ "max_blur_radius", _maxBlurRadius }
 	};
 }
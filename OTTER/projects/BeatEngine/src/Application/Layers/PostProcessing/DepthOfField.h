@@ -4,6 +4,7 @@
 #include "Graphics/ShaderProgram.h"
 #include "Graphics/Textures/Texture3D.h"
 #include "Graphics/Framebuffer.h"
+#include "BlurPasses.h"
 
 class DepthOfField : public PostProcessingLayer::Effect {
 public:
@@ -21,5 +22,18 @@ public:
 	virtual nlohmann::json ToJson() const override;
 
 protected:
+	// The full resolution shader, used when we aren't downsampling
 	ShaderProgram::Sptr _shader;
+	ShaderProgram::Sptr _gatherShader;
+	ShaderProgram::Sptr _compositeShader;
+	BlurPasses::Sptr    _blur;
+
+	// How many times the image is halved before gathering, 0 for full resolution, 1 for half and 2 for quarter
+	int   _downsample;
+	// The largest blur radius, in full resolution pixels
+	float _maxBlurRadius;
+
+	Framebuffer::Sptr _half;
+	Framebuffer::Sptr _quarter;
+	Framebuffer::Sptr _gathered;
 };
\ No newline at end of file
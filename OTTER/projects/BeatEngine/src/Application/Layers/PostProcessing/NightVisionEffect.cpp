@@ -30,6 +30,16 @@ void NightVisionEffect::Apply(const Framebuffer::Sptr& gBuffer)
 	_shader->Bind();
 }
 
+EffectFusion NightVisionEffect::GetFusion() const
+{
+	return EffectFusion::PerPixel;
+}
+
+std::string NightVisionEffect::GetStageSource() const
+{
+	return "shaders/fragment_shaders/post_effects/stages/night_vision.glsl";
+}
+
 void NightVisionEffect::RenderImGui()
 {
 }
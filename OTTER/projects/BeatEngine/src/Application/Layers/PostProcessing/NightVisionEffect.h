@@ -14,6 +14,9 @@ public:
 	virtual void Apply(const Framebuffer::Sptr& gBuffer) override;
 	virtual void RenderImGui() override;
 
+	virtual EffectFusion GetFusion() const override;
+	virtual std::string GetStageSource() const override;
+
 	// Inherited from IResource
 
 	NightVisionEffect::Sptr FromJson(const nlohmann::json& data);
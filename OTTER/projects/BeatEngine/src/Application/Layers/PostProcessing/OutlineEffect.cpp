@@ -38,6 +38,29 @@ void OutlineEffect::Apply(const Framebuffer::Sptr& gBuffer)
 	gBuffer->BindAttachment(RenderTargetAttachment::Color1, 2); // The normal buffer
 }
 
+EffectFusion OutlineEffect::GetFusion() const
+{
+	return EffectFusion::PerPixel;
+}
+
+std::string OutlineEffect::GetStageSource() const
+{
+	return "shaders/fragment_shaders/post_effects/stages/outline.glsl";
+}
+
+void OutlineEffect::ApplyStage(const Framebuffer::Sptr& gBuffer, PostProcessingLayer::FusedStage& stage)
+{
+	stage.SetUniform("OutlineColor", _outlineColor);
+	stage.SetUniform("Scale", _scale);
+	stage.SetUniform("DepthThreshold", _depthThreshold);
+	stage.SetUniform("NormalThreshold", _normalThreshold);
+	stage.SetUniform("DepthNormThreshold", _depthNormalThreshold);
+	stage.SetUniform("DepthNormThresholdScale", _depthNormalThresholdScale);
+	stage.SetUniform("PixelSize", glm::vec2(1.0f) / (glm::vec2)gBuffer->GetSize());
+	stage.BindAttachment("Depth", gBuffer, RenderTargetAttachment::Depth);
+	stage.BindAttachment("Normals", gBuffer, RenderTargetAttachment::Color1);
+}
+
 void OutlineEffect::RenderImGui()
 {
 	LABEL_LEFT(ImGui::ColorEdit4,   "Color", &_outlineColor.x);
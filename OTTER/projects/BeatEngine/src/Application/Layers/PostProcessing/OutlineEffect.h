@@ -13,6 +13,10 @@ public:
 	virtual void Apply(const Framebuffer::Sptr& gBuffer) override;
 	virtual void RenderImGui() override;
 
+	virtual EffectFusion GetFusion() const override;
+	virtual std::string GetStageSource() const override;
+	virtual void ApplyStage(const Framebuffer::Sptr& gBuffer, PostProcessingLayer::FusedStage& stage) override;
+
 	// Inherited from IResource
 
 	OutlineEffect::Sptr FromJson(const nlohmann::json& data);
@@ -31,6 +31,21 @@ void PixellationEffect::Apply(const Framebuffer::Sptr& gBuffer)
 	//gBuffer->BindAttachment(RenderTargetAttachment::Color1, 2); // The normal buffer
 }
 
+EffectFusion PixellationEffect::GetFusion() const
+{
+	return EffectFusion::Resample;
+}
+
+std::string PixellationEffect::GetStageSource() const
+{
+	return "shaders/fragment_shaders/post_effects/stages/pixellation.glsl";
+}
+
+void PixellationEffect::ApplyStage(const Framebuffer::Sptr& gBuffer, PostProcessingLayer::FusedStage& stage)
+{
+	stage.SetUniform("PixelNumber", _pixelSize);
+}
+
 void PixellationEffect::RenderImGui()
 {
 	LABEL_LEFT(ImGui::SliderFloat,  "Pixel Size", &_pixelSize, 512.f, 4000.f);
@@ -2,6 +2,8 @@
 
 #include "Application/Application.h"
 #include "RenderLayer.h"
+#include "Graphics/GpuProfiler.h"
+#include "Utils/FileHelpers.h"
 
 #include "PostProcessing/ColorCorrectionEffect.h"
 #include "PostProcessing/BoxFilter3x3.h"
@@ -50,18 +52,7 @@ void PostProcessingLayer::OnAppLoad(const nlohmann::json & config)
 	//GetEffect<ChromaticAberrationEffect>()->Enabled = false;
 	//GetEffect<ColorCorrectionEffect>()->Enabled = false;
 
-	Application& app = Application::Get();
-	const glm::uvec4& viewport = app.GetPrimaryViewport();
-
-	// Initialize all the effect's output FBOs (inefficient) 
-	for (const auto& effect : _effects) {
-		FramebufferDescriptor fboDesc = FramebufferDescriptor();
-		fboDesc.Width = viewport.z * effect->_outputScale.x;
-		fboDesc.Height = viewport.w * effect->_outputScale.y;
-		fboDesc.RenderTargets[RenderTargetAttachment::Color0] = RenderTargetDescriptor(effect->_format);
-
-		effect->_output = std::make_shared<Framebuffer>(fboDesc);
-	}
+	// Effect outputs are transient targets in the render graph, so they're created as they're needed
 
 	// We need a mesh for drawing fullscreen quads
 	glm::vec2 positions[6] = {
@@ -80,71 +71,134 @@ void PostProcessingLayer::OnAppLoad(const nlohmann::json & config)
 
 void PostProcessingLayer::OnPostRender()
 {
+	GPU_PASS("Post Processing");
+	_presentedOutput = nullptr;
+
 	Application& app = Application::Get();
 	const glm::uvec4& viewport = app.GetPrimaryViewport();
 
+	// There's nothing to present to when the game viewport is collapsed or the window is minimized
+	if (viewport.z == 0 || viewport.w == 0) {
+		return;
+	}
+
 	// Grab the render layer from the app, get it's output and the G-Buffer
 	const RenderLayer::Sptr& renderer = app.GetLayer<RenderLayer>();
 	const Framebuffer::Sptr& output = renderer->GetRenderOutput();
 	const Framebuffer::Sptr& gBuffer = renderer->GetGBuffer();
+	const RenderGraph::Sptr& graph = renderer->GetRenderGraph();
 
-	// Stores the input FBO to the effect, we start with the renderlayer's output 
-	Framebuffer::Sptr current = output;
+	RenderGraph::Target gBufferTarget = graph->Import("G-Buffer", gBuffer);
 
-	// Disable depth testing and depth writing, as well as blending
-	glDisable(GL_DEPTH_TEST);
-	glDepthMask(false);
-	glDisable(GL_BLEND);
+	// Stores the input to the next effect, we start with the renderlayer's output 
+	RenderGraph::Target current = graph->Import("Render Output", output);
 
-	// Bind the quad VAO so our effects can use it
-	_quadVAO->Bind();
+	// Group the enabled effects into passes, this only does any work when the set of enabled effects has changed
+	_FuseEffects();
+
+	// Each pass feeds into the next one. Passes with the same output size and format ping-pong between two
+	// framebuffers, rather than each having their own
+	for (const EffectPass& effectPass : _passes) {
+		const Effect::Sptr& first = effectPass.Effects.front();
+		const Effect::Sptr& last  = effectPass.Effects.back();
+		const std::string& name = effectPass.Fused != nullptr ? effectPass.Fused->Name : first->Name;
+
+		FramebufferDescriptor fboDesc = FramebufferDescriptor();
+		fboDesc.Width = viewport.z * first->_outputScale.x;
+		fboDesc.Height = viewport.w * first->_outputScale.y;
+		fboDesc.RenderTargets[RenderTargetAttachment::Color0] = RenderTargetDescriptor(last->_format);
+
+		RenderGraph::PassBuilder pass = graph->AddPass(name);
+		RenderGraph::Target input = pass.Read(current);
+		pass.Read(gBufferTarget);
+		RenderGraph::Target target = pass.Create(name, fboDesc);
+		pass.SetExecute([this, effectPass, input, target, gBuffer](const RenderGraph::PassContext& context) {
+			const Framebuffer::Sptr& passOutput = context.Get(target);
+			GPU_PASS(effectPass.Fused != nullptr ? effectPass.Fused->Name.c_str() : effectPass.Effects[0]->Name.c_str());
 
-	// Iterate over all the effects in the queue
-	for (const auto& effect : _effects) {
-		// Only render if it's enabled
-		if (effect->Enabled) {
 			// Bind the FBO and make sure we're rendering to the whole thing
-			effect->_output->Bind();
-			glViewport(0, 0, effect->_output->GetWidth(), effect->_output->GetHeight());
+			passOutput->Bind();
+			glViewport(0, 0, passOutput->GetWidth(), passOutput->GetHeight());
 
 			// Bind color 0 from previous pass to texture slot 0 so our effects can access
-			current->BindAttachment(RenderTargetAttachment::Color0, 0);
-
-			// Apply the effect and render the fullscreen quad
-			effect->Apply(gBuffer);
-			_quadVAO->Draw();
+			context.Get(input)->BindAttachment(RenderTargetAttachment::Color0, 0);
+
+			// Apply the effect (or all the stages of a fused pass) and render the fullscreen quad
+			bool needsDraw = true;
+			if (effectPass.Fused == nullptr) {
+				const Effect::Sptr& effect = effectPass.Effects[0];
+				effect->_output = passOutput;
+				effect->_input = context.Get(input);
+				effect->_outputWritten = false;
+				effect->Apply(gBuffer);
+				needsDraw = !effect->_outputWritten;
+			} else {
+				effectPass.Fused->Shader->Bind();
+				int nextSlot = 1;
+				for (size_t ix = 0; ix < effectPass.Effects.size(); ix++) {
+					FusedStage stage(effectPass.Fused->Shader, "s" + std::to_string(ix) + "_", nextSlot);
+					effectPass.Effects[ix]->_output = passOutput;
+					effectPass.Effects[ix]->ApplyStage(gBuffer, stage);
+				}
+			}
+			if (needsDraw) {
+				_quadVAO->Draw();
+			}
+
+			// Unbind output, the next pass will read from it
+			passOutput->Unbind();
+			for (const auto& effect : effectPass.Effects) {
+				effect->_output = nullptr;
+				effect->_input = nullptr;
+			}
+		});
 
-			// Unbind output and set it as input for next pass
-			effect->_output->Unbind();
-			current = effect->_output;
-		}
+		current = target;
 	}
-	_quadVAO->Unbind();
 
-	// Restore viewport to game viewport
-	glViewport(viewport.x, viewport.y, viewport.z, viewport.w);
-
-	// Bind the output of our post processing as the source for the blit
-	current->Bind(FramebufferBinding::Read);
-	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
-
-	// Blit the color buffer to our game window
-	current->Blit(
-		{ 0, 0, current->GetWidth(), current->GetHeight() },
-		{ viewport.x, viewport.y, viewport.x + viewport.z, viewport.y + viewport.w },
-		BufferFlags::Color,
-		MagFilter::Linear
-	);
+	RenderGraph::PassBuilder present = graph->AddPass("Present");
+	present.Read(current);
+	present.Read(gBufferTarget);
+	present.SetSideEffects();
+	present.SetExecute([this, viewport, current, gBuffer](const RenderGraph::PassContext& context) {
+		const Framebuffer::Sptr& result = context.Get(current);
+		_presentedOutput = result;
+
+		// Restore viewport to game viewport
+		glViewport(viewport.x, viewport.y, viewport.z, viewport.w);
+
+		// Bind the output of our post processing as the source for the blit
+		result->Bind(FramebufferBinding::Read);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+
+		// Blit the color buffer to our game window
+		result->Blit(
+			{ 0, 0, result->GetWidth(), result->GetHeight() },
+			{ viewport.x, viewport.y, viewport.x + viewport.z, viewport.y + viewport.w },
+			BufferFlags::Color,
+			MagFilter::Linear
+		);
+
+		gBuffer->Bind(FramebufferBinding::Read);
+		result->Blit(
+			{ 0, 0, gBuffer->GetWidth(), gBuffer->GetHeight() },
+			{ viewport.x, viewport.y, viewport.x + viewport.z, viewport.y + viewport.w },
+			BufferFlags::Depth,
+			MagFilter::Nearest
+		);
+
+		gBuffer->Unbind();
+	});
 
-	gBuffer->Bind(FramebufferBinding::Read);
-	current->Blit(
-		{ 0, 0, gBuffer->GetWidth(), gBuffer->GetHeight() },
-		{ viewport.x, viewport.y, viewport.x + viewport.z, viewport.y + viewport.w },
-		BufferFlags::Depth,
-		MagFilter::Nearest
-	);
+	// Disable depth testing and depth writing, as well as blending
+	glDisable(GL_DEPTH_TEST);
+	glDepthMask(false);
+	glDisable(GL_BLEND);
 
-	gBuffer->Unbind();
+	// Bind the quad VAO so our effects can use it
+	_quadVAO->Bind();
+	graph->Execute();
+	_quadVAO->Unbind();
 }
 
 void PostProcessingLayer::OnSceneLoad()
@@ -165,7 +219,6 @@ void PostProcessingLayer::OnWindowResize(const glm::ivec2 & oldSize, const glm::
 {
 	for (const auto& effect : _effects) {
 		effect->OnWindowResize(oldSize, newSize);
-		effect->_output->Resize(newSize.x, newSize.y);
 	}
 }
 
@@ -174,9 +227,151 @@ const std::vector<PostProcessingLayer::Effect::Sptr>& PostProcessingLayer::GetEf
 	return _effects;
 }
 
+const Framebuffer::Sptr& PostProcessingLayer::GetPresentedOutput() const
+{
+	return _presentedOutput;
+}
+
+void PostProcessingLayer::_FuseEffects()
+{
+	std::vector<Effect*> enabled;
+	for (const auto& effect : _effects) {
+		if (effect->Enabled) {
+			enabled.push_back(effect.get());
+		}
+	}
+	if (enabled == _fusedEffects) {
+		return;
+	}
+	_fusedEffects = enabled;
+
+	// Walk the enabled effects in order, adding each one to the last pass if it's allowed to join it. Effects that
+	// resample their input start a new pass, since they need the previous effects' result to be in a texture
+	std::vector<EffectPass> passes;
+	for (const auto& effect : _effects) {
+		if (!effect->Enabled) {
+			continue;
+		}
+
+		EffectFusion fusion = effect->GetFusion();
+		bool canJoin =
+			passes.size() > 0 &&
+			fusion == EffectFusion::PerPixel &&
+			passes.back().Effects.back()->GetFusion() != EffectFusion::None &&
+			passes.back().Effects.front()->_outputScale == effect->_outputScale;
+
+		if (canJoin) {
+			passes.back().Effects.push_back(effect);
+		} else {
+			passes.push_back(EffectPass());
+			passes.back().Effects.push_back(effect);
+		}
+	}
+
+	// Generate the shaders for any passes with more than one effect. If one fails to build, we fall back to
+	// running it's effects one at a time
+	_passes.clear();
+	for (EffectPass& pass : passes) {
+		if (pass.Effects.size() > 1) {
+			pass.Fused = _GetFusedShader(pass.Effects);
+			if (pass.Fused == nullptr) {
+				for (const auto& effect : pass.Effects) {
+					_passes.push_back(EffectPass());
+					_passes.back().Effects.push_back(effect);
+				}
+				continue;
+			}
+		}
+		_passes.push_back(pass);
+	}
+
+	LOG_INFO("Post processing: {} enabled effects in {} passes", enabled.size(), _passes.size());
+}
+
+const PostProcessingLayer::FusedShader* PostProcessingLayer::_GetFusedShader(const std::vector<Effect::Sptr>& effects)
+{
+	std::string key;
+	for (const auto& effect : effects) {
+		key += effect->GetStageSource() + ";";
+	}
+	auto it = _fusedShaders.find(key);
+	if (it != _fusedShaders.end()) {
+		return it->second.Shader != nullptr ? &it->second : nullptr;
+	}
+
+	// Paste each stage in after the header, giving it's identifiers a prefix that's unique to the stage
+	std::string source = FileHelpers::ReadResolveIncludes("shaders/fragment_shaders/post_effects/stages/fused_header.glsl");
+	std::string mainSource = "\nvoid main() {\n    vec4 color = texture(s_Image, inUV);\n";
+	std::string name;
+	for (size_t ix = 0; ix < effects.size(); ix++) {
+		const Effect::Sptr& effect = effects[ix];
+		std::string prefix = "s" + std::to_string(ix) + "_";
+		std::string stage = FileHelpers::ReadResolveIncludes(effect->GetStageSource());
+		for (size_t seek = stage.find("STAGE_"); seek != std::string::npos; seek = stage.find("STAGE_", seek)) {
+			stage.replace(seek, 6, prefix);
+		}
+		source += "\n// " + effect->Name + "\n" + stage + "\n";
+
+		mainSource += "    color = " + prefix + "Apply(inUV, inViewDir, color);\n";
+
+		// The effects were written to run on their own, so between stages we clamp to what they would have seen
+		// coming out of their own render target
+		if (ix + 1 < effects.size()) {
+			if (effect->_format == RenderTargetType::ColorRgb8) {
+				mainSource += "    color = vec4(clamp(color.rgb, 0, 1), 1);\n";
+			} else if (effect->_format == RenderTargetType::ColorRgba8) {
+				mainSource += "    color = clamp(color, 0, 1);\n";
+			}
+		}
+
+		name += (ix > 0 ? " + " : "") + effect->Name;
+	}
+	source += mainSource + "    outColor = color;\n}\n";
+
+	FusedShader& result = _fusedShaders[key];
+	result.Name = name;
+
+	ShaderProgram::Sptr shader = std::make_shared<ShaderProgram>();
+	bool success =
+		shader->LoadShaderPartFromFile("shaders/vertex_shaders/fullscreen_quad.glsl", ShaderPartType::Vertex) &&
+		shader->LoadShaderPart(source.c_str(), ShaderPartType::Fragment) &&
+		shader->Link();
+	if (!success) {
+		LOG_WARN("Failed to fuse post processing effects \"{}\", they will run as separate passes", name);
+		return nullptr;
+	}
+	shader->SetDebugName("Fused: " + name);
+	result.Shader = shader;
+	return &result;
+}
+
+PostProcessingLayer::FusedStage::FusedStage(const ShaderProgram::Sptr& shader, const std::string& prefix, int& nextSlot) :
+	_shader(shader),
+	_prefix(prefix),
+	_nextSlot(nextSlot)
+{ }
+
+void PostProcessingLayer::FusedStage::BindTexture(const std::string& name, const ITexture::Sptr& texture)
+{
+	texture->Bind(_AllocateSlot(name));
+}
+
+void PostProcessingLayer::FusedStage::BindAttachment(const std::string& name, const Framebuffer::Sptr& buffer, RenderTargetAttachment attachment)
+{
+	buffer->BindAttachment(attachment, _AllocateSlot(name));
+}
+
+int PostProcessingLayer::FusedStage::_AllocateSlot(const std::string& name)
+{
+	int slot = _nextSlot++;
+	_shader->SetUniform(_prefix + name, slot);
+	return slot;
+}
+
 void PostProcessingLayer::Effect::DrawFullscreen()
 {
 	glDrawArrays(GL_TRIANGLES, 0, 6);
+	GpuProfiler::CountDraw(DrawMode::TriangleList, 6);
 }
 
 /*
@@ -1,8 +1,26 @@
 #pragma once
 
+#include <unordered_map>
+#include <EnumToString.h>
+
 #include "Application/ApplicationLayer.h"
 #include "Utils/Macros.h"
 #include "Graphics/VertexArrayObject.h"
+#include "Graphics/ShaderProgram.h"
+#include "Graphics/Textures/ITexture.h"
+
+/**
+ * Describes how a post processing effect can be merged with the effects next to it into a single
+ * fullscreen pass
+ */
+ENUM(EffectFusion, int,
+	// The effect needs it's own pass (ex: blurs, which sample a wide area of the previous pass)
+	None     = 0,
+	// The effect only reads the previous pass at the pixel it's shading, so it can go anywhere in a fused pass
+	PerPixel = 1,
+	// The effect reads the previous pass at other pixels (ex: pixellation), so it has to be the first stage
+	Resample = 2
+);
 
 /**
  * The post processing layer will handle rendering effects after the primary
@@ -12,6 +30,41 @@ class PostProcessingLayer final : public ApplicationLayer {
 public:
 	MAKE_PTRS(PostProcessingLayer);
 
+	/**
+	 * Handed to effects when they're applied as one stage of a fused pass. Uniform names get the stage's
+	 * prefix added to them, and textures are given slots that won't collide with the other stages
+	 */
+	class FusedStage {
+	public:
+		template <typename T>
+		void SetUniform(const std::string& name, const T& value) {
+			_shader->SetUniform(_prefix + name, value);
+		}
+		template <typename T>
+		void SetUniform(const std::string& name, const T* values, int count) {
+			_shader->SetUniform(_prefix + name, values, count);
+		}
+		/**
+		 * Binds a texture to the next free slot, and points the stage's sampler with the given name at it
+		 */
+		void BindTexture(const std::string& name, const ITexture::Sptr& texture);
+		/**
+		 * Binds a framebuffer attachment (ex: from the G-Buffer) to the next free slot, and points the stage's
+		 * sampler with the given name at it
+		 */
+		void BindAttachment(const std::string& name, const Framebuffer::Sptr& buffer, RenderTargetAttachment attachment);
+
+	protected:
+		friend class PostProcessingLayer;
+		FusedStage(const ShaderProgram::Sptr& shader, const std::string& prefix, int& nextSlot);
+
+		const ShaderProgram::Sptr& _shader;
+		std::string _prefix;
+		int&        _nextSlot;
+
+		int _AllocateSlot(const std::string& name);
+	};
+
 	/**
 	 * Base class for post processing effects, we extend this to create new effects
 	 */
@@ -29,10 +82,30 @@ public:
 
 		/**
 		 * Overload this in derived classes to apply the effect. Texture slot 0
-		 * will contain the image from the previous pass
+		 * will contain the image from the previous pass, and the layer will draw a
+		 * fullscreen quad into the effect's output once this returns. Effects may
+		 * render their own passes first, as long as they bind the output again
 		 * @param gBuffer The G-Buffer from the deferred rendering pipeline
 		 */
 		virtual void Apply(const Framebuffer::Sptr& gBuffer) = 0;
+		/**
+		 * Overload this in derived classes that can be fused with other effects into a single pass.
+		 * Effects that sample a wide area of the previous pass should leave this as None
+		 */
+		virtual EffectFusion GetFusion() const { return EffectFusion::None; }
+		/**
+		 * Gets the path of the GLSL snippet that implements this effect as a fused stage. The snippet
+		 * defines vec4 STAGE_Apply(vec2 uv, vec3 viewDir, vec4 color), and prefixes anything else it
+		 * declares with STAGE_ so that several stages can share a shader
+		 */
+		virtual std::string GetStageSource() const { return ""; }
+		/**
+		 * Overload this in derived classes to set the effect's uniforms and textures when it's applied
+		 * as a stage of a fused pass. The fused shader is already bound
+		 * @param gBuffer The G-Buffer from the deferred rendering pipeline
+		 * @param stage Sets uniforms and textures for this effect's stage
+		 */
+		virtual void ApplyStage(const Framebuffer::Sptr& gBuffer, FusedStage& stage) {}
 		/**
 		 * Allows this effect to perform logic when a new scene is loaded
 		 */
@@ -43,7 +116,7 @@ public:
 		virtual void OnSceneUnload() {}
 		/**
 		 * Allows this effect to perform additional logic when the window is resized
-		 * Note that the output framebuffer will already be resized by the post processing layer
+		 * Note that the output framebuffer is sized from the viewport each frame, so it doesn't need resizing
 		 */
 		virtual void OnWindowResize(const glm::ivec2& oldSize, const glm::ivec2& newSize) {}
 		/**
@@ -61,8 +134,15 @@ public:
 	protected:
 		friend class PostProcessingLayer;
 
-		// The output that this effect will render into
+		// The output that this effect is rendering into, handed out by the render graph each frame. Effects with
+		// the same scale and format share framebuffers, so this is only valid while the effect is being applied
 		Framebuffer::Sptr _output = nullptr;
+		// The output of the previous pass, also bound to texture slot 0. Only valid while the effect is being applied,
+		// for effects that render several passes of their own and need to get back to it
+		Framebuffer::Sptr _input = nullptr;
+		// Effects that write their output on their own in Apply (ex: from a compute shader) set this so that the
+		// layer doesn't draw over it. Reset before every Apply
+		bool _outputWritten = false;
 		// The scaling between this effect's output and the screen size, default 1
 		glm::vec2 _outputScale = glm::vec2(1);
 		// The render target format for the effect's buffer
@@ -99,6 +179,12 @@ public:
 	 */
 	void AddEffect(const Effect::Sptr& effect);
 
+	/**
+	 * Gets the framebuffer that was blitted to the window by the last frame's present pass. This is
+	 * only valid until the next frame's post processing runs, since it may be a pooled render target
+	 */
+	const Framebuffer::Sptr& GetPresentedOutput() const;
+
 	// Inherited from ApplicationLayer
 
 	virtual void OnAppLoad(const nlohmann::json& config) override;
@@ -110,6 +196,32 @@ public:
 protected:
 	friend class Effect;
 
+	// A shader generated from the stages of several effects
+	struct FusedShader {
+		ShaderProgram::Sptr Shader;
+		// Kept alongside the shader so that the GPU profiler has a name that outlives the pass
+		std::string         Name;
+	};
+
+	// A single fullscreen pass, applying one or more effects
+	struct EffectPass {
+		std::vector<Effect::Sptr> Effects;
+		// The shader that applies all the effects, null when the pass only has one effect
+		const FusedShader*        Fused = nullptr;
+	};
+
 	std::vector<Effect::Sptr> _effects;
 	VertexArrayObject::Sptr _quadVAO;
+
+	// The passes that the enabled effects are currently grouped into
+	std::vector<EffectPass> _passes;
+	// The enabled effects that the passes were built from, so we know when we need to fuse again
+	std::vector<Effect*> _fusedEffects;
+	// Shaders we've generated, keyed on the stage sources they were built from so toggling effects doesn't re-compile
+	std::unordered_map<std::string, FusedShader> _fusedShaders;
+	// The image that the last present pass showed, so it can be read back without touching the window
+	Framebuffer::Sptr _presentedOutput;
+
+	void _FuseEffects();
+	const FusedShader* _GetFusedShader(const std::vector<Effect::Sptr>& effects);
 };
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Graphics/GuiBatcher.h"
 #include "Gameplay/Components/Camera.h"
 #include "Graphics/DebugDraw.h"
+#include "Graphics/GpuProfiler.h"
 #include "Graphics/Textures/TextureCube.h"
 #include "../Timing.h"
 #include "Gameplay/Components/ComponentManager.h"
@@ -21,11 +22,15 @@
 RenderLayer::RenderLayer() :
 	ApplicationLayer(),
 	_primaryFBO(nullptr),
+	_gBufferValidation(nullptr),
 	_blitFbo(true),
 	_frameUniforms(nullptr),
 	_instanceUniforms(nullptr),
 	_renderFlags(RenderFlags::None),
-	_clearColor({ 0.1f, 0.1f, 0.1f, 1.0f })
+	_clearColor({ 0.1f, 0.1f, 0.1f, 1.0f }),
+	_validateGBuffer(false),
+	_gBufferHasReference(false),
+	_validationTolerances({ 2.0f, 0.001f })
 {
 	Name = "Rendering";
 	Overrides =
@@ -39,20 +44,30 @@ RenderLayer::~RenderLayer() = default;
 void RenderLayer::OnPreRender()
 {
 	using namespace Gameplay;
+	GPU_PASS("Frame Setup");
 
 	Application& app = Application::Get();
 
-	// Clear the color and depth buffers
-	const glm::vec4 colors[4] = {
+	// Transient targets that went unused last frame are released here
+	_renderGraph->BeginFrame();
+
+	// Add or remove the reference targets if validation was toggled during the last frame
+	if (_validateGBuffer != _gBufferHasReference) {
+		_CreateGBuffer(_primaryFBO->GetSize());
+	}
+
+	// Clear the color and depth buffers, a normal target of all zeros marks pixels without a surface
+	const glm::vec4 colors[5] = {
+		glm::vec4(0.0f),
+		glm::vec4(0.0f),
 		glm::vec4(0.0f),
-		glm::vec4(0.5f, 0.5f, 0.5f, 0.0f),
 		glm::vec4(0.0f),
 		glm::vec4(0.0f)
 	};
 
 	_primaryFBO->Bind();
 	// Clear the framebuffer. Note that this also binds and sets the viewport
-	_ClearFramebuffer(_primaryFBO, colors, 4);
+	_ClearFramebuffer(_primaryFBO, colors, _gBufferHasReference ? 5 : 3);
 
 	// Grab shorthands to the camera and shader from the scene
 	Camera::Sptr camera = app.CurrentScene()->MainCamera;
@@ -92,6 +107,7 @@ void RenderLayer::OnPreRender()
 void RenderLayer::OnRender(const Framebuffer::Sptr& prevLayer)
 {
 	using namespace Gameplay;
+	GPU_PASS("G-Buffer");
 
 	Application& app = Application::Get();
 
@@ -121,8 +137,18 @@ void RenderLayer::OnPostRender() {
 	// Unbind our G-Buffer
 	_primaryFBO->Unbind();
 
-	// Composite our lighting 
-	_Composite();
+	// Lighting is scheduled through the render graph, so the lighting buffer and shadow maps only take up
+	// memory while they're in use, and can share it with the post processing targets
+	RenderGraph::Target gBuffer  = _renderGraph->Import("G-Buffer", _primaryFBO);
+	RenderGraph::Target output   = _renderGraph->Import("Render Output", _outputBuffer);
+	RenderGraph::Target lighting = _AddLightingPasses(gBuffer);
+	_AddCompositePass(gBuffer, lighting, output);
+	if (_gBufferHasReference) {
+		_AddValidationPass(gBuffer);
+	}
+	_renderGraph->Execute();
+
+	GPU_PASS("Output Blit");
 
 	Application& app = Application::Get();
 	const glm::uvec4& viewport = app.GetPrimaryViewport();
@@ -152,200 +178,276 @@ void RenderLayer::OnPostRender() {
 	_outputBuffer->Unbind();
 }
 
-void RenderLayer::_AccumulateLighting()
+RenderGraph::Target RenderLayer::_AddLightingPasses(RenderGraph::Target gBuffer)
 {
 	using namespace Gameplay;
 
 	Application& app = Application::Get();
 	Scene::Sptr& scene = app.CurrentScene();
 
-	Camera::Sptr camera = app.CurrentScene()->MainCamera;
-	const glm::mat4& view = camera->GetView();
-
-	// Update our lighting UBO for any shaders that need it
-	LightingUboStruct& data = _lightingUbo->GetData();
-	data.AmbientCol = scene->GetAmbientLight();
-	data.EnvironmentRotation = scene->GetSkyboxRotation() * glm::inverse(glm::mat3(scene->MainCamera->GetView()));
-
-	const glm::vec3& ambient = scene->GetAmbientLight();
-	const glm::vec4 colors[2] = {
-		{ ambient, 1.0f },         // diffuse (multiplicative)
-		{ 0.0f, 0.0f, 0.0f, 1.0f } // specular (additive)
-	};
-	_lightingFBO->Bind();
-	_ClearFramebuffer(_lightingFBO, colors, 2);
-
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-
-	// Bind our shader for processing lighting 
-	_lightAccumulationShader->Bind();
-
-	// Bind our G-Buffer textures so that they're readable
-	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Depth)->Bind(0);  // depth
-	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color0)->Bind(1); // albedo + spec
-	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color1)->Bind(2); // normals + metallic
-	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color2)->Bind(3); // emissive
-	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color3)->Bind(4); // view pos
-
-
-	// Send in how many active lights we have and the global lighting settings
-	data.AmbientCol = glm::vec3(0.1f);
-	int ix = 0;
-	app.CurrentScene()->Components().Each<Light>([&](const Light::Sptr& light) {
-		// Get the light's position in view space, since we're doing view space lighting
-		glm::vec4 pos = glm::vec4(light->GetGameObject()->GetWorldPosition(), 1.0f);
-		pos = view * pos;
-
-		// Copy to the ubo data
-		data.Lights[ix].Position = (glm::vec3)(pos) / pos.w;
-		data.Lights[ix].Intensity = light->GetIntensity();
-		data.Lights[ix].Color = light->GetColor();
-		data.Lights[ix].Attenuation = 1.0f / (1.0f + light->GetRadius());
-
-		ix++;
+	FramebufferDescriptor lightingDesc;
+	lightingDesc.Width  = _primaryFBO->GetWidth();
+	lightingDesc.Height = _primaryFBO->GetHeight();
+	lightingDesc.RenderTargets[RenderTargetAttachment::Color0] = RenderTargetDescriptor(RenderTargetType::ColorRgba8); // Diffuse
+	lightingDesc.RenderTargets[RenderTargetAttachment::Color1] = RenderTargetDescriptor(RenderTargetType::ColorRgba8); // Specular
+
+	RenderGraph::PassBuilder lightingPass = _renderGraph->AddPass("Lighting");
+	lightingPass.Read(gBuffer);
+	RenderGraph::Target lighting = lightingPass.Create("Lighting", lightingDesc);
+	lightingPass.SetExecute([this, lighting](const RenderGraph::PassContext& context) {
+		GPU_PASS("Lighting");
+
+		Application& app = Application::Get();
+		Scene::Sptr& scene = app.CurrentScene();
+
+		Camera::Sptr camera = scene->MainCamera;
+		const glm::mat4& view = camera->GetView();
+
+		// Update our lighting UBO for any shaders that need it
+		LightingUboStruct& data = _lightingUbo->GetData();
+		data.AmbientCol = scene->GetAmbientLight();
+		data.EnvironmentRotation = scene->GetSkyboxRotation() * glm::inverse(glm::mat3(scene->MainCamera->GetView()));
+
+		const glm::vec3& ambient = scene->GetAmbientLight();
+		const glm::vec4 colors[2] = {
+			{ ambient, 1.0f },         // diffuse (multiplicative)
+			{ 0.0f, 0.0f, 0.0f, 1.0f } // specular (additive)
+		};
+		_lightingFBO = context.Get(lighting);
+		_lightingFBO->Bind();
+		_ClearFramebuffer(_lightingFBO, colors, 2);
+
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+
+		// Bind our shader for processing lighting 
+		_lightAccumulationShader->Bind();
+
+		// Bind our G-Buffer textures so that they're readable
+		_BindGBuffer();
+
+		// Send in how many active lights we have and the global lighting settings
+		data.AmbientCol = glm::vec3(0.1f);
+		int ix = 0;
+		scene->Components().Each<Light>([&](const Light::Sptr& light) {
+			// Get the light's position in view space, since we're doing view space lighting
+			glm::vec4 pos = glm::vec4(light->GetGameObject()->GetWorldPosition(), 1.0f);
+			pos = view * pos;
+
+			// Copy to the ubo data
+			data.Lights[ix].Position = (glm::vec3)(pos) / pos.w;
+			data.Lights[ix].Intensity = light->GetIntensity();
+			data.Lights[ix].Color = light->GetColor();
+			data.Lights[ix].Attenuation = 1.0f / (1.0f + light->GetRadius());
+
+			ix++;
+
+			// If we've reached the max # of lights the shader supports, draw to the screen and start the next batch
+			if (ix == MAX_LIGHTS) {
+				data.NumLights = MAX_LIGHTS;
+
+				// Send updated data to OpenGL
+				_lightingUbo->Update();
+
+				// Draw the fullscreen quad to accumulate the lights
+				_fullscreenQuad->Draw();
+
+				ix = 0;
+			}
+		});
 
-		// If we've reached the max # of lights the shader supports, draw to the screen and start the next batch
-		if (ix == MAX_LIGHTS) {
-			data.NumLights = MAX_LIGHTS;
+		// If we have lights left over that haven't been drawn, draw them now
+		if (ix > 0) {
+			data.NumLights = ix;
 
 			// Send updated data to OpenGL
 			_lightingUbo->Update();
 
 			// Draw the fullscreen quad to accumulate the lights
 			_fullscreenQuad->Draw();
-
-			ix = 0;
 		}
 	});
 
-	// If we have lights left over that haven't been drawn, draw them now
-	if (ix > 0) {
-		data.NumLights = ix;
+	// Each shadow map is composited into the lighting right after it's rendered, rather than rendering all of
+	// them up front, so that lights with the same resolution can share a single depth buffer
+	scene->Components().Each<ShadowCamera>([&](const ShadowCamera::Sptr& shadowCam) {
+		FramebufferDescriptor shadowDesc;
+		shadowDesc.Width  = shadowCam->GetBufferResolution().x;
+		shadowDesc.Height = shadowCam->GetBufferResolution().y;
+		shadowDesc.RenderTargets[RenderTargetAttachment::Depth] = RenderTargetDescriptor(RenderTargetType::Depth32);
 
-		// Send updated data to OpenGL
-		_lightingUbo->Update();
+		RenderGraph::PassBuilder shadowPass = _renderGraph->AddPass("Shadow Map");
+		RenderGraph::Target shadowMap = shadowPass.Create("Shadow Map", shadowDesc);
+		shadowPass.SetExecute([this, shadowCam, shadowMap](const RenderGraph::PassContext& context) {
+			GPU_PASS("Shadow Map");
 
-		// Draw the fullscreen quad to accumulate the lights
-		_fullscreenQuad->Draw();
-	}
+			// Bind the shadow camera's depth buffer and clear it
+			shadowCam->_depthBuffer = context.Get(shadowMap);
+			shadowCam->_depthBuffer->Bind();
+			glClear(GL_DEPTH_BUFFER_BIT);
+			glViewport(0, 0, shadowCam->GetBufferResolution().x, shadowCam->GetBufferResolution().y);
 
-	// Re-render the scene for shadows
-	app.CurrentScene()->Components().Each<ShadowCamera>([&](const ShadowCamera::Sptr& shadowCam) {
-		// Bind the shadow camera's depth buffer and clear it
-		shadowCam->GetDepthBuffer()->Bind();
-		glClear(GL_DEPTH_BUFFER_BIT);
-		glViewport(0, 0, shadowCam->GetBufferResolution().x, shadowCam->GetBufferResolution().y);
+			_RenderScene(shadowCam->GetGameObject()->GetInverseTransform(), shadowCam->GetProjection(), shadowCam->_depthBuffer->GetSize());
 
-		_RenderScene(shadowCam->GetGameObject()->GetInverseTransform(), shadowCam->GetProjection(), shadowCam->GetDepthBuffer()->GetSize());
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		});
 
-		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
-	});
+		RenderGraph::PassBuilder compositePass = _renderGraph->AddPass("Shadow Composite");
+		compositePass.Read(gBuffer);
+		compositePass.Read(shadowMap);
+		compositePass.Write(lighting);
+		compositePass.SetExecute([this, shadowCam, shadowMap, lighting](const RenderGraph::PassContext& context) {
+			GPU_PASS("Shadow Composite");
 
-	// Restore frame level uniforms
-	_InitFrameUniforms();
+			// Restore frame level uniforms
+			_InitFrameUniforms();
 
-	_lightingFBO->Bind();
-	glViewport(0, 0, _lightingFBO->GetWidth(), _lightingFBO->GetHeight());
+			const Framebuffer::Sptr& lightingFBO = context.Get(lighting);
+			lightingFBO->Bind();
+			glViewport(0, 0, lightingFBO->GetWidth(), lightingFBO->GetHeight());
 
-	// Bind our G-Buffer textures so that they're readable
-	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Depth)->Bind(0);  // depth
-	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color0)->Bind(1); // albedo + spec
-	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color1)->Bind(2); // normals + metallic
-	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color2)->Bind(3); // emissive
-	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color3)->Bind(4); // view pos
+			// Bind our G-Buffer textures so that they're readable
+			_BindGBuffer();
 
-	// Bind shadow composite shader
-	_shadowShader->Bind();
+			// Bind shadow composite shader
+			_shadowShader->Bind();
 
-	// Add each shadow casting light to the lighting buffers
-	app.CurrentScene()->Components().Each<ShadowCamera>([&](const ShadowCamera::Sptr& shadowCam) {
+			Camera::Sptr camera = Application::Get().CurrentScene()->MainCamera;
 
-		// This gets us the light -> view space matrix, which we'll inverse to go from view space to light space
-		glm::mat4 lightSpaceMatrix = camera->GetView() * shadowCam->GetGameObject()->GetTransform();
+			// This gets us the light -> view space matrix, which we'll inverse to go from view space to light space
+			glm::mat4 lightSpaceMatrix = camera->GetView() * shadowCam->GetGameObject()->GetTransform();
 
-		// Or we have a matrix to go from view space to shadow space
-		glm::mat4 viewToShadow = shadowCam->GetProjection() * glm::inverse(lightSpaceMatrix);
+			// Or we have a matrix to go from view space to shadow space
+			glm::mat4 viewToShadow = shadowCam->GetProjection() * glm::inverse(lightSpaceMatrix);
 
-		// Calculate light's position and direction in view space
-		glm::vec3 lightDirViewSpace = glm::mat3(lightSpaceMatrix) * glm::vec3(0, 0, -1.0f);
-		glm::vec3 lightPosViewSpace = lightSpaceMatrix * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+			// Calculate light's position and direction in view space
+			glm::vec3 lightDirViewSpace = glm::mat3(lightSpaceMatrix) * glm::vec3(0, 0, -1.0f);
+			glm::vec3 lightPosViewSpace = lightSpaceMatrix * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
 
-		// Bind depth and projection mask for reading, making sure not to stomp G-Buffer bindings
-		shadowCam->GetDepthBuffer()->BindAttachment(RenderTargetAttachment::Depth, 5);
-		if (shadowCam->GetProjectionMask() != nullptr) {
-			shadowCam->GetProjectionMask()->Bind(6);
-		}
+			// Bind depth and projection mask for reading, making sure not to stomp G-Buffer bindings
+			context.Get(shadowMap)->BindAttachment(RenderTargetAttachment::Depth, 5);
+			if (shadowCam->GetProjectionMask() != nullptr) {
+				shadowCam->GetProjectionMask()->Bind(6);
+			}
 
-		//_shadowShader->SetUniformMatrix("u_ClipToShadow", clipToShadow); 
-		_shadowShader->SetUniformMatrix("u_ViewToShadow", viewToShadow);
+			//_shadowShader->SetUniformMatrix("u_ClipToShadow", clipToShadow); 
+			_shadowShader->SetUniformMatrix("u_ViewToShadow", viewToShadow);
 
-		// Get color and normalize it (strip the alpha)
-		glm::vec4 color = shadowCam->GetColor();
-		color *= color.w;
+			// Get color and normalize it (strip the alpha)
+			glm::vec4 color = shadowCam->GetColor();
+			color *= color.w;
 
-		_shadowShader->SetUniform("u_LightDirViewspace", lightDirViewSpace);
-		_shadowShader->SetUniform("u_ShadowBias", shadowCam->Bias);
-		_shadowShader->SetUniform("u_NormalBias", shadowCam->NormalBias);
-		_shadowShader->SetUniform("u_Attenuation", 1 / shadowCam->Range);
-		_shadowShader->SetUniform("u_Intensity", shadowCam->Intensity);
-		_shadowShader->SetUniform("u_LightColor", (glm::vec3)color);
-		_shadowShader->SetUniform("u_LightPosViewspace", lightPosViewSpace);
-		_shadowShader->SetUniform("u_ShadowFlags", *shadowCam->Flags);
+			_shadowShader->SetUniform("u_LightDirViewspace", lightDirViewSpace);
+			_shadowShader->SetUniform("u_ShadowBias", shadowCam->Bias);
+			_shadowShader->SetUniform("u_NormalBias", shadowCam->NormalBias);
+			_shadowShader->SetUniform("u_Attenuation", 1 / shadowCam->Range);
+			_shadowShader->SetUniform("u_Intensity", shadowCam->Intensity);
+			_shadowShader->SetUniform("u_LightColor", (glm::vec3)color);
+			_shadowShader->SetUniform("u_LightPosViewspace", lightPosViewSpace);
+			_shadowShader->SetUniform("u_ShadowFlags", *shadowCam->Flags);
 
-		// Draw the fullscreen quad to accumulate the lights
-		_fullscreenQuad->Draw();
+			// Draw the fullscreen quad to accumulate the lights
+			_fullscreenQuad->Draw();
+
+			// Unbind the lighting FBO so we can read its textures
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		});
 	});
 
-	// Unbind the lighting FBO so we can read its textures
-	_lightingFBO->Unbind();
+	return lighting;
 }
 
-void RenderLayer::_Composite()
+void RenderLayer::_AddCompositePass(RenderGraph::Target gBuffer, RenderGraph::Target lighting, RenderGraph::Target output)
 {
-	using namespace Gameplay;
-	Application& app = Application::Get();
+	RenderGraph::PassBuilder pass = _renderGraph->AddPass("Composite");
+	pass.Read(gBuffer);
+	pass.Read(lighting);
+	pass.Write(output);
+	pass.SetExecute([this, lighting](const RenderGraph::PassContext& context) {
+		GPU_PASS("Composite");
 
-	Scene::Sptr& scene = app.CurrentScene();
+		const Framebuffer::Sptr& lightingFBO = context.Get(lighting);
 
-	_AccumulateLighting();
+		// We want to switch to our compositing shader
+		_compositingShader->Bind();
 
-	// We want to switch to our compositing shader
-	_compositingShader->Bind();
+		// Switch rendering to output
+		_outputBuffer->Bind();
+		glViewport(0, 0, _outputBuffer->GetWidth(), _outputBuffer->GetHeight());
 
-	// Switch rendering to output
-	_outputBuffer->Bind();
-	glViewport(0, 0, _outputBuffer->GetWidth(), _outputBuffer->GetHeight());
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		// Disable blending, we want to override any existing colors
+		glDisable(GL_BLEND);
 
-	// Disable blending, we want to override any existing colors
-	glDisable(GL_BLEND);
+		// Bind our albedo and lighting buffers so we can composite a final scene
+		_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color0)->Bind(0);
+		_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color1)->Bind(1);
+		lightingFBO->GetTextureAttachment(RenderTargetAttachment::Color0)->Bind(2);
+		lightingFBO->GetTextureAttachment(RenderTargetAttachment::Color1)->Bind(3);
+		_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color2)->Bind(4);
+		_fullscreenQuad->Draw();
 
-	// Bind our albedo and lighting buffers so we can composite a final scene
-	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color0)->Bind(0);
-	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color1)->Bind(1);
-	_lightingFBO->GetTextureAttachment(RenderTargetAttachment::Color0)->Bind(2);
-	_lightingFBO->GetTextureAttachment(RenderTargetAttachment::Color1)->Bind(3);
-	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color2)->Bind(4);
-	_fullscreenQuad->Draw();
+		// Re-enable depth testing
+		glEnable(GL_DEPTH_TEST);
 
-	// Re-enable depth testing
-	glEnable(GL_DEPTH_TEST);
+		// Blit our depth from primary FBO to our output depth buffer
+		glBlitNamedFramebuffer(
+			_primaryFBO->GetHandle(), _outputBuffer->GetHandle(),
+			0, 0, _primaryFBO->GetWidth(), _primaryFBO->GetHeight(),
+			0, 0, _outputBuffer->GetWidth(), _outputBuffer->GetHeight(),
+			GL_DEPTH_BUFFER_BIT,
+			GL_NEAREST
+		);
 
-	// Blit our depth from primary FBO to our output depth buffer
-	glBlitNamedFramebuffer(
-		_primaryFBO->GetHandle(), _outputBuffer->GetHandle(),
-		0, 0, _primaryFBO->GetWidth(), _primaryFBO->GetHeight(),
-		0, 0, _outputBuffer->GetWidth(), _outputBuffer->GetHeight(),
-		GL_DEPTH_BUFFER_BIT,
-		GL_NEAREST
-	);
+		// Use our cubemap to draw our skybox
+		//scene->DrawSkybox();
 
-	// Use our cubemap to draw our skybox
-	//scene->DrawSkybox();
+		_outputBuffer->Unbind();
+	});
+}
 
-	_outputBuffer->Unbind();
+void RenderLayer::_AddValidationPass(RenderGraph::Target gBuffer)
+{
+	// The output is kept outside of the graph, since the post processing targets would alias it before the
+	// debug view gets to draw it
+	if (_gBufferValidation == nullptr) {
+		FramebufferDescriptor validationDesc;
+		validationDesc.Width  = _primaryFBO->GetWidth();
+		validationDesc.Height = _primaryFBO->GetHeight();
+		validationDesc.RenderTargets[RenderTargetAttachment::Color0] = RenderTargetDescriptor(RenderTargetType::ColorRgba8);
+		_gBufferValidation = std::make_shared<Framebuffer>(validationDesc);
+	}
+
+	RenderGraph::PassBuilder pass = _renderGraph->AddPass("G-Buffer Validation");
+	pass.Read(gBuffer);
+	pass.Write(_renderGraph->Import("G-Buffer Validation", _gBufferValidation));
+	pass.SetExecute([this](const RenderGraph::PassContext& context) {
+		GPU_PASS("G-Buffer Validation");
+
+		_gBufferValidation->Bind();
+		glViewport(0, 0, _gBufferValidation->GetWidth(), _gBufferValidation->GetHeight());
+		glDisable(GL_BLEND);
+
+		_validationShader->Bind();
+		_validationShader->SetUniform("u_NormalTolerance", _validationTolerances.x);
+		_validationShader->SetUniform("u_PositionTolerance", _validationTolerances.y);
+
+		_BindGBuffer();
+		_primaryFBO->BindAttachment(RenderTargetAttachment::Color3, 5); // reference view pos
+		_primaryFBO->BindAttachment(RenderTargetAttachment::Color4, 6); // reference normals
+		_fullscreenQuad->Draw();
+
+		_gBufferValidation->Unbind();
+	});
+}
+
+void RenderLayer::_BindGBuffer()
+{
+	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Depth)->Bind(0);  // depth
+	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color0)->Bind(1); // albedo
+	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color1)->Bind(2); // normals + metallic + spec
+	_primaryFBO->GetTextureAttachment(RenderTargetAttachment::Color2)->Bind(3); // emissive
 }
 
 void RenderLayer::_ClearFramebuffer(Framebuffer::Sptr & buffer, const glm::vec4 * colors, int layers) {
@@ -377,9 +479,12 @@ void RenderLayer::OnWindowResize(const glm::ivec2 & oldSize, const glm::ivec2 &
 	if (newSize.x * newSize.y == 0) return;
 
 	// Set viewport and resize our primary FBO and light accumulation FBO
+	// The lighting buffer is sized from the G-Buffer each frame, so the render graph picks up the new size on it's own
 	_primaryFBO->Resize(newSize);
-	_lightingFBO->Resize(newSize);
 	_outputBuffer->Resize(newSize);
+	if (_gBufferValidation != nullptr) {
+		_gBufferValidation->Resize(newSize);
+	}
 
 	// Update the main camera's projection
 	Application& app = Application::Get();
@@ -395,33 +500,16 @@ void RenderLayer::OnAppLoad(const nlohmann::json & config)
 	glEnable(GL_CULL_FACE);
 	glCullFace(GL_BACK);
 
-	// Create a new descriptor for our FBO
-	FramebufferDescriptor fboDescriptor;
-	fboDescriptor.Width = app.GetWindowSize().x;
-	fboDescriptor.Height = app.GetWindowSize().y;
-
-	// We want to use a 32 bit depth buffer, we'll ignore the stencil buffer for now
-	fboDescriptor.RenderTargets[RenderTargetAttachment::Depth] = RenderTargetDescriptor(RenderTargetType::Depth32);
-	// Color layer 0 (albedo, specular)
-	fboDescriptor.RenderTargets[RenderTargetAttachment::Color0] = RenderTargetDescriptor(RenderTargetType::ColorRgba8);
-	// Color layer 1 (normals, metallic)
-	fboDescriptor.RenderTargets[RenderTargetAttachment::Color1] = RenderTargetDescriptor(RenderTargetType::ColorRgba8);
-	// Color layer 2 (emissive)  
-	fboDescriptor.RenderTargets[RenderTargetAttachment::Color2] = RenderTargetDescriptor(RenderTargetType::ColorRgba8);
-	// Color layer 3 (view space position)  
-	fboDescriptor.RenderTargets[RenderTargetAttachment::Color3] = RenderTargetDescriptor(RenderTargetType::ColorRgba16F);
-
 	// Create the primary FBO
-	_primaryFBO = std::make_shared<Framebuffer>(fboDescriptor);
+	_CreateGBuffer(app.GetWindowSize());
 
-	fboDescriptor.RenderTargets.clear();
-	fboDescriptor.RenderTargets[RenderTargetAttachment::Color0] = RenderTargetDescriptor(RenderTargetType::ColorRgba8); // Diffuse
-	fboDescriptor.RenderTargets[RenderTargetAttachment::Color1] = RenderTargetDescriptor(RenderTargetType::ColorRgba8); // Specular
-
-	_lightingFBO = std::make_shared<Framebuffer>(fboDescriptor);
+	// The lighting buffer, shadow maps and post processing targets are transient, and come from the render graph
+	_renderGraph = std::make_shared<RenderGraph>();
 
 	// Create an FBO to store final output
-	fboDescriptor.RenderTargets.clear();
+	FramebufferDescriptor fboDescriptor;
+	fboDescriptor.Width = app.GetWindowSize().x;
+	fboDescriptor.Height = app.GetWindowSize().y;
 	fboDescriptor.RenderTargets[RenderTargetAttachment::Depth] = RenderTargetDescriptor(RenderTargetType::Depth32);
 	fboDescriptor.RenderTargets[RenderTargetAttachment::Color0] = RenderTargetDescriptor(RenderTargetType::ColorRgba8);
 
@@ -448,6 +536,11 @@ void RenderLayer::OnAppLoad(const nlohmann::json & config)
 	_shadowShader->LoadShaderPartFromFile("shaders/fragment_shaders/shadow_composite.glsl", ShaderPartType::Fragment);
 	_shadowShader->Link();
 
+	_validationShader = ShaderProgram::Create();
+	_validationShader->LoadShaderPartFromFile("shaders/vertex_shaders/fullscreen_quad.glsl", ShaderPartType::Vertex);
+	_validationShader->LoadShaderPartFromFile("shaders/fragment_shaders/gbuffer_validation.glsl", ShaderPartType::Fragment);
+	_validationShader->Link();
+
 	// We need a mesh for drawing fullscreen quads
 
 	glm::vec2 positions[6] = {
@@ -510,6 +603,58 @@ const Framebuffer::Sptr& RenderLayer::GetGBuffer() const
 	return _primaryFBO;
 }
 
+const RenderGraph::Sptr& RenderLayer::GetRenderGraph() const
+{
+	return _renderGraph;
+}
+
+bool RenderLayer::IsGBufferValidationEnabled() const {
+	return _validateGBuffer;
+}
+
+void RenderLayer::SetGBufferValidationEnabled(bool value) {
+	_validateGBuffer = value;
+}
+
+const Framebuffer::Sptr& RenderLayer::GetGBufferValidation() const {
+	return _gBufferValidation;
+}
+
+const glm::vec2& RenderLayer::GetGBufferValidationTolerances() const {
+	return _validationTolerances;
+}
+
+void RenderLayer::SetGBufferValidationTolerances(const glm::vec2& value) {
+	_validationTolerances = value;
+}
+
+void RenderLayer::_CreateGBuffer(const glm::ivec2& size)
+{
+	// Create a new descriptor for our FBO
+	FramebufferDescriptor fboDescriptor;
+	fboDescriptor.Width = size.x;
+	fboDescriptor.Height = size.y;
+
+	// We want to use a 32 bit depth buffer, we'll ignore the stencil buffer for now. View space positions are
+	// re-constructed from this, so we don't need to store them
+	fboDescriptor.RenderTargets[RenderTargetAttachment::Depth] = RenderTargetDescriptor(RenderTargetType::Depth32);
+	// Color layer 0 (albedo)
+	fboDescriptor.RenderTargets[RenderTargetAttachment::Color0] = RenderTargetDescriptor(RenderTargetType::ColorRgba8);
+	// Color layer 1 (octahedral normals, metallic, specular), see fragments/gbuffer_encoding.glsl
+	fboDescriptor.RenderTargets[RenderTargetAttachment::Color1] = RenderTargetDescriptor(RenderTargetType::ColorRgba8);
+	// Color layer 2 (emissive)  
+	fboDescriptor.RenderTargets[RenderTargetAttachment::Color2] = RenderTargetDescriptor(RenderTargetType::ColorRgba8);
+
+	// Full precision view space positions and normals, only for checking the layers above against
+	if (_validateGBuffer) {
+		fboDescriptor.RenderTargets[RenderTargetAttachment::Color3] = RenderTargetDescriptor(RenderTargetType::ColorRgba16F);
+		fboDescriptor.RenderTargets[RenderTargetAttachment::Color4] = RenderTargetDescriptor(RenderTargetType::ColorRgba16F);
+	}
+
+	_primaryFBO = std::make_shared<Framebuffer>(fboDescriptor);
+	_gBufferHasReference = _validateGBuffer;
+}
+
 void RenderLayer::_InitFrameUniforms()
 {
 	using namespace Gameplay;
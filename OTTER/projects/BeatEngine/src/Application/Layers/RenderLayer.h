@@ -1,6 +1,7 @@
 #pragma once
 #include "../ApplicationLayer.h"
 #include "Graphics/Framebuffer.h"
+#include "Graphics/RenderGraph.h"
 #include "Graphics/Buffers/UniformBuffer.h"
 #include "Graphics/ShaderProgram.h"
 #include "Graphics/VertexArrayObject.h"
@@ -115,10 +116,39 @@ public:
 	void SetRenderFlags(RenderFlags value);
 	RenderFlags GetRenderFlags() const;
 
+	/// <summary>
+	/// Gets the framebuffer that the render graph gave the lighting target last frame. This is transient, so
+	/// it's only meant for debug views, and will be null until the first frame has been rendered
+	/// </summary>
 	const Framebuffer::Sptr& GetLightingBuffer() const;
 	const Framebuffer::Sptr& GetRenderOutput() const;
 	const Framebuffer::Sptr& GetGBuffer() const;
 
+	/// <summary>
+	/// When enabled, the G-Buffer gets extra targets that the G-Buffer shaders write full precision view space
+	/// positions and normals to, and a debug pass compares them against what the lighting passes read back from
+	/// the compact targets. Takes effect at the start of the next frame
+	/// </summary>
+	bool IsGBufferValidationEnabled() const;
+	void SetGBufferValidationEnabled(bool value);
+	/// <summary>
+	/// Gets the output of the G-Buffer validation pass, normal error in red, position error in green and the
+	/// error of the old normal encoding in blue. Will be null until validation has run for a frame
+	/// </summary>
+	const Framebuffer::Sptr& GetGBufferValidation() const;
+	/// <summary>
+	/// Gets or sets the errors that show up at full intensity in the validation view, with the normal error in
+	/// degrees in x, and the position error relative to the pixel's depth in y
+	/// </summary>
+	const glm::vec2& GetGBufferValidationTolerances() const;
+	void SetGBufferValidationTolerances(const glm::vec2& value);
+
+	/// <summary>
+	/// Gets the render graph that the frame's passes are scheduled through. Layers that render after this one
+	/// can add their own passes, transient targets are pooled across the whole frame
+	/// </summary>
+	const RenderGraph::Sptr& GetRenderGraph() const;
+
 	const UniformBuffer<FrameLevelUniforms>::Sptr& GetFrameUniforms() const;
 
 	// Inherited from ApplicationLayer
@@ -133,11 +163,14 @@ protected:
 	Framebuffer::Sptr   _primaryFBO;
 	Framebuffer::Sptr   _lightingFBO;
 	Framebuffer::Sptr   _outputBuffer;
+	Framebuffer::Sptr   _gBufferValidation;
+	RenderGraph::Sptr   _renderGraph;
 
 	ShaderProgram::Sptr _clearShader;
 	ShaderProgram::Sptr _lightAccumulationShader;
 	ShaderProgram::Sptr _compositingShader;
 	ShaderProgram::Sptr _shadowShader;
+	ShaderProgram::Sptr _validationShader;
 
 	VertexArrayObject::Sptr _fullscreenQuad;
 
@@ -145,6 +178,10 @@ protected:
 	glm::vec4         _clearColor;
 	RenderFlags       _renderFlags;
 
+	bool              _validateGBuffer;
+	bool              _gBufferHasReference;
+	glm::vec2         _validationTolerances;
+
 	const int FRAME_UBO_BINDING = 0;
 	UniformBuffer<FrameLevelUniforms>::Sptr _frameUniforms;
 
@@ -158,9 +195,12 @@ protected:
 	//UniformBuffer<LightingUboStruct>::Sptr _AnimationUBO;
 
 	void _InitFrameUniforms();
+	void _CreateGBuffer(const glm::ivec2& size);
 	void _RenderScene(const glm::mat4& view, const glm::mat4& Projection, const glm::ivec2& screenSize);
 
-	void _AccumulateLighting();
-	void _Composite();
+	RenderGraph::Target _AddLightingPasses(RenderGraph::Target gBuffer);
+	void _AddCompositePass(RenderGraph::Target gBuffer, RenderGraph::Target lighting, RenderGraph::Target output);
+	void _AddValidationPass(RenderGraph::Target gBuffer);
+	void _BindGBuffer();
 	void _ClearFramebuffer(Framebuffer::Sptr& buffer, const glm::vec4* colors, int layers);
 };
\ No newline at end of file
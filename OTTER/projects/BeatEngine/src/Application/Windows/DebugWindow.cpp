@@ -25,6 +25,23 @@ void DebugWindow::RenderMenuBar()
 	}
 
 	ImGui::Separator();
+
+	int physicsThreads = app.CurrentScene()->GetPhysicsThreadCount();
+	ImGui::SetNextItemWidth(80.0f);
+	if (ImGui::InputInt("Physics Threads", &physicsThreads)) {
+		app.CurrentScene()->SetPhysicsThreadCount(physicsThreads);
+	}
+
+	ImGui::Separator();
+
+	float activationRadius = app.CurrentScene()->GetActivationRadius();
+	ImGui::SetNextItemWidth(80.0f);
+	if (ImGui::DragFloat("Activation Radius", &activationRadius, 1.0f, 0.0f, 1000.0f)) {
+		app.CurrentScene()->SetActivationRadius(activationRadius);
+	}
+	ImGui::Text("Active: %d Dormant: %d", app.CurrentScene()->GetActiveObjectCount(), app.CurrentScene()->GetDormantObjectCount());
+
+	ImGui::Separator();
 	 
 
 	RenderFlags flags = renderLayer->GetRenderFlags();
@@ -27,10 +27,6 @@ void GBufferPreviews::Render()
 	Texture2D::Sptr& color = framebuffer->GetTextureAttachment(RenderTargetAttachment::Color0);
 	Texture2D::Sptr& normals = framebuffer->GetTextureAttachment(RenderTargetAttachment::Color1);
 	Texture2D::Sptr& emissive = framebuffer->GetTextureAttachment(RenderTargetAttachment::Color2);
-	Texture2D::Sptr& viewspace = framebuffer->GetTextureAttachment(RenderTargetAttachment::Color3);
-
-	Texture2D::Sptr& diffuse = lightBuffer->GetTextureAttachment(RenderTargetAttachment::Color0);
-	Texture2D::Sptr& specular = lightBuffer->GetTextureAttachment(RenderTargetAttachment::Color1);
 
 	int width = (ImGui::GetContentRegionAvailWidth() / 2);
 	float aspect = app.GetWindowSize().x / (float)app.GetWindowSize().y;
@@ -49,22 +45,44 @@ void GBufferPreviews::Render()
 	_RenderTexture2D(color, size, "color");
 	ImGui::NextColumn();
 
-	_RenderTexture2D(normals, size, "normals");
+	_RenderTexture2D(normals, size, "normals (octahedral) + metallic + specular");
 	ImGui::NextColumn();
 
 	_RenderTexture2D(emissive, size, "emissive"); 
 	ImGui::NextColumn();  
 
-	_RenderTexture2D(viewspace, size, "position (viewspace)");
-	ImGui::NextColumn();
+	// The lighting buffer comes from the render graph, so it won't exist until we've rendered a frame
+	if (lightBuffer != nullptr) {
+		_RenderTexture2D(lightBuffer->GetTextureAttachment(RenderTargetAttachment::Color0), size, "Diffuse Lighting");
+		ImGui::NextColumn();
 
-	_RenderTexture2D(diffuse, size, "Diffuse Lighting");
-	ImGui::NextColumn();
-
-	_RenderTexture2D(specular, size, "Specular Lighting");
-	ImGui::NextColumn(); 
+		_RenderTexture2D(lightBuffer->GetTextureAttachment(RenderTargetAttachment::Color1), size, "Specular Lighting");
+		ImGui::NextColumn(); 
+	}
 
 	ImGui::Columns(1);
+
+	// Compares the compact G-Buffer against full precision copies of what it's encoding
+	ImGui::Separator();
+	bool validate = renderLayer->IsGBufferValidationEnabled();
+	if (ImGui::Checkbox("Validate Encoding", &validate)) {
+		renderLayer->SetGBufferValidationEnabled(validate);
+	}
+	if (validate) {
+		glm::vec2 tolerances = renderLayer->GetGBufferValidationTolerances();
+		bool changed = false;
+		changed |= ImGui::DragFloat("Normal Tolerance (deg)", &tolerances.x, 0.05f, 0.01f, 45.0f);
+		changed |= ImGui::DragFloat("Position Tolerance", &tolerances.y, 0.0001f, 0.00001f, 0.1f, "%.5f");
+		if (changed) {
+			renderLayer->SetGBufferValidationTolerances(tolerances);
+		}
+		ImGui::TextWrapped("Red: normal error, Green: position error, Blue: old normal encoding's error, Magenta: surface mismatch. Full intensity is at or over the tolerance");
+
+		const Framebuffer::Sptr& validation = renderLayer->GetGBufferValidation();
+		if (validation != nullptr) {
+			_RenderTexture2D(validation->GetTextureAttachment(RenderTargetAttachment::Color0), ImVec2(width * 2, height * 2), "validation");
+		}
+	}
 }
 
 void GBufferPreviews::_RenderTexture2D(const Texture2D::Sptr & value, const ImVec2& size, const char* name) {
@@ -61,7 +61,7 @@ void HierarchyWindow::_RenderObjectNode(Gameplay::GameObject::Sptr object, int d
 
 	// Determine the text of the node
 	static char buffer[256];
-	sprintf_s(buffer, 256, "%s###GO_HEADER", object->Name.c_str());
+	snprintf(buffer, 256, "%s###GO_HEADER", object->Name.c_str());
 	bool isOpen = ImGui::TreeNodeEx(buffer, flags);
 	if (ImGui::IsItemClicked()) {
 		// TODO: Properly handle multi-selection
@@ -91,7 +91,7 @@ void HierarchyWindow::_RenderObjectNode(Gameplay::GameObject::Sptr object, int d
 		char buffer[64];
 		scene->Components().EachType([&](const std::string& typeName, const std::type_index type) {
 			// Hide component types already added
-			sprintf_s(buffer, "Add %s", typeName.c_str());
+			snprintf(buffer, sizeof(buffer), "Add %s", typeName.c_str());
 			if (ImGui::MenuItem(buffer, nullptr, nullptr, !object->Has(type))) {
 				object->Add(type);
 			}
@@ -0,0 +1,260 @@
+#include "MemoryWindow.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+#include <cstring>
+#include <map>
+#include <glad/glad.h>
+
+// Vendor specific queries for the driver's view of video memory, these aren't in our glad build. All values are in KB
+// https://www.khronos.org/registry/OpenGL/extensions/NVX/NVX_gpu_memory_info.txt
+#define GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX         0x9047
+#define GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX 0x9049
+// https://www.khronos.org/registry/OpenGL/extensions/ATI/ATI_meminfo.txt
+#define TEXTURE_FREE_MEMORY_ATI                      0x87FC
+
+// Formats a size in bytes for display, picking whichever unit keeps it readable
+static std::string FormatBytes(int64_t bytes) {
+	char buffer[32];
+	double value = (double)bytes;
+	if (std::abs(value) >= 1024.0 * 1024.0 * 1024.0) {
+		snprintf(buffer, sizeof(buffer), "%.2f GB", value / (1024.0 * 1024.0 * 1024.0));
+	} else if (std::abs(value) >= 1024.0 * 1024.0) {
+		snprintf(buffer, sizeof(buffer), "%.2f MB", value / (1024.0 * 1024.0));
+	} else if (std::abs(value) >= 1024.0) {
+		snprintf(buffer, sizeof(buffer), "%.2f KB", value / 1024.0);
+	} else {
+		snprintf(buffer, sizeof(buffer), "%lld B", (long long)bytes);
+	}
+	return buffer;
+}
+
+MemoryWindow::MemoryWindow() :
+	IEditorWindow(),
+	_driverQuery(DriverMemoryQuery::Unknown),
+	_budgetMb(0),
+	_gpuAllocations(),
+	_heapHistory(),
+	_heapHistoryOffset(0)
+{
+	Name = "Memory";
+	ParentName = "Render Stats";
+	SplitDirection = ImGuiDir_::ImGuiDir_Down;
+	SplitDepth = 0.5f;
+}
+
+MemoryWindow::~MemoryWindow() = default;
+
+void MemoryWindow::Render()
+{
+	if (ImGui::CollapsingHeader("Frame", ImGuiTreeNodeFlags_DefaultOpen)) {
+		_RenderFrame();
+	}
+	if (ImGui::CollapsingHeader("Heap", ImGuiTreeNodeFlags_DefaultOpen)) {
+		_RenderHeap();
+	}
+	if (ImGui::CollapsingHeader("GPU", ImGuiTreeNodeFlags_DefaultOpen)) {
+		_RenderGpu();
+	}
+
+	const std::vector<SceneLeakReport>& reports = MemoryTracker::GetLeakReports();
+	char header[48];
+	snprintf(header, sizeof(header), "Scene Leaks (%d)###SceneLeaks", (int)reports.size());
+	if (ImGui::CollapsingHeader(header, reports.empty() ? 0 : ImGuiTreeNodeFlags_DefaultOpen)) {
+		_RenderLeaks();
+	}
+}
+
+void MemoryWindow::_RenderFrame()
+{
+	const FrameArenaStats& stats = FrameArena::GetLastFrameStats();
+
+	if (MemoryTracker::IsCpuTrackingEnabled()) {
+		_heapHistory[_heapHistoryOffset] = (float)stats.HeapAllocations;
+		_heapHistoryOffset = (_heapHistoryOffset + 1) % IM_ARRAYSIZE(_heapHistory);
+
+		char overlay[48];
+		snprintf(overlay, sizeof(overlay), "%llu heap allocations", (unsigned long long)stats.HeapAllocations);
+		ImGui::PlotLines("##HeapAllocations", _heapHistory, IM_ARRAYSIZE(_heapHistory), _heapHistoryOffset, overlay, 0.0f, FLT_MAX, ImVec2(-1.0f, 40.0f));
+	} else {
+		ImGui::TextDisabled("Heap allocations aren't counted without ENABLE_MEMORY_TRACKING");
+	}
+
+	ImGui::Text("Arena:     %s in %llu allocations", FormatBytes(stats.ArenaBytes).c_str(), (unsigned long long)stats.ArenaAllocations);
+	ImGui::Text("Peak:      %s of %s reserved", FormatBytes(FrameArena::GetHighWaterMark()).c_str(), FormatBytes(FrameArena::GetCapacity()).c_str());
+	if (stats.Overflowed) {
+		ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.2f, 1.0f), "The arena grew last frame");
+	}
+}
+
+void MemoryWindow::_RenderHeap()
+{
+	if (!MemoryTracker::IsCpuTrackingEnabled()) {
+		ImGui::TextDisabled("Heap tracking was disabled with ENABLE_MEMORY_TRACKING");
+		return;
+	}
+
+	ImGui::Columns(4, "HeapTags");
+	ImGui::Text("Tag"); ImGui::NextColumn();
+	ImGui::Text("Live"); ImGui::NextColumn();
+	ImGui::Text("Blocks"); ImGui::NextColumn();
+	ImGui::Text("Allocations"); ImGui::NextColumn();
+	ImGui::Separator();
+
+	MemoryTagStats total;
+	MemoryTag tag = MemoryTag::General;
+	size_t tagCount = CountOfMemoryTag(tag);
+	for (size_t ix = 0; ix < tagCount; ix++, tag++) {
+		MemoryTagStats stats = MemoryTracker::GetTagStats(tag);
+		total.LiveBytes  += stats.LiveBytes;
+		total.LiveCount  += stats.LiveCount;
+		total.TotalCount += stats.TotalCount;
+
+		ImGui::Text("%s", (~tag).c_str()); ImGui::NextColumn();
+		ImGui::Text("%s", FormatBytes(stats.LiveBytes).c_str()); ImGui::NextColumn();
+		ImGui::Text("%lld", (long long)stats.LiveCount); ImGui::NextColumn();
+		ImGui::Text("%llu", (unsigned long long)stats.TotalCount); ImGui::NextColumn();
+	}
+
+	ImGui::Separator();
+	ImGui::Text("Total"); ImGui::NextColumn();
+	ImGui::Text("%s", FormatBytes(total.LiveBytes).c_str()); ImGui::NextColumn();
+	ImGui::Text("%lld", (long long)total.LiveCount); ImGui::NextColumn();
+	ImGui::Text("%llu", (unsigned long long)total.TotalCount); ImGui::NextColumn();
+	ImGui::Columns(1);
+}
+
+void MemoryWindow::_RenderGpu()
+{
+	// Figure out if the driver can tell us about video memory, this needs a context so we can't do it in the constructor
+	if (_driverQuery == DriverMemoryQuery::Unknown) {
+		_driverQuery = DriverMemoryQuery::None;
+		int extensionCount = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+		for (int ix = 0; ix < extensionCount; ix++) {
+			const char* name = (const char*)glGetStringi(GL_EXTENSIONS, ix);
+			if (name == nullptr) continue;
+			if (strcmp(name, "GL_NVX_gpu_memory_info") == 0) {
+				_driverQuery = DriverMemoryQuery::Nvidia;
+			} else if (strcmp(name, "GL_ATI_meminfo") == 0) {
+				_driverQuery = DriverMemoryQuery::Amd;
+			}
+		}
+
+		// Default the budget to the card's memory if we know it, and nobody has set one yet
+		if (_driverQuery == DriverMemoryQuery::Nvidia && MemoryTracker::GetGpuBudget() == 0) {
+			int dedicatedKb = 0;
+			glGetIntegerv(GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &dedicatedKb);
+			MemoryTracker::SetGpuBudget((int64_t)dedicatedKb * 1024);
+		}
+		_budgetMb = (int)(MemoryTracker::GetGpuBudget() / (1024 * 1024));
+	}
+
+	int64_t tracked = MemoryTracker::GetGpuTotal();
+	ImGui::Text("Tracked:   %s", FormatBytes(tracked).c_str());
+
+	if (_driverQuery == DriverMemoryQuery::Nvidia) {
+		int dedicatedKb = 0, availableKb = 0;
+		glGetIntegerv(GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &dedicatedKb);
+		glGetIntegerv(GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &availableKb);
+		ImGui::Text("Driver:    %s used of %s", FormatBytes((int64_t)(dedicatedKb - availableKb) * 1024).c_str(), FormatBytes((int64_t)dedicatedKb * 1024).c_str());
+	} else if (_driverQuery == DriverMemoryQuery::Amd) {
+		int freeKb[4] = { 0 };
+		glGetIntegerv(TEXTURE_FREE_MEMORY_ATI, freeKb);
+		ImGui::Text("Driver:    %s free", FormatBytes((int64_t)freeKb[0] * 1024).c_str());
+	} else {
+		ImGui::TextDisabled("Driver:    not reported by this renderer");
+	}
+
+	if (ImGui::DragInt("Budget (MB)", &_budgetMb, 16.0f, 0, 64 * 1024)) {
+		MemoryTracker::SetGpuBudget((int64_t)_budgetMb * 1024 * 1024);
+	}
+	int64_t budget = MemoryTracker::GetGpuBudget();
+	if (budget > 0) {
+		float fraction = (float)((double)tracked / (double)budget);
+		char overlay[64];
+		snprintf(overlay, sizeof(overlay), "%.1f%% of budget", fraction * 100.0f);
+		if (fraction > 1.0f) {
+			ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.9f, 0.2f, 0.2f, 1.0f));
+			ImGui::ProgressBar(1.0f, ImVec2(-1.0f, 0.0f), overlay);
+			ImGui::PopStyleColor();
+		} else {
+			ImGui::ProgressBar(fraction, ImVec2(-1.0f, 0.0f), overlay);
+		}
+	}
+
+	// Group the allocations by type, with the biggest types and owners first
+	MemoryTracker::GetGpuAllocations(_gpuAllocations);
+	std::sort(_gpuAllocations.begin(), _gpuAllocations.end(), [](const GpuAllocation& a, const GpuAllocation& b) {
+		return a.Bytes > b.Bytes;
+	});
+	std::map<std::string, std::pair<size_t, size_t>> byType;
+	for (const auto& allocation : _gpuAllocations) {
+		auto& [count, bytes] = byType[allocation.Type];
+		count++;
+		bytes += allocation.Bytes;
+	}
+	std::vector<std::pair<std::string, std::pair<size_t, size_t>>> types(byType.begin(), byType.end());
+	std::sort(types.begin(), types.end(), [](const auto& a, const auto& b) {
+		return a.second.second > b.second.second;
+	});
+
+	ImGui::Separator();
+	for (const auto& [type, totals] : types) {
+		char label[128];
+		snprintf(label, sizeof(label), "%s (%d) - %s###%s", type.c_str(), (int)totals.first, FormatBytes(totals.second).c_str(), type.c_str());
+		if (ImGui::TreeNode(label)) {
+			ImGui::Columns(3, "GpuOwners");
+			for (const auto& allocation : _gpuAllocations) {
+				if (allocation.Type != type) continue;
+				ImGui::Text("%s", allocation.Owner.empty() ? "(unnamed)" : allocation.Owner.c_str()); ImGui::NextColumn();
+				ImGui::TextDisabled("%s", (~allocation.Tag).c_str()); ImGui::NextColumn();
+				ImGui::Text("%s", FormatBytes(allocation.Bytes).c_str()); ImGui::NextColumn();
+			}
+			ImGui::Columns(1);
+			ImGui::TreePop();
+		}
+	}
+}
+
+void MemoryWindow::_RenderLeaks()
+{
+	const std::vector<SceneLeakReport>& reports = MemoryTracker::GetLeakReports();
+	if (reports.empty()) {
+		ImGui::TextDisabled("Nothing has been left behind by an unloaded scene");
+		return;
+	}
+	if (ImGui::Button("Clear")) {
+		MemoryTracker::ClearLeakReports();
+		return;
+	}
+
+	// Newest first, since that's usually the one we care about
+	for (auto it = reports.crbegin(); it != reports.crend(); it++) {
+		const SceneLeakReport& report = *it;
+		ImGui::PushID(&report);
+		ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.4f, 0.4f, 1.0f));
+		bool open = ImGui::TreeNode("Report", "%s (generation %u)", report.Scene.c_str(), report.Generation);
+		ImGui::PopStyleColor();
+		if (open) {
+			if (!report.SceneReleased) {
+				ImGui::Text("The scene was still referenced after it was unloaded");
+			}
+			if (report.CpuCount > 0) {
+				ImGui::Text("Heap: %lld blocks, %s", (long long)report.CpuCount, FormatBytes(report.CpuBytes).c_str());
+			}
+			if (!report.GpuAllocations.empty()) {
+				ImGui::Columns(3, "LeakedGpu");
+				for (const auto& allocation : report.GpuAllocations) {
+					ImGui::Text("%s", allocation.Type.c_str()); ImGui::NextColumn();
+					ImGui::Text("%s", allocation.Owner.empty() ? "(unnamed)" : allocation.Owner.c_str()); ImGui::NextColumn();
+					ImGui::Text("%s", FormatBytes(allocation.Bytes).c_str()); ImGui::NextColumn();
+				}
+				ImGui::Columns(1);
+			}
+			ImGui::TreePop();
+		}
+		ImGui::PopID();
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "Application/IEditorWindow.h"
+#include "Utils/MemoryTracker.h"
+#include "Utils/FrameArena.h"
+
+/**
+ * Breaks down our heap and GPU memory usage by subsystem, resource type and owner,
+ * shows how much transient memory each frame uses, and lists anything that was left
+ * behind when a scene was unloaded
+ */
+class MemoryWindow final : public IEditorWindow {
+public:
+	MAKE_PTRS(MemoryWindow);
+	MemoryWindow();
+	virtual ~MemoryWindow();
+
+	// Inherited from IEditorWindow
+
+	virtual void Render() override;
+
+protected:
+	// Which vendor extension we can ask for the driver's view of video memory, detected on the first render
+	enum class DriverMemoryQuery {
+		Unknown,
+		None,
+		Nvidia,
+		Amd
+	};
+
+	DriverMemoryQuery          _driverQuery;
+	int                        _budgetMb;
+	std::vector<GpuAllocation> _gpuAllocations;
+	// A rolling history of heap allocations per frame, for the plot
+	float                      _heapHistory[120];
+	int                        _heapHistoryOffset;
+
+	void _RenderFrame();
+	void _RenderHeap();
+	void _RenderGpu();
+	void _RenderLeaks();
+};
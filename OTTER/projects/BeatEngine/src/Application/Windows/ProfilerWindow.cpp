@@ -0,0 +1,197 @@
+#include "ProfilerWindow.h"
+#include <algorithm>
+#include <unordered_map>
+#include "Utils/Windows/FileDialogs.h"
+
+// Height of a single row in the timeline, in pixels
+static constexpr float RowHeight = 18.0f;
+
+// Picks a stable color for a zone, based on it's name
+static ImU32 ZoneColor(const char* name) {
+	uint32_t hash = 2166136261u;
+	for (const char* c = name; *c != '\0'; c++) {
+		hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+	}
+	return ImColor::HSV((hash % 360) / 360.0f, 0.55f, 0.75f);
+}
+
+ProfilerWindow::ProfilerWindow() :
+	IEditorWindow(),
+	_frameCount(1),
+	_frameOffset(0),
+	_zoom(1.0f),
+	_frameMarkers(std::vector<uint64_t>()),
+	_capture(std::vector<ProfileThreadCapture>())
+{
+	Name = "Profiler";
+	SplitDirection = ImGuiDir_::ImGuiDir_Down;
+	SplitDepth = 0.3f;
+}
+
+ProfilerWindow::~ProfilerWindow() = default;
+
+void ProfilerWindow::Render()
+{
+	#if !ENABLE_PROFILING
+	ImGui::TextDisabled("Profiling is disabled in this build (ENABLE_PROFILING = 0)");
+	return;
+	#endif
+
+	bool recording = Profiler::IsRecording();
+	if (ImGui::Checkbox("Record", &recording)) {
+		Profiler::SetRecording(recording);
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Export Trace")) {
+		std::optional<std::string> path = FileDialogs::SaveFile("Trace File\0*.json\0\0");
+		if (path.has_value()) {
+			std::string file = path.value();
+			if (file.find(".json") == std::string::npos) {
+				file += ".json";
+			}
+			Profiler::ExportChromeTrace(file);
+		}
+	}
+
+	Profiler::GetFrameMarkers(_frameMarkers);
+	// The last marker is the frame currently in flight, so we need at least 2 to show a complete frame
+	int completeFrames = static_cast<int>(_frameMarkers.size()) - 1;
+	if (completeFrames < 1) {
+		ImGui::Text("Waiting for frames...");
+		return;
+	}
+
+	ImGui::SetNextItemWidth(120.0f);
+	ImGui::SliderInt("Frames", &_frameCount, 1, std::min(16, completeFrames));
+	ImGui::SameLine();
+	ImGui::SetNextItemWidth(120.0f);
+	ImGui::SliderInt("Frames Back", &_frameOffset, 0, completeFrames - 1);
+	ImGui::SameLine();
+	ImGui::SetNextItemWidth(120.0f);
+	ImGui::SliderFloat("Zoom", &_zoom, 1.0f, 32.0f, "%.1fx", 2.0f);
+
+	_frameCount = std::clamp(_frameCount, 1, completeFrames);
+	_frameOffset = std::clamp(_frameOffset, 0, completeFrames - _frameCount);
+
+	size_t endIx = _frameMarkers.size() - 1 - _frameOffset;
+	uint64_t end = _frameMarkers[endIx];
+	uint64_t start = _frameMarkers[endIx - _frameCount];
+
+	ImGui::Text("Showing %.3f ms", (end - start) / 1000000.0);
+
+	Profiler::Capture(_capture, start);
+
+	_RenderTimeline(start, end);
+	_RenderSummary(start, end);
+}
+
+void ProfilerWindow::_RenderTimeline(uint64_t start, uint64_t end)
+{
+	// Figure out how many rows we need so we can size the child window
+	float contentHeight = 0.0f;
+	for (const auto& thread : _capture) {
+		uint32_t maxDepth = 0;
+		for (const auto& zone : thread.Zones) {
+			maxDepth = std::max(maxDepth, zone.Depth);
+		}
+		contentHeight += RowHeight * (maxDepth + 2);
+	}
+
+	ImGui::BeginChild("Timeline", ImVec2(0, std::min(contentHeight + 24.0f, 400.0f)), true, ImGuiWindowFlags_HorizontalScrollbar);
+
+	float width = (ImGui::GetContentRegionAvail().x - 4.0f) * _zoom;
+	double pixelsPerNs = width / static_cast<double>(end - start);
+	ImVec2 origin = ImGui::GetCursorScreenPos();
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	ImVec2 mouse = ImGui::GetIO().MousePos;
+
+	const ProfileZone* hovered = nullptr;
+	float y = origin.y;
+	for (const auto& thread : _capture) {
+		drawList->AddText(ImVec2(origin.x + ImGui::GetScrollX(), y), ImGui::GetColorU32(ImGuiCol_Text), thread.Name.c_str());
+		y += RowHeight;
+
+		uint32_t maxDepth = 0;
+		for (const auto& zone : thread.Zones) {
+			if (zone.EndNs < start || zone.StartNs > end) continue;
+			maxDepth = std::max(maxDepth, zone.Depth);
+
+			float x0 = origin.x + static_cast<float>((static_cast<double>(zone.StartNs) - start) * pixelsPerNs);
+			float x1 = origin.x + static_cast<float>((static_cast<double>(zone.EndNs) - start) * pixelsPerNs);
+			x0 = std::max(x0, origin.x);
+			x1 = std::max(std::min(x1, origin.x + width), x0 + 1.0f);
+			float y0 = y + zone.Depth * RowHeight;
+
+			ImVec2 min(x0, y0);
+			ImVec2 max(x1, y0 + RowHeight - 1.0f);
+			drawList->AddRectFilled(min, max, ZoneColor(zone.Name));
+
+			// Only draw labels when there's actually room for some of the text
+			if (x1 - x0 > 24.0f) {
+				drawList->PushClipRect(min, max, true);
+				drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(255, 255, 255, 255), zone.Name);
+				drawList->PopClipRect();
+			}
+
+			if (mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y) {
+				hovered = &zone;
+			}
+		}
+		y += RowHeight * (maxDepth + 1);
+	}
+
+	ImGui::Dummy(ImVec2(width, y - origin.y));
+
+	if (hovered != nullptr && ImGui::IsWindowHovered()) {
+		ImGui::BeginTooltip();
+		ImGui::Text("%s", hovered->Name);
+		ImGui::Text("%.3f ms", (hovered->EndNs - hovered->StartNs) / 1000000.0);
+		ImGui::EndTooltip();
+	}
+
+	ImGui::EndChild();
+}
+
+void ProfilerWindow::_RenderSummary(uint64_t start, uint64_t end)
+{
+	uint32_t mainThreadId = Profiler::GetMainThreadId();
+	auto mainThread = std::find_if(_capture.begin(), _capture.end(), [&](const ProfileThreadCapture& thread) {
+		return thread.ThreadId == mainThreadId;
+	});
+	if (mainThread == _capture.end() || !ImGui::CollapsingHeader("Main Thread Summary")) {
+		return;
+	}
+
+	// Total up the time spent in each zone name, we key by pointer since names are all stable strings
+	struct ZoneTotal {
+		const char* Name;
+		uint64_t    TotalNs;
+		int         Count;
+	};
+	std::unordered_map<const char*, ZoneTotal> totals;
+	for (const auto& zone : mainThread->Zones) {
+		if (zone.StartNs < start || zone.EndNs > end) continue;
+		ZoneTotal& total = totals.emplace(zone.Name, ZoneTotal{ zone.Name, 0, 0 }).first->second;
+		total.TotalNs += zone.EndNs - zone.StartNs;
+		total.Count++;
+	}
+
+	std::vector<ZoneTotal> sorted;
+	sorted.reserve(totals.size());
+	for (const auto& [key, total] : totals) {
+		sorted.push_back(total);
+	}
+	std::sort(sorted.begin(), sorted.end(), [](const ZoneTotal& a, const ZoneTotal& b) { return a.TotalNs > b.TotalNs; });
+
+	ImGui::Columns(3, "ProfilerSummary");
+	ImGui::Text("Zone"); ImGui::NextColumn();
+	ImGui::Text("Total (ms)"); ImGui::NextColumn();
+	ImGui::Text("Calls"); ImGui::NextColumn();
+	ImGui::Separator();
+	for (const auto& total : sorted) {
+		ImGui::Text("%s", total.Name); ImGui::NextColumn();
+		ImGui::Text("%.3f", total.TotalNs / 1000000.0); ImGui::NextColumn();
+		ImGui::Text("%d", total.Count); ImGui::NextColumn();
+	}
+	ImGui::Columns(1);
+}
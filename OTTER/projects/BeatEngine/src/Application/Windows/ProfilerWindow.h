@@ -0,0 +1,29 @@
+#pragma once
+#include "Application/IEditorWindow.h"
+#include "Utils/Profiler.h"
+
+/**
+ * Displays the zones recorded by the CPU profiler as a per-thread timeline,
+ * and lets us export them to a trace file for offline analysis
+ */
+class ProfilerWindow final : public IEditorWindow {
+public:
+	MAKE_PTRS(ProfilerWindow);
+	ProfilerWindow();
+	virtual ~ProfilerWindow();
+
+	// Inherited from IEditorWindow
+
+	virtual void Render() override;
+
+protected:
+	int   _frameCount;
+	int   _frameOffset;
+	float _zoom;
+
+	std::vector<uint64_t>             _frameMarkers;
+	std::vector<ProfileThreadCapture> _capture;
+
+	void _RenderTimeline(uint64_t start, uint64_t end);
+	void _RenderSummary(uint64_t start, uint64_t end);
+};
@@ -0,0 +1,89 @@
+#include "RenderStatsWindow.h"
+#include "Graphics/GpuProfiler.h"
+#include "Application/Application.h"
+#include "Application/Layers/RenderLayer.h"
+#include "Utils/Windows/FileDialogs.h"
+
+RenderStatsWindow::RenderStatsWindow() :
+	IEditorWindow(),
+	_gpuHistory{ 0.0f },
+	_historyOffset(0)
+{
+	Name = "Render Stats";
+	ParentName = "Profiler";
+	SplitDirection = ImGuiDir_::ImGuiDir_Right;
+	SplitDepth = 0.3f;
+}
+
+RenderStatsWindow::~RenderStatsWindow() = default;
+
+void RenderStatsWindow::Render()
+{
+	bool enabled = GpuProfiler::IsEnabled();
+	if (ImGui::Checkbox("GPU Timing", &enabled)) {
+		GpuProfiler::SetEnabled(enabled);
+	}
+	ImGui::SameLine();
+	if (GpuProfiler::IsCsvLogging()) {
+		if (ImGui::Button("Stop CSV Log")) {
+			GpuProfiler::StopCsvLog();
+		}
+	} else if (ImGui::Button("Start CSV Log")) {
+		std::optional<std::string> path = FileDialogs::SaveFile("CSV File\0*.csv\0\0");
+		if (path.has_value()) {
+			std::string file = path.value();
+			if (file.find(".csv") == std::string::npos) {
+				file += ".csv";
+			}
+			GpuProfiler::StartCsvLog(file);
+		}
+	}
+
+	// Track the GPU frame time so we can see spikes
+	float gpuTime = GpuProfiler::GetFrameGpuTime();
+	_gpuHistory[_historyOffset] = gpuTime;
+	_historyOffset = (_historyOffset + 1) % HistorySize;
+
+	char overlay[32];
+	snprintf(overlay, sizeof(overlay), "GPU: %.3f ms", gpuTime);
+	ImGui::PlotLines("##GpuHistory", _gpuHistory, HistorySize, _historyOffset, overlay, 0.0f, FLT_MAX, ImVec2(ImGui::GetContentRegionAvail().x, 48.0f));
+
+	const RenderStats& stats = GpuProfiler::GetLastFrameStats();
+	ImGui::Separator();
+	ImGui::Text("Draw Calls:       %u", stats.DrawCalls);
+	ImGui::Text("Triangles:        %llu", (unsigned long long)stats.Triangles);
+	ImGui::Text("Shader Binds:     %u", stats.ShaderBinds);
+	ImGui::Text("Material Applies: %u", stats.MaterialApplies);
+	ImGui::Text("Texture Binds:    %u", stats.TextureBinds);
+	ImGui::Text("UBO Uploads:      %.2f KB", stats.UboBytes / 1024.0f);
+
+	const RenderLayer::Sptr& renderLayer = Application::Get().GetLayer<RenderLayer>();
+	if (renderLayer != nullptr) {
+		const RenderGraphStats& graphStats = renderLayer->GetRenderGraph()->GetLastFrameStats();
+		ImGui::Separator();
+		ImGui::Text("Graph Passes:     %u (%u culled)", graphStats.Passes, graphStats.CulledPasses);
+		ImGui::Text("Graph Targets:    %u (%u framebuffers)", graphStats.Targets, graphStats.PhysicalTargets);
+		ImGui::Text("Graph Barriers:   %u", graphStats.Barriers);
+		ImGui::Text("Target Memory:    %.2f MB (%.2f MB saved)", graphStats.AllocatedBytes / (1024.0f * 1024.0f),
+			(graphStats.RequestedBytes - glm::min(graphStats.RequestedBytes, graphStats.AllocatedBytes)) / (1024.0f * 1024.0f));
+	}
+
+	ImGui::Separator();
+	if (!GpuProfiler::IsEnabled()) {
+		ImGui::TextDisabled("GPU timing is disabled");
+		return;
+	}
+	ImGui::Columns(2, "GpuPasses");
+	ImGui::Text("Pass"); ImGui::NextColumn();
+	ImGui::Text("GPU (ms)"); ImGui::NextColumn();
+	ImGui::Separator();
+	for (const auto& timing : GpuProfiler::GetPassTimings()) {
+		ImGui::Indent(timing.Depth * 12.0f + 1.0f);
+		ImGui::Text("%s", timing.Name);
+		ImGui::Unindent(timing.Depth * 12.0f + 1.0f);
+		ImGui::NextColumn();
+		ImGui::Text("%.3f", timing.Milliseconds);
+		ImGui::NextColumn();
+	}
+	ImGui::Columns(1);
+}
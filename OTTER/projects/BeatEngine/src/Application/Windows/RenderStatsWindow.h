@@ -0,0 +1,23 @@
+#pragma once
+#include "Application/IEditorWindow.h"
+
+/**
+ * Displays the GPU time taken by each render pass, as well as counters for
+ * the GL work we submitted in the last frame
+ */
+class RenderStatsWindow final : public IEditorWindow {
+public:
+	MAKE_PTRS(RenderStatsWindow);
+	RenderStatsWindow();
+	virtual ~RenderStatsWindow();
+
+	// Inherited from IEditorWindow
+
+	virtual void Render() override;
+
+protected:
+	static constexpr int HistorySize = 120;
+
+	float _gpuHistory[HistorySize];
+	int   _historyOffset;
+};
@@ -2,6 +2,8 @@
 
 void AudioEngine::init()
 {
+	if (!IsEnabled())
+		return;
 	assert(&Studio != nullptr);
 	Studio.LoadBank("Master.bank");
 	Studio.LoadBank("Master.strings.bank");
@@ -47,4 +49,19 @@ ToneFire::FMODStudio* AudioEngine::GetContext()
 ToneFire::StudioSound* AudioEngine::GetContextBanks()
 {
 	return &Banks;
-}
\ No newline at end of file
+}
+
+void AudioEngine::SetEnabled(bool value)
+{
+	ToneFire::StudioSound::Enabled = value;
+}
+bool AudioEngine::IsEnabled()
+{
+	return ToneFire::StudioSound::Enabled;
+}
+
+void AudioEngine::Update()
+{
+	if (IsEnabled())
+		Studio.Update();
+}
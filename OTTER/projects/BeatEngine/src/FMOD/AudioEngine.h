@@ -22,6 +22,14 @@ public:
 	static ToneFire::FMODStudio* GetContext();
 
 	static ToneFire::StudioSound* GetContextBanks();
+
+	//Turns all audio on or off. When off, no banks are loaded and events are ignored,
+	//so the game can run without sound (ex: hidden window benchmarks). Must be set before init()
+	static void SetEnabled(bool value);
+	static bool IsEnabled();
+
+	//Updates the underlying FMOD Studio system. Must be called once per frame.
+	static void Update();
 private:
 	//Static Singletons for use throughout the project
 	inline static ToneFire::FMODStudio Studio;
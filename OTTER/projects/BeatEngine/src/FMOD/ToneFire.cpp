@@ -306,6 +306,8 @@ ToneFire::StudioSound::StudioSound()
 
 void ToneFire::StudioSound::LoadEvent(const std::string& eventName)
 {
+	if (!Enabled)
+		return;
 	_bankEventDescriptions[eventName] = _instance->_GetEventDescription(eventName);
 	FMOD_RESULT result = _bankEventDescriptions[eventName]->createInstance(&_bankEventInstances[eventName]);
 	_instance->_ErrorCheck(result, "Creating Event Instance: " + eventName);
@@ -313,6 +315,8 @@ void ToneFire::StudioSound::LoadEvent(const std::string& eventName)
 
 void ToneFire::StudioSound::PlayEvent(const std::string& eventName)
 {
+	if (!Enabled)
+		return;
 	if (_bankEventDescriptions[eventName] == nullptr)
 		LoadEvent(eventName);
 
@@ -321,6 +325,8 @@ void ToneFire::StudioSound::PlayEvent(const std::string& eventName)
 
 void ToneFire::StudioSound::SetVolume(const std::string& eventName, float volume)
 {
+	if (!Enabled)
+		return;
 	if (_bankEventDescriptions[eventName] == nullptr)
 		LoadEvent(eventName);
 
@@ -330,12 +336,16 @@ void ToneFire::StudioSound::SetVolume(const std::string& eventName, float volume
 
 void ToneFire::StudioSound::StopEvent(const std::string& eventName)
 {
+	if (!Enabled)
+		return;
 	if (_bankEventDescriptions[eventName] == nullptr)
 		LoadEvent(eventName);
 	_bankEventInstances[eventName]->stop(FMOD_STUDIO_STOP_IMMEDIATE);
 }
 bool ToneFire::StudioSound::IsEventPlaying(const std::string& eventName)
 {
+	if (!Enabled)
+		return false;
 	if (_bankEventDescriptions[eventName] == nullptr)
 		LoadEvent(eventName);
 	FMOD_STUDIO_PLAYBACK_STATE isPlaying;
@@ -349,6 +359,8 @@ bool ToneFire::StudioSound::IsEventPlaying(const std::string& eventName)
 
 void ToneFire::StudioSound::SetEventParameter(const std::string& eventName, const std::string& parameterName, float paramValue)
 {
+	if (!Enabled)
+		return;
 	if (_bankEventDescriptions[eventName] == nullptr)
 		LoadEvent(eventName);
 	FMOD_RESULT result = _bankEventInstances[eventName]->setParameterByName(parameterName.c_str(), paramValue, false);
@@ -358,6 +370,8 @@ void ToneFire::StudioSound::SetEventParameter(const std::string& eventName, cons
 
 void ToneFire::StudioSound::SetEventPosition(const std::string& eventName, const FMOD_VECTOR& pos)
 {
+	if (!Enabled)
+		return;
 	if (_bankEventDescriptions[eventName] == nullptr)
 		LoadEvent(eventName);
 	FMOD_3D_ATTRIBUTES atr;
@@ -161,6 +161,10 @@ namespace ToneFire {
 
 		FMOD_VECTOR forward = { 0.0f,0.0f,1.0f };
 		FMOD_VECTOR up = { 0.0f,1.0f,0.0f };
+
+		//When false, every call on a StudioSound is ignored. Lets us run without
+		//any banks loaded (ex: hidden window benchmarks)
+		inline static bool Enabled = true;
 	private:
 
 		FMOD_VECTOR _velocity; // not yet implemented
@@ -7,6 +7,8 @@
 void BackgroundMover::Awake()
 {
     _body = GetComponent<Gameplay::Physics::RigidBody>();
+    // We're recycled once we fall behind the view, which can only happen if we keep updating outside the activation region
+    GetGameObject()->AlwaysActive = true;
 
 }
 
@@ -35,13 +37,18 @@ BackgroundMover::Sptr BackgroundMover::FromJson(const nlohmann::json & blob) {
 
 void BackgroundMover::Update(float deltaTime)
 {
+    // Drift left of the view at 5.5 units a second on top of the scroll, and wrap back ahead of it once we're 25 units behind
+    Gameplay::Scene* scene = GetGameObject()->GetScene();
+    float viewX = scene->IsWorldScrollEnabled() ? scene->GetWorldScrollOffset().x : 0.0f;
+    float scrollX = scene->IsWorldScrollEnabled() ? scene->GetWorldScrollVelocity().x : 0.0f;
+
     glm::vec3 current = GetGameObject()->GetPosition();
-    current.x -= 5.5 * deltaTime;
+    current.x += (scrollX - 5.5f) * deltaTime;
     GetGameObject()->SetPostion(current);
 
-    if (GetGameObject()->GetPosition().x <= -25.0f)
+    if (GetGameObject()->GetPosition().x - viewX <= -25.0f)
     {
-        GetGameObject()->SetPostion(glm::vec3(glm::vec3(25.870f, 7.80f, 2.7f)));
+        GetGameObject()->SetPostion(glm::vec3(glm::vec3(25.870f + viewX, 7.80f, 2.7f)));
     }
 }
 
@@ -51,6 +58,8 @@ void BackgroundMover::Update(float deltaTime)
 void BackgroundBuildingMover::Awake()
 {
     _body = GetComponent<Gameplay::Physics::RigidBody>();
+    // Buildings drift out of the activation region long before they wrap, so they have to stay awake to come back
+    GetGameObject()->AlwaysActive = true;
 
 }
 
@@ -87,12 +96,17 @@ void BackgroundBuildingMover::Update(float deltaTime)
     BuildObjY = GetGameObject()->GetPosition().y;
     BuildObjZ = GetGameObject()->GetPosition().z;
 
-    BuildObjPosX = BuildObjPosX - 0.5 * deltaTime;
+    // The buildings sit far back, so they only creep left of the view before wrapping back ahead of it
+    Gameplay::Scene* scene = GetGameObject()->GetScene();
+    float viewX = scene->IsWorldScrollEnabled() ? scene->GetWorldScrollOffset().x : 0.0f;
+    float scrollX = scene->IsWorldScrollEnabled() ? scene->GetWorldScrollVelocity().x : 0.0f;
+
+    BuildObjPosX = BuildObjPosX + (scrollX - 0.5f) * deltaTime;
     
     GetGameObject()->SetPostion(glm::vec3(BuildObjPosX, BuildObjY, BuildObjZ));
 
-    if (GetGameObject()->GetPosition().x <= -55.0f)
+    if (GetGameObject()->GetPosition().x - viewX <= -55.0f)
     {
-        GetGameObject()->SetPostion(glm::vec3(glm::vec3(40.870f, 21.880f, -46.040f)));
+        GetGameObject()->SetPostion(glm::vec3(glm::vec3(40.870f + viewX, 21.880f, -46.040f)));
     }
 }
\ No newline at end of file
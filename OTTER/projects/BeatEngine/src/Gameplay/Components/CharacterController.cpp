@@ -84,7 +84,7 @@ using namespace Gameplay::Physics;
         }
     }
 
-    LOG_INFO("Body has entered our trigger volume: {}", _PlatformName);
+    LOG_TRACE("Body has entered our trigger volume: {}", _PlatformName);
     if ((_PlatformName == "Vinyl") || (_PlatformName == "CD") || (_PlatformName == "BeatGem")) {
         _CoyoteTimeUsed = true;
     }
@@ -145,7 +145,7 @@ using namespace Gameplay::Physics;
     if (_PlatformName == "Half Circle Platform") {
         _rotPlat = (_body->GetGameObject()->GetPosition()) - body->GetGameObject()->GetPosition();
         body->GetGameObject()->SetRotation(body->GetGameObject()->GetRotationEuler() + glm::vec3(0.0f, -20 * _rotPlat.x, 0.0f));
-        LOG_INFO(_rotPlat.x);
+        LOG_TRACE(_rotPlat.x);
     }
 
 
@@ -163,7 +163,7 @@ using namespace Gameplay::Physics;
 void CharacterController::OnTriggerVolumeLeaving(const std::shared_ptr<RigidBody>& body) {
     //player is no longer on platform
     _LastBodyCollided = nullptr;
-    LOG_INFO("Body has left our trigger volume: {}", body->GetGameObject()->Name);
+    LOG_TRACE("Body has left our trigger volume: {}", body->GetGameObject()->Name);
     //reset rotation 
     if (body->GetGameObject()->Name == "Half Circle Platform") {
         body->GetGameObject()->SetRotation(glm::vec3(-90.000f, 0.0f, 180.0f));
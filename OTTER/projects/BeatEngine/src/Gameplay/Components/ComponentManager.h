@@ -189,12 +189,14 @@ namespace Gameplay {
 		/// Iterates over all components of the given type and invokes a method with them
 		/// </summary>
 		/// <typeparam name="ComponentType">The type of component to iterate on</typeparam>
+		/// <typeparam name="Callback">The type of callback, taken as a template so that lambda captures don't need to be copied into a std::function every call</typeparam>
 		/// <param name="callback">The callback to invoke with the components</param>
 		/// <param name="includeDisabled">True to include disabled components, false if otherwise</param>
 		template <
 			typename ComponentType,
+			typename Callback,
 			typename = typename std::enable_if<std::is_base_of<IComponent, ComponentType>::value>::type>
-		void Each(std::function<void(const std::shared_ptr<ComponentType>&)> callback, bool includeDisabled = false) {
+		void Each(Callback&& callback, bool includeDisabled = false) {
 			// We can use typeid and type_index to get a unique ID for our types
 			std::type_index type = std::type_index(typeid(ComponentType));
 			LOG_ASSERT(_TypeLoadRegistry[type] != nullptr, "You must register component types before creating them!");
@@ -7,6 +7,8 @@
 void ForeGroundMover::Awake()
 {
     _body = GetComponent<Gameplay::Physics::RigidBody>();
+    // We drive past the camera and only restart from the far side if we keep updating while out of range
+    GetGameObject()->AlwaysActive = true;
 
 }
 
@@ -53,11 +55,16 @@ void ForeGroundMover::Update(float deltaTime)
          GetGameObject()->SetPostion(glm::vec3(BObjPosX, ObjY, ObjZ));
       }*/
 
-    BObjPosX = BObjPosX + 15.0 * deltaTime;
+    // Drive right, against the scroll, and wrap back to the left of the view once we've passed it
+    Gameplay::Scene* scene = GetGameObject()->GetScene();
+    float viewX = scene->IsWorldScrollEnabled() ? scene->GetWorldScrollOffset().x : 0.0f;
+    float scrollX = scene->IsWorldScrollEnabled() ? scene->GetWorldScrollVelocity().x : 0.0f;
+
+    BObjPosX = BObjPosX + (scrollX + 15.0f) * deltaTime;
     GetGameObject()->SetPostion(glm::vec3(BObjPosX, ObjY, ObjZ));
 
-    if (GetGameObject()->GetPosition().x >= 40.0f)
+    if (GetGameObject()->GetPosition().x - viewX >= 40.0f)
     {
-        GetGameObject()->SetPostion(glm::vec3(glm::vec3(-20.970f, 0.470f, -3.90f)));
+        GetGameObject()->SetPostion(glm::vec3(glm::vec3(-20.970f + viewX, 0.470f, -3.90f)));
     }
 }
\ No newline at end of file
@@ -11,7 +11,8 @@ GuiPanel::GuiPanel() :
 	_texture(nullptr),
 	_transform(nullptr),
 	_percentOfScreenX(1.0f),
-	_percentOfScreenY(1.0f)
+	_percentOfScreenY(1.0f),
+	_layoutWindowSize(0, 0)
 	//_width(width),
 	//_height(height)
 
@@ -26,13 +27,17 @@ GuiPanel::GuiPanel(float perX, float perY, float width, float height) :
 	_percentOfScreenX(perX),
 	_percentOfScreenY(perY),
 	_width(width),
-	_height(height)
+	_height(height),
+	_layoutWindowSize(0, 0)
 { }
 
 GuiPanel::~GuiPanel() = default;
 
 void GuiPanel::SetColor(const glm::vec4 & color) {
-	_color = color;
+	if (color != _color) {
+		_color = color;
+		_MarkGuiDirty();
+	}
 }
 
 const glm::vec4& GuiPanel::GetColor() const {
@@ -44,7 +49,10 @@ int GuiPanel::GetBorderRadius() const {
 }
 
 void GuiPanel::SetBorderRadius(int value) {
-	_borderRadius = value;
+	if (value != _borderRadius) {
+		_borderRadius = value;
+		_MarkGuiDirty();
+	}
 }
 
 Texture2D::Sptr GuiPanel::GetTexture() const {
@@ -52,7 +60,10 @@ Texture2D::Sptr GuiPanel::GetTexture() const {
 }
 
 void GuiPanel::SetTexture(const Texture2D::Sptr & value) {
-	_texture = value;
+	if (value != _texture) {
+		_texture = value;
+		_MarkGuiDirty();
+	}
 }
 
 void GuiPanel::Awake() {
@@ -71,6 +82,8 @@ void GuiPanel::Awake() {
 		LOG_WARN("Failed to find a rect transform for a GUI panel, disabling");
 	}
 
+	// Pack our texture into the GUI atlas now, rather than the first time we're drawn
+	GuiBatcher::PreloadTexture(_texture != nullptr ? _texture : GuiBatcher::GetDefaultTexture());
 }
 
 void GuiPanel::StartGUI() {
@@ -85,22 +98,29 @@ void GuiPanel::FinishGUI() {
 
 void GuiPanel::RenderImGui()
 {
-	LABEL_LEFT(ImGui::ColorEdit4, "Color ", &_color.x);
-	LABEL_LEFT(ImGui::DragInt, "Radius", &_borderRadius, 1, 0, 128);
+	bool changed = LABEL_LEFT(ImGui::ColorEdit4, "Color ", &_color.x);
+	changed |= LABEL_LEFT(ImGui::DragInt, "Radius", &_borderRadius, 1, 0, 128);
+	if (changed) {
+		_MarkGuiDirty();
+	}
 }
 
 void GuiPanel::Update(float deltaTime) {
 
-	//Get Window Size
+	//Get Window Size, our layout only needs to be recalculated when it changes
 	Application& app = Application::Get();
-	glm::vec2 windowSize = app.GetWindowSize();
+	if (app.GetWindowSize() == _layoutWindowSize) {
+		return;
+	}
+	_layoutWindowSize = app.GetWindowSize();
+	glm::vec2 windowSize = _layoutWindowSize;
 
 	//Update the GUI to dynamically move to the correct percent position of the screen. For example, an element dead center (50%, 50%) on a 1080p screen will stay centered when rescaled to 4k 
-	GetGameObject()->Get<RectTransform>()->SetPosition({ windowSize.x * _percentOfScreenX, windowSize.y * _percentOfScreenY });
+	_transform->SetPosition({ windowSize.x * _percentOfScreenX, windowSize.y * _percentOfScreenY });
 
 	//Use the proptortion relative to a 1920/1080 screen to properly scale it to their screen size
 	//For some reason windowSize returns a value ~4x larger than it should be? Jank fix for now
-	GetGameObject()->Get<RectTransform>()->SetSize({ (_proportionX / 4) * windowSize.x, (_proportionY / 4) * windowSize.y });
+	_transform->SetSize({ (_proportionX / 4) * windowSize.x, (_proportionY / 4) * windowSize.y });
 
 }
 
@@ -66,6 +66,8 @@ private:
 	float _height;
 	float _proportionX;
 	float _proportionY;
+	// The window size that our rect was last laid out for
+	glm::ivec2 _layoutWindowSize;
 
 protected:
 	int             _borderRadius;
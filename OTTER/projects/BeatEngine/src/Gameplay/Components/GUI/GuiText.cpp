@@ -1,22 +1,20 @@
 #include "Gameplay/Components/GUI/GuiText.h"
-#include <locale>
-#include <codecvt>
 #include <string>
 #include "Graphics/GuiBatcher.h"
 #include "Utils/ImGuiHelper.h"
 #include "Utils/JsonGlmHelpers.h"
+#include "Utils/StringUtils.h"
 #include "Gameplay/GameObject.h"
 #include "Application/application.h"
 
-std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> StringConvert;
-
 GuiText::GuiText() :
 	IComponent(),
 	_text(LR"()"), // The LR and parenthesis tell us it's a unicode string (wide string)
 	_color(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)),
 	_font(nullptr),
 	_textSize(glm::vec2(0.0f)),
-	_textScale(4.0f)
+	_textScale(4.0f),
+	_layoutWindowSize(0, 0)
 { }
 
 GuiText::GuiText(float perX, float perY, float scale) :
@@ -29,13 +27,17 @@ GuiText::GuiText(float perX, float perY, float scale) :
 
 	_percentOfScreenX(perX),
 	_percentOfScreenY(perY),
-	_scale(scale)
+	_scale(scale),
+	_layoutWindowSize(0, 0)
 { }
 
 GuiText::~GuiText() = default;
 
 void GuiText::SetColor(const glm::vec4& color) {
-	_color = color;
+	if (color != _color) {
+		_color = color;
+		_MarkGuiDirty();
+	}
 }
 
 const glm::vec4& GuiText::GetColor() const {
@@ -43,11 +45,14 @@ const glm::vec4& GuiText::GetColor() const {
 }
 
 std::string GuiText::GetText() const {
-	return StringConvert.to_bytes(_text);
+	return StringTools::UnicodeToUtf8(_text);
 }
 
 void GuiText::SetText(const std::string& value) {
-	SetTextUnicode(StringConvert.from_bytes(value));
+	// This gets called every frame for things like score counters, so decode into a buffer we keep around
+	static std::wstring unicode;
+	StringTools::Utf8ToUnicode(value, unicode);
+	SetTextUnicode(unicode);
 }
 
 const std::wstring& GuiText::GetTextUnicode() const {
@@ -55,11 +60,12 @@ const std::wstring& GuiText::GetTextUnicode() const {
 }
 
 void GuiText::SetTextUnicode(const std::wstring& value) {
-	_text = value;
-	
-	if (_font != nullptr) {
-		_textSize = _font->MeausureString(_text, _textScale);
+	if (value == _text) {
+		return;
 	}
+	_text = value;
+	_UpdateLayout();
+	_MarkGuiDirty();
 }
 
 const float GuiText::GetTextScale() const {
@@ -67,7 +73,12 @@ const float GuiText::GetTextScale() const {
 }
 
 void GuiText::SetTextScale(float value) {
+	if (value == _textScale) {
+		return;
+	}
 	_textScale = value;
+	_UpdateLayout();
+	_MarkGuiDirty();
 }
 
 const Font::Sptr& GuiText::GetFont() const {
@@ -76,9 +87,14 @@ const Font::Sptr& GuiText::GetFont() const {
 
 void GuiText::SetFont(const Font::Sptr& font) {
 	_font = font;
-	if (_font != nullptr) {
-		_textSize = _font->MeausureString(_text, _textScale);
-	}
+	_UpdateLayout();
+	_MarkGuiDirty();
+}
+
+void GuiText::_UpdateLayout() {
+	// The run is in font units, so a change in scale doesn't need a new layout
+	_glyphRun.SetText(_text, _font);
+	_textSize = _glyphRun.GetSize() * _textScale;
 }
 
 void GuiText::Awake() {
@@ -87,34 +103,38 @@ void GuiText::Awake() {
 		IsEnabled = false;
 		LOG_WARN("Failed to find a rect transform for a GUI panel, disabling");
 	}
+
+	// Pack the font into the GUI atlas now, rather than the first time we're drawn
+	GuiBatcher::PreloadFont(_font);
 }
 
 void GuiText::RenderGUI()
 {
 	if (_font != nullptr && !_text.empty()) {
+		// Only lays anything out if the text was changed without going through a setter
+		_UpdateLayout();
+
 		glm::vec2 position = _transform->GetSize() / 2.0f;
 		position -= _textSize / 2.0f;
-		GuiBatcher::RenderText(_text, _font, position, _color, _textScale);
+		GuiBatcher::RenderText(_glyphRun, position, _color, _textScale);
 	}
 }
 
 void GuiText::RenderImGui()
 {
 	static char buffer[4096];
-	std::string ascii = StringConvert.to_bytes(_text);
+	std::string ascii = StringTools::UnicodeToUtf8(_text);
 	memcpy(buffer, ascii.data(), ascii.size());
 
 	if (LABEL_LEFT(ImGui::InputTextMultiline, "Text", buffer, 4096)) {
-		_text = StringConvert.from_bytes(buffer);
-		if (_font != nullptr) {
-			_textSize = _font->MeausureString(_text, _textScale);
-		}
+		SetText(buffer);
+	}
+	if (LABEL_LEFT(ImGui::ColorEdit4, "Color", &_color.x)) {
+		_MarkGuiDirty();
 	}
-	LABEL_LEFT(ImGui::ColorEdit4, "Color", &_color.x);
-	if (LABEL_LEFT(ImGui::DragFloat, "Scale", &_textScale, 0.01f)) {
-		if (_font != nullptr) {
-			_textSize = _font->MeausureString(_text, _textScale);
-		}
+	float scale = _textScale;
+	if (LABEL_LEFT(ImGui::DragFloat, "Scale", &scale, 0.01f)) {
+		SetTextScale(scale);
 	}
 }
 
@@ -134,12 +154,16 @@ void GuiText::Update(float deltaTime) {
 	if (GetGameObject()->GetScene()->FindObjectByName("Character") != nullptr) {
 		GetGameObject()->GetScene()->FindObjectByName("HUD Score Text")->Get<GuiText>()->SetText(std::to_string(Application::GetScore()));
 	}
-	//Get Window Size
+	//Get Window Size, our layout only needs to be recalculated when it changes
 	Application& app = Application::Get();
-	glm::vec2 windowSize = app.GetWindowSize();
+	if (app.GetWindowSize() == _layoutWindowSize) {
+		return;
+	}
+	_layoutWindowSize = app.GetWindowSize();
+	glm::vec2 windowSize = _layoutWindowSize;
 
 	//Update the GUI to dynamically move to the correct percent position of the screen. For example, an element dead center (50%, 50%) on a 1080p screen will stay centered when rescaled to 4k 
-	GetGameObject()->Get<RectTransform>()->SetPosition({ windowSize.x * _percentOfScreenX, windowSize.y * _percentOfScreenY });
+	_transform->SetPosition({ windowSize.x * _percentOfScreenX, windowSize.y * _percentOfScreenY });
 	SetTextScale((_scale /1080) * windowSize.y );
 
 }
@@ -2,6 +2,7 @@
 #include "Gameplay/Components/IComponent.h"
 #include "Gameplay/Components/GUI/RectTransform.h"
 #include "Graphics/Font.h"
+#include "Graphics/GlyphRun.h"
 
 /// <summary>
 /// Renders text for UI components
@@ -84,6 +85,13 @@ private:
 	float _percentOfScreenY;
 	float _scale;
 	std::string _score;
+	// The window size that our rect was last laid out for
+	glm::ivec2 _layoutWindowSize;
+	// The laid out glyphs for our text, only the characters that change are laid out again
+	GlyphRun _glyphRun;
+
+	// Updates the glyph run and text size to match our text, font and scale
+	void _UpdateLayout();
 
 protected:
 	std::wstring    _text;
@@ -22,8 +22,11 @@ const glm::vec2& RectTransform::GetPosition() const {
 	return _position;
 }
 void RectTransform::SetPosition(const glm::vec2& pos) {
-	_position = pos;
-	_transformDirty = true;
+	if (pos != _position) {
+		_position = pos;
+		_transformDirty = true;
+		_MarkGuiDirty(true);
+	}
 }
 
 glm::vec2 RectTransform::GetMin() const {
@@ -36,6 +39,7 @@ void RectTransform::SetMin(const glm::vec2& value)
 	_halfSize = newSize / 2.0f;
 	_position = value + _halfSize;
 	_transformDirty = true;
+	_MarkGuiDirty(true);
 }
 
 glm::vec2 RectTransform::GetMax() const {
@@ -46,17 +50,28 @@ void RectTransform::SetMax(const glm::vec2& value) {
 	_halfSize = newSize / 2.0f;
 	_position = value - _halfSize;
 	_transformDirty = true;
+	_MarkGuiDirty(true);
 }
 
 glm::vec2 RectTransform::GetSize() const {
 	return _halfSize * 2.0f;
 }
 void RectTransform::SetSize(const glm::vec2& value) {
-	_halfSize = value * 2.0f;
+	glm::vec2 halfSize = value * 2.0f;
+	if (halfSize != _halfSize) {
+		_halfSize = halfSize;
+		_transformDirty = true;
+		_MarkGuiDirty(true);
+	}
 }
 
 void RectTransform::SetRotationDeg(float value) {
-	_rotation = glm::radians(value);
+	float rotation = glm::radians(value);
+	if (rotation != _rotation) {
+		_rotation = rotation;
+		_transformDirty = true;
+		_MarkGuiDirty(true);
+	}
 }
 
 float RectTransform::GetRotationDeg() const {
@@ -70,11 +85,13 @@ const glm::mat3& RectTransform::GetLocalTransform() const {
 
 void RectTransform::RenderImGui()
 {
-	_transformDirty |= LABEL_LEFT(ImGui::DragFloat2, "Position", &_position.x, 0.01f);
+	if (LABEL_LEFT(ImGui::DragFloat2, "Position", &_position.x, 0.01f)) {
+		_transformDirty = true;
+		_MarkGuiDirty(true);
+	}
 	float degrees = glm::degrees(_rotation);
 	if (LABEL_LEFT(ImGui::DragFloat, "Rotation", &degrees, 0.1f)) {
-		_transformDirty = true;
-		_rotation = glm::radians(degrees);
+		SetRotationDeg(degrees);
 	}
 	glm::vec2 temp = GetSize();
 	if (LABEL_LEFT(ImGui::DragFloat2, "Size    ", &temp.x, 0.1f)) {
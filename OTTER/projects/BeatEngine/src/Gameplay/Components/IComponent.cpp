@@ -12,6 +12,12 @@ namespace Gameplay {
 		return _weakSelfPtr;
 	}
 
+	void IComponent::_MarkGuiDirty(bool includeChildren) {
+		if (_context != nullptr) {
+			_context->MarkGuiDirty(includeChildren);
+		}
+	}
+
 	void IComponent::LoadBaseJson(const Sptr& result, const nlohmann::json& blob)
 	{
 		result->OverrideGUID(Guid(blob["guid"]));
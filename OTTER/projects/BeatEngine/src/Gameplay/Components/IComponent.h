@@ -156,6 +156,13 @@ namespace Gameplay {
 	protected:
 		IComponent();
 
+		/// <summary>
+		/// Lets the gameobject know that the GUI this component draws has changed and needs to be rebuilt,
+		/// does nothing if we haven't been attached yet
+		/// </summary>
+		/// <param name="includeChildren">True if the change affects the children as well, ex: moving a rect transform</param>
+		void _MarkGuiDirty(bool includeChildren = false);
+
 	private:
 		friend class ComponentManager;
 		friend class GameObject;
@@ -79,6 +79,21 @@ void LevelMover::OnLeavingTrigger(const std::shared_ptr<Gameplay::Physics::Trigg
 
 void LevelMover::Update(float deltaTime)
 {
+    Gameplay::Scene* scene = GetGameObject()->GetScene();
+
+    // When the world scrolls the view moves past us instead, so we can stay put 
+    // and only need to check if we've fallen behind
+    if (scene->IsWorldScrollEnabled()) {
+        // The lerp starts _timer seconds along it's path, so we shift by that lead once to
+        // keep objects lined up with the beat the same way they were when they moved
+        if (_timer > 0.0f) {
+            glm::vec3 position = GetGameObject()->GetPosition();
+            GetGameObject()->SetPostion(glm::vec3(position.x - _timer * _speed, position.y, position.z));
+            _timer = 0.0f;
+        }
+        _CheckBehindView(GetGameObject()->GetPosition().x - scene->GetWorldScrollOffset().x);
+        return;
+    }
 
     // Object with behavior attached Y and Z position
     ObjY = GetGameObject()->GetPosition().y;
@@ -108,8 +123,13 @@ void LevelMover::Update(float deltaTime)
         keyframe++;
     }
 
+    _CheckBehindView(GetGameObject()->GetPosition().x);
+}
+
+void LevelMover::_CheckBehindView(float viewX)
+{
     Gameplay::GameObject::Sptr context = GetGameObject()->SelfRef();
-    if (GetGameObject()->GetPosition().x <= -25.f && !inTrigger) {
+    if (viewX <= -25.f && !inTrigger) {
         auto BeatGemsUsed = GetGameObject()->GetScene()->FindObjectByName("Character/Player")->Get<CharacterController>()->GetBeatGemsUsed();
         if (GetGameObject()->Has<BeatGem>()&& !BeatGemsUsed.empty()) {
           BeatGemsUsed.pop_back();
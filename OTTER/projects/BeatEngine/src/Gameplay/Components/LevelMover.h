@@ -49,4 +49,6 @@ protected:
 	float ObjZ;
 	float ObjX;
 
+	// Removes the object once it has scrolled off screen, x is relative to the view
+	void _CheckBehindView(float viewX);
 };
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include "Application/Application.h"
 #include "Utils/ImGuiHelper.h"
 #include "Graphics/DebugDraw.h"
+#include "Graphics/GpuProfiler.h"
+#include "Utils/MemoryTracker.h"
+#include "Utils/FrameArena.h"
 #include "imgui_internal.h"
 
 ParticleSystem::ParticleSystem() :
@@ -30,6 +33,7 @@ ParticleSystem::~ParticleSystem()
 		glDeleteBuffers(2, _particleBuffers);
 		glDeleteTransformFeedbacks(2, _feedbackBuffers);
 		glDeleteQueries(1, &_query);
+		MemoryTracker::ReleaseGpuAllocation(this);
 		_updateShader = nullptr;
 		_renderShader = nullptr;
 	}
@@ -105,12 +109,16 @@ void ParticleSystem::Update()
 
 		// We create a query object to track the number of particles we're simulating
 		glGenQueries(1, &_query);
+
+		// Our buffers are raw GL handles, so we report them to the memory tracker ourselves
+		MemoryTracker::SetGpuAllocation(this, "ParticleSystem", GetGameObject()->Name, dataSize * 2);
 	}
 
 	if (_needsResize) {
 		size_t dataSize = (_maxParticles + _emitters.size()) * sizeof(ParticleData);
 		glNamedBufferData(_particleBuffers[0], dataSize, nullptr, GL_DYNAMIC_DRAW);
 		glNamedBufferData(_particleBuffers[1], dataSize, nullptr, GL_DYNAMIC_DRAW);
+		MemoryTracker::SetGpuAllocation(this, "ParticleSystem", GetGameObject()->Name, dataSize * 2);
 		_needsUpload = true;
 		_needsResize = false;
 	}
@@ -118,10 +126,9 @@ void ParticleSystem::Update()
 	if (_needsUpload) {
 		glBindVertexArray(0);
 
-		// Allocate some temp space for particles, so we can init the emitters
+		// Grab some temp space for particles from the frame arena, so we can init the emitters
 		size_t dataSize = (_emitters.size()) * sizeof(ParticleData);
-		ParticleData* data = new ParticleData[_emitters.size()];
-		memset(data, 0, dataSize);
+		ParticleData* data = FrameArena::Allocate<ParticleData>(_emitters.size());
 
 		// Add all emitter to the the particle list at the beginning
 		for (int ix = 0; ix < _emitters.size(); ix++) {
@@ -132,9 +139,6 @@ void ParticleSystem::Update()
 		for (int ix = 0; ix < 2; ix++) {
 			glNamedBufferSubData(_particleBuffers[ix], 0, dataSize, data);
 		}
-
-		// We no longer need the CPU copy
-		delete[] data;
 	}
 
 	// Disable rasterization, this is update only
@@ -163,6 +167,7 @@ void ParticleSystem::Update()
 	else {
 		glDrawTransformFeedback(GL_POINTS, _feedbackBuffers[_currentVertexBuffer]);
 	}
+	GpuProfiler::CountDraw(DrawMode::Points, _numParticles + (uint32_t)_emitters.size());
 
 	// End of transform feedback
 	glEndTransformFeedback();
@@ -227,6 +232,7 @@ void ParticleSystem::Render()
 
 		// Draw our particles using whatever data we have in transform feedback buffer
 		glDrawTransformFeedback(GL_POINTS, _feedbackBuffers[_currentVertexBuffer]);
+		GpuProfiler::CountDraw(DrawMode::Points, _numParticles);
 
 		glBindVertexArray(0);
 
@@ -281,7 +287,7 @@ void ParticleSystem::RenderImGui()
 
 		ImGui::PushID(&emitter);
 		static char buffer[255];
-		sprintf_s(buffer, "%s###Emitter", (~emitter.Type).c_str());
+		snprintf(buffer, sizeof(buffer), "%s###Emitter", (~emitter.Type).c_str());
 		ImGuiID id = ImGui::GetID(buffer);
 		bool open = ImGui::CollapsingHeader(buffer, ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_AllowItemOverlap | ImGuiTreeNodeFlags_ClipLabelForTrailingButton);
 
@@ -36,9 +36,6 @@ void ShadowCamera::SetShadowIntensity(float value) {
 void ShadowCamera::SetBufferResolution(const glm::ivec2& value) {
 	LOG_ASSERT(value.x * value.y > 0, "Buffer size must be > 0");
 	_bufferResolution = value;
-	if (_depthBuffer != nullptr) {
-		_depthBuffer->Resize(value);
-	}
 }
 
 const glm::ivec2& ShadowCamera::GetBufferResolution() const {
@@ -69,18 +66,6 @@ const Texture2D::Sptr& ShadowCamera::GetProjectionMask() const {
 	return _projectionMask;
 }
 
-void ShadowCamera::OnLoad()
-{
-	LOG_ASSERT(_bufferResolution.x * _bufferResolution.y > 0, "Buffer size must be > 0");
-
-	FramebufferDescriptor desc;
-	desc.Width  = _bufferResolution.x;
-	desc.Height = _bufferResolution.y;
-	desc.RenderTargets[RenderTargetAttachment::Depth] = RenderTargetDescriptor(RenderTargetType::Depth32);
-
-	_depthBuffer = std::make_shared<Framebuffer>(desc);
-}
-
 nlohmann::json ShadowCamera::ToJson() const
 {
 	return {
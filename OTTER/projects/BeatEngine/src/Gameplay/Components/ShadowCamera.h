@@ -47,7 +47,7 @@ public:
 	void SetShadowIntensity(float value);
 
 	/// <summary>
-	/// Resizes this light's depth buffer, both dimensions must be non-zero
+	/// Sets the resolution of this light's depth buffer, both dimensions must be non-zero
 	/// </summary>
 	/// <param name="value">The new size of the buffer, in pixels</param>
 	void SetBufferResolution(const glm::ivec2& value);
@@ -82,20 +82,22 @@ public:
 	const Texture2D::Sptr& GetProjectionMask() const;
 
 	/// <summary>
-	/// Gets the shadow camera's depth buffer that it renders to
+	/// Gets the depth buffer that the shadow camera was last rendered to. Shadow maps are transient targets in the
+	/// render graph, so lights with the same resolution share a buffer, and this is only meant for debug views
 	/// </summary>
 	const Framebuffer::Sptr& GetDepthBuffer() const;
 
 	// Inherited from IComponent
 
-	virtual void OnLoad();
 	virtual void RenderImGui() override;
 	virtual nlohmann::json ToJson() const override;
 	static ShadowCamera::Sptr FromJson(const nlohmann::json& data);
 	MAKE_TYPENAME(ShadowCamera);
 
 protected:
-	// Framebuffer we render into to get depth
+	friend class RenderLayer;
+
+	// Framebuffer we last rendered into to get depth, handed to us by the render layer
 	Framebuffer::Sptr _depthBuffer;
 	// The image to project from this light
 	Texture2D::Sptr   _projectionMask;
@@ -35,6 +35,11 @@ SpawnLoop::SpawnLoop() {
 }
 void SpawnLoop::Awake() {
 
+	if (!_IsSeedPinned) {
+		_Seed = std::random_device()();
+	}
+	_Random.seed(_Seed);
+
 	nlohmann::ordered_json data = ResourceManager::GetManifest();
 
 	CreateList(data);
@@ -162,7 +167,8 @@ void SpawnLoop::SpawnBlock() {
 	Application& app = Application::Get();
 	Gameplay::Scene::Sptr scene = app.CurrentScene();
 
-	float distanceFromBlock = 30.0;
+	// Blocks are laid out relative to the view, so account for any world scrolling
+	float distanceFromBlock = 30.0 + scene->GetWorldScrollOffset().x;
 
 	switch (_BlockToSpawn) {
 	case 0:
@@ -425,10 +431,20 @@ void SpawnLoop::SpawnBlock() {
 
 void SpawnLoop::ToSpawn() {
 	_SpawnTimer -= 30;
-	_BlockToSpawn = rand() % 10;
+	// We use the raw engine output rather than a distribution, since distributions can differ between standard libraries
+	_BlockToSpawn = _Random() % 10;
 	SpawnBlock();
 }
 
+void SpawnLoop::SetSeed(uint32_t seed) {
+	_Seed = seed;
+	_IsSeedPinned = true;
+}
+
+uint32_t SpawnLoop::GetSeed() {
+	return _Seed;
+}
+
 void SpawnLoop::RenderImGui(){
 	//ImGui::Text("Difficulty:   %s", "Easy");
 	//ImGui::Separator();
@@ -5,6 +5,7 @@
 #include "Gameplay/MeshResource.h"
 #include "Application/Layers/SpawnFunctions.h"
 #include "Utils/FileHelpers.h"
+#include <random>
 
 //Meant to be a singleton class please ONLY add this to the GameManager GameObject
 class SpawnLoop : public Gameplay::IComponent
@@ -34,6 +35,12 @@ public:
 	void SpawnBlock();
 	void CreateList(const nlohmann::json&);
 
+	// Pins the seed used to pick which blocks get spawned, so that runs can be replayed exactly.
+	// When no seed is pinned, every level load picks a new one
+	static void SetSeed(uint32_t seed);
+	// Gets the seed that the most recent level load used
+	static uint32_t GetSeed();
+
 	virtual void RenderImGui() override;
 	MAKE_TYPENAME(SpawnLoop);
 
@@ -47,6 +54,10 @@ private:
 	int _BlockToSpawn;
 	float _SpawnTimer = 0;
 	bool _isDirty=false;
+	std::mt19937 _Random;
+
+	inline static uint32_t _Seed = 0;
+	inline static bool _IsSeedPinned = false;
 
 	//This is Disgusting.
 	
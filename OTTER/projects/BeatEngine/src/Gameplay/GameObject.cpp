@@ -2,6 +2,7 @@
 
 // Utilities
 #include "Utils/JsonGlmHelpers.h"
+#include "Utils/Profiler.h"
 
 // GLM
 #define GLM_ENABLE_EXPERIMENTAL
@@ -20,6 +21,7 @@ namespace Gameplay {
 		IResource(),
 		Name("Unknown"),
 		HideInHierarchy(false),
+		AlwaysActive(false),
 		_components(std::vector<IComponent::Sptr>()),
 		_scene(nullptr),
 		_position(ZERO),
@@ -31,6 +33,12 @@ namespace Gameplay {
 		_worldTransform(MAT4_IDENTITY),
 		_inverseWorldTransform(MAT4_IDENTITY),
 		_isWorldTransformDirty(true),
+		_isPhysicsTransformDirty(true),
+		_isDormant(false),
+		_guiCache(),
+		_guiEnabledMask(0),
+		_isGuiDirty(true),
+		_isGuiChildrenDirty(false),
 		_parent(WeakRef()),
 		_children(std::vector<WeakRef>())
 	{ }
@@ -116,6 +124,7 @@ namespace Gameplay {
 	void GameObject::SetPostion(const glm::vec3& position) {
 		_position = position;
 		_isLocalTransformDirty = true;
+		_isPhysicsTransformDirty = true;
 	}
 
 	const glm::vec3& GameObject::GetPosition() const {
@@ -129,6 +138,7 @@ namespace Gameplay {
 	void GameObject::SetRotation(const glm::quat& value) {
 		_rotation = value;
 		_isLocalTransformDirty = true;
+		_isPhysicsTransformDirty = true;
 	}
 
 	const glm::quat& GameObject::GetRotation() const {
@@ -138,12 +148,21 @@ namespace Gameplay {
 	void GameObject::SetRotation(const glm::vec3& eulerAngles) {
 		_rotation = glm::quat(glm::radians(eulerAngles));
 		_isLocalTransformDirty = true;
+		_isPhysicsTransformDirty = true;
 	}
 
 	glm::vec3 GameObject::GetRotationEuler() const {
 		return glm::degrees(glm::eulerAngles(_rotation));
 	}
 
+	bool GameObject::IsPhysicsTransformDirty() const {
+		return _isPhysicsTransformDirty;
+	}
+
+	void GameObject::ClearPhysicsTransformDirty() {
+		_isPhysicsTransformDirty = false;
+	}
+
 	void GameObject::SetScale(const glm::vec3& value) {
 		_scale = value;
 		_isLocalTransformDirty = true;
@@ -175,15 +194,68 @@ namespace Gameplay {
 	}
 
 	void GameObject::RenderGUI() {
+		if (_CheckGuiDirty()) {
+			_RenderGUI(false);
+		}
+		else {
+			GuiBatcher::DrawCache(_guiCache);
+		}
+	}
+
+	void GameObject::MarkGuiDirty(bool includeChildren) {
+		_isGuiDirty = true;
+		_isGuiChildrenDirty |= includeChildren;
+	}
+
+	bool GameObject::_CheckGuiDirty() {
+		// Objects without a rect transform don't draw, and neither do their children
+		if (!Has<RectTransform>()) {
+			return false;
+		}
+
 		// Prune children
 		auto it = std::remove_if(_children.begin(), _children.end(), [](const WeakRef& child) { return !child.IsAlive(); });
 		if (it != _children.end()) {
-			_children.erase(it);
+			_children.erase(it, _children.end());
+			_isGuiDirty = true;
 		}
 
+		// Components can be enabled or disabled at any time, so compare against what was enabled when we were built
+		uint64_t enabledMask = 0;
+		for (size_t ix = 0; ix < _components.size() && ix < 64; ix++) {
+			enabledMask |= _components[ix]->IsEnabled ? (1ull << ix) : 0;
+		}
+		if (enabledMask != _guiEnabledMask) {
+			_guiEnabledMask = enabledMask;
+			_isGuiDirty = true;
+		}
+
+		if (!_guiCache.IsValid()) {
+			_isGuiDirty = true;
+		}
+
+		// A dirty child means our cache is out of date as well, every child is checked so that their state is updated
+		for (auto& child : _children) {
+			_isGuiDirty |= child->_CheckGuiDirty();
+		}
+
+		return _isGuiDirty;
+	}
+
+	void GameObject::_RenderGUI(bool rebuild) {
 		RectTransform::Sptr rect = Get<RectTransform>();
 
 		if (rect != nullptr) {
+			// Nothing in this tree has changed, draw what it drew last time
+			if (!rebuild && !_isGuiDirty) {
+				GuiBatcher::DrawCache(_guiCache);
+				return;
+			}
+
+			// If our transform changed, the children's caches have the old one baked in
+			bool rebuildChildren = rebuild || _isGuiChildrenDirty;
+
+			GuiBatcher::BeginCapture();
 			GuiBatcher::PushModelTransform(rect->GetLocalTransform());
 
 			for (auto& component : _components) {
@@ -197,7 +269,7 @@ namespace Gameplay {
 				}
 			}
 			for (auto& child : _children) {
-				child->RenderGUI();
+				child->_RenderGUI(rebuildChildren);
 			}
 			for (auto& component : _components) {
 				if (component->IsEnabled) {
@@ -206,6 +278,10 @@ namespace Gameplay {
 			}
 
 			GuiBatcher::PopModelTransform();
+			GuiBatcher::EndCapture(_guiCache);
+
+			_isGuiDirty = false;
+			_isGuiChildrenDirty = false;
 		}
 	}
 
@@ -222,6 +298,7 @@ namespace Gameplay {
 	void GameObject::Update(float dt) {
 		for (auto& component : _components) {
 			if (component->IsEnabled) {
+				PROFILE_ZONE(Profiler::TypeZoneName(*component));
 				component->Update(dt);
 			}
 		}
@@ -257,6 +334,7 @@ namespace Gameplay {
 	std::shared_ptr<IComponent> GameObject::Add(const std::type_index& type)
 	{
 		LOG_ASSERT(!Has(type), "Cannot add 2 instances of a component type to a game object");
+		MEMORY_TAG(MemoryTag::Components);
 
 		// Make a new component, forwarding the arguments
 		std::shared_ptr<IComponent> component = _scene->_components.Create(type);
@@ -265,6 +343,7 @@ namespace Gameplay {
 
 		// Append it to the binding component's storage, and invoke the OnLoad
 		_components.push_back(component);
+		_isGuiDirty = true;
 		component->OnLoad();
 
 		if (_scene->GetIsAwake()) {
@@ -297,6 +376,9 @@ namespace Gameplay {
 			_children.push_back(child);
 			child->_parent = _selfRef.lock();
 			child->_isWorldTransformDirty = true;
+			// The child's GUI will be drawn under our transform from now on
+			child->MarkGuiDirty(true);
+			_isGuiDirty = true;
 		}
 		else {
 			LOG_WARN("Attempting to add same child twice, ignoring: {}", child->Name);
@@ -311,6 +393,8 @@ namespace Gameplay {
 			// Clear the object's parent and remove from our list of children
 			child->_parent.Reset();
 			_children.erase(it);
+			child->MarkGuiDirty(true);
+			_isGuiDirty = true;
 			return true;
 		}
 		else {
@@ -334,7 +418,7 @@ namespace Gameplay {
 		ImGui::PushID(this); // Push a new ImGui ID scope for this object
 		// Since we're allowing names to change, we need to use the ### to have a static ID for the header
 		static char buffer[256];
-		sprintf_s(buffer, 256, "%s###GO_HEADER", Name.c_str());
+		snprintf(buffer, 256, "%s###GO_HEADER", Name.c_str());
 		if (ImGui::CollapsingHeader(buffer)) {
 			ImGui::Indent();
 
@@ -414,6 +498,7 @@ namespace Gameplay {
 					// Render a delete button for the component
 					if (ImGuiHelper::WarningButton("Delete")) {
 						_components.erase(_components.begin() + ix);
+						_isGuiDirty = true;
 						ix--;
 					}
 					ImGui::PopID();
@@ -483,6 +568,7 @@ namespace Gameplay {
 		result->_rotation = (data["rotation"]);
 		result->_scale = (data["scale"]);
 		result->HideInHierarchy = JsonGet(data, "hide_in_inspector", false);
+		result->AlwaysActive = JsonGet(data, "always_active", false);
 		result->_isLocalTransformDirty = true;
 		result->_isWorldTransformDirty = true;
 
@@ -513,7 +599,8 @@ namespace Gameplay {
 			{ "rotation", _rotation },
 			{ "scale",    _scale },
 			{ "parent",   parent == nullptr ? "null" : parent->_guid.str() },
-			{ "hide_in_inspector", HideInHierarchy }
+			{ "hide_in_inspector", HideInHierarchy },
+			{ "always_active", AlwaysActive }
 		};
 		result["components"] = nlohmann::json();
 		for (auto& component : _components) {
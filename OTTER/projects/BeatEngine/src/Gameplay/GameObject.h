@@ -12,6 +12,8 @@
 #include "Gameplay/Components/IComponent.h"
 #include "Gameplay/Components/ComponentManager.h"
 #include "Utils/ResourceManager/IResource.h"
+#include "Utils/MemoryTracker.h"
+#include "Graphics/GuiBatcher.h"
 
 class InspectorWindow;
 class HierarchyWindow;
@@ -139,6 +141,15 @@ namespace Gameplay {
 		// Hack to hide instances from the hierarchy (like when adding lots of instances)
 		bool HideInHierarchy = false;
 
+		// If true, this object keeps updating even when it's outside of the scene's activation region
+		bool AlwaysActive = false;
+
+		/// <summary>
+		/// Returns true if this object is outside of the scene's activation region, dormant
+		/// objects are not updated and their physics bodies are removed from the world
+		/// </summary>
+		bool IsDormant() const { return _isDormant; }
+
 		/// <summary>
 		/// Rotates this object to look at the given point in world coordinates
 		/// </summary>
@@ -202,6 +213,16 @@ namespace Gameplay {
 		/// </summary>
 		glm::vec3 GetRotationEuler() const;
 
+		/// <summary>
+		/// True if our position or rotation has been set since physics last synced with us,
+		/// lets rigid bodies tell a teleport apart from the transform they wrote themselves
+		/// </summary>
+		bool IsPhysicsTransformDirty() const;
+		/// <summary>
+		/// Called by physics once it has caught up with our transform
+		/// </summary>
+		void ClearPhysicsTransformDirty();
+
 		/// <summary>
 		/// Sets the scaling factor for the game object, should be non-zero
 		/// </summary>
@@ -227,9 +248,15 @@ namespace Gameplay {
 		const glm::mat4& GetInverseLocalTransform() const;
 
 		/// <summary>
-		/// Allows components to render GUI elements to the screen
+		/// Allows components to render GUI elements to the screen. The GUI is retained, anything in
+		/// this object's tree that hasn't been marked dirty is drawn from what it emitted last time
 		/// </summary>
 		void RenderGUI(); 
+		/// <summary>
+		/// Flags the GUI for this object as needing to be rebuilt on the next RenderGUI
+		/// </summary>
+		/// <param name="includeChildren">True if the children need to be rebuilt as well, ex: when our rect transform changes</param>
+		void MarkGuiDirty(bool includeChildren = false);
 
 		/// <summary>
 		/// Returns a pointer to the scene that this GameObject belongs to
@@ -293,6 +320,7 @@ namespace Gameplay {
 		std::shared_ptr<T> Add(TArgs&&... args) {
 			static_assert(is_valid_component<T>(), "Type is not a valid component type!");
 			LOG_ASSERT(!Has<T>(), "Cannot add 2 instances of a component type to a game object");
+			MEMORY_TAG(MemoryTag::Components);
 
 			// Make a new component, forwarding the arguments
 			std::shared_ptr<T> component = _scene->Components().Create<T>(std::forward<TArgs>(args)...);
@@ -301,6 +329,7 @@ namespace Gameplay {
 
 			// Append it to the binding component's storage, and invoke the OnLoad
 			_components.push_back(component);
+			_isGuiDirty = true;
 			component->OnLoad();
 
 			if (_scene->GetIsAwake()) {
@@ -357,6 +386,19 @@ namespace Gameplay {
 		mutable glm::mat4 _inverseWorldTransform;
 		mutable bool _isWorldTransformDirty;
 
+		// Set whenever our position or rotation is written, cleared by physics
+		bool _isPhysicsTransformDirty;
+
+		// True if the scene has put us to sleep
+		bool _isDormant;
+
+		// The quads that this object and it's children emitted the last time the GUI was rebuilt
+		GuiBatcher::QuadCache _guiCache;
+		// Which components were enabled when the cache was built, IsEnabled can change without us being told
+		uint64_t _guiEnabledMask;
+		bool _isGuiDirty;
+		bool _isGuiChildrenDirty;
+
 		// For the hierarchy
 		WeakRef _parent;
 		std::vector<WeakRef> _children;
@@ -380,6 +422,11 @@ namespace Gameplay {
 		void _RecalcWorldTransform() const;
 
 		void _PurgeDeletedChildren();
+
+		// Looks for changes in this object's GUI tree, returns true if anything in the tree needs rebuilding
+		bool _CheckGuiDirty();
+		// Rebuilds the GUI for this object if it's dirty, or replays it's cache if not
+		void _RenderGUI(bool rebuild);
 	};
 
 }
\ No newline at end of file
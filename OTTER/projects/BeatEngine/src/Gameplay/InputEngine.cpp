@@ -1,9 +1,10 @@
 #include "Gameplay/InputEngine.h"
-#include <locale>
-#include <codecvt>
 #include "Application/Application.h"
+#include "Gameplay/InputRecorder.h"
+#include "Utils/StringUtils.h"
 
 GLFWwindow* InputEngine::__window = nullptr;
+bool InputEngine::__windowInputEnabled = true;
 glm::dvec2 InputEngine::__mousePos  = glm::dvec2(0.0);
 glm::dvec2 InputEngine::__prevMousePos = glm::dvec2(0.0);;
 glm::dvec2 InputEngine::__scrollDelta = glm::dvec2(0.0);
@@ -66,13 +67,20 @@ std::wstring InputEngine::GetInputText() {
 }
 
 std::string InputEngine::GetInputTextAscii() {
-	static std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> StringConvert;
-	return StringConvert.to_bytes(__inputText);
+	return StringTools::UnicodeToUtf8(__inputText);
 }
 
 void InputEngine::EndFrame() {
 	__prevMousePos = __mousePos;
-	glfwGetCursorPos(__window, &__mousePos.x, &__mousePos.y);
+	if (__windowInputEnabled) {
+		glfwGetCursorPos(__window, &__mousePos.x, &__mousePos.y);
+	}
+
+	// Anything after this belongs to the next frame, including the cursor position we just read
+	InputRecorder::NextFrame();
+	if (__mousePos != __prevMousePos) {
+		InputRecorder::RecordCursor(__mousePos);
+	}
 
 	__scrollDelta.x = __scrollDelta.y = 0.0;
 	__inputText.clear();
@@ -88,17 +96,38 @@ void InputEngine::EndFrame() {
 	}
 }
 
+void InputEngine::InjectKey(int keyCode, bool down) {
+	if (keyCode < 0 || keyCode > GLFW_KEY_LAST)
+		return;
+	__keyState[keyCode] = down ? ButtonState::Pressed : ButtonState::Released;
+}
+
+void InputEngine::InjectMouseButton(int button, bool down) {
+	if (button < 0 || button > GLFW_MOUSE_BUTTON_LAST)
+		return;
+	__mouseState[button] = down ? ButtonState::Pressed : ButtonState::Released;
+}
+
+void InputEngine::InjectCursor(const glm::dvec2& position) {
+	__mousePos = position;
+}
+
+void InputEngine::SetWindowInputEnabled(bool value) {
+	__windowInputEnabled = value;
+}
 
 void InputEngine::__KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
-	if (key == GLFW_KEY_UNKNOWN)
+	if (key == GLFW_KEY_UNKNOWN || !__windowInputEnabled)
 		return;
 
 	switch (action) {
 		case GLFW_PRESS:
 			__keyState[key] = ButtonState::Pressed;
+			InputRecorder::RecordKey(key, true);
 			break;
 		case GLFW_RELEASE:
 			__keyState[key] = ButtonState::Released;
+			InputRecorder::RecordKey(key, false);
 			break;
 		default:
 			break;
@@ -110,13 +139,15 @@ void InputEngine::__CharCallback(GLFWwindow* window, uint32_t keycode) {
 }
 
 void InputEngine::__MouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
-	if (button > GLFW_MOUSE_BUTTON_LAST)
+	if (button > GLFW_MOUSE_BUTTON_LAST || !__windowInputEnabled)
 		return;
 
 	if (action == GLFW_PRESS) {
 		__mouseState[button] = ButtonState::Pressed;
+		InputRecorder::RecordMouseButton(button, true);
 	} else if (action == GLFW_RELEASE) {
 		__mouseState[button] = ButtonState::Released;
+		InputRecorder::RecordMouseButton(button, false);
 	}
 }
 
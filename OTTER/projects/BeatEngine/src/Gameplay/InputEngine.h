@@ -44,8 +44,19 @@ public:
 
 	static void EndFrame();
 
+	// Feeds a key press or release into the input engine as if it came from the window,
+	// used to drive the game from scripted or recorded input
+	static void InjectKey(int keyCode, bool down);
+	static void InjectMouseButton(int button, bool down);
+	static void InjectCursor(const glm::dvec2& position);
+
+	// When disabled, key, mouse and cursor events from the window are ignored so
+	// that injected input can't be disturbed (ex: while replaying a recording)
+	static void SetWindowInputEnabled(bool value);
+
 private:
 	static GLFWwindow*  __window;
+	static bool         __windowInputEnabled;
 	static ButtonState  __keyState[GLFW_KEY_LAST + 1];
 	static ButtonState  __mouseState[GLFW_MOUSE_BUTTON_LAST + 1];
 	static glm::dvec2   __mousePos;
@@ -0,0 +1,90 @@
+#include "Gameplay/InputRecorder.h"
+
+#include <json.hpp>
+#include "Logging.h"
+#include "Utils/FileHelpers.h"
+
+bool InputRecorder::_isRecording = false;
+std::string InputRecorder::_path = "";
+std::string InputRecorder::_scene = "";
+float InputRecorder::_timeStep = 0.0f;
+uint32_t InputRecorder::_seed = 0;
+int InputRecorder::_frame = 0;
+std::vector<InputRecorder::Event> InputRecorder::_events;
+
+void InputRecorder::Start(const std::string& path, const std::string& scene, float timeStep, uint32_t seed) {
+	_path = path;
+	_scene = scene;
+	_timeStep = timeStep;
+	_seed = seed;
+	_frame = 0;
+	_events.clear();
+	// Five minutes of play at 60fps is a few thousand events, so this avoids most of the regrowth
+	_events.reserve(4096);
+	_isRecording = true;
+
+	LOG_INFO("Recording input to \"{}\" (seed {})", path, seed);
+}
+
+void InputRecorder::Stop() {
+	if (!_isRecording) {
+		return;
+	}
+	_isRecording = false;
+
+	nlohmann::json events = nlohmann::json::array();
+	for (const Event& e : _events) {
+		nlohmann::json item;
+		item["frame"] = e.Frame;
+		if (e.IsCursor) {
+			item["cursor"] = { e.Cursor.x, e.Cursor.y };
+		} else {
+			if (e.Key >= 0) {
+				item["key"] = e.Key;
+			}
+			if (e.MouseButton >= 0) {
+				item["mouse"] = e.MouseButton;
+			}
+			item["down"] = e.Down;
+		}
+		events.push_back(item);
+	}
+
+	nlohmann::json blob;
+	blob["scene"] = _scene;
+	blob["dt"] = _timeStep;
+	blob["seed"] = _seed;
+	blob["frames"] = _frame;
+	blob["events"] = events;
+
+	FileHelpers::WriteContentsToFile(_path, blob.dump(1, '\t'));
+	LOG_INFO("Wrote {} frames of input ({} events) to \"{}\"", _frame, _events.size(), _path);
+}
+
+bool InputRecorder::IsRecording() {
+	return _isRecording;
+}
+
+void InputRecorder::NextFrame() {
+	if (_isRecording) {
+		_frame++;
+	}
+}
+
+void InputRecorder::RecordKey(int keyCode, bool down) {
+	if (_isRecording) {
+		_events.push_back({ _frame, keyCode, -1, down, false, glm::dvec2(0.0) });
+	}
+}
+
+void InputRecorder::RecordMouseButton(int button, bool down) {
+	if (_isRecording) {
+		_events.push_back({ _frame, -1, button, down, false, glm::dvec2(0.0) });
+	}
+}
+
+void InputRecorder::RecordCursor(const glm::dvec2& position) {
+	if (_isRecording) {
+		_events.push_back({ _frame, -1, -1, false, true, position });
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <GLM/glm.hpp>
+
+/// <summary>
+/// Records everything the InputEngine receives from the window, tagged with the frame
+/// it arrived on, so that a run can be replayed exactly with the benchmark runner.
+/// Recordings are JSON files in the same format as benchmark input scripts:
+///
+/// { "scene": "Level1.json", "dt": 0.0166, "seed": 1234, "frames": 18000,
+///   "events": [ { "frame": 10, "key": 32, "down": true }, { "frame": 11, "cursor": [ 960, 540 ] } ] }
+/// </summary>
+class InputRecorder {
+public:
+	InputRecorder() = delete;
+
+	/// <summary>
+	/// Starts recording input, discarding anything that was recorded previously
+	/// </summary>
+	/// <param name="path">The path to write the recording to when we stop</param>
+	/// <param name="scene">The scene the recording starts in</param>
+	/// <param name="timeStep">The fixed timestep the game is running at</param>
+	/// <param name="seed">The seed used for gameplay randomness</param>
+	static void Start(const std::string& path, const std::string& scene, float timeStep, uint32_t seed);
+	/// <summary>
+	/// Stops recording and writes the recording to disk
+	/// </summary>
+	static void Stop();
+	static bool IsRecording();
+
+	/// <summary>
+	/// Moves on to the next frame, invoked by the InputEngine at the end of every frame
+	/// </summary>
+	static void NextFrame();
+
+	static void RecordKey(int keyCode, bool down);
+	static void RecordMouseButton(int button, bool down);
+	static void RecordCursor(const glm::dvec2& position);
+
+protected:
+	struct Event {
+		int        Frame;
+		int        Key;
+		int        MouseButton;
+		bool       Down;
+		bool       IsCursor;
+		glm::dvec2 Cursor;
+	};
+
+	static bool               _isRecording;
+	static std::string        _path;
+	static std::string        _scene;
+	static float              _timeStep;
+	static uint32_t           _seed;
+	static int                _frame;
+	static std::vector<Event> _events;
+};
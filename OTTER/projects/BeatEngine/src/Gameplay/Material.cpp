@@ -4,6 +4,7 @@
 #include "Graphics/Textures/TextureCube.h"
 #include "Graphics/Textures/Texture2D.h"
 #include "Logging.h"
+#include "Graphics/GpuProfiler.h"
 #include "Utils/ImGuiHelper.h"
 #include "Graphics/Textures/Texture1D.h"
 #include "Graphics/Textures/Texture3D.h"
@@ -62,6 +63,8 @@ namespace Gameplay {
 
 	void Material::Apply() {
 		if (_shader != nullptr) {
+			GpuProfiler::Counters().MaterialApplies++;
+
 			// Skip the reserved # of texture slots
 			int textureSlot = 0;
 
@@ -211,7 +214,7 @@ namespace Gameplay {
 		uint8_t* dataStore = ArraySize > 1 ? (uint8_t*)ArrayBlock : Value;
 
 		// We'll need the name regardless, create it here
-		sprintf_s(buffer, "%s:", Name.c_str());
+		snprintf(buffer, sizeof(buffer), "%s:", Name.c_str());
 
 		// If this is an array, draw name and indent items
 		if (ArraySize > 1) {
@@ -224,7 +227,7 @@ namespace Gameplay {
 		for (int ix = 0; ix < ArraySize; ix++) {
 			// If it's an array element, the name is the index
 			if (ArraySize > 1) {
-				sprintf_s(buffer, "[%d]:", ix);
+				snprintf(buffer, sizeof(buffer), "[%d]:", ix);
 			}
 
 			// For arrays determine our data offset
@@ -2,6 +2,9 @@
 #include <filesystem>
 
 #include "Utils/ObjLoader.h"
+#include "Utils/OptimizedObjLoader.h"
+#include "Gameplay/Physics/CollisionShapeCache.h"
+#include "Utils/ResourceManager/ResourceManager.h"
 
 namespace Gameplay {
 	MeshResource::MeshResource() :
@@ -9,7 +12,7 @@ namespace Gameplay {
 		Filename(""),
 		MeshBuilderParams(std::vector<MeshBuilderParam>()),
 		Mesh(nullptr),
-		BulletTriMesh(nullptr)
+		CollisionHull()
 	{ 
 	
 	}
@@ -19,9 +22,11 @@ namespace Gameplay {
 		Filename(filename),
 		MeshBuilderParams(std::vector<MeshBuilderParam>()),
 		Mesh(nullptr),
-		BulletTriMesh(nullptr)
+		CollisionHull()
 	{
-		Mesh = ObjLoader::LoadFromFile(filename);
+		std::vector<glm::vec3> positions;
+		Mesh = ObjLoader::LoadFromFile(filename, true, &positions);
+		CollisionHull = Physics::CollisionShapeCache::BakeConvexHull(positions.data(), positions.size());
 	}
 
 	MeshResource::~MeshResource() = default;
@@ -54,14 +59,28 @@ namespace Gameplay {
 			}
 			MeshFactory::CalculateTBN(mesh);
 			result->Mesh = mesh.Bake();
+			result->_BakeCollisionHull(mesh);
 		} else {
 			result->Filename = JsonGet<std::string>(blob, "filename", "null");
-			if (result->Filename != "null" && std::filesystem::exists(result->Filename)) {
-				#ifdef OPTIMIZED_OBJ_LOADER
-				result->Mesh = OptimizedObjLoader::LoadFromFile(result->Filename);
-				#else
-				result->Mesh = ObjLoader::LoadFromFile(result->Filename);
-				#endif
+			// If the manifest was loaded from an archive, the binary mesh is uploaded straight out of the mapping
+			AssetView archived = ResourceManager::ReadArchived<MeshResource>(blob);
+			if (archived.IsValid()) {
+				result->Mesh = OptimizedObjLoader::LoadFromMemory(archived.Data, archived.Size, &result->CollisionHull, result->Filename);
+			}
+			if (result->Mesh == nullptr && result->Filename != "null" && std::filesystem::exists(result->Filename)) {
+				// Cooked manifests point straight at the binary mesh, which already stores a pre-baked hull
+				if (std::filesystem::path(result->Filename).extension() == ".bin") {
+					result->Mesh = OptimizedObjLoader::LoadFromFile(result->Filename, &result->CollisionHull);
+				} else {
+					#ifdef OPTIMIZED_OBJ_LOADER
+					// The binary mesh format stores a pre-baked hull for us
+					result->Mesh = OptimizedObjLoader::LoadFromFile(result->Filename, &result->CollisionHull);
+					#else
+					std::vector<glm::vec3> positions;
+					result->Mesh = ObjLoader::LoadFromFile(result->Filename, true, &positions);
+					result->CollisionHull = Physics::CollisionShapeCache::BakeConvexHull(positions.data(), positions.size());
+					#endif
+				}
 
 			}
 		}
@@ -75,6 +94,17 @@ namespace Gameplay {
 		}
 		MeshFactory::CalculateTBN(mesh);
 		Mesh = mesh.Bake();
+		_BakeCollisionHull(mesh);
+	}
+
+	void MeshResource::_BakeCollisionHull(MeshBuilder<VertexPosNormTexColTangents>& mesh) {
+		std::vector<glm::vec3> positions;
+		positions.reserve(mesh.GetVertexCount());
+		const VertexPosNormTexColTangents* vertices = mesh.GetVertexDataPtr();
+		for (size_t ix = 0; ix < mesh.GetVertexCount(); ix++) {
+			positions.push_back(vertices[ix].Position);
+		}
+		CollisionHull = Physics::CollisionShapeCache::BakeConvexHull(positions.data(), positions.size());
 	}
 
 	void MeshResource::AddParam(const MeshBuilderParam & param) {
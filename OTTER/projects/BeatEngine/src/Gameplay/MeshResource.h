@@ -3,9 +3,6 @@
 #include "Graphics/VertexArrayObject.h"
 #include "Utils/MeshFactory.h"
 
-// bullet triangle mesh pre-declaration
-class btTriangleMesh;
-
 namespace Gameplay {
 	/// <summary>
 	/// A mesh resource contains information on how to generate a VAO at runtime
@@ -48,9 +45,10 @@ namespace Gameplay {
 		/// </summary>
 		MeshResource::Sptr             ColliderMeshData;
 		/// <summary>
-		/// Allows for bullet to generate a triangle mesh from this mesh and cache it
+		/// A simplified convex hull around this mesh's vertices, baked when the mesh is loaded 
+		/// so that convex mesh colliders never have to read geometry back from the GPU
 		/// </summary>
-		std::shared_ptr<btTriangleMesh> BulletTriMesh;
+		std::vector<glm::vec3>          CollisionHull;
 
 		/// <summary>
 		/// Generates a new mesh from the mesh builder parameters
@@ -68,5 +66,9 @@ namespace Gameplay {
 		static MeshResource::Sptr FromJson(const nlohmann::json& blob);
 
 		//MAKE_TYPENAME(MeshResource);
+
+	protected:
+		// Bakes our collision hull from the vertices of a mesh builder
+		void _BakeCollisionHull(MeshBuilder<VertexPosNormTexColTangents>& mesh);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "Gameplay/Physics/BulletTaskScheduler.h"
+
+#include <algorithm>
+
+namespace Gameplay::Physics {
+	std::unique_ptr<BulletTaskScheduler> BulletTaskScheduler::_singleton = nullptr;
+
+	BulletTaskScheduler::BulletTaskScheduler(int numThreads) :
+		btITaskScheduler("BeatEngine"),
+		_pool(nullptr)
+	{
+		// The calling thread participates in all work, so we need one less worker
+		_pool = std::make_unique<ThreadPool>(std::max(numThreads, 1) - 1);
+	}
+
+	BulletTaskScheduler::~BulletTaskScheduler() = default;
+
+	BulletTaskScheduler* BulletTaskScheduler::Activate(int numThreads) {
+		if (_singleton == nullptr) {
+			_singleton = std::make_unique<BulletTaskScheduler>(numThreads);
+		} else if (_singleton->getNumThreads() != numThreads) {
+			_singleton->setNumThreads(numThreads);
+		}
+		btSetTaskScheduler(_singleton.get());
+		return _singleton.get();
+	}
+
+	int BulletTaskScheduler::getMaxNumThreads() const {
+		return BT_MAX_THREAD_COUNT;
+	}
+
+	int BulletTaskScheduler::getNumThreads() const {
+		return _pool->GetNumWorkers() + 1;
+	}
+
+	void BulletTaskScheduler::setNumThreads(int numThreads) {
+		numThreads = std::clamp(numThreads, 1, (int)BT_MAX_THREAD_COUNT);
+		_pool->SetNumWorkers(numThreads - 1);
+		// Our old workers are gone, so let bullet hand out thread indices from the start again
+		btResetThreadIndexCounter();
+	}
+
+	void BulletTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) {
+		_pool->ParallelFor(iBegin, iEnd, grainSize, [&](int begin, int end) {
+			body.forLoop(begin, end);
+		});
+	}
+
+	btScalar BulletTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) {
+		// Each chunk produces a partial sum, which we combine under a lock
+		btScalar result = 0;
+		std::mutex sumLock;
+		_pool->ParallelFor(iBegin, iEnd, grainSize, [&](int begin, int end) {
+			btScalar partial = body.sumLoop(begin, end);
+			std::lock_guard<std::mutex> lock(sumLock);
+			result += partial;
+		});
+		return result;
+	}
+}
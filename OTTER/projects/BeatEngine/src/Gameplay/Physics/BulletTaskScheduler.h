@@ -0,0 +1,41 @@
+#pragma once
+#include <LinearMath/btThreads.h>
+
+#include "Utils/ThreadPool.h"
+
+namespace Gameplay::Physics {
+	/// <summary>
+	/// Implements Bullet's task scheduler interface on top of our own thread pool, this is
+	/// what the multithreaded dynamics world, dispatcher and solver pool use to spread their
+	/// work across cores
+	/// 
+	/// Note that Bullet's multithreaded classes only take proper locks when the Bullet 
+	/// libraries are built with BT_THREADSAFE, so the scene won't activate us otherwise
+	/// </summary>
+	class BulletTaskScheduler : public btITaskScheduler {
+	public:
+		BulletTaskScheduler(int numThreads);
+		virtual ~BulletTaskScheduler();
+
+		/// <summary>
+		/// Makes sure the shared scheduler exists with the given thread count and
+		/// registers it with Bullet. Must be called before creating any of Bullet's 
+		/// "Mt" classes
+		/// </summary>
+		/// <param name="numThreads">The total number of threads to use, including the calling thread</param>
+		static BulletTaskScheduler* Activate(int numThreads);
+
+		// Inherited from btITaskScheduler
+
+		virtual int getMaxNumThreads() const override;
+		virtual int getNumThreads() const override;
+		virtual void setNumThreads(int numThreads) override;
+		virtual void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+		virtual btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+	protected:
+		ThreadPool::Uptr _pool;
+
+		static std::unique_ptr<BulletTaskScheduler> _singleton;
+	};
+}
@@ -2,9 +2,14 @@
 
 #include "Gameplay/Physics/ICollider.h"
 
+namespace Gameplay {
+	class MeshResource;
+}
+
 namespace Gameplay::Physics {
 	/// <summary>
-	/// A complex collider type that allows us to construct collision hulls from arbitrary convex meshes
+	/// A complex collider type that allows us to construct collision hulls from arbitrary convex meshes,
+	/// using the simplified hull that is baked into the mesh resource when it is loaded
 	/// </summary>
 	class ConvexMeshCollider final : public ICollider {
 	public:
@@ -19,9 +24,11 @@ namespace Gameplay::Physics {
 		virtual void FromJson(const nlohmann::json& data) override;
 
 	protected:
-		btTriangleMesh* _triMesh;
+		// The mesh that we're generating our hull from
+		std::shared_ptr<MeshResource> _mesh;
 		ConvexMeshCollider();
 
 		virtual btCollisionShape* CreateShape() const override;
+		virtual Guid GetShapeSource() const override;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,97 @@
+#include "Gameplay/Physics/CollisionShapeCache.h"
+#include <BulletCollision/CollisionShapes/btShapeHull.h>
+
+#include "Utils/GlmBulletConversions.h"
+#include "Logging.h"
+
+namespace Gameplay::Physics {
+	CollisionShapeCache::CollisionShapeCache() :
+		_shapes(),
+		_hits(0),
+		_misses(0)
+	{ }
+
+	CollisionShapeCache::ShapePtr CollisionShapeCache::Get(const std::string& key, const glm::vec3& scale, const ShapeFactory& factory) {
+		// If someone is still using a shape with this key, share it
+		auto it = _shapes.find(key);
+		if (it != _shapes.end()) {
+			ShapePtr result = it->second.lock();
+			if (result != nullptr) {
+				_hits++;
+				return result;
+			}
+		}
+
+		btCollisionShape* shape = factory();
+		if (shape == nullptr) {
+			return nullptr;
+		}
+		shape->setLocalScaling(ToBt(scale));
+		_misses++;
+
+		// Clean up any dead entries before we grow the map
+		_PruneExpired();
+
+		ShapePtr result = ShapePtr(shape);
+		_shapes[key] = result;
+		return result;
+	}
+
+	std::string CollisionShapeCache::MakeKey(int type, const std::string& params, const std::string& source, const glm::vec3& scale) {
+		std::string result;
+		result.reserve(params.size() + source.size() + 64);
+		result += std::to_string(type);
+		result += '|';
+		result += params;
+		result += '|';
+		result += source;
+		result += '|';
+		result += std::to_string(scale.x) + "," + std::to_string(scale.y) + "," + std::to_string(scale.z);
+		return result;
+	}
+
+	std::vector<glm::vec3> CollisionShapeCache::BakeConvexHull(const glm::vec3* points, size_t count) {
+		std::vector<glm::vec3> result;
+		if (points == nullptr || count == 0) {
+			return result;
+		}
+
+		// Wrap the whole point cloud, then let the shape hull reduce it down to a much
+		// smaller set of vertices that still contain the mesh
+		btConvexHullShape source = btConvexHullShape(&points[0].x, static_cast<int>(count), sizeof(glm::vec3));
+		btShapeHull hull = btShapeHull(&source);
+		if (!hull.buildHull(source.getMargin())) {
+			LOG_WARN("Failed to build a convex hull from {} points", count);
+			return result;
+		}
+
+		result.reserve(hull.numVertices());
+		for (int ix = 0; ix < hull.numVertices(); ix++) {
+			result.push_back(ToGlm(hull.getVertexPointer()[ix]));
+		}
+		return result;
+	}
+
+	size_t CollisionShapeCache::GetLiveShapeCount() {
+		_PruneExpired();
+		return _shapes.size();
+	}
+
+	size_t CollisionShapeCache::GetHitCount() const {
+		return _hits;
+	}
+
+	size_t CollisionShapeCache::GetMissCount() const {
+		return _misses;
+	}
+
+	void CollisionShapeCache::_PruneExpired() {
+		for (auto it = _shapes.begin(); it != _shapes.end();) {
+			if (it->second.expired()) {
+				it = _shapes.erase(it);
+			} else {
+				it++;
+			}
+		}
+	}
+}
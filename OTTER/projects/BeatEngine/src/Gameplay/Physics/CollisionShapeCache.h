@@ -0,0 +1,86 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+
+#include <GLM/glm.hpp>
+#include <btBulletCollisionCommon.h>
+
+namespace Gameplay::Physics {
+	/// <summary>
+	/// Shares Bullet collision shapes between colliders that would otherwise create identical
+	/// shapes, for instance every platform spawned with the same box collider. Shapes are keyed
+	/// by the collider type, it's parameters, the source mesh (if any) and the shape's scale, and 
+	/// are freed once the last collider using them lets go
+	/// 
+	/// Each scene owns it's own cache, so the cache's bookkeeping is freed along with the scene
+	/// rather than outliving it
+	/// 
+	/// Note that shared shapes must never have their local scaling changed after creation, since
+	/// that would affect every body using them. Request a new shape with the new scale instead
+	/// </summary>
+	class CollisionShapeCache {
+	public:
+		typedef std::shared_ptr<btCollisionShape> ShapePtr;
+		typedef std::function<btCollisionShape*()> ShapeFactory;
+
+		CollisionShapeCache();
+		~CollisionShapeCache() = default;
+
+		CollisionShapeCache(const CollisionShapeCache& other) = delete;
+		CollisionShapeCache& operator=(const CollisionShapeCache& other) = delete;
+
+		/// <summary>
+		/// Gets the shape with the given key, or creates it with the factory if no live
+		/// shape exists for that key yet. The factory's result will have it's local 
+		/// scaling set to the given scale before it is shared
+		/// </summary>
+		/// <param name="key">The key that uniquely identifies the shape's parameters, see MakeKey</param>
+		/// <param name="scale">The local scaling to apply to the shape</param>
+		/// <param name="factory">Creates the shape if we miss the cache, may return nullptr</param>
+		/// <returns>The shared shape, or nullptr if the factory failed</returns>
+		ShapePtr Get(const std::string& key, const glm::vec3& scale, const ShapeFactory& factory);
+
+		/// <summary>
+		/// Builds a cache key from the parts that determine what a collision shape looks like
+		/// </summary>
+		/// <param name="type">The collider type, as an int</param>
+		/// <param name="params">A string containing all the collider's parameters, ex: it's JSON</param>
+		/// <param name="source">The GUID of the resource the shape is generated from, or empty</param>
+		/// <param name="scale">The local scaling that will be applied to the shape</param>
+		static std::string MakeKey(int type, const std::string& params, const std::string& source, const glm::vec3& scale);
+
+		/// <summary>
+		/// Reduces a point cloud down to a simplified convex hull that is suitable for creating a
+		/// btConvexHullShape from. This is expensive, and should be done when baking mesh data
+		/// rather than when creating colliders
+		/// </summary>
+		/// <param name="points">The points to wrap, usually the positions of a mesh</param>
+		/// <param name="count">The number of points</param>
+		/// <returns>The vertices of the simplified hull, or an empty vector on failure</returns>
+		static std::vector<glm::vec3> BakeConvexHull(const glm::vec3* points, size_t count);
+
+		/// <summary>
+		/// Gets the number of shapes currently being shared
+		/// </summary>
+		size_t GetLiveShapeCount();
+		/// <summary>
+		/// Gets the number of times that a collider got an existing shape from the cache
+		/// </summary>
+		size_t GetHitCount() const;
+		/// <summary>
+		/// Gets the number of times that we had to create a new shape
+		/// </summary>
+		size_t GetMissCount() const;
+
+	protected:
+		std::unordered_map<std::string, std::weak_ptr<btCollisionShape>> _shapes;
+		size_t _hits;
+		size_t _misses;
+
+		// Removes entries for shapes that are no longer used by anyone
+		void _PruneExpired();
+	};
+}
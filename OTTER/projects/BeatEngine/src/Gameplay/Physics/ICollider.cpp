@@ -6,6 +6,8 @@
 // Utils
 #include "Utils/GlmDefines.h"
 
+#include "Gameplay/Physics/CollisionShapeCache.h"
+
 // Collider Types
 #include "Gameplay/Physics/Colliders/BoxCollider.h"
 #include "Gameplay/Physics/Colliders/PlaneCollider.h"
@@ -27,22 +29,24 @@ namespace Gameplay::Physics {
 		_guid(Guid::New())
 	{ }
 
-	ICollider::~ICollider() {
-		if (_shape != nullptr) {
-			delete _shape;
-			_shape = nullptr;
-		}
-	}
+	ICollider::~ICollider() = default;
 
 	ColliderType ICollider::GetType() const {
 		return _type;
 	}
 
 	btCollisionShape* ICollider::GetShape() const {
-		if (_shape == nullptr) {
-			_shape = CreateShape();
-		}
-		return _shape;
+		return _shape.get();
+	}
+
+	std::shared_ptr<btCollisionShape> ICollider::_AcquireShape(CollisionShapeCache& cache, const glm::vec3& scale) const {
+		// Our JSON contains all of our shape parameters, so we can use it to tell shapes apart
+		nlohmann::json params;
+		ToJson(params);
+		Guid source = GetShapeSource();
+		std::string key = CollisionShapeCache::MakeKey(*_type, params.dump(), source.isValid() ? source.str() : "", scale);
+
+		return cache.Get(key, scale, [this]() { return CreateShape(); });
 	}
 
 	ICollider* ICollider::SetPosition(const glm::vec3& value) {
@@ -40,6 +40,8 @@ namespace Gameplay {
 }
 
 namespace Gameplay::Physics {
+	class CollisionShapeCache;
+
 	// Stores a string that can be fed to ImGui to make a combo box
 	// of all collider types
 	extern const char* ColliderTypeComboNames;
@@ -89,7 +91,9 @@ namespace Gameplay::Physics {
 		/// </summary>
 		virtual ColliderType GetType() const;
 		/// <summary>
-		/// Gets this collider's bullet collision shape
+		/// Gets this collider's bullet collision shape, note that this shape may be 
+		/// shared with other colliders that have the same parameters. This will be null
+		/// until the collider has been added to a body in a scene
 		/// </summary>
 		btCollisionShape* GetShape() const;
 
@@ -145,16 +149,31 @@ namespace Gameplay::Physics {
 		// Stores type 
 		ColliderType _type;
 		// Stores shape, note that mutable lets us modify in const functions
-		mutable btCollisionShape* _shape;
+		mutable std::shared_ptr<btCollisionShape> _shape;
 		mutable bool _isDirty;
 
 		ICollider(ColliderType type);
 
 		/// <summary>
-		/// Creates the bullet collision shape from this collider's info
+		/// Creates the bullet collision shape from this collider's info. This is only
+		/// invoked when no matching shape exists in the CollisionShapeCache
 		/// </summary>
 		/// <returns>A btCollisionShape allocated with new</returns>
 		virtual btCollisionShape* CreateShape() const = 0;
+		/// <summary>
+		/// Gets the GUID of the resource that this collider's shape is generated from, if
+		/// any. Colliders that build their shape from a mesh must override this so that 
+		/// shapes from different meshes are not shared
+		/// </summary>
+		virtual Guid GetShapeSource() const { return Guid(); }
+
+		/// <summary>
+		/// Gets a shape matching this collider's parameters and the given scale, 
+		/// sharing an existing shape if one is available
+		/// </summary>
+		/// <param name="cache">The cache of the scene that the shape will be used in</param>
+		/// <param name="scale">The local scaling for the shape</param>
+		std::shared_ptr<btCollisionShape> _AcquireShape(CollisionShapeCache& cache, const glm::vec3& scale) const;
 
 	private:
 		// Allow RigidBody to access protected and private members
@@ -18,9 +18,14 @@ int PhysicsBase::_editorSelectedColliderType = 0;
 		_isShapeDirty(true),
 		_collisionGroup(0x01),
 		_collisionMask(0xFFFFFFFF),
-		_prevScale(glm::vec3(1.0f))
+		_prevScale(glm::vec3(1.0f)),
+		_isSimulationEnabled(true)
 	{ }
 
+	bool PhysicsBase::IsSimulationEnabled() const {
+		return _isSimulationEnabled;
+	}
+
 	PhysicsBase::~PhysicsBase() {
 		if (_scene != nullptr) {
 			delete _shape;
@@ -150,28 +155,47 @@ int PhysicsBase::_editorSelectedColliderType = 0;
 	void PhysicsBase::RemoveCollider(const ICollider::Sptr& collider) {
 		auto& it = std::find(_colliders.begin(), _colliders.end(), collider);
 		if (it != _colliders.end()) {
-			if (collider->GetShape() != nullptr) {
-				_shape->removeChildShape(collider->GetShape());
+			_colliders.erase(it);
+			if (_shape != nullptr && collider->_shape != nullptr) {
+				_RemoveColliderFromShape(collider.get());
 				_isShapeDirty = true;
 			}
-			_colliders.erase(it);
+		}
+	}
+
+	void PhysicsBase::_RemoveColliderFromShape(ICollider* collider) {
+		// Hold on to the shape until we're done with it, we may have had the last reference to it
+		std::shared_ptr<btCollisionShape> shape = collider->_shape;
+		collider->_shape = nullptr;
+
+		// Bullet removes every child that uses the shape, and since shapes are shared other colliders
+		// on this body may be using it as well, so we need to add them back in
+		_shape->removeChildShape(shape.get());
+		for (auto& other : _colliders) {
+			if (other->_shape == shape) {
+				other->_shape = nullptr;
+				_AddColliderToShape(other.get());
+			}
 		}
 	}
 
 
 	void PhysicsBase::_AddColliderToShape(ICollider* collider) {
-		// Create the bullet collision shape from the collider
-		btCollisionShape* newShape = collider->CreateShape();
-		collider->_shape = newShape;
+		// Our compound shape keeps the scale the object had when it was created, any scaling since then 
+		// is applied to the colliders directly, since their shapes may be shared between bodies
+		glm::vec3 relativeScale = _prevScale / ToGlm(_shape->getLocalScaling());
+
+		// Grab the bullet collision shape for the collider, this may be shared with other colliders
+		collider->_shape = collider->_AcquireShape(_scene->GetShapeCache(), collider->_scale * relativeScale);
+		btCollisionShape* newShape = collider->_shape.get();
 
 		// If the shape actually exists
 		if (newShape != nullptr) {
 			// We convert our shape parameters to a bullet transform
 			btTransform transform;
 			transform.setIdentity();
-			transform.setOrigin(ToBt(collider->_position));
+			transform.setOrigin(ToBt(collider->_position * relativeScale));
 			transform.setRotation(ToBt(glm::quat(glm::radians(collider->_rotation))));
-			newShape->setLocalScaling(ToBt(collider->_scale));
 
 			// Add the shape to the compound shape
 			_shape->addChildShape(transform, newShape);
@@ -192,8 +216,7 @@ int PhysicsBase::_editorSelectedColliderType = 0;
 			if (collider->_isDirty) {
 				// If the collider already had a shape, delete it
 				if (collider->_shape != nullptr) {
-					_shape->removeChildShape(collider->_shape);
-					delete collider->_shape;
+					_RemoveColliderFromShape(collider.get());
 				}
 				_AddColliderToShape(collider.get());
 				collider->_isDirty = false;
@@ -225,9 +248,19 @@ int PhysicsBase::_editorSelectedColliderType = 0;
 		transform.setOrigin(ToBt(context->GetPosition()));	 
 		transform.setRotation(ToBt(context->GetRotation()));
 		if (context->GetScale() != _prevScale) {
-			_shape->setLocalScaling(ToBt(context->GetScale()));
-			_scene->GetPhysicsWorld()->getBroadphase()->getOverlappingPairCache()->cleanProxyFromPairs(_GetBroadphaseHandle(), _scene->GetPhysicsWorld()->getDispatcher());
+			// We can't re-scale the compound shape, as that would modify our shared child shapes,
+			// so instead we swap each collider over to a shape with the new scale
 			_prevScale = context->GetScale();
+			for (auto& collider : _colliders) {
+				if (collider->_shape != nullptr) {
+					_shape->removeChildShape(collider->_shape.get());
+					collider->_shape = nullptr;
+				}
+			}
+			for (auto& collider : _colliders) {
+				_AddColliderToShape(collider.get());
+			}
+			_scene->GetPhysicsWorld()->getBroadphase()->getOverlappingPairCache()->cleanProxyFromPairs(_GetBroadphaseHandle(), _scene->GetPhysicsWorld()->getDispatcher());
 		}
 	}
 
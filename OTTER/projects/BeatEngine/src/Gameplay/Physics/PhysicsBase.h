@@ -70,6 +70,18 @@ namespace Gameplay {
 			void RemoveCollider(const ICollider::Sptr& collider);
 
 
+			/// <summary>
+			/// Adds or removes this object from the physics world. Objects that are not being
+			/// simulated keep all of their settings, and are re-synced with their gameobject
+			/// when they are re-enabled. Used by the scene to put far away objects to sleep
+			/// </summary>
+			/// <param name="value">True if the object should be part of the physics world</param>
+			virtual void SetSimulationEnabled(bool value) = 0;
+			/// <summary>
+			/// Gets whether this object is currently part of the physics world
+			/// </summary>
+			bool IsSimulationEnabled() const;
+
 			/// <summary>
 			/// Invoked for each RigidBody before the physics world is stepped forward a frame,
 			/// handles body initialization, shape changes, mass changes, etc...
@@ -103,6 +115,9 @@ namespace Gameplay {
 
 			glm::vec3 _prevScale;
 
+			// False if we've been pulled out of the physics world
+			bool _isSimulationEnabled;
+
 			PhysicsBase();
 
 			void _RenderImGuiBase();
@@ -112,6 +127,8 @@ namespace Gameplay {
 
 			// Handles adding a collider to our compound shape
 			void _AddColliderToShape(ICollider* collider);
+			// Handles removing a collider from our compound shape, without disturbing colliders that share it's shape
+			void _RemoveColliderFromShape(ICollider* collider);
 
 			// Handles resolving any dirty state stuff for our object
 			bool _HandleShapeDirty();
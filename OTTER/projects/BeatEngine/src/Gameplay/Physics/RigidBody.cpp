@@ -27,13 +27,20 @@ namespace Gameplay::Physics {
 		_angularVelocity(btVector3(0, 0, 0)),
 		_angularVelocityDirty(false),
 		_angularFactor(btVector3(1,1,1)),
-		_angularFactorDirty(false)
+		_angularFactorDirty(false),
+		_prevState(btTransform::getIdentity()),
+		_currState(btTransform::getIdentity()),
+		_hasStepState(false),
+		_syncedPosition(glm::vec3(0.0f)),
+		_syncedRotation(glm::quat(glm::vec3(0.0f)))
 	{ }
 
 	RigidBody::~RigidBody() {
 		if (_body != nullptr) {
 			// Remove from the physics world
-			_scene->GetPhysicsWorld()->removeRigidBody(_body);
+			if (_isSimulationEnabled) {
+				_scene->GetPhysicsWorld()->removeRigidBody(_body);
+			}
 
 			// Clean up all our memory
 			delete _motionState;
@@ -126,6 +133,8 @@ namespace Gameplay::Physics {
 
 	void RigidBody::SetType(RigidBodyType type) {
 		_type = type;
+		// Our interpolation states may be stale, force a re-sync from the gameobject
+		_hasStepState = false;
 		if (_body != nullptr) {
 			// Remove any static or kinematic flags for the object
 			int flags = _body->getCollisionFlags() & ~btCollisionObject::CF_STATIC_OBJECT;
@@ -151,29 +160,63 @@ namespace Gameplay::Physics {
 		return _type;
 	}
 
+	void RigidBody::SetSimulationEnabled(bool value) {
+		if (value == _isSimulationEnabled) return;
+		_isSimulationEnabled = value;
+
+		// If we haven't been awoken yet, Awake will handle adding us to the world
+		if (_body == nullptr) return;
+
+		if (value) {
+			_scene->GetPhysicsWorld()->addRigidBody(_body, _collisionGroup, _collisionMask);
+			// The gameobject may have moved while we were out of the world
+			_hasStepState = false;
+		} else {
+			_scene->GetPhysicsWorld()->removeRigidBody(_body);
+		}
+	}
+
 	void RigidBody::PhysicsPreStep(float dt) {
+		// Bodies outside of the world don't need any updates until they come back
+		if (!_isSimulationEnabled) return;
+
 		// Update any dirty state that may have changed
 		_HandleStateDirty();
 
 		if (_type != RigidBodyType::Static) {		
+			GameObject* context = GetGameObject();
 			btTransform transform;
 			_CopyGameobjectTransformTo(transform);
 
 			// Copy to body and to it's motion state
 			if (_type == RigidBodyType::Dynamic) {
-				_body->setWorldTransform(transform);
-			} else {
+				// Dynamics are driven by the simulation, so we only pull in moves made from outside of physics
+				if (!_hasStepState) {
+					// Our states are stale, start simulating from wherever the gameobject is
+					_body->setWorldTransform(transform);
+					_prevState = transform;
+					_currState = transform;
+					_hasStepState = true;
+				} else {
+					_ApplyOutsideMove();
+				}
+			} else if (!_hasStepState || context->IsPhysicsTransformDirty()) {
 				// Kinematics prefer to be driven my motion state for some reason :|
+				// Only push when the object actually moved, so that level geometry that is 
+				// sitting still doesn't disturb the broadphase
 				_body->getMotionState()->setWorldTransform(transform);
+				_hasStepState = true;
 			}
+			_syncedPosition = context->GetPosition();
+			_syncedRotation = context->GetRotation();
+			context->ClearPhysicsTransformDirty();
 		}
 	}
 
-	void RigidBody::PhysicsPostStep(float dt) {
-		// Kinematics are driven externally and statics don't move, so only need to get data out for dynamics!
-		if (_type == RigidBodyType::Dynamic) {
-			btTransform transform = _body->getWorldTransform();
-			_CopyGameobjectTransformFrom(transform);
+	void RigidBody::RecordPhysicsState() {
+		if (_type == RigidBodyType::Dynamic && _isSimulationEnabled) {
+			_prevState = _currState;
+			_currState = _body->getWorldTransform();
 
 			// Store a copy of our velocities
 			_linearVelocity = _body->getLinearVelocity();
@@ -181,6 +224,68 @@ namespace Gameplay::Physics {
 		}
 	}
 
+	void RigidBody::PhysicsPostStep(float dt) {
+		// Kinematics are driven externally and statics don't move, so only need to get data out for dynamics!
+		if (_type == RigidBodyType::Dynamic && _hasStepState && _isSimulationEnabled) {
+			// Frames that don't step still need to keep outside moves, or we'd overwrite them below
+			_ApplyOutsideMove();
+
+			// Blend between the last two simulated states based on how far we are into the next step
+			btScalar alpha = _scene->GetPhysicsInterpolation();
+			btTransform transform;
+			transform.setOrigin(_prevState.getOrigin().lerp(_currState.getOrigin(), alpha));
+			transform.setRotation(_prevState.getRotation().slerp(_currState.getRotation(), alpha));
+			_CopyGameobjectTransformFrom(transform);
+
+			// Remember what we wrote so we can tell how far someone else moves the object
+			GameObject* context = GetGameObject();
+			_syncedPosition = context->GetPosition();
+			_syncedRotation = context->GetRotation();
+			context->ClearPhysicsTransformDirty();
+		}
+	}
+
+	void RigidBody::_ApplyOutsideMove() {
+		GameObject* context = GetGameObject();
+		if (!context->IsPhysicsTransformDirty()) return;
+
+		// The gameobject holds our interpolated transform, which lags the simulation, so we apply the 
+		// move on top of the simulated states instead of pushing that transform back into bullet
+		glm::vec3 offset = context->GetPosition() - _syncedPosition;
+		glm::quat turn = context->GetRotation() * glm::inverse(_syncedRotation);
+		for (btTransform* state : { &_prevState, &_currState }) {
+			state->getOrigin() += ToBt(offset);
+			state->setRotation(ToBt(turn) * state->getRotation());
+		}
+		_body->setWorldTransform(_currState);
+
+		_syncedPosition = context->GetPosition();
+		_syncedRotation = context->GetRotation();
+		context->ClearPhysicsTransformDirty();
+	}
+
+	void RigidBody::ShiftOrigin(const glm::vec3& offset) {
+		btVector3 shift = ToBt(offset);
+
+		// Move our interpolation states along with the body, so that the move isn't 
+		// seen as a teleport and we keep blending smoothly
+		_prevState.getOrigin() += shift;
+		_currState.getOrigin() += shift;
+		_syncedPosition += offset;
+
+		if (_body != nullptr) {
+			btTransform transform = _body->getWorldTransform();
+			transform.getOrigin() += shift;
+			_body->setWorldTransform(transform);
+			_body->setInterpolationWorldTransform(transform);
+
+			btTransform motion;
+			_motionState->getWorldTransform(motion);
+			motion.getOrigin() += shift;
+			_motionState->setWorldTransform(motion);
+		}
+	}
+
 	void RigidBody::Awake() {
 		GameObject* context = GetGameObject();
 		_scene = context->GetScene();
@@ -214,12 +319,22 @@ namespace Gameplay::Physics {
 		transform.setRotation(ToBt(context->GetRotation()));
 		_motionState->setWorldTransform(transform);
 
+		// Our starting transform is both of our interpolation states
+		_prevState = transform;
+		_currState = transform;
+		_syncedPosition = context->GetPosition();
+		_syncedRotation = context->GetRotation();
+		_hasStepState = true;
+		context->ClearPhysicsTransformDirty();
+
 		// Create the bullet rigidbody and add it to the physics scene
 		_body = new btRigidBody(_mass, _motionState, _shape, _inertia);
 		// Add a pointer to our own weak reference to allow getting this component as a shared_ptr later
 		_body->setUserPointer(&SelfRef());
 
-		_scene->GetPhysicsWorld()->addRigidBody(_body);
+		if (_isSimulationEnabled) {
+			_scene->GetPhysicsWorld()->addRigidBody(_body);
+		}
 
 		// If the object is kinematic (driven by a controller), tell bullet that
 		if (_type == RigidBodyType::Kinematic) {
@@ -2,6 +2,7 @@
 #include <EnumToString.h>
 #include <btBulletCollisionCommon.h>
 #include <btBulletDynamicsCommon.h>
+#include <GLM/gtc/quaternion.hpp>
 
 #include "Gameplay/Components/IComponent.h"
 #include "Gameplay/Physics/ICollider.h"
@@ -163,11 +164,27 @@ namespace Gameplay::Physics {
 		/// <param name="dt">The time in seconds since the last frame</param>
 		virtual void PhysicsPreStep(float dt) override;
 		/// <summary>
-		/// Invoked for each RigidBody after the physics world is stepped forward a frame,
-		/// handles copying transform to the OpenGL state
+		/// Invoked for each RigidBody after the physics world has been stepped for the frame,
+		/// handles copying the transform to the OpenGL state, interpolating between the last
+		/// two simulated states using the scene's physics interpolation factor
 		/// </summary>
 		/// <param name="dt">The time in seconds since the last frame</param>
 		virtual void PhysicsPostStep(float dt) override;
+		/// <summary>
+		/// Invoked for each RigidBody after every fixed physics step, stores the body's
+		/// simulated state so that we can interpolate between steps when rendering
+		/// </summary>
+		void RecordPhysicsState();
+		/// <summary>
+		/// Moves the body by the given offset without affecting it's velocity or
+		/// interpolation, used when the scene scrolls or rebases it's origin. Note that
+		/// the gameobject should be moved by the same amount
+		/// </summary>
+		/// <param name="offset">The offset to move the body by, in world units</param>
+		void ShiftOrigin(const glm::vec3& offset);
+
+		// Inherited from PhysicsBase
+		virtual void SetSimulationEnabled(bool value) override;
 
 		// Inherited from IComponent
 		virtual void Awake() override;
@@ -202,8 +219,19 @@ namespace Gameplay::Physics {
 		btVector3        _angularFactor;
 		bool             _angularFactorDirty;
 
+		// The last two simulated transforms, used to interpolate our visual transform
+		btTransform      _prevState;
+		btTransform      _currState;
+		// False when our stored states no longer match the body (ex: after a type change)
+		bool             _hasStepState;
+		// The transform the gameobject had when we last synced with it, lets us work out how far outside changes moved it
+		glm::vec3        _syncedPosition;
+		glm::quat        _syncedRotation;
+
 		// Handles resolving any dirty state stuff for our object
 		void _HandleStateDirty();
+		// Carries a move made outside of physics (ex: by a controller) over to our simulated states
+		void _ApplyOutsideMove();
 
 		virtual btBroadphaseProxy* _GetBroadphaseHandle() override;
 	};
@@ -3,6 +3,7 @@
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 
 #include "Utils/GlmBulletConversions.h"
+#include "Utils/FrameArena.h"
 
 #include "Gameplay/GameObject.h"
 #include "Gameplay/Scene.h"
@@ -18,12 +19,31 @@ namespace Gameplay::Physics {
 
 	TriggerVolume::~TriggerVolume() {
 		if (_ghost != nullptr) {
-			_scene->GetPhysicsWorld()->removeCollisionObject(_ghost);
+			if (_isSimulationEnabled) {
+				_scene->GetPhysicsWorld()->removeCollisionObject(_ghost);
+			}
 			delete _ghost;
 		}
 	}
 
+	void TriggerVolume::SetSimulationEnabled(bool value) {
+		if (value == _isSimulationEnabled) return;
+		_isSimulationEnabled = value;
+
+		// If we haven't been awoken yet, Awake will handle adding us to the world
+		if (_ghost == nullptr) return;
+
+		if (value) {
+			_scene->GetPhysicsWorld()->addCollisionObject(_ghost, _collisionGroup, _collisionMask);
+		} else {
+			_scene->GetPhysicsWorld()->removeCollisionObject(_ghost);
+		}
+	}
+
 	void TriggerVolume::PhysicsPreStep(float dt) {
+		// Volumes outside of the world keep their last known contacts until they come back
+		if (!_isSimulationEnabled) return;
+
 		// Update any dirty state that may have changed
 		_HandleShapeDirty();
 		_HandleGroupDirty();
@@ -37,8 +57,10 @@ namespace Gameplay::Physics {
 	}
 
 	void TriggerVolume::PhysicsPostStep(float dt) {
-		// This will store all the objects inside the trigger this frame
-		std::vector<std::weak_ptr<RigidBody>> thisFrameCollision;
+		if (!_isSimulationEnabled) return;
+
+		// This will store all the objects inside the trigger this frame, it's thrown away once we're done so it can live in the frame arena
+		FrameVector<std::weak_ptr<RigidBody>> thisFrameCollision;
 
 		// Get all our collisions from from the world
 		_scene->GetPhysicsWorld()->getDispatcher()->dispatchAllCollisionPairs(_ghost->getOverlappingPairCache(), _scene->GetPhysicsWorld()->getDispatchInfo(), _scene->GetPhysicsWorld()->getDispatcher());
@@ -131,8 +153,8 @@ namespace Gameplay::Physics {
 			}
 		}
 
-		// Load the contents of the current collision items into the cache
-		_currentCollisions.swap(thisFrameCollision);
+		// Load the contents of the current collision items into the cache, copying so the cache keeps it's capacity
+		_currentCollisions.assign(thisFrameCollision.begin(), thisFrameCollision.end());
 	}
 
 	void TriggerVolume::Awake() {
@@ -164,12 +186,10 @@ namespace Gameplay::Physics {
 		_CopyGameobjectTransformTo(transform);
 		_ghost->setWorldTransform(transform);
 
-		// Add the object to the scene
-		_scene->GetPhysicsWorld()->addCollisionObject(_ghost);
-		
-		// Copy over group and mask info
-		_ghost->getBroadphaseHandle()->m_collisionFilterGroup = _collisionGroup;
-		_ghost->getBroadphaseHandle()->m_collisionFilterMask  = _collisionMask;
+		// Add the object to the scene, with our group and mask info
+		if (_isSimulationEnabled) {
+			_scene->GetPhysicsWorld()->addCollisionObject(_ghost, _collisionGroup, _collisionMask);
+		}
 	}
 
 	void TriggerVolume::RenderImGui() {
@@ -39,6 +39,9 @@ namespace Gameplay::Physics {
 		/// <param name="dt">The time in seconds since the last frame</param>
 		virtual void PhysicsPostStep(float dt) override;
 
+		// Inherited from PhysicsBase
+		virtual void SetSimulationEnabled(bool value) override;
+
 		void SetFlags(TriggerTypeFlags flags);
 		TriggerTypeFlags GetFlags() const;
 
@@ -3,13 +3,23 @@
 #include <GLFW/glfw3.h>
 #include <locale>
 #include <codecvt>
+#include <limits>
 
 #include "Utils/FileHelpers.h"
 #include "Utils/GlmBulletConversions.h"
+#include "Utils/JsonGlmHelpers.h"
+#include "Utils/Profiler.h"
+#include "Utils/MemoryTracker.h"
+
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
 
 #include "Gameplay/Physics/RigidBody.h"
 #include "Gameplay/Physics/TriggerVolume.h"
+#include "Gameplay/Physics/BulletTaskScheduler.h"
 #include "Gameplay/MeshResource.h"
+#include "Gameplay/Components/GUI/RectTransform.h"
 #include "Gameplay/Material.h"
 
 #include "Graphics/DebugDraw.h"
@@ -32,7 +42,23 @@ namespace Gameplay {
 		_skyboxTexture(nullptr),
 		_skyboxRotation(glm::mat3(1.0f)),
 		_ambientLight(glm::vec3(0.1f)),
-		_gravity(glm::vec3(0.0f, 0.0f, -30.0f))
+		_gravity(glm::vec3(0.0f, 0.0f, -30.0f)),
+		_physicsTimestep(1.0f / 120.0f),
+		_maxPhysicsSubSteps(8),
+		_physicsAccumulator(0.0f),
+		_physicsInterpolation(1.0f),
+		_physicsThreads(1),
+		_worldScrollEnabled(false),
+		_worldScrollVelocity(glm::vec3(1.0f, 0.0f, 0.0f)),
+		_worldScrollOffset(glm::vec3(0.0f)),
+		_originOffset(glm::dvec3(0.0)),
+		_originRebaseDistance(100.0f),
+		_scrollFollowers(),
+		_activationRadius(0.0f),
+		_activationAnchors(),
+		_activeObjectCount(0),
+		_dormantObjectCount(0),
+		_constraintSolverMt(nullptr)
 	{
 		GameObject::Sptr mainCam = CreateGameObject("Main Camera");		
 		MainCamera = mainCam->Add<Camera>();
@@ -98,6 +124,9 @@ namespace Gameplay {
 
 	GameObject::Sptr Scene::CreateGameObject(const std::string& name)
 	{
+		// Objects can be spawned mid-update as well as while loading, either way they belong to the scene
+		MEMORY_TAG(MemoryTag::Scene);
+
 		GameObject::Sptr result(new GameObject());
 		result->Name = name;
 		result->_scene = this;
@@ -160,24 +189,327 @@ namespace Gameplay {
 	}
 
 	void Scene::DoPhysics(float dt) {
-		_components.Each<Gameplay::Physics::RigidBody>([=](const std::shared_ptr<Gameplay::Physics::RigidBody>& body) {
-			body->PhysicsPreStep(dt);
+		using namespace Gameplay::Physics;
+		PROFILE_ZONE("Physics");
+
+		// When not playing, we still let bodies handle initialization and shape changes,
+		// but we don't advance the simulation
+		if (!IsPlaying) {
+			_components.Each<RigidBody>([=](const std::shared_ptr<RigidBody>& body) {
+				body->PhysicsPreStep(dt);
+			});
+			_components.Each<TriggerVolume>([=](const std::shared_ptr<TriggerVolume>& body) {
+				body->PhysicsPreStep(dt);
+			});
+			_physicsAccumulator = 0.0f;
+			_physicsInterpolation = 1.0f;
+			return;
+		}
+
+		// Consume as much of the frame time as we can in fixed steps
+		_physicsAccumulator += dt;
+		int steps = 0;
+		while (_physicsAccumulator >= _physicsTimestep && steps < _maxPhysicsSubSteps) {
+			_StepPhysics(_physicsTimestep);
+			_physicsAccumulator -= _physicsTimestep;
+			steps++;
+		}
+
+		// If we've hit our step limit we're falling behind, drop the backlog instead of 
+		// trying to catch up next frame (which would only make the next frame slower)
+		if (_physicsAccumulator >= _physicsTimestep) {
+			_physicsAccumulator = fmodf(_physicsAccumulator, _physicsTimestep);
+		}
+
+		// Let the bodies blend between their last two states based on the leftover time
+		_physicsInterpolation = _physicsAccumulator / _physicsTimestep;
+		_components.Each<RigidBody>([=](const std::shared_ptr<RigidBody>& body) {
+			body->PhysicsPostStep(dt);
 		});
-		_components.Each<Gameplay::Physics::TriggerVolume>([=](const std::shared_ptr<Gameplay::Physics::TriggerVolume>& body) {
-			body->PhysicsPreStep(dt);
+	}
+
+	void Scene::SetPhysicsTimestep(float value) {
+		LOG_ASSERT(value > 0.0f, "Physics timestep must be greater than zero!");
+		_physicsTimestep = value;
+	}
+
+	float Scene::GetPhysicsTimestep() const {
+		return _physicsTimestep;
+	}
+
+	void Scene::SetMaxPhysicsSubSteps(int value) {
+		_maxPhysicsSubSteps = value < 1 ? 1 : value;
+	}
+
+	int Scene::GetMaxPhysicsSubSteps() const {
+		return _maxPhysicsSubSteps;
+	}
+
+	float Scene::GetPhysicsInterpolation() const {
+		return _physicsInterpolation;
+	}
+
+	void Scene::SetPhysicsThreadCount(int value) {
+		value = glm::clamp(value, 1, (int)BT_MAX_THREAD_COUNT);
+		#if !BT_THREADSAFE
+		// Without BT_THREADSAFE bullet's Mt classes skip their locking and thread indices, 
+		// so running them on more than one thread would race
+		if (value > 1) {
+			LOG_WARN("Bullet was built without BT_THREADSAFE, ignoring request for {} physics threads", value);
+			value = 1;
+		}
+		#endif
+		if (value == _physicsThreads) return;
+
+		// Pull all the objects out of the current world, remembering their collision filters
+		struct CollisionEntry {
+			btCollisionObject* Object;
+			int                Group;
+			int                Mask;
+		};
+		std::vector<CollisionEntry> entries;
+		btCollisionObjectArray& objects = _physicsWorld->getCollisionObjectArray();
+		entries.reserve(objects.size());
+		for (int ix = objects.size() - 1; ix >= 0; ix--) {
+			btCollisionObject* object = objects[ix];
+			btBroadphaseProxy* proxy = object->getBroadphaseHandle();
+			entries.push_back({ object, proxy->m_collisionFilterGroup, proxy->m_collisionFilterMask });
+
+			btRigidBody* body = btRigidBody::upcast(object);
+			if (body != nullptr) {
+				_physicsWorld->removeRigidBody(body);
+			} else {
+				_physicsWorld->removeCollisionObject(object);
+			}
+		}
+
+		// Rebuild the world with the new threading config, keeping our debug draw mode
+		BulletDebugMode debugMode = GetPhysicsDebugDrawMode();
+		_CleanupPhysics();
+		_physicsThreads = value;
+		_InitPhysics();
+		SetPhysicsDebugDrawMode(debugMode);
+
+		// Add everything back in the order it was originally added
+		for (auto it = entries.rbegin(); it != entries.rend(); it++) {
+			btRigidBody* body = btRigidBody::upcast(it->Object);
+			if (body != nullptr) {
+				_physicsWorld->addRigidBody(body, it->Group, it->Mask);
+			} else {
+				_physicsWorld->addCollisionObject(it->Object, it->Group, it->Mask);
+			}
+		}
+	}
+
+	int Scene::GetPhysicsThreadCount() const {
+		return _physicsThreads;
+	}
+
+	void Scene::SetWorldScrollEnabled(bool value) {
+		_worldScrollEnabled = value;
+	}
+
+	bool Scene::IsWorldScrollEnabled() const {
+		return _worldScrollEnabled;
+	}
+
+	void Scene::SetWorldScrollVelocity(const glm::vec3& value) {
+		_worldScrollVelocity = value;
+	}
+
+	const glm::vec3& Scene::GetWorldScrollVelocity() const {
+		return _worldScrollVelocity;
+	}
+
+	const glm::vec3& Scene::GetWorldScrollOffset() const {
+		return _worldScrollOffset;
+	}
+
+	glm::dvec3 Scene::GetTotalWorldScroll() const {
+		return _originOffset + glm::dvec3(_worldScrollOffset);
+	}
+
+	void Scene::SetOriginRebaseDistance(float value) {
+		_originRebaseDistance = glm::max(value, 0.0f);
+	}
+
+	float Scene::GetOriginRebaseDistance() const {
+		return _originRebaseDistance;
+	}
+
+	void Scene::AddScrollFollower(const GameObject::Sptr& object) {
+		LOG_ASSERT(object->GetScene() == this, "Scroll followers must belong to this scene!");
+		RemoveScrollFollower(object);
+		_scrollFollowers.push_back(object);
+	}
+
+	void Scene::RemoveScrollFollower(const GameObject::Sptr& object) {
+		_scrollFollowers.erase(std::remove_if(_scrollFollowers.begin(), _scrollFollowers.end(), [&](const std::weak_ptr<GameObject>& ptr) {
+			return ptr.expired() || ptr.lock() == object;
+		}), _scrollFollowers.end());
+	}
+
+	void Scene::RebaseOrigin(const glm::vec3& shift) {
+		using namespace Gameplay::Physics;
+
+		// Children are positioned relative to their parents, so only roots need to move
+		for (const auto& object : _objects) {
+			if (object->GetParent() == nullptr) {
+				object->SetPostion(object->GetPosition() - shift);
+			}
+		}
+
+		// Bodies are in world space, shift them directly so that their velocities and
+		// interpolation states carry over and we don't treat this as a teleport
+		_components.Each<RigidBody>([&](const std::shared_ptr<RigidBody>& body) {
+			body->ShiftOrigin(-shift);
 		});
 
-		if (IsPlaying) {
+		_originOffset += glm::dvec3(shift);
+		_worldScrollOffset -= shift;
+
+		LOG_INFO("Rebased scene origin by ({}, {}, {})", shift.x, shift.y, shift.z);
+	}
 
-			_physicsWorld->stepSimulation(dt, 1);
+	void Scene::SetActivationRadius(float value) {
+		_activationRadius = glm::max(value, 0.0f);
+	}
 
-			_components.Each<Gameplay::Physics::RigidBody>([=](const std::shared_ptr<Gameplay::Physics::RigidBody>& body) {
-				body->PhysicsPostStep(dt);
-			});
-			_components.Each<Gameplay::Physics::TriggerVolume>([=](const std::shared_ptr<Gameplay::Physics::TriggerVolume>& body) {
-				body->PhysicsPostStep(dt);
-			});
+	float Scene::GetActivationRadius() const {
+		return _activationRadius;
+	}
+
+	void Scene::AddActivationAnchor(const GameObject::Sptr& object) {
+		LOG_ASSERT(object->GetScene() == this, "Activation anchors must belong to this scene!");
+		RemoveActivationAnchor(object);
+		_activationAnchors.push_back(object);
+	}
+
+	void Scene::RemoveActivationAnchor(const GameObject::Sptr& object) {
+		_activationAnchors.erase(std::remove_if(_activationAnchors.begin(), _activationAnchors.end(), [&](const std::weak_ptr<GameObject>& ptr) {
+			return ptr.expired() || ptr.lock() == object;
+		}), _activationAnchors.end());
+	}
+
+	int Scene::GetActiveObjectCount() const {
+		return _activeObjectCount;
+	}
+
+	int Scene::GetDormantObjectCount() const {
+		return _dormantObjectCount;
+	}
+
+	void Scene::_UpdateActivation() {
+		PROFILE_ZONE("Activation");
+
+		// Collect the points that we keep objects active around
+		std::vector<glm::vec3> anchors;
+		anchors.reserve(_activationAnchors.size() + 1);
+		if (MainCamera != nullptr) {
+			anchors.push_back(MainCamera->GetGameObject()->GetWorldPosition());
+		}
+		for (auto it = _activationAnchors.begin(); it != _activationAnchors.end();) {
+			GameObject::Sptr anchor = it->lock();
+			if (anchor == nullptr) {
+				it = _activationAnchors.erase(it);
+				continue;
+			}
+			anchors.push_back(anchor->GetWorldPosition());
+			it++;
+		}
+
+		// Objects have to come a bit closer to wake up than they have to go to fall asleep, 
+		// so that objects sitting right on the boundary don't flicker between states
+		const float wakeDistSq  = _activationRadius * _activationRadius;
+		const float sleepDistSq = wakeDistSq * 1.1f * 1.1f;
+		const bool  enabled     = _activationRadius > 0.0f && !anchors.empty();
+
+		_activeObjectCount  = 0;
+		_dormantObjectCount = 0;
+		for (const auto& object : _objects) {
+			bool dormant = false;
+			// UI elements don't live in world space, so they're never put to sleep
+			if (enabled && !object->AlwaysActive && !object->Has<RectTransform>()) {
+				glm::vec3 position = object->GetWorldPosition();
+				float closestSq = std::numeric_limits<float>::max();
+				for (const auto& anchor : anchors) {
+					glm::vec3 delta = position - anchor;
+					closestSq = glm::min(closestSq, glm::dot(delta, delta));
+				}
+				dormant = closestSq > (object->_isDormant ? wakeDistSq : sleepDistSq);
+			}
+
+			if (dormant != object->_isDormant) {
+				_SetDormant(object, dormant);
+			}
+			if (dormant) {
+				_dormantObjectCount++;
+			} else {
+				_activeObjectCount++;
+			}
+		}
+	}
+
+	void Scene::_SetDormant(const GameObject::Sptr& object, bool dormant) {
+		using namespace Gameplay::Physics;
+
+		object->_isDormant = dormant;
+
+		RigidBody::Sptr body = object->Get<RigidBody>();
+		if (body != nullptr) {
+			body->SetSimulationEnabled(!dormant);
+		}
+		TriggerVolume::Sptr volume = object->Get<TriggerVolume>();
+		if (volume != nullptr) {
+			volume->SetSimulationEnabled(!dormant);
+		}
+	}
+
+	void Scene::_ScrollWorld(float dt) {
+		using namespace Gameplay::Physics;
+
+		glm::vec3 delta = _worldScrollVelocity * dt;
+		_worldScrollOffset += delta;
+
+		for (auto it = _scrollFollowers.begin(); it != _scrollFollowers.end();) {
+			GameObject::Sptr object = it->lock();
+			if (object == nullptr) {
+				it = _scrollFollowers.erase(it);
+				continue;
+			}
+
+			object->SetPostion(object->GetPosition() + delta);
+			// Carry the body along with the object so it's not seen as a teleport
+			RigidBody::Sptr body = object->Get<RigidBody>();
+			if (body != nullptr) {
+				body->ShiftOrigin(delta);
+			}
+			it++;
+		}
+	}
+
+	void Scene::_StepPhysics(float step) {
+		using namespace Gameplay::Physics;
+
+		_components.Each<RigidBody>([=](const std::shared_ptr<RigidBody>& body) {
+			body->PhysicsPreStep(step);
+		});
+		_components.Each<TriggerVolume>([=](const std::shared_ptr<TriggerVolume>& body) {
+			body->PhysicsPreStep(step);
+		});
+
+		// We handle our own substepping, so tell bullet to take exactly one step
+		{
+			PROFILE_ZONE("StepSimulation");
+			_physicsWorld->stepSimulation(step, 0);
 		}
+
+		_components.Each<RigidBody>([=](const std::shared_ptr<RigidBody>& body) {
+			body->RecordPhysicsState();
+		});
+		_components.Each<TriggerVolume>([=](const std::shared_ptr<TriggerVolume>& body) {
+			body->PhysicsPostStep(step);
+		});
 	}
 
 	void Scene::DrawPhysicsDebug() {
@@ -188,13 +520,26 @@ namespace Gameplay {
 	}
 
 	void Scene::Update(float dt) {
+		PROFILE_ZONE("Scene::Update");
 		_FlushDeleteQueue();
 		if (IsPlaying) {
+			if (_worldScrollEnabled) {
+				_ScrollWorld(dt);
+			}
+			_UpdateActivation();
 			for (int i = 0; i < _objects.size(); i++) {
-				_objects[i]->Update(dt);
+				if (!_objects[i]->_isDormant) {
+					_objects[i]->Update(dt);
+				}
 			}
 		}
 		_FlushDeleteQueue();
+
+		// Pull everything back towards the origin once we've scrolled far enough that
+		// we'd start to lose precision
+		if (_worldScrollEnabled && _originRebaseDistance > 0.0f && glm::length(_worldScrollOffset) >= _originRebaseDistance) {
+			RebaseOrigin(_worldScrollOffset);
+		}
 	}
 
 	void Scene::RenderGUI()
@@ -211,8 +556,13 @@ namespace Gameplay {
 		return _physicsWorld;
 	}
 
+	Physics::CollisionShapeCache& Scene::GetShapeCache() {
+		return _shapeCache;
+	}
+
 	Scene::Sptr Scene::FromJson(const nlohmann::json& data)
 	{
+		MEMORY_TAG(MemoryTag::Scene);
 
 		Scene::Sptr result = std::make_shared<Scene>();
 		result->MainCamera = nullptr;
@@ -223,6 +573,16 @@ namespace Gameplay {
 			result->SetAmbientLight((data["ambient"]));
 		}
 
+		// Objects have not been added to the world yet, so switching now is cheap
+		result->SetPhysicsThreadCount(JsonGet(data, "physics_threads", 1));
+
+		if (data.contains("world_scroll") && data["world_scroll"].is_object()) {
+			const nlohmann::json& blob = data["world_scroll"];
+			result->SetWorldScrollEnabled(JsonGet(blob, "enabled", false));
+			result->SetWorldScrollVelocity(JsonGet(blob, "velocity", result->_worldScrollVelocity));
+			result->SetOriginRebaseDistance(JsonGet(blob, "rebase_distance", result->_originRebaseDistance));
+		}
+
 		if (data.contains("skybox") && data["skybox"].is_object()) {
 			nlohmann::json& blob = data["skybox"].get<nlohmann::json>();
 			result->_skyboxMesh = ResourceManager::Get<MeshResource>(Guid(blob["mesh"]));
@@ -251,6 +611,29 @@ namespace Gameplay {
 		// Create and load camera config
 		result->MainCamera = result->_components.GetComponentByGUID<Camera>(Guid(data["main_camera"]));
 	
+		// Activation anchors are stored by GUID, so we can only resolve them once all objects are loaded
+		if (data.contains("activation") && data["activation"].is_object()) {
+			result->SetActivationRadius(JsonGet(data["activation"], "radius", 0.0f));
+			if (data["activation"].contains("anchors")) {
+				for (auto& guid : data["activation"]["anchors"]) {
+					GameObject::Sptr anchor = result->FindObjectByGUID(Guid(guid.get<std::string>()));
+					if (anchor != nullptr) {
+						result->AddActivationAnchor(anchor);
+					}
+				}
+			}
+		}
+
+		// Scroll followers are stored by GUID, so we can only resolve them once all objects are loaded
+		if (data.contains("world_scroll") && data["world_scroll"].is_object() && data["world_scroll"].contains("followers")) {
+			for (auto& guid : data["world_scroll"]["followers"]) {
+				GameObject::Sptr follower = result->FindObjectByGUID(Guid(guid.get<std::string>()));
+				if (follower != nullptr) {
+					result->AddScrollFollower(follower);
+				}
+			}
+		}
+	
 		return result;
 	}
 
@@ -261,6 +644,29 @@ namespace Gameplay {
 		blob["default_material"] = DefaultMaterial ? DefaultMaterial->GetGUID().str() : "null";
 
 		blob["ambient"] = GetAmbientLight();
+		blob["physics_threads"] = _physicsThreads;
+
+		blob["world_scroll"] = nlohmann::json();
+		blob["world_scroll"]["enabled"] = _worldScrollEnabled;
+		blob["world_scroll"]["velocity"] = _worldScrollVelocity;
+		blob["world_scroll"]["rebase_distance"] = _originRebaseDistance;
+		std::vector<std::string> followers;
+		for (const auto& ptr : _scrollFollowers) {
+			if (!ptr.expired()) {
+				followers.push_back(ptr.lock()->_guid.str());
+			}
+		}
+		blob["world_scroll"]["followers"] = followers;
+
+		blob["activation"] = nlohmann::json();
+		blob["activation"]["radius"] = _activationRadius;
+		std::vector<std::string> anchors;
+		for (const auto& ptr : _activationAnchors) {
+			if (!ptr.expired()) {
+				anchors.push_back(ptr.lock()->_guid.str());
+			}
+		}
+		blob["activation"]["anchors"] = anchors;
 
 		blob["skybox"] = nlohmann::json();
 		blob["skybox"]["mesh"] = _skyboxMesh ? _skyboxMesh->GetGUID().str() : "null";
@@ -308,18 +714,46 @@ namespace Gameplay {
 	}
 
 	void Scene::_InitPhysics() {
-		_collisionConfig = new btDefaultCollisionConfiguration();
-		_collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
+		if (_physicsThreads > 1) {
+			// The multithreaded classes dispatch their work through bullet's global task scheduler
+			Physics::BulletTaskScheduler::Activate(_physicsThreads);
+
+			// Each thread may be allocating manifolds and algorithms at the same time, so we
+			// size the pools up front rather than letting them overflow to the heap
+			btDefaultCollisionConstructionInfo info;
+			info.m_defaultMaxPersistentManifoldPoolSize = 80000;
+			info.m_defaultMaxCollisionAlgorithmPoolSize = 80000;
+			_collisionConfig = new btDefaultCollisionConfiguration(info);
+			_collisionDispatcher = new btCollisionDispatcherMt(_collisionConfig, 40);
+		} else {
+			_collisionConfig = new btDefaultCollisionConfiguration();
+			_collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
+		}
 		_broadphaseInterface = new btDbvtBroadphase();
 		_ghostCallback = new btGhostPairCallback();
 		_broadphaseInterface->getOverlappingPairCache()->setInternalGhostPairCallback(_ghostCallback);
-		_constraintSolver = new btSequentialImpulseConstraintSolver();
-		_physicsWorld = new btDiscreteDynamicsWorld(
-			_collisionDispatcher,
-			_broadphaseInterface,
-			_constraintSolver,
-			_collisionConfig
-		);
+		if (_physicsThreads > 1) {
+			// Small islands are solved in parallel by the pool, large ones by the Mt solver
+			btConstraintSolverPoolMt* solverPool = new btConstraintSolverPoolMt(_physicsThreads);
+			_constraintSolver = solverPool;
+			_constraintSolverMt = new btSequentialImpulseConstraintSolverMt();
+			_physicsWorld = new btDiscreteDynamicsWorldMt(
+				_collisionDispatcher,
+				_broadphaseInterface,
+				solverPool,
+				_constraintSolverMt,
+				_collisionConfig
+			);
+		} else {
+			_constraintSolver = new btSequentialImpulseConstraintSolver();
+			_constraintSolverMt = nullptr;
+			_physicsWorld = new btDiscreteDynamicsWorld(
+				_collisionDispatcher,
+				_broadphaseInterface,
+				_constraintSolver,
+				_collisionConfig
+			);
+		}
 		_physicsWorld->setGravity(ToBt(_gravity));
 		// TODO bullet debug drawing
 		_bulletDebugDraw = new BulletDebugDraw();
@@ -329,11 +763,14 @@ namespace Gameplay {
 
 	void Scene::_CleanupPhysics() {
 		delete _physicsWorld;
+		delete _constraintSolverMt;
 		delete _constraintSolver;
 		delete _broadphaseInterface;
 		delete _ghostCallback;
 		delete _collisionDispatcher;
 		delete _collisionConfig;
+		delete _bulletDebugDraw;
+		_constraintSolverMt = nullptr;
 	}
 
 
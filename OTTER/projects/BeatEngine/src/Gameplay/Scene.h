@@ -6,6 +6,7 @@
 #include "Gameplay/GameObject.h"
 
 #include "Physics/BulletDebugDraw.h"
+#include "Physics/CollisionShapeCache.h"
 
 #include "Graphics/Buffers/UniformBuffer.h"
 #include "Graphics/Textures/Texture3D.h"
@@ -123,10 +124,143 @@ namespace Gameplay {
 		/// Performs physics updates for all physics bodies in this scene,
 		/// should be called after Update in the main loop
 		/// 
+		/// The frame time is accumulated and the world is advanced in steps of
+		/// the fixed physics timestep, after which rigid bodies interpolate their
+		/// visual transforms between the last two simulated states
+		/// 
 		/// Only invokes events if IsPlaying is true
 		/// </summary>
 		/// <param name="dt">The time in seconds since the last frame</param>
 		void DoPhysics(float dt);
+
+		/// <summary>
+		/// Sets the length of a single physics step, in seconds
+		/// </summary>
+		/// <param name="value">The new fixed timestep, should be greater than zero</param>
+		void SetPhysicsTimestep(float value);
+		/// <summary>
+		/// Gets the length of a single physics step, in seconds
+		/// </summary>
+		float GetPhysicsTimestep() const;
+
+		/// <summary>
+		/// Sets the maximum number of physics steps that may be taken in a single frame. If
+		/// a frame takes longer than this many steps, the remaining time is dropped so that
+		/// we never spiral trying to catch up
+		/// </summary>
+		/// <param name="value">The new maximum step count, should be at least 1</param>
+		void SetMaxPhysicsSubSteps(int value);
+		/// <summary>
+		/// Gets the maximum number of physics steps that may be taken in a single frame
+		/// </summary>
+		int GetMaxPhysicsSubSteps() const;
+
+		/// <summary>
+		/// Gets how far we are between the last two physics steps, in the 0-1 range. 
+		/// Used by rigid bodies to interpolate their rendered transforms
+		/// </summary>
+		float GetPhysicsInterpolation() const;
+
+		/// <summary>
+		/// Sets the number of threads that the physics world can use. A value of 1 uses
+		/// the single threaded Bullet world, any higher value switches to Bullet's multithreaded
+		/// world, dispatcher and solver pool, backed by our own task scheduler. Existing 
+		/// bodies are carried over to the new world
+		/// 
+		/// Only takes effect when Bullet is built with BT_THREADSAFE, otherwise this logs
+		/// a warning and the world stays single threaded
+		/// </summary>
+		/// <param name="value">The number of threads to use, including the main thread</param>
+		void SetPhysicsThreadCount(int value);
+		/// <summary>
+		/// Gets the number of threads that the physics world can use, 1 if single threaded
+		/// </summary>
+		int GetPhysicsThreadCount() const;
+
+		/// <summary>
+		/// Enables or disables world scroll mode. When enabled the level geometry stays
+		/// put, and instead the scroll followers (ex: the player and camera) advance by 
+		/// the world scroll velocity every frame. Level behaviours use the scroll offset
+		/// to work in view-relative space
+		/// </summary>
+		/// <param name="value">True to enable world scrolling, false to move the level instead</param>
+		void SetWorldScrollEnabled(bool value);
+		/// <summary>
+		/// Gets whether world scroll mode is enabled for this scene
+		/// </summary>
+		bool IsWorldScrollEnabled() const;
+		/// <summary>
+		/// Sets the speed and direction that the view advances through the level, in units per second
+		/// </summary>
+		void SetWorldScrollVelocity(const glm::vec3& value);
+		/// <summary>
+		/// Gets the speed and direction that the view advances through the level, in units per second
+		/// </summary>
+		const glm::vec3& GetWorldScrollVelocity() const;
+		/// <summary>
+		/// Gets how far the view has scrolled since the last origin rebase. Subtract this 
+		/// from a position to get it relative to where the view started
+		/// </summary>
+		const glm::vec3& GetWorldScrollOffset() const;
+		/// <summary>
+		/// Gets the total distance the view has scrolled since the scene started, 
+		/// including any distance that has been removed by origin rebasing
+		/// </summary>
+		glm::dvec3 GetTotalWorldScroll() const;
+		/// <summary>
+		/// Sets how far the view may scroll before we shift the scene back towards the origin,
+		/// keeps coordinates small so that we don't lose float precision. 0 to disable
+		/// </summary>
+		void SetOriginRebaseDistance(float value);
+		/// <summary>
+		/// Gets how far the view may scroll before we shift the scene back towards the origin
+		/// </summary>
+		float GetOriginRebaseDistance() const;
+
+		/// <summary>
+		/// Adds an object that will advance with the view while world scrolling is enabled
+		/// </summary>
+		/// <param name="object">The object to add, should be a root object</param>
+		void AddScrollFollower(const GameObject::Sptr& object);
+		/// <summary>
+		/// Removes an object from the list of objects that advance with the view
+		/// </summary>
+		void RemoveScrollFollower(const GameObject::Sptr& object);
+
+		/// <summary>
+		/// Moves every root object and physics body in the scene by -shift in a single
+		/// pass, without disturbing velocities or physics interpolation
+		/// </summary>
+		/// <param name="shift">The position that will become the new origin</param>
+		void RebaseOrigin(const glm::vec3& shift);
+
+		/// <summary>
+		/// Sets the radius of the activation region around the main camera and any activation
+		/// anchors. Objects outside of the region go dormant, they stop updating and their
+		/// physics bodies are pulled out of the world until they come back. 0 to disable
+		/// </summary>
+		/// <param name="value">The new radius, in world units</param>
+		void SetActivationRadius(float value);
+		/// <summary>
+		/// Gets the radius of the activation region, 0 if disabled
+		/// </summary>
+		float GetActivationRadius() const;
+		/// <summary>
+		/// Adds an object that objects will stay active around, in addition to the main camera
+		/// </summary>
+		void AddActivationAnchor(const GameObject::Sptr& object);
+		/// <summary>
+		/// Removes an object from the list of activation anchors
+		/// </summary>
+		void RemoveActivationAnchor(const GameObject::Sptr& object);
+		/// <summary>
+		/// Gets the number of objects that were inside the activation region this frame
+		/// </summary>
+		int GetActiveObjectCount() const;
+		/// <summary>
+		/// Gets the number of objects that were dormant this frame
+		/// </summary>
+		int GetDormantObjectCount() const;
 		/// <summary>
 		/// Renders debug information for the physics scene
 		/// </summary>
@@ -158,6 +292,10 @@ namespace Gameplay {
 		/// Gets the scene's Bullet physics world
 		/// </summary>
 		btDynamicsWorld* GetPhysicsWorld() const;
+		/// <summary>
+		/// Gets the cache that shares collision shapes between the colliders in this scene
+		/// </summary>
+		Physics::CollisionShapeCache& GetShapeCache();
 
 		/// <summary>
 		/// Loads a scene from a JSON blob
@@ -203,9 +341,14 @@ namespace Gameplay {
 		// Provides rough broadphase (AABB) checks to improve performance
 		btBroadphaseInterface*    _broadphaseInterface;
 		// Resolves contraints (ex: hinge constraints, angle axis, etc...)
+		// When multithreaded, this is a pool of solvers that islands are spread across
 		btConstraintSolver*       _constraintSolver;
+		// Multithreaded solver for large islands, only used by the multithreaded world
+		btConstraintSolver*       _constraintSolverMt;
 		// this is what allows us to get our pairs from the trigger volumes
 		btGhostPairCallback*      _ghostCallback;
+		// Shares identical collision shapes between the bodies in this scene
+		Physics::CollisionShapeCache _shapeCache;
 
 		BulletDebugDraw* _bulletDebugDraw;
 
@@ -215,6 +358,38 @@ namespace Gameplay {
 		// Our physics scene's global gravity, default matches earth's gravity (m/s^2)
 		glm::vec3 _gravity;
 
+		// The length of a single physics step, in seconds
+		float _physicsTimestep;
+		// The maximum number of physics steps we can take in a frame
+		int   _maxPhysicsSubSteps;
+		// Stores frame time that has not yet been consumed by a physics step
+		float _physicsAccumulator;
+		// How far we are between the previous and current physics state (0-1)
+		float _physicsInterpolation;
+		// The number of threads the physics world may use, 1 for single threaded
+		int   _physicsThreads;
+
+		// True if the view scrolls through the level instead of the level moving
+		bool      _worldScrollEnabled;
+		// How fast and in which direction the view advances, in units per second
+		glm::vec3 _worldScrollVelocity;
+		// How far the view has scrolled since the last rebase
+		glm::vec3 _worldScrollOffset;
+		// The total distance removed from the scene by origin rebases
+		glm::dvec3 _originOffset;
+		// How far we can scroll before rebasing, 0 to never rebase
+		float     _originRebaseDistance;
+		// Objects that advance with the view, ex the camera and player
+		std::vector<std::weak_ptr<GameObject>> _scrollFollowers;
+
+		// Objects further than this from the camera or an anchor go dormant, 0 to disable
+		float _activationRadius;
+		// Objects that we keep active around, in addition to the main camera
+		std::vector<std::weak_ptr<GameObject>> _activationAnchors;
+		// Counters from the last time we updated activation
+		int   _activeObjectCount;
+		int   _dormantObjectCount;
+
 		// Stores all the objects in our scene
 		std::vector<GameObject::Sptr>  _objects;
 		std::vector<std::weak_ptr<GameObject>>  _deletionQueue;
@@ -240,6 +415,25 @@ namespace Gameplay {
 		/// Handles cleaning up bullet physics for this scene
 		/// </summary>
 		void _CleanupPhysics();
+		/// <summary>
+		/// Advances the physics world by a single fixed step, invoking the pre and
+		/// post step handlers for all physics components
+		/// </summary>
+		/// <param name="step">The length of the step in seconds</param>
+		void _StepPhysics(float step);
+		/// <summary>
+		/// Advances our scroll followers by the world scroll velocity
+		/// </summary>
+		void _ScrollWorld(float dt);
+		/// <summary>
+		/// Determines which objects are inside the activation region, waking or
+		/// putting objects to sleep as they cross it's boundary
+		/// </summary>
+		void _UpdateActivation();
+		/// <summary>
+		/// Puts an object to sleep or wakes it up, including it's physics bodies
+		/// </summary>
+		void _SetDormant(const GameObject::Sptr& object, bool dormant);
 
 		void _FlushDeleteQueue();
 	};
@@ -5,7 +5,8 @@ IBuffer::IBuffer(BufferType type, BufferUsage usage) :
 	IGraphicsResource(),
 	_elementCount(0),
 	_elementSize(0),
-	_size(0)
+	_size(0),
+	_immutable(false)
 {
 	_type = type;
 	_usage = usage;
@@ -23,19 +24,36 @@ IBuffer::~IBuffer() {
 	}
 }
 
+void IBuffer::AllocateStorage(uint32_t elementSize, uint32_t elementCount, BufferMapMode access, const void* data) {
+	LOG_ASSERT(!_immutable, "Buffer storage has already been allocated!");
+
+	// Only the flags that glNamedBufferStorage accepts, the invalidate and unsynchronized bits only apply to mapping
+	BufferMapMode storageFlags = access & (BufferMapMode::Read | BufferMapMode::Write | BufferMapMode::Persistent | BufferMapMode::Coherent);
+	glNamedBufferStorage(_rendererId, (GLsizeiptr)elementSize * elementCount, data, *storageFlags);
+
+	_immutable = true;
+	_elementCount = elementCount;
+	_elementSize = elementSize;
+	_size = elementCount * elementSize;
+	_SetGpuMemory(_size);
+}
+
 void IBuffer::LoadData(const void* data, uint32_t elementSize, uint32_t elementCount) {
+	LOG_ASSERT(!_immutable, "Cannot re-allocate a buffer with immutable storage, use UpdateData instead");
+
 	// Note, this is part of the bindless state access stuff added in 4.5
 	glNamedBufferData(_rendererId, (GLsizeiptr)elementSize * elementCount, data, (GLenum)_usage);
 
 	_elementCount = elementCount;
 	_elementSize = elementSize;
 	_size = elementCount * elementSize;
+	_SetGpuMemory(_size);
 }
 
 void IBuffer::UpdateData(const void* data, uint32_t elementSize, uint32_t elementCount, bool allowResize /*= true*/)
 {
 	if (elementSize * elementCount > _size) {
-		if (allowResize) {
+		if (allowResize && !_immutable) {
 			glNamedBufferData(_rendererId, (GLsizeiptr)elementSize * elementCount, data, (GLenum)_usage);
 
 			LOG_INFO("Expanding buffer from {} bytes to {} bytes", _size, elementCount * elementSize);
@@ -43,6 +61,7 @@ void IBuffer::UpdateData(const void* data, uint32_t elementSize, uint32_t elemen
 			_elementCount = elementCount;
 			_elementSize = elementSize;
 			_size = elementCount * elementSize;
+			_SetGpuMemory(_size);
 		} else {
 			LOG_ASSERT(false, "Attempting to write beyond the end of the buffer!");
 		}
@@ -50,6 +69,7 @@ void IBuffer::UpdateData(const void* data, uint32_t elementSize, uint32_t elemen
 		if (_size == 0) {
 			glNamedBufferData(_rendererId, (GLsizeiptr)elementSize * elementCount, data, (GLenum)_usage);
 			_size = elementCount * elementSize;
+			_SetGpuMemory(_size);
 		} else {
 			glNamedBufferSubData(_rendererId, 0, (GLsizeiptr)elementSize * elementCount, data);
 		}
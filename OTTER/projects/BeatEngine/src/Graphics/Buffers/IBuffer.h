@@ -52,6 +52,23 @@ public:
 	/// <param name="allowResize">True if resizing the buffer is allowed, otherwise an assertion is thrown for oversized writes</param>
 	virtual void UpdateData(const void* data, uint32_t elementSize, uint32_t elementCount, bool allowResize = true);
 
+	/// <summary>
+	/// Allocates immutable storage for this buffer using glNamedBufferStorage. The size can never change
+	/// afterwards, but the buffer can stay mapped while the GPU is using it if the access flags include
+	/// BufferMapMode::Persistent. LoadData and UpdateData can't resize a buffer allocated this way
+	/// </summary>
+	/// <see>https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glBufferStorage.xhtml</see>
+	/// <param name="elementSize">The size of a single element, in bytes</param>
+	/// <param name="elementCount">The number of elements to allocate space for</param>
+	/// <param name="access">The ways the buffer is allowed to be mapped, Map must be called with a subset of these</param>
+	/// <param name="data">The initial contents of the buffer, or nullptr to leave it uninitialized</param>
+	void AllocateStorage(uint32_t elementSize, uint32_t elementCount, BufferMapMode access, const void* data = nullptr);
+
+	/// <summary>
+	/// Returns true if this buffer was allocated with AllocateStorage, and can't be resized
+	/// </summary>
+	bool IsImmutable() const { return _immutable; }
+
 	/// <summary>
 	/// Loads an array of data into this buffer, using the bindless method glNamedBufferData
 	/// </summary>
@@ -134,4 +151,5 @@ protected:
 	uint32_t _size; // The size of the buffer in bytes
 	BufferUsage _usage; // The buffer usage mode (GL_STATIC_DRAW, GL_DYNAMIC_DRAW)
 	BufferType _type; // The buffer type (ex GL_ARRAY_BUFFER, GL_ARRAY_ELEMENT_BUFFER)
+	bool _immutable; // True if the storage was allocated with glNamedBufferStorage
 };
@@ -22,6 +22,7 @@ void AbstractUniformBuffer::LoadData(const void* data, uint32_t elementSize, uin
 	memcpy(_rawData, data, dataSize);
 	// Upload data to the OpenGL buffer
 	glNamedBufferSubData(_rendererId, 0, dataSize, _rawData);
+	GpuProfiler::Counters().UboBytes += dataSize;
 }
 
 void AbstractUniformBuffer::Bind() const {
@@ -1,5 +1,6 @@
 #pragma once
 #include "IBuffer.h"
+#include "Graphics/GpuProfiler.h"
 #include <memory>
 
 /// <summary>
@@ -108,5 +109,6 @@ public:
 	/// </summary>
 	void Update() {
 		glNamedBufferSubData(_rendererId, 0, sizeof(Structure), _rawData);
+		GpuProfiler::Counters().UboBytes += sizeof(Structure);
 	}
 };
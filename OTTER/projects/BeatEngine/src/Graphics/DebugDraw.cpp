@@ -1,4 +1,5 @@
 #include "Graphics/DebugDraw.h"
+#include "Graphics/GpuProfiler.h"
 
 DebugDrawer::DebugDrawer() :
 	_colorStack(std::stack<glm::vec3>()),
@@ -77,6 +78,7 @@ void DebugDrawer::FlushLines()
 		_linesVBO->LoadData<VertexPosCol>(_lineBuffer, LINE_BATCH_SIZE * 2);
 		_linesVAO->Bind();
 		glDrawArrays((GLenum)DrawMode::LineList, 0, _lineOffset);
+		GpuProfiler::CountDraw(DrawMode::LineList, _lineOffset);
 		_linesVAO->Unbind();
 		_lineOffset = 0;
 		if (restorePoint != 0) {
@@ -120,6 +122,7 @@ void DebugDrawer::FlushTris()
 		_trisVBO->LoadData<VertexPosCol>(_triBuffer, TRI_BATCH_SIZE * 3);
 		_trisVAO->Bind();
 		glDrawArrays((GLenum)DrawMode::TriangleList, 0, _triangleOffset);
+		GpuProfiler::CountDraw(DrawMode::TriangleList, _triangleOffset);
 		_trisVAO->Unbind();
 		_triangleOffset = 0;
 		if (restorePoint != 0) {
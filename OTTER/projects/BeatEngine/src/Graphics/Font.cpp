@@ -1,24 +1,37 @@
 #include "Graphics/Font.h"
 #include "Utils/FileHelpers.h"
 #include "Utils/JsonGlmHelpers.h"
+#include "Utils/StringUtils.h"
+#include "Utils/ThreadPool.h"
+#include "Utils/Profiler.h"
 #include <set>
-#include <codecvt>
-#include <locale>
+#include <algorithm>
 #include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <filesystem>
 #include <stb_rect_pack.h>
-#include "Utils/JsonGlmHelpers.h"
 
 #define OVERSAMPLE_X 1
 #define OVERSAMPLE_Y 1
 #define PADDING 1
 
+// The pixel height that distance field glyphs are rendered at, independent of the font size
+#define SDF_BAKE_SIZE 32.0f
+// How far the distance field extends past the glyph edges, in pixels at the bake size
+#define SDF_PADDING 4
+// The value stored on the glyph edge, the field falls to 0 at SDF_PADDING pixels outside of it
+#define SDF_ON_EDGE 128
+// The largest we'll let the atlas grow to when packing distance fields
+#define SDF_MAX_ATLAS_SIZE 4096u
+
 Font::Font() : Font("", 0.0f) { }
 
 Font::Font(const std::string& fontPath, float size) :
 	IResource(),
 	_fontPath(fontPath),
 	_fontSize(size),
-	_glyphs(nullptr),
+	_atlasMode(FontAtlasMode::Coverage),
 	_atlas(nullptr),
 	_ascent(0),
 	_descent(0),
@@ -41,12 +54,18 @@ Font::Font(const std::string& fontPath, float size) :
 }
 
 Font::~Font() {
-	delete[] _glyphs;
+	// The worker thread is still using our font data
+	if (_pendingBake.valid()) {
+		_pendingBake.wait();
+	}
 	_atlas = nullptr;
 }
 
 void Font::Load(const std::string& fontPath, float size /*= 16.0f*/)
 {
+	// Don't pull the font data out from under a worker thread
+	__FinishBake();
+
 	// Read the contents of the file
 	std::string data = FileHelpers::ReadFile(fontPath);
 
@@ -54,11 +73,7 @@ void Font::Load(const std::string& fontPath, float size /*= 16.0f*/)
 	if (!data.empty()) {
 		_fontPath = fontPath;
 		_fontData = data;
-
-		if (_glyphs != nullptr) {
-			delete[] _glyphs;
-			_glyphs = nullptr;
-		}
+		_fontSize = size;
 		_atlas = nullptr;
 
 		uint8_t* rawData = reinterpret_cast<uint8_t*>(_fontData.data());
@@ -79,32 +94,199 @@ void Font::Load(const std::string& fontPath, float size /*= 16.0f*/)
 }
 
 void Font::AddGlyphRange(uint32_t min, uint32_t max) {
-	LOG_ASSERT(_atlas == nullptr, "Cannot add glyphs after the font has been baked!");
+	LOG_ASSERT(_atlas == nullptr && !IsBaking(), "Cannot add glyphs after the font has been baked!");
 	_glyphRanges.push_back({ min, max });
 }
 
+void Font::SetAtlasMode(FontAtlasMode mode) {
+	LOG_ASSERT(_atlas == nullptr && !IsBaking(), "Cannot change the atlas mode after the font has been baked!");
+	_atlasMode = mode;
+}
+
+FontAtlasMode Font::GetAtlasMode() const {
+	return _atlasMode;
+}
+
 void Font::Bake() {
-	LOG_ASSERT(_atlas == nullptr, "Bake has already been called!");
+	LOG_ASSERT(_atlas == nullptr && !IsBaking(), "Bake has already been called!");
+	LOG_ASSERT(_fontInfo.data != nullptr, "Have not loaded a font asset!");
+
+	// If we've baked this exact font before, we can skip straight to the upload
+	uint64_t key = __ComputeCacheKey();
+	std::string cachePath = __GetCachePath(key);
+	std::unique_ptr<BakeResult> cached = __LoadCache(cachePath, key);
+	if (cached != nullptr) {
+		__ApplyBake(*cached);
+		return;
+	}
+
+	std::set<int> codePoints = __CollectCodePoints();
+	if (codePoints.empty()) {
+		LOG_ERROR("Font \"{}\" has none of the requested glyphs", _fontPath);
+		return;
+	}
+
+	// Fonts are shared between a handful of workers, so that several fonts can bake at once
+	static ThreadPool bakePool(std::max(ThreadPool::HardwareThreads() - 1, 1));
+
+	// Everything the worker reads is left alone until the bake is finished, so it doesn't need any locking
+	auto promise = std::make_shared<std::promise<std::unique_ptr<BakeResult>>>();
+	_pendingBake = promise->get_future();
+	bakePool.Enqueue([this, promise, codePoints, cachePath, key]() {
+		PROFILE_ZONE("Bake Font");
+		std::unique_ptr<BakeResult> result = _atlasMode == FontAtlasMode::SDF ? __BakeSdf(codePoints) : __BakeCoverage(codePoints);
+		if (result != nullptr) {
+			__SaveCache(cachePath, key, *result);
+		}
+		promise->set_value(std::move(result));
+	});
+}
+
+bool Font::IsBaking() const {
+	return _pendingBake.valid();
+}
+
+bool Font::Cook() const {
 	LOG_ASSERT(_fontInfo.data != nullptr, "Have not loaded a font asset!");
 
-	uint8_t* rawFontData = reinterpret_cast<uint8_t*>(_fontData.data());
+	uint64_t key = __ComputeCacheKey();
+	std::string cachePath = __GetCachePath(key);
+	if (__LoadCache(cachePath, key) != nullptr) {
+		return true;
+	}
+
+	std::set<int> codePoints = __CollectCodePoints();
+	if (codePoints.empty()) {
+		LOG_ERROR("Font \"{}\" has none of the requested glyphs", _fontPath);
+		return false;
+	}
+
+	std::unique_ptr<BakeResult> result = _atlasMode == FontAtlasMode::SDF ? __BakeSdf(codePoints) : __BakeCoverage(codePoints);
+	if (result == nullptr) {
+		return false;
+	}
+	__SaveCache(cachePath, key, *result);
+	return std::filesystem::exists(cachePath);
+}
 
+const Texture2D::Sptr& Font::GetAtlas() {
+	__FinishBake();
+	return _atlas;
+}
+
+GlyphInfo Font::GetGlyph(uint32_t codePoint, float offsetX, float offsetY) const {
+	__FinishBake();
+
+	// Try and get glyph info from the codepoint, otherwise grab the default glyph
+	auto it = _glyphMap.find(codePoint);		
+	GlyphInfo result = it == _glyphMap.end() ? _defaultGlyph : it->second;
+
+	result.OffsetX += offsetX;
+	result.OffsetY += offsetY;
+
+	return result;
+}
+
+float Font::GetKerning(int char1, int char2) const {
+	return stbtt_GetCodepointKernAdvance(&_fontInfo, char1, char2) * _pixelHeightScale;
+}
+
+float Font::GetLineHeight() const {
+	return (_ascent - _descent + _lineGap) * _pixelHeightScale;
+}
+
+glm::vec2 Font::MeausureString(const std::string& text, const float scale /*= 1.0f*/) {
+	// We can convert an ASCII string to unicode!
+	static std::wstring unicode;
+	StringTools::Utf8ToUnicode(text, unicode);
+	return MeausureString(unicode, scale);
+}
+
+glm::vec2 Font::MeausureString(const std::wstring& text, const float scale /*= 1.0f*/) {
+	// Will cache the current glyph
+	GlyphInfo glyph;
+
+	// We'll track the position and max size of the text
+	float xOff{ 0 }, yOff{ 0 };
+	float lineHeight = 0.0f;
+	float maxWidth = 0.0f;
+	float totalHeight = 0.0f;
+
+	// Iterate over all characters, ascii and unicode overlap in the 0-255 range!
+	for (size_t i = 0; i < text.size(); i++) {
+		glyph = GetGlyph(text[i], xOff, yOff);
+		xOff = glyph.OffsetX;
+		yOff = glyph.OffsetY;
+
+		lineHeight = glm::max(lineHeight, -glyph.Positions[1].y);
+		maxWidth = glm::max(maxWidth, xOff);
+
+		if (text[i] == '\n')
+		{
+			yOff += GetLineHeight();
+			totalHeight += lineHeight;
+			lineHeight = 0.0f;
+			xOff = 0;
+		} else if (text[i] == '\r') {
+			xOff = 0;
+		} else if (text[i] == '\t') {
+			float xOffTemp{ 0 }, yOffTemp{ 0 };
+			glyph = GetGlyph(' ', xOffTemp, yOffTemp);
+			xOff += glyph.OffsetX * 4;
+		}
+	}
+	totalHeight += lineHeight;
+	return glm::vec2(maxWidth, totalHeight) * scale;
+}
+
+GlyphInfo Font::__CreateGlyph(const stbtt_packedchar* glyphs, uint32_t atlasWidth, uint32_t atlasHeight, uint32_t index)
+{
+	stbtt_aligned_quad quad;
+
+	float offsetX{0}, offsetY{0};
+	stbtt_GetPackedQuad(glyphs, atlasWidth, atlasHeight, index, &offsetX, &offsetY, &quad, 1);
+	float xmin = quad.x0;
+	float xmax = quad.x1;
+	float ymin = quad.y1;
+	float ymax = quad.y0;
+
+	GlyphInfo info = GlyphInfo();
+
+	info.OffsetX      = offsetX;
+	info.OffsetY      = offsetY;
+	info.Positions[0] = { xmax, ymin };
+	info.Positions[1] = { xmax, ymax };
+	info.Positions[2] = { xmin, ymax };
+	info.Positions[3] = { xmin, ymin };
+	info.UVs[0]       = { quad.s1, quad.t1 };
+	info.UVs[1]       = { quad.s1, quad.t0 };
+	info.UVs[2]       = { quad.s0, quad.t0 };
+	info.UVs[3]       = { quad.s0, quad.t1 };
+	info.IsPacked = true;
+
+	return info;
+}
+
+std::set<int> Font::__CollectCodePoints() const {
 	// Collect all codepoint ranges into a set, so we have a list of unique codepoints
 	std::set<int> codePoints;
-	uint32_t numCodepoints = 0;
 	for (const auto& range : _glyphRanges) {
 		for (uint32_t ix = range.x; ix <= range.y; ix++) {
 			// skip if the font doesn't have that glyph
 			if (!stbtt_FindGlyphIndex(&_fontInfo, ix)) {
 				continue;
 			}
-			numCodepoints += codePoints.emplace(ix).second ? 1 : 0;
+			codePoints.emplace(ix);
 		}
 	}
+	return codePoints;
+}
+
+std::unique_ptr<Font::BakeResult> Font::__BakeCoverage(const std::set<int>& codePoints) const {
+	const uint8_t* rawFontData = reinterpret_cast<const uint8_t*>(_fontData.data());
 
 	// Allocate our glyph data for the number of unicode character's we're supporting
-	_glyphs = new stbtt_packedchar[numCodepoints];
-	memset(_glyphs, 0, sizeof(stbtt_packedchar) * numCodepoints);
+	std::vector<stbtt_packedchar> glyphs(codePoints.size(), stbtt_packedchar());
 
 	// Collect unicode ranges, may differ from input ranges!
 	std::vector<stbtt_pack_range> ranges;
@@ -114,7 +296,7 @@ void Font::Bake() {
 	current.font_size = _fontSize;
 	current.first_unicode_codepoint_in_range = *codePoints.begin();
 	current.num_chars = 0;
-	current.chardata_for_range = _glyphs;
+	current.chardata_for_range = glyphs.data();
 	current.h_oversample = OVERSAMPLE_X;
 	current.v_oversample = OVERSAMPLE_Y;
 	current.array_of_unicode_codepoints = (int*)(&*codePoints.begin());
@@ -137,7 +319,7 @@ void Font::Bake() {
 
 			// Start the next range
 			current.first_unicode_codepoint_in_range = codepoint;
-			current.chardata_for_range = _glyphs + encodedChars;
+			current.chardata_for_range = glyphs.data() + encodedChars;
 			current.array_of_unicode_codepoints = (int*)(&*codePoints.begin()) + encodedChars;
 		}
 
@@ -154,22 +336,16 @@ void Font::Bake() {
 
 	_CrtCheckMemory();
 
-	// Create a texture to store the atlas
-	Texture2DDescription desc;
-	desc.Width = _atlasWidth;
-	desc.Height = _atlasHeight;
-	desc.Format = InternalFormat::R8;
-	_atlas = std::make_shared<Texture2D>(desc);
-
 	// Allocate memory for the image, and point rect pack at it
-	uint8_t* atlasData = new uint8_t[desc.Width * (size_t)desc.Height];
-	memset(atlasData, 0, desc.Width * desc.Height);
+	std::unique_ptr<BakeResult> result = std::make_unique<BakeResult>();
+	result->AtlasWidth = _atlasWidth;
+	result->AtlasHeight = _atlasHeight;
+	result->Pixels.resize(result->AtlasWidth * (size_t)result->AtlasHeight, 0);
 
 	stbtt_pack_context context;
-	if (!stbtt_PackBegin(&context, atlasData, _atlasWidth, _atlasHeight, 0, 1, nullptr)) {
+	if (!stbtt_PackBegin(&context, result->Pixels.data(), result->AtlasWidth, result->AtlasHeight, 0, 1, nullptr)) {
 		LOG_ERROR("Failed to pack font texture");
-		delete[] atlasData;
-		return;
+		return nullptr;
 	}
 	_CrtCheckMemory();
 
@@ -177,8 +353,8 @@ void Font::Bake() {
 	for (auto& range : ranges) {
 		if (!stbtt_PackFontRange(&context, rawFontData, 0, range.font_size, range.first_unicode_codepoint_in_range, range.num_chars, range.chardata_for_range)) {
 			LOG_ERROR("Failed to pack font range");
-			delete[] atlasData;
-			return;
+			stbtt_PackEnd(&context);
+			return nullptr;
 		}
 		_CrtCheckMemory();
 	}
@@ -186,120 +362,284 @@ void Font::Bake() {
 
 	_CrtCheckMemory();
 
-	// Upload data into the image
-	_atlas->LoadData(desc.Width, desc.Height, PixelFormat::Red, PixelType::UByte, atlasData);
-	delete[] atlasData;
-
 	uint32_t index = 0;
 	for (uint32_t codepoint : codePoints) {
-		_glyphMap[codepoint] = __CreateGlyph(index);
+		result->Glyphs[codepoint] = __CreateGlyph(glyphs.data(), result->AtlasWidth, result->AtlasHeight, index);
 		index++;
 
 		if (codepoint == 0xE000u)
-			_defaultGlyph = _glyphMap[codepoint];
+			result->DefaultGlyph = result->Glyphs[codepoint];
 	}
+	return result;
 }
 
-const Texture2D::Sptr& Font::GetAtlas() {
-	return _atlas;
-}
+std::unique_ptr<Font::BakeResult> Font::__BakeSdf(const std::set<int>& codePoints) const
+{
+	// The glyphs are rendered at a fixed size, and their metrics converted back to the font size so
+	// that layout is the same as a coverage atlas
+	float bakeScale = stbtt_ScaleForPixelHeight(&_fontInfo, SDF_BAKE_SIZE);
+	float bakeToFont = _pixelHeightScale / bakeScale;
+
+	struct SdfBitmap {
+		uint32_t Codepoint;
+		uint8_t* Data;
+		int      Width, Height, XOff, YOff;
+	};
+	std::vector<SdfBitmap> bitmaps;
+	std::vector<stbrp_rect> rects;
+	bitmaps.reserve(codePoints.size());
+	rects.reserve(codePoints.size());
+
+	for (int codepoint : codePoints) {
+		SdfBitmap bitmap = SdfBitmap();
+		bitmap.Codepoint = codepoint;
+		bitmap.Data = stbtt_GetCodepointSDF(&_fontInfo, bakeScale, codepoint, SDF_PADDING, SDF_ON_EDGE, SDF_ON_EDGE / (float)SDF_PADDING,
+											&bitmap.Width, &bitmap.Height, &bitmap.XOff, &bitmap.YOff);
+		bitmaps.push_back(bitmap);
+
+		// Glyphs with no outline (ex: spaces) don't take up any room in the atlas
+		if (bitmap.Data != nullptr) {
+			stbrp_rect rect = stbrp_rect();
+			rect.id = (int)bitmaps.size() - 1;
+			rect.w = bitmap.Width + PADDING;
+			rect.h = bitmap.Height + PADDING;
+			rects.push_back(rect);
+		}
+	}
 
-GlyphInfo Font::GetGlyph(uint32_t codePoint, float offsetX, float offsetY) const {
-	// Try and get glyph info from the codepoint, otherwise grab the default glyph
-	auto it = _glyphMap.find(codePoint);		
-	GlyphInfo result = it == _glyphMap.end() ? _defaultGlyph : it->second;
+	// Keep doubling the atlas until everything fits
+	std::unique_ptr<BakeResult> result = std::make_unique<BakeResult>();
+	uint32_t& atlasWidth = result->AtlasWidth;
+	uint32_t& atlasHeight = result->AtlasHeight;
+	atlasWidth = _atlasWidth;
+	atlasHeight = _atlasHeight;
+	std::vector<stbrp_node> nodes;
+	bool packed = false;
+	while (!packed) {
+		nodes.resize(atlasWidth);
+		stbrp_context context;
+		stbrp_init_target(&context, atlasWidth, atlasHeight, nodes.data(), (int)nodes.size());
+		packed = stbrp_pack_rects(&context, rects.data(), (int)rects.size()) != 0;
+
+		if (!packed) {
+			if (atlasWidth >= SDF_MAX_ATLAS_SIZE && atlasHeight >= SDF_MAX_ATLAS_SIZE) {
+				break;
+			}
+			if (atlasWidth <= atlasHeight) {
+				atlasWidth *= 2;
+			} else {
+				atlasHeight *= 2;
+			}
+		}
+	}
+	if (!packed) {
+		LOG_ERROR("Failed to pack font distance fields, some glyphs will be missing");
+	}
 
-	result.OffsetX += offsetX;
-	result.OffsetY += offsetY;
+	// Copy the distance fields into the atlas
+	result->Pixels.resize(atlasWidth * (size_t)atlasHeight, 0);
+	for (const stbrp_rect& rect : rects) {
+		if (!rect.was_packed) {
+			continue;
+		}
+		const SdfBitmap& bitmap = bitmaps[rect.id];
+		for (int row = 0; row < bitmap.Height; row++) {
+			memcpy(result->Pixels.data() + (rect.y + row) * (size_t)atlasWidth + rect.x, bitmap.Data + row * (size_t)bitmap.Width, bitmap.Width);
+		}
+	}
+
+	// Unpacked glyphs keep their advance, but have no quad
+	std::vector<const stbrp_rect*> rectLookup(bitmaps.size(), nullptr);
+	for (const stbrp_rect& rect : rects) {
+		if (rect.was_packed) {
+			rectLookup[rect.id] = &rect;
+		}
+	}
+
+	for (size_t ix = 0; ix < bitmaps.size(); ix++) {
+		const SdfBitmap& bitmap = bitmaps[ix];
+
+		int advance, leftBearing;
+		stbtt_GetCodepointHMetrics(&_fontInfo, bitmap.Codepoint, &advance, &leftBearing);
+
+		GlyphInfo info = GlyphInfo();
+		info.OffsetX = advance * _pixelHeightScale;
+		info.OffsetY = 0.0f;
+
+		const stbrp_rect* rect = rectLookup[ix];
+		if (rect != nullptr) {
+			float xmin = bitmap.XOff * bakeToFont;
+			float xmax = (bitmap.XOff + bitmap.Width) * bakeToFont;
+			float ymin = (bitmap.YOff + bitmap.Height) * bakeToFont;
+			float ymax = bitmap.YOff * bakeToFont;
+
+			float s0 = rect->x / (float)atlasWidth;
+			float s1 = (rect->x + bitmap.Width) / (float)atlasWidth;
+			float t0 = rect->y / (float)atlasHeight;
+			float t1 = (rect->y + bitmap.Height) / (float)atlasHeight;
+
+			info.Positions[0] = { xmax, ymin };
+			info.Positions[1] = { xmax, ymax };
+			info.Positions[2] = { xmin, ymax };
+			info.Positions[3] = { xmin, ymin };
+			info.UVs[0]       = { s1, t1 };
+			info.UVs[1]       = { s1, t0 };
+			info.UVs[2]       = { s0, t0 };
+			info.UVs[3]       = { s0, t1 };
+			info.IsPacked = true;
+		}
+
+		result->Glyphs[bitmap.Codepoint] = info;
+		if (bitmap.Codepoint == 0xE000u) {
+			result->DefaultGlyph = info;
+		}
 
+		stbtt_FreeSDF(bitmap.Data, nullptr);
+	}
 	return result;
 }
 
-float Font::GetKerning(int char1, int char2) const {
-	return stbtt_GetCodepointKernAdvance(&_fontInfo, char1, char2) * _pixelHeightScale;
+void Font::__FinishBake() const {
+	if (!_pendingBake.valid()) {
+		return;
+	}
+	std::unique_ptr<BakeResult> result = _pendingBake.get();
+	if (result != nullptr) {
+		__ApplyBake(*result);
+	}
 }
 
-float Font::GetLineHeight() const {
-	return (_ascent - _descent + _lineGap) * _pixelHeightScale;
-}
+void Font::__ApplyBake(BakeResult& result) const {
+	_atlasWidth = result.AtlasWidth;
+	_atlasHeight = result.AtlasHeight;
+	_glyphMap = std::move(result.Glyphs);
+	_defaultGlyph = result.DefaultGlyph;
 
-glm::vec2 Font::MeausureString(const std::string& text, const float scale /*= 1.0f*/) {
-	// We can convert an ASCII string to unicode!
-	std::wstring unicode = std::wstring_convert<std::codecvt_utf8<wchar_t>>().from_bytes(text);
-	return MeausureString(unicode, scale);
+	Texture2DDescription desc;
+	desc.Width = _atlasWidth;
+	desc.Height = _atlasHeight;
+	desc.Format = InternalFormat::R8;
+	// The distance field is meant to be interpolated, and mips would blur the edges together
+	if (_atlasMode == FontAtlasMode::SDF) {
+		desc.MinificationFilter = MinFilter::Linear;
+		desc.MagnificationFilter = MagFilter::Linear;
+		desc.GenerateMipMaps = false;
+	}
+	_atlas = std::make_shared<Texture2D>(desc);
+	_atlas->LoadData(desc.Width, desc.Height, PixelFormat::Red, PixelType::UByte, result.Pixels.data());
 }
 
-glm::vec2 Font::MeausureString(const std::wstring& text, const float scale /*= 1.0f*/) {
-	// Will cache the current glyph
-	GlyphInfo glyph;
+uint64_t Font::__ComputeCacheKey() const {
+	// FNV-1a, it only needs to tell bakes apart, not resist collisions on purpose
+	uint64_t hash = 0xcbf29ce484222325ull;
+	auto append = [&hash](const void* data, size_t size) {
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+		for (size_t ix = 0; ix < size; ix++) {
+			hash = (hash ^ bytes[ix]) * 0x100000001b3ull;
+		}
+	};
 
-	// We'll track the position and max size of the text
-	float xOff{ 0 }, yOff{ 0 };
-	float lineHeight = 0.0f;
-	float maxWidth = 0.0f;
-	float totalHeight = 0.0f;
+	append(_fontData.data(), _fontData.size());
+	append(&_fontSize, sizeof(float));
+	append(&_atlasMode, sizeof(FontAtlasMode));
+	append(&_atlasWidth, sizeof(uint32_t));
+	append(&_atlasHeight, sizeof(uint32_t));
+	for (const glm::uvec2& range : _glyphRanges) {
+		append(&range, sizeof(glm::uvec2));
+	}
+	return hash;
+}
 
-	// Iterate over all characters, ascii and unicode overlap in the 0-255 range!
-	for (size_t i = 0; i < text.size(); i++) {
-		glyph = GetGlyph(text[i], xOff, yOff);
-		xOff = glyph.OffsetX;
-		yOff = glyph.OffsetY;
+std::string Font::__GetCachePath(uint64_t key) const {
+	char keyText[17];
+	snprintf(keyText, sizeof(keyText), "%016llx", (unsigned long long)key);
 
-		lineHeight = glm::max(lineHeight, -glyph.Positions[1].y);
-		maxWidth = glm::max(maxWidth, xOff);
+	// Stored next to the font, there will be one of these per size and mode that the font is used at
+	std::filesystem::path path = std::filesystem::path(_fontPath);
+	path.replace_extension();
+	return path.string() + "." + keyText + ".fontcache";
+}
 
-		if (text[i] == '\n')
-		{
-			yOff += GetLineHeight();
-			totalHeight += lineHeight;
-			lineHeight = 0.0f;
-			xOff = 0;
-		} else if (text[i] == '\r') {
-			xOff = 0;
-		} else if (text[i] == '\t') {
-			float xOffTemp{ 0 }, yOffTemp{ 0 };
-			glyph = GetGlyph(' ', xOffTemp, yOffTemp);
-			xOff += glyph.OffsetX * 4;
-		}
+std::unique_ptr<Font::BakeResult> Font::__LoadCache(const std::string& path, uint64_t key) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		return nullptr;
 	}
-	totalHeight += lineHeight;
-	return glm::vec2(maxWidth, totalHeight) * scale;
-}
 
+	// Anything that doesn't match what we expect is treated as a miss, and will be overwritten
+	CacheHeader header = CacheHeader();
+	CacheHeader expected = CacheHeader();
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(CacheHeader)) ||
+		memcmp(header.HeaderBytes, expected.HeaderBytes, 4) != 0 ||
+		header.Version != CurrentCacheVersion || header.Key != key ||
+		header.AtlasWidth == 0 || header.AtlasHeight == 0 || header.AtlasWidth > 8192 || header.AtlasHeight > 8192) {
+		LOG_INFO("Font cache \"{}\" is missing or stale, rebuilding", path);
+		return nullptr;
+	}
 
-GlyphInfo Font::__CreateGlyph(uint32_t index)
-{
-	stbtt_aligned_quad quad;
+	std::unique_ptr<BakeResult> result = std::make_unique<BakeResult>();
+	result->AtlasWidth = header.AtlasWidth;
+	result->AtlasHeight = header.AtlasHeight;
 
-	float offsetX{0}, offsetY{0};
-	stbtt_GetPackedQuad(_glyphs, _atlasWidth, _atlasHeight, index, &offsetX, &offsetY, &quad, 1);
-	float xmin = quad.x0;
-	float xmax = quad.x1;
-	float ymin = quad.y1;
-	float ymax = quad.y0;
+	std::vector<CachedGlyph> glyphs(header.NumGlyphs);
+	result->Pixels.resize(header.AtlasWidth * (size_t)header.AtlasHeight);
+	if (!file.read(reinterpret_cast<char*>(glyphs.data()), glyphs.size() * sizeof(CachedGlyph)) ||
+		!file.read(reinterpret_cast<char*>(result->Pixels.data()), result->Pixels.size())) {
+		LOG_WARN("Font cache \"{}\" is truncated, rebuilding", path);
+		return nullptr;
+	}
 
-	GlyphInfo info = GlyphInfo();
+	for (const CachedGlyph& glyph : glyphs) {
+		result->Glyphs[glyph.Codepoint] = glyph.Info;
+		if (glyph.Codepoint == 0xE000u) {
+			result->DefaultGlyph = glyph.Info;
+		}
+	}
+	return result;
+}
 
-	info.OffsetX      = offsetX;
-	info.OffsetY      = offsetY;
-	info.Positions[0] = { xmax, ymin };
-	info.Positions[1] = { xmax, ymax };
-	info.Positions[2] = { xmin, ymax };
-	info.Positions[3] = { xmin, ymin };
-	info.UVs[0]       = { quad.s1, quad.t1 };
-	info.UVs[1]       = { quad.s1, quad.t0 };
-	info.UVs[2]       = { quad.s0, quad.t0 };
-	info.UVs[3]       = { quad.s0, quad.t1 };
-	info.IsPacked = true;
+void Font::__SaveCache(const std::string& path, uint64_t key, const BakeResult& result) {
+	// Write to a temporary file first, so that a crash can't leave a half written cache behind. Several
+	// copies of the same font can be baking at once, so each worker gets it's own
+	std::string tempPath = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			LOG_WARN("Failed to write font cache \"{}\"", path);
+			return;
+		}
 
-	return info;
+		CacheHeader header = CacheHeader();
+		header.Version = CurrentCacheVersion;
+		header.Key = key;
+		header.AtlasWidth = result.AtlasWidth;
+		header.AtlasHeight = result.AtlasHeight;
+		header.NumGlyphs = (uint32_t)result.Glyphs.size();
+		file.write(reinterpret_cast<const char*>(&header), sizeof(CacheHeader));
+
+		for (const auto& [codepoint, info] : result.Glyphs) {
+			CachedGlyph glyph = CachedGlyph();
+			glyph.Codepoint = codepoint;
+			glyph.Info = info;
+			file.write(reinterpret_cast<const char*>(&glyph), sizeof(CachedGlyph));
+		}
+		file.write(reinterpret_cast<const char*>(result.Pixels.data()), result.Pixels.size());
+	}
+
+	std::error_code error;
+	std::filesystem::rename(tempPath, path, error);
+	if (error) {
+		LOG_WARN("Failed to write font cache \"{}\": {}", path, error.message());
+		std::filesystem::remove(tempPath, error);
+	}
 }
 
 nlohmann::json Font::ToJson() const
 {
 	nlohmann::json blob = {
 		{ "filename", _fontPath },
-		{ "font_size", _fontSize }
+		{ "font_size", _fontSize },
+		{ "atlas_mode", ~_atlasMode }
 	};
 
 	nlohmann::json ranges = std::vector<nlohmann::json>();
@@ -310,13 +650,14 @@ nlohmann::json Font::ToJson() const
 	return blob;
 }
 
-Font::Sptr Font::FromJson(const nlohmann::json& data) {
+Font::Sptr Font::FromJson(const nlohmann::json& data, bool bake) {
 	Font::Sptr result = std::make_shared<Font>();
 		
 	// Load the path and font size so we can grab the font file
 	std::string path = JsonGet<std::string>(data, "filename", "");
 	float size = JsonGet(data, "font_size", 16.0f);
 	result->Load(path, size);
+	result->SetAtlasMode(JsonParseEnum(FontAtlasMode, data, "atlas_mode", FontAtlasMode::Coverage));
 		
 	// Iterate over the ranges and add them to the font
 	if (data.contains("ranges") && data["ranges"].is_array()) {
@@ -327,6 +668,8 @@ Font::Sptr Font::FromJson(const nlohmann::json& data) {
 	}
 
 	// Bake font texture and return
-	result->Bake();
+	if (bake) {
+		result->Bake();
+	}
 	return result;
-}
+}
\ No newline at end of file
@@ -4,6 +4,10 @@
 #include "Graphics/Textures/Texture2D.h"
 
 #include <stb_truetype.h>
+#include <set>
+#include <future>
+#include <memory>
+#include <EnumToString.h>
 
 	struct GlyphInfo {
 		glm::vec2 Positions[4];
@@ -12,6 +16,16 @@
 		bool IsPacked;
 	};
 
+	/// <summary>
+	/// How a font stores it's glyphs in it's atlas
+	/// </summary>
+	ENUM(FontAtlasMode, uint8_t,
+		// The atlas stores the glyph coverage rasterized at the font size, and gets blurry when scaled up
+		Coverage = 0,
+		// The atlas stores the signed distance to the glyph edges, so a single bake stays sharp at any scale
+		SDF      = 1
+	);
+
 	/// <summary>
 	/// The font resource wraps around stb_truetype to allow us to render text to the screen
 	/// A Font class contains the texture atlas and data needed to render glyphs using said atlas
@@ -43,12 +57,37 @@
 		/// <param name="max">The maximum unicode character (inclusive)</param>
 		void AddGlyphRange(uint32_t min, uint32_t max);
 
+		/// <summary>
+		/// Sets how glyphs are stored in the atlas, must be called before the font is baked
+		/// </summary>
+		/// <param name="mode">The new atlas mode</param>
+		void SetAtlasMode(FontAtlasMode mode);
+		/// <summary>
+		/// Gets how glyphs are stored in the atlas
+		/// </summary>
+		FontAtlasMode GetAtlasMode() const;
+
 		/// <summary>
 		/// Generates the texture to use when rendering with this font, must be called
-		/// before the font is used
+		/// before the font is used.
+		/// 
+		/// Baked atlases are cached on disk next to the font file, keyed by the font's contents,
+		/// size, atlas mode and glyph ranges. If there's a matching cache it's uploaded right
+		/// away, otherwise the atlas is baked on a worker thread and the font will wait for it
+		/// the first time it's glyphs or atlas are needed
 		/// </summary>
 		void Bake();
 		/// <summary>
+		/// Returns true if Bake was called, and the atlas is still being built on a worker thread
+		/// </summary>
+		bool IsBaking() const;
+		/// <summary>
+		/// Bakes the atlas straight into the on-disk cache without creating a texture, so that tools
+		/// can build the cache ahead of time. Does nothing if there's already a matching cache
+		/// </summary>
+		/// <returns>True if the cache is up to date</returns>
+		bool Cook() const;
+		/// <summary>
 		/// Gets the texture atlas for this font
 		/// </summary>
 		const Texture2D::Sptr& GetAtlas();
@@ -90,16 +129,51 @@
 		virtual glm::vec2 MeausureString(const std::wstring& text, const float scale = 1.0f);
 
 		virtual nlohmann::json ToJson() const override;
-		static Font::Sptr FromJson(const nlohmann::json& data);
+		/// <summary>
+		/// Loads a font from it's manifest entry
+		/// </summary>
+		/// <param name="data">The JSON blob to load from</param>
+		/// <param name="bake">False to skip baking the atlas, for tools that don't have a graphics context</param>
+		static Font::Sptr FromJson(const nlohmann::json& data, bool bake = true);
 
 	protected:
+		// The CPU side result of a bake, built on a worker thread or read from the cache
+		struct BakeResult {
+			uint32_t                      AtlasWidth = 0;
+			uint32_t                      AtlasHeight = 0;
+			std::vector<uint8_t>          Pixels;
+			std::map<uint32_t, GlyphInfo> Glyphs;
+			GlyphInfo                     DefaultGlyph = GlyphInfo();
+		};
+
+		// Will be put at the start of a cache file, the glyphs and then the atlas pixels follow it
+		struct CacheHeader {
+			// A check value so we can ensure that we're loading in the right file type
+			char     HeaderBytes[4] = { 'B', 'F', 'N', 'T' };
+			// The version code, caches from other versions are ignored and rebuilt
+			uint16_t Version = 0;
+			// The hash of everything that went into the bake
+			uint64_t Key = 0;
+			uint32_t AtlasWidth = 0;
+			uint32_t AtlasHeight = 0;
+			uint32_t NumGlyphs = 0;
+		};
+		struct CachedGlyph {
+			uint32_t  Codepoint;
+			GlyphInfo Info;
+		};
+		static const uint16_t CurrentCacheVersion = 0x01;
+
 		std::vector<glm::uvec2> _glyphRanges;
-		std::map<uint32_t, GlyphInfo> _glyphMap;
-		GlyphInfo                     _defaultGlyph;
-		Texture2D::Sptr   _atlas;
+		// These are filled in when a pending bake is finished, which can happen from the const getters
+		mutable std::map<uint32_t, GlyphInfo> _glyphMap;
+		mutable GlyphInfo                     _defaultGlyph;
+		mutable Texture2D::Sptr               _atlas;
+		mutable std::future<std::unique_ptr<BakeResult>> _pendingBake;
 		std::string       _fontPath;
 		std::string       _fontData;
 		float             _fontSize;
+		FontAtlasMode     _atlasMode;
 
 		float             _pixelHeightScale;
 		float             _emToPixel;
@@ -107,11 +181,26 @@
 						  _descent,
 						  _lineGap;
 
-		uint32_t          _atlasWidth,
+		mutable uint32_t  _atlasWidth,
 			              _atlasHeight;
 
-		stbtt_packedchar* _glyphs;
 		stbtt_fontinfo    _fontInfo;
 
-		GlyphInfo __CreateGlyph(uint32_t index);
+		static GlyphInfo __CreateGlyph(const stbtt_packedchar* glyphs, uint32_t atlasWidth, uint32_t atlasHeight, uint32_t index);
+		// Packs every codepoint with stbtt's packer, safe to call from a worker thread
+		// Gets every codepoint in our glyph ranges that the font actually has a glyph for
+		std::set<int> __CollectCodePoints() const;
+		std::unique_ptr<BakeResult> __BakeCoverage(const std::set<int>& codePoints) const;
+		// Renders a distance field for every codepoint and packs them, safe to call from a worker thread
+		std::unique_ptr<BakeResult> __BakeSdf(const std::set<int>& codePoints) const;
+		// Waits for a pending bake if there is one, and uploads it's atlas
+		void __FinishBake() const;
+		// Creates the atlas texture and glyph lookup from a bake
+		void __ApplyBake(BakeResult& result) const;
+
+		// Hashes everything that affects the output of a bake
+		uint64_t __ComputeCacheKey() const;
+		std::string __GetCachePath(uint64_t key) const;
+		static std::unique_ptr<BakeResult> __LoadCache(const std::string& path, uint64_t key);
+		static void __SaveCache(const std::string& path, uint64_t key, const BakeResult& result);
 	};
\ No newline at end of file
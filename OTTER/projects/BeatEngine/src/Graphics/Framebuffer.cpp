@@ -1,4 +1,5 @@
 #include "Graphics/Framebuffer.h"
+#include <algorithm>
 
 #include "Graphics/RenderBuffer.h"
 #include "Utils/JsonGlmHelpers.h"
@@ -85,8 +86,9 @@ void Framebuffer::_AddAttachment(RenderTargetAttachment attachment, const Render
 		_targets[attachment].Resource = nullptr;
 	}
 	// If this is a new attachment and is a color, add it to the draw buffers so OpenGL knows to render to it
+	// They're kept in order, since the descriptor's map doesn't give us one, and shader outputs are matched to them by index
 	else if (IsColorAttachment(attachment)) {
-		_drawBuffers.push_back(attachment);
+		_drawBuffers.insert(std::upper_bound(_drawBuffers.begin(), _drawBuffers.end(), attachment), attachment);
 		glNamedFramebufferDrawBuffers(_rendererId, _drawBuffers.size(), reinterpret_cast<GLenum*>(_drawBuffers.data()));
 	}
 
@@ -253,7 +255,7 @@ void Framebuffer::SetDebugName(const std::string& name) {
 	// We'll also update the name for all our children
 	for (const auto& attachment : _targets) {
 		static char buffer[256];
-		sprintf_s(buffer, 256, "%s_%s", name.c_str(), (~attachment.first).c_str());
+		snprintf(buffer, 256, "%s_%s", name.c_str(), (~attachment.first).c_str());
 		attachment.second.Resource->SetDebugName(buffer);
 	}
 }
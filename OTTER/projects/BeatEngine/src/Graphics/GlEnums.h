@@ -9,6 +9,20 @@
 #include <Logging.h>
 #include <glm/glm.hpp>
 
+// The S3TC formats are an extension that glad wasn't generated with, but every desktop driver supports them
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
 // We can use an enum to make our code more readable and restrict
 // values to only ones we want to accept
 ENUM(ShaderPartType, GLint,
@@ -17,6 +31,7 @@ ENUM(ShaderPartType, GLint,
 	TessControl = GL_TESS_CONTROL_SHADER,
 	TessEval = GL_TESS_EVALUATION_SHADER,
 	Geometry = GL_GEOMETRY_SHADER,
+	Compute = GL_COMPUTE_SHADER,
 	Unknown = GL_NONE // Usually good practice to have an "unknown" or "none" state for enums
 )
 
@@ -52,7 +67,16 @@ ENUM(InternalFormat, GLint,
 	RGBA8 = GL_RGBA8,
 	SRGBA = GL_SRGB8_ALPHA8,
 	RGBA16 = GL_RGBA16,
-	RGB32AF = GL_RGBA32F
+	RGB32AF = GL_RGBA32F,
+	// Block compressed formats, these can only be filled with data that is already compressed (see DdsFile)
+	BC1 = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,
+	BC1_SRGB = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT,
+	BC3 = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+	BC3_SRGB = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT,
+	BC4 = GL_COMPRESSED_RED_RGTC1,
+	BC5 = GL_COMPRESSED_RG_RGTC2,
+	BC7 = GL_COMPRESSED_RGBA_BPTC_UNORM,
+	BC7_SRGB = GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
 	// Note: There are sized internal formats but there is a LOT of them
 )
 
@@ -142,7 +166,7 @@ constexpr InternalFormat GetInternalFormatForChannels8(int numChannels) {
 	case 4:
 		return InternalFormat::RGBA8;
 	default:
-		LOG_WARN(false, "Unsupported texture format with {0} channels", numChannels);
+		LOG_WARN("Unsupported texture format with {0} channels", numChannels);
 		return InternalFormat::Unknown;
 	}
 }
@@ -157,7 +181,7 @@ constexpr PixelFormat GetPixelFormatForChannels(int numChannels) {
 	case 4:
 		return PixelFormat::RGBA;
 	default:
-		LOG_WARN(false, "Unsupported texture format with {0} channels", numChannels);
+		LOG_WARN("Unsupported texture format with {0} channels", numChannels);
 		return PixelFormat::Unknown;
 	}
 }
@@ -195,6 +219,136 @@ constexpr size_t GetTexelSize(PixelFormat format, PixelType type) {
 	return GetTexelComponentSize(type) * GetTexelComponentCount(format);
 }
 
+/*
+ * Gets the number of bytes a single texel takes up in GPU memory for a sized internal format. This is
+ * what we'd expect the driver to allocate, drivers are free to pad formats (ex: RGB8 is usually stored as RGBA8)
+ * @param format The internal format, as an InternalFormat or RenderTargetType value
+ * @returns The size of a texel in bytes, or 4 for formats we don't know about
+ */
+constexpr size_t GetInternalFormatSize(GLenum format) {
+	switch (format) {
+	case GL_R8:
+	case GL_STENCIL_INDEX4:
+	case GL_STENCIL_INDEX8:
+		return 1;
+	case GL_R16:
+	case GL_R16F:
+	case GL_RG8:
+	case GL_DEPTH_COMPONENT16:
+	case GL_STENCIL_INDEX16:
+		return 2;
+	case GL_RGB8:
+	case GL_SRGB8:
+	case GL_DEPTH_COMPONENT24:
+		return 3;
+	case GL_RGBA8:
+	case GL_SRGB8_ALPHA8:
+	case GL_RGB10:
+	case GL_RGB10_A2:
+	case GL_R11F_G11F_B10F:
+	case GL_R32F:
+	case GL_RG16:
+	case GL_RG16F:
+	case GL_DEPTH_COMPONENT32:
+	case GL_DEPTH_COMPONENT32F:
+	case GL_DEPTH24_STENCIL8:
+	case GL_DEPTH_STENCIL:
+		return 4;
+	case GL_RGB16:
+	case GL_RGB16F:
+		return 6;
+	case GL_RGBA16:
+	case GL_RGBA16F:
+	case GL_RG32F:
+	case GL_DEPTH32F_STENCIL8:
+		return 8;
+	case GL_RGB32F:
+		return 12;
+	case GL_RGBA32F:
+		return 16;
+	default:
+		return 4;
+	}
+}
+
+/*
+ * Gets the number of bytes needed to store a texture with a full mip chain of the given levels, where
+ * each level is half the size of the one above it along every axis that is larger than 1
+ * @param texelSize The size of a single texel, in bytes
+ * @param width, height, depth The size of the top level in texels
+ * @param levels The number of mip levels allocated
+ */
+constexpr size_t GetTextureStorageSize(size_t texelSize, size_t width, size_t height, size_t depth, int levels) {
+	size_t result = 0;
+	for (int ix = 0; ix < levels; ix++) {
+		result += texelSize * width * height * depth;
+		width  = width  > 1 ? width  / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+		depth  = depth  > 1 ? depth  / 2 : 1;
+	}
+	return result;
+}
+
+/*
+ * Gets the number of bytes a single 4x4 block takes up for a block compressed format
+ * @param format The internal format, as an InternalFormat value
+ * @returns The size of a block in bytes, or 0 if the format is not block compressed
+ */
+constexpr size_t GetCompressedBlockSize(GLenum format) {
+	switch (format) {
+	case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+	case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+	case GL_COMPRESSED_RED_RGTC1:
+		return 8;
+	case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+	case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+	case GL_COMPRESSED_RG_RGTC2:
+	case GL_COMPRESSED_RGBA_BPTC_UNORM:
+	case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+		return 16;
+	default:
+		return 0;
+	}
+}
+
+/*
+ * Returns true if the given internal format is block compressed, and must be uploaded with glCompressedTextureSubImage
+ */
+constexpr bool IsCompressedFormat(GLenum format) {
+	return GetCompressedBlockSize(format) != 0;
+}
+
+/*
+ * Gets the number of bytes needed to store a single 2D image of the given size in the given format. Compressed
+ * formats are stored in 4x4 blocks, so their images are rounded up to a whole number of blocks
+ * @param format The internal format, as an InternalFormat value
+ * @param width, height The size of the image in texels
+ */
+constexpr size_t GetImageSize(GLenum format, size_t width, size_t height) {
+	if (IsCompressedFormat(format)) {
+		return GetCompressedBlockSize(format) * ((width + 3) / 4) * ((height + 3) / 4);
+	}
+	return GetInternalFormatSize(format) * width * height;
+}
+
+/*
+ * Gets the number of bytes needed to store a mip chain of 2D images in the given format, this handles compressed
+ * formats where GetTextureStorageSize does not. Array layers and cube faces don't shrink with the mip levels,
+ * so they should be scaled in by the caller
+ * @param format The internal format, as an InternalFormat value
+ * @param width, height The size of the top level in texels
+ * @param levels The number of mip levels allocated
+ */
+constexpr size_t GetImageStorageSize(GLenum format, size_t width, size_t height, int levels) {
+	size_t result = 0;
+	for (int ix = 0; ix < levels; ix++) {
+		result += GetImageSize(format, width, height);
+		width  = width  > 1 ? width  / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+	}
+	return result;
+}
+
 
 /*
 	* Represents the type of data used in a shader in a more useful format for us
@@ -546,7 +700,7 @@ constexpr uint32_t ShaderDataTypeComponentCount(ShaderDataType type)
 	case ShaderDataTypecode::Texture:
 		return 1;
 	default:
-		LOG_WARN(false, "Unknown ShaderDataType! {}", type);
+		LOG_WARN("Unknown ShaderDataType! {}", type);
 		return 1;
 	}
 }
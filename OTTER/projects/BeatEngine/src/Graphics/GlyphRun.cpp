@@ -0,0 +1,110 @@
+#include "Graphics/GlyphRun.h"
+
+GlyphRun::GlyphRun() :
+	_text(),
+	_font(nullptr),
+	_quads(),
+	_states(),
+	_lastRebuildCount(0)
+{ }
+
+bool GlyphRun::SetText(const std::wstring& text, const Font::Sptr& font) {
+	_lastRebuildCount = 0;
+
+	// A different font invalidates the whole layout
+	size_t common = 0;
+	if (font == _font) {
+		if (text == _text) {
+			return false;
+		}
+		size_t maxCommon = glm::min(text.size(), _text.size());
+		while (common < maxCommon && text[common] == _text[common]) {
+			common++;
+		}
+	}
+	_text = text;
+	_font = font;
+
+	// The pen position after a character includes the kerning with the one after it, so the last
+	// character that matched has to be laid out again as well
+	size_t start = common > 0 ? common - 1 : 0;
+	_states.resize(start);
+
+	CharState state = CharState();
+	if (start > 0) {
+		state = _states[start - 1];
+	}
+	_quads.resize(state.QuadEnd);
+
+	if (_font == nullptr) {
+		_states.clear();
+		_quads.clear();
+		return true;
+	}
+
+	for (size_t ix = start; ix < _text.size(); ix++) {
+		wchar_t c = _text[ix];
+
+		// A newline will advance to the next line and return to the start of the line
+		if (c == '\n') {
+			state.Pen.y += _font->GetLineHeight();
+			state.Pen.x = 0.0f;
+			state.TotalHeight += state.LineHeight;
+			state.LineHeight = 0.0f;
+		}
+		// A return character simply returns to the start of the line
+		else if (c == '\r') {
+			state.Pen.x = 0.0f;
+		}
+		// A tab character is 4 spaces
+		else if (c == '\t') {
+			state.Pen.x += _font->GetGlyph(' ', 0.0f, 0.0f).OffsetX * 4;
+		}
+		// All other characters get a quad, unless they have nothing to draw (ex: spaces)
+		else {
+			GlyphInfo glyph = _font->GetGlyph(c, state.Pen.x, state.Pen.y);
+			if (glyph.IsPacked && glyph.Positions[0] != glyph.Positions[2]) {
+				GlyphQuad quad;
+				for (int corner = 0; corner < 4; corner++) {
+					quad.Positions[corner] = state.Pen + glyph.Positions[corner];
+					quad.UVs[corner] = glyph.UVs[corner];
+				}
+				_quads.push_back(quad);
+			}
+			state.LineHeight = glm::max(state.LineHeight, -glyph.Positions[1].y);
+
+			// Advance the pen based on the size of the glyph
+			state.Pen.x = glyph.OffsetX;
+			state.Pen.y = glyph.OffsetY;
+			state.MaxWidth = glm::max(state.MaxWidth, state.Pen.x);
+
+			// If we have more characters, see if there's any kerning between the
+			// current and next character and add it to the pen
+			if (ix + 1 < _text.size()) {
+				state.Pen.x += _font->GetKerning(c, _text[ix + 1]);
+			}
+		}
+
+		state.QuadEnd = (uint32_t)_quads.size();
+		_states.push_back(state);
+		_lastRebuildCount++;
+	}
+
+	return true;
+}
+
+void GlyphRun::Clear() {
+	_text.clear();
+	_font = nullptr;
+	_quads.clear();
+	_states.clear();
+	_lastRebuildCount = 0;
+}
+
+glm::vec2 GlyphRun::GetSize() const {
+	if (_states.empty()) {
+		return glm::vec2(0.0f);
+	}
+	const CharState& last = _states.back();
+	return glm::vec2(last.MaxWidth, last.TotalHeight + last.LineHeight);
+}
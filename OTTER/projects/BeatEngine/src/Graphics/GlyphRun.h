@@ -0,0 +1,78 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <GLM/glm.hpp>
+
+#include "Graphics/Font.h"
+
+/// <summary>
+/// A single laid out glyph, in font units relative to the start of the run
+/// </summary>
+struct GlyphQuad {
+	glm::vec2 Positions[4];
+	glm::vec2 UVs[4];
+};
+
+/// <summary>
+/// Holds the laid out quads for a string of text in a given font, so that text that doesn't
+/// change doesn't need to be looked up glyph by glyph every frame. Quads are stored in font units,
+/// so the scale is only applied when the run is drawn.
+///
+/// When the text changes, only the characters after the first difference are laid out again, so
+/// a counter that ticks up only redoes the digits that changed
+/// </summary>
+class GlyphRun {
+public:
+	GlyphRun();
+	~GlyphRun() = default;
+
+	/// <summary>
+	/// Updates the text for this run, re-laying out anything that changed
+	/// </summary>
+	/// <param name="text">The unicode text to lay out</param>
+	/// <param name="font">The font to lay out the text with</param>
+	/// <returns>True if the run changed, false if it already matched</returns>
+	bool SetText(const std::wstring& text, const Font::Sptr& font);
+
+	/// <summary>
+	/// Forgets the text and quads in this run
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// Gets the text that this run was laid out for
+	/// </summary>
+	const std::wstring& GetText() const { return _text; }
+	/// <summary>
+	/// Gets the font that this run was laid out with
+	/// </summary>
+	const Font::Sptr& GetFont() const { return _font; }
+	/// <summary>
+	/// Gets the size of the text, in font units. This matches Font::MeausureString
+	/// </summary>
+	glm::vec2 GetSize() const;
+	/// <summary>
+	/// Gets the glyph quads that need to be drawn for this run
+	/// </summary>
+	const std::vector<GlyphQuad>& GetQuads() const { return _quads; }
+	/// <summary>
+	/// Gets the number of characters that were laid out by the last call to SetText
+	/// </summary>
+	uint32_t GetLastRebuildCount() const { return _lastRebuildCount; }
+
+private:
+	// The layout state after each character, so that we can pick up from the middle of the string
+	struct CharState {
+		glm::vec2 Pen         = glm::vec2(0.0f);
+		uint32_t  QuadEnd     = 0;
+		float     LineHeight  = 0.0f;
+		float     MaxWidth    = 0.0f;
+		float     TotalHeight = 0.0f;
+	};
+
+	std::wstring           _text;
+	Font::Sptr             _font;
+	std::vector<GlyphQuad> _quads;
+	std::vector<CharState> _states;
+	uint32_t               _lastRebuildCount;
+};
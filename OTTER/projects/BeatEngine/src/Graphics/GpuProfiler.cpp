@@ -0,0 +1,235 @@
+#include "Graphics/GpuProfiler.h"
+#include <algorithm>
+
+bool GpuProfiler::_isEnabled = true;
+uint64_t GpuProfiler::_frameIndex = 0;
+GpuProfiler::FrameSlot GpuProfiler::_slots[GpuProfiler::FramesInFlight];
+std::vector<size_t> GpuProfiler::_passStack;
+RenderStats GpuProfiler::_counters;
+RenderStats GpuProfiler::_lastStats;
+std::vector<GpuPassTiming> GpuProfiler::_timings;
+float GpuProfiler::_frameGpuTime = 0.0f;
+uint64_t GpuProfiler::_resolvedFrameIndex = 0;
+std::ofstream GpuProfiler::_csvFile;
+std::vector<std::string> GpuProfiler::_csvColumns;
+
+void GpuProfiler::BeginFrame() {
+	_frameIndex++;
+
+	// This slot was last used FramesInFlight frames ago, so it's results should be ready by now
+	FrameSlot& slot = _slots[_frameIndex % FramesInFlight];
+	if (slot.Pending) {
+		_Resolve(slot);
+	}
+
+	slot.FrameIndex = _frameIndex;
+	slot.Pending = false;
+	slot.Passes.clear();
+	slot.UsedQueries = 0;
+	_passStack.clear();
+
+	_counters = RenderStats();
+}
+
+void GpuProfiler::EndFrame() {
+	// Close off any passes that were left open so we don't leave dangling queries
+	while (!_passStack.empty()) {
+		EndPass();
+	}
+
+	FrameSlot& slot = _slots[_frameIndex % FramesInFlight];
+	slot.Stats = _counters;
+	slot.Pending = true;
+	_lastStats = _counters;
+}
+
+void GpuProfiler::BeginPass(const char* name) {
+	FrameSlot& slot = _slots[_frameIndex % FramesInFlight];
+
+	PassRecord record;
+	record.Name = name;
+	record.Depth = static_cast<uint32_t>(_passStack.size());
+	record.BeginQuery = 0;
+	record.EndQuery = 0;
+
+	// We use timestamps rather than GL_TIME_ELAPSED, since elapsed queries can't be nested
+	if (_isEnabled) {
+		record.BeginQuery = _AllocQuery(slot);
+		glQueryCounter(record.BeginQuery, GL_TIMESTAMP);
+	}
+
+	_passStack.push_back(slot.Passes.size());
+	slot.Passes.push_back(record);
+}
+
+void GpuProfiler::EndPass() {
+	if (_passStack.empty()) {
+		LOG_WARN("GpuProfiler::EndPass called without a matching BeginPass");
+		return;
+	}
+
+	FrameSlot& slot = _slots[_frameIndex % FramesInFlight];
+	PassRecord& record = slot.Passes[_passStack.back()];
+	_passStack.pop_back();
+
+	if (_isEnabled && record.BeginQuery != 0) {
+		record.EndQuery = _AllocQuery(slot);
+		glQueryCounter(record.EndQuery, GL_TIMESTAMP);
+	}
+}
+
+bool GpuProfiler::IsEnabled() {
+	return _isEnabled;
+}
+
+void GpuProfiler::SetEnabled(bool value) {
+	_isEnabled = value;
+}
+
+const RenderStats& GpuProfiler::GetLastFrameStats() {
+	return _lastStats;
+}
+
+const std::vector<GpuPassTiming>& GpuProfiler::GetPassTimings() {
+	return _timings;
+}
+
+float GpuProfiler::GetFrameGpuTime() {
+	return _frameGpuTime;
+}
+
+uint64_t GpuProfiler::GetResolvedFrameIndex() {
+	return _resolvedFrameIndex;
+}
+
+void GpuProfiler::CountDraw(DrawMode mode, uint32_t elements, uint32_t instances) {
+	_counters.DrawCalls++;
+
+	uint64_t triangles = 0;
+	switch (mode) {
+		case DrawMode::TriangleList:
+			triangles = elements / 3;
+			break;
+		case DrawMode::TriangleStrip:
+		case DrawMode::TriangleFan:
+			triangles = elements > 2 ? elements - 2 : 0;
+			break;
+		default:
+			break;
+	}
+	_counters.Triangles += triangles * instances;
+}
+
+bool GpuProfiler::StartCsvLog(const std::string& path) {
+	StopCsvLog();
+
+	_csvFile.open(path, std::ios::out | std::ios::trunc);
+	if (!_csvFile.is_open()) {
+		LOG_WARN("Failed to open \"{}\" for writing render stats", path);
+		return false;
+	}
+	_csvColumns.clear();
+	LOG_INFO("Logging render stats to \"{}\"", path);
+	return true;
+}
+
+void GpuProfiler::StopCsvLog() {
+	if (_csvFile.is_open()) {
+		_csvFile.close();
+	}
+	_csvColumns.clear();
+}
+
+bool GpuProfiler::IsCsvLogging() {
+	return _csvFile.is_open();
+}
+
+void GpuProfiler::Cleanup() {
+	StopCsvLog();
+	for (auto& slot : _slots) {
+		if (!slot.Queries.empty()) {
+			glDeleteQueries(static_cast<GLsizei>(slot.Queries.size()), slot.Queries.data());
+		}
+		slot.Queries.clear();
+		slot.Passes.clear();
+		slot.UsedQueries = 0;
+		slot.Pending = false;
+	}
+}
+
+uint32_t GpuProfiler::_AllocQuery(FrameSlot& slot) {
+	// Queries are kept around between frames, we only create new ones when a frame has more passes than ever before
+	if (slot.UsedQueries == slot.Queries.size()) {
+		size_t oldSize = slot.Queries.size();
+		size_t newSize = std::max<size_t>(32, oldSize * 2);
+		slot.Queries.resize(newSize);
+		glGenQueries(static_cast<GLsizei>(newSize - oldSize), slot.Queries.data() + oldSize);
+	}
+	return slot.Queries[slot.UsedQueries++];
+}
+
+void GpuProfiler::_Resolve(FrameSlot& slot) {
+	slot.Pending = false;
+
+	// If the GPU is still more than a frame behind, we'd rather drop the results than stall waiting on them
+	if (slot.UsedQueries > 0) {
+		GLint available = 0;
+		glGetQueryObjectiv(slot.Queries[slot.UsedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available) {
+			return;
+		}
+	}
+
+	_resolvedFrameIndex = slot.FrameIndex;
+	_timings.clear();
+	_timings.reserve(slot.Passes.size());
+	_frameGpuTime = 0.0f;
+	for (const auto& pass : slot.Passes) {
+		float ms = 0.0f;
+		if (pass.BeginQuery != 0 && pass.EndQuery != 0) {
+			GLuint64 begin = 0, end = 0;
+			glGetQueryObjectui64v(pass.BeginQuery, GL_QUERY_RESULT, &begin);
+			glGetQueryObjectui64v(pass.EndQuery, GL_QUERY_RESULT, &end);
+			ms = end > begin ? (end - begin) / 1000000.0f : 0.0f;
+		}
+		_timings.push_back({ pass.Name, pass.Depth, ms });
+		if (pass.Depth == 0) {
+			_frameGpuTime += ms;
+		}
+	}
+
+	if (_csvFile.is_open()) {
+		_WriteCsvRow(slot);
+	}
+}
+
+void GpuProfiler::_WriteCsvRow(const FrameSlot& slot) {
+	// The first row we write decides what pass columns the file will have
+	if (_csvColumns.empty()) {
+		_csvFile << "frame,gpu_ms,draw_calls,shader_binds,material_applies,texture_binds,ubo_bytes,triangles";
+		for (const auto& timing : _timings) {
+			if (std::find(_csvColumns.begin(), _csvColumns.end(), timing.Name) == _csvColumns.end()) {
+				_csvColumns.push_back(timing.Name);
+				_csvFile << "," << timing.Name << "_ms";
+			}
+		}
+		_csvFile << "\n";
+	}
+
+	const RenderStats& stats = slot.Stats;
+	_csvFile << slot.FrameIndex << "," << _frameGpuTime << ","
+		<< stats.DrawCalls << "," << stats.ShaderBinds << "," << stats.MaterialApplies << ","
+		<< stats.TextureBinds << "," << stats.UboBytes << "," << stats.Triangles;
+
+	// Passes may show up more than once per frame (ex: one per shadow caster), so we total them by name
+	for (const auto& column : _csvColumns) {
+		float total = 0.0f;
+		for (const auto& timing : _timings) {
+			if (column == timing.Name) {
+				total += timing.Milliseconds;
+			}
+		}
+		_csvFile << "," << total;
+	}
+	_csvFile << "\n";
+}
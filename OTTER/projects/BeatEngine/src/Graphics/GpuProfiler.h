@@ -0,0 +1,164 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Graphics/GlEnums.h"
+#include "Utils/Profiler.h"
+
+#if ENABLE_PROFILING
+// Times the GPU work issued between here and the end of the enclosing scope as a named pass
+#define GPU_PASS(name) ::GpuPassScope PROFILE_CONCAT(__gpuPass, __LINE__)(name)
+#else
+#define GPU_PASS(name)
+#endif
+
+/// <summary>
+/// Counters for the work we submit to OpenGL over a single frame
+/// </summary>
+struct RenderStats {
+	uint32_t DrawCalls       = 0;
+	uint32_t ShaderBinds     = 0;
+	uint32_t MaterialApplies = 0;
+	uint32_t TextureBinds    = 0;
+	uint64_t UboBytes        = 0;
+	uint64_t Triangles       = 0;
+};
+
+/// <summary>
+/// The GPU time taken by a single pass within a frame
+/// </summary>
+struct GpuPassTiming {
+	const char* Name;
+	uint32_t    Depth;
+	float       Milliseconds;
+};
+
+/// <summary>
+/// Measures how long each render pass takes on the GPU, and counts the GL work we submit
+/// per frame. Passes are timed with pairs of timestamp queries that are double buffered,
+/// so we read back the results from 2 frames ago instead of waiting for the GPU to catch up
+/// </summary>
+class GpuProfiler {
+public:
+	// How many frames of queries we keep in flight before reading them back
+	static constexpr int FramesInFlight = 2;
+
+	/// <summary>
+	/// Starts a new frame, reading back the results from the oldest frame in flight
+	/// and resetting the counters. Should be called by the main loop once per frame
+	/// </summary>
+	static void BeginFrame();
+	/// <summary>
+	/// Ends the current frame
+	/// </summary>
+	static void EndFrame();
+
+	/// <summary>
+	/// Begins a new named pass, passes may be nested. Name must be a stable string
+	/// </summary>
+	static void BeginPass(const char* name);
+	/// <summary>
+	/// Ends the most recently started pass
+	/// </summary>
+	static void EndPass();
+
+	/// <summary>
+	/// Gets or sets whether GPU timing queries are issued, counters are always collected
+	/// </summary>
+	static bool IsEnabled();
+	static void SetEnabled(bool value);
+
+	/// <summary>
+	/// Gets the counters for the frame currently being recorded
+	/// </summary>
+	static inline RenderStats& Counters() { return _counters; }
+	/// <summary>
+	/// Gets the counters for the last complete frame
+	/// </summary>
+	static const RenderStats& GetLastFrameStats();
+	/// <summary>
+	/// Gets the pass timings from the last frame that the GPU has finished with
+	/// </summary>
+	static const std::vector<GpuPassTiming>& GetPassTimings();
+	/// <summary>
+	/// Gets the total GPU time for the last resolved frame, in milliseconds
+	/// </summary>
+	static float GetFrameGpuTime();
+	/// <summary>
+	/// Gets the index of the frame that the pass timings were read back from, 0 if none have been read yet
+	/// </summary>
+	static uint64_t GetResolvedFrameIndex();
+
+	/// <summary>
+	/// Records a single draw call, as well as the number of triangles it will produce
+	/// </summary>
+	/// <param name="mode">The primitive type being drawn</param>
+	/// <param name="elements">The number of vertices or indices being drawn</param>
+	/// <param name="instances">The number of instances being drawn</param>
+	static void CountDraw(DrawMode mode, uint32_t elements, uint32_t instances = 1);
+
+	/// <summary>
+	/// Starts writing a row per frame with all the counters and pass timings to a CSV file.
+	/// Pass columns are taken from the first frame written, passes that appear later are skipped
+	/// </summary>
+	/// <param name="path">The path to the CSV file to write</param>
+	/// <returns>True if the file could be opened, false if otherwise</returns>
+	static bool StartCsvLog(const std::string& path);
+	static void StopCsvLog();
+	static bool IsCsvLogging();
+
+	/// <summary>
+	/// Releases all query objects, should be called before the GL context is destroyed
+	/// </summary>
+	static void Cleanup();
+
+protected:
+	struct PassRecord {
+		const char* Name;
+		uint32_t    Depth;
+		uint32_t    BeginQuery;
+		uint32_t    EndQuery;
+	};
+
+	struct FrameSlot {
+		uint64_t                FrameIndex = 0;
+		bool                    Pending = false;
+		RenderStats             Stats;
+		std::vector<PassRecord> Passes;
+		std::vector<uint32_t>   Queries;
+		size_t                  UsedQueries = 0;
+	};
+
+	static bool      _isEnabled;
+	static uint64_t  _frameIndex;
+	static FrameSlot _slots[FramesInFlight];
+	static std::vector<size_t> _passStack;
+
+	static RenderStats _counters;
+	static RenderStats _lastStats;
+	static std::vector<GpuPassTiming> _timings;
+	static float _frameGpuTime;
+	static uint64_t _resolvedFrameIndex;
+
+	static std::ofstream _csvFile;
+	static std::vector<std::string> _csvColumns;
+
+	static uint32_t _AllocQuery(FrameSlot& slot);
+	static void _Resolve(FrameSlot& slot);
+	static void _WriteCsvRow(const FrameSlot& slot);
+};
+
+/// <summary>
+/// Times a single GPU pass for the lifetime of this object, use the GPU_PASS
+/// macro instead of creating these directly so they can be compiled out
+/// </summary>
+class GpuPassScope {
+public:
+	NO_COPY(GpuPassScope);
+	NO_MOVE(GpuPassScope);
+
+	inline GpuPassScope(const char* name) { GpuProfiler::BeginPass(name); }
+	inline ~GpuPassScope() { GpuProfiler::EndPass(); }
+};
@@ -1,12 +1,21 @@
 #include "Graphics/GuiBatcher.h"
 #include <GLM/gtc/matrix_transform.hpp>
 #include <GLM/gtc/matrix_inverse.hpp>
+#include "Graphics/GpuProfiler.h"
 #include "Utils/ResourceManager/ResourceManager.h"
-#include <locale>
-#include <codecvt>
+#include "Utils/StringUtils.h"
+#include <cstddef>
 
+// Used as the scissor rect when none has been pushed, gl_FragCoord will never be outside of it
+static const glm::vec4 NoScissor = glm::vec4(0.0f, 0.0f, 65536.0f, 65536.0f);
 
-std::unordered_map<Texture2D*, GuiBatcher::MeshData> GuiBatcher::_meshBuilders;
+const std::vector<BufferAttribute> GuiBatcher::GuiVertex::V_DECL = {
+	BufferAttribute(0, 2, AttributeType::Float, sizeof(GuiVertex), offsetof(GuiVertex, Position), AttribUsage::Position),
+	BufferAttribute(1, 4, AttributeType::Float, sizeof(GuiVertex), offsetof(GuiVertex, Color), AttribUsage::Color),
+	BufferAttribute(3, 2, AttributeType::Float, sizeof(GuiVertex), offsetof(GuiVertex, UV), AttribUsage::Texture),
+	BufferAttribute(4, 2, AttributeType::Float, sizeof(GuiVertex), offsetof(GuiVertex, Sampling), AttribUsage::User0),
+	BufferAttribute(5, 4, AttributeType::Float, sizeof(GuiVertex), offsetof(GuiVertex, Scissor), AttribUsage::User1),
+};
 
 VertexArrayObject::Sptr GuiBatcher::__vao = nullptr;
 IndexBuffer::Sptr GuiBatcher::__ibo = nullptr;
@@ -16,46 +25,69 @@ int GuiBatcher::__defaultEdgeRadius = 0;
 
 VertexBuffer::Sptr GuiBatcher::__vbo = nullptr;
 ShaderProgram::Sptr GuiBatcher::__shader = nullptr;
-ShaderProgram::Sptr GuiBatcher::__fontShader = nullptr;
 glm::ivec2 GuiBatcher::__windowSize = {0, 0};
 glm::mat4 GuiBatcher::__projection = glm::mat4(1.0f);
 glm::mat3 GuiBatcher::__model = glm::mat3(1.0f);
 std::vector<glm::mat3> GuiBatcher::__modelTransformStack = std::vector<glm::mat3>();
-std::vector<GuiBatcher::IRect> GuiBatcher::__scissorRects = std::vector<GuiBatcher::IRect>();
+std::vector<glm::vec4> GuiBatcher::__scissorRects = std::vector<glm::vec4>();
+
+GuiBatcher::GuiVertex* GuiBatcher::__mappedVertices = nullptr;
+GLsync GuiBatcher::__regionFences[GuiBatcher::RegionCount] = { };
+uint32_t GuiBatcher::__region = 0;
+uint32_t GuiBatcher::__quadCount = 0;
+std::vector<GuiBatcher::DrawCommand> GuiBatcher::__draws = std::vector<GuiBatcher::DrawCommand>();
+uint32_t GuiBatcher::__lastDrawCount = 0;
+
+std::vector<GuiBatcher::GuiVertex> GuiBatcher::__captureVertices = std::vector<GuiBatcher::GuiVertex>();
+std::vector<Texture2D*> GuiBatcher::__captureTextures = std::vector<Texture2D*>();
+std::vector<uint32_t> GuiBatcher::__captureStarts = std::vector<uint32_t>();
+uint32_t GuiBatcher::__generation = 1;
+
+Texture2DArray::Sptr GuiBatcher::__atlas = nullptr;
+uint32_t GuiBatcher::__atlasPages = 0;
+std::vector<GuiBatcher::AtlasShelf> GuiBatcher::__atlasShelves = std::vector<GuiBatcher::AtlasShelf>();
+std::unordered_map<Texture2D*, GuiBatcher::AtlasEntry> GuiBatcher::__atlasEntries;
 
 void GuiBatcher::PushRect(const glm::vec2& min, const glm::vec2& max, const glm::vec4& color, const Texture2D::Sptr& tex, const glm::vec2 uvMin, const glm::vec2 uvMax) {
-	// Create vertices and transform positions
-	VertexPosColTex verts[4];
+	if (tex == nullptr) {
+		return;
+	}
+
+	// Find where the texture lives, so we can remap the UVs into the atlas
+	const AtlasEntry& entry = __GetAtlasEntry(tex, __GetTextureMode(tex));
+	glm::vec2 atlasMin = glm::mix(entry.UVMin, entry.UVMax, uvMin);
+	glm::vec2 atlasMax = glm::mix(entry.UVMin, entry.UVMax, uvMax);
+
+	// Build the quad locally, the streaming buffer is write-combined memory so we copy it over in one go
+	GuiVertex verts[4];
 	verts[0].Position = __model * glm::vec3(min.x, min.y, 1.0f);
 	verts[1].Position = __model * glm::vec3(min.x, max.y, 1.0f);
 	verts[2].Position = __model * glm::vec3(max.x, max.y, 1.0f);
 	verts[3].Position = __model * glm::vec3(max.x, min.y, 1.0f);
-		
-	// Grab mesh info for the texture batch
-	MeshData& mesh = _meshBuilders[tex.get()];
-	// We can use the vertex count for depth, so that things drawn later have a bit of spacing
-	float depth = mesh.Builder.GetVertexCount() / 1000.0f;
 
-	// Copy in all color and set depth 
+	verts[0].UV = glm::vec2(atlasMin.x, atlasMax.y);
+	verts[1].UV = glm::vec2(atlasMin.x, atlasMin.y);
+	verts[2].UV = glm::vec2(atlasMax.x, atlasMin.y);
+	verts[3].UV = glm::vec2(atlasMax.x, atlasMax.y);
+
+	glm::vec2 sampling = glm::vec2((float)entry.Layer, (float)entry.Mode);
+	glm::vec4 scissor = __scissorRects.empty() ? NoScissor : __scissorRects.back();
 	for (int ix = 0; ix < 4; ix++) {
 		verts[ix].Color = color;
-		verts[ix].Position.z = depth;
+		verts[ix].Sampling = sampling;
+		verts[ix].Scissor = scissor;
 	}
 
-	// Copy over UV coords
-	verts[0].UV = glm::vec2(uvMin.x, uvMax.y);
-	verts[1].UV = glm::vec2(uvMin.x, uvMin.y);
-	verts[2].UV = glm::vec2(uvMax.x, uvMin.y);
-	verts[3].UV = glm::vec2(uvMax.x, uvMax.y);
-
-	// Add vertices and indices to range
-	uint32_t ix = mesh.Builder.AddVertexRange(verts, 4);
-	mesh.Builder.AddIndexTri(ix + 0, ix + 2, ix + 1);
-	mesh.Builder.AddIndexTri(ix + 0, ix + 3, ix + 2);
+	Texture2D* standalone = entry.Layer < 0 ? tex.get() : nullptr;
+	__PushQuads(verts, &standalone, 1);
 }
 
 void GuiBatcher::PushRect(const glm::vec2& min, const glm::vec2& max, const glm::vec4& color, const Texture2D::Sptr& tex, int edgeRadius)
 {
+	if (tex == nullptr) {
+		return;
+	}
+
 	if (edgeRadius <= 0) {
 		PushRect(min, max, color, tex, { 0,0 }, { 1,1 });
 	} 
@@ -98,116 +130,139 @@ void GuiBatcher::SetProjection(const glm::mat4& projection) {
 }
 
 void GuiBatcher::RenderText(const std::wstring& text, const Font::Sptr& font, const glm::vec2& position, const glm::vec4& color, float scale /*= 1.0f*/) {
-	// How many characters we have
-	size_t length = text.size();
+	// Lay the text out in a scratch run, anything that draws the same text every frame should keep it's own run
+	static GlyphRun scratch;
+	scratch.SetText(text, font);
+	RenderText(scratch, position, color, scale);
 
-	// Tracks the offset of the character
-	glm::vec2 offset = glm::vec2(0.0f);
+	// Don't hang on to the font, the scratch run outlives everything else
+	scratch.Clear();
+}
 
-	// Transform the origin based off the model transform
-	glm::vec2 origin = position;
+void GuiBatcher::RenderText(const std::string& text, const Font::Sptr& font, const glm::vec2& position, const glm::vec4& color, float scale /*= 1.0f*/)
+{
+	static std::wstring unicode;
+	StringTools::Utf8ToUnicode(text, unicode);
+	RenderText(unicode, font, position, color, scale);
+}
+
+void GuiBatcher::RenderText(const GlyphRun& run, const glm::vec2& position, const glm::vec4& color, float scale /*= 1.0f*/) {
+	const Font::Sptr& font = run.GetFont();
+	if (font == nullptr || run.GetQuads().empty()) {
+		return;
+	}
 
-	// Gets the texture used to render the font
-	Texture2D::Sptr atlas = font->GetAtlas();
+	// Gets the texture used to render the font, and where it lives in the atlas
+	const Texture2D::Sptr& atlas = font->GetAtlas();
+	if (atlas == nullptr) {
+		return;
+	}
+	const AtlasEntry& entry = __GetAtlasEntry(atlas, __GetFontMode(font));
+	Texture2D* standalone = entry.Layer < 0 ? atlas.get() : nullptr;
 
-	// Grab the mesh builder and make sure it's a texture batch
-	MeshData& mesh = _meshBuilders[atlas.get()];
-	mesh.IsFont = true;
+	// Everything but the positions and UVs is shared by all the glyphs
+	GuiVertex verts[4];
+	glm::vec2 sampling = glm::vec2((float)entry.Layer, (float)entry.Mode);
+	glm::vec4 scissor = __scissorRects.empty() ? NoScissor : __scissorRects.back();
+	for (int ix = 0; ix < 4; ix++) {
+		verts[ix].Color = color;
+		verts[ix].Sampling = sampling;
+		verts[ix].Scissor = scissor;
+	}
 
-	// Allocate some space for the vertices
-	VertexPosColTex verts[4];
-	verts[0].Color = color;
-	verts[1].Color = color;
-	verts[2].Color = color;
-	verts[3].Color = color;
+	// The run is in font units, so we only need to scale and transform it
+	for (const GlyphQuad& quad : run.GetQuads()) {
+		for (int ix = 0; ix < 4; ix++) {
+			verts[ix].Position = __model * glm::vec3(position + quad.Positions[ix] * scale, 1.0f);
+			verts[ix].UV = glm::mix(entry.UVMin, entry.UVMax, quad.UVs[ix]);
+		}
+		__PushQuads(verts, &standalone, 1);
+	}
+}
 
-	float depth = mesh.Builder.GetVertexCount() / 1000.0f;
+void GuiBatcher::Flush()
+{
+	__StaticInit();
 
-	// Iterate over all characters in string
-	for (int i = 0; i < length; i++) {
-		// Grab the glyph data for the character
-		GlyphInfo glyph = font->GetGlyph(text[i], offset.x, offset.y);
+	if (__quadCount > 0) {
+		__vao->Bind();
+		__shader->Bind();
+		__shader->SetUniformMatrix(0, &__projection, 1, false);
+		__atlas->Bind(0);
 
-		// A newline will advance to the next line and return to the start of the line
-		if (text[i] == '\n') {
-			offset.y  += font->GetLineHeight() * scale;
-			offset.x = 0;
-		}
-		// A return character simply returns to the start of the line
-		else if (text[i] == '\r') {
-			offset.x = 0;
-		}
-		// A tab character is 4 spaces
-		else if (text[i] == '\t') {
-			float xOffTemp{ 0 }, yOffTemp{ 0 };
-			glyph = font->GetGlyph(' ', xOffTemp, yOffTemp);
-			offset.x += glyph.OffsetX * 4;
-		}
-		// All other characters get rendered
-		else {
-			verts[0].Position = __model * glm::vec3(origin + (offset + glyph.Positions[0]) * scale, 1.0f);
-			verts[1].Position = __model * glm::vec3(origin + (offset + glyph.Positions[1]) * scale, 1.0f);
-			verts[2].Position = __model * glm::vec3(origin + (offset + glyph.Positions[2]) * scale, 1.0f);
-			verts[3].Position = __model * glm::vec3(origin + (offset + glyph.Positions[3]) * scale, 1.0f);
-			verts[0].UV = glyph.UVs[0];
-			verts[1].UV = glyph.UVs[1];
-			verts[2].UV = glyph.UVs[2];
-			verts[3].UV = glyph.UVs[3];
-
-			verts[0].Position.z = verts[1].Position.z = verts[2].Position.z = verts[3].Position.z = depth;
-
-			uint32_t ix = mesh.Builder.AddVertexRange(verts, 4);
-			mesh.Builder.AddIndexTri(ix + 0, ix + 1, ix + 2);
-			mesh.Builder.AddIndexTri(ix + 0, ix + 2, ix + 3);
-
-			// Advance the offset based on the size of the glyph
-			offset.x = glyph.OffsetX;
-			offset.y = glyph.OffsetY;
-
-			// If we have more characters, see if there's any kerning between the
-			// current and next character and add it to the x offset
-			if (i < length - 1) {
-				float kerning = font->GetKerning(text[i], text[i + 1]);
-				offset.x += kerning;
+		// Every draw reads from the same index buffer, the base vertex moves it to the run's quads
+		for (const DrawCommand& draw : __draws) {
+			if (draw.Texture != nullptr) {
+				draw.Texture->Bind(1);
 			}
+			GLint baseVertex = (GLint)((__region * QuadsPerRegion + draw.FirstQuad) * 4);
+			glDrawElementsBaseVertex(GL_TRIANGLES, draw.QuadCount * 6, GL_UNSIGNED_INT, nullptr, baseVertex);
+			GpuProfiler::CountDraw(DrawMode::TriangleList, draw.QuadCount * 6);
 		}
 
+		// Fence off the region we just drew from, and move on to the next one. If the GPU is still
+		// reading from that one we have to wait for it, otherwise we'd be writing over it's vertices
+		__regionFences[__region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		__region = (__region + 1) % RegionCount;
+		if (__regionFences[__region] != nullptr) {
+			GLenum result = glClientWaitSync(__regionFences[__region], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+			if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED) {
+				LOG_WARN("Timed out waiting for the GPU to finish with a GUI buffer region");
+			}
+			glDeleteSync(__regionFences[__region]);
+			__regionFences[__region] = nullptr;
+		}
 	}
 
+	__lastDrawCount = (uint32_t)__draws.size();
+	__draws.clear();
+	__quadCount = 0;
 }
 
-void GuiBatcher::RenderText(const std::string& text, const Font::Sptr& font, const glm::vec2& position, const glm::vec4& color, float scale /*= 1.0f*/)
-{
-	static std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
-	RenderText(converter.from_bytes(text), font, position, color, scale);
+uint32_t GuiBatcher::GetLastDrawCount() {
+	return __lastDrawCount;
 }
 
-void GuiBatcher::Flush()
-{
+bool GuiBatcher::QuadCache::IsValid() const {
+	return _generation == GuiBatcher::__generation;
+}
+
+void GuiBatcher::BeginCapture() {
+	__captureStarts.push_back((uint32_t)__captureTextures.size());
+}
+
+void GuiBatcher::EndCapture(QuadCache& cache) {
+	LOG_ASSERT(__captureStarts.size() > 0, "Capture begin/end mismatch!");
+	uint32_t start = __captureStarts.back();
+	__captureStarts.pop_back();
+
+	cache._textures.assign(__captureTextures.begin() + start, __captureTextures.end());
+	cache._vertices.assign(__captureVertices.begin() + (size_t)start * 4, __captureVertices.end());
+	cache._generation = __generation;
+
+	// Once the outermost capture is done, everything has been copied out
+	if (__captureStarts.empty()) {
+		__captureTextures.clear();
+		__captureVertices.clear();
+	}
+}
+
+void GuiBatcher::DrawCache(const QuadCache& cache) {
 	__StaticInit();
+	if (cache.GetQuadCount() > 0) {
+		__PushQuads(cache._vertices.data(), cache._textures.data(), cache.GetQuadCount());
+	}
+}
 
-	// Iterate over each texture and it's mesh
-	for (auto&[key, value] : _meshBuilders) {
-		Texture2D* tex = key;
-		// If the texture exists and the mesh has data
-		if (tex != nullptr && value.Builder.GetIndexCount() > 0) {
-			// Update the VAO and it's buffers
-			__vao->Bind();
-			__vbo->UpdateData(value.Builder.GetVertexDataPtr(), sizeof(VertexPosColTex), value.Builder.GetVertexCount(), true);
-			__ibo->UpdateData(value.Builder.GetIndexDataPtr(), sizeof(uint32_t), value.Builder.GetIndexCount(), true);
-
-			// Bind texture, send uniforms to shader
-			tex->Bind(0);
-			ShaderProgram::Sptr shader = value.IsFont ? __fontShader : __shader;
-			shader->Bind();
-			shader->SetUniformMatrix(0, &__projection, 1, false);
-
-			// Draw geometry
-			__vao->Draw();
-
-			// Clear mesh
-			value.Builder.Reset();
-		}
+void GuiBatcher::PreloadTexture(const Texture2D::Sptr& texture) {
+	if (texture != nullptr) {
+		__GetAtlasEntry(texture, __GetTextureMode(texture));
+	}
+}
+
+void GuiBatcher::PreloadFont(const Font::Sptr& font) {
+	if (font != nullptr && font->GetAtlas() != nullptr) {
+		__GetAtlasEntry(font->GetAtlas(), __GetFontMode(font));
 	}
 }
 
@@ -224,87 +279,298 @@ void GuiBatcher::PopModelTransform()
 }
 
 void GuiBatcher::SetWindowSize(const glm::ivec2& size) {
-	__windowSize = size;
+	if (size != __windowSize) {
+		__windowSize = size;
+		__generation++;
+	}
 }
 
-void GuiBatcher::__StaticInit()
-{
-	static bool needsInit = true;
-	if (needsInit) {
-		__shader = ShaderProgram::Create();
-		__shader->LoadShaderPart(R"LIT(#version 460
-					layout(location = 0) in vec3 inPos;
-					layout(location = 1) in vec4 inColor;
-					layout(location = 3) in vec2 inUV;
+const GuiBatcher::AtlasEntry& GuiBatcher::__GetAtlasEntry(const Texture2D::Sptr& texture, SampleMode mode) {
+	__StaticInit();
 
-					layout(location = 0) out vec4 outColor;
-					layout(location = 1) out vec2 outUV;
+	// If the texture that was packed has since been destroyed, this is a new texture at the same address
+	auto it = __atlasEntries.find(texture.get());
+	if (it != __atlasEntries.end() && !it->second.Texture.expired()) {
+		return it->second;
+	}
 
-					layout(location = 0) uniform mat4 u_Projection;
+	AtlasEntry& entry = __atlasEntries[texture.get()];
+	entry = AtlasEntry();
+	entry.Texture = texture;
+	entry.Mode = mode;
 
-					void main() {
-						outColor = inColor;
-						outUV = inUV;
-						gl_Position = u_Projection * vec4(inPos, 1);
-					}
-				)LIT", ShaderPartType::Vertex);
+	// Textures drawn on their own use their own sampler settings, so they only need the font modes
+	if (!__PackTexture(texture, entry) && entry.Mode == SampleMode::Nearest) {
+		entry.Mode = SampleMode::Linear;
+	}
+	return entry;
+}
 
-		__shader->LoadShaderPart(R"LIT(#version 460
-					layout(location = 0) in vec4 inColor;
-					layout(location = 1) in vec2 inUV;
+GuiBatcher::SampleMode GuiBatcher::__GetTextureMode(const Texture2D::Sptr& texture) {
+	return texture->GetMagFilter() == MagFilter::Nearest ? SampleMode::Nearest : SampleMode::Linear;
+}
 
-					layout(location = 0) out vec4 outColor;
+GuiBatcher::SampleMode GuiBatcher::__GetFontMode(const Font::Sptr& font) {
+	return font->GetAtlasMode() == FontAtlasMode::SDF ? SampleMode::SdfFont : SampleMode::Font;
+}
+
+bool GuiBatcher::__PackTexture(const Texture2D::Sptr& texture, AtlasEntry& entry) {
+	uint32_t width = texture->GetWidth();
+	uint32_t height = texture->GetHeight();
+	if (width == 0 || height == 0 || width > MaxAtlasEntrySize || height > MaxAtlasEntrySize) {
+		return false;
+	}
+	if (texture->GetDescription().MultisampleCount != 1) {
+		return false;
+	}
+	// We read the texels back as 8 bit RGBA, so anything that would lose precision or be converted on the way stays out.
+	// Cooked textures are fine, the driver decompresses them for us
+	switch (texture->GetFormat()) {
+		case InternalFormat::R8:
+		case InternalFormat::RG8:
+		case InternalFormat::RGB8:
+		case InternalFormat::RGBA8:
+		case InternalFormat::BC1:
+		case InternalFormat::BC3:
+		case InternalFormat::BC7:
+			break;
+		default:
+			return false;
+	}
 
-					uniform layout(binding=0) sampler2D s_Texture;
+	// Leave a 1 texel border so that linear filtering at the edges doesn't bleed in neighbouring entries
+	uint32_t layer;
+	glm::uvec2 offset;
+	if (!__AllocateAtlasRect(width + 2, height + 2, layer, offset)) {
+		LOG_WARN("The GUI atlas is full, a {}x{} texture will be drawn on it's own", width, height);
+		return false;
+	}
 
-					void main() {
-						outColor = texture(s_Texture, inUV) * inColor;
-					}
-				)LIT", ShaderPartType::Fragment);
+	std::vector<glm::u8vec4> source(width * (size_t)height);
+	glGetTextureImage(texture->GetHandle(), 0, GL_RGBA, GL_UNSIGNED_BYTE, (GLsizei)(source.size() * sizeof(glm::u8vec4)), source.data());
 
-		__shader->Link();
+	// Copy the texels into the middle of the border, and extrude the edges out into it
+	std::vector<glm::u8vec4> padded((width + 2) * (size_t)(height + 2));
+	for (uint32_t iy = 0; iy < height + 2; iy++) {
+		uint32_t sourceY = glm::clamp<int>((int)iy - 1, 0, height - 1);
+		for (uint32_t ix = 0; ix < width + 2; ix++) {
+			uint32_t sourceX = glm::clamp<int>((int)ix - 1, 0, width - 1);
+			padded[iy * (width + 2) + ix] = source[sourceY * width + sourceX];
+		}
+	}
+	__atlas->LoadData(width + 2, height + 2, 1, PixelFormat::RGBA, PixelType::UByte, padded.data(), offset.x, offset.y, layer);
+
+	entry.Layer = (int)layer;
+	entry.UVMin = (glm::vec2(offset) + 1.0f) / (float)AtlasPageSize;
+	entry.UVMax = (glm::vec2(offset) + 1.0f + glm::vec2(width, height)) / (float)AtlasPageSize;
+	return true;
+}
+
+bool GuiBatcher::__AllocateAtlasRect(uint32_t width, uint32_t height, uint32_t& outLayer, glm::uvec2& outOffset) {
+	// Use the shortest shelf that the rect fits on, so we waste as little height as we can
+	AtlasShelf* best = nullptr;
+	for (AtlasShelf& shelf : __atlasShelves) {
+		if (shelf.Height >= height && shelf.X + width <= AtlasPageSize && (best == nullptr || shelf.Height < best->Height)) {
+			best = &shelf;
+		}
+	}
+
+	// Otherwise start a new shelf under the last one on a page
+	if (best == nullptr) {
+		uint32_t layer = 0;
+		uint32_t top = 0;
+		for (; layer < __atlasPages; layer++) {
+			top = 0;
+			for (const AtlasShelf& shelf : __atlasShelves) {
+				if (shelf.Layer == layer) {
+					top = glm::max(top, shelf.Y + shelf.Height);
+				}
+			}
+			if (top + height <= AtlasPageSize) {
+				break;
+			}
+		}
+
+		// Every page is full, add another one
+		if (layer == __atlasPages) {
+			if (__atlasPages >= MaxAtlasPages) {
+				return false;
+			}
+			__GrowAtlas();
+			top = 0;
+		}
+
+		__atlasShelves.push_back({ layer, top, height, 0 });
+		best = &__atlasShelves.back();
+	}
+
+	outLayer = best->Layer;
+	outOffset = glm::uvec2(best->X, best->Y);
+	best->X += width;
+	return true;
+}
 
-		__fontShader = ShaderProgram::Create();
-		__fontShader->LoadShaderPart(R"LIT(#version 460
-					layout(location = 0) in vec3 inPos;
+void GuiBatcher::__GrowAtlas() {
+	Texture2DArrayDescription desc = Texture2DArrayDescription();
+	desc.Width = AtlasPageSize * (__atlasPages + 1);
+	desc.Height = AtlasPageSize;
+	desc.XDivisions = __atlasPages + 1;
+	desc.YDivisions = 1;
+	desc.Format = InternalFormat::RGBA8;
+	desc.HorizontalWrap = WrapMode::ClampToEdge;
+	desc.VerticalWrap = WrapMode::ClampToEdge;
+	desc.MinificationFilter = MinFilter::Linear;
+	desc.MagnificationFilter = MagFilter::Linear;
+	desc.MaxAnisotropic = 1.0f;
+	desc.GenerateMipMaps = false;
+
+	// Texture storage is immutable, so we make a bigger array and copy the existing pages over on the GPU
+	Texture2DArray::Sptr atlas = std::make_shared<Texture2DArray>(desc);
+	if (__atlas != nullptr) {
+		glCopyImageSubData(
+			__atlas->GetHandle(), GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+			atlas->GetHandle(), GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+			AtlasPageSize, AtlasPageSize, __atlasPages
+		);
+	}
+	atlas->SetDebugName("GUI Atlas");
+
+	__atlas = atlas;
+	__atlasPages++;
+}
+
+void GuiBatcher::__PushQuads(const GuiVertex* vertices, Texture2D* const* standalone, uint32_t count) {
+	if (!__captureStarts.empty()) {
+		__captureVertices.insert(__captureVertices.end(), vertices, vertices + count * 4);
+		__captureTextures.insert(__captureTextures.end(), standalone, standalone + count);
+	}
+
+	uint32_t written = 0;
+	while (written < count) {
+		if (__quadCount >= QuadsPerRegion) {
+			Flush();
+		}
+
+		// Quads that only use the atlas can go in any draw. A quad with it's own texture can join the
+		// current draw if that draw hasn't needed a texture yet, or needs the same one
+		uint32_t batch = glm::min(count - written, QuadsPerRegion - __quadCount);
+		for (uint32_t ix = 0; ix < batch; ix++) {
+			Texture2D* texture = standalone[written + ix];
+			if (__draws.empty() || (texture != nullptr && __draws.back().Texture != nullptr && __draws.back().Texture != texture)) {
+				__draws.push_back({ texture, __quadCount + ix, 0 });
+			}
+			else if (texture != nullptr) {
+				__draws.back().Texture = texture;
+			}
+			__draws.back().QuadCount++;
+		}
+
+		memcpy(__mappedVertices + ((size_t)__region * QuadsPerRegion + __quadCount) * 4, vertices + (size_t)written * 4, sizeof(GuiVertex) * 4 * batch);
+		__quadCount += batch;
+		written += batch;
+	}
+}
+
+void GuiBatcher::__StaticInit()
+{
+	static bool needsInit = true;
+	if (needsInit) {
+		needsInit = false;
+
+		__shader = ShaderProgram::Create();
+		__shader->LoadShaderPart(R"LIT(#version 460
+					layout(location = 0) in vec2 inPos;
 					layout(location = 1) in vec4 inColor;
 					layout(location = 3) in vec2 inUV;
+					layout(location = 4) in vec2 inSampling;
+					layout(location = 5) in vec4 inScissor;
 
 					layout(location = 0) out vec4 outColor;
 					layout(location = 1) out vec2 outUV;
+					layout(location = 2) flat out vec2 outSampling;
+					layout(location = 3) flat out vec4 outScissor;
 
 					layout(location = 0) uniform mat4 u_Projection;
 
 					void main() {
 						outColor = inColor;
 						outUV = inUV;
-						gl_Position = u_Projection * vec4(inPos, 1);
+						outSampling = inSampling;
+						outScissor = inScissor;
+						gl_Position = u_Projection * vec4(inPos, 0, 1);
 					}
 				)LIT", ShaderPartType::Vertex);
 
-		__fontShader->LoadShaderPart(R"LIT(#version 460
+		__shader->LoadShaderPart(R"LIT(#version 460
 					layout(location = 0) in vec4 inColor;
 					layout(location = 1) in vec2 inUV;
+					layout(location = 2) flat in vec2 inSampling;
+					layout(location = 3) flat in vec4 inScissor;
 
 					layout(location = 0) out vec4 outColor;
 
-					uniform layout(binding=0) sampler2D s_Texture;
+					uniform layout(binding=0) sampler2DArray s_Atlas;
+					uniform layout(binding=1) sampler2D s_Texture;
 
 					void main() {
-						float fontPow = texture(s_Texture, inUV).r;
-						outColor = vec4(inColor.rgb, fontPow);
+						// Scissoring is done here rather than with glScissor so that it doesn't break the batch
+						if (gl_FragCoord.x < inScissor.x || gl_FragCoord.y < inScissor.y || gl_FragCoord.x >= inScissor.z || gl_FragCoord.y >= inScissor.w) {
+							discard;
+						}
+
+						// A negative layer means the quad uses a texture that isn't in the atlas
+						vec4 texel;
+						if (inSampling.x < 0.0) {
+							texel = texture(s_Texture, inUV);
+						} else if (inSampling.y == 1.0) {
+							texel = texelFetch(s_Atlas, ivec3(inUV * vec2(textureSize(s_Atlas, 0).xy), int(inSampling.x)), 0);
+						} else {
+							texel = texture(s_Atlas, vec3(inUV, inSampling.x));
+						}
+
+						// Fonts only store coverage or distance in the red channel
+						if (inSampling.y == 2.0) {
+							outColor = vec4(inColor.rgb, texel.r);
+						} else if (inSampling.y == 3.0) {
+							// The edge is at 0.5, anti-alias over about a pixel either side of it at any scale
+							float width = fwidth(texel.r);
+							outColor = vec4(inColor.rgb, smoothstep(0.5 - width, 0.5 + width, texel.r));
+						} else {
+							outColor = texel * inColor;
+						}
 					}
-				)LIT" , ShaderPartType::Fragment);
+				)LIT", ShaderPartType::Fragment);
 
-		__fontShader->Link();
+		__shader->Link();
 
+		// The vertex buffer stays mapped for the lifetime of the app, we write each flush's quads into
+		// the next region and fence it off once it's been drawn
 		__vbo = VertexBuffer::Create(BufferUsage::DynamicDraw);
-		__ibo = IndexBuffer::Create(BufferUsage::DynamicDraw, IndexType::UInt);
+		BufferMapMode mapMode = BufferMapMode::Write | BufferMapMode::Persistent | BufferMapMode::Coherent;
+		__vbo->AllocateStorage(sizeof(GuiVertex), RegionCount * QuadsPerRegion * 4, mapMode);
+		__vbo->SetDebugName("GUI Vertices");
+		__mappedVertices = reinterpret_cast<GuiVertex*>(__vbo->Map(mapMode));
+
+		// Every quad has the same indices, so they only need to be uploaded once
+		std::vector<uint32_t> indices(QuadsPerRegion * 6);
+		for (uint32_t ix = 0; ix < QuadsPerRegion; ix++) {
+			indices[ix * 6 + 0] = ix * 4 + 0;
+			indices[ix * 6 + 1] = ix * 4 + 1;
+			indices[ix * 6 + 2] = ix * 4 + 2;
+			indices[ix * 6 + 3] = ix * 4 + 0;
+			indices[ix * 6 + 4] = ix * 4 + 2;
+			indices[ix * 6 + 5] = ix * 4 + 3;
+		}
+		__ibo = IndexBuffer::Create(BufferUsage::StaticDraw, IndexType::UInt);
+		__ibo->LoadData(indices.data(), (uint32_t)indices.size());
 
 		__vao = VertexArrayObject::Create();
-		__vao->AddVertexBuffer(__vbo, VertexPosColTex::V_DECL);
+		__vao->AddVertexBuffer(__vbo, GuiVertex::V_DECL);
 		__vao->SetIndexBuffer(__ibo);
 
+		// Start with a single atlas page, so that there's always something bound
+		__GrowAtlas();
+
 		// Generate a simple white texture with a black border
 		if (__defaultUITexture == nullptr) {
 			Texture2DDescription desc = Texture2DDescription();
@@ -328,8 +594,6 @@ void GuiBatcher::__StaticInit()
 			}
 			__defaultUITexture->LoadData(16, 16, PixelFormat::RGBA, PixelType::UByte, data);
 		}
-
-		needsInit = false;
 	}
 }
 
@@ -346,36 +610,18 @@ void GuiBatcher::PushScissorRect(const glm::vec2& min, const glm::vec2& max) {
 	glm::ivec2 minWin = glm::floor(((minNDC + 1.0f) / 2.0f) * (glm::vec2)__windowSize);
 	glm::ivec2 maxWin = glm::ceil(((maxNDC + 1.0f) / 2.0f)  * (glm::vec2)__windowSize);
 
-	// Store the bounds
-	__scissorRects.push_back({ minWin, maxWin });
-
-	// Calculate the actual size
-	int width  = glm::max(maxWin.x, minWin.x) - glm::min(maxWin.x, minWin.x);
-	int height = glm::max(maxWin.y, minWin.y) - glm::min(maxWin.y, minWin.y);
-
-	// Draw current geo with the current scissor, then update it
-	Flush();
-	glScissor(minWin.x, maxWin.y, width, height);
+	// Store the bounds, flipping them so that min is the bottom left corner like gl_FragCoord
+	__scissorRects.push_back(glm::vec4(glm::min(minWin, maxWin), glm::max(minWin, maxWin)));
 }
 
 void GuiBatcher::PopScissorRect() {
 	LOG_ASSERT(__scissorRects.size() > 0, "Scissor rect push/pop mismatch!");
 	__scissorRects.pop_back();
-
-	// Grab the last scissor rect, or just use window bounds if none left
-	IRect bounds = __scissorRects.size() > 0 ? __scissorRects.back() : IRect{ { 0, 0 }, { __windowSize.x, __windowSize.y } };
-
-	// Calculate the actual size
-	int width  = glm::max(bounds.Min.x, bounds.Max.x) - glm::min(bounds.Min.x, bounds.Max.x);
-	int height = glm::max(bounds.Min.y, bounds.Max.y) - glm::min(bounds.Min.y, bounds.Max.y);
-
-	// Draw current geo with the current scissor, then update it
-	Flush();
-	glScissor(glm::min(bounds.Min.x, bounds.Max.x), glm::min(bounds.Min.y, bounds.Max.y), width, height);
 }
 
 void GuiBatcher::SetDefaultTexture(const Texture2D::Sptr& value) {
 	__defaultUITexture = value;
+	PreloadTexture(value);
 }
 
 const Texture2D::Sptr& GuiBatcher::GetDefaultTexture() {
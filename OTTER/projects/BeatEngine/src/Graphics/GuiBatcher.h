@@ -3,19 +3,62 @@
 #include <GLM/glm.hpp>
 
 #include "Graphics/Textures/Texture2D.h"
+#include "Graphics/Textures/Texture2DArray.h"
 #include "Graphics/ShaderProgram.h"
 #include "Graphics/VertexArrayObject.h"
-#include "Graphics/VertexTypes.h"
 #include "Graphics/Font.h"
-#include "Utils/MeshBuilder.h"
+#include "Graphics/GlyphRun.h"
 #include <unordered_map>
 
 	/// <summary>
 	/// The GUI Batcher class provides utilities for drawing rectangles and
 	/// fonts to the screen in a 2D fashion
+	/// 
+	/// GUI textures and font atlases are copied into a shared atlas the first time they're seen (or when
+	/// preloaded), and every quad is written straight into a persistently mapped vertex buffer in the order
+	/// it was pushed. Scissor rects are stored per vertex, so a whole frame of GUI is normally a single draw
+	/// call. Only textures that can't go in the atlas (too big, or an unsupported format) break the batch
+	/// 
+	/// The quads emitted between BeginCapture and EndCapture can be kept in a QuadCache and replayed on later
+	/// frames, which is how retained GUI trees skip rebuilding anything that hasn't changed
 	/// </summary>
 	class GuiBatcher {
+	private:
+		// How the fragment shader should treat the texture for a vertex
+		enum class SampleMode {
+			Linear  = 0,
+			// Texels are fetched directly, for textures that were using nearest filtering
+			Nearest = 1,
+			// The red channel is coverage, and the vertex color is used as-is
+			Font    = 2,
+			// The red channel is a distance field, with the glyph edge at 0.5
+			SdfFont = 3
+		};
+
+		struct GuiVertex {
+			glm::vec2 Position;
+			glm::vec4 Color;
+			glm::vec2 UV;
+			// X is the atlas layer, or -1 to sample the standalone texture, Y is the SampleMode
+			glm::vec2 Sampling;
+			// The scissor rect in window pixels, as (minX, minY, maxX, maxY)
+			glm::vec4 Scissor;
+
+			static const std::vector<BufferAttribute> V_DECL;
+		};
+
 	public:
+		// The size of a single page of the atlas, in texels
+		static constexpr uint32_t AtlasPageSize = 2048;
+		// The most pages the atlas can grow to, anything that doesn't fit after that is drawn on it's own
+		static constexpr uint32_t MaxAtlasPages = 4;
+		// Textures larger than this along either axis are never put in the atlas
+		static constexpr uint32_t MaxAtlasEntrySize = 1024;
+		// The number of quads that fit in one region of the streaming buffer, a region that fills up is flushed early
+		static constexpr uint32_t QuadsPerRegion = 4096;
+		// The number of regions in the streaming buffer, the CPU only waits on the GPU if it gets this many flushes ahead
+		static constexpr uint32_t RegionCount = 3;
+
 		/// <summary>
 		/// Adds a rectangle to the GUI batch, with a given border radius in pixels.
 		/// This can be used with textures to create rounded borders
@@ -55,6 +98,14 @@
 		/// <param name="color">The color of the text</param>
 		/// <param name="scale">The scaling to apply to the text</param>
 		static void RenderText(const std::string& text, const Font::Sptr& font, const glm::vec2& position, const glm::vec4& color, float scale = 1.0f);
+		/// <summary>
+		/// Renders a run of text that has already been laid out, this skips looking up each glyph
+		/// </summary>
+		/// <param name="run">The glyph run to render</param>
+		/// <param name="position">The position of the text in model space</param>
+		/// <param name="color">The color of the text</param>
+		/// <param name="scale">The scaling to apply to the text</param>
+		static void RenderText(const GlyphRun& run, const glm::vec2& position, const glm::vec4& color, float scale = 1.0f);
 
 		/// <summary>
 		/// Sets the projection matrix to use for rendering, should ideally be an orthographic
@@ -69,6 +120,61 @@
 		/// Draws all geometry to the screen and prepares for the next batch
 		/// </summary>
 		static void Flush();
+		/// <summary>
+		/// Gets the number of draw calls that the last Flush made
+		/// </summary>
+		static uint32_t GetLastDrawCount();
+
+		/// <summary>
+		/// A copy of the quads that were emitted during a capture, in window space. Caches
+		/// are invalidated whenever the window size changes
+		/// </summary>
+		class QuadCache {
+		public:
+			/// <summary>
+			/// Gets the number of quads held by this cache
+			/// </summary>
+			uint32_t GetQuadCount() const { return (uint32_t)_textures.size(); }
+			/// <summary>
+			/// Returns true if the cache was captured since the last time the window changed size
+			/// </summary>
+			bool IsValid() const;
+
+		private:
+			friend class GuiBatcher;
+			std::vector<GuiVertex>  _vertices;
+			// The standalone texture for each quad, or nullptr if it comes from the atlas
+			std::vector<Texture2D*> _textures;
+			uint32_t                _generation = 0;
+		};
+
+		/// <summary>
+		/// Starts recording the quads that are pushed, captures can be nested
+		/// </summary>
+		static void BeginCapture();
+		/// <summary>
+		/// Stops the innermost capture, and copies everything pushed since it began into the cache
+		/// </summary>
+		/// <param name="cache">The cache to overwrite</param>
+		static void EndCapture(QuadCache& cache);
+		/// <summary>
+		/// Pushes the quads in a cache to the batch, as they were when they were captured. The current
+		/// transform and scissor stacks are ignored
+		/// </summary>
+		/// <param name="cache">The cache to draw</param>
+		static void DrawCache(const QuadCache& cache);
+
+		/// <summary>
+		/// Copies a texture into the GUI atlas ahead of time, so that it doesn't have to be done
+		/// mid-frame the first time it's drawn. Textures that can't go in the atlas are ignored
+		/// </summary>
+		/// <param name="texture">The texture to pack</param>
+		static void PreloadTexture(const Texture2D::Sptr& texture);
+		/// <summary>
+		/// Copies a font's atlas into the GUI atlas ahead of time
+		/// </summary>
+		/// <param name="font">The font to pack, must already be baked</param>
+		static void PreloadFont(const Font::Sptr& font);
 
 		/// <summary>
 		/// Push a new transform to the stack, this will be multiplied with the
@@ -82,14 +188,14 @@
 		static void PopModelTransform();
 
 		/// <summary>
-		/// Sets a new scissor region in model space. Note that this will invoke a 
-		/// flush
+		/// Sets a new scissor region in model space. Scissor rects are applied per vertex, so
+		/// this doesn't break the batch
 		/// </summary>
 		/// <param name="min">The minimum bounds of the scissor rectangle</param>
 		/// <param name="min">The maximum bounds of the scissor rectangle</param>
 		static void PushScissorRect(const glm::vec2& min, const glm::vec2& max);
 		/// <summary>
-		/// Pops the last scissor region, not that this will invoke a flush
+		/// Pops the last scissor region
 		/// </summary>
 		static void PopScissorRect();
 
@@ -113,30 +219,74 @@
 		static int GetDefaultBorderRadius();
 
 	private:
-		struct IRect {
-			glm::ivec2 Min;
-			glm::ivec2 Max;
+		// Where a texture ended up in the atlas
+		struct AtlasEntry {
+			// Used to detect when a texture has been destroyed and it's address re-used
+			std::weak_ptr<Texture2D> Texture;
+			// The atlas layer, or -1 if the texture is drawn on it's own
+			int        Layer = -1;
+			// The atlas UVs that the texture's 0-1 range maps to
+			glm::vec2  UVMin = glm::vec2(0.0f);
+			glm::vec2  UVMax = glm::vec2(1.0f);
+			SampleMode Mode = SampleMode::Linear;
 		};
 
-		struct MeshData {
-			MeshBuilder<VertexPosColTex> Builder;
-			bool IsFont;
+		// A row of entries within an atlas page, entries are packed left to right
+		struct AtlasShelf {
+			uint32_t Layer;
+			uint32_t Y;
+			uint32_t Height;
+			uint32_t X;
+		};
+
+		// A run of quads that can be drawn with a single call
+		struct DrawCommand {
+			// The standalone texture to bind, or nullptr if the run only uses the atlas
+			Texture2D* Texture;
+			uint32_t   FirstQuad;
+			uint32_t   QuadCount;
 		};
 
 		static glm::ivec2 __windowSize;
 		static glm::mat4 __projection;
 		static glm::mat3 __model;
 		static std::vector<glm::mat3> __modelTransformStack;
-		static std::vector<IRect> __scissorRects;
+		static std::vector<glm::vec4> __scissorRects;
 		static ShaderProgram::Sptr __shader;
-		static ShaderProgram::Sptr __fontShader;
-		static std::unordered_map<Texture2D*, MeshData> _meshBuilders;
 		static VertexArrayObject::Sptr __vao;
 		static VertexBuffer::Sptr __vbo;
 		static IndexBuffer::Sptr __ibo;
 
+		// The streaming buffer, the region that we're currently writing to and how much of it we've filled
+		static GuiVertex* __mappedVertices;
+		static GLsync __regionFences[RegionCount];
+		static uint32_t __region;
+		static uint32_t __quadCount;
+		static std::vector<DrawCommand> __draws;
+		static uint32_t __lastDrawCount;
+
+		// Everything pushed during the outermost capture, and where each nested capture started
+		static std::vector<GuiVertex> __captureVertices;
+		static std::vector<Texture2D*> __captureTextures;
+		static std::vector<uint32_t> __captureStarts;
+		// Bumped when the window is resized, since the scissor rects in caches are in window space
+		static uint32_t __generation;
+
+		static Texture2DArray::Sptr __atlas;
+		static uint32_t __atlasPages;
+		static std::vector<AtlasShelf> __atlasShelves;
+		static std::unordered_map<Texture2D*, AtlasEntry> __atlasEntries;
+
 		static Texture2D::Sptr __defaultUITexture;
 		static int __defaultEdgeRadius;
 
 		static void __StaticInit();
-	};
+		static const AtlasEntry& __GetAtlasEntry(const Texture2D::Sptr& texture, SampleMode mode);
+		static SampleMode __GetTextureMode(const Texture2D::Sptr& texture);
+		static SampleMode __GetFontMode(const Font::Sptr& font);
+		static bool __PackTexture(const Texture2D::Sptr& texture, AtlasEntry& entry);
+		static bool __AllocateAtlasRect(uint32_t width, uint32_t height, uint32_t& outLayer, glm::uvec2& outOffset);
+		static void __GrowAtlas();
+		// Copies quads into the streaming buffer, and adds them to the current draw
+		static void __PushQuads(const GuiVertex* vertices, Texture2D* const* standalone, uint32_t count);
+	};
\ No newline at end of file
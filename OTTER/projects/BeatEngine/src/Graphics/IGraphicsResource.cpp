@@ -1,10 +1,22 @@
 #include "Graphics/IGraphicsResource.h"
 
+#include <typeinfo>
+
+#include "Utils/MemoryTracker.h"
+#include "Utils/StringUtils.h"
+
 IGraphicsResource::IGraphicsResource() :
 	_debugName(""),
-	_rendererId(0)
+	_rendererId(0),
+	_gpuMemory(0)
 { }
 
+IGraphicsResource::~IGraphicsResource() {
+	if (_gpuMemory > 0) {
+		MemoryTracker::ReleaseGpuAllocation(this);
+	}
+}
+
 void IGraphicsResource::SetDebugName(const std::string& name)
 {
 	_debugName = name;
@@ -12,6 +24,9 @@ void IGraphicsResource::SetDebugName(const std::string& name)
 	if (type != GlResourceType::Unknown && _rendererId != 0) {
 		glObjectLabel(*type, _rendererId, name.size(), name.c_str());
 	}
+	if (_gpuMemory > 0) {
+		MemoryTracker::SetGpuAllocationOwner(this, _debugName);
+	}
 }
 
 const std::string& IGraphicsResource::GetDebugName() const {
@@ -22,6 +37,20 @@ uint32_t IGraphicsResource::GetHandle() const {
 	return _rendererId;
 }
 
+size_t IGraphicsResource::GetGpuMemory() const {
+	return _gpuMemory;
+}
+
+void IGraphicsResource::_SetGpuMemory(size_t bytes) {
+	_gpuMemory = bytes;
+	if (bytes > 0) {
+		// Storage is allocated from the derived class, so typeid gives us the most derived type here
+		MemoryTracker::SetGpuAllocation(this, StringTools::SanitizeClassName(typeid(*this).name()), _debugName, bytes);
+	} else {
+		MemoryTracker::ReleaseGpuAllocation(this);
+	}
+}
+
 void IGraphicsResource::_SetRenderId(uint32_t renderId)
 {
 	_rendererId = renderId;
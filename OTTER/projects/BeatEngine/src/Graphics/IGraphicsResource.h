@@ -35,7 +35,7 @@ public:
 	// For pointers and deletion of move and copy
 	DEFINE_RESOURCE(IGraphicsResource)
 
-	virtual ~IGraphicsResource() = default;
+	virtual ~IGraphicsResource();
 
 	/**
 	 * Should be overridden in derived classes to return a resource type identifier
@@ -58,6 +58,11 @@ public:
 	 */
 	virtual uint32_t GetHandle() const;
 
+	/**
+	 * Returns the number of bytes of GPU memory this resource has reported using
+	 */
+	size_t GetGpuMemory() const;
+
 protected:
 	IGraphicsResource();
 	
@@ -67,6 +72,14 @@ protected:
 	 */
 	void _SetRenderId(uint32_t renderId);
 
+	/**
+	 * Reports how much GPU memory this resource's storage takes up to the memory tracker.
+	 * Should be called by derived classes whenever they (re)allocate storage
+	 * @param bytes The size of the storage, in bytes
+	 */
+	void _SetGpuMemory(size_t bytes);
+
 	std::string _debugName;
 	uint32_t    _rendererId;
+	size_t      _gpuMemory;
 };
\ No newline at end of file
@@ -0,0 +1,292 @@
+#include "Graphics/RenderGraph.h"
+#include <algorithm>
+#include "Logging.h"
+
+const RenderGraph::Target RenderGraph::InvalidTarget = ~0u;
+
+RenderGraph::PassContext::PassContext(const RenderGraph* graph) :
+	_graph(graph)
+{ }
+
+const Framebuffer::Sptr& RenderGraph::PassContext::Get(Target target) const {
+	static const Framebuffer::Sptr empty = nullptr;
+	if (target >= _graph->_targets.size()) {
+		LOG_WARN("Pass requested a target that isn't in the render graph");
+		return empty;
+	}
+
+	const TargetNode& node = _graph->_targets[target];
+	if (node.IsImported) {
+		return node.Buffer;
+	}
+	return node.Physical != ~0u ? _graph->_pool[node.Physical].Buffer : empty;
+}
+
+RenderGraph::PassBuilder::PassBuilder(RenderGraph* graph, uint32_t pass) :
+	_graph(graph),
+	_pass(pass)
+{ }
+
+RenderGraph::Target RenderGraph::PassBuilder::Read(Target target) {
+	LOG_ASSERT(target < _graph->_targets.size(), "Invalid render graph target");
+	PassNode& pass = _graph->_passes[_pass];
+	pass.Reads.push_back(target);
+	if (_graph->_targets[target].Producer != ~0u) {
+		pass.Dependencies.push_back(_graph->_targets[target].Producer);
+	}
+	return target;
+}
+
+RenderGraph::Target RenderGraph::PassBuilder::Write(Target target) {
+	LOG_ASSERT(target < _graph->_targets.size(), "Invalid render graph target");
+	PassNode& pass = _graph->_passes[_pass];
+	TargetNode& node = _graph->_targets[target];
+	pass.Writes.push_back(target);
+
+	// Passes usually add to what's already in a target (ex: blending lights), so whoever wrote it last still matters
+	if (node.Producer != ~0u && node.Producer != _pass) {
+		pass.Dependencies.push_back(node.Producer);
+	}
+	node.Producer = _pass;
+
+	// Anything outside of the graph could be looking at an imported target
+	if (node.IsImported) {
+		pass.HasSideEffects = true;
+	}
+	return target;
+}
+
+RenderGraph::Target RenderGraph::PassBuilder::Create(const std::string& name, const FramebufferDescriptor& description) {
+	TargetNode node = TargetNode();
+	node.Name        = name;
+	node.Description = description;
+	// Collapsed viewports and minimized windows can give us an empty size, framebuffers need at least a pixel
+	node.Description.Width  = std::max(node.Description.Width, 1u);
+	node.Description.Height = std::max(node.Description.Height, 1u);
+	_graph->_targets.push_back(node);
+	return Write((Target)(_graph->_targets.size() - 1));
+}
+
+void RenderGraph::PassBuilder::SetSideEffects() {
+	_graph->_passes[_pass].HasSideEffects = true;
+}
+
+void RenderGraph::PassBuilder::SetExecute(const ExecuteFunc& execute) {
+	_graph->_passes[_pass].Execute = execute;
+}
+
+RenderGraph::RenderGraph() :
+	_targets(),
+	_passes(),
+	_pool(),
+	_frameStats(),
+	_lastFrameStats()
+{ }
+
+RenderGraph::~RenderGraph() = default;
+
+RenderGraph::Target RenderGraph::Import(const std::string& name, const Framebuffer::Sptr& framebuffer) {
+	LOG_ASSERT(framebuffer != nullptr, "Cannot import a null framebuffer into the render graph");
+	TargetNode node = TargetNode();
+	node.Name       = name;
+	node.Buffer     = framebuffer;
+	node.IsImported = true;
+	_targets.push_back(node);
+	return (Target)(_targets.size() - 1);
+}
+
+RenderGraph::PassBuilder RenderGraph::AddPass(const std::string& name) {
+	PassNode pass = PassNode();
+	pass.Name = name;
+	_passes.push_back(pass);
+	return PassBuilder(this, (uint32_t)(_passes.size() - 1));
+}
+
+void RenderGraph::Execute() {
+	_Cull();
+	_ComputeLifetimes();
+
+	// Tracks which targets have been rendered into since they were last read, so we can count the transitions
+	std::vector<bool> isDirty(_targets.size(), false);
+
+	PassContext context(this);
+	for (uint32_t ix = 0; ix < _passes.size(); ix++) {
+		PassNode& pass = _passes[ix];
+		if (pass.IsCulled) {
+			continue;
+		}
+
+		// Bring in any targets that start their life here
+		for (Target target : pass.Writes) {
+			TargetNode& node = _targets[target];
+			if (!node.IsImported && node.FirstUse == ix && node.Physical == ~0u) {
+				node.Physical = _Acquire(node);
+				_frameStats.Targets++;
+				_frameStats.RequestedBytes += __GetSize(node.Description);
+			}
+		}
+
+		for (Target target : pass.Reads) {
+			if (isDirty[target]) {
+				_frameStats.Barriers++;
+				isDirty[target] = false;
+			}
+		}
+
+		if (pass.Execute) {
+			pass.Execute(context);
+		}
+
+		for (Target target : pass.Writes) {
+			isDirty[target] = true;
+		}
+
+		// Hand back any targets that aren't used past this point, so that later passes can alias them
+		auto release = [&](Target target) {
+			TargetNode& node = _targets[target];
+			if (!node.IsImported && node.LastUse == ix && node.Physical != ~0u) {
+				_pool[node.Physical].InUse = false;
+			}
+		};
+		for (Target target : pass.Reads) {
+			release(target);
+		}
+		for (Target target : pass.Writes) {
+			release(target);
+		}
+	}
+
+	_frameStats.Passes += (uint32_t)_passes.size();
+	for (const PassNode& pass : _passes) {
+		_frameStats.CulledPasses += pass.IsCulled ? 1 : 0;
+	}
+
+	// Anything that made it this far without being released was never used, so it's safe to hand back
+	for (PooledTarget& pooled : _pool) {
+		pooled.InUse = false;
+	}
+	_targets.clear();
+	_passes.clear();
+}
+
+void RenderGraph::BeginFrame() {
+	// Anything that wasn't touched last frame is released, so that targets for passes that have been turned off
+	// (ex: disabled post processing effects) don't hold on to memory
+	_frameStats.PhysicalTargets = 0;
+	_frameStats.AllocatedBytes  = 0;
+	for (auto it = _pool.begin(); it != _pool.end();) {
+		if (it->UsedThisFrame) {
+			_frameStats.PhysicalTargets++;
+			_frameStats.AllocatedBytes += it->Size;
+			it->UsedThisFrame = false;
+			it++;
+		} else {
+			it = _pool.erase(it);
+		}
+	}
+
+	_lastFrameStats = _frameStats;
+	_frameStats = RenderGraphStats();
+}
+
+void RenderGraph::ReleaseAll() {
+	_pool.clear();
+	_targets.clear();
+	_passes.clear();
+}
+
+void RenderGraph::_Cull() {
+	// Dependencies always point at earlier passes, so walking backwards from the passes that are needed will
+	// visit every pass after everything that depends on it
+	for (PassNode& pass : _passes) {
+		pass.IsCulled = !pass.HasSideEffects;
+	}
+	for (size_t ix = _passes.size(); ix > 0; ix--) {
+		PassNode& pass = _passes[ix - 1];
+		if (pass.IsCulled) {
+			continue;
+		}
+		for (uint32_t dependency : pass.Dependencies) {
+			_passes[dependency].IsCulled = false;
+		}
+	}
+}
+
+void RenderGraph::_ComputeLifetimes() {
+	for (uint32_t ix = 0; ix < _passes.size(); ix++) {
+		const PassNode& pass = _passes[ix];
+		if (pass.IsCulled) {
+			continue;
+		}
+		auto use = [&](Target target) {
+			TargetNode& node = _targets[target];
+			node.FirstUse = glm::min(node.FirstUse, ix);
+			node.LastUse  = glm::max(node.LastUse, ix);
+		};
+		for (Target target : pass.Reads) {
+			use(target);
+		}
+		for (Target target : pass.Writes) {
+			use(target);
+		}
+	}
+
+	// A target that's read before anything writes to it would be aliased while holding garbage
+	for (const TargetNode& node : _targets) {
+		if (!node.IsImported && node.FirstUse != ~0u && node.Producer == ~0u) {
+			LOG_WARN("Render graph target \"{}\" is read but never written", node.Name);
+		}
+	}
+}
+
+uint32_t RenderGraph::_Acquire(const TargetNode& target) {
+	for (uint32_t ix = 0; ix < _pool.size(); ix++) {
+		PooledTarget& pooled = _pool[ix];
+		if (!pooled.InUse && __Matches(pooled.Description, target.Description)) {
+			pooled.InUse = true;
+			pooled.UsedThisFrame = true;
+
+			// Whatever the last target left behind is garbage to us, let the driver skip preserving it
+			std::vector<GLenum> attachments;
+			for (const auto& [attachment, descriptor] : pooled.Description.RenderTargets) {
+				attachments.push_back(*attachment);
+			}
+			glInvalidateNamedFramebufferData(pooled.Buffer->GetHandle(), (GLsizei)attachments.size(), attachments.data());
+			return ix;
+		}
+	}
+
+	PooledTarget pooled = PooledTarget();
+	pooled.Description   = target.Description;
+	pooled.Buffer        = std::make_shared<Framebuffer>(target.Description);
+	pooled.Size          = __GetSize(target.Description);
+	pooled.InUse         = true;
+	pooled.UsedThisFrame = true;
+	pooled.Buffer->SetDebugName("RenderGraph_" + target.Name);
+	_pool.push_back(pooled);
+	return (uint32_t)(_pool.size() - 1);
+}
+
+bool RenderGraph::__Matches(const FramebufferDescriptor& a, const FramebufferDescriptor& b) {
+	if (a.Width != b.Width || a.Height != b.Height || a.RenderTargets.size() != b.RenderTargets.size()) {
+		return false;
+	}
+	for (const auto& [attachment, descriptor] : a.RenderTargets) {
+		auto it = b.RenderTargets.find(attachment);
+		if (it == b.RenderTargets.end() ||
+			it->second.Format != descriptor.Format ||
+			it->second.UseTexture != descriptor.UseTexture ||
+			it->second.IsShadow != descriptor.IsShadow) {
+			return false;
+		}
+	}
+	return true;
+}
+
+uint64_t RenderGraph::__GetSize(const FramebufferDescriptor& description) {
+	uint64_t result = 0;
+	for (const auto& [attachment, descriptor] : description.RenderTargets) {
+		result += GetImageSize(*descriptor.Format, description.Width, description.Height);
+	}
+	return result;
+}
@@ -0,0 +1,198 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Graphics/Framebuffer.h"
+#include "Utils/Macros.h"
+
+/// <summary>
+/// Stats for the passes and targets that went through a render graph over a single frame
+/// </summary>
+struct RenderGraphStats {
+	// The number of passes that were declared
+	uint32_t Passes          = 0;
+	// The number of passes that were dropped because nothing used their output
+	uint32_t CulledPasses    = 0;
+	// The number of transient targets that were used by passes that ran
+	uint32_t Targets         = 0;
+	// The number of framebuffers that actually backed those targets
+	uint32_t PhysicalTargets = 0;
+	// The number of times a pass read a target that an earlier pass rendered into
+	uint32_t Barriers        = 0;
+	// The GPU memory the transient targets would need if they each had their own framebuffer
+	uint64_t RequestedBytes  = 0;
+	// The GPU memory the framebuffers backing the transient targets take up
+	uint64_t AllocatedBytes  = 0;
+};
+
+/// <summary>
+/// Schedules a frame's render passes from the targets that they read and write, rather than from framebuffers
+/// that are created up front and kept for the life of the app.
+///
+/// Passes declare their inputs and outputs as they're added, and run in the order they were added when the
+/// graph is executed. Passes whose outputs are never read (and that don't write to anything outside of the
+/// graph) are dropped before they run. Targets created by passes are transient, they only exist from the first
+/// pass that uses them to the last one, and targets with the same layout whose lifetimes don't overlap share a
+/// single framebuffer. Targets that need to outlive the graph (ex: the G-Buffer) are imported instead.
+///
+/// The framebuffers are pooled and kept between frames, so a graph that has the same shape every frame doesn't
+/// allocate anything after the first. Anything that goes a full frame without being used is released.
+///
+/// OpenGL resolves render target -> texture hazards on it's own when we re-bind, so there's nothing for us to
+/// issue when a pass reads something an earlier one wrote. We still count those transitions as barriers, since
+/// they're what the driver has to flush for, and they'd be real barriers on a newer API
+/// </summary>
+class RenderGraph {
+public:
+	MAKE_PTRS(RenderGraph);
+	NO_COPY(RenderGraph);
+	NO_MOVE(RenderGraph);
+
+	/// <summary>
+	/// A handle to a target in the graph, only valid until the graph is next executed
+	/// </summary>
+	typedef uint32_t Target;
+	static const Target InvalidTarget;
+
+	/// <summary>
+	/// Gives passes access to the framebuffers backing their targets while they run
+	/// </summary>
+	class PassContext {
+	public:
+		/// <summary>
+		/// Gets the framebuffer backing the given target. Transient targets have undefined contents
+		/// before the first pass that writes to them
+		/// </summary>
+		const Framebuffer::Sptr& Get(Target target) const;
+
+	protected:
+		friend class RenderGraph;
+		PassContext(const RenderGraph* graph);
+
+		const RenderGraph* _graph;
+	};
+
+	typedef std::function<void(const PassContext&)> ExecuteFunc;
+
+	/// <summary>
+	/// Declares the targets a pass uses, returned when adding a pass to the graph
+	/// </summary>
+	class PassBuilder {
+	public:
+		/// <summary>
+		/// Declares that the pass reads from the given target
+		/// </summary>
+		Target Read(Target target);
+		/// <summary>
+		/// Declares that the pass renders into the given target
+		/// </summary>
+		Target Write(Target target);
+		/// <summary>
+		/// Creates a new transient target that the pass renders into. Empty sizes are clamped to a single pixel
+		/// </summary>
+		/// <param name="name">The name of the target, for debugging</param>
+		/// <param name="description">The layout of the framebuffer that will back the target</param>
+		Target Create(const std::string& name, const FramebufferDescriptor& description);
+		/// <summary>
+		/// Marks the pass as having an effect outside of the graph (ex: drawing to the screen), so that it's
+		/// never culled. Passes that write to imported targets are treated the same way
+		/// </summary>
+		void SetSideEffects();
+		/// <summary>
+		/// Sets the function that records the pass's GL commands, called when the graph is executed
+		/// </summary>
+		void SetExecute(const ExecuteFunc& execute);
+
+	protected:
+		friend class RenderGraph;
+		PassBuilder(RenderGraph* graph, uint32_t pass);
+
+		RenderGraph* _graph;
+		uint32_t     _pass;
+	};
+
+	RenderGraph();
+	~RenderGraph();
+
+	/// <summary>
+	/// Adds a target that is owned outside of the graph, and will be kept alive after the graph is executed
+	/// </summary>
+	/// <param name="name">The name of the target, for debugging</param>
+	/// <param name="framebuffer">The framebuffer that backs the target</param>
+	Target Import(const std::string& name, const Framebuffer::Sptr& framebuffer);
+	/// <summary>
+	/// Adds a pass to the end of the graph
+	/// </summary>
+	/// <param name="name">The name of the pass, for debugging</param>
+	PassBuilder AddPass(const std::string& name);
+
+	/// <summary>
+	/// Culls and schedules all the passes that were added since the last execute, then runs them. May be called
+	/// several times a frame, targets that are still pooled from an earlier execute will be re-used
+	/// </summary>
+	void Execute();
+
+	/// <summary>
+	/// Starts a new frame, releasing any framebuffers that went unused during the last one
+	/// </summary>
+	void BeginFrame();
+	/// <summary>
+	/// Releases all of the pooled framebuffers
+	/// </summary>
+	void ReleaseAll();
+
+	/// <summary>
+	/// Gets the stats for the last complete frame
+	/// </summary>
+	const RenderGraphStats& GetLastFrameStats() const { return _lastFrameStats; }
+
+protected:
+	struct TargetNode {
+		std::string           Name;
+		FramebufferDescriptor Description;
+		Framebuffer::Sptr     Buffer;
+		bool                  IsImported = false;
+		// The pass that wrote to the target most recently while declaring passes, used to find dependencies
+		uint32_t              Producer   = ~0u;
+		// The first and last passes that use the target, out of the passes that weren't culled
+		uint32_t              FirstUse   = ~0u;
+		uint32_t              LastUse    = 0;
+		// The pooled framebuffer backing the target, for transient targets
+		uint32_t              Physical   = ~0u;
+	};
+
+	struct PassNode {
+		std::string           Name;
+		std::vector<Target>   Reads;
+		std::vector<Target>   Writes;
+		// The passes that produced the contents that this pass reads or adds to
+		std::vector<uint32_t> Dependencies;
+		ExecuteFunc           Execute;
+		bool                  HasSideEffects = false;
+		bool                  IsCulled       = true;
+	};
+
+	struct PooledTarget {
+		FramebufferDescriptor Description;
+		Framebuffer::Sptr     Buffer;
+		uint64_t              Size          = 0;
+		bool                  InUse         = false;
+		bool                  UsedThisFrame = false;
+	};
+
+	std::vector<TargetNode>   _targets;
+	std::vector<PassNode>     _passes;
+	std::vector<PooledTarget> _pool;
+
+	RenderGraphStats _frameStats;
+	RenderGraphStats _lastFrameStats;
+
+	void _Cull();
+	void _ComputeLifetimes();
+	uint32_t _Acquire(const TargetNode& target);
+
+	static bool __Matches(const FramebufferDescriptor& a, const FramebufferDescriptor& b);
+	static uint64_t __GetSize(const FramebufferDescriptor& description);
+};
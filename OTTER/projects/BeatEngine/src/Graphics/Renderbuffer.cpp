@@ -1,5 +1,7 @@
 #include "Graphics/Renderbuffer.h"
 
+#include <algorithm>
+
 Renderbuffer::Renderbuffer(const RenderbufferDescription& description) :
 	IGraphicsResource(),
 	_description(description)
@@ -12,6 +14,7 @@ Renderbuffer::Renderbuffer(const RenderbufferDescription& description) :
 	else {
 		glNamedRenderbufferStorage(_rendererId, *_description.Format, _description.Width, _description.Height);
 	}
+	_SetGpuMemory(GetInternalFormatSize(*_description.Format) * _description.Width * _description.Height * std::max<uint8_t>(_description.MultisampleCount, 1));
 }
 
 Renderbuffer::~Renderbuffer() {
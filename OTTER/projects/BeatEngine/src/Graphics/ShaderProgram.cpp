@@ -1,11 +1,13 @@
 #include "ShaderProgram.h"
 #include "Logging.h"
+#include "Graphics/GpuProfiler.h"
 #include <fstream>
 #include <sstream>
 #include <filesystem>
 
 #include "Utils/FileHelpers.h"
 #include "Utils/JsonGlmHelpers.h"
+#include "Utils/ResourceManager/ResourceManager.h"
 
 ShaderProgram::ShaderProgram() :
 	IGraphicsResource(),
@@ -33,11 +35,16 @@ ShaderProgram::~ShaderProgram() {
 }
 
 bool ShaderProgram::LoadShaderPart(const char* source, ShaderPartType type) {
+	return LoadShaderPart(source, -1, type);
+}
+
+bool ShaderProgram::LoadShaderPart(const char* source, int length, ShaderPartType type) {
 	// Creates a new shader part (VS, FS, GS, etc...)
 	GLuint handle = glCreateShader((GLenum)type);
 
 	// Load the GLSL source and compile it
-	glShaderSource(handle, 1, &source, nullptr);
+	GLint sourceLength = length;
+	glShaderSource(handle, 1, &source, length < 0 ? nullptr : &sourceLength);
 	glCompileShader(handle);
 
 	// Get the compilation status for the shader part
@@ -77,7 +84,7 @@ bool ShaderProgram::LoadShaderPart(const char* source, ShaderPartType type) {
 
 	// Store info about where we got this data from
 	_fileSourceMap[type].IsFilePath = false;
-	_fileSourceMap[type].Source = source;
+	_fileSourceMap[type].Source = length < 0 ? std::string(source) : std::string(source, length);
 
 	return status != GL_FALSE;
 }
@@ -167,6 +174,7 @@ bool ShaderProgram::Link() {
 void ShaderProgram::Bind() {
 	// Simply calls glUseProgram with our shader handle
 	glUseProgram(_rendererId);
+	GpuProfiler::Counters().ShaderBinds++;
 }
 
 void ShaderProgram::Unbind() {
@@ -352,8 +360,19 @@ ShaderProgram::Sptr ShaderProgram::FromJson(const nlohmann::json& data) {
 		ShaderPartType type = ParseShaderPartType(key, ShaderPartType::Unknown);
 		// As long as the type is valid
 		if (type != ShaderPartType::Unknown) {
+			// If the manifest was loaded from an archive, the stage's source (with includes resolved) is packed under it's type
+			AssetView archived = ResourceManager::ReadArchived<ShaderProgram>(data, *type);
+			if (archived.IsValid() && blob.contains("path")) {
+				std::string path = blob["path"].get<std::string>();
+				if (!result->LoadShaderPart(reinterpret_cast<const char*>(archived.Data), static_cast<int>(archived.Size), type)) {
+					LOG_ERROR("Source File: {}", path);
+				}
+				result->_fileSourceMap[type].IsFilePath = true;
+				result->_fileSourceMap[type].Source = path;
+				glObjectLabel(GL_SHADER, result->_handles[type], -1, path.c_str());
+			}
 			// If it has a file, we load from file
-			if (blob.contains("path")) {
+			else if (blob.contains("path")) {
 				result->LoadShaderPartFromFile(blob["path"].get<std::string>().c_str(), type);
 			}
 			// Otherwise we see if there's a source and load that instead
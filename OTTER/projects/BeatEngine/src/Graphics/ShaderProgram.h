@@ -77,6 +77,15 @@ public:
 	/// <returns>True if the shader is loaded, false if there was an issue</returns>
 	bool LoadShaderPart(const char* source, ShaderPartType type);
 	/// <summary>
+	/// Loads a single shader stage into this shader object from source that isn't null terminated (ex: source
+	/// that's been read out of an archive)
+	/// </summary>
+	/// <param name="source">The source code of the shader to load</param>
+	/// <param name="length">The length of the source in characters, or -1 if it's null terminated</param>
+	/// <param name="type">The stage to load (GL_VERTEX_SHADER or GL_FRAGMENT_SHADER)</param>
+	/// <returns>True if the shader is loaded, false if there was an issue</returns>
+	bool LoadShaderPart(const char* source, int length, ShaderPartType type);
+	/// <summary>
 	/// Loads a single shader stage into this shader object (ex: Vertex Shader or Fragment Shader) from an external file (in res)
 	/// </summary>
 	/// <param name="path">The relative path to the file containing the source</param>
@@ -0,0 +1,305 @@
+#include "Graphics/Textures/DdsFile.h"
+#include <cstring>
+#include <fstream>
+#include "Utils/MappedFile.h"
+#include <Logging.h>
+
+// See https://docs.microsoft.com/en-us/windows/win32/direct3ddds/dx-graphics-dds-pguide for the layout of these
+#pragma pack(push, 1)
+struct DdsPixelFormat {
+	uint32_t Size;
+	uint32_t Flags;
+	uint32_t FourCC;
+	uint32_t RGBBitCount;
+	uint32_t RBitMask;
+	uint32_t GBitMask;
+	uint32_t BBitMask;
+	uint32_t ABitMask;
+};
+
+struct DdsHeader {
+	uint32_t       Size;
+	uint32_t       Flags;
+	uint32_t       Height;
+	uint32_t       Width;
+	uint32_t       PitchOrLinearSize;
+	uint32_t       Depth;
+	uint32_t       MipMapCount;
+	uint32_t       Reserved1[11];
+	DdsPixelFormat PixelFormat;
+	uint32_t       Caps;
+	uint32_t       Caps2;
+	uint32_t       Caps3;
+	uint32_t       Caps4;
+	uint32_t       Reserved2;
+};
+
+struct DdsHeaderDx10 {
+	uint32_t DxgiFormat;
+	uint32_t ResourceDimension;
+	uint32_t MiscFlag;
+	uint32_t ArraySize;
+	uint32_t MiscFlags2;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(DdsHeader) == 124, "DDS header must be 124 bytes");
+static_assert(sizeof(DdsHeaderDx10) == 20, "DDS DX10 header must be 20 bytes");
+
+constexpr uint32_t MakeFourCC(char a, char b, char c, char d) {
+	return (uint32_t)(uint8_t)a | ((uint32_t)(uint8_t)b << 8) | ((uint32_t)(uint8_t)c << 16) | ((uint32_t)(uint8_t)d << 24);
+}
+
+constexpr uint32_t DDS_MAGIC              = MakeFourCC('D', 'D', 'S', ' ');
+constexpr uint32_t DDSD_CAPS              = 0x1;
+constexpr uint32_t DDSD_HEIGHT            = 0x2;
+constexpr uint32_t DDSD_WIDTH             = 0x4;
+constexpr uint32_t DDSD_PIXELFORMAT       = 0x1000;
+constexpr uint32_t DDSD_MIPMAPCOUNT       = 0x20000;
+constexpr uint32_t DDSD_LINEARSIZE        = 0x80000;
+constexpr uint32_t DDPF_FOURCC            = 0x4;
+constexpr uint32_t DDPF_RGB               = 0x40;
+constexpr uint32_t DDSCAPS_COMPLEX        = 0x8;
+constexpr uint32_t DDSCAPS_TEXTURE        = 0x1000;
+constexpr uint32_t DDSCAPS_MIPMAP         = 0x400000;
+constexpr uint32_t DDSCAPS2_CUBEMAP       = 0x200;
+constexpr uint32_t DDSCAPS2_CUBEMAP_FACES = 0xFC00;
+constexpr uint32_t DDS_DIMENSION_TEXTURE2D = 3;
+constexpr uint32_t DDS_RESOURCE_MISC_TEXTURECUBE = 0x4;
+
+// The subset of DXGI_FORMAT that we can upload
+constexpr uint32_t DXGI_FORMAT_R8G8B8A8_UNORM      = 28;
+constexpr uint32_t DXGI_FORMAT_R8G8B8A8_UNORM_SRGB = 29;
+constexpr uint32_t DXGI_FORMAT_R8G8_UNORM          = 49;
+constexpr uint32_t DXGI_FORMAT_R8_UNORM            = 61;
+constexpr uint32_t DXGI_FORMAT_BC1_UNORM           = 71;
+constexpr uint32_t DXGI_FORMAT_BC1_UNORM_SRGB      = 72;
+constexpr uint32_t DXGI_FORMAT_BC3_UNORM           = 77;
+constexpr uint32_t DXGI_FORMAT_BC3_UNORM_SRGB      = 78;
+constexpr uint32_t DXGI_FORMAT_BC4_UNORM           = 80;
+constexpr uint32_t DXGI_FORMAT_BC5_UNORM           = 83;
+constexpr uint32_t DXGI_FORMAT_BC7_UNORM           = 98;
+constexpr uint32_t DXGI_FORMAT_BC7_UNORM_SRGB      = 99;
+
+static InternalFormat __FormatFromDxgi(uint32_t dxgi) {
+	switch (dxgi) {
+		case DXGI_FORMAT_R8G8B8A8_UNORM:      return InternalFormat::RGBA8;
+		case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB: return InternalFormat::SRGBA;
+		case DXGI_FORMAT_R8G8_UNORM:          return InternalFormat::RG8;
+		case DXGI_FORMAT_R8_UNORM:            return InternalFormat::R8;
+		case DXGI_FORMAT_BC1_UNORM:           return InternalFormat::BC1;
+		case DXGI_FORMAT_BC1_UNORM_SRGB:      return InternalFormat::BC1_SRGB;
+		case DXGI_FORMAT_BC3_UNORM:           return InternalFormat::BC3;
+		case DXGI_FORMAT_BC3_UNORM_SRGB:      return InternalFormat::BC3_SRGB;
+		case DXGI_FORMAT_BC4_UNORM:           return InternalFormat::BC4;
+		case DXGI_FORMAT_BC5_UNORM:           return InternalFormat::BC5;
+		case DXGI_FORMAT_BC7_UNORM:           return InternalFormat::BC7;
+		case DXGI_FORMAT_BC7_UNORM_SRGB:      return InternalFormat::BC7_SRGB;
+		default:                              return InternalFormat::Unknown;
+	}
+}
+
+static uint32_t __FormatToDxgi(InternalFormat format) {
+	switch (format) {
+		case InternalFormat::RGBA8:    return DXGI_FORMAT_R8G8B8A8_UNORM;
+		case InternalFormat::SRGBA:    return DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+		case InternalFormat::RG8:      return DXGI_FORMAT_R8G8_UNORM;
+		case InternalFormat::R8:       return DXGI_FORMAT_R8_UNORM;
+		case InternalFormat::BC1:      return DXGI_FORMAT_BC1_UNORM;
+		case InternalFormat::BC1_SRGB: return DXGI_FORMAT_BC1_UNORM_SRGB;
+		case InternalFormat::BC3:      return DXGI_FORMAT_BC3_UNORM;
+		case InternalFormat::BC3_SRGB: return DXGI_FORMAT_BC3_UNORM_SRGB;
+		case InternalFormat::BC4:      return DXGI_FORMAT_BC4_UNORM;
+		case InternalFormat::BC5:      return DXGI_FORMAT_BC5_UNORM;
+		case InternalFormat::BC7:      return DXGI_FORMAT_BC7_UNORM;
+		case InternalFormat::BC7_SRGB: return DXGI_FORMAT_BC7_UNORM_SRGB;
+		default:                       return 0;
+	}
+}
+
+// Handles files written without the DX10 header, which only covers the block compressed formats most tools write by default
+static InternalFormat __FormatFromLegacy(const DdsPixelFormat& format) {
+	if (format.Flags & DDPF_FOURCC) {
+		switch (format.FourCC) {
+			case MakeFourCC('D', 'X', 'T', '1'): return InternalFormat::BC1;
+			case MakeFourCC('D', 'X', 'T', '5'): return InternalFormat::BC3;
+			case MakeFourCC('A', 'T', 'I', '1'):
+			case MakeFourCC('B', 'C', '4', 'U'): return InternalFormat::BC4;
+			case MakeFourCC('A', 'T', 'I', '2'):
+			case MakeFourCC('B', 'C', '5', 'U'): return InternalFormat::BC5;
+			default:                             return InternalFormat::Unknown;
+		}
+	}
+	if ((format.Flags & DDPF_RGB) && format.RGBBitCount == 32 &&
+		format.RBitMask == 0x000000FF && format.GBitMask == 0x0000FF00 && format.BBitMask == 0x00FF0000) {
+		return InternalFormat::RGBA8;
+	}
+	return InternalFormat::Unknown;
+}
+
+uint32_t DdsImage::GetLevelWidth(uint32_t level) const {
+	return glm::max(Width >> level, 1u);
+}
+
+uint32_t DdsImage::GetLevelHeight(uint32_t level) const {
+	return glm::max(Height >> level, 1u);
+}
+
+size_t DdsImage::GetLevelSize(uint32_t level) const {
+	return GetImageSize(*Format, GetLevelWidth(level), GetLevelHeight(level));
+}
+
+size_t DdsImage::GetLayerSize() const {
+	return GetImageStorageSize(*Format, Width, Height, Levels);
+}
+
+const uint8_t* DdsImage::GetLevelData(uint32_t layer, uint32_t level) const {
+	size_t offset = GetLayerSize() * layer;
+	for (uint32_t ix = 0; ix < level; ix++) {
+		offset += GetLevelSize(ix);
+	}
+	return (ExternalData != nullptr ? ExternalData : Data.data()) + offset;
+}
+
+uint8_t* DdsImage::GetLevelData(uint32_t layer, uint32_t level) {
+	return const_cast<uint8_t*>(static_cast<const DdsImage*>(this)->GetLevelData(layer, level));
+}
+
+void DdsImage::Allocate() {
+	Data.resize(GetLayerSize() * Layers);
+}
+
+PixelFormat DdsImage::GetUploadFormat() const {
+	switch (Format) {
+		case InternalFormat::R8:    return PixelFormat::Red;
+		case InternalFormat::RG8:   return PixelFormat::RG;
+		case InternalFormat::RGBA8:
+		case InternalFormat::SRGBA: return PixelFormat::RGBA;
+		default:                    return PixelFormat::Unknown;
+	}
+}
+
+bool DdsImage::Save(const std::string& path) const {
+	uint32_t dxgi = __FormatToDxgi(Format);
+	if (dxgi == 0) {
+		LOG_WARN("Cannot write a DDS file with format {}", ~Format);
+		return false;
+	}
+	LOG_ASSERT(Data.size() == GetLayerSize() * Layers, "DDS image data does not match it's size");
+
+	DdsHeader header = DdsHeader();
+	header.Size        = sizeof(DdsHeader);
+	header.Flags       = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE;
+	header.Height      = Height;
+	header.Width       = Width;
+	header.PitchOrLinearSize = (uint32_t)GetLevelSize(0);
+	header.Depth       = 1;
+	header.MipMapCount = Levels;
+	header.PixelFormat.Size   = sizeof(DdsPixelFormat);
+	header.PixelFormat.Flags  = DDPF_FOURCC;
+	header.PixelFormat.FourCC = MakeFourCC('D', 'X', '1', '0');
+	header.Caps  = DDSCAPS_TEXTURE | (Levels > 1 ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0) | (Layers > 1 ? DDSCAPS_COMPLEX : 0);
+	header.Caps2 = IsCubemap ? DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_FACES : 0;
+
+	DdsHeaderDx10 dx10 = DdsHeaderDx10();
+	dx10.DxgiFormat        = dxgi;
+	dx10.ResourceDimension = DDS_DIMENSION_TEXTURE2D;
+	dx10.MiscFlag          = IsCubemap ? DDS_RESOURCE_MISC_TEXTURECUBE : 0;
+	// Cubemaps count whole cubes rather than faces
+	dx10.ArraySize         = IsCubemap ? Layers / 6 : Layers;
+
+	std::ofstream file(path, std::ios::binary);
+	if (!file) {
+		LOG_WARN("Failed to open \"{}\" for writing", path);
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(&DDS_MAGIC), sizeof(uint32_t));
+	file.write(reinterpret_cast<const char*>(&header), sizeof(DdsHeader));
+	file.write(reinterpret_cast<const char*>(&dx10), sizeof(DdsHeaderDx10));
+	file.write(reinterpret_cast<const char*>(Data.data()), Data.size());
+	return file.good();
+}
+
+bool DdsImage::Load(const std::string& path, DdsImage& result) {
+	MappedFile file;
+	if (!file.Open(path)) {
+		return false;
+	}
+
+	// The mapping goes away when we return, so we need our own copy of the data
+	DdsImage image = DdsImage();
+	if (!LoadFromMemory(file.GetData(), file.GetSize(), image, path)) {
+		return false;
+	}
+	image.Data.assign(image.ExternalData, image.ExternalData + image.GetLayerSize() * image.Layers);
+	image.ExternalData = nullptr;
+
+	result = std::move(image);
+	return true;
+}
+
+bool DdsImage::LoadFromMemory(const uint8_t* data, size_t size, DdsImage& result, const std::string& name) {
+	const uint8_t* seek = data;
+	const uint8_t* end = data + size;
+
+	uint32_t magic = 0;
+	DdsHeader header = DdsHeader();
+	if (size < sizeof(uint32_t) + sizeof(DdsHeader)) {
+		LOG_WARN("\"{}\" is not a DDS file", name);
+		return false;
+	}
+	memcpy(&magic, seek, sizeof(uint32_t));
+	seek += sizeof(uint32_t);
+	memcpy(&header, seek, sizeof(DdsHeader));
+	seek += sizeof(DdsHeader);
+	if (magic != DDS_MAGIC || header.Size != sizeof(DdsHeader)) {
+		LOG_WARN("\"{}\" is not a DDS file", name);
+		return false;
+	}
+
+	DdsImage image = DdsImage();
+	image.Width  = header.Width;
+	image.Height = header.Height;
+	image.Levels = (header.Flags & DDSD_MIPMAPCOUNT) ? glm::max(header.MipMapCount, 1u) : 1;
+
+	if ((header.PixelFormat.Flags & DDPF_FOURCC) && header.PixelFormat.FourCC == MakeFourCC('D', 'X', '1', '0')) {
+		DdsHeaderDx10 dx10 = DdsHeaderDx10();
+		if ((size_t)(end - seek) < sizeof(DdsHeaderDx10)) {
+			LOG_WARN("\"{}\" is missing it's DX10 header", name);
+			return false;
+		}
+		memcpy(&dx10, seek, sizeof(DdsHeaderDx10));
+		seek += sizeof(DdsHeaderDx10);
+		if (dx10.ResourceDimension != DDS_DIMENSION_TEXTURE2D) {
+			LOG_WARN("\"{}\" is not a 2D texture, only 2D textures, arrays and cubemaps are supported", name);
+			return false;
+		}
+		image.Format    = __FormatFromDxgi(dx10.DxgiFormat);
+		image.IsCubemap = (dx10.MiscFlag & DDS_RESOURCE_MISC_TEXTURECUBE) != 0;
+		image.Layers    = glm::max(dx10.ArraySize, 1u) * (image.IsCubemap ? 6 : 1);
+	} else {
+		image.Format    = __FormatFromLegacy(header.PixelFormat);
+		image.IsCubemap = (header.Caps2 & DDSCAPS2_CUBEMAP) != 0;
+		image.Layers    = image.IsCubemap ? 6 : 1;
+	}
+
+	if (image.Format == InternalFormat::Unknown) {
+		LOG_WARN("\"{}\" is in a DDS format that we can't load", name);
+		return false;
+	}
+	if (image.Width == 0 || image.Height == 0 || image.Levels > 32) {
+		LOG_WARN("\"{}\" has an invalid size", name);
+		return false;
+	}
+
+	// Make sure the file actually contains all the data that the header says it does before we use it
+	size_t dataSize = image.GetLayerSize() * image.Layers;
+	if ((size_t)(end - seek) < dataSize) {
+		LOG_WARN("\"{}\" is truncated, expected {} bytes of image data", name, dataSize);
+		return false;
+	}
+	image.ExternalData = seek;
+
+	result = std::move(image);
+	return true;
+}
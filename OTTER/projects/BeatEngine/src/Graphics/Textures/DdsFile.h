@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Graphics/GlEnums.h"
+
+/// <summary>
+/// A texture with all of it's layers and mip levels, as stored in a DDS file. This is what the texture
+/// cooker writes out, and lets our textures upload a pre-built mip chain without touching the source image.
+///
+/// Images are stored the way OpenGL expects them, with the bottom row first. This matches what the
+/// cooker writes, but means that DDS files from other tools will appear upside down unless they were
+/// exported for OpenGL
+/// </summary>
+struct DdsImage {
+	/// <summary>
+	/// The format of the image data, either a block compressed format or an uncompressed 8 bit format
+	/// </summary>
+	InternalFormat       Format    = InternalFormat::Unknown;
+	/// <summary>
+	/// The size of the top mip level, in texels
+	/// </summary>
+	uint32_t             Width     = 0;
+	uint32_t             Height    = 0;
+	/// <summary>
+	/// The number of array layers, or 6 for a cubemap
+	/// </summary>
+	uint32_t             Layers    = 1;
+	/// <summary>
+	/// The number of mip levels stored for each layer
+	/// </summary>
+	uint32_t             Levels    = 1;
+	/// <summary>
+	/// True if the layers are the faces of a cubemap, in the order +X, -X, +Y, -Y, +Z, -Z
+	/// </summary>
+	bool                 IsCubemap = false;
+	/// <summary>
+	/// The image data, with each layer's mip chain stored back to back
+	/// </summary>
+	std::vector<uint8_t> Data;
+	/// <summary>
+	/// If set, the image data lives outside of the image (ex: in a mapped archive) and Data is left empty.
+	/// The memory it points to must outlive the image
+	/// </summary>
+	const uint8_t*       ExternalData = nullptr;
+
+	/// <summary>
+	/// Gets the width of the given mip level, in texels
+	/// </summary>
+	uint32_t GetLevelWidth(uint32_t level) const;
+	/// <summary>
+	/// Gets the height of the given mip level, in texels
+	/// </summary>
+	uint32_t GetLevelHeight(uint32_t level) const;
+	/// <summary>
+	/// Gets the number of bytes that a single layer of the given mip level takes up
+	/// </summary>
+	size_t GetLevelSize(uint32_t level) const;
+	/// <summary>
+	/// Gets the number of bytes that a single layer's mip chain takes up
+	/// </summary>
+	size_t GetLayerSize() const;
+	/// <summary>
+	/// Gets a pointer to the start of a single layer of the given mip level
+	/// </summary>
+	const uint8_t* GetLevelData(uint32_t layer, uint32_t level) const;
+	uint8_t* GetLevelData(uint32_t layer, uint32_t level);
+
+	/// <summary>
+	/// Resizes the data store to fit the current size, format, layers and levels
+	/// </summary>
+	void Allocate();
+
+	/// <summary>
+	/// Gets the pixel format to use when uploading an uncompressed image, or Unknown for compressed formats
+	/// </summary>
+	PixelFormat GetUploadFormat() const;
+
+	/// <summary>
+	/// Writes this image out to a DDS file, using the DX10 header extension
+	/// </summary>
+	/// <param name="path">The path to write to</param>
+	/// <returns>True if the file was written</returns>
+	bool Save(const std::string& path) const;
+
+	/// <summary>
+	/// Loads an image from a DDS file. Both the DX10 header and the legacy DXT1, DXT5, ATI1 and ATI2 codes are supported
+	/// </summary>
+	/// <param name="path">The path to load from</param>
+	/// <param name="result">The image to load into</param>
+	/// <returns>True if the image was loaded, false if the file is missing, malformed, or in a format we can't upload</returns>
+	static bool Load(const std::string& path, DdsImage& result);
+	/// <summary>
+	/// Loads an image from a DDS file that's already in memory, without copying it's data. The image's
+	/// ExternalData will point into the given memory, so it must outlive the image
+	/// </summary>
+	/// <param name="data">The contents of the DDS file</param>
+	/// <param name="size">The size of the DDS file, in bytes</param>
+	/// <param name="result">The image to load into</param>
+	/// <param name="name">The name to use for the image when logging errors</param>
+	/// <returns>True if the image was loaded</returns>
+	static bool LoadFromMemory(const uint8_t* data, size_t size, DdsImage& result, const std::string& name);
+};
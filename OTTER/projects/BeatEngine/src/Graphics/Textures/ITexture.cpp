@@ -1,4 +1,5 @@
 #include "ITexture.h"
+#include "Graphics/GpuProfiler.h"
 
 ITexture::Limits ITexture::__limits = ITexture::Limits();
 bool ITexture::__isStaticInit = false;
@@ -30,6 +31,7 @@ void ITexture::Bind(int slot) {
 	if (_rendererId != 0) {
 		// Instead of glActiveTexture + glBindTexture, we can one line it now :D
 		glBindTextureUnit(slot, _rendererId); 
+		GpuProfiler::Counters().TextureBinds++;
 	}
 }
 
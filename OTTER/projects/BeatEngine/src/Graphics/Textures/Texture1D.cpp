@@ -178,6 +178,7 @@ void Texture1D::_SetTextureParams()
 	int layers = _description.GenerateMipMaps ? CalcRequiredMipLevels(_description.Size) : 1;
 	// Allocates the memory for our texture
 	glTextureStorage1D(_rendererId, layers, (GLenum)_description.Format, _description.Size);
+	_SetGpuMemory(GetTextureStorageSize(GetInternalFormatSize(*_description.Format), _description.Size, 1, 1, layers));
 
 	glTextureParameteri(_rendererId, GL_TEXTURE_MIN_FILTER, (GLenum)_description.MinificationFilter);
 	glTextureParameteri(_rendererId, GL_TEXTURE_MAG_FILTER, (GLenum)_description.MagnificationFilter);
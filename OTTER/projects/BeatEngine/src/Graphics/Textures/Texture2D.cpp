@@ -4,6 +4,8 @@
 #include "GLM/glm.hpp"
 #include "Utils/JsonGlmHelpers.h"
 #include "Utils/Base64.h"
+#include "Graphics/Textures/TextureCooker.h"
+#include "Utils/ResourceManager/ResourceManager.h"
 
 /// <summary>
 /// Get the number of mipmap levels required for a texture of the given size
@@ -56,6 +58,23 @@ Texture2D::Sptr Texture2D::FromJson(const nlohmann::json& data)
 	descr.MaxAnisotropic = JsonGet(data, "anisotropic", 0.0f);
 	descr.GenerateMipMaps = JsonGet(data, "generate_mipmaps", false);
 
+	// If the manifest was loaded from an archive, the cooked image is uploaded straight out of the mapping
+	AssetView archived = ResourceManager::ReadArchived<Texture2D>(data);
+	if (archived.IsValid()) {
+		std::string filename = descr.Filename;
+		descr.Filename = "";
+		Texture2D::Sptr result = std::make_shared<Texture2D>(descr);
+		result->_description.Filename = filename;
+
+		DdsImage image;
+		if (DdsImage::LoadFromMemory(archived.Data, archived.Size, image, filename) && result->_LoadCooked(image)) {
+			result->SetDebugName(filename);
+			return result;
+		}
+		LOG_WARN("Failed to load \"{}\" from archive, falling back to the loose file", filename);
+		descr.Filename = filename;
+	}
+
 	Texture2D::Sptr result = std::make_shared<Texture2D>(descr);
 
 	// If we embedded data into the JSON, load it now
@@ -76,7 +95,8 @@ Texture2D::Sptr Texture2D::FromJson(const nlohmann::json& data)
 Texture2D::Texture2D(const Texture2DDescription& description) :
 	ITexture(TextureType::_2D),
 	_description(description),
-	_pixelType(PixelType::Unknown)
+	_pixelType(PixelType::Unknown),
+	_cookedLevels(0)
 {
 	_SetTextureParams();
 	if (!description.Filename.empty()) {
@@ -87,7 +107,8 @@ Texture2D::Texture2D(const Texture2DDescription& description) :
 Texture2D::Texture2D(const std::string& filePath) :
 	ITexture(TextureType::_2D),
 	_description(Texture2DDescription()),
-	_pixelType(PixelType::Unknown)
+	_pixelType(PixelType::Unknown),
+	_cookedLevels(0)
 {
 	_description.Filename = filePath;
 	_SetTextureParams();
@@ -118,10 +139,6 @@ void Texture2D::SetAnisoLevel(float value) {
 	if (value != _description.MaxAnisotropic) {
 		_description.MaxAnisotropic = glm::clamp(value, 1.0f, ITexture::GetLimits().MAX_ANISOTROPY);
 		glTextureParameterf(_rendererId, GL_TEXTURE_MAX_ANISOTROPY, _description.MaxAnisotropic);
-
-		if (_description.GenerateMipMaps) {
-			glGenerateTextureMipmap(_rendererId);
-		}
 	}
 }
 
@@ -130,6 +147,12 @@ void Texture2D::LoadData(uint32_t width, uint32_t height, PixelFormat format, Pi
 	LOG_ASSERT((width + offsetX) <= _description.Width, "Pixel bounds are outside of the X extents of the image!");
 	LOG_ASSERT((height + offsetY) <= _description.Height, "Pixel bounds are outside of the Y extents of the image!");
 
+	// Compressed textures can only be filled with pre-compressed blocks, which come from cooked files
+	if (IsCompressedFormat(*_description.Format)) {
+		LOG_WARN("Cannot load uncompressed data into a compressed texture, ignoring");
+		return;
+	}
+
 	_description.FormatHint = format;
 	_pixelType = type;
 
@@ -151,6 +174,18 @@ void Texture2D::_LoadDataFromFile() {
 	LOG_ASSERT(_description.Width + _description.Height == 0, "This texture has already been configured with a size! Cannot re-allocate memory!");
 
 	if (!_description.Filename.empty()) {
+		// If there's an up to date cooked version of the image, we can use that instead and skip decoding
+		// the image and building the mip chain. Files that are already DDS files are loaded as-is
+		DdsImage cooked;
+		if (TextureCooker::LoadCooked({ _description.Filename }, TextureCooker::GetCookedPath(_description.Filename), cooked) && _LoadCooked(cooked)) {
+			SetDebugName(_description.Filename);
+			return;
+		}
+		if (TextureCooker::IsDdsFile(_description.Filename)) {
+			LOG_WARN("Failed to load DDS image from \"{}\"", _description.Filename);
+			return;
+		}
+
 		// Variables that will store properties about our image
 		int width, height, numChannels;
 		const int targetChannels = GetTexelComponentCount(_description.FormatHint);
@@ -200,6 +235,41 @@ void Texture2D::_LoadDataFromFile() {
 	SetDebugName(_description.Filename);
 }
 
+bool Texture2D::_LoadCooked(const DdsImage& image) {
+	if (image.Layers != 1 || image.IsCubemap) {
+		LOG_WARN("Cooked image for \"{}\" is not a 2D texture, falling back to the source image", _description.Filename);
+		return false;
+	}
+
+	// Only upload the top level if the description doesn't want mipmaps
+	uint32_t levels = _description.GenerateMipMaps ? image.Levels : 1;
+
+	_description.Format = image.Format;
+	_description.Width = image.Width;
+	_description.Height = image.Height;
+	_cookedLevels = levels;
+
+	// Allocates our memory
+	_SetTextureParams();
+
+	PixelFormat uploadFormat = image.GetUploadFormat();
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (uint32_t level = 0; level < levels; level++) {
+		if (uploadFormat == PixelFormat::Unknown) {
+			glCompressedTextureSubImage2D(_rendererId, level, 0, 0, image.GetLevelWidth(level), image.GetLevelHeight(level),
+				*image.Format, (GLsizei)image.GetLevelSize(level), image.GetLevelData(0, level));
+		} else {
+			glTextureSubImage2D(_rendererId, level, 0, 0, image.GetLevelWidth(level), image.GetLevelHeight(level),
+				*uploadFormat, GL_UNSIGNED_BYTE, image.GetLevelData(0, level));
+		}
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	_description.FormatHint = uploadFormat == PixelFormat::Unknown ? PixelFormat::RGBA : uploadFormat;
+	_pixelType = PixelType::UByte;
+	return true;
+}
+
 void Texture2D::_SetTextureParams() {
 	// If we have a multisampled texture, and the current type is 2D, change it to 2D multisampled
 	if (_description.MultisampleCount > 1 && _type == TextureType::_2D) {
@@ -217,10 +287,15 @@ void Texture2D::_SetTextureParams() {
 	if ((_description.Width * _description.Height > 0) && _description.Format != InternalFormat::Unknown) {
 		// If the texture is NOT multisampled, we proceed as normal
 		if (_description.MultisampleCount == 1) {
-			// Calculate how many layers of storage to allocate based on whether mipmaps are enabled or not
+			// Calculate how many layers of storage to allocate based on whether mipmaps are enabled or not, cooked
+			// images may stop their mip chain early
 			int layers = _description.GenerateMipMaps ? CalcRequiredMipLevels(_description.Width, _description.Height) : 1;
+			if (_cookedLevels > 0) {
+				layers = _cookedLevels;
+			}
 			// Allocates the memory for our texture
 			glTextureStorage2D(_rendererId, layers, (GLenum)_description.Format, _description.Width, _description.Height);
+			_SetGpuMemory(GetImageStorageSize(*_description.Format, _description.Width, _description.Height, layers));
 
 			glTextureParameteri(_rendererId, GL_TEXTURE_MIN_FILTER, (GLenum)_description.MinificationFilter);
 			glTextureParameteri(_rendererId, GL_TEXTURE_MAG_FILTER, (GLenum)_description.MagnificationFilter);
@@ -229,6 +304,7 @@ void Texture2D::_SetTextureParams() {
 		// Texture is multisampled, we need to allocate memory differently
 		else {
 			glTextureStorage2DMultisample(_rendererId, _description.MultisampleCount, *_description.Format, _description.Width, _description.Height, true);
+			_SetGpuMemory(GetTextureStorageSize(GetInternalFormatSize(*_description.Format), _description.Width, _description.Height, 1, 1) * _description.MultisampleCount);
 		}
 
 		glTextureParameteri(_rendererId, GL_TEXTURE_WRAP_S, (GLenum)_description.HorizontalWrap);
@@ -1,5 +1,6 @@
 #pragma once
 #include "ITexture.h"
+#include "Graphics/Textures/DdsFile.h"
 
 /// <summary>
 /// Describes all parameters we can manipulate with our 2D Textures
@@ -150,6 +151,8 @@ public:
 protected:
 	Texture2DDescription _description;
 	PixelType _pixelType;
+	// The number of mip levels in the cooked image we loaded, or 0 if we loaded the source image
+	uint32_t _cookedLevels;
 
 	/// <summary>
 	/// Loads this texture from the file specified in the description
@@ -157,6 +160,12 @@ protected:
 	/// </summary>
 	void _LoadDataFromFile();
 	/// <summary>
+	/// Loads this texture from a cooked DDS file, with it's mip chain already built
+	/// Will overwrite description size and format
+	/// </summary>
+	/// <returns>True if the image could be used, false if it's not a 2D texture</returns>
+	bool _LoadCooked(const DdsImage& image);
+	/// <summary>
 	/// Allocates our texture's memory and sets sampling / filtering parameters
 	/// </summary>
 	void _SetTextureParams();
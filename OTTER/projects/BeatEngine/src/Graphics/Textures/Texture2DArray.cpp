@@ -4,6 +4,8 @@
 #include "GLM/glm.hpp"
 #include "Utils/JsonGlmHelpers.h"
 #include "Utils/Base64.h"
+#include "Graphics/Textures/TextureCooker.h"
+#include "Utils/ResourceManager/ResourceManager.h"
 
 /// <summary>
 /// Get the number of mipmap levels required for a texture of the given size
@@ -61,6 +63,23 @@ Texture2DArray::Sptr Texture2DArray::FromJson(const nlohmann::json& data)
 	descr.XDivisions = JsonGet(data, "x_split", descr.XDivisions);
 	descr.YDivisions = JsonGet(data, "y_split", descr.YDivisions);
 
+	// If the manifest was loaded from an archive, the cooked image is uploaded straight out of the mapping
+	AssetView archived = ResourceManager::ReadArchived<Texture2DArray>(data);
+	if (archived.IsValid()) {
+		std::string filename = descr.Filename;
+		descr.Filename = "";
+		Texture2DArray::Sptr result = std::make_shared<Texture2DArray>(descr);
+		result->_description.Filename = filename;
+
+		DdsImage image;
+		if (DdsImage::LoadFromMemory(archived.Data, archived.Size, image, filename) && result->_LoadCooked(image)) {
+			result->SetDebugName(filename);
+			return result;
+		}
+		LOG_WARN("Failed to load \"{}\" from archive, falling back to the loose file", filename);
+		descr.Filename = filename;
+	}
+
 	Texture2DArray::Sptr result = std::make_shared<Texture2DArray>(descr);
 
 	// If we embedded data into the JSON, load it now
@@ -82,7 +101,8 @@ Texture2DArray::Sptr Texture2DArray::FromJson(const nlohmann::json& data)
 Texture2DArray::Texture2DArray(const Texture2DArrayDescription& description) :
 	ITexture(TextureType::_2DArray),
 	_description(description),
-	_pixelType(PixelType::Unknown)
+	_pixelType(PixelType::Unknown),
+	_cookedLevels(0)
 {
 	_SetTextureParams();
 	if (!description.Filename.empty()) {
@@ -93,7 +113,8 @@ Texture2DArray::Texture2DArray(const Texture2DArrayDescription& description) :
 Texture2DArray::Texture2DArray(const std::string& filePath, uint32_t splitX, uint32_t splitY) :
 	ITexture(TextureType::_2DArray),
 	_description(Texture2DArrayDescription()),
-	_pixelType(PixelType::Unknown)
+	_pixelType(PixelType::Unknown),
+	_cookedLevels(0)
 {
 	_description.Filename = filePath;
 	_description.XDivisions = splitX;
@@ -120,10 +141,6 @@ void Texture2DArray::SetAnisoLevel(float value) {
 	if (value != _description.MaxAnisotropic) {
 		_description.MaxAnisotropic = glm::clamp(value, 1.0f, ITexture::GetLimits().MAX_ANISOTROPY);
 		glTextureParameterf(_rendererId, GL_TEXTURE_MAX_ANISOTROPY, _description.MaxAnisotropic);
-
-		if (_description.GenerateMipMaps) {
-			glGenerateTextureMipmap(_rendererId);
-		}
 	}
 }
 
@@ -132,6 +149,12 @@ void Texture2DArray::LoadData(uint32_t width, uint32_t height, uint32_t layers,
 	LOG_ASSERT((width + offsetX) <= _description.Width, "Pixel bounds are outside of the X extents of the image!");
 	LOG_ASSERT((height + offsetY) <= _description.Height, "Pixel bounds are outside of the Y extents of the image!");
 
+	// Compressed textures can only be filled with pre-compressed blocks, which come from cooked files
+	if (IsCompressedFormat(*_description.Format)) {
+		LOG_WARN("Cannot load uncompressed data into a compressed texture, ignoring");
+		return;
+	}
+
 	_description.FormatHint = format;
 	_pixelType = type;
 
@@ -153,6 +176,19 @@ void Texture2DArray::_LoadDataFromFile() {
 	LOG_ASSERT(_description.Width + _description.Height == 0, "This texture has already been configured with a size! Cannot re-allocate memory!");
 
 	if (!_description.Filename.empty()) {
+		// If there's an up to date cooked version of the image, we can use that instead and skip decoding
+		// the image and building the mip chain. Files that are already DDS files are loaded as-is
+		DdsImage cooked;
+		std::string cookedPath = TextureCooker::GetCookedArrayPath(_description.Filename, _description.XDivisions, _description.YDivisions);
+		if (TextureCooker::LoadCooked({ _description.Filename }, cookedPath, cooked) && _LoadCooked(cooked)) {
+			SetDebugName(_description.Filename);
+			return;
+		}
+		if (TextureCooker::IsDdsFile(_description.Filename)) {
+			LOG_WARN("Failed to load DDS image from \"{}\"", _description.Filename);
+			return;
+		}
+
 		// Variables that will store properties about our image
 		int width, height, numChannels;
 		const int targetChannels = GetTexelComponentCount(_description.FormatHint);
@@ -226,7 +262,7 @@ void Texture2DArray::_LoadDataFromFile() {
 			for (uint64_t iy = 0; iy < ySize; iy++) {
 				for (uint64_t ix = 0; ix < xSize; ix++) {
 					xLoc = (iz % _description.XDivisions) * xSize + ix;
-					yLoc = (iz / _description.YDivisions) * ySize + iy;
+					yLoc = (iz / _description.XDivisions) * ySize + iy;
 					memcpy(
 						repack + (iz * size + iy * xSize + ix) * texelSize,
 						data + (yLoc * width + xLoc) * texelSize,
@@ -250,6 +286,44 @@ void Texture2DArray::_LoadDataFromFile() {
 	SetDebugName(_description.Filename);
 }
 
+bool Texture2DArray::_LoadCooked(const DdsImage& image) {
+	if (image.IsCubemap || image.Layers != _description.XDivisions * _description.YDivisions) {
+		LOG_WARN("Cooked image for \"{}\" does not have {} layers, falling back to the source image", _description.Filename, _description.XDivisions * _description.YDivisions);
+		return false;
+	}
+
+	// Only upload the top level if the description doesn't want mipmaps
+	uint32_t levels = _description.GenerateMipMaps ? image.Levels : 1;
+
+	// Our description stores the size of the image before it was split
+	_description.Format = image.Format;
+	_description.Width = image.Width * _description.XDivisions;
+	_description.Height = image.Height * _description.YDivisions;
+	_cookedLevels = levels;
+
+	// Allocates our memory
+	_SetTextureParams();
+
+	PixelFormat uploadFormat = image.GetUploadFormat();
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (uint32_t layer = 0; layer < image.Layers; layer++) {
+		for (uint32_t level = 0; level < levels; level++) {
+			if (uploadFormat == PixelFormat::Unknown) {
+				glCompressedTextureSubImage3D(_rendererId, level, 0, 0, layer, image.GetLevelWidth(level), image.GetLevelHeight(level), 1,
+					*image.Format, (GLsizei)image.GetLevelSize(level), image.GetLevelData(layer, level));
+			} else {
+				glTextureSubImage3D(_rendererId, level, 0, 0, layer, image.GetLevelWidth(level), image.GetLevelHeight(level), 1,
+					*uploadFormat, GL_UNSIGNED_BYTE, image.GetLevelData(layer, level));
+			}
+		}
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	_description.FormatHint = uploadFormat == PixelFormat::Unknown ? PixelFormat::RGBA : uploadFormat;
+	_pixelType = PixelType::UByte;
+	return true;
+}
+
 void Texture2DArray::_SetTextureParams() {
 	// If the anisotropy is negative, we assume that we want max anisotropy
 	if (_description.MaxAnisotropic < 0.0f) {
@@ -262,10 +336,16 @@ void Texture2DArray::_SetTextureParams() {
 		size_t sliceWidth = _description.Width / _description.XDivisions;
 		size_t sliceHeight = _description.Height / _description.YDivisions;
 
-		// Calculate how many layers of storage to allocate based on whether mipmaps are enabled or not
+		// Calculate how many layers of storage to allocate based on whether mipmaps are enabled or not, cooked
+		// images may stop their mip chain early
 		int layers = _description.GenerateMipMaps ? CalcRequiredMipLevels(sliceWidth, sliceHeight) : 1;
+		if (_cookedLevels > 0) {
+			layers = _cookedLevels;
+		}
 		// Allocates the memory for our texture
 		glTextureStorage3D(_rendererId, layers, (GLenum)_description.Format, sliceWidth, sliceHeight, _description.XDivisions * _description.YDivisions);
+		// Array layers don't shrink with the mip levels, so we scale the size of a single slice instead
+		_SetGpuMemory(GetImageStorageSize(*_description.Format, sliceWidth, sliceHeight, layers) * _description.XDivisions * _description.YDivisions);
 
 		glTextureParameteri(_rendererId, GL_TEXTURE_MIN_FILTER, (GLenum)_description.MinificationFilter);
 		glTextureParameteri(_rendererId, GL_TEXTURE_MAG_FILTER, (GLenum)_description.MagnificationFilter);
@@ -2,11 +2,15 @@
 #include "Utils/Base64.h"
 #include "Utils/JsonGlmHelpers.h"
 #include "Utils/StringUtils.h"
+#include "Graphics/Textures/TextureCooker.h"
+#include "Utils/ResourceManager/ResourceManager.h"
+#include "Utils/MappedFile.h"
 #include <Logging.h>
 #include <stb_image.h>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <cstring>
 
 inline int CalcRequiredMipLevels(int width, int height, int depth) {
 	return (1 + floor(log2(std::max(width, std::max(height, depth)))));
@@ -115,6 +119,23 @@ Texture3D::Sptr Texture3D::FromJson(const nlohmann::json& data)
 	description.GenerateMipMaps = JsonGet(data, "generate_mipmaps", false);
 	description.FormatHint = JsonParseEnum(PixelFormat, data, "format", PixelFormat::Unknown);
 
+	// If the manifest was loaded from an archive, the cooked LUT is read straight out of the mapping
+	AssetView archived = ResourceManager::ReadArchived<Texture3D>(data);
+	if (archived.IsValid()) {
+		std::string filename = description.Filename;
+		description.Filename = "";
+		Texture3D::Sptr result = std::make_shared<Texture3D>(description);
+		result->_description.Filename = filename;
+
+		LutData lut = LutData();
+		if (__ParseCookedLut(archived.Data, archived.Size, filename, lut)) {
+			result->_UploadLut(lut);
+			return result;
+		}
+		LOG_WARN("Failed to load \"{}\" from archive, falling back to the loose file", filename);
+		description.Filename = filename;
+	}
+
 	Texture3D::Sptr result = std::make_shared<Texture3D>(description);
 
 	// If we embedded data into the JSON, load it now
@@ -141,25 +162,61 @@ void Texture3D::_LoadDataFromFile()
 		std::string extension = fPath.extension().string();
 		StringTools::ToLower(extension);
 
-		if (extension.compare(".cube") == 0) {
-			_LoadCubeFile();
+		if (extension.compare(".cube") == 0 || extension.compare(".lut") == 0) {
+			_LoadLut();
 		}
 	}
 }
 
-void Texture3D::_LoadCubeFile()
+void Texture3D::_LoadLut()
 {
-	std::ifstream inFile(_description.Filename);
+	LutData lut = LutData();
 
-	if (!inFile.is_open()) {
-		LOG_WARN("Failed to open file .cube file: {}", _description.Filename);
+	// The cooked file is a straight copy of the texels, so we can skip parsing the text entirely
+	std::string cookedPath = GetCookedLutPath(_description.Filename);
+	bool loaded = TextureCooker::IsUpToDate({ _description.Filename }, cookedPath) && __LoadCookedLut(cookedPath, lut);
+	if (!loaded && cookedPath != _description.Filename) {
+		loaded = __ParseCubeFile(_description.Filename, lut);
+	}
+
+	if (!loaded) {
+		LOG_WARN("Failed to load cube file: \"{}\"", _description.Filename);
 		return;
 	}
 
-	glm::u8vec3* textureData = nullptr;
-	uint32_t lutSize{ 0 };
-	uint32_t ix{ 0 };
-	glm::vec3 rgb { 0, 0, 0 };
+	_UploadLut(lut);
+}
+
+void Texture3D::_UploadLut(const LutData& lut)
+{
+	// We'll grab the title for our debug name, nice lil use of it
+	if (!lut.Title.empty()) {
+		SetDebugName(lut.Title);
+	}
+
+	// Update the description's size
+	_description.Width = _description.Height = _description.Depth = lut.Size;
+	// Set the pixel format
+	_description.Format = InternalFormat::RGB8;
+	// We need to clamp to edge for LUTS
+	_description.WrapS = _description.WrapT = _description.WrapR = WrapMode::ClampToEdge;
+
+	// Allocate data and configure params
+	_SetTextureParams();
+	// Load data
+	LoadData(lut.Size, lut.Size, lut.Size, PixelFormat::RGB, PixelType::UByte, lut.Texels.data());
+}
+
+bool Texture3D::__ParseCubeFile(const std::string& path, LutData& result)
+{
+	std::ifstream inFile(path);
+
+	if (!inFile.is_open()) {
+		LOG_WARN("Failed to open file .cube file: {}", path);
+		return false;
+	}
+
+	size_t ix{ 0 };
 
 	std::string line;
 	// Iterate as long as we have lines from the file
@@ -182,36 +239,23 @@ void Texture3D::_LoadCubeFile()
 		else if (line.find("LUT_3D_SIZE") != std::string::npos) {
 
 			// Skip over the LUT_3D_SIZE text and read in the value
-			std::stringstream lReader(line.substr(12));
-			lReader >> lutSize;
-
-			// Update the description's size
-			_description.Width = _description.Height = _description.Depth = lutSize;
-
-			// If the size we read is non-zero, allocate our data!
-			if (lutSize > 0) {
-				// If we had data already, delete it
-				if (textureData != nullptr) {
-					delete[] textureData;
-				} 
-
-				// Allocate data to store texels in
-				textureData = new glm::u8vec3[(size_t)lutSize * lutSize * lutSize];
-				ix = 0;
-			}
+			result.Size = static_cast<uint32_t>(strtoul(line.c_str() + 11, nullptr, 10));
+
+			// Allocate data to store texels in, replacing anything we had already
+			result.Texels.assign((size_t)result.Size * result.Size * result.Size, glm::u8vec3(0));
+			ix = 0;
 		}
 
-		// We'll grab the title for our debug name, nice lil use of it
+		// Grab the title, so the texture can use it as it's debug name
 		else if (line.find("TITLE") != std::string::npos) {
 
 			// Skip over the TITLE token and the space after it
 			std::string name = line.substr(6);
 
-			// Trim any excess whitespace
+			// Trim any excess whitespace and quotes
 			StringTools::Trim(name);
-
-			// We'll store this in the debug name
-			SetDebugName(name);
+			StringTools::Trim(name, '"');
+			result.Title = name;
 		}
 
 		else if (line.find("DOMAIN_MIN") != std::string::npos)
@@ -224,46 +268,71 @@ void Texture3D::_LoadCubeFile()
 		{ /* ignore for now */ }
 
 		// Reading data lines
-		else if (!line.empty() && textureData != nullptr) {
+		else if (!result.Texels.empty()) {
 
 			// Make sure we don't case a write access violation
-			if (ix >= (lutSize * lutSize * lutSize) && lutSize > 0) {
+			if (ix >= result.Texels.size()) {
 				LOG_ASSERT(false, "Attempting to write outside the bounds of the LUT");
+				continue;
 			}
 
-			// Read RGB from the line
-			std::stringstream lReader(line);
-			lReader >> rgb.r >> rgb.g >> rgb.b;
+			// Read RGB from the line, strtof is a good deal faster than a stringstream for the thousands of lines in a LUT
+			glm::vec3 rgb;
+			char* seek = const_cast<char*>(line.c_str());
+			rgb.r = strtof(seek, &seek);
+			rgb.g = strtof(seek, &seek);
+			rgb.b = strtof(seek, &seek);
 
 			rgb = glm::clamp(rgb, glm::vec3(0), glm::vec3(1));
 
 			// Store in the array, converting to the correct scale for bytes
-			textureData[ix].r = static_cast<uint8_t>(rgb.r * 255);
-			textureData[ix].g = static_cast<uint8_t>(rgb.g * 255);
-			textureData[ix].b = static_cast<uint8_t>(rgb.b * 255);
+			result.Texels[ix] = glm::u8vec3(rgb * 255.0f);
 
 			// Move to the next texel
 			ix++;
 		}
-	} 
+	}
 
-	if (textureData != nullptr) {
-		// Set the pixel format
-		_description.Format = InternalFormat::RGB8;
-		// We need to clamp to edge for LUTS
-		_description.WrapS = _description.WrapT = _description.WrapR = WrapMode::ClampToEdge;
+	return !result.Texels.empty();
+}
 
-		// Allocate data and configure params
-		_SetTextureParams();
-		// Load data
-		LoadData(lutSize, lutSize, lutSize, PixelFormat::RGB, PixelType::UByte, textureData);
+bool Texture3D::__LoadCookedLut(const std::string& path, LutData& result)
+{
+	MappedFile file;
+	if (!file.Open(path)) {
+		return false;
+	}
+	return __ParseCookedLut(file.GetData(), file.GetSize(), path, result);
+}
 
-		// Clean up after ourselves
-		delete[] textureData;
+bool Texture3D::__ParseCookedLut(const uint8_t* data, size_t size, const std::string& name, LutData& result)
+{
+	// Anything that doesn't match what we expect is treated as missing, and we'll fall back to the source
+	LutHeader header = LutHeader();
+	LutHeader expected = LutHeader();
+	if (size >= sizeof(LutHeader)) {
+		memcpy(&header, data, sizeof(LutHeader));
 	}
-	else {
-		LOG_WARN("Failed to load cube file: \"{}\"", _description.Filename);
+	if (size < sizeof(LutHeader) ||
+		memcmp(header.HeaderBytes, expected.HeaderBytes, 4) != 0 ||
+		header.Version != CurrentLutVersion || header.Size == 0 || header.Size > 256) {
+		LOG_WARN("Cooked LUT \"{}\" is invalid or from an older version", name);
+		return false;
+	}
+
+	size_t texelCount = (size_t)header.Size * header.Size * header.Size;
+	if (size - sizeof(LutHeader) < (size_t)header.TitleLength + texelCount * sizeof(glm::u8vec3)) {
+		LOG_WARN("Cooked LUT \"{}\" is truncated", name);
+		return false;
 	}
+
+	const uint8_t* seek = data + sizeof(LutHeader);
+	result.Size = header.Size;
+	result.Title.assign(reinterpret_cast<const char*>(seek), header.TitleLength);
+	seek += header.TitleLength;
+	result.Texels.resize(texelCount);
+	memcpy(result.Texels.data(), seek, texelCount * sizeof(glm::u8vec3));
+	return true;
 }
 
 void Texture3D::_SetTextureParams()
@@ -272,6 +341,7 @@ void Texture3D::_SetTextureParams()
 	int layers = _description.GenerateMipMaps ? CalcRequiredMipLevels(_description.Width, _description.Height, _description.Depth) : 1;
 	// Allocates the memory for our texture
 	glTextureStorage3D(_rendererId, layers, (GLenum)_description.Format, _description.Width, _description.Height, _description.Depth);
+	_SetGpuMemory(GetTextureStorageSize(GetInternalFormatSize(*_description.Format), _description.Width, _description.Height, _description.Depth, layers));
 
 	glTextureParameteri(_rendererId, GL_TEXTURE_MIN_FILTER, (GLenum)_description.MinificationFilter);
 	glTextureParameteri(_rendererId, GL_TEXTURE_MAG_FILTER, (GLenum)_description.MagnificationFilter);
@@ -291,3 +361,35 @@ Texture3D::Sptr Texture3D::LoadFromFile(const std::string& path, const Texture3D
 
 	return result;
 }
+
+std::string Texture3D::GetCookedLutPath(const std::string& source)
+{
+	std::filesystem::path path = std::filesystem::path(source);
+	path.replace_extension(".lut");
+	return path.string();
+}
+
+bool Texture3D::CookLut(const std::string& source, const std::string& outFile /*= ""*/)
+{
+	LutData lut = LutData();
+	if (!__ParseCubeFile(source, lut)) {
+		LOG_WARN("Failed to load cube file: \"{}\"", source);
+		return false;
+	}
+
+	std::string outputPath = outFile.empty() ? GetCookedLutPath(source) : outFile;
+	std::ofstream file(outputPath, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		LOG_WARN("Failed to open \"{}\" for writing", outputPath);
+		return false;
+	}
+
+	LutHeader header = LutHeader();
+	header.Version = CurrentLutVersion;
+	header.Size = lut.Size;
+	header.TitleLength = static_cast<uint32_t>(lut.Title.size());
+	file.write(reinterpret_cast<const char*>(&header), sizeof(LutHeader));
+	file.write(lut.Title.data(), lut.Title.size());
+	file.write(reinterpret_cast<const char*>(lut.Texels.data()), lut.Texels.size() * sizeof(glm::u8vec3));
+	return file.good();
+}
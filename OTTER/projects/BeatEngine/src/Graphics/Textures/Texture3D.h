@@ -1,5 +1,6 @@
 #pragma once
 #include "ITexture.h"
+#include <vector>
 
 /// <summary>
 /// Describes all parameters we can manipulate with our 2D Textures
@@ -146,24 +147,63 @@ public:
 	virtual nlohmann::json ToJson() const override;
 	static Texture3D::Sptr FromJson(const nlohmann::json& data);
 
+	/// <summary>
+	/// Gets the path that the cooked version of a .cube LUT is stored at
+	/// </summary>
+	static std::string GetCookedLutPath(const std::string& source);
+	/// <summary>
+	/// Converts a .cube LUT into a binary file that can be loaded without parsing any text. Textures
+	/// that load the .cube file will pick up the cooked version as long as it is newer than the source
+	/// </summary>
+	/// <param name="source">The path to the .cube file to convert</param>
+	/// <param name="outFile">The output path for the cooked file, or empty to use GetCookedLutPath</param>
+	/// <returns>True if the cooked file was written</returns>
+	static bool CookLut(const std::string& source, const std::string& outFile = "");
+
 protected:
 	Texture3DDescription _description;
 	PixelType _pixelType;
 
+	// The texels and name of a 3D LUT, either parsed from a .cube file or read from a cooked one
+	struct LutData {
+		std::string              Title;
+		uint32_t                 Size = 0;
+		std::vector<glm::u8vec3> Texels;
+	};
+
+	// Will be put at the start of a cooked LUT, followed by the title and then the texels
+	struct LutHeader {
+		char     HeaderBytes[4] = { 'B', 'L', 'U', 'T' };
+		uint16_t Version = 0;
+		uint32_t Size = 0;
+		uint32_t TitleLength = 0;
+	};
+
+	// The version that we write to new cooked LUTs
+	static const uint16_t CurrentLutVersion = 0x01;
+
 	/// <summary>
 	/// Loads this texture from the file specified in the description
 	/// Will overwrite description size
 	/// </summary>
 	void _LoadDataFromFile();
 	/// <summary>
-	/// Loads a 3D LUT from a .cube file
+	/// Loads a 3D LUT from a .cube file, or from it's cooked version if there is one
 	/// </summary>
-	void _LoadCubeFile();
+	void _LoadLut();
+	/// <summary>
+	/// Allocates the texture to fit a LUT and uploads it's texels
+	/// </summary>
+	void _UploadLut(const LutData& lut);
 	/// <summary>
 	/// Allocates our texture's memory and sets sampling / filtering parameters
 	/// </summary>
 	void _SetTextureParams();
 
+	static bool __ParseCubeFile(const std::string& path, LutData& result);
+	static bool __LoadCookedLut(const std::string& path, LutData& result);
+	static bool __ParseCookedLut(const uint8_t* data, size_t size, const std::string& name, LutData& result);
+
 public:
 	static Texture3D::Sptr LoadFromFile(const std::string& path, const Texture3DDescription& description = Texture3DDescription(), bool forceRgba = true);
 };
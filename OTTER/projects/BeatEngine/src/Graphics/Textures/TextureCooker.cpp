@@ -0,0 +1,458 @@
+#include "Graphics/Textures/TextureCooker.h"
+#include <array>
+#include <cfloat>
+#include <cstring>
+#include <filesystem>
+#include <stb_image.h>
+#include <Logging.h>
+
+#include "Graphics/Textures/TextureCube.h"
+
+/// <summary>
+/// Get the number of mipmap levels required for a texture of the given size
+/// </summary>
+/// <param name="width">The width of the texture in pixels</param>
+/// <param name="height">The height of the texture in pixels</param>
+/// <returns>Number of mip levels required for the texture</returns>
+inline int CalcRequiredMipLevels(int width, int height) {
+	return (1 + floor(log2(glm::max(width, height))));
+}
+
+// Converts an 8 bit sRGB value into linear space
+static float __SrgbToLinear(uint8_t value) {
+	static const std::array<float, 256> table = []() {
+		std::array<float, 256> result;
+		for (int ix = 0; ix < 256; ix++) {
+			float c = ix / 255.0f;
+			result[ix] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+		}
+		return result;
+	}();
+	return table[value];
+}
+
+// Converts a linear value back into 8 bit sRGB
+static uint8_t __LinearToSrgb(float value) {
+	value = glm::clamp(value, 0.0f, 1.0f);
+	float c = value <= 0.0031308f ? value * 12.92f : 1.055f * powf(value, 1.0f / 2.4f) - 0.055f;
+	return (uint8_t)(c * 255.0f + 0.5f);
+}
+
+static uint8_t __ToUnorm(float value) {
+	return (uint8_t)(glm::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+// Packs a color into 5:6:5, rounding to the nearest value
+static uint16_t __PackRgb565(const glm::vec3& color) {
+	glm::vec3 c = glm::clamp(color, 0.0f, 255.0f);
+	uint16_t r = (uint16_t)((c.r * 31.0f + 127.5f) / 255.0f);
+	uint16_t g = (uint16_t)((c.g * 63.0f + 127.5f) / 255.0f);
+	uint16_t b = (uint16_t)((c.b * 31.0f + 127.5f) / 255.0f);
+	return (r << 11) | (g << 5) | b;
+}
+
+// Expands a 5:6:5 color the same way the hardware does
+static glm::vec3 __UnpackRgb565(uint16_t color) {
+	uint32_t r = (color >> 11) & 0x1F;
+	uint32_t g = (color >> 5) & 0x3F;
+	uint32_t b = color & 0x1F;
+	return glm::vec3((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+}
+
+void TextureCooker::EncodeBC1Block(const glm::u8vec4 texels[16], uint8_t* output) {
+	glm::vec3 colors[16];
+	glm::vec3 mean = glm::vec3(0.0f);
+	for (int ix = 0; ix < 16; ix++) {
+		colors[ix] = glm::vec3(texels[ix]);
+		mean += colors[ix];
+	}
+	mean /= 16.0f;
+
+	// Find the axis that the colors are spread out along, using a few steps of power iteration on the covariance
+	glm::mat3 covariance = glm::mat3(0.0f);
+	for (int ix = 0; ix < 16; ix++) {
+		glm::vec3 delta = colors[ix] - mean;
+		covariance += glm::outerProduct(delta, delta);
+	}
+	glm::vec3 axis = glm::vec3(1.0f);
+	for (int iteration = 0; iteration < 8; iteration++) {
+		axis = covariance * axis;
+		float largest = glm::max(glm::abs(axis.x), glm::max(glm::abs(axis.y), glm::abs(axis.z)));
+		if (largest < 1e-6f) {
+			axis = glm::vec3(0.0f);
+			break;
+		}
+		axis /= largest;
+	}
+
+	// Use the colors at either end of the axis as our endpoints, inset slightly since the extremes are rarely hit exactly
+	glm::vec3 minColor = mean, maxColor = mean;
+	if (glm::dot(axis, axis) > 0.0f) {
+		float minT = FLT_MAX, maxT = -FLT_MAX;
+		for (int ix = 0; ix < 16; ix++) {
+			float t = glm::dot(colors[ix] - mean, axis);
+			if (t < minT) { minT = t; minColor = colors[ix]; }
+			if (t > maxT) { maxT = t; maxColor = colors[ix]; }
+		}
+		glm::vec3 inset = (maxColor - minColor) / 16.0f;
+		minColor += inset;
+		maxColor -= inset;
+	}
+
+	uint16_t c0 = __PackRgb565(maxColor);
+	uint16_t c1 = __PackRgb565(minColor);
+	// The first color must be larger to select the 4 color mode, the palette gets built from the final order
+	if (c0 < c1) {
+		std::swap(c0, c1);
+	}
+
+	uint32_t indices = 0;
+	if (c0 != c1) {
+		glm::vec3 palette[4];
+		palette[0] = __UnpackRgb565(c0);
+		palette[1] = __UnpackRgb565(c1);
+		palette[2] = (palette[0] * 2.0f + palette[1]) / 3.0f;
+		palette[3] = (palette[0] + palette[1] * 2.0f) / 3.0f;
+
+		for (int ix = 0; ix < 16; ix++) {
+			uint32_t best = 0;
+			float bestDist = FLT_MAX;
+			for (uint32_t p = 0; p < 4; p++) {
+				glm::vec3 delta = colors[ix] - palette[p];
+				float dist = glm::dot(delta, delta);
+				if (dist < bestDist) {
+					bestDist = dist;
+					best = p;
+				}
+			}
+			indices |= best << (ix * 2);
+		}
+	}
+
+	memcpy(output, &c0, sizeof(uint16_t));
+	memcpy(output + 2, &c1, sizeof(uint16_t));
+	memcpy(output + 4, &indices, sizeof(uint32_t));
+}
+
+void TextureCooker::EncodeBC4Block(const uint8_t values[16], uint8_t* output) {
+	uint8_t minValue = 255, maxValue = 0;
+	for (int ix = 0; ix < 16; ix++) {
+		minValue = glm::min(minValue, values[ix]);
+		maxValue = glm::max(maxValue, values[ix]);
+	}
+
+	// With the first endpoint larger we get 6 interpolated values between the endpoints. Index 0 is the max,
+	// index 1 is the min, and indices 2-7 step from the max towards the min
+	uint64_t indices = 0;
+	if (maxValue > minValue) {
+		uint32_t range = maxValue - minValue;
+		for (int ix = 0; ix < 16; ix++) {
+			uint32_t step = ((values[ix] - minValue) * 14 + range) / (range * 2);
+			uint64_t index = step == 7 ? 0 : step == 0 ? 1 : 8 - step;
+			indices |= index << (ix * 3);
+		}
+	}
+
+	output[0] = maxValue;
+	output[1] = minValue;
+	for (int ix = 0; ix < 6; ix++) {
+		output[2 + ix] = (uint8_t)(indices >> (ix * 8));
+	}
+}
+
+void TextureCooker::__EncodeLevel(const glm::u8vec4* texels, uint32_t width, uint32_t height, InternalFormat format, uint8_t* output) {
+	if (format == InternalFormat::RGBA8) {
+		memcpy(output, texels, sizeof(glm::u8vec4) * width * height);
+		return;
+	}
+
+	size_t blockSize = GetCompressedBlockSize(*format);
+	uint32_t blocksX = (width + 3) / 4;
+	uint32_t blocksY = (height + 3) / 4;
+
+	glm::u8vec4 block[16];
+	uint8_t channel[16];
+	for (uint32_t by = 0; by < blocksY; by++) {
+		for (uint32_t bx = 0; bx < blocksX; bx++) {
+			// Blocks that hang off the edge of the image repeat the edge texels
+			for (uint32_t iy = 0; iy < 4; iy++) {
+				uint32_t y = glm::min(by * 4 + iy, height - 1);
+				for (uint32_t ix = 0; ix < 4; ix++) {
+					uint32_t x = glm::min(bx * 4 + ix, width - 1);
+					block[iy * 4 + ix] = texels[y * width + x];
+				}
+			}
+
+			uint8_t* dest = output + (by * (size_t)blocksX + bx) * blockSize;
+			switch (format) {
+				case InternalFormat::BC1:
+					EncodeBC1Block(block, dest);
+					break;
+				case InternalFormat::BC3:
+					for (int ix = 0; ix < 16; ix++) { channel[ix] = block[ix].a; }
+					EncodeBC4Block(channel, dest);
+					EncodeBC1Block(block, dest + 8);
+					break;
+				case InternalFormat::BC4:
+					for (int ix = 0; ix < 16; ix++) { channel[ix] = block[ix].r; }
+					EncodeBC4Block(channel, dest);
+					break;
+				case InternalFormat::BC5:
+					for (int ix = 0; ix < 16; ix++) { channel[ix] = block[ix].r; }
+					EncodeBC4Block(channel, dest);
+					for (int ix = 0; ix < 16; ix++) { channel[ix] = block[ix].g; }
+					EncodeBC4Block(channel, dest + 8);
+					break;
+				default:
+					LOG_ASSERT(false, "Cannot encode texture to {}", ~format);
+					break;
+			}
+		}
+	}
+}
+
+void TextureCooker::__CookLayer(const SourceImage& source, const TextureCookSettings& settings, DdsImage& image, uint32_t layer) {
+	// We keep the working level as floats so that rounding errors don't build up as we go down the chain
+	uint32_t width = source.Width;
+	uint32_t height = source.Height;
+	std::vector<glm::vec4> level(source.Texels.size());
+	for (size_t ix = 0; ix < source.Texels.size(); ix++) {
+		const glm::u8vec4& texel = source.Texels[ix];
+		if (settings.IsNormalMap) {
+			level[ix] = glm::vec4(glm::vec3(texel) / 127.5f - 1.0f, texel.a / 255.0f);
+		} else if (settings.IsSrgb) {
+			level[ix] = glm::vec4(__SrgbToLinear(texel.r), __SrgbToLinear(texel.g), __SrgbToLinear(texel.b), texel.a / 255.0f);
+		} else {
+			level[ix] = glm::vec4(texel) / 255.0f;
+		}
+	}
+
+	std::vector<glm::u8vec4> encoded(level.size());
+	std::vector<glm::vec4> next;
+	for (uint32_t mip = 0; mip < image.Levels; mip++) {
+		// Everything below the top level is a 2x2 box filter of the level above it
+		if (mip > 0) {
+			uint32_t nextWidth = glm::max(width / 2, 1u);
+			uint32_t nextHeight = glm::max(height / 2, 1u);
+			next.resize(nextWidth * (size_t)nextHeight);
+			for (uint32_t iy = 0; iy < nextHeight; iy++) {
+				uint32_t y0 = glm::min(iy * 2, height - 1);
+				uint32_t y1 = glm::min(iy * 2 + 1, height - 1);
+				for (uint32_t ix = 0; ix < nextWidth; ix++) {
+					uint32_t x0 = glm::min(ix * 2, width - 1);
+					uint32_t x1 = glm::min(ix * 2 + 1, width - 1);
+					glm::vec4 sum =
+						level[y0 * width + x0] + level[y0 * width + x1] +
+						level[y1 * width + x0] + level[y1 * width + x1];
+					glm::vec4 result = sum * 0.25f;
+					if (settings.IsNormalMap) {
+						float length = glm::length(glm::vec3(result));
+						result = glm::vec4(length > 0.0f ? glm::vec3(result) / length : glm::vec3(0.0f, 0.0f, 1.0f), result.a);
+					}
+					next[iy * nextWidth + ix] = result;
+				}
+			}
+			level.swap(next);
+			width = nextWidth;
+			height = nextHeight;
+		}
+
+		encoded.resize(level.size());
+		for (size_t ix = 0; ix < level.size(); ix++) {
+			const glm::vec4& texel = level[ix];
+			if (settings.IsNormalMap) {
+				encoded[ix] = glm::u8vec4(__ToUnorm(texel.r * 0.5f + 0.5f), __ToUnorm(texel.g * 0.5f + 0.5f), __ToUnorm(texel.b * 0.5f + 0.5f), __ToUnorm(texel.a));
+			} else if (settings.IsSrgb) {
+				encoded[ix] = glm::u8vec4(__LinearToSrgb(texel.r), __LinearToSrgb(texel.g), __LinearToSrgb(texel.b), __ToUnorm(texel.a));
+			} else {
+				encoded[ix] = glm::u8vec4(__ToUnorm(texel.r), __ToUnorm(texel.g), __ToUnorm(texel.b), __ToUnorm(texel.a));
+			}
+		}
+
+		__EncodeLevel(encoded.data(), width, height, image.Format, image.GetLevelData(layer, mip));
+	}
+}
+
+InternalFormat TextureCooker::__ResolveFormat(const TextureCookSettings& settings, const std::vector<SourceImage>& layers) {
+	switch (settings.Format) {
+		case CookedTextureFormat::BC1:   return InternalFormat::BC1;
+		case CookedTextureFormat::BC3:   return InternalFormat::BC3;
+		case CookedTextureFormat::BC4:   return InternalFormat::BC4;
+		case CookedTextureFormat::BC5:   return InternalFormat::BC5;
+		case CookedTextureFormat::RGBA8: return InternalFormat::RGBA8;
+		default:
+			break;
+	}
+
+	// Textures are always loaded as RGBA, so we only pick between the formats that keep all 4 channels
+	for (const SourceImage& layer : layers) {
+		for (const glm::u8vec4& texel : layer.Texels) {
+			if (texel.a != 255) {
+				return InternalFormat::BC3;
+			}
+		}
+	}
+	return InternalFormat::BC1;
+}
+
+bool TextureCooker::__LoadSource(const std::string& path, SourceImage& result) {
+	int width, height, numChannels;
+	// Match the texture loaders, so that the cooked data is in the same orientation
+	stbi_set_flip_vertically_on_load(true);
+	uint8_t* data = stbi_load(path.c_str(), &width, &height, &numChannels, 4);
+	if (data == nullptr) {
+		LOG_WARN("STBI Failed to load image from \"{}\"", path);
+		return false;
+	}
+
+	result.Width = width;
+	result.Height = height;
+	result.Texels.resize(width * (size_t)height);
+	memcpy(result.Texels.data(), data, result.Texels.size() * sizeof(glm::u8vec4));
+	stbi_image_free(data);
+	return true;
+}
+
+bool TextureCooker::__Write(const std::vector<SourceImage>& layers, const TextureCookSettings& settings, bool isCubemap, const std::string& outputPath) {
+	DdsImage image = DdsImage();
+	image.Format    = __ResolveFormat(settings, layers);
+	image.Width     = layers[0].Width;
+	image.Height    = layers[0].Height;
+	image.Layers    = (uint32_t)layers.size();
+	image.Levels    = settings.GenerateMips ? CalcRequiredMipLevels(image.Width, image.Height) : 1;
+	image.IsCubemap = isCubemap;
+	image.Allocate();
+
+	for (uint32_t ix = 0; ix < image.Layers; ix++) {
+		__CookLayer(layers[ix], settings, image, ix);
+	}
+
+	if (!image.Save(outputPath)) {
+		return false;
+	}
+	LOG_INFO("Cooked \"{}\" ({}x{}, {} layers, {} levels, {})", outputPath, image.Width, image.Height, image.Layers, image.Levels, ~image.Format);
+	return true;
+}
+
+bool TextureCooker::CookTexture2D(const std::string& source, const TextureCookSettings& settings) {
+	std::vector<SourceImage> layers(1);
+	if (!__LoadSource(source, layers[0])) {
+		return false;
+	}
+	return __Write(layers, settings, false, GetCookedPath(source));
+}
+
+bool TextureCooker::CookTexture2DArray(const std::string& source, uint32_t splitX, uint32_t splitY, const TextureCookSettings& settings) {
+	SourceImage image;
+	if (!__LoadSource(source, image)) {
+		return false;
+	}
+	if (splitX == 0 || splitY == 0 || image.Width % splitX != 0 || image.Height % splitY != 0) {
+		LOG_ERROR("Could not cook \"{}\", size {}x{} does not divide into {}x{} layers", source, image.Width, image.Height, splitX, splitY);
+		return false;
+	}
+
+	// Split the image into layers the same way that Texture2DArray does, starting from the bottom left
+	uint32_t sliceWidth = image.Width / splitX;
+	uint32_t sliceHeight = image.Height / splitY;
+	std::vector<SourceImage> layers(splitX * splitY);
+	for (uint32_t iz = 0; iz < layers.size(); iz++) {
+		SourceImage& layer = layers[iz];
+		layer.Width = sliceWidth;
+		layer.Height = sliceHeight;
+		layer.Texels.resize(sliceWidth * (size_t)sliceHeight);
+		uint32_t startX = (iz % splitX) * sliceWidth;
+		uint32_t startY = (iz / splitX) * sliceHeight;
+		for (uint32_t iy = 0; iy < sliceHeight; iy++) {
+			memcpy(
+				layer.Texels.data() + iy * (size_t)sliceWidth,
+				image.Texels.data() + (startY + iy) * (size_t)image.Width + startX,
+				sliceWidth * sizeof(glm::u8vec4)
+			);
+		}
+	}
+
+	return __Write(layers, settings, false, GetCookedArrayPath(source, splitX, splitY));
+}
+
+bool TextureCooker::CookTextureCube(const std::string& baseFilename, const TextureCookSettings& settings) {
+	std::vector<std::string> faces = GetCubeFacePaths(baseFilename);
+	if (faces.size() != 6) {
+		LOG_ERROR("Could not find all 6 faces for cubemap \"{}\"", baseFilename);
+		return false;
+	}
+
+	std::vector<SourceImage> layers(6);
+	for (int ix = 0; ix < 6; ix++) {
+		if (!__LoadSource(faces[ix], layers[ix])) {
+			return false;
+		}
+		if (layers[ix].Width != layers[ix].Height || layers[ix].Width != layers[0].Width) {
+			LOG_ERROR("Cubemap face \"{}\" is not square, or does not match the other faces", faces[ix]);
+			return false;
+		}
+	}
+
+	return __Write(layers, settings, true, GetCookedPath(baseFilename));
+}
+
+std::string TextureCooker::GetCookedPath(const std::string& source) {
+	std::filesystem::path path = std::filesystem::path(source);
+	path.replace_extension(".dds");
+	return path.string();
+}
+
+std::string TextureCooker::GetCookedArrayPath(const std::string& source, uint32_t splitX, uint32_t splitY) {
+	if (IsDdsFile(source)) {
+		return source;
+	}
+	std::filesystem::path path = std::filesystem::path(source);
+	path.replace_extension("." + std::to_string(splitX) + "x" + std::to_string(splitY) + ".dds");
+	return path.string();
+}
+
+std::vector<std::string> TextureCooker::GetCubeFacePaths(const std::string& baseFilename) {
+	std::filesystem::path baseName = std::filesystem::path(baseFilename);
+	std::filesystem::path rootFileName = baseName.parent_path() / baseName.stem();
+
+	std::vector<std::string> result;
+	for (int ix = 0; ix < 6; ix++) {
+		// EX: foo/bar/Skybox_PosX.png
+		std::filesystem::path targetPath = rootFileName;
+		targetPath += "_" + ~(CubeMapFace)ix;
+		targetPath += baseName.extension();
+		if (!std::filesystem::exists(targetPath)) {
+			return std::vector<std::string>();
+		}
+		result.push_back(targetPath.string());
+	}
+	return result;
+}
+
+bool TextureCooker::IsUpToDate(const std::vector<std::string>& sources, const std::string& cookedPath) {
+	std::error_code error;
+	auto cookedTime = std::filesystem::last_write_time(cookedPath, error);
+	if (error) {
+		return false;
+	}
+	// Sources that are missing are fine, so that a build can ship with only the cooked files
+	for (const std::string& source : sources) {
+		auto sourceTime = std::filesystem::last_write_time(source, error);
+		if (!error && sourceTime > cookedTime) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool TextureCooker::LoadCooked(const std::vector<std::string>& sources, const std::string& cookedPath, DdsImage& result) {
+	if (!IsUpToDate(sources, cookedPath)) {
+		return false;
+	}
+	return DdsImage::Load(cookedPath, result);
+}
+
+bool TextureCooker::IsDdsFile(const std::string& path) {
+	std::string extension = std::filesystem::path(path).extension().string();
+	return extension == ".dds" || extension == ".DDS";
+}
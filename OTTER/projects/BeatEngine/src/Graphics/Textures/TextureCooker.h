@@ -0,0 +1,152 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <EnumToString.h>
+#include <GLM/glm.hpp>
+
+#include "Graphics/Textures/DdsFile.h"
+
+/// <summary>
+/// The formats that the texture cooker can encode to
+/// </summary>
+ENUM(CookedTextureFormat, uint8_t,
+	// BC3 if the image has any transparency, otherwise BC1
+	Auto  = 0,
+	// RGB at 4 bits per texel, alpha is dropped
+	BC1   = 1,
+	// RGBA at 8 bits per texel
+	BC3   = 2,
+	// A single channel at 4 bits per texel, taken from red
+	BC4   = 3,
+	// Two channels at 8 bits per texel, taken from red and green. Shaders must rebuild z for normal maps
+	BC5   = 4,
+	// Uncompressed, for data that can't tolerate compression artifacts (ex: lookup tables)
+	RGBA8 = 5
+);
+
+/// <summary>
+/// Controls how a single texture is cooked
+/// </summary>
+struct TextureCookSettings {
+	/// <summary>
+	/// The format to encode the texture to
+	/// </summary>
+	CookedTextureFormat Format       = CookedTextureFormat::Auto;
+	/// <summary>
+	/// True if the RGB channels hold colors, which are averaged in linear space when building the mip chain.
+	/// The texture is still stored as a UNORM format, so it samples the same way it did before it was cooked
+	/// </summary>
+	bool                IsSrgb       = true;
+	/// <summary>
+	/// True if the RGB channels hold a tangent space normal, which is re-normalized at every mip level
+	/// </summary>
+	bool                IsNormalMap  = false;
+	/// <summary>
+	/// True to store a full mip chain down to 1x1, false to only store the top level
+	/// </summary>
+	bool                GenerateMips = true;
+};
+
+/// <summary>
+/// Converts source images into DDS files with pre-built mip chains, in a block compressed format that can be
+/// uploaded as-is. Cooked files sit next to their sources, and the texture classes will pick them up in place
+/// of the source image as long as they are newer than it.
+///
+/// Mip levels are built on the CPU with a box filter, in linear space for color data. Encoding is a simple
+/// range fit along the principal axis of each block, which is fast but not as good as a dedicated encoder
+/// </summary>
+class TextureCooker {
+public:
+	/// <summary>
+	/// Cooks a single image into a 2D texture
+	/// </summary>
+	/// <param name="source">The path to the source image</param>
+	/// <param name="settings">The settings to cook the texture with</param>
+	/// <returns>True if the cooked file was written</returns>
+	static bool CookTexture2D(const std::string& source, const TextureCookSettings& settings = TextureCookSettings());
+	/// <summary>
+	/// Cooks a single image into a 2D texture array, by splitting it into a grid of equal sized layers
+	/// the same way that Texture2DArray does
+	/// </summary>
+	/// <param name="source">The path to the source image</param>
+	/// <param name="splitX">The number of layers along the x axis of the image</param>
+	/// <param name="splitY">The number of layers along the y axis of the image</param>
+	/// <param name="settings">The settings to cook the texture with</param>
+	/// <returns>True if the cooked file was written</returns>
+	static bool CookTexture2DArray(const std::string& source, uint32_t splitX, uint32_t splitY, const TextureCookSettings& settings = TextureCookSettings());
+	/// <summary>
+	/// Cooks the 6 faces of a cubemap into a single texture. The faces are found the same way that
+	/// TextureCube does it (ex: "skybox.png" will look for "skybox_PosX.png", "skybox_NegX.png", etc...)
+	/// </summary>
+	/// <param name="baseFilename">The base filename of the cubemap</param>
+	/// <param name="settings">The settings to cook the texture with</param>
+	/// <returns>True if the cooked file was written</returns>
+	static bool CookTextureCube(const std::string& baseFilename, const TextureCookSettings& settings = TextureCookSettings());
+
+	/// <summary>
+	/// Gets the path that the cooked version of a 2D texture or cubemap is stored at
+	/// </summary>
+	static std::string GetCookedPath(const std::string& source);
+	/// <summary>
+	/// Gets the path that the cooked version of a 2D texture array is stored at, these are kept separate
+	/// from the 2D version since the same image may be used both ways
+	/// </summary>
+	static std::string GetCookedArrayPath(const std::string& source, uint32_t splitX, uint32_t splitY);
+	/// <summary>
+	/// Gets the paths to the 6 faces of a cubemap, or an empty list if any of them are missing
+	/// </summary>
+	static std::vector<std::string> GetCubeFacePaths(const std::string& baseFilename);
+
+	/// <summary>
+	/// Returns true if the cooked file exists and is at least as new as all of it's sources
+	/// </summary>
+	static bool IsUpToDate(const std::vector<std::string>& sources, const std::string& cookedPath);
+
+	/// <summary>
+	/// Loads a cooked texture, if it exists and is up to date with it's sources. Passing a DDS file as the
+	/// source and cooked path will load it directly
+	/// </summary>
+	/// <param name="sources">The source images that the texture was cooked from</param>
+	/// <param name="cookedPath">The path to the cooked texture</param>
+	/// <param name="result">The image to load into</param>
+	/// <returns>True if the cooked texture was loaded</returns>
+	static bool LoadCooked(const std::vector<std::string>& sources, const std::string& cookedPath, DdsImage& result);
+
+	/// <summary>
+	/// Returns true if the given path is a DDS file, and should be loaded as-is instead of through STBI
+	/// </summary>
+	static bool IsDdsFile(const std::string& path);
+
+	/// <summary>
+	/// Encodes a 4x4 block of texels to BC1, ignoring alpha
+	/// </summary>
+	/// <param name="texels">The texels in the block, row by row</param>
+	/// <param name="output">The 8 bytes to write the block to</param>
+	static void EncodeBC1Block(const glm::u8vec4 texels[16], uint8_t* output);
+	/// <summary>
+	/// Encodes a 4x4 block of single channel values to BC4, this is also how BC3 stores alpha
+	/// </summary>
+	/// <param name="values">The values in the block, row by row</param>
+	/// <param name="output">The 8 bytes to write the block to</param>
+	static void EncodeBC4Block(const uint8_t values[16], uint8_t* output);
+
+protected:
+	TextureCooker() = default;
+
+	// An 8 bit RGBA image that has been loaded from disk
+	struct SourceImage {
+		uint32_t                 Width = 0;
+		uint32_t                 Height = 0;
+		std::vector<glm::u8vec4> Texels;
+	};
+
+	static bool __LoadSource(const std::string& path, SourceImage& result);
+	// Picks the final format based on the settings and the contents of the layers
+	static InternalFormat __ResolveFormat(const TextureCookSettings& settings, const std::vector<SourceImage>& layers);
+	// Builds the mip chain for a single layer and encodes every level of it into the image
+	static void __CookLayer(const SourceImage& source, const TextureCookSettings& settings, DdsImage& image, uint32_t layer);
+	// Encodes a single mip level into the given format
+	static void __EncodeLevel(const glm::u8vec4* texels, uint32_t width, uint32_t height, InternalFormat format, uint8_t* output);
+	// Encodes the layers into a DDS file and writes it out
+	static bool __Write(const std::vector<SourceImage>& layers, const TextureCookSettings& settings, bool isCubemap, const std::string& outputPath);
+};
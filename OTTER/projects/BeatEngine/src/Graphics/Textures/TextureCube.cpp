@@ -2,10 +2,13 @@
 #include <filesystem>
 #include "stb_image.h"
 #include "Utils/JsonGlmHelpers.h"
+#include "Graphics/Textures/TextureCooker.h"
+#include "Utils/ResourceManager/ResourceManager.h"
 
 TextureCube::TextureCube(const std::string& baseFilename) :
 	ITexture(TextureType::Cubemap),
-	_description(TextureCubeDescription())
+	_description(TextureCubeDescription()),
+	_cookedLevels(0)
 {
 	_description.Filename = baseFilename;
 	_LoadFromDescription();
@@ -13,7 +16,8 @@ TextureCube::TextureCube(const std::string& baseFilename) :
 
 TextureCube::TextureCube(const std::unordered_map<CubeMapFace, std::string>& faceFilenames) :
 	ITexture(TextureType::Cubemap),
-	_description(TextureCubeDescription())
+	_description(TextureCubeDescription()),
+	_cookedLevels(0)
 {
 	_description.FaceFileNames = faceFilenames;
 	_LoadFromDescription();
@@ -21,7 +25,8 @@ TextureCube::TextureCube(const std::unordered_map<CubeMapFace, std::string>& fac
 
 TextureCube::TextureCube(const TextureCubeDescription& description) :
 	ITexture(TextureType::Cubemap),
-	_description(description)
+	_description(description),
+	_cookedLevels(0)
 {
 	_LoadFromDescription();
 }
@@ -58,11 +63,39 @@ TextureCube::Sptr TextureCube::FromJson(const nlohmann::json& data)
 			}
 		}
 	}
+
+	// If the manifest was loaded from an archive, the cooked cubemap is uploaded straight out of the mapping
+	AssetView archived = ResourceManager::ReadArchived<TextureCube>(data);
+	if (archived.IsValid()) {
+		TextureCube::Sptr result = std::make_shared<TextureCube>(TextureCubeDescription());
+		result->_description = descr;
+
+		DdsImage image;
+		if (DdsImage::LoadFromMemory(archived.Data, archived.Size, image, descr.Filename) && result->_LoadCooked(image)) {
+			return result;
+		}
+		LOG_WARN("Failed to load \"{}\" from archive, falling back to the loose files", descr.Filename);
+	}
+
 	return std::make_shared<TextureCube>(descr);
 }
 
 void TextureCube::_LoadFromDescription()
 {
+	// Nothing to load, the faces will be uploaded after construction (ex: from an archive)
+	if (_description.FaceFileNames.empty() && _description.Filename.empty()) {
+		return;
+	}
+
+	// A cubemap given as a DDS file has all of it's faces in the one file
+	if (_description.FaceFileNames.empty() && TextureCooker::IsDdsFile(_description.Filename)) {
+		DdsImage image;
+		if (!DdsImage::Load(_description.Filename, image) || !_LoadCooked(image)) {
+			LOG_ERROR("Failed to load cubemap from \"{}\"", _description.Filename);
+		}
+		return;
+	}
+
 	// If we weren't passed face filenames but WERE passed a base filename, try and get the 6 face files
 	if (_description.FaceFileNames.empty() && !_description.Filename.empty()) {
 		// Get the file path and it's directory to extract the root file name w/o extension
@@ -88,6 +121,19 @@ void TextureCube::_LoadFromDescription()
 		}
 	}
 
+	// If the faces were cooked and the cooked file is newer than all of them, we can skip decoding them. We check
+	// this before making sure all the faces exist, since a build may only ship the cooked file
+	if (!_description.Filename.empty()) {
+		std::vector<std::string> sources;
+		for (auto& [face, filename] : _description.FaceFileNames) {
+			sources.push_back(filename);
+		}
+		DdsImage cooked;
+		if (TextureCooker::LoadCooked(sources, TextureCooker::GetCookedPath(_description.Filename), cooked) && _LoadCooked(cooked)) {
+			return;
+		}
+	}
+
 	// If we don't have 6 faces for our cube, something has gone horribly wrong (or the files don't exist)
 	if (_description.FaceFileNames.size() != 6) {
 		LOG_ERROR("TextureCube was not given 6 faces, aborting load");
@@ -177,11 +223,47 @@ void TextureCube::_LoadImages(const std::unordered_map<CubeMapFace, std::string>
 	delete[] datastore;
 }
 
+bool TextureCube::_LoadCooked(const DdsImage& image)
+{
+	if (!image.IsCubemap || image.Layers != 6 || image.Width != image.Height) {
+		LOG_WARN("Cooked image for \"{}\" is not a cubemap", _description.Filename);
+		return false;
+	}
+
+	_description.Size = image.Width;
+	_description.Format = image.Format;
+	PixelFormat uploadFormat = image.GetUploadFormat();
+	_description.FormatHint = uploadFormat == PixelFormat::Unknown ? PixelFormat::RGBA : uploadFormat;
+	_cookedLevels = image.Levels;
+
+	// Allocate memory and set up initial parameters
+	_SetTextureParams();
+
+	// The faces are stored as layers, in the same order as CubeMapFace
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (uint32_t face = 0; face < 6; face++) {
+		for (uint32_t level = 0; level < image.Levels; level++) {
+			if (uploadFormat == PixelFormat::Unknown) {
+				glCompressedTextureSubImage3D(_rendererId, level, 0, 0, face, image.GetLevelWidth(level), image.GetLevelHeight(level), 1,
+					*image.Format, (GLsizei)image.GetLevelSize(level), image.GetLevelData(face, level));
+			} else {
+				glTextureSubImage3D(_rendererId, level, 0, 0, face, image.GetLevelWidth(level), image.GetLevelHeight(level), 1,
+					*uploadFormat, GL_UNSIGNED_BYTE, image.GetLevelData(face, level));
+			}
+		}
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	return true;
+}
+
 void TextureCube::_SetTextureParams(){
 	// Make sure the size is greater than zero and that we have a format specified before trying to set parameters
 	if (_description.Size > 0 && _description.Format != InternalFormat::Unknown) {
+		// Cooked cubemaps come with their mip chain, otherwise we only have the top level
+		int levels = _cookedLevels > 0 ? _cookedLevels : 1;
 		// Allocates the memory for our texture
-		glTextureStorage2D(_rendererId, 1, (GLenum)_description.Format, _description.Size, _description.Size);
+		glTextureStorage2D(_rendererId, levels, (GLenum)_description.Format, _description.Size, _description.Size);
+		_SetGpuMemory(GetImageStorageSize(*_description.Format, _description.Size, _description.Size, levels) * 6);
 
 		// Set up our texture parameters
 		glTextureParameteri(_rendererId, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
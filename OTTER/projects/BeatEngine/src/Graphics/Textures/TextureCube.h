@@ -1,6 +1,7 @@
 #pragma once
 #include <EnumToString.h>
 #include "ITexture.h"
+#include "Graphics/Textures/DdsFile.h"
 
 /*
 0 	GL_TEXTURE_CUBE_MAP_POSITIVE_X
@@ -113,9 +114,16 @@ public:
 
 protected:
 	TextureCubeDescription _description;
+	// The number of mip levels in the cooked image we loaded, or 0 if we loaded the source images
+	uint32_t _cookedLevels;
 
 	virtual void _LoadFromDescription();
 	virtual void _LoadImages(const std::unordered_map<CubeMapFace, std::string>& faceFilenames);
+	/// <summary>
+	/// Loads all 6 faces from a cooked DDS file, with their mip chains already built
+	/// </summary>
+	/// <returns>True if the image could be used, false if it's not a cubemap</returns>
+	bool _LoadCooked(const DdsImage& image);
 
 	/// <summary>
 	/// Allocates our texture's memory and sets sampling / filtering parameters
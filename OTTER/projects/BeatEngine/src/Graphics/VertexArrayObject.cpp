@@ -2,6 +2,7 @@
 #include "Buffers/IndexBuffer.h"
 #include "Buffers/VertexBuffer.h"
 #include "Logging.h"
+#include "Graphics/GpuProfiler.h"
 
 VertexArrayObject::VertexArrayObject() :
 	_indexBuffer(nullptr),
@@ -106,9 +107,11 @@ void VertexArrayObject::Draw(DrawMode mode) {
 	if (_indexBuffer == nullptr) {
 		uint32_t elements = _elementCount == 0 ? _vertexBuffers[0]->Buffer->GetElementCount() : _elementCount;
 		glDrawArrays((GLenum)mode, 0, elements);
+		GpuProfiler::CountDraw(mode, elements);
 	} else {
 		uint32_t elements = _elementCount == 0 ? _indexBuffer->GetElementCount() : _elementCount;
 		glDrawElements((GLenum)mode, elements, (GLenum)_indexBuffer->GetElementType(), nullptr);
+		GpuProfiler::CountDraw(mode, elements);
 	}
 	Unbind();
 }
@@ -119,10 +122,12 @@ void VertexArrayObject::DrawInstanced(uint32_t instanceCount, DrawMode mode /*=
 	if (_indexBuffer == nullptr) {
 		uint32_t elements = _elementCount == 0 ? _vertexBuffers[0]->Buffer->GetElementCount() : _elementCount;
 		glDrawArraysInstanced((GLenum)mode, 0, elements, instanceCount);
+		GpuProfiler::CountDraw(mode, elements, instanceCount);
 	}
 	else {
 		uint32_t elements = _elementCount == 0 ? _indexBuffer->GetElementCount() : _elementCount;
 		glDrawElementsInstanced((GLenum)mode, elements, (GLenum)_indexBuffer->GetElementType(), nullptr, instanceCount);
+		GpuProfiler::CountDraw(mode, elements, instanceCount);
 	}
 	Unbind();
 	
@@ -0,0 +1,104 @@
+#include "Utils/FrameArena.h"
+
+#include <algorithm>
+#include <Logging.h>
+
+#include "Utils/MemoryTracker.h"
+
+std::vector<FrameArena::Block> FrameArena::_blocks;
+size_t                         FrameArena::_offset = 0;
+size_t                         FrameArena::_capacity = 0;
+size_t                         FrameArena::_highWaterMark = 0;
+uint64_t                       FrameArena::_frameIndex = 0;
+uint64_t                       FrameArena::_frameStartHeapAllocations = 0;
+FrameArenaStats                FrameArena::_currentStats;
+FrameArenaStats                FrameArena::_lastFrameStats;
+std::thread::id                FrameArena::_ownerThread;
+
+void FrameArena::Init() {
+	_ownerThread = std::this_thread::get_id();
+	if (_blocks.empty()) {
+		_blocks.reserve(8);
+		_AddBlock(InitialSize);
+	}
+	_frameStartHeapAllocations = MemoryTracker::GetTotalAllocationCount();
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+	LOG_ASSERT(_ownerThread == std::this_thread::get_id(), "The frame arena can only be used from the main thread");
+	LOG_ASSERT((alignment & (alignment - 1)) == 0, "Alignment must be a power of 2");
+
+	if (_blocks.empty()) {
+		_AddBlock(std::max(InitialSize, size + alignment));
+	}
+
+	// Align the next free byte in the current block, and chain on a new block if we don't fit
+	Block* block = &_blocks.back();
+	size_t previous = _offset;
+	size_t start = ((reinterpret_cast<uintptr_t>(block->Data) + _offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - reinterpret_cast<uintptr_t>(block->Data);
+	if (start + size > block->Size) {
+		_AddBlock(std::max(block->Size, size + alignment));
+		_currentStats.Overflowed = true;
+		block = &_blocks.back();
+		previous = 0;
+		start = ((reinterpret_cast<uintptr_t>(block->Data) + alignment - 1) & ~(uintptr_t)(alignment - 1)) - reinterpret_cast<uintptr_t>(block->Data);
+	}
+
+	_offset = start + size;
+	_currentStats.ArenaBytes += _offset - previous;
+	_currentStats.ArenaAllocations++;
+	return block->Data + start;
+}
+
+void FrameArena::EndFrame() {
+	_currentStats.HeapAllocations = MemoryTracker::GetTotalAllocationCount() - _frameStartHeapAllocations;
+	_highWaterMark = std::max(_highWaterMark, _currentStats.ArenaBytes);
+
+	// If we had to chain blocks this frame, replace them with one that would have fit everything
+	if (_blocks.size() > 1) {
+		size_t total = _capacity;
+		for (const Block& block : _blocks) {
+			delete[] block.Data;
+		}
+		_blocks.clear();
+		_capacity = 0;
+		_AddBlock(total);
+	}
+	_offset = 0;
+
+	_lastFrameStats = _currentStats;
+	_currentStats = FrameArenaStats();
+	_frameIndex++;
+
+	// Sampled last so that growing the arena is billed to the frame that needed it
+	_frameStartHeapAllocations = MemoryTracker::GetTotalAllocationCount();
+}
+
+uint64_t FrameArena::GetFrameIndex() {
+	return _frameIndex;
+}
+
+const FrameArenaStats& FrameArena::GetCurrentStats() {
+	return _currentStats;
+}
+
+const FrameArenaStats& FrameArena::GetLastFrameStats() {
+	return _lastFrameStats;
+}
+
+size_t FrameArena::GetCapacity() {
+	return _capacity;
+}
+
+size_t FrameArena::GetHighWaterMark() {
+	return _highWaterMark;
+}
+
+void FrameArena::_AddBlock(size_t minSize) {
+	Block block;
+	block.Size = minSize;
+	block.Data = new uint8_t[minSize];
+	_blocks.push_back(block);
+	_capacity += minSize;
+	_offset = 0;
+}
@@ -0,0 +1,142 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// <summary>
+/// Stats for a single frame's worth of transient allocations
+/// </summary>
+struct FrameArenaStats {
+	// The number of bytes handed out by the arena, including alignment padding
+	size_t   ArenaBytes       = 0;
+	// The number of allocations served by the arena
+	uint64_t ArenaAllocations = 0;
+	// The number of allocations that went through the global heap, only counted when memory tracking is on
+	uint64_t HeapAllocations  = 0;
+	// True if the arena ran out of space and had to chain on another block
+	bool     Overflowed       = false;
+};
+
+/// <summary>
+/// A linear allocator for data that only needs to live until the end of the current frame. Allocating
+/// is a pointer bump, freeing does nothing, and everything is released at once when the application
+/// calls EndFrame at the bottom of the main loop.
+///
+/// When a frame needs more than we have, we chain on another block rather than moving the existing
+/// one, so that pointers handed out earlier in the frame stay valid. At the end of that frame the
+/// blocks are merged into one big enough for the whole frame, so after a few frames of warmup the
+/// arena never touches the heap.
+///
+/// The arena belongs to the main thread, worker threads should keep using the heap
+/// </summary>
+class FrameArena {
+public:
+	// The size of the first block, grown as needed
+	static constexpr size_t InitialSize = 256 * 1024;
+
+	/// <summary>
+	/// Reserves the first block and claims the arena for the calling thread, should be called
+	/// by the main thread right before the main loop starts
+	/// </summary>
+	static void Init();
+
+	/// <summary>
+	/// Allocates a block of memory that is valid until the end of the frame
+	/// </summary>
+	/// <param name="size">The size of the block, in bytes</param>
+	/// <param name="alignment">The alignment of the block, must be a power of 2</param>
+	static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	/// <summary>
+	/// Allocates uninitialized space for an array of elements that is valid until the end of the frame.
+	/// Destructors are never invoked, so this should only be used for trivially destructible types
+	/// </summary>
+	/// <typeparam name="T">The type of element to allocate space for</typeparam>
+	/// <param name="count">The number of elements to allocate space for</param>
+	template <typename T>
+	static T* Allocate(size_t count) {
+		static_assert(std::is_trivially_destructible<T>::value, "Frame allocations are never destroyed, use a FrameVector instead");
+		return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+	}
+
+	/// <summary>
+	/// Releases everything that was allocated this frame and records the frame's stats. Should only
+	/// be invoked by the application once nothing is holding on to frame memory
+	/// </summary>
+	static void EndFrame();
+
+	/// <summary>
+	/// Gets the number of frames that have ended since startup, anything holding on to frame memory
+	/// can compare this to know if it's memory is still valid
+	/// </summary>
+	static uint64_t GetFrameIndex();
+
+	/// <summary>
+	/// Gets the stats for the frame that's currently running, the heap allocation count is updated at EndFrame
+	/// </summary>
+	static const FrameArenaStats& GetCurrentStats();
+	/// <summary>
+	/// Gets the stats for the last frame that was completed
+	/// </summary>
+	static const FrameArenaStats& GetLastFrameStats();
+	/// <summary>
+	/// Gets the total number of bytes reserved by the arena
+	/// </summary>
+	static size_t GetCapacity();
+	/// <summary>
+	/// Gets the most bytes that any single frame has used
+	/// </summary>
+	static size_t GetHighWaterMark();
+
+protected:
+	struct Block {
+		uint8_t* Data;
+		size_t   Size;
+	};
+
+	static std::vector<Block> _blocks;
+	// The offset of the next free byte within the last block
+	static size_t             _offset;
+	static size_t             _capacity;
+	static size_t             _highWaterMark;
+	static uint64_t           _frameIndex;
+	static uint64_t           _frameStartHeapAllocations;
+	static FrameArenaStats    _currentStats;
+	static FrameArenaStats    _lastFrameStats;
+	static std::thread::id    _ownerThread;
+
+	static void _AddBlock(size_t minSize);
+};
+
+/// <summary>
+/// An STL allocator that hands out memory from the FrameArena, letting containers be used for temporaries
+/// without hitting the heap. Deallocation does nothing, so a container using this should be destroyed before
+/// the end of the frame. One that outlives the frame must not be read again, but it's safe to replace or destroy
+/// </summary>
+/// <typeparam name="T">The type of element to allocate</typeparam>
+template <typename T>
+class FrameAllocator {
+public:
+	typedef T value_type;
+
+	FrameAllocator() noexcept = default;
+	template <typename U>
+	FrameAllocator(const FrameAllocator<U>&) noexcept { }
+
+	T* allocate(size_t count) {
+		return static_cast<T*>(FrameArena::Allocate(sizeof(T) * count, alignof(T)));
+	}
+	void deallocate(T*, size_t) noexcept { }
+
+	template <typename U>
+	bool operator ==(const FrameAllocator<U>&) const noexcept { return true; }
+	template <typename U>
+	bool operator !=(const FrameAllocator<U>&) const noexcept { return false; }
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
@@ -14,6 +14,7 @@
 
 #include <GLM/glm.hpp>
 #include "StringUtils.h"
+#include "FrameArena.h"
 
 GLFWwindow* ImGuiHelper::_window = nullptr;
 
@@ -237,7 +238,8 @@ void ImGuiHelper::DrawLinearDepthTexture(const Texture2D::Sptr& image, const glm
 
 	ImDrawList* drawList = ImGui::GetWindowDrawList();
 
-	Data* temp = new Data();
+	// ImGui invokes our callbacks when it renders at the end of this frame, so the data only needs to live that long
+	Data* temp = new (FrameArena::Allocate<Data>(1)) Data();
 	temp->programId = _linearDepthShader->GetHandle();
 	temp->nearFar = glm::vec2(zNear, zFar);
 	temp->dispPos = ImGui::GetWindowViewport()->Pos;
@@ -255,7 +257,6 @@ void ImGuiHelper::DrawLinearDepthTexture(const Texture2D::Sptr& image, const glm
 	drawList->AddCallback([](const ImDrawList* parent_list, const ImDrawCmd* cmd) {
 		Data* data = static_cast<Data*>(cmd->UserCallbackData);
 		glUseProgram(data->restoreProgram);
-		delete cmd->UserCallbackData;
 		}, temp);
 
 	ImGui::PopStyleVar();
@@ -290,7 +291,7 @@ void ImGuiHelper::DrawTextureArraySlice(const Texture2DArray::Sptr& image, uint3
 		if (!ImGui::ItemAdd(bb, 0))
 			return;
 
-		Data* temp = new Data();
+		Data* temp = new (FrameArena::Allocate<Data>(1)) Data();
 		temp->programId = _arraySliceShader->GetHandle();
 		temp->dispPos = ImGui::GetWindowViewport()->Pos;
 		temp->dispSize = ImGui::GetWindowViewport()->Size;
@@ -325,7 +326,6 @@ void ImGuiHelper::DrawTextureArraySlice(const Texture2DArray::Sptr& image, uint3
 			Data* data = static_cast<Data*>(cmd->UserCallbackData);
 			glUseProgram(data->restoreProgram);
 			glBindTextureUnit(1, data->restoreTexId);
-			delete cmd->UserCallbackData;
 			}, temp);
 
 		ImGui::PopStyleVar();
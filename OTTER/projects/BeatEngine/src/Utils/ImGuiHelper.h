@@ -67,7 +67,8 @@ public:
 
 	template <typename T>
 	static bool ResourceDragTarget(std::shared_ptr<T>& resourceOut) {
-		std::string typeName = StringTools::SanitizeClassName(typeid(T).name());
+		// This gets hit every frame for every drop target, so we only build the type name once
+		static const std::string typeName = StringTools::SanitizeClassName(typeid(T).name());
 		bool result = false;
 
 		if (ImGui::BeginDragDropTarget()) {
@@ -0,0 +1,105 @@
+#include "Utils/MappedFile.h"
+#include "Logging.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() :
+	_path(""),
+	_data(nullptr),
+	_size(0)
+	#ifdef _WIN32
+	, _fileHandle(nullptr)
+	, _mappingHandle(nullptr)
+	#endif
+{ }
+
+MappedFile::~MappedFile() {
+	Close();
+}
+
+bool MappedFile::Open(const std::string& path) {
+	Close();
+
+	#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		LOG_WARN("Failed to map \"{}\" ({})", path, GetLastError());
+		CloseHandle(file);
+		return false;
+	}
+
+	void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == nullptr) {
+		LOG_WARN("Failed to map \"{}\" ({})", path, GetLastError());
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	_fileHandle = file;
+	_mappingHandle = mapping;
+	_size = static_cast<size_t>(size.QuadPart);
+	#else
+	int file = open(path.c_str(), O_RDONLY);
+	if (file < 0) {
+		return false;
+	}
+
+	struct stat info;
+	if (fstat(file, &info) != 0 || info.st_size == 0) {
+		close(file);
+		return false;
+	}
+
+	// The mapping keeps the file alive on it's own, so we can close the descriptor right away
+	void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (data == MAP_FAILED) {
+		LOG_WARN("Failed to map \"{}\"", path);
+		return false;
+	}
+	_size = static_cast<size_t>(info.st_size);
+	#endif
+
+	_data = static_cast<const uint8_t*>(data);
+	_path = path;
+	return true;
+}
+
+void MappedFile::Close() {
+	if (_data == nullptr) {
+		return;
+	}
+
+	#ifdef _WIN32
+	UnmapViewOfFile(_data);
+	CloseHandle(_mappingHandle);
+	CloseHandle(_fileHandle);
+	_mappingHandle = nullptr;
+	_fileHandle = nullptr;
+	#else
+	munmap(const_cast<uint8_t*>(_data), _size);
+	#endif
+
+	_data = nullptr;
+	_size = 0;
+	_path = "";
+}
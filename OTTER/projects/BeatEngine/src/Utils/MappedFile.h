@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Utils/Macros.h"
+
+/// <summary>
+/// A read-only view of an entire file, mapped into memory by the OS. Pages are only read from disk as they
+/// are touched, and there's no copy into our own buffers, so loaders can parse straight out of the mapping
+/// </summary>
+class MappedFile {
+public:
+	MAKE_PTRS(MappedFile);
+	NO_COPY(MappedFile);
+	NO_MOVE(MappedFile);
+
+	MappedFile();
+	~MappedFile();
+
+	/// <summary>
+	/// Maps the given file, closing any file that was already open
+	/// </summary>
+	/// <param name="path">The path of the file to map</param>
+	/// <returns>True if the file was mapped, false if it's missing or couldn't be mapped</returns>
+	bool Open(const std::string& path);
+	/// <summary>
+	/// Unmaps the file, any pointers into it will be invalid after this
+	/// </summary>
+	void Close();
+
+	/// <summary>
+	/// Returns true if a file is currently mapped
+	/// </summary>
+	bool IsOpen() const { return _data != nullptr; }
+	/// <summary>
+	/// Gets a pointer to the start of the file, or nullptr if no file is open
+	/// </summary>
+	const uint8_t* GetData() const { return _data; }
+	/// <summary>
+	/// Gets the size of the file, in bytes
+	/// </summary>
+	size_t GetSize() const { return _size; }
+	/// <summary>
+	/// Gets the path of the mapped file
+	/// </summary>
+	const std::string& GetPath() const { return _path; }
+
+protected:
+	std::string    _path;
+	const uint8_t* _data;
+	size_t         _size;
+	#ifdef _WIN32
+	void*          _fileHandle;
+	void*          _mappingHandle;
+	#endif
+};
@@ -0,0 +1,333 @@
+#include "Utils/MemoryTracker.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <LinearMath/btAlignedAllocator.h>
+#include <Logging.h>
+
+std::atomic<int64_t>  MemoryTracker::_liveBytes[MemoryTracker::TagCount];
+std::atomic<int64_t>  MemoryTracker::_liveCount[MemoryTracker::TagCount];
+std::atomic<uint64_t> MemoryTracker::_totalCount[MemoryTracker::TagCount];
+std::atomic<int64_t>  MemoryTracker::_generationBytes[MemoryTracker::GenerationSlots];
+std::atomic<int64_t>  MemoryTracker::_generationCount[MemoryTracker::GenerationSlots];
+std::atomic<uint32_t> MemoryTracker::_generation(0);
+std::vector<SceneLeakReport> MemoryTracker::_leakReports;
+
+// The tag that allocations on this thread are attributed to. This needs to stay a plain enum so that
+// it's constant initialized, since operator new can be called before any of our statics are set up
+static thread_local MemoryTag CurrentTag = MemoryTag::General;
+
+// Heap memory from these tags belongs to a scene, and shouldn't outlive it
+static bool IsSceneOwned(MemoryTag tag) {
+	return tag == MemoryTag::Scene || tag == MemoryTag::Components || tag == MemoryTag::Physics;
+}
+
+/// <summary>
+/// Does the actual bookkeeping for the allocator hooks below. Every tracked block has a small header
+/// in front of it, so that we know how big it was and who to credit when it's freed
+/// </summary>
+struct MemoryTrackerAccess {
+	struct Header {
+		size_t    Size;
+		uint32_t  Generation;
+		MemoryTag Tag;
+	};
+	// Keeps the block after the header aligned the same way malloc would have aligned it
+	static constexpr size_t HeaderSize = 16;
+	static_assert(sizeof(Header) <= HeaderSize, "Allocation header doesn't fit in it's padding");
+
+	static void* Allocate(size_t size, MemoryTag tag) {
+		void* block = std::malloc(size + HeaderSize);
+		if (block == nullptr) {
+			return nullptr;
+		}
+
+		Header* header = reinterpret_cast<Header*>(block);
+		header->Size = size;
+		header->Tag = tag;
+		header->Generation = MemoryTracker::_generation.load(std::memory_order_relaxed);
+
+		size_t index = *tag;
+		MemoryTracker::_liveBytes[index].fetch_add(size, std::memory_order_relaxed);
+		MemoryTracker::_liveCount[index].fetch_add(1, std::memory_order_relaxed);
+		MemoryTracker::_totalCount[index].fetch_add(1, std::memory_order_relaxed);
+		if (IsSceneOwned(tag)) {
+			size_t slot = header->Generation % MemoryTracker::GenerationSlots;
+			MemoryTracker::_generationBytes[slot].fetch_add(size, std::memory_order_relaxed);
+			MemoryTracker::_generationCount[slot].fetch_add(1, std::memory_order_relaxed);
+		}
+
+		return reinterpret_cast<uint8_t*>(block) + HeaderSize;
+	}
+
+	static void Free(void* ptr) {
+		if (ptr == nullptr) {
+			return;
+		}
+
+		Header* header = reinterpret_cast<Header*>(reinterpret_cast<uint8_t*>(ptr) - HeaderSize);
+		size_t index = *header->Tag;
+		MemoryTracker::_liveBytes[index].fetch_sub(header->Size, std::memory_order_relaxed);
+		MemoryTracker::_liveCount[index].fetch_sub(1, std::memory_order_relaxed);
+		if (IsSceneOwned(header->Tag)) {
+			size_t slot = header->Generation % MemoryTracker::GenerationSlots;
+			MemoryTracker::_generationBytes[slot].fetch_sub(header->Size, std::memory_order_relaxed);
+			MemoryTracker::_generationCount[slot].fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		std::free(header);
+	}
+
+	// Bullet allocates everything through these once they're installed, so it's always credited to physics
+	static void* BulletAlloc(size_t size) {
+		return Allocate(size, MemoryTag::Physics);
+	}
+
+	static void BulletFree(void* ptr) {
+		Free(ptr);
+	}
+};
+
+#if ENABLE_MEMORY_TRACKING
+// Replacing the global allocation functions routes every new and delete in the game through
+// the tracker. The array, sized and nothrow forms all need replacing as well, since they are
+// not guaranteed to forward to the basic forms on every standard library
+
+void* operator new(std::size_t size) {
+	void* result = MemoryTrackerAccess::Allocate(size, CurrentTag);
+	if (result == nullptr) {
+		throw std::bad_alloc();
+	}
+	return result;
+}
+
+void* operator new[](std::size_t size) {
+	void* result = MemoryTrackerAccess::Allocate(size, CurrentTag);
+	if (result == nullptr) {
+		throw std::bad_alloc();
+	}
+	return result;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	return MemoryTrackerAccess::Allocate(size, CurrentTag);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	return MemoryTrackerAccess::Allocate(size, CurrentTag);
+}
+
+void operator delete(void* ptr) noexcept {
+	MemoryTrackerAccess::Free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	MemoryTrackerAccess::Free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	MemoryTrackerAccess::Free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+	MemoryTrackerAccess::Free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+	MemoryTrackerAccess::Free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+	MemoryTrackerAccess::Free(ptr);
+}
+#endif
+
+void MemoryTracker::Init() {
+	#if ENABLE_MEMORY_TRACKING
+	btAlignedAllocSetCustom(&MemoryTrackerAccess::BulletAlloc, &MemoryTrackerAccess::BulletFree);
+	#endif
+}
+
+MemoryTagStats MemoryTracker::GetTagStats(MemoryTag tag) {
+	MemoryTagStats result;
+	result.LiveBytes  = _liveBytes[*tag].load(std::memory_order_relaxed);
+	result.LiveCount  = _liveCount[*tag].load(std::memory_order_relaxed);
+	result.TotalCount = _totalCount[*tag].load(std::memory_order_relaxed);
+	return result;
+}
+
+uint64_t MemoryTracker::GetTotalAllocationCount() {
+	uint64_t result = 0;
+	for (size_t ix = 0; ix < TagCount; ix++) {
+		result += _totalCount[ix].load(std::memory_order_relaxed);
+	}
+	return result;
+}
+
+MemoryTag MemoryTracker::GetCurrentTag() {
+	return CurrentTag;
+}
+
+MemoryTag MemoryTracker::_PushTag(MemoryTag tag) {
+	MemoryTag previous = CurrentTag;
+	CurrentTag = tag;
+	return previous;
+}
+
+void MemoryTracker::_PopTag(MemoryTag previous) {
+	CurrentTag = previous;
+}
+
+MemoryTracker::GpuRegistry& MemoryTracker::_GetGpuRegistry() {
+	// This is never destroyed, since graphics resources held in statics can be released after our statics are torn down
+	static GpuRegistry* registry = new GpuRegistry();
+	return *registry;
+}
+
+void MemoryTracker::SetGpuAllocation(const void* key, const std::string& type, const std::string& owner, size_t bytes) {
+	GpuRegistry& registry = _GetGpuRegistry();
+	std::lock_guard<std::mutex> lock(registry.Lock);
+	auto it = registry.Allocations.find(key);
+	if (it == registry.Allocations.end()) {
+		// The tag and generation are taken when the memory is first allocated, so resizes don't move it to another scene
+		GpuAllocation allocation;
+		allocation.Key        = key;
+		allocation.Bytes      = 0;
+		allocation.Tag        = CurrentTag;
+		allocation.Generation = _generation.load(std::memory_order_relaxed);
+		it = registry.Allocations.emplace(key, allocation).first;
+	}
+
+	registry.Total += (int64_t)bytes - (int64_t)it->second.Bytes;
+	it->second.Type  = type;
+	it->second.Owner = owner;
+	it->second.Bytes = bytes;
+
+	// Only warn once per trip over the budget, otherwise resizing a window would spam the log
+	if (registry.Budget > 0 && registry.Total > registry.Budget) {
+		if (!registry.OverBudget) {
+			LOG_WARN("Tracked GPU memory ({:.1f} MB) is over budget ({:.1f} MB), allocating {} for \"{}\"",
+				registry.Total / (1024.0f * 1024.0f), registry.Budget / (1024.0f * 1024.0f), type, owner);
+			registry.OverBudget = true;
+		}
+	} else {
+		registry.OverBudget = false;
+	}
+}
+
+void MemoryTracker::SetGpuAllocationOwner(const void* key, const std::string& owner) {
+	GpuRegistry& registry = _GetGpuRegistry();
+	std::lock_guard<std::mutex> lock(registry.Lock);
+	auto it = registry.Allocations.find(key);
+	if (it != registry.Allocations.end()) {
+		it->second.Owner = owner;
+	}
+}
+
+void MemoryTracker::ReleaseGpuAllocation(const void* key) {
+	GpuRegistry& registry = _GetGpuRegistry();
+	std::lock_guard<std::mutex> lock(registry.Lock);
+	auto it = registry.Allocations.find(key);
+	if (it != registry.Allocations.end()) {
+		registry.Total -= (int64_t)it->second.Bytes;
+		registry.Allocations.erase(it);
+	}
+}
+
+void MemoryTracker::GetGpuAllocations(std::vector<GpuAllocation>& outAllocations) {
+	GpuRegistry& registry = _GetGpuRegistry();
+	std::lock_guard<std::mutex> lock(registry.Lock);
+	outAllocations.clear();
+	outAllocations.reserve(registry.Allocations.size());
+	for (const auto& [key, allocation] : registry.Allocations) {
+		outAllocations.push_back(allocation);
+	}
+}
+
+int64_t MemoryTracker::GetGpuTotal() {
+	GpuRegistry& registry = _GetGpuRegistry();
+	std::lock_guard<std::mutex> lock(registry.Lock);
+	return registry.Total;
+}
+
+int64_t MemoryTracker::GetGpuBudget() {
+	GpuRegistry& registry = _GetGpuRegistry();
+	std::lock_guard<std::mutex> lock(registry.Lock);
+	return registry.Budget;
+}
+
+void MemoryTracker::SetGpuBudget(int64_t bytes) {
+	GpuRegistry& registry = _GetGpuRegistry();
+	std::lock_guard<std::mutex> lock(registry.Lock);
+	registry.Budget = std::max<int64_t>(bytes, 0);
+	registry.OverBudget = false;
+}
+
+uint32_t MemoryTracker::BeginSceneGeneration() {
+	uint32_t generation = _generation.fetch_add(1, std::memory_order_relaxed) + 1;
+
+	// The slot we're about to reuse may still have counts from a generation that wrapped around
+	// a long time ago, anything in there has been reported already so we start it fresh
+	_generationBytes[generation % GenerationSlots].store(0, std::memory_order_relaxed);
+	_generationCount[generation % GenerationSlots].store(0, std::memory_order_relaxed);
+	return generation;
+}
+
+uint32_t MemoryTracker::GetGeneration() {
+	return _generation.load(std::memory_order_relaxed);
+}
+
+bool MemoryTracker::CheckSceneUnload(const std::string& sceneName, uint32_t generation, bool sceneReleased) {
+	SceneLeakReport report;
+	report.Scene         = sceneName;
+	report.Generation    = generation;
+	report.SceneReleased = sceneReleased;
+	report.CpuBytes      = 0;
+	report.CpuCount      = 0;
+
+	// Slots are only trustworthy while the generation hasn't been wrapped over
+	if (GetGeneration() - generation < GenerationSlots) {
+		report.CpuBytes = _generationBytes[generation % GenerationSlots].load(std::memory_order_relaxed);
+		report.CpuCount = _generationCount[generation % GenerationSlots].load(std::memory_order_relaxed);
+	}
+
+	{
+		GpuRegistry& registry = _GetGpuRegistry();
+		std::lock_guard<std::mutex> lock(registry.Lock);
+		for (const auto& [key, allocation] : registry.Allocations) {
+			if (allocation.Generation == generation && allocation.Tag != MemoryTag::Resources && allocation.Tag != MemoryTag::Application) {
+				report.GpuAllocations.push_back(allocation);
+			}
+		}
+	}
+
+	if (sceneReleased && report.CpuCount <= 0 && report.GpuAllocations.empty()) {
+		return true;
+	}
+
+	size_t gpuBytes = 0;
+	for (const auto& allocation : report.GpuAllocations) {
+		gpuBytes += allocation.Bytes;
+	}
+	LOG_WARN("Scene \"{}\" left memory behind after unloading: {} heap blocks ({} bytes), {} GPU allocations ({} bytes){}",
+		sceneName, report.CpuCount, report.CpuBytes, report.GpuAllocations.size(), gpuBytes,
+		sceneReleased ? "" : ", and the scene itself is still referenced");
+
+	std::sort(report.GpuAllocations.begin(), report.GpuAllocations.end(), [](const GpuAllocation& a, const GpuAllocation& b) {
+		return a.Bytes > b.Bytes;
+	});
+	_leakReports.push_back(std::move(report));
+	if (_leakReports.size() > MaxLeakReports) {
+		_leakReports.erase(_leakReports.begin());
+	}
+	return false;
+}
+
+const std::vector<SceneLeakReport>& MemoryTracker::GetLeakReports() {
+	return _leakReports;
+}
+
+void MemoryTracker::ClearLeakReports() {
+	_leakReports.clear();
+}
@@ -0,0 +1,222 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <EnumToString.h>
+
+#include "Utils/Macros.h"
+#include "Utils/Profiler.h"
+
+// Set ENABLE_MEMORY_TRACKING to 0 in the build config to stop replacing the global allocator, Release builds
+// do this in Premake5.lua. GPU allocations are still tracked when this is off, since they're only registered on creation
+#ifndef ENABLE_MEMORY_TRACKING
+#define ENABLE_MEMORY_TRACKING 1
+#endif
+
+#if ENABLE_MEMORY_TRACKING
+// Attributes the heap allocations made on this thread until the end of the enclosing scope to the given tag
+#define MEMORY_TAG(tag) ::MemoryTagScope PROFILE_CONCAT(__memoryTag, __LINE__)(tag)
+#else
+#define MEMORY_TAG(tag)
+#endif
+
+/// <summary>
+/// The subsystems that we break memory usage down by. Allocations made outside of
+/// any tagged scope are counted as General. Resources and Application allocations are
+/// expected to live for as long as the app does, the rest belong to the current scene
+/// </summary>
+ENUM(MemoryTag, uint8_t,
+	General     = 0,
+	Scene       = 1,
+	Components  = 2,
+	Resources   = 3,
+	Physics     = 4,
+	Application = 5
+);
+
+/// <summary>
+/// The live and lifetime allocation counters for a single tag
+/// </summary>
+struct MemoryTagStats {
+	int64_t  LiveBytes   = 0;
+	int64_t  LiveCount   = 0;
+	uint64_t TotalCount  = 0;
+};
+
+/// <summary>
+/// A single block of GPU memory as reported by a graphics resource or component
+/// </summary>
+struct GpuAllocation {
+	const void* Key;
+	std::string Type;
+	std::string Owner;
+	size_t      Bytes;
+	MemoryTag   Tag;
+	uint32_t    Generation;
+};
+
+/// <summary>
+/// What was left behind when a scene was unloaded
+/// </summary>
+struct SceneLeakReport {
+	std::string                Scene;
+	uint32_t                   Generation;
+	// False if something still held a reference to the scene after it was unloaded
+	bool                       SceneReleased;
+	// Heap memory from the scene, component and physics tags that outlived the scene
+	int64_t                    CpuBytes;
+	int64_t                    CpuCount;
+	std::vector<GpuAllocation> GpuAllocations;
+};
+
+/// <summary>
+/// Keeps track of where our memory is going. CPU allocations are counted by replacing the global
+/// operator new and Bullet's allocator, and attributed to whichever MemoryTag is active on the
+/// allocating thread. GPU memory is reported by the graphics resources themselves as they allocate
+/// storage, since OpenGL doesn't give us a portable way of asking.
+///
+/// Every allocation is stamped with the current scene generation, which is bumped whenever a
+/// scene starts loading, so we can find anything a scene left behind once it's been unloaded
+/// </summary>
+class MemoryTracker {
+public:
+	// The number of scene generations we keep live counters for, older generations wrap around
+	static constexpr uint32_t GenerationSlots = 64;
+	// The number of leak reports we hold on to for the debug window
+	static constexpr size_t MaxLeakReports = 8;
+
+	/// <summary>
+	/// Hooks Bullet's allocator, should be called before any physics objects are created
+	/// </summary>
+	static void Init();
+
+	/// <summary>
+	/// Returns true if the global allocator has been replaced, if false only GPU memory is tracked
+	/// </summary>
+	static constexpr bool IsCpuTrackingEnabled() { return ENABLE_MEMORY_TRACKING != 0; }
+
+	/// <summary>
+	/// Gets the counters for a single tag
+	/// </summary>
+	static MemoryTagStats GetTagStats(MemoryTag tag);
+	/// <summary>
+	/// Gets the number of heap allocations made across all tags since startup, sample this at the
+	/// start and end of a frame to find out how many allocations the frame made
+	/// </summary>
+	static uint64_t GetTotalAllocationCount();
+
+	/// <summary>
+	/// Gets the tag that allocations on the calling thread are currently attributed to
+	/// </summary>
+	static MemoryTag GetCurrentTag();
+
+	/// <summary>
+	/// Registers or updates a block of GPU memory. Keys are usually the owning object's address
+	/// </summary>
+	/// <param name="key">A unique key for the allocation, used to update or release it later</param>
+	/// <param name="type">The type of resource holding the memory (ex: Texture2D)</param>
+	/// <param name="owner">The name of whatever owns the memory, for display</param>
+	/// <param name="bytes">The size of the allocation, in bytes</param>
+	static void SetGpuAllocation(const void* key, const std::string& type, const std::string& owner, size_t bytes);
+	/// <summary>
+	/// Updates the owner name of a GPU allocation, does nothing if the key isn't registered
+	/// </summary>
+	static void SetGpuAllocationOwner(const void* key, const std::string& owner);
+	/// <summary>
+	/// Removes a block of GPU memory, does nothing if the key isn't registered
+	/// </summary>
+	static void ReleaseGpuAllocation(const void* key);
+
+	/// <summary>
+	/// Takes a copy of all the GPU allocations that are currently alive
+	/// </summary>
+	static void GetGpuAllocations(std::vector<GpuAllocation>& outAllocations);
+	/// <summary>
+	/// Gets the total size of all live GPU allocations, in bytes
+	/// </summary>
+	static int64_t GetGpuTotal();
+
+	/// <summary>
+	/// Gets or sets the GPU memory budget in bytes, a warning is logged the first time the tracked
+	/// GPU memory goes over it. Zero disables the budget
+	/// </summary>
+	static int64_t GetGpuBudget();
+	static void SetGpuBudget(int64_t bytes);
+
+	/// <summary>
+	/// Starts a new scene generation, anything allocated from here on belongs to the next scene
+	/// </summary>
+	/// <returns>The new generation</returns>
+	static uint32_t BeginSceneGeneration();
+	/// <summary>
+	/// Gets the current scene generation
+	/// </summary>
+	static uint32_t GetGeneration();
+	/// <summary>
+	/// Checks for anything from the given generation that is still alive, and logs and stores a report
+	/// if anything is found. Allocations tagged as Resources or Application are expected to outlive
+	/// scenes, so they're never reported
+	/// </summary>
+	/// <param name="sceneName">The name of the scene that was unloaded, for display</param>
+	/// <param name="generation">The generation the scene was loaded in</param>
+	/// <param name="sceneReleased">Whether the scene object itself was destroyed</param>
+	/// <returns>True if nothing was left behind</returns>
+	static bool CheckSceneUnload(const std::string& sceneName, uint32_t generation, bool sceneReleased);
+	/// <summary>
+	/// Gets the most recent leak reports, oldest first
+	/// </summary>
+	static const std::vector<SceneLeakReport>& GetLeakReports();
+	static void ClearLeakReports();
+
+protected:
+	friend class MemoryTagScope;
+	friend struct MemoryTrackerAccess;
+
+	static constexpr size_t TagCount = 6;
+
+	static std::atomic<int64_t>  _liveBytes[TagCount];
+	static std::atomic<int64_t>  _liveCount[TagCount];
+	static std::atomic<uint64_t> _totalCount[TagCount];
+	static std::atomic<int64_t>  _generationBytes[GenerationSlots];
+	static std::atomic<int64_t>  _generationCount[GenerationSlots];
+	static std::atomic<uint32_t> _generation;
+
+	struct GpuRegistry {
+		std::mutex Lock;
+		std::unordered_map<const void*, GpuAllocation> Allocations;
+		int64_t Total      = 0;
+		int64_t Budget     = 0;
+		bool    OverBudget = false;
+	};
+
+	static std::vector<SceneLeakReport> _leakReports;
+
+	static GpuRegistry& _GetGpuRegistry();
+
+	static MemoryTag _PushTag(MemoryTag tag);
+	static void _PopTag(MemoryTag previous);
+};
+
+/// <summary>
+/// Attributes allocations on the current thread to a tag for the lifetime of this object.
+/// Use the MEMORY_TAG macro instead of creating these directly so they can be compiled out
+/// </summary>
+class MemoryTagScope {
+public:
+	NO_COPY(MemoryTagScope);
+	NO_MOVE(MemoryTagScope);
+
+	inline MemoryTagScope(MemoryTag tag) :
+		_previous(MemoryTracker::_PushTag(tag))
+	{ }
+
+	inline ~MemoryTagScope() {
+		MemoryTracker::_PopTag(_previous);
+	}
+
+private:
+	MemoryTag _previous;
+};
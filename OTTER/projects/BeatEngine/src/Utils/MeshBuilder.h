@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <vector>
 #include "Graphics/VertexArrayObject.h"
 
@@ -35,7 +36,7 @@ public:
 	uint32_t AddVertexRange(const VertType* data, uint32_t count) {
 		uint32_t index = static_cast<uint32_t>(_vertices.size());
 		// Reserve space for the incoming vertices, ensures the underlying datastore will be large enough
-		_vertices.reserve(_vertices.size() + count);
+		ReserveVertexSpace(count);
 		// Copy data into the container, this will also update the container's size!
 		std::copy(data, data + count, std::back_inserter(_vertices));
 		// Return the index of the start of the range
@@ -90,7 +91,7 @@ public:
 	/// </summary>
 	/// <param name="extendAmount">The number of vertices to reserve space for</param>
 	void ReserveVertexSpace(size_t extendAmount) {
-		_vertices.reserve(_vertices.size() + extendAmount);
+		_Reserve(_vertices, extendAmount);
 	}
 	/// <summary>
 	/// Resizes the internal vector to allocate space for new indices, can improve
@@ -98,7 +99,7 @@ public:
 	/// </summary>
 	/// <param name="extendAmount">The number of indices to reserve space for</param>
 	void ReserveIndexSpace(size_t extendAmount) {
-		_indices.reserve(_indices.size() + extendAmount);
+		_Reserve(_indices, extendAmount);
 	}
 
 	/// <summary>
@@ -169,4 +170,13 @@ protected:
 	
 	std::vector<VertType> _vertices;
 	std::vector<uint32_t> _indices;
+
+	// Reserving exactly what we need would make every small append reallocate, so we still grow geometrically
+	template <typename List>
+	static void _Reserve(List& list, size_t extendAmount) {
+		size_t required = list.size() + extendAmount;
+		if (required > list.capacity()) {
+			list.reserve(std::max(required, list.capacity() * 2));
+		}
+	}
 };
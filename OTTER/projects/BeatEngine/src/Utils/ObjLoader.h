@@ -15,8 +15,14 @@
 class ObjLoader
 {
 public:
+	/// <summary>
+	/// Loads a VAO from an OBJ file
+	/// </summary>
+	/// <param name="filename">The path to the OBJ file to load</param>
+	/// <param name="calcTangents">True if tangents and bitangents should be generated for the mesh</param>
+	/// <param name="outPositions">If not null, will receive a CPU copy of the OBJ's vertex positions (ex: for generating colliders)</param>
 	template <typename VertexType = VertexPosNormTexColTangents>
-	static VertexArrayObject::Sptr LoadFromFile(const std::string& filename, bool calcTangents = true);
+	static VertexArrayObject::Sptr LoadFromFile(const std::string& filename, bool calcTangents = true, std::vector<glm::vec3>* outPositions = nullptr);
 
 protected:
 	ObjLoader() = default;
@@ -25,7 +31,7 @@ protected:
 
 
 template <typename VertexType>
-VertexArrayObject::Sptr ObjLoader::LoadFromFile(const std::string& filename, bool calcTangents) {
+VertexArrayObject::Sptr ObjLoader::LoadFromFile(const std::string& filename, bool calcTangents, std::vector<glm::vec3>* outPositions) {
 	// Open our file in binary mode
 	std::ifstream file;
 	file.open(filename, std::ios::binary);
@@ -187,6 +193,11 @@ VertexArrayObject::Sptr ObjLoader::LoadFromFile(const std::string& filename, boo
 	float endTime = static_cast<float>(glfwGetTime());
 	LOG_TRACE("Loaded OBJ file \"{}\" in {} seconds ({} vertices, {} indices)", filename, endTime - startTime, mesh.GetVertexCount(), mesh.GetIndexCount());
 
+	// Hand the positions back to the caller while we still have them on the CPU
+	if (outPositions != nullptr) {
+		*outPositions = std::move(positions);
+	}
+
 	// Move our data into a VAO and return it
 	return mesh.Bake();
 }
\ No newline at end of file
@@ -7,17 +7,20 @@
 #include <fstream>
 #include <iostream>
 #include <filesystem>
+#include <cstring>
 
 #include "Utils/StringUtils.h"
+#include "Utils/MappedFile.h"
 #include "GLFW/glfw3.h"
 #include "Logging.h"
+#include "Gameplay/Physics/CollisionShapeCache.h"
 
 const char HEADER_BYTES[4] = { 'B', 'O', 'B', 'J' };
 const std::string binaryExtension = ".bin";
 
 namespace fs = std::filesystem;
 
-VertexArrayObject::Sptr OptimizedObjLoader::LoadFromFile(const std::string& filename) {
+VertexArrayObject::Sptr OptimizedObjLoader::LoadFromFile(const std::string& filename, std::vector<glm::vec3>* outHull) {
 	// Get the file extension and lowercase it
 	fs::path filePath = std::filesystem::path(filename);
 	std::string extension = filePath.extension().string();
@@ -27,16 +30,16 @@ VertexArrayObject::Sptr OptimizedObjLoader::LoadFromFile(const std::string& file
 	if (extension == ".obj") {
 		// Get the binary path
 		fs::path binPath = filePath.replace_extension(binaryExtension);
-		// If the file does not exist, convert the OBJ file to a binary file
-		if (!fs::exists(binPath)) {
+		// If the file does not exist or is from an older version, convert the OBJ file to a binary file
+		if (!fs::exists(binPath) || _GetBinFileVersion(binPath.string()) < CurrentVersion) {
 			ConvertToBinary(filename, binPath.string());
 		}
 		// Load the corresponding binary file
-		return _LoadFromBinFile(binPath.string());
+		return _LoadFromBinFile(binPath.string(), outHull);
 	} 
 	// Load our fancy binary files
 	else if (extension == ".bin") {
-		return _LoadFromBinFile(filename);
+		return _LoadFromBinFile(filename, outHull);
 	}
 	// We've never met this extension in our life
 	else {
@@ -62,8 +65,16 @@ void OptimizedObjLoader::ConvertToBinary(const std::string& inFile, const std::s
 		outFileName = path.string();
 	}
 
+	// Bake a simplified convex hull for colliders, so we never need to do this at runtime
+	std::vector<glm::vec3> positions;
+	positions.reserve(mesh->GetVertexCount());
+	for (size_t ix = 0; ix < mesh->GetVertexCount(); ix++) {
+		positions.push_back(mesh->GetVertexDataPtr()[ix].Position);
+	}
+	std::vector<glm::vec3> hull = Gameplay::Physics::CollisionShapeCache::BakeConvexHull(positions.data(), positions.size());
+
 	// Save the mesh to the file
-	SaveBinaryFile(*mesh, outFileName);
+	SaveBinaryFile(*mesh, outFileName, hull);
 
 	float endTime = static_cast<float>(glfwGetTime());
 	LOG_TRACE("Converted OBJ file to binary \"{}\" in {} seconds ({} vertices, {} indices)", inFile, endTime - startTime, mesh->GetVertexCount(), mesh->GetIndexCount());
@@ -233,33 +244,43 @@ MeshBuilder<VertexPosNormTexColTangents>* OptimizedObjLoader::_LoadFromObjFile(c
 	return mesh;
 }
 
-VertexArrayObject::Sptr OptimizedObjLoader::_LoadFromBinFile(const std::string& filename) {
-
-	// Open the output file
+uint16_t OptimizedObjLoader::_GetBinFileVersion(const std::string& filename) {
 	std::ifstream file(filename, std::ios::binary);
+	BinaryHeader header = BinaryHeader();
+	if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(BinaryHeader))) {
+		return 0;
+	}
+	return memcmp(header.HeaderBytes, HEADER_BYTES, 4) == 0 ? header.Version : 0;
+}
+
+VertexArrayObject::Sptr OptimizedObjLoader::_LoadFromBinFile(const std::string& filename, std::vector<glm::vec3>* outHull) {
+
+	// Map the file, so we can hand it's contents to OpenGL without reading it into our own buffers first
+	MappedFile file;
 	// If our file fails to open, we will throw an error
-	if (!file) { throw std::runtime_error("Failed to open file"); }
+	if (!file.Open(filename)) { throw std::runtime_error("Failed to open file"); }
 
-	float startTime = static_cast<float>(glfwGetTime());
+	return LoadFromMemory(file.GetData(), file.GetSize(), outHull, filename);
+}
 
-	// Get the file size so we can avoid reading past the end
-	file.seekg(0, std::ios::end);
-	size_t size = file.tellg();
-	file.seekg(0, std::ios::beg);
+VertexArrayObject::Sptr OptimizedObjLoader::LoadFromMemory(const uint8_t* data, size_t size, std::vector<glm::vec3>* outHull, const std::string& name) {
+	float startTime = static_cast<float>(glfwGetTime());
 
-	// Read the header from the file
+	// Read the header from the data
 	BinaryHeader header = BinaryHeader();
 	if (size >= sizeof(BinaryHeader)) {
-		file.read(reinterpret_cast<char*>(&header), sizeof(BinaryHeader));
+		memcpy(&header, data, sizeof(BinaryHeader));
 	} else {
 		LOG_ERROR("Not enough data in the file!");
 		return nullptr;
 	}
+	const uint8_t* seek = data + sizeof(BinaryHeader);
 
 	// TODO: validate header
 
 	// Handle our version
-	if (header.Version == 0x01) {
+	// Version 2 is identical to version 1, with a collision hull appended to the end
+	if (header.Version == 0x01 || header.Version == 0x02) {
 		// Determine how many bytes we need in the file
 		size_t requiredBytes =
 			sizeof(BinaryHeader) +
@@ -276,38 +297,35 @@ VertexArrayObject::Sptr OptimizedObjLoader::_LoadFromBinFile(const std::string&
 		// Read all attributes from the file, this is basically our VDECL
 		std::vector<BufferAttribute> vertexDeclaration;
 		vertexDeclaration.resize(header.NumAttributes);
-		for (int ix = 0; ix < header.NumAttributes; ix++) {
-			file.read(reinterpret_cast<char*>(&vertexDeclaration[ix]), sizeof(BufferAttribute));
-		}
+		memcpy(vertexDeclaration.data(), seek, header.NumAttributes * sizeof(BufferAttribute));
+		seek += header.NumAttributes * sizeof(BufferAttribute);
 
 		// These will have the buffer pointers
 		IndexBuffer::Sptr indices = nullptr;
 		VertexBuffer::Sptr vertices = nullptr;
 
-		// If we have index data, load it
+		// If we have index data, load it straight out of the data we were given
 		if (header.NumIndices > 0) {
-			// Create index buffer
 			indices = IndexBuffer::Create(BufferUsage::StaticDraw);
-
-			// Create memory to store indices, then read from the file
-			void* dataStore = malloc(header.NumIndices * GetIndexTypeSize(header.IndicesType));
-			file.read(reinterpret_cast<char*>(dataStore), header.NumIndices * GetIndexTypeSize(header.IndicesType));
-			
-			// Load data into OpenGL and free the CPU memory we allocated
-			indices->LoadData(dataStore, GetIndexTypeSize(header.IndicesType), header.NumIndices, header.IndicesType);
-			free(dataStore);
+			indices->LoadData(seek, GetIndexTypeSize(header.IndicesType), header.NumIndices, header.IndicesType);
+			seek += header.NumIndices * GetIndexTypeSize(header.IndicesType);
 		}
 
-		// Create a new VBO
+		// Create a new VBO and load the vertices the same way
 		vertices = VertexBuffer::Create(BufferUsage::StaticDraw);
-
-		// Create memory to store vertices and load from file
-		void* vertexStore = malloc(header.NumVertices * (size_t)header.VertexStride);
-		file.read(reinterpret_cast<char*>(vertexStore), header.NumVertices * (size_t)header.VertexStride);
-
-		// Load data into OpenGL and free the CPU copy
-		vertices->LoadData(vertexStore, header.VertexStride, header.NumVertices);
-		free(vertexStore);
+		vertices->LoadData(seek, header.VertexStride, header.NumVertices);
+		seek += header.NumVertices * (size_t)header.VertexStride;
+
+		// Read our baked collision hull if the file has one
+		if (header.Version >= 0x02 && outHull != nullptr && (size_t)(data + size - seek) >= sizeof(uint32_t)) {
+			uint32_t hullSize = 0;
+			memcpy(&hullSize, seek, sizeof(uint32_t));
+			seek += sizeof(uint32_t);
+			if (hullSize > 0 && (size_t)(data + size - seek) >= hullSize * sizeof(glm::vec3)) {
+				outHull->resize(hullSize);
+				memcpy(outHull->data(), seek, hullSize * sizeof(glm::vec3));
+			}
+		}
 
 		// Create the VAO and attach our index and vertex buffers
 		VertexArrayObject::Sptr result = VertexArrayObject::Create();
@@ -319,7 +337,7 @@ VertexArrayObject::Sptr OptimizedObjLoader::_LoadFromBinFile(const std::string&
 
 		// Calculate and trace out how long it took us to load
 		float endTime = static_cast<float>(glfwGetTime());
-		LOG_TRACE("Loaded OBJ file \"{}\" in {} seconds ({} vertices, {} indices)", filename, endTime - startTime, header.NumVertices, header.NumIndices);
+		LOG_TRACE("Loaded OBJ file \"{}\" in {} seconds ({} vertices, {} indices)", name, endTime - startTime, header.NumVertices, header.NumIndices);
 
 		return result;
 	}
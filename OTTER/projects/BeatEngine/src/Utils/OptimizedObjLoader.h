@@ -24,8 +24,19 @@ public:
 	/// to a binary file and load that instead. On subsequent runs, the binary file will be loaded instead
 	/// </summary>
 	/// <param name="filename">The path to the .obj or .bin file to load</param>
+	/// <param name="outHull">If not null, receives the convex collision hull baked into the binary file</param>
 	/// <returns>A VAO loaded from disk</returns>
-	static VertexArrayObject::Sptr LoadFromFile(const std::string& filename);
+	static VertexArrayObject::Sptr LoadFromFile(const std::string& filename, std::vector<glm::vec3>* outHull = nullptr);
+	/// <summary>
+	/// Loads a VAO from the contents of a binary mesh file that are already in memory (ex: from an asset archive).
+	/// The index and vertex data are uploaded straight from the given memory
+	/// </summary>
+	/// <param name="data">The contents of the binary mesh file</param>
+	/// <param name="size">The size of the data, in bytes</param>
+	/// <param name="outHull">If not null, receives the convex collision hull baked into the binary file</param>
+	/// <param name="name">The name of the mesh, for logging</param>
+	/// <returns>A VAO loaded from the data, or nullptr if the data is invalid</returns>
+	static VertexArrayObject::Sptr LoadFromMemory(const uint8_t* data, size_t size, std::vector<glm::vec3>* outHull = nullptr, const std::string& name = "");
 	/// <summary>
 	/// Manually converts an OBJ file into a binary mesh file
 	/// </summary>
@@ -39,8 +50,9 @@ public:
 	/// <typeparam name="VertexType"></typeparam>
 	/// <param name="mesh"></param>
 	/// <param name="outFilename"></param>
+	/// <param name="hull">The simplified convex hull to store for generating colliders</param>
 	template <typename VertexType>
-	static void SaveBinaryFile(MeshBuilder<VertexType>& mesh, const std::string& outFilename);
+	static void SaveBinaryFile(MeshBuilder<VertexType>& mesh, const std::string& outFilename, const std::vector<glm::vec3>& hull = std::vector<glm::vec3>());
 
 protected:
 	// Will be put at the start of the binary file, contains info about the contents of the file
@@ -64,12 +76,17 @@ protected:
 	OptimizedObjLoader() = default;
 	~OptimizedObjLoader() = default;
 
+	// The version that we write to new binary files
+	static const uint16_t CurrentVersion = 0x02;
+
 	static MeshBuilder<VertexPosNormTexColTangents>* _LoadFromObjFile(const std::string& filename);
-	static VertexArrayObject::Sptr _LoadFromBinFile(const std::string& filename);
+	static VertexArrayObject::Sptr _LoadFromBinFile(const std::string& filename, std::vector<glm::vec3>* outHull);
+	// Reads just the version number from a binary file, or 0 if the file is invalid
+	static uint16_t _GetBinFileVersion(const std::string& filename);
 };
 
 template <typename VertexType>
-void OptimizedObjLoader::SaveBinaryFile(MeshBuilder<VertexType>& mesh, const std::string& outFilename) {
+void OptimizedObjLoader::SaveBinaryFile(MeshBuilder<VertexType>& mesh, const std::string& outFilename, const std::vector<glm::vec3>& hull) {
 	// Open the output file
 	std::ofstream file(outFilename, std::ios::binary);
 	if (!file) {
@@ -78,7 +95,7 @@ void OptimizedObjLoader::SaveBinaryFile(MeshBuilder<VertexType>& mesh, const std
 
 	// Create the fixed size header for our output file
 	BinaryHeader header  = BinaryHeader();
-	header.Version       = 0x01; // This is version 1! Update this and implement different readers if changes to format are made
+	header.Version       = CurrentVersion; // Update this and implement different readers if changes to format are made
 	header.NumIndices    = mesh.GetIndexCount();
 	header.IndicesType   = IndexType::UInt;
 	header.NumVertices   = mesh.GetVertexCount();
@@ -99,4 +116,11 @@ void OptimizedObjLoader::SaveBinaryFile(MeshBuilder<VertexType>& mesh, const std
 
 	// Write vertex data to file
 	file.write(reinterpret_cast<const char*>(mesh.GetVertexDataPtr()), mesh.GetVertexCount() * sizeof(VertexType));
+
+	// Version 2 adds the collision hull to the end of the file
+	uint32_t hullSize = static_cast<uint32_t>(hull.size());
+	file.write(reinterpret_cast<const char*>(&hullSize), sizeof(uint32_t));
+	if (hullSize > 0) {
+		file.write(reinterpret_cast<const char*>(hull.data()), hullSize * sizeof(glm::vec3));
+	}
 }
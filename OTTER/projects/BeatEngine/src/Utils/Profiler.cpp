@@ -0,0 +1,202 @@
+#include "Utils/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <Logging.h>
+
+std::atomic<bool> Profiler::_isRecording(true);
+std::mutex Profiler::_threadLock;
+std::vector<std::shared_ptr<Profiler::ThreadBuffer>> Profiler::_threads;
+uint64_t Profiler::_frameMarkers[Profiler::FrameHistory] ={ 0 };
+std::atomic<uint64_t> Profiler::_frameCount(0);
+std::atomic<uint32_t> Profiler::_mainThreadId(Profiler::NoThreadId);
+std::mutex Profiler::_typeNameLock;
+std::unordered_map<std::type_index, std::unique_ptr<std::string>> Profiler::_typeNames;
+thread_local std::unordered_map<std::type_index, const char*> Profiler::_localTypeNames;
+
+// We store all times relative to when the profiler was first touched, so they fit nicely in a trace
+static const std::chrono::steady_clock::time_point ProfilerEpoch = std::chrono::steady_clock::now();
+
+Profiler::ThreadBuffer::ThreadBuffer(uint32_t id) :
+	ThreadId(id),
+	Name("Thread " + std::to_string(id)),
+	Zones(std::vector<ProfileZone>(ZonesPerThread)),
+	Head(0),
+	Depth(0)
+{ }
+
+uint64_t Profiler::Now() {
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - ProfilerEpoch).count());
+}
+
+bool Profiler::IsRecording() {
+	return _isRecording.load(std::memory_order_relaxed);
+}
+
+void Profiler::SetRecording(bool value) {
+	_isRecording.store(value, std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+	ThreadBuffer& buffer = _GetThreadBuffer();
+	std::lock_guard<std::mutex> lock(_threadLock);
+	buffer.Name = name;
+}
+
+void Profiler::MarkFrame() {
+	// Whichever thread marks frames is our main thread
+	ThreadBuffer& buffer = _GetThreadBuffer();
+	if (_mainThreadId.load(std::memory_order_relaxed) != buffer.ThreadId) {
+		std::lock_guard<std::mutex> lock(_threadLock);
+		_mainThreadId.store(buffer.ThreadId, std::memory_order_relaxed);
+		buffer.Name = "Main Thread";
+	}
+
+	if (!IsRecording()) return;
+	uint64_t frame = _frameCount.load(std::memory_order_relaxed);
+	_frameMarkers[frame % FrameHistory] = Now();
+	_frameCount.store(frame + 1, std::memory_order_release);
+}
+
+uint32_t Profiler::GetMainThreadId() {
+	return _mainThreadId.load(std::memory_order_relaxed);
+}
+
+void Profiler::GetFrameMarkers(std::vector<uint64_t>& outMarkers) {
+	outMarkers.clear();
+	uint64_t count = _frameCount.load(std::memory_order_acquire);
+	uint64_t first = count > FrameHistory ? count - FrameHistory : 0;
+	outMarkers.reserve(static_cast<size_t>(count - first));
+	for (uint64_t ix = first; ix < count; ix++) {
+		outMarkers.push_back(_frameMarkers[ix % FrameHistory]);
+	}
+}
+
+void Profiler::Capture(std::vector<ProfileThreadCapture>& outThreads, uint64_t minEndNs) {
+	outThreads.clear();
+
+	std::lock_guard<std::mutex> lock(_threadLock);
+	outThreads.reserve(_threads.size());
+	for (const auto& buffer : _threads) {
+		ProfileThreadCapture& capture = outThreads.emplace_back();
+		capture.ThreadId = buffer->ThreadId;
+		capture.Name = buffer->Name;
+
+		// Hold the owner off while we copy, so it can't lap us and overwrite zones mid-copy
+		std::lock_guard<std::mutex> bufferLock(buffer->Lock);
+		uint64_t head = buffer->Head;
+		uint64_t first = head > ZonesPerThread ? head - ZonesPerThread : 0;
+
+		// Zones are written in the order they end, so we can walk back from the head to find the first one we care about
+		if (minEndNs > 0) {
+			uint64_t ix = head;
+			while (ix > first && buffer->Zones[(ix - 1) % ZonesPerThread].EndNs >= minEndNs) {
+				ix--;
+			}
+			first = ix;
+		}
+		capture.Zones.reserve(static_cast<size_t>(head - first));
+		for (uint64_t ix = first; ix < head; ix++) {
+			capture.Zones.push_back(buffer->Zones[ix % ZonesPerThread]);
+		}
+	}
+}
+
+// Writes a string to the stream, escaping anything that would break the JSON
+static void WriteJsonString(std::ofstream& stream, const char* value) {
+	stream << '"';
+	for (const char* c = value; *c != '\0'; c++) {
+		switch (*c) {
+			case '"':  stream << "\\\""; break;
+			case '\\': stream << "\\\\"; break;
+			case '\n': stream << "\\n"; break;
+			default:   stream << *c; break;
+		}
+	}
+	stream << '"';
+}
+
+bool Profiler::ExportChromeTrace(const std::string& path) {
+	std::vector<ProfileThreadCapture> threads;
+	Capture(threads);
+
+	std::ofstream file(path, std::ios::out | std::ios::trunc);
+	if (!file.is_open()) {
+		LOG_WARN("Failed to open \"{}\" for writing profiler trace", path);
+		return false;
+	}
+
+	// Trace timestamps are in microseconds, we keep the fractional part so short zones don't collapse
+	file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	bool first = true;
+	size_t zoneCount = 0;
+	for (const auto& thread : threads) {
+		file << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread.ThreadId << ",\"args\":{\"name\":";
+		WriteJsonString(file, thread.Name.c_str());
+		file << "}}";
+		first = false;
+
+		for (const auto& zone : thread.Zones) {
+			file << ",\n{\"name\":";
+			WriteJsonString(file, zone.Name);
+			file << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread.ThreadId
+				<< ",\"ts\":" << (zone.StartNs / 1000) << "." << (zone.StartNs % 1000 / 100)
+				<< ",\"dur\":" << ((zone.EndNs - zone.StartNs) / 1000) << "." << ((zone.EndNs - zone.StartNs) % 1000 / 100)
+				<< "}";
+		}
+		zoneCount += thread.Zones.size();
+	}
+	file << "\n]}\n";
+
+	LOG_INFO("Wrote {} profiler zones across {} threads to \"{}\"", zoneCount, threads.size(), path);
+	return true;
+}
+
+Profiler::ThreadBuffer& Profiler::_GetThreadBuffer() {
+	static std::atomic<uint32_t> nextThreadId(0);
+	thread_local ThreadBuffer* buffer = nullptr;
+
+	// First zone on this thread, allocate and register a buffer. The profiler shares ownership, so
+	// we can still see the zones from threads that have since exited
+	if (buffer == nullptr) {
+		std::shared_ptr<ThreadBuffer> result = std::make_shared<ThreadBuffer>(nextThreadId++);
+		std::lock_guard<std::mutex> lock(_threadLock);
+		_threads.push_back(result);
+		buffer = result.get();
+	}
+	return *buffer;
+}
+
+uint32_t Profiler::_BeginZone() {
+	ThreadBuffer& buffer = _GetThreadBuffer();
+	return buffer.Depth++;
+}
+
+void Profiler::_EndZone(const char* name, uint64_t start, uint32_t depth) {
+	ThreadBuffer& buffer = _GetThreadBuffer();
+	buffer.Depth = depth;
+
+	if (!IsRecording()) return;
+
+	ProfileZone zone{ name, start, Now(), depth };
+	std::lock_guard<std::mutex> lock(buffer.Lock);
+	buffer.Zones[buffer.Head % ZonesPerThread] = zone;
+	buffer.Head++;
+}
+
+const char* Profiler::_CacheTypeName(std::type_index type, const std::string& name) {
+	// The name is interned globally so that every thread hands out the same pointer, which the trace export
+	// and benchmarks rely on to merge zones. This only happens once per type per thread
+	const char* result = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(_typeNameLock);
+		auto it = _typeNames.find(type);
+		if (it == _typeNames.end()) {
+			it = _typeNames.emplace(type, std::make_unique<std::string>(name)).first;
+		}
+		result = it->second->c_str();
+	}
+	_localTypeNames.emplace(type, result);
+	return result;
+}
@@ -0,0 +1,192 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "Utils/Macros.h"
+
+// Set ENABLE_PROFILING to 0 in the build config to strip all zones out of the build
+#ifndef ENABLE_PROFILING
+#define ENABLE_PROFILING 1
+#endif
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#if ENABLE_PROFILING
+// Opens a zone that lasts until the end of the enclosing scope. Name must outlive the profiler capture (ex: a literal)
+#define PROFILE_ZONE(name) ::ProfileScope PROFILE_CONCAT(__profileZone, __LINE__)(name)
+// Opens a zone named after the enclosing function
+#define PROFILE_FUNCTION() PROFILE_ZONE(__FUNCTION__)
+// Marks the start of a new frame on the main thread
+#define PROFILE_FRAME() ::Profiler::MarkFrame()
+// Names the calling thread in the timeline and trace exports
+#define PROFILE_THREAD(name) ::Profiler::SetThreadName(name)
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_FUNCTION()
+#define PROFILE_FRAME()
+#define PROFILE_THREAD(name)
+#endif
+
+/// <summary>
+/// A single completed zone, as stored in a thread's ring buffer
+/// </summary>
+struct ProfileZone {
+	const char* Name;
+	uint64_t    StartNs;
+	uint64_t    EndNs;
+	uint32_t    Depth;
+};
+
+/// <summary>
+/// A copy of all the zones that are currently held by a single thread's ring buffer
+/// </summary>
+struct ProfileThreadCapture {
+	uint32_t                 ThreadId;
+	std::string              Name;
+	std::vector<ProfileZone> Zones;
+};
+
+/// <summary>
+/// A very lightweight scoped-zone CPU profiler. Every thread that records a zone
+/// gets it's own fixed size ring buffer and lock, so recording only ever waits on a 
+/// capture copying that thread's buffer, and never allocates after the first zone on a 
+/// thread. Old zones are overwritten as new ones come in, so the profiler always holds 
+/// the last few frames worth of data
+/// </summary>
+class Profiler {
+public:
+	// The number of zones each thread can hold before it starts overwriting old ones
+	static constexpr size_t ZonesPerThread = 1 << 16;
+	// The number of frame markers we keep around
+	static constexpr size_t FrameHistory = 256;
+	// Returned by GetMainThreadId until the first frame has been marked
+	static constexpr uint32_t NoThreadId = UINT32_MAX;
+
+	/// <summary>
+	/// Gets the current time in nanoseconds since the profiler was started
+	/// </summary>
+	static uint64_t Now();
+
+	/// <summary>
+	/// Gets or sets whether new zones are being recorded. Pausing lets us inspect
+	/// a capture without it scrolling out from under us
+	/// </summary>
+	static bool IsRecording();
+	static void SetRecording(bool value);
+
+	/// <summary>
+	/// Sets the display name for the calling thread
+	/// </summary>
+	static void SetThreadName(const std::string& name);
+
+	/// <summary>
+	/// Records the start of a new frame, should be invoked by the main loop only
+	/// </summary>
+	static void MarkFrame();
+
+	/// <summary>
+	/// Gets the ID of the thread that marks frames, or NoThreadId if no frames have been marked yet
+	/// </summary>
+	static uint32_t GetMainThreadId();
+
+	/// <summary>
+	/// Copies the start times of the most recent frames into the output, oldest first
+	/// </summary>
+	static void GetFrameMarkers(std::vector<uint64_t>& outMarkers);
+
+	/// <summary>
+	/// Takes a snapshot of the zones in every thread's ring buffer, oldest first
+	/// </summary>
+	/// <param name="outThreads">The list to store the per-thread results in</param>
+	/// <param name="minEndNs">Zones that ended before this time are skipped, lets us avoid copying the whole buffer</param>
+	static void Capture(std::vector<ProfileThreadCapture>& outThreads, uint64_t minEndNs = 0);
+
+	/// <summary>
+	/// Writes everything currently held by the profiler to a trace file in the
+	/// Chrome trace event format, which can be opened in chrome://tracing or ui.perfetto.dev
+	/// </summary>
+	/// <param name="path">The path to the file to write</param>
+	/// <returns>True if the file was written, false if otherwise</returns>
+	static bool ExportChromeTrace(const std::string& path);
+
+	/// <summary>
+	/// Gets a stable zone name for the given object's type, using the object's ComponentTypeName
+	/// the first time a type is seen. This lets us have a zone per component type without building
+	/// a string every time
+	/// </summary>
+	template <typename T>
+	static const char* TypeZoneName(const T& obj) {
+		// Every thread keeps it's own copy of the names it has already seen, so this never locks after a type's first zone
+		std::type_index type = std::type_index(typeid(obj));
+		auto it = _localTypeNames.find(type);
+		if (it != _localTypeNames.end()) {
+			return it->second;
+		}
+		return _CacheTypeName(type, obj.ComponentTypeName());
+	}
+
+protected:
+	friend class ProfileScope;
+
+	struct ThreadBuffer {
+		uint32_t                 ThreadId;
+		std::string              Name;
+		std::vector<ProfileZone> Zones;
+		uint64_t                 Head;
+		uint32_t                 Depth;
+		// Guards Zones and Head, only contended while a capture is copying this buffer
+		std::mutex               Lock;
+
+		ThreadBuffer(uint32_t id);
+	};
+
+	static std::atomic<bool> _isRecording;
+
+	static std::mutex _threadLock;
+	static std::vector<std::shared_ptr<ThreadBuffer>> _threads;
+
+	static uint64_t _frameMarkers[FrameHistory];
+	static std::atomic<uint64_t> _frameCount;
+	static std::atomic<uint32_t> _mainThreadId;
+
+	static std::mutex _typeNameLock;
+	static std::unordered_map<std::type_index, std::unique_ptr<std::string>> _typeNames;
+	static thread_local std::unordered_map<std::type_index, const char*> _localTypeNames;
+
+	static ThreadBuffer& _GetThreadBuffer();
+	static uint32_t _BeginZone();
+	static void _EndZone(const char* name, uint64_t start, uint32_t depth);
+	static const char* _CacheTypeName(std::type_index type, const std::string& name);
+};
+
+/// <summary>
+/// Records a single zone that lasts for the lifetime of this object. Use the PROFILE_ZONE
+/// macro instead of creating these directly so they can be compiled out
+/// </summary>
+class ProfileScope {
+public:
+	NO_COPY(ProfileScope);
+	NO_MOVE(ProfileScope);
+
+	inline ProfileScope(const char* name) :
+		_name(name),
+		_depth(Profiler::_BeginZone()),
+		_start(Profiler::Now())
+	{ }
+
+	inline ~ProfileScope() {
+		Profiler::_EndZone(_name, _start, _depth);
+	}
+
+private:
+	const char* _name;
+	uint32_t    _depth;
+	uint64_t    _start;
+};
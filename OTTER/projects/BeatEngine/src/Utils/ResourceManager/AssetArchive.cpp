@@ -0,0 +1,236 @@
+#include "Utils/ResourceManager/AssetArchive.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <zlib.h>
+#include "Logging.h"
+
+const char* AssetArchive::ManifestTypeName = "Manifest";
+
+bool AssetArchive::Open(const std::string& path) {
+	_toc = nullptr;
+	_numEntries = 0;
+	if (!_file.Open(path)) {
+		LOG_WARN("Failed to open archive \"{}\"", path);
+		return false;
+	}
+
+	// Validate everything up front, so that reads only need to check the entry they're after
+	Header header = Header();
+	Header expected = Header();
+	if (_file.GetSize() < sizeof(Header)) {
+		LOG_WARN("\"{}\" is not an asset archive", path);
+		_file.Close();
+		return false;
+	}
+	memcpy(&header, _file.GetData(), sizeof(Header));
+	if (memcmp(header.HeaderBytes, expected.HeaderBytes, 4) != 0 || header.Version != CurrentVersion) {
+		LOG_WARN("\"{}\" is not an asset archive, or is from an older version", path);
+		_file.Close();
+		return false;
+	}
+	if (header.TocOffset % Alignment != 0 || header.TocOffset + (uint64_t)header.NumEntries * sizeof(TocEntry) > _file.GetSize()) {
+		LOG_WARN("Archive \"{}\" has a corrupt table of contents", path);
+		_file.Close();
+		return false;
+	}
+
+	const TocEntry* toc = reinterpret_cast<const TocEntry*>(_file.GetData() + header.TocOffset);
+	for (uint32_t ix = 0; ix < header.NumEntries; ix++) {
+		if (toc[ix].Offset + toc[ix].StoredSize > _file.GetSize()) {
+			LOG_WARN("Archive \"{}\" is truncated", path);
+			_file.Close();
+			return false;
+		}
+	}
+
+	_toc = toc;
+	_numEntries = header.NumEntries;
+	LOG_INFO("Opened archive \"{}\" ({} entries, {} KB)", path, _numEntries, _file.GetSize() / 1024);
+	return true;
+}
+
+bool AssetArchive::Contains(const std::string& typeName, const Guid& id, uint32_t part) const {
+	return _Find(typeName, id, part) != nullptr;
+}
+
+AssetView AssetArchive::Read(const std::string& typeName, const Guid& id, uint32_t part) const {
+	AssetView result;
+	const TocEntry* entry = _Find(typeName, id, part);
+	if (entry == nullptr) {
+		return result;
+	}
+
+	const uint8_t* stored = _file.GetData() + entry->Offset;
+	switch (entry->Compression) {
+		case ArchiveCompression::None:
+			result.Data = stored;
+			result.Size = entry->Size;
+			break;
+		case ArchiveCompression::Deflate:
+		{
+			result.Storage.resize(entry->Size);
+			uLongf size = static_cast<uLongf>(entry->Size);
+			int status = uncompress(result.Storage.data(), &size, stored, static_cast<uLong>(entry->StoredSize));
+			if (status != Z_OK || size != entry->Size) {
+				LOG_ERROR("Failed to decompress {} {} from \"{}\" ({})", typeName, id.str(), GetPath(), status);
+				result.Storage.clear();
+				return result;
+			}
+			result.Data = result.Storage.data();
+			result.Size = entry->Size;
+			break;
+		}
+		default:
+			LOG_ERROR("{} {} in \"{}\" uses an unknown compression mode", typeName, id.str(), GetPath());
+			break;
+	}
+	return result;
+}
+
+const AssetArchive::TocEntry* AssetArchive::_Find(const std::string& typeName, const Guid& id, uint32_t part) const {
+	if (_toc == nullptr) {
+		return nullptr;
+	}
+
+	uint32_t typeHash = __HashTypeName(typeName);
+	const TocEntry* end = _toc + _numEntries;
+	const TocEntry* it = std::lower_bound(_toc, end, 0, [&](const TocEntry& entry, int) {
+		return __Compare(entry.TypeHash, entry.Id, entry.Part, typeHash, id.bytes(), part) < 0;
+	});
+	if (it != end && __Compare(it->TypeHash, it->Id, it->Part, typeHash, id.bytes(), part) == 0) {
+		return it;
+	}
+	return nullptr;
+}
+
+uint32_t AssetArchive::__HashTypeName(const std::string& typeName) {
+	uint32_t hash = 0x811c9dc5u;
+	for (char c : typeName) {
+		hash = (hash ^ static_cast<uint8_t>(c)) * 0x01000193u;
+	}
+	return hash;
+}
+
+int AssetArchive::__Compare(uint32_t typeHashA, const uint8_t* idA, uint32_t partA, uint32_t typeHashB, const uint8_t* idB, uint32_t partB) {
+	if (typeHashA != typeHashB) {
+		return typeHashA < typeHashB ? -1 : 1;
+	}
+	int idOrder = memcmp(idA, idB, 16);
+	if (idOrder != 0) {
+		return idOrder;
+	}
+	if (partA != partB) {
+		return partA < partB ? -1 : 1;
+	}
+	return 0;
+}
+
+void AssetArchive::Writer::Add(const std::string& typeName, const Guid& id, uint32_t part, const void* data, size_t size, bool allowCompression) {
+	PendingEntry entry = PendingEntry();
+	entry.TypeHash    = __HashTypeName(typeName);
+	entry.Id          = id;
+	entry.Part        = part;
+	entry.Size        = size;
+	entry.Compression = ArchiveCompression::None;
+
+	// Small entries and data that's already compressed (ex: block compressed textures) won't shrink enough to be
+	// worth inflating at load time, so we only keep the compressed copy if it saves at least an eighth
+	if (allowCompression && size >= 256) {
+		uLongf compressedSize = compressBound(static_cast<uLong>(size));
+		entry.Data.resize(compressedSize);
+		if (compress2(entry.Data.data(), &compressedSize, static_cast<const Bytef*>(data), static_cast<uLong>(size), Z_BEST_COMPRESSION) == Z_OK &&
+			compressedSize < size - size / 8) {
+			entry.Data.resize(compressedSize);
+			entry.Compression = ArchiveCompression::Deflate;
+		}
+	}
+	if (entry.Compression == ArchiveCompression::None) {
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		entry.Data.assign(bytes, bytes + size);
+	}
+
+	auto existing = std::find_if(_entries.begin(), _entries.end(), [&](const PendingEntry& other) {
+		return __Compare(other.TypeHash, other.Id.bytes(), other.Part, entry.TypeHash, entry.Id.bytes(), entry.Part) == 0;
+	});
+	if (existing != _entries.end()) {
+		*existing = std::move(entry);
+	} else {
+		_entries.push_back(std::move(entry));
+	}
+}
+
+bool AssetArchive::Writer::Save(const std::string& path) const {
+	// The table of contents is sorted so that lookups can binary search it
+	std::vector<const PendingEntry*> sorted;
+	sorted.reserve(_entries.size());
+	for (const PendingEntry& entry : _entries) {
+		sorted.push_back(&entry);
+	}
+	std::sort(sorted.begin(), sorted.end(), [](const PendingEntry* a, const PendingEntry* b) {
+		return __Compare(a->TypeHash, a->Id.bytes(), a->Part, b->TypeHash, b->Id.bytes(), b->Part) < 0;
+	});
+
+	auto align = [](uint64_t offset) {
+		return (offset + Alignment - 1) / Alignment * Alignment;
+	};
+
+	Header header = Header();
+	header.Version    = CurrentVersion;
+	header.NumEntries = static_cast<uint32_t>(sorted.size());
+	header.TocOffset  = static_cast<uint32_t>(align(sizeof(Header)));
+
+	std::vector<TocEntry> toc(sorted.size());
+	uint64_t offset = align(header.TocOffset + toc.size() * sizeof(TocEntry));
+	for (size_t ix = 0; ix < sorted.size(); ix++) {
+		TocEntry entry;
+		memset(&entry, 0, sizeof(TocEntry));
+		entry.TypeHash    = sorted[ix]->TypeHash;
+		entry.Part        = sorted[ix]->Part;
+		memcpy(entry.Id, sorted[ix]->Id.bytes(), 16);
+		entry.Offset      = offset;
+		entry.StoredSize  = sorted[ix]->Data.size();
+		entry.Size        = sorted[ix]->Size;
+		entry.Compression = sorted[ix]->Compression;
+		toc[ix] = entry;
+		offset = align(offset + entry.StoredSize);
+	}
+
+	// Write to a temporary file first, so that the game never sees a half written archive
+	std::string tempPath = path + ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			LOG_ERROR("Failed to open \"{}\" for writing", tempPath);
+			return false;
+		}
+
+		static const char padding[Alignment] = { 0 };
+		auto pad = [&file, &align]() {
+			uint64_t position = static_cast<uint64_t>(file.tellp());
+			file.write(padding, align(position) - position);
+		};
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+		pad();
+		file.write(reinterpret_cast<const char*>(toc.data()), toc.size() * sizeof(TocEntry));
+		for (const PendingEntry* entry : sorted) {
+			pad();
+			file.write(reinterpret_cast<const char*>(entry->Data.data()), entry->Data.size());
+		}
+		if (!file) {
+			LOG_ERROR("Failed to write archive \"{}\"", path);
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(tempPath, path, error);
+	if (error) {
+		LOG_ERROR("Failed to write archive \"{}\": {}", path, error.message());
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+	return true;
+}
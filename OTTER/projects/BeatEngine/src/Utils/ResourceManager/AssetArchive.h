@@ -0,0 +1,165 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <EnumToString.h>
+
+#include "Utils/GUID.hpp"
+#include "Utils/Macros.h"
+#include "Utils/MappedFile.h"
+
+/// <summary>
+/// How an entry's data is stored in an archive
+/// </summary>
+ENUM(ArchiveCompression, uint8_t,
+	None    = 0,
+	// zlib's deflate, since we already link zlib. Only used when it actually makes the entry smaller
+	Deflate = 1
+);
+
+/// <summary>
+/// A block of data read out of an archive. Entries that were stored as-is point straight into the
+/// mapped archive, compressed entries are inflated into a buffer that the view owns. Either way the
+/// data is only valid for as long as both the view and the archive are alive
+/// </summary>
+struct AssetView {
+	NO_COPY(AssetView);
+
+	const uint8_t*       Data    = nullptr;
+	size_t               Size    = 0;
+	// Only used when the entry had to be decompressed
+	std::vector<uint8_t> Storage;
+
+	AssetView() = default;
+	AssetView(AssetView&& other) = default;
+	AssetView& operator =(AssetView&& other) = default;
+
+	/// <summary>
+	/// Returns true if the view holds an entry
+	/// </summary>
+	bool IsValid() const { return Data != nullptr; }
+};
+
+/// <summary>
+/// A single file that holds the data for many assets, along with the manifest that describes them. Assets are
+/// looked up by the name of their resource type, their GUID, and a part index for assets that are made of
+/// several blobs (ex: the stages of a shader program).
+///
+/// The archive is mapped into memory when it's opened, and the table of contents is searched in place, so
+/// loading an asset is a binary search and a pointer rather than opening and reading a file. Every entry
+/// starts on a 64 byte boundary so that loaders can use the data without copying it somewhere aligned first
+/// </summary>
+class AssetArchive {
+public:
+	MAKE_PTRS(AssetArchive);
+	NO_COPY(AssetArchive);
+	NO_MOVE(AssetArchive);
+
+	/// <summary>
+	/// The type name that the archive's resource manifest is stored under
+	/// </summary>
+	static const char* ManifestTypeName;
+
+	AssetArchive() = default;
+
+	/// <summary>
+	/// Maps an archive file and validates it's table of contents
+	/// </summary>
+	/// <param name="path">The path to the archive</param>
+	/// <returns>True if the archive was opened</returns>
+	bool Open(const std::string& path);
+
+	/// <summary>
+	/// Gets the path of the archive
+	/// </summary>
+	const std::string& GetPath() const { return _file.GetPath(); }
+	/// <summary>
+	/// Gets the number of entries in the archive
+	/// </summary>
+	uint32_t GetNumEntries() const { return _numEntries; }
+
+	/// <summary>
+	/// Returns true if the archive has an entry for the given asset
+	/// </summary>
+	bool Contains(const std::string& typeName, const Guid& id, uint32_t part = 0) const;
+	/// <summary>
+	/// Reads an entry from the archive, decompressing it if needed
+	/// </summary>
+	/// <param name="typeName">The name of the asset's resource type, as it appears in manifests</param>
+	/// <param name="id">The GUID of the asset</param>
+	/// <param name="part">Which part of the asset to read, 0 for assets that only have one</param>
+	/// <returns>A view of the entry's data, or an invalid view if there is no such entry</returns>
+	AssetView Read(const std::string& typeName, const Guid& id, uint32_t part = 0) const;
+
+	/// <summary>
+	/// Collects entries and writes them out as an archive, used by the asset cooker
+	/// </summary>
+	class Writer {
+	public:
+		/// <summary>
+		/// Adds an entry to the archive. Adding the same asset and part twice replaces the old entry
+		/// </summary>
+		/// <param name="typeName">The name of the asset's resource type, as it appears in manifests</param>
+		/// <param name="id">The GUID of the asset</param>
+		/// <param name="part">Which part of the asset this is, 0 for assets that only have one</param>
+		/// <param name="data">The data to store</param>
+		/// <param name="size">The size of data, in bytes</param>
+		/// <param name="allowCompression">True to compress the entry if it will save space</param>
+		void Add(const std::string& typeName, const Guid& id, uint32_t part, const void* data, size_t size, bool allowCompression = true);
+		/// <summary>
+		/// Writes all of the entries out to an archive file
+		/// </summary>
+		/// <returns>True if the archive was written</returns>
+		bool Save(const std::string& path) const;
+
+	protected:
+		struct PendingEntry {
+			uint32_t             TypeHash;
+			Guid                 Id;
+			uint32_t             Part;
+			uint64_t             Size;
+			ArchiveCompression   Compression;
+			std::vector<uint8_t> Data;
+		};
+		std::vector<PendingEntry> _entries;
+	};
+
+protected:
+	// Will be put at the start of the archive, followed by the table of contents
+	struct Header {
+		char     HeaderBytes[4] = { 'B', 'P', 'A', 'K' };
+		uint16_t Version        = 0;
+		uint16_t Reserved       = 0;
+		uint32_t NumEntries     = 0;
+		uint32_t TocOffset      = 0;
+	};
+
+	// A single entry in the table of contents, which is sorted by type, GUID and then part. Padded out to a cache line
+	struct TocEntry {
+		uint32_t           TypeHash;
+		uint32_t           Part;
+		uint8_t            Id[16];
+		uint64_t           Offset;
+		uint64_t           StoredSize;
+		uint64_t           Size;
+		ArchiveCompression Compression;
+		uint8_t            Padding[15];
+	};
+	static_assert(sizeof(TocEntry) == 64, "TOC entries should be a cache line each");
+
+	// The version that we write to new archives
+	static const uint16_t CurrentVersion = 0x01;
+	// Every entry and the table of contents start on a multiple of this
+	static const uint32_t Alignment = 64;
+
+	MappedFile      _file;
+	const TocEntry* _toc        = nullptr;
+	uint32_t        _numEntries = 0;
+
+	const TocEntry* _Find(const std::string& typeName, const Guid& id, uint32_t part) const;
+
+	// Hashes a type name for the table of contents, FNV-1a
+	static uint32_t __HashTypeName(const std::string& typeName);
+	// Orders entries the same way the table of contents is sorted
+	static int __Compare(uint32_t typeHashA, const uint8_t* idA, uint32_t partA, uint32_t typeHashB, const uint8_t* idB, uint32_t partB);
+};
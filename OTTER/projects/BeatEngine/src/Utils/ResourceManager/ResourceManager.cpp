@@ -3,11 +3,15 @@
 #include "Utils/ObjLoader.h"
 #include "Utils/FileHelpers.h"
 #include "Utils/StringUtils.h"
+#include <filesystem>
+#include "Logging.h"
 
 std::map<std::type_index, std::map<Guid, IResource::Sptr>> ResourceManager::_resources;
 std::map<std::string, std::function<Guid(const nlohmann::json&)>> ResourceManager::_typeLoaders;
 
 nlohmann::ordered_json ResourceManager::_manifest;
+AssetArchive::Sptr ResourceManager::_archive;
+bool ResourceManager::_isManifestCooked = false;
 
 void ResourceManager::Init() {
 	// TODO: initialize the resource manager once it's a bit more complex
@@ -22,8 +26,44 @@ const nlohmann::ordered_json& ResourceManager::GetManifest() {
 }
 
 void ResourceManager::LoadManifest(const std::string& path, bool preloadAssets) {
-	std::string contents = FileHelpers::ReadFile(path);
-	nlohmann::ordered_json blob = nlohmann::ordered_json::parse(contents);
+	MEMORY_TAG(MemoryTag::Resources);
+	nlohmann::ordered_json blob;
+	// Archives carry their manifest with them, and the loaders will read assets straight out of the archive
+	if (std::filesystem::path(path).extension() == ".pak") {
+		AssetArchive::Sptr archive = std::make_shared<AssetArchive>();
+		AssetView manifest;
+		if (archive->Open(path)) {
+			manifest = archive->Read(AssetArchive::ManifestTypeName, Guid());
+		}
+		bool isValid = manifest.IsValid();
+		if (isValid) {
+			try {
+				blob = nlohmann::ordered_json::from_msgpack(manifest.Data, manifest.Data + manifest.Size);
+			} catch (const nlohmann::json::exception& e) {
+				LOG_WARN("Failed to read the manifest in \"{}\": {}", path, e.what());
+				isValid = false;
+			}
+		}
+
+		// A stale or corrupt archive shouldn't leave us with nothing loaded, so we go back to the manifest it was packed from
+		if (!isValid) {
+			std::string fallback = ResolveManifestPath(std::filesystem::path(path).replace_extension(".json").string(), false);
+			if (!std::filesystem::exists(fallback)) {
+				LOG_ERROR("\"{}\" does not contain a resource manifest, and there is no JSON manifest to fall back to", path);
+				return;
+			}
+			LOG_WARN("\"{}\" failed validation, loading \"{}\" instead", path, fallback);
+			LoadManifest(fallback, preloadAssets);
+			return;
+		}
+		_archive = archive;
+		_isManifestCooked = true;
+	} else {
+		std::string contents = FileHelpers::ReadFile(path);
+		blob = nlohmann::ordered_json::parse(contents);
+		_archive = nullptr;
+		_isManifestCooked = std::filesystem::path(path).stem().extension() == ".cooked";
+	}
 	_manifest = blob;
 
 	if (preloadAssets) {
@@ -39,6 +79,12 @@ void ResourceManager::LoadManifest(const std::string& path, bool preloadAssets)
 }
 
 void ResourceManager::SaveManifest(const std::string& path) {
+	// Our resources point at cooked files now, writing them out would replace the source paths that the cooker needs
+	if (_isManifestCooked) {
+		LOG_ERROR("Not saving the manifest to \"{}\", the loaded manifest is cooked. Load the source manifest to edit resources", path);
+		return;
+	}
+
 	// Update all resources in the manifest so they match their current representation
 	for (auto& [type, map] : _resources) {
 		std::string typeName = StringTools::SanitizeClassName(type.name());
@@ -52,6 +98,38 @@ void ResourceManager::SaveManifest(const std::string& path) {
 	FileHelpers::WriteContentsToFile(path, _manifest.dump(1,'\t'));
 }
 
+std::string ResourceManager::GetCookedManifestPath(const std::string& path) {
+	std::filesystem::path result = std::filesystem::path(path);
+	result.replace_extension(".cooked" + result.extension().string());
+	return result.string();
+}
+
+std::string ResourceManager::GetArchivePath(const std::string& path) {
+	std::filesystem::path result = std::filesystem::path(path);
+	result.replace_extension(".pak");
+	return result.string();
+}
+
+std::string ResourceManager::ResolveManifestPath(const std::string& path, bool allowArchive) {
+	// If the manifest was re-generated since it was cooked, the cooked copies may be missing assets
+	std::error_code error;
+	bool hasSource = std::filesystem::exists(path, error);
+	auto isUpToDate = [&](const std::string& cookedPath) {
+		return std::filesystem::exists(cookedPath, error) &&
+			(!hasSource || std::filesystem::last_write_time(cookedPath, error) >= std::filesystem::last_write_time(path, error));
+	};
+
+	std::string archivePath = GetArchivePath(path);
+	if (allowArchive && isUpToDate(archivePath)) {
+		return archivePath;
+	}
+	std::string cookedPath = GetCookedManifestPath(path);
+	if (isUpToDate(cookedPath)) {
+		return cookedPath;
+	}
+	return path;
+}
+
 void ResourceManager::Cleanup() {
 	for (auto& [type, map] : _resources) {
 		map.clear();
@@ -6,7 +6,9 @@
 
 #include "Utils/GUID.hpp"
 #include "Utils/ResourceManager/IResource.h"
+#include "Utils/ResourceManager/AssetArchive.h"
 #include "Utils/StringUtils.h"
+#include "Utils/MemoryTracker.h"
 
 /// <summary>
 /// Utility class for managing and loading resources from JSON
@@ -29,6 +31,8 @@ public:
 	/// <returns>The GUID of the newly created asset</returns>
 	template <typename T, typename ... TArgs, typename = std::enable_if<is_valid_resource<T>()>::type>
 	static std::shared_ptr<T> CreateAsset(TArgs&&... args) {
+		MEMORY_TAG(MemoryTag::Resources);
+
 		// Create and store the asset
 		std::shared_ptr<T> asset = std::make_shared<T>(std::forward<TArgs>(args)...);
 		_resources[std::type_index(typeid(T))][asset->IResource::GetGUID()] = asset;
@@ -88,6 +92,7 @@ public:
 
 		// Create the type loader for the type
 		_typeLoaders[typeName] = [](const nlohmann::json& data) {
+			MEMORY_TAG(MemoryTag::Resources);
 			IResource::Sptr res = T::FromJson(data);
 			res->OverrideGUID(Guid(data["guid"]));
 			_resources[std::type_index(typeid(T))][res->GetGUID()] = res;
@@ -131,16 +136,52 @@ public:
 	static const nlohmann::ordered_json& GetManifest();
 	/// <summary>
 	/// Loads a manifest file into the resource manager. Note that this will not perform load on the assets themselves 
-	/// unless preloadAssets is set to true
+	/// unless preloadAssets is set to true. If an archive fails to validate, the JSON manifest it was packed from is
+	/// loaded instead
 	/// </summary>
 	/// <param name="path">The path to the JSON manifest file</param>
 	/// <param name="preloadAssets">True if all assets should be loaded into memory</param>
 	static void LoadManifest(const std::string& path, bool preloadAssets = false);
 	/// <summary>
-	/// Saves the manifest to the given JSON file
+	/// Saves the manifest to the given JSON file. This does nothing if the manifest was loaded from a cooked
+	/// copy or an archive, since it's resources point at cooked files that shouldn't end up in a source manifest
 	/// </summary>
 	/// <param name="path">The path to the file to output</param>
 	static void SaveManifest(const std::string& path);
+	/// <summary>
+	/// Gets the path that the asset cooker writes the cooked copy of a manifest to. The cooked copy
+	/// points at pre-converted assets, so that they can be loaded without any conversion at runtime
+	/// </summary>
+	/// <param name="path">The path to the source manifest</param>
+	static std::string GetCookedManifestPath(const std::string& path);
+	/// <summary>
+	/// Gets the path that the asset cooker packs a manifest and all of it's cooked assets into
+	/// </summary>
+	/// <param name="path">The path to the source manifest</param>
+	static std::string GetArchivePath(const std::string& path);
+	/// <summary>
+	/// Gets the manifest that should be loaded in place of the given one. This will be it's archive or it's
+	/// cooked copy, if they exist and are at least as new as the source manifest
+	/// </summary>
+	/// <param name="path">The path to the source manifest</param>
+	/// <param name="allowArchive">False to only consider the cooked copy, ex: when the archive is known to be bad</param>
+	static std::string ResolveManifestPath(const std::string& path, bool allowArchive = true);
+
+	/// <summary>
+	/// Reads an asset's data out of the mounted archive. An archive is mounted when the manifest is loaded
+	/// from one, and loaders should prefer it's data over the files that their manifest entry refers to
+	/// </summary>
+	/// <typeparam name="T">The type of resource being loaded</typeparam>
+	/// <param name="data">The asset's manifest entry</param>
+	/// <param name="part">Which part of the asset to read, for assets that are packed as several entries</param>
+	/// <returns>A view of the packed data, or an invalid view if the asset isn't in an archive</returns>
+	template <typename T>
+	static AssetView ReadArchived(const nlohmann::json& data, uint32_t part = 0) {
+		if (_archive == nullptr || !data.contains("guid") || !data["guid"].is_string()) {
+			return AssetView();
+		}
+		return _archive->Read(StringTools::SanitizeClassName(typeid(T).name()), Guid(data["guid"].get<std::string>()), part);
+	}
 
 	/// <summary>
 	/// Releases all resources held by the resource manager
@@ -164,4 +205,12 @@ protected:
 	/// This allows us to register dependencies before the dependent resource
 	/// </summary>
 	static nlohmann::ordered_json _manifest;
+	/// <summary>
+	/// The archive that the current manifest was loaded from, if any
+	/// </summary>
+	static AssetArchive::Sptr _archive;
+	/// <summary>
+	/// True if the current manifest came from a cooked copy or an archive, and must not be saved
+	/// </summary>
+	static bool _isManifestCooked;
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Utils/StringUtils.h"
+#include <cstdint>
 
 std::string StringTools::SanitizeClassName(const std::string& name)
 {
@@ -65,3 +66,81 @@ int StringTools::Split(const std::string& s, std::vector<std::string>& results,
 	results.push_back(s.substr(lastPos, seek));
 	return ++result;
 }
+
+void StringTools::Utf8ToUnicode(const std::string& value, std::wstring& result) {
+	result.clear();
+	size_t ix = 0;
+	while (ix < value.size()) {
+		uint8_t lead = (uint8_t)value[ix++];
+
+		// Work out how many continuation bytes follow the lead byte
+		uint32_t codepoint;
+		int extra;
+		if (lead < 0x80)                { codepoint = lead;        extra = 0; }
+		else if ((lead & 0xE0) == 0xC0) { codepoint = lead & 0x1F; extra = 1; }
+		else if ((lead & 0xF0) == 0xE0) { codepoint = lead & 0x0F; extra = 2; }
+		else if ((lead & 0xF8) == 0xF0) { codepoint = lead & 0x07; extra = 3; }
+		else                            { codepoint = 0xFFFD;      extra = 0; }
+
+		for (; extra > 0; extra--) {
+			if (ix >= value.size() || ((uint8_t)value[ix] & 0xC0) != 0x80) {
+				codepoint = 0xFFFD;
+				break;
+			}
+			codepoint = (codepoint << 6) | ((uint8_t)value[ix++] & 0x3F);
+		}
+
+		// Windows has a 16 bit wchar_t, so anything outside the BMP needs a surrogate pair
+		if (sizeof(wchar_t) == 2 && codepoint >= 0x10000 && codepoint <= 0x10FFFF) {
+			codepoint -= 0x10000;
+			result.push_back((wchar_t)(0xD800 + (codepoint >> 10)));
+			result.push_back((wchar_t)(0xDC00 + (codepoint & 0x3FF)));
+		} else {
+			result.push_back((wchar_t)codepoint);
+		}
+	}
+}
+
+std::wstring StringTools::Utf8ToUnicode(const std::string& value) {
+	std::wstring result;
+	Utf8ToUnicode(value, result);
+	return result;
+}
+
+void StringTools::UnicodeToUtf8(const std::wstring& value, std::string& result) {
+	result.clear();
+	for (size_t ix = 0; ix < value.size(); ix++) {
+		uint32_t codepoint = (uint32_t)value[ix];
+
+		// Stitch surrogate pairs back together
+		if (sizeof(wchar_t) == 2 && codepoint >= 0xD800 && codepoint < 0xDC00 && ix + 1 < value.size()) {
+			uint32_t low = (uint32_t)value[ix + 1];
+			if (low >= 0xDC00 && low < 0xE000) {
+				codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+				ix++;
+			}
+		}
+
+		if (codepoint < 0x80) {
+			result.push_back((char)codepoint);
+		} else if (codepoint < 0x800) {
+			result.push_back((char)(0xC0 | (codepoint >> 6)));
+			result.push_back((char)(0x80 | (codepoint & 0x3F)));
+		} else if (codepoint < 0x10000) {
+			result.push_back((char)(0xE0 | (codepoint >> 12)));
+			result.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+			result.push_back((char)(0x80 | (codepoint & 0x3F)));
+		} else {
+			result.push_back((char)(0xF0 | (codepoint >> 18)));
+			result.push_back((char)(0x80 | ((codepoint >> 12) & 0x3F)));
+			result.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+			result.push_back((char)(0x80 | (codepoint & 0x3F)));
+		}
+	}
+}
+
+std::string StringTools::UnicodeToUtf8(const std::wstring& value) {
+	std::string result;
+	UnicodeToUtf8(value, result);
+	return result;
+}
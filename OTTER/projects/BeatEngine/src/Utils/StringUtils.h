@@ -115,4 +115,28 @@ public:
 	/// <param name="splitOn">The delimiter string to split on</param>
 	/// <returns>The number of tokens this command appended to the results</returns>
 	static int Split(const std::string& s, std::vector<std::string>& results, const std::string& splitOn = ",");
+
+	/// <summary>
+	/// Decodes a UTF-8 string into a unicode string, reusing the storage in the result. Invalid
+	/// bytes are replaced with U+FFFD rather than throwing like std::wstring_convert does
+	/// </summary>
+	/// <param name="value">The UTF-8 string to decode</param>
+	/// <param name="result">The string to overwrite with the decoded characters</param>
+	static void Utf8ToUnicode(const std::string& value, std::wstring& result);
+	/// <summary>
+	/// Decodes a UTF-8 string into a unicode string
+	/// </summary>
+	/// <param name="value">The UTF-8 string to decode</param>
+	static std::wstring Utf8ToUnicode(const std::string& value);
+	/// <summary>
+	/// Encodes a unicode string as UTF-8, reusing the storage in the result
+	/// </summary>
+	/// <param name="value">The unicode string to encode</param>
+	/// <param name="result">The string to overwrite with the encoded bytes</param>
+	static void UnicodeToUtf8(const std::wstring& value, std::string& result);
+	/// <summary>
+	/// Encodes a unicode string as UTF-8
+	/// </summary>
+	/// <param name="value">The unicode string to encode</param>
+	static std::string UnicodeToUtf8(const std::wstring& value);
 };
\ No newline at end of file
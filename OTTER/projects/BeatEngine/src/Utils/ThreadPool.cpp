@@ -0,0 +1,130 @@
+#include "Utils/ThreadPool.h"
+#include "Utils/Profiler.h"
+
+ThreadPool::ThreadPool(int numWorkers) :
+	_workers(std::vector<std::thread>()),
+	_jobs(std::queue<Job>()),
+	_isStopping(false)
+{
+	SetNumWorkers(numWorkers);
+}
+
+ThreadPool::~ThreadPool() {
+	_StopWorkers();
+}
+
+int ThreadPool::GetNumWorkers() const {
+	return static_cast<int>(_workers.size());
+}
+
+void ThreadPool::SetNumWorkers(int numWorkers) {
+	_StopWorkers();
+
+	_isStopping = false;
+	_workers.reserve(numWorkers);
+	for (int ix = 0; ix < numWorkers; ix++) {
+		_workers.emplace_back(&ThreadPool::_WorkerLoop, this);
+	}
+}
+
+void ThreadPool::Enqueue(const Job& job) {
+	// With no workers, we just do the work immediately
+	if (_workers.empty()) {
+		job();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_jobLock);
+		_jobs.push(job);
+	}
+	_jobSignal.notify_one();
+}
+
+void ThreadPool::ParallelFor(int begin, int end, int grainSize, const RangeJob& callback) {
+	if (end <= begin) return;
+	grainSize = grainSize < 1 ? 1 : grainSize;
+
+	// If there's only one chunk worth of work (or nobody to help), skip the queue entirely
+	if (_workers.empty() || end - begin <= grainSize) {
+		callback(begin, end);
+		return;
+	}
+
+	// Tracks how many chunks are still outstanding
+	std::atomic<int> remaining(0);
+	for (int ix = begin; ix < end; ix += grainSize) {
+		remaining++;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_jobLock);
+		for (int ix = begin; ix < end; ix += grainSize) {
+			int chunkEnd = ix + grainSize < end ? ix + grainSize : end;
+			_jobs.push([&callback, &remaining, ix, chunkEnd]() {
+				callback(ix, chunkEnd);
+				remaining--;
+			});
+		}
+	}
+	_jobSignal.notify_all();
+
+	// Help out with the work on this thread until all of our chunks are done. We
+	// may end up running other queued jobs, which is fine
+	while (remaining > 0) {
+		if (!_TryRunJob()) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+int ThreadPool::HardwareThreads() {
+	unsigned int result = std::thread::hardware_concurrency();
+	return result == 0 ? 1 : static_cast<int>(result);
+}
+
+void ThreadPool::_WorkerLoop() {
+	PROFILE_THREAD("Worker");
+	while (true) {
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(_jobLock);
+			_jobSignal.wait(lock, [this]() { return _isStopping || !_jobs.empty(); });
+			if (_isStopping && _jobs.empty()) {
+				return;
+			}
+			job = std::move(_jobs.front());
+			_jobs.pop();
+		}
+		PROFILE_ZONE("Job");
+		job();
+	}
+}
+
+bool ThreadPool::_TryRunJob() {
+	Job job;
+	{
+		std::lock_guard<std::mutex> lock(_jobLock);
+		if (_jobs.empty()) {
+			return false;
+		}
+		job = std::move(_jobs.front());
+		_jobs.pop();
+	}
+	job();
+	return true;
+}
+
+void ThreadPool::_StopWorkers() {
+	{
+		std::lock_guard<std::mutex> lock(_jobLock);
+		_isStopping = true;
+	}
+	_jobSignal.notify_all();
+	for (auto& worker : _workers) {
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+	_workers.clear();
+}
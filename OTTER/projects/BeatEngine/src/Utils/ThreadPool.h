@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "Utils/Macros.h"
+
+/// <summary>
+/// A simple pool of worker threads that pull jobs from a shared queue. Used by
+/// engine systems that want to spread work across cores (ex: physics)
+/// </summary>
+class ThreadPool {
+public:
+	DEFINE_RESOURCE(ThreadPool)
+
+	typedef std::function<void()> Job;
+	typedef std::function<void(int begin, int end)> RangeJob;
+
+	/// <summary>
+	/// Creates a new thread pool with the given number of worker threads
+	/// </summary>
+	/// <param name="numWorkers">The number of worker threads to spawn, 0 to run everything on the calling thread</param>
+	ThreadPool(int numWorkers = 0);
+	~ThreadPool();
+
+	/// <summary>
+	/// Gets the number of worker threads in this pool (not including the calling thread)
+	/// </summary>
+	int GetNumWorkers() const;
+	/// <summary>
+	/// Stops all existing worker threads and spawns a new set of workers. Should
+	/// not be called while the pool is processing work
+	/// </summary>
+	/// <param name="numWorkers">The new number of worker threads</param>
+	void SetNumWorkers(int numWorkers);
+
+	/// <summary>
+	/// Adds a job to the queue, to be picked up by the next idle worker
+	/// </summary>
+	/// <param name="job">The job to invoke</param>
+	void Enqueue(const Job& job);
+
+	/// <summary>
+	/// Splits the range [begin, end) into chunks of at most grainSize elements, and
+	/// invokes the callback for each chunk across all worker threads. The calling 
+	/// thread participates in the work, and this function blocks until all chunks 
+	/// are complete
+	/// </summary>
+	/// <param name="begin">The first index in the range</param>
+	/// <param name="end">One past the last index in the range</param>
+	/// <param name="grainSize">The maximum number of elements in a single chunk</param>
+	/// <param name="callback">The callback to invoke with the bounds of each chunk</param>
+	void ParallelFor(int begin, int end, int grainSize, const RangeJob& callback);
+
+	/// <summary>
+	/// Gets the number of hardware threads available on this machine, always at least 1
+	/// </summary>
+	static int HardwareThreads();
+
+protected:
+	std::vector<std::thread> _workers;
+	std::queue<Job>          _jobs;
+	std::mutex               _jobLock;
+	std::condition_variable  _jobSignal;
+	bool                     _isStopping;
+
+	void _WorkerLoop();
+	// Attempts to pop and run a single job, returns false if the queue was empty
+	bool _TryRunJob();
+	void _StopWorkers();
+};
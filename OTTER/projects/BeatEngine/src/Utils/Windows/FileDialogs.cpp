@@ -3,9 +3,10 @@
 #include <sstream>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <optional>
+#ifdef _WIN32
 #define GLFW_EXPOSE_NATIVE_WIN32
 #include <GLFW/glfw3native.h>
-#include <optional>
 #include "Application/Application.h"
 
 std::optional<std::string> FileDialogs::OpenFile(const char* filter)
@@ -64,3 +65,9 @@ std::optional<std::string> FileDialogs::SelectFolder(const char* filter)
 		return ofn.lpstrFile;
 	return std::nullopt;
 }
+#else
+// Native file dialogs are only implemented for Windows, other platforms behave as if the user cancelled
+std::optional<std::string> FileDialogs::OpenFile(const char* filter) { return std::nullopt; }
+std::optional<std::string> FileDialogs::SaveFile(const char* filter) { return std::nullopt; }
+std::optional<std::string> FileDialogs::SelectFolder(const char* filter) { return std::nullopt; }
+#endif
@@ -1,14 +1,15 @@
 #define GLM_SWIZZLE 
 #include "Application/Application.h"
+#ifdef _WIN32
 extern "C" {
 	__declspec(dllexport) unsigned long NvOptimusEnablement = 0x01;
 	__declspec(dllexport) int AmdPowerXpressRequestHighPerformance = 0x01;
 }
+#endif
 int main(int argc, char** args) {
 	Logger::Init();
 
-	// TODO: parse arguments?
-
+	// Arguments are handled by the application (ex: --benchmark Level1.json --hidden-window)
 	Application::Start(argc, args);
 
 	Logger::Uninitialize();
@@ -0,0 +1,93 @@
+#include "CookCache.h"
+#include <filesystem>
+#include <fstream>
+#include <json.hpp>
+#include "Logging.h"
+
+#include "Utils/FileHelpers.h"
+
+CookCache::CookCache(const std::string& path) :
+	_path(path),
+	_entries(),
+	_lock()
+{
+	std::ifstream file(path);
+	if (!file) {
+		return;
+	}
+
+	try {
+		nlohmann::json blob = nlohmann::json::parse(file);
+		uint32_t version = blob.value("version", 0u);
+		if (version != CurrentVersion) {
+			LOG_INFO("Cook cache \"{}\" is from an older version, everything will be re-cooked", path);
+			return;
+		}
+		for (auto& [output, hash] : blob["entries"].items()) {
+			_entries[output] = std::stoull(hash.get<std::string>(), nullptr, 16);
+		}
+	}
+	catch (std::exception& e) {
+		LOG_WARN("Failed to read cook cache \"{}\": {}", path, e.what());
+		_entries.clear();
+	}
+}
+
+bool CookCache::IsUpToDate(const std::string& output, uint64_t hash) const {
+	std::lock_guard<std::mutex> lock(_lock);
+	auto it = _entries.find(output);
+	return it != _entries.end() && it->second == hash && std::filesystem::exists(output);
+}
+
+void CookCache::Record(const std::string& output, uint64_t hash) {
+	std::lock_guard<std::mutex> lock(_lock);
+	_entries[output] = hash;
+}
+
+void CookCache::Save() const {
+	std::lock_guard<std::mutex> lock(_lock);
+
+	// Stored as hex strings, since not every JSON reader copes with 64 bit integers
+	nlohmann::json entries = nlohmann::json::object();
+	for (const auto& [output, hash] : _entries) {
+		char hashText[17];
+		snprintf(hashText, sizeof(hashText), "%016llx", (unsigned long long)hash);
+		entries[output] = hashText;
+	}
+
+	uint32_t version = CurrentVersion;
+	nlohmann::json blob = {
+		{ "version", version },
+		{ "entries", entries }
+	};
+	FileHelpers::WriteContentsToFile(_path, blob.dump(1, '\t'));
+}
+
+uint64_t CookCache::Hash(const std::string& settings, const std::vector<std::string>& sources) {
+	// FNV-1a, same as the font cache. It only needs to notice changes, not resist collisions on purpose
+	uint64_t hash = 0xcbf29ce484222325ull;
+	auto append = [&hash](const void* data, size_t size) {
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+		for (size_t ix = 0; ix < size; ix++) {
+			hash = (hash ^ bytes[ix]) * 0x100000001b3ull;
+		}
+	};
+
+	uint32_t version = CurrentVersion;
+	append(&version, sizeof(uint32_t));
+	append(settings.data(), settings.size());
+
+	std::vector<char> buffer(64 * 1024);
+	for (const std::string& source : sources) {
+		std::ifstream file(source, std::ios::binary);
+		if (!file) {
+			continue;
+		}
+		// Include the name, so that swapping which files go where still counts as a change
+		append(source.data(), source.size());
+		while (file.read(buffer.data(), buffer.size()) || file.gcount() > 0) {
+			append(buffer.data(), (size_t)file.gcount());
+		}
+	}
+	return hash;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// Remembers a hash of everything that each cooked file was built from, so that assets whose
+/// contents haven't changed can be skipped on the next run. Unlike comparing timestamps, this
+/// survives fresh checkouts and tools that touch files without changing them.
+///
+/// The cache is safe to query and update from several cooking threads at once
+/// </summary>
+class CookCache {
+public:
+	/// <summary>
+	/// Loads the cache from the given file, or starts empty if it's missing or from an older version
+	/// </summary>
+	/// <param name="path">The path to the cache file</param>
+	CookCache(const std::string& path);
+
+	/// <summary>
+	/// Returns true if the output exists, and was last cooked from inputs with the given hash
+	/// </summary>
+	bool IsUpToDate(const std::string& output, uint64_t hash) const;
+	/// <summary>
+	/// Stores the hash of the inputs that an output was just cooked from
+	/// </summary>
+	void Record(const std::string& output, uint64_t hash);
+	/// <summary>
+	/// Writes the cache back out to the file it was loaded from
+	/// </summary>
+	void Save() const;
+
+	/// <summary>
+	/// Hashes the given inputs, settings first and then the contents of each source file
+	/// </summary>
+	/// <param name="settings">Anything other than the sources that changes the output</param>
+	/// <param name="sources">The files the output is built from, missing files are skipped</param>
+	static uint64_t Hash(const std::string& settings, const std::vector<std::string>& sources);
+
+protected:
+	// Bump this to invalidate every cache, ex: when the cooked formats change
+	static const uint32_t CurrentVersion = 0x01;
+
+	std::string                               _path;
+	std::unordered_map<std::string, uint64_t> _entries;
+	mutable std::mutex                        _lock;
+};
@@ -0,0 +1,544 @@
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+#include "Logging.h"
+
+#include "CookCache.h"
+#include "Gameplay/MeshResource.h"
+#include "Graphics/Font.h"
+#include "Graphics/ShaderProgram.h"
+#include "Graphics/Textures/Texture2D.h"
+#include "Graphics/Textures/Texture2DArray.h"
+#include "Graphics/Textures/Texture3D.h"
+#include "Graphics/Textures/TextureCooker.h"
+#include "Graphics/Textures/TextureCube.h"
+#include "Utils/FileHelpers.h"
+#include "Utils/MappedFile.h"
+#include "Utils/OptimizedObjLoader.h"
+#include "Utils/ResourceManager/AssetArchive.h"
+#include "Utils/ResourceManager/ResourceManager.h"
+#include "Utils/StringUtils.h"
+#include "Utils/ThreadPool.h"
+
+// Offline cooker for the game's assets. Source files are converted into formats that the engine can load as-is, and
+// the cooked files are written next to their sources:
+//
+//    AssetCooker .                                   (cook every manifest and image under the current folder)
+//    AssetCooker Level1-manifest.json                (cook everything a manifest uses)
+//    AssetCooker --format RGBA8 --linear luts        (options apply to every path after them)
+//    AssetCooker --array 2 2 textures/particles.png  (cook an image for use as a Texture2DArray)
+//    AssetCooker --pack Level1-manifest.json         (also pack the cooked manifest and it's assets into an archive)
+//
+// Manifests (*-manifest.json) have each of their textures, LUTs, meshes, shaders and fonts cooked, and a copy of the
+// manifest is written alongside it (*-manifest.cooked.json) that points at the cooked files. The game loads the
+// cooked copy in place of the manifest as long as it's newer. Loose images are cooked into DDS files as well, which
+// the texture classes pick up in place of their source.
+//
+// Texture formats are Auto, BC1, BC3, BC4, BC5 and RGBA8. --linear skips gamma correction when filtering mips,
+// --normal re-normalizes every mip level, and --no-mips only stores the top level. Cubemaps are found by their _PosX
+// face. Every cooked file remembers a hash of what it was built from (in .cookcache.json), and anything that hasn't
+// changed is skipped unless --force is given. Work is spread across every core
+//
+// --pack writes each cooked manifest and everything it points at into a single archive (*-manifest.pak), which the
+// game mounts in place of the manifest and loads assets out of without opening any other files. Fonts keep their own
+// cache and stay as loose files
+//
+// The working directory should be the BeatEngine res folder, so that cooked files land next to the paths the game uses
+
+namespace fs = std::filesystem;
+
+static const char* ImageExtensions[] = { ".png", ".jpg", ".jpeg", ".tga", ".bmp" };
+static const char* ManifestSuffix = "-manifest.json";
+static const char* CacheFilename = ".cookcache.json";
+
+static bool IsSourceImage(const fs::path& path) {
+	std::string extension = path.extension().string();
+	StringTools::ToLower(extension);
+	for (const char* supported : ImageExtensions) {
+		if (extension == supported) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool IsManifest(const fs::path& path) {
+	std::string filename = path.filename().string();
+	size_t suffixLen = strlen(ManifestSuffix);
+	return filename.size() > suffixLen && filename.compare(filename.size() - suffixLen, suffixLen, ManifestSuffix) == 0;
+}
+
+// If the path is a cubemap face, returns the face and stores the cubemap's base filename (ex: "skybox_PosX.png" => "skybox.png")
+static CubeMapFace GetCubeFace(const fs::path& path, fs::path& baseFilename) {
+	std::string stem = path.stem().string();
+	size_t split = stem.rfind('_');
+	if (split == std::string::npos) {
+		return CubeMapFace::Unknown;
+	}
+	CubeMapFace face = ParseCubeMapFace(stem.substr(split + 1), CubeMapFace::Unknown);
+	if (face != CubeMapFace::Unknown) {
+		baseFilename = path.parent_path() / (stem.substr(0, split) + path.extension().string());
+	}
+	return face;
+}
+
+// Gets the name that a resource type is stored under in manifests
+template <typename T>
+static std::string GetManifestTypeName() {
+	return StringTools::SanitizeClassName(typeid(T).name());
+}
+
+struct CookOptions {
+	TextureCookSettings Settings;
+	uint32_t            SplitX = 0;
+	uint32_t            SplitY = 0;
+	bool                Force  = false;
+};
+
+struct CookStats {
+	std::atomic<int> Cooked  { 0 };
+	std::atomic<int> Skipped { 0 };
+	std::atomic<int> Failed  { 0 };
+};
+
+// A single file to cook. Jobs are gathered up front so that assets shared between manifests are only cooked once,
+// and then they're all run in parallel
+struct CookJob {
+	// The cooked file, or empty if the job keeps it's own cache (ex: fonts)
+	std::string              Output;
+	// The files that the output is built from
+	std::vector<std::string> Sources;
+	// Anything else that changes the output, such as the cook settings
+	std::string              Settings;
+	// Writes the output, returning true on success
+	std::function<bool()>    Cook;
+	bool                     Force     = false;
+	bool                     Succeeded = false;
+};
+
+class CookQueue {
+public:
+	// Adds a job and returns it's index, or the index of an existing job that writes the same output
+	size_t Add(const std::string& key, CookJob&& job) {
+		auto it = _byKey.find(key);
+		if (it != _byKey.end()) {
+			return it->second;
+		}
+		Jobs.push_back(std::move(job));
+		_byKey[key] = Jobs.size() - 1;
+		return Jobs.size() - 1;
+	}
+
+	size_t Add(CookJob&& job) {
+		std::string key = job.Output;
+		return Add(key, std::move(job));
+	}
+
+	std::vector<CookJob> Jobs;
+
+protected:
+	std::unordered_map<std::string, size_t> _byKey;
+};
+
+// A manifest that is being cooked, along with the fields that should point at cooked files once their jobs succeed
+struct ManifestFile {
+	struct Patch {
+		nlohmann::ordered_json* Field;
+		size_t                  Job;
+	};
+
+	std::string            Path;
+	nlohmann::ordered_json Blob;
+	std::vector<Patch>     Patches;
+};
+
+static std::string DescribeSettings(const TextureCookSettings& settings) {
+	return ~settings.Format + (settings.IsSrgb ? ":srgb" : ":linear") + (settings.IsNormalMap ? ":normal" : "") + (settings.GenerateMips ? ":mips" : "");
+}
+
+static CookJob MakeTexture2DJob(const std::string& source, const CookOptions& options, const TextureCookSettings& settings) {
+	CookJob job = CookJob();
+	job.Output   = TextureCooker::GetCookedPath(source);
+	job.Sources  = { source };
+	job.Settings = "Texture2D:" + DescribeSettings(settings);
+	job.Force    = options.Force;
+	job.Cook     = [source, settings]() { return TextureCooker::CookTexture2D(source, settings); };
+	return job;
+}
+
+static CookJob MakeTexture2DArrayJob(const std::string& source, uint32_t splitX, uint32_t splitY, const CookOptions& options, const TextureCookSettings& settings) {
+	CookJob job = CookJob();
+	job.Output   = TextureCooker::GetCookedArrayPath(source, splitX, splitY);
+	job.Sources  = { source };
+	job.Settings = "Texture2DArray:" + DescribeSettings(settings);
+	job.Force    = options.Force;
+	job.Cook     = [source, splitX, splitY, settings]() { return TextureCooker::CookTexture2DArray(source, splitX, splitY, settings); };
+	return job;
+}
+
+static CookJob MakeTextureCubeJob(const std::string& baseFilename, const CookOptions& options, const TextureCookSettings& settings) {
+	CookJob job = CookJob();
+	job.Output   = TextureCooker::GetCookedPath(baseFilename);
+	job.Sources  = TextureCooker::GetCubeFacePaths(baseFilename);
+	job.Settings = "TextureCube:" + DescribeSettings(settings);
+	job.Force    = options.Force;
+	job.Cook     = [baseFilename, settings]() { return TextureCooker::CookTextureCube(baseFilename, settings); };
+	return job;
+}
+
+static void QueueImage(const fs::path& path, const CookOptions& options, CookQueue& queue) {
+	std::string source = path.generic_string();
+
+	if (options.SplitX > 0) {
+		queue.Add(MakeTexture2DArrayJob(source, options.SplitX, options.SplitY, options, options.Settings));
+		return;
+	}
+
+	// The faces of a cubemap are cooked together into one file, so we only cook it when we see the first face
+	fs::path baseFilename;
+	CubeMapFace face = GetCubeFace(path, baseFilename);
+	if (face != CubeMapFace::Unknown) {
+		if (face == CubeMapFace::PosX) {
+			queue.Add(MakeTextureCubeJob(baseFilename.generic_string(), options, options.Settings));
+		}
+		return;
+	}
+
+	queue.Add(MakeTexture2DJob(source, options, options.Settings));
+}
+
+// Queues a job for the given manifest field, and remembers to point the field at the cooked file if it succeeds
+static void QueuePatch(ManifestFile& manifest, nlohmann::ordered_json& field, CookQueue& queue, CookJob&& job) {
+	size_t index = queue.Add(std::move(job));
+	manifest.Patches.push_back({ &field, index });
+}
+
+static void QueueManifestEntry(ManifestFile& manifest, const std::string& typeName, nlohmann::ordered_json& entry, const CookOptions& options, CookQueue& queue) {
+	// Cooked files are loaded as-is, so a manifest that's been cooked before won't queue them again
+	auto getPath = [&entry](const char* key) {
+		return entry.contains(key) && entry[key].is_string() ? entry[key].get<std::string>() : std::string();
+	};
+
+	TextureCookSettings settings = options.Settings;
+	settings.GenerateMips = options.Settings.GenerateMips && entry.value("generate_mipmaps", false);
+
+	if (typeName == GetManifestTypeName<Texture2D>()) {
+		std::string source = getPath("filename");
+		if (!source.empty() && !TextureCooker::IsDdsFile(source) && fs::exists(source)) {
+			QueuePatch(manifest, entry["filename"], queue, MakeTexture2DJob(source, options, settings));
+		}
+	}
+	else if (typeName == GetManifestTypeName<Texture2DArray>()) {
+		std::string source = getPath("filename");
+		uint32_t splitX = entry.value("x_split", 0u);
+		uint32_t splitY = entry.value("y_split", 0u);
+		if (!source.empty() && !TextureCooker::IsDdsFile(source) && splitX > 0 && splitY > 0 && fs::exists(source)) {
+			QueuePatch(manifest, entry["filename"], queue, MakeTexture2DArrayJob(source, splitX, splitY, options, settings));
+		}
+	}
+	else if (typeName == GetManifestTypeName<TextureCube>()) {
+		// Cubemaps with hand picked faces can't be described by a single path, so they stay as they are
+		std::string base = getPath("base_filename");
+		if (!base.empty() && !TextureCooker::IsDdsFile(base) && !entry.contains("face_filenames")) {
+			if (TextureCooker::GetCubeFacePaths(base).empty()) {
+				LOG_WARN("Skipping cubemap \"{}\", it's missing some faces", base);
+			} else {
+				settings.GenerateMips = options.Settings.GenerateMips;
+				QueuePatch(manifest, entry["base_filename"], queue, MakeTextureCubeJob(base, options, settings));
+			}
+		}
+	}
+	else if (typeName == GetManifestTypeName<Texture3D>()) {
+		std::string source = getPath("filename");
+		if (fs::path(source).extension() == ".cube" && fs::exists(source)) {
+			CookJob job = CookJob();
+			job.Output   = Texture3D::GetCookedLutPath(source);
+			job.Sources  = { source };
+			job.Settings = "Texture3D";
+			job.Force    = options.Force;
+			job.Cook     = [source]() { return Texture3D::CookLut(source); };
+			QueuePatch(manifest, entry["filename"], queue, std::move(job));
+		}
+	}
+	else if (typeName == GetManifestTypeName<Gameplay::MeshResource>()) {
+		std::string source = getPath("filename");
+		if (fs::path(source).extension() == ".obj" && fs::exists(source)) {
+			CookJob job = CookJob();
+			job.Output   = fs::path(source).replace_extension(".bin").generic_string();
+			job.Sources  = { source };
+			job.Settings = "MeshResource";
+			job.Force    = options.Force;
+			job.Cook     = [source, output = job.Output]() {
+				try {
+					OptimizedObjLoader::ConvertToBinary(source, output);
+					return fs::exists(output);
+				}
+				catch (std::exception& e) {
+					LOG_ERROR("Failed to convert \"{}\": {}", source, e.what());
+					return false;
+				}
+			};
+			QueuePatch(manifest, entry["filename"], queue, std::move(job));
+		}
+	}
+	else if (typeName == GetManifestTypeName<ShaderProgram>()) {
+		// Shaders are cooked by resolving all of their includes into a single file. Since the includes are what
+		// usually change, we hash the resolved source rather than the file itself
+		for (auto& [key, stage] : entry.items()) {
+			if (ParseShaderPartType(key, ShaderPartType::Unknown) == ShaderPartType::Unknown || !stage.contains("path")) {
+				continue;
+			}
+			fs::path source = fs::path(stage["path"].get<std::string>());
+			if (source.stem().extension() == ".cooked" || !fs::exists(source)) {
+				continue;
+			}
+
+			std::string resolved = FileHelpers::ReadResolveIncludes(source.generic_string());
+			CookJob job = CookJob();
+			job.Output   = fs::path(source).replace_extension(".cooked" + source.extension().string()).generic_string();
+			job.Settings = "ShaderProgram:" + resolved;
+			job.Force    = options.Force;
+			job.Cook     = [resolved, output = job.Output]() {
+				FileHelpers::WriteContentsToFile(output, resolved);
+				return fs::exists(output);
+			};
+			QueuePatch(manifest, stage["path"], queue, std::move(job));
+		}
+	}
+	else if (typeName == GetManifestTypeName<Font>()) {
+		// Fonts already keep a cache keyed by their contents, so we just make sure it's been baked
+		CookJob job = CookJob();
+		job.Cook = [data = nlohmann::json(entry)]() {
+			Font::Sptr font = Font::FromJson(data, false);
+			return font->Cook();
+		};
+		nlohmann::json key = nlohmann::json(entry);
+		key.erase("guid");
+		queue.Add("Font:" + key.dump(), std::move(job));
+	}
+}
+
+// Packs a cooked manifest and the cooked files that it points at into an archive. Anything that failed to cook still
+// points at it's source, and is left out so that it's loaded as a loose file instead
+static bool PackManifest(const ManifestFile& manifest) {
+	AssetArchive::Writer writer;
+	int packed = 0;
+	auto addFile = [&](const std::string& typeName, const std::string& guid, uint32_t part, const std::string& path) {
+		MappedFile file;
+		if (!file.Open(path)) {
+			LOG_WARN("Failed to pack \"{}\", it will be loaded as a loose file", path);
+			return;
+		}
+		writer.Add(typeName, Guid(guid), part, file.GetData(), file.GetSize());
+		packed++;
+	};
+	auto getPath = [](const nlohmann::ordered_json& entry, const char* key) {
+		return entry.contains(key) && entry[key].is_string() ? entry[key].get<std::string>() : std::string();
+	};
+
+	for (auto& [typeName, items] : manifest.Blob.items()) {
+		if (!items.is_object()) {
+			continue;
+		}
+		for (auto& [guid, entry] : items.items()) {
+			if (typeName == GetManifestTypeName<Texture2D>() || typeName == GetManifestTypeName<Texture2DArray>()) {
+				std::string path = getPath(entry, "filename");
+				if (TextureCooker::IsDdsFile(path)) {
+					addFile(typeName, guid, 0, path);
+				}
+			}
+			else if (typeName == GetManifestTypeName<TextureCube>()) {
+				std::string path = getPath(entry, "base_filename");
+				if (TextureCooker::IsDdsFile(path) && !entry.contains("face_filenames")) {
+					addFile(typeName, guid, 0, path);
+				}
+			}
+			else if (typeName == GetManifestTypeName<Texture3D>()) {
+				std::string path = getPath(entry, "filename");
+				if (fs::path(path).extension() == ".lut") {
+					addFile(typeName, guid, 0, path);
+				}
+			}
+			else if (typeName == GetManifestTypeName<Gameplay::MeshResource>()) {
+				std::string path = getPath(entry, "filename");
+				if (fs::path(path).extension() == ".bin") {
+					addFile(typeName, guid, 0, path);
+				}
+			}
+			else if (typeName == GetManifestTypeName<ShaderProgram>()) {
+				// Each stage is it's own entry, keyed by the stage type
+				for (auto& [key, stage] : entry.items()) {
+					ShaderPartType type = ParseShaderPartType(key, ShaderPartType::Unknown);
+					std::string path = getPath(stage, "path");
+					if (type != ShaderPartType::Unknown && fs::path(path).stem().extension() == ".cooked") {
+						addFile(typeName, guid, *type, path);
+					}
+				}
+			}
+		}
+	}
+
+	std::vector<uint8_t> blob = nlohmann::ordered_json::to_msgpack(manifest.Blob);
+	writer.Add(AssetArchive::ManifestTypeName, Guid(), 0, blob.data(), blob.size());
+
+	std::string archivePath = ResourceManager::GetArchivePath(manifest.Path);
+	if (!writer.Save(archivePath)) {
+		return false;
+	}
+	LOG_INFO("Packed {} assets into \"{}\"", packed, archivePath);
+	return true;
+}
+
+static bool QueueManifest(const fs::path& path, const CookOptions& options, CookQueue& queue, std::list<ManifestFile>& manifests) {
+	ManifestFile manifest = ManifestFile();
+	manifest.Path = path.generic_string();
+	try {
+		manifest.Blob = nlohmann::ordered_json::parse(FileHelpers::ReadFile(manifest.Path));
+	}
+	catch (std::exception& e) {
+		LOG_ERROR("Failed to parse manifest \"{}\": {}", manifest.Path, e.what());
+		return false;
+	}
+
+	// The manifest is moved into the list first, so that the patches point at it's final location
+	manifests.push_back(std::move(manifest));
+	ManifestFile& added = manifests.back();
+	for (auto& [typeName, items] : added.Blob.items()) {
+		if (!items.is_object()) {
+			continue;
+		}
+		for (auto& [guid, entry] : items.items()) {
+			QueueManifestEntry(added, typeName, entry, options, queue);
+		}
+	}
+	return true;
+}
+
+static bool QueuePath(const fs::path& path, const CookOptions& options, CookQueue& queue, CookQueue& imageQueue, std::list<ManifestFile>& manifests) {
+	if (fs::is_directory(path)) {
+		bool success = true;
+		for (const fs::directory_entry& entry : fs::recursive_directory_iterator(path)) {
+			if (!entry.is_regular_file()) {
+				continue;
+			}
+			if (IsManifest(entry.path())) {
+				success &= QueueManifest(entry.path(), options, queue, manifests);
+			} else if (IsSourceImage(entry.path())) {
+				QueueImage(entry.path(), options, imageQueue);
+			}
+		}
+		return success;
+	} else if (fs::is_regular_file(path)) {
+		if (path.extension() == ".json") {
+			return QueueManifest(path, options, queue, manifests);
+		}
+		QueueImage(path, options, imageQueue);
+		return true;
+	} else {
+		LOG_ERROR("Could not find \"{}\"", path.string());
+		return false;
+	}
+}
+
+static void RunJob(CookJob& job, CookCache& cache, CookStats& stats) {
+	if (job.Output.empty()) {
+		job.Succeeded = job.Cook();
+		(job.Succeeded ? stats.Cooked : stats.Failed)++;
+		return;
+	}
+
+	uint64_t hash = CookCache::Hash(job.Settings, job.Sources);
+	if (!job.Force && cache.IsUpToDate(job.Output, hash)) {
+		// The game compares timestamps to see if a cooked file is stale, so make sure it agrees with us
+		std::error_code error;
+		fs::last_write_time(job.Output, fs::file_time_type::clock::now(), error);
+		job.Succeeded = true;
+		stats.Skipped++;
+		return;
+	}
+
+	job.Succeeded = job.Cook();
+	if (job.Succeeded) {
+		cache.Record(job.Output, hash);
+		stats.Cooked++;
+	} else {
+		stats.Failed++;
+	}
+}
+
+int main(int argc, char** args) {
+	Logger::Init();
+
+	CookOptions options = CookOptions();
+	CookStats stats;
+	CookQueue queue;
+	CookQueue imageQueue;
+	bool pack = false;
+	// Patches point into the manifests, so they can't be moved once they've been queued
+	std::list<ManifestFile> manifests;
+
+	bool success = true;
+	for (int ix = 1; ix < argc; ix++) {
+		std::string arg = args[ix];
+		if (arg == "--format" && ix + 1 < argc) {
+			options.Settings.Format = ParseCookedTextureFormat(args[++ix], CookedTextureFormat::Auto);
+		} else if (arg == "--linear") {
+			options.Settings.IsSrgb = false;
+		} else if (arg == "--normal") {
+			options.Settings.IsNormalMap = true;
+			options.Settings.IsSrgb = false;
+		} else if (arg == "--no-mips") {
+			options.Settings.GenerateMips = false;
+		} else if (arg == "--force") {
+			options.Force = true;
+		} else if (arg == "--pack") {
+			pack = true;
+		} else if (arg == "--array" && ix + 2 < argc) {
+			options.SplitX = std::stoi(args[++ix]);
+			options.SplitY = std::stoi(args[++ix]);
+		} else {
+			success &= QueuePath(fs::path(arg), options, queue, imageQueue, manifests);
+		}
+	}
+
+	// Loose images go last, so that if a manifest uses the same image it's settings win
+	for (CookJob& job : imageQueue.Jobs) {
+		queue.Add(std::move(job));
+	}
+
+	CookCache cache(CacheFilename);
+	ThreadPool pool(std::max(ThreadPool::HardwareThreads() - 1, 0));
+	pool.ParallelFor(0, (int)queue.Jobs.size(), 1, [&](int begin, int end) {
+		for (int ix = begin; ix < end; ix++) {
+			RunJob(queue.Jobs[ix], cache, stats);
+		}
+	});
+	cache.Save();
+
+	// Anything that failed to cook keeps pointing at it's source, so the cooked manifest is always safe to load
+	for (ManifestFile& manifest : manifests) {
+		for (const ManifestFile::Patch& patch : manifest.Patches) {
+			if (queue.Jobs[patch.Job].Succeeded) {
+				*patch.Field = queue.Jobs[patch.Job].Output;
+			}
+		}
+		std::string cookedPath = ResourceManager::GetCookedManifestPath(manifest.Path);
+		FileHelpers::WriteContentsToFile(cookedPath, manifest.Blob.dump(1, '\t'));
+		LOG_INFO("Wrote cooked manifest \"{}\"", cookedPath);
+
+		if (pack) {
+			success &= PackManifest(manifest);
+		}
+	}
+
+	LOG_INFO("Cooked {} assets, {} up to date, {} failed", stats.Cooked.load(), stats.Skipped.load(), stats.Failed.load());
+
+	Logger::Uninitialize();
+	return (!success || stats.Failed > 0) ? 1 : 0;
+}